@@ -0,0 +1,186 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Pre-generates the FFTW wisdom for every transform the LTE and NR PHY plan at start-up (OFDM modulators and
+ * demodulators for all the cell bandwidths and cyclic prefixes, SC-FDMA transform precoding and PRACH), so that a cold
+ * eNodeB/UE start does not have to measure them. The wisdom is stored in the default srsRAN wisdom file on exit and,
+ * optionally, in an additional output file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <unistd.h>
+
+#include "srsran/srsran.h"
+
+static char*    output_file_name = NULL;
+static uint32_t max_prb_lte      = SRSRAN_MAX_PRB;
+static uint32_t max_prb_nr       = SRSRAN_MAX_PRB_NR;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [opPv]\n", prog);
+  printf("\t-o additional wisdom output file [Default only ~/.srsran_fftwisdom]\n");
+  printf("\t-p maximum number of LTE PRB [Default %d]\n", max_prb_lte);
+  printf("\t-P maximum number of NR PRB [Default %d]\n", max_prb_nr);
+  printf("\t-v srsran_verbose\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "opPv")) != -1) {
+    switch (opt) {
+      case 'o':
+        output_file_name = argv[optind];
+        break;
+      case 'p':
+        max_prb_lte = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'P':
+        max_prb_nr = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// Plans the OFDM modulator and demodulator for a given bandwidth, for both cyclic prefixes
+static int plan_ofdm(cf_t* buffer_time, cf_t* buffer_freq, uint32_t nof_prb, uint32_t symbol_sz)
+{
+  for (srsran_cp_t cp = SRSRAN_CP_NORM; cp <= SRSRAN_CP_EXT; cp++) {
+    srsran_ofdm_cfg_t cfg = {};
+    cfg.nof_prb           = nof_prb;
+    cfg.symbol_sz         = symbol_sz;
+    cfg.cp                = cp;
+
+    srsran_ofdm_t ofdm_rx = {};
+    cfg.in_buffer         = buffer_time;
+    cfg.out_buffer        = buffer_freq;
+    if (srsran_ofdm_rx_init_cfg(&ofdm_rx, &cfg) < SRSRAN_SUCCESS) {
+      ERROR("Error initialising OFDM demodulator for %d PRB", nof_prb);
+      return SRSRAN_ERROR;
+    }
+    srsran_ofdm_rx_free(&ofdm_rx);
+
+    srsran_ofdm_t ofdm_tx = {};
+    cfg.in_buffer         = buffer_freq;
+    cfg.out_buffer        = buffer_time;
+    if (srsran_ofdm_tx_init_cfg(&ofdm_tx, &cfg) < SRSRAN_SUCCESS) {
+      ERROR("Error initialising OFDM modulator for %d PRB", nof_prb);
+      return SRSRAN_ERROR;
+    }
+    srsran_ofdm_tx_free(&ofdm_tx);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int                     ret         = SRSRAN_ERROR;
+  uint32_t                max_sf_len  = SRSRAN_SF_LEN_MAX * 4;
+  cf_t*                   buffer_time = srsran_vec_cf_malloc(max_sf_len);
+  cf_t*                   buffer_freq = srsran_vec_cf_malloc(max_sf_len);
+  srsran_dft_precoding_t  precoding   = {};
+  srsran_prach_t          prach       = {};
+  srsran_dft_plan_stats_t stats       = {};
+
+  parse_args(argc, argv);
+
+  if (buffer_time == NULL || buffer_freq == NULL) {
+    ERROR("Error allocating buffers");
+    goto clean_exit;
+  }
+
+  // LTE, both with the 3GPP standard and the reduced symbol sizes
+  bool standard_symbol_size = srsran_symbol_size_is_standard();
+  for (uint32_t s = 0; s < 2; s++) {
+    srsran_use_standard_symbol_size(s == 0);
+    for (uint32_t nof_prb = 1; nof_prb <= max_prb_lte; nof_prb++) {
+      int symbol_sz = srsran_symbol_sz(nof_prb);
+      if (symbol_sz < SRSRAN_SUCCESS) {
+        ERROR("Invalid number of PRB %d", nof_prb);
+        goto clean_exit;
+      }
+      if (plan_ofdm(buffer_time, buffer_freq, nof_prb, (uint32_t)symbol_sz) < SRSRAN_SUCCESS) {
+        goto clean_exit;
+      }
+      if (srsran_prach_init(&prach, (uint32_t)symbol_sz) < SRSRAN_SUCCESS) {
+        ERROR("Error initialising PRACH for symbol size %d", symbol_sz);
+        goto clean_exit;
+      }
+      srsran_prach_free(&prach);
+    }
+  }
+  srsran_use_standard_symbol_size(standard_symbol_size);
+
+  // SC-FDMA transform precoding
+  for (uint32_t is_tx = 0; is_tx < 2; is_tx++) {
+    if (srsran_dft_precoding_init(&precoding, max_prb_lte, is_tx) < SRSRAN_SUCCESS) {
+      ERROR("Error initialising transform precoding");
+      goto clean_exit;
+    }
+    srsran_dft_precoding_free(&precoding);
+  }
+
+  // NR, minimum symbol size for each bandwidth
+  for (uint32_t nof_prb = 1; nof_prb <= max_prb_nr; nof_prb++) {
+    uint32_t symbol_sz = srsran_min_symbol_sz_rb(nof_prb);
+    if (symbol_sz == 0) {
+      ERROR("Invalid number of NR PRB %d", nof_prb);
+      goto clean_exit;
+    }
+    if (plan_ofdm(buffer_time, buffer_freq, nof_prb, symbol_sz) < SRSRAN_SUCCESS) {
+      goto clean_exit;
+    }
+  }
+
+  if (output_file_name != NULL && srsran_dft_export_wisdom(output_file_name) < SRSRAN_SUCCESS) {
+    ERROR("Error writing wisdom to %s", output_file_name);
+    goto clean_exit;
+  }
+
+  srsran_dft_get_plan_stats(&stats);
+  printf("Planned %d transforms (%d shared) in %.1f ms\n",
+         stats.nof_plans,
+         stats.nof_shared,
+         (double)stats.planning_time_us / 1000.0);
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (buffer_time) {
+    free(buffer_time);
+  }
+  if (buffer_freq) {
+    free(buffer_freq);
+  }
+
+  return ret;
+}
@@ -213,6 +213,18 @@ public:
     }
     node = new_head;
   }
+  /// Inserts "t" right after "pos", which must be a node of this list
+  void insert_after(T* pos, T* t)
+  {
+    node_t* prev_node   = static_cast<node_t*>(pos);
+    node_t* new_node    = static_cast<node_t*>(t);
+    new_node->prev_node = prev_node;
+    new_node->next_node = prev_node->next_node;
+    if (prev_node->next_node != nullptr) {
+      prev_node->next_node->prev_node = new_node;
+    }
+    prev_node->next_node = new_node;
+  }
   void pop(T* t)
   {
     node_t* to_rem = static_cast<node_t*>(t);
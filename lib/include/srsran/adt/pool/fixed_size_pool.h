@@ -24,6 +24,7 @@
 
 #include "memblock_cache.h"
 #include "srsran/adt/circular_buffer.h"
+#include <algorithm>
 #include <thread>
 
 namespace srsran {
@@ -31,8 +32,9 @@ namespace srsran {
 /**
  * Concurrent fixed size memory pool made of blocks of equal size
  * Each worker keeps a separate thread-local memory block cache that it uses for fast allocation/deallocation.
- * When this cache gets depleted, the worker tries to obtain blocks from a central memory block cache.
- * When accessing a thread local cache, no locks are required.
+ * When this cache gets depleted, the worker pops a batch of blocks from a central memory block cache.
+ * When accessing a thread local cache, no locks are required. The central cache is a lock-free stack of batches of
+ * blocks, so moving blocks between the thread local caches and the central cache is also lock-free.
  * Since there is no stealing of blocks between workers, it is possible that a worker can't allocate while another
  * worker still has blocks in its own cache. To minimize the impact of this event, an upper bound is place on a worker
  * thread cache size. Once a worker reaches that upper bound, it sends half of its stored blocks to the central cache.
@@ -52,22 +54,28 @@ class concurrent_fixed_memory_pool
     typename std::aligned_storage<ObjSize, alignof(detail::max_alignment_t)>::type buffer;
   };
 
-  const static size_t batch_steal_size = 16;
+  /// Number of blocks moved at once between the thread local caches and the central cache
+  const static size_t batch_size = 16;
 
   // ctor only accessible from singleton get_instance()
-  explicit concurrent_fixed_memory_pool(size_t nof_objects_)
+  explicit concurrent_fixed_memory_pool(size_t nof_objects_) :
+    nof_objects(nof_objects_),
+    allocated_blocks(new obj_storage_t[nof_objects_]),
+    central_mem_cache(allocated_blocks.get(), sizeof(obj_storage_t), nof_objects_)
   {
-    srsran_assert(nof_objects_ > batch_steal_size, "A positive pool size must be provided");
+    srsran_assert(nof_objects_ > batch_size, "A positive pool size must be provided");
+    srsran_assert(allocated_blocks != nullptr, "Failed to instantiate fixed memory pool");
 
-    std::lock_guard<std::mutex> lock(mutex);
-    allocated_blocks.resize(nof_objects_);
-    for (std::unique_ptr<obj_storage_t>& b : allocated_blocks) {
-      b.reset(new obj_storage_t());
-      srsran_assert(b.get() != nullptr, "Failed to instantiate fixed memory pool");
-      central_mem_cache.push(static_cast<void*>(b.get()));
+    detail::intrusive_memblock_list batch;
+    for (size_t i = 0; i < nof_objects; ++i) {
+      batch.push(static_cast<void*>(&allocated_blocks[i]));
+      if (batch.size() == batch_size) {
+        central_mem_cache.push(batch);
+      }
     }
-    local_growth_thres = allocated_blocks.size() / 16;
-    local_growth_thres = local_growth_thres < batch_steal_size ? batch_steal_size : local_growth_thres;
+    central_mem_cache.push(batch);
+    local_growth_thres = nof_objects / 16;
+    local_growth_thres = local_growth_thres < 2 * batch_size ? 2 * batch_size : local_growth_thres;
   }
 
 public:
@@ -78,19 +86,35 @@ public:
   concurrent_fixed_memory_pool& operator=(const concurrent_fixed_memory_pool&) = delete;
   concurrent_fixed_memory_pool& operator=(concurrent_fixed_memory_pool&&) = delete;
 
-  ~concurrent_fixed_memory_pool()
-  {
-    std::lock_guard<std::mutex> lock(mutex);
-    allocated_blocks.clear();
-  }
-
   static concurrent_fixed_memory_pool<ObjSize, DebugSanitizeAddress>* get_instance(size_t size = 4096)
   {
     static concurrent_fixed_memory_pool<ObjSize, DebugSanitizeAddress> pool(size);
     return &pool;
   }
 
-  size_t size() { return allocated_blocks.size(); }
+  size_t size() { return nof_objects; }
+
+  /// Number of blocks currently allocated, as seen from the thread local counters of all the workers.
+  size_t nof_allocated_blocks()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    int64_t                     count = nof_allocated_by_finished_workers;
+    for (const worker_ctxt* w : workers) {
+      count += w->nof_allocated.load(std::memory_order_relaxed);
+    }
+    return count > 0 ? static_cast<size_t>(count) : 0;
+  }
+
+  /// Number of blocks allocated since the pool creation, as seen from the thread local counters of all the workers.
+  uint64_t nof_total_allocations()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t                    count = nof_allocations_by_finished_workers;
+    for (const worker_ctxt* w : workers) {
+      count += w->nof_allocations.load(std::memory_order_relaxed);
+    }
+    return count;
+  }
 
   void* allocate_node(size_t sz)
   {
@@ -99,18 +123,17 @@ public:
 
     void* node = worker_ctxt->cache.try_pop();
     if (node == nullptr) {
-      // fill the thread local cache enough for this and next allocations
-      std::array<void*, batch_steal_size> popped_blocks;
-      size_t                              n = central_mem_cache.try_pop(popped_blocks);
-      for (size_t i = 0; i < n; ++i) {
-        new (popped_blocks[i]) obj_storage_t();
-        worker_ctxt->cache.push(static_cast<void*>(popped_blocks[i]));
+      // fill the thread local cache with a batch of blocks for this and next allocations
+      if (central_mem_cache.try_pop(worker_ctxt->cache)) {
+        node = worker_ctxt->cache.try_pop();
       }
-      node = worker_ctxt->cache.try_pop();
     }
 
+    if (node != nullptr) {
+      worker_ctxt->add_allocated(1);
+    }
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
-    if (node == nullptr) {
+    else {
       print_error("Error allocating buffer in pool of ObjSize=%zd", ObjSize);
     }
 #endif
@@ -120,24 +143,26 @@ public:
   void deallocate_node(void* p)
   {
     srsran_assert(p != nullptr, "Deallocated nodes must have valid address");
-    worker_ctxt*   worker_ctxt = get_worker_cache();
-    obj_storage_t* block_ptr   = static_cast<obj_storage_t*>(p);
+    worker_ctxt* worker_ctxt = get_worker_cache();
 
     if (DebugSanitizeAddress) {
-      std::lock_guard<std::mutex> lock(mutex);
-      srsran_assert(std::any_of(allocated_blocks.begin(),
-                                allocated_blocks.end(),
-                                [block_ptr](const std::unique_ptr<obj_storage_t>& b) { return b.get() == block_ptr; }),
+      uint8_t* mem_start = reinterpret_cast<uint8_t*>(allocated_blocks.get());
+      uint8_t* block_ptr = static_cast<uint8_t*>(p);
+      srsran_assert(block_ptr >= mem_start and block_ptr < mem_start + nof_objects * sizeof(obj_storage_t) and
+                        (block_ptr - mem_start) % sizeof(obj_storage_t) == 0,
                     "Error deallocating block with address 0x%lx",
                     (long unsigned)block_ptr);
     }
 
     // push to local memory block cache
-    worker_ctxt->cache.push(static_cast<void*>(p));
+    worker_ctxt->cache.push(p);
+    worker_ctxt->add_allocated(-1);
 
     if (worker_ctxt->cache.size() >= local_growth_thres) {
       // if local cache reached max capacity, send half of the blocks to central cache
-      central_mem_cache.steal_blocks(worker_ctxt->cache, worker_ctxt->cache.size() / 2);
+      while (worker_ctxt->cache.size() > local_growth_thres / 2) {
+        push_batch(worker_ctxt->cache);
+      }
     }
   }
 
@@ -153,15 +178,10 @@ public:
 
   void print_all_buffers()
   {
-    auto*  worker     = get_worker_cache();
-    size_t tot_blocks = 0;
-    {
-      std::lock_guard<std::mutex> lock(mutex);
-      tot_blocks = allocated_blocks.size();
-    }
+    auto* worker = get_worker_cache();
     printf("There are %zd/%zd buffers in shared block container. This thread contains %zd in its local cache\n",
            central_mem_cache.size(),
-           tot_blocks,
+           nof_objects,
            worker->cache.size());
   }
 
@@ -169,12 +189,27 @@ private:
   struct worker_ctxt {
     std::thread::id    id;
     free_memblock_list cache;
+    /// Blocks allocated minus blocks deallocated by this worker. Only written by the worker itself.
+    std::atomic<int64_t> nof_allocated{0};
+    /// Blocks allocated by this worker. Only written by the worker itself.
+    std::atomic<uint64_t> nof_allocations{0};
 
-    worker_ctxt() : id(std::this_thread::get_id()) {}
+    worker_ctxt() : id(std::this_thread::get_id()) { pool_type::get_instance()->register_worker(this); }
     ~worker_ctxt()
     {
-      concurrent_free_memblock_list& central_cache = pool_type::get_instance()->central_mem_cache;
-      central_cache.steal_blocks(cache, cache.size());
+      pool_type* pool = pool_type::get_instance();
+      while (not cache.empty()) {
+        pool->push_batch(cache);
+      }
+      pool->unregister_worker(this);
+    }
+
+    void add_allocated(int64_t n)
+    {
+      nof_allocated.store(nof_allocated.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+      if (n > 0) {
+        nof_allocations.store(nof_allocations.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+      }
     }
   };
 
@@ -184,6 +219,30 @@ private:
     return &worker_cache;
   }
 
+  /// Moves up to batch_size blocks from the thread local cache to the central cache.
+  void push_batch(free_memblock_list& local_cache)
+  {
+    detail::intrusive_memblock_list batch;
+    for (size_t i = 0; i < batch_size and not local_cache.empty(); ++i) {
+      batch.push(local_cache.pop());
+    }
+    central_mem_cache.push(batch);
+  }
+
+  void register_worker(worker_ctxt* w)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    workers.push_back(w);
+  }
+
+  void unregister_worker(worker_ctxt* w)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    nof_allocated_by_finished_workers += w->nof_allocated.load(std::memory_order_relaxed);
+    nof_allocations_by_finished_workers += w->nof_allocations.load(std::memory_order_relaxed);
+    workers.erase(std::remove(workers.begin(), workers.end(), w), workers.end());
+  }
+
   /// Formats and prints the input string and arguments into the configured output stream.
   template <typename... Args>
   void print_error(const char* str, Args&&... args)
@@ -195,12 +254,18 @@ private:
     }
   }
 
-  size_t                local_growth_thres = 0;
-  srslog::basic_logger* logger             = nullptr;
+  const size_t                     nof_objects;
+  size_t                           local_growth_thres = 0;
+  srslog::basic_logger*            logger             = nullptr;
+  std::unique_ptr<obj_storage_t[]> allocated_blocks;
+
+  concurrent_memblock_batch_stack central_mem_cache;
 
-  concurrent_free_memblock_list                central_mem_cache;
-  std::mutex                                   mutex;
-  std::vector<std::unique_ptr<obj_storage_t> > allocated_blocks;
+  // Registry of the thread local caches, only used to compute the pool occupancy
+  std::mutex                mutex;
+  std::vector<worker_ctxt*> workers;
+  int64_t                   nof_allocated_by_finished_workers   = 0;
+  uint64_t                  nof_allocations_by_finished_workers = 0;
 };
 
 } // namespace srsran
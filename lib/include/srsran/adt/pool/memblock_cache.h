@@ -23,6 +23,8 @@
 #define SRSRAN_MEMBLOCK_CACHE_H
 
 #include "pool_utils.h"
+#include <atomic>
+#include <limits>
 #include <mutex>
 
 namespace srsran {
@@ -269,6 +271,107 @@ private:
   mutable std::mutex mutex;
 };
 
+/**
+ * Lock-free stack of batches of memory blocks, where all blocks belong to the same contiguous memory region.
+ * Each batch is an intrusive list of blocks. The first block of a batch also stores, after the list node, the index of
+ * the next batch in the stack and the batch size. The stack head packs the index of the first batch with a version
+ * number, so that it can be updated with a single 64-bit CAS, while avoiding the ABA problem.
+ * Note: Popping a batch reads the next batch index of a block that may have just been popped by another thread. Given
+ *       that blocks are never returned to the OS, the read is safe and its stale value is discarded by the CAS.
+ */
+class concurrent_memblock_batch_stack
+{
+  struct batch_header_t {
+    detail::intrusive_memblock_list::node node;
+    std::atomic<uint32_t>                 next_batch;
+    uint32_t                              nof_blocks;
+  };
+
+  static const uint32_t null_index = std::numeric_limits<uint32_t>::max();
+
+public:
+  concurrent_memblock_batch_stack(void* mem_start_, size_t block_size_, size_t nof_blocks_) :
+    mem_start(static_cast<uint8_t*>(mem_start_)), block_size(block_size_)
+  {
+    srsran_assert(block_size_ >= sizeof(batch_header_t) and is_aligned(mem_start_, alignof(batch_header_t)) and
+                      block_size_ % alignof(batch_header_t) == 0,
+                  "Invalid memory block size=%zd",
+                  block_size_);
+    srsran_assert(nof_blocks_ < null_index, "Number of memory blocks=%zd is too large", nof_blocks_);
+  }
+  concurrent_memblock_batch_stack(const concurrent_memblock_batch_stack&) = delete;
+  concurrent_memblock_batch_stack& operator=(const concurrent_memblock_batch_stack&) = delete;
+
+  /// Pushes all the blocks of "batch" to the stack as a single batch, leaving "batch" empty.
+  void push(detail::intrusive_memblock_list& batch) noexcept
+  {
+    if (batch.empty()) {
+      return;
+    }
+    batch_header_t* header = reinterpret_cast<batch_header_t*>(batch.head);
+    uint32_t        idx    = get_index(header);
+    header->nof_blocks     = batch.size();
+    nof_blocks.fetch_add(batch.size(), std::memory_order_relaxed);
+
+    uint64_t old_head = head.load(std::memory_order_relaxed);
+    do {
+      header->next_batch.store(get_head_index(old_head), std::memory_order_relaxed);
+    } while (not head.compare_exchange_weak(
+        old_head, make_head(idx, get_head_version(old_head) + 1), std::memory_order_release, std::memory_order_relaxed));
+    batch.clear();
+  }
+
+  /// Pops a batch of blocks from the stack into the empty list "batch". Returns false if the stack is empty.
+  bool try_pop(detail::intrusive_memblock_list& batch) noexcept
+  {
+    srsran_assert(batch.empty(), "Batches can only be popped into empty lists");
+    uint64_t        old_head = head.load(std::memory_order_acquire);
+    batch_header_t* header   = nullptr;
+    do {
+      uint32_t idx = get_head_index(old_head);
+      if (idx == null_index) {
+        return false;
+      }
+      header            = get_header(idx);
+      uint32_t next_idx = header->next_batch.load(std::memory_order_relaxed);
+      if (head.compare_exchange_weak(old_head,
+                                     make_head(next_idx, get_head_version(old_head) + 1),
+                                     std::memory_order_acquire,
+                                     std::memory_order_acquire)) {
+        break;
+      }
+    } while (true);
+    batch.head  = &header->node;
+    batch.count = header->nof_blocks;
+    nof_blocks.fetch_sub(batch.count, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool empty() const noexcept { return get_head_index(head.load(std::memory_order_relaxed)) == null_index; }
+
+  /// Number of blocks in the stack. The value may be outdated if other threads are pushing/popping blocks.
+  size_t size() const noexcept { return nof_blocks.load(std::memory_order_relaxed); }
+
+private:
+  static uint64_t make_head(uint32_t idx, uint32_t version) { return (static_cast<uint64_t>(version) << 32U) | idx; }
+  static uint32_t get_head_index(uint64_t head_) { return static_cast<uint32_t>(head_); }
+  static uint32_t get_head_version(uint64_t head_) { return static_cast<uint32_t>(head_ >> 32U); }
+
+  uint32_t get_index(batch_header_t* header) const
+  {
+    return static_cast<uint32_t>((reinterpret_cast<uint8_t*>(header) - mem_start) / block_size);
+  }
+  batch_header_t* get_header(uint32_t idx) const
+  {
+    return reinterpret_cast<batch_header_t*>(mem_start + static_cast<size_t>(idx) * block_size);
+  }
+
+  uint8_t* const        mem_start;
+  const size_t          block_size;
+  std::atomic<uint64_t> head{make_head(null_index, 0)};
+  std::atomic<size_t>   nof_blocks{0};
+};
+
 /**
  * Manages the allocation, caching and deallocation of memory blocks.
  * On alloc, a memory block is stolen from cache. If cache is empty, malloc/new is called.
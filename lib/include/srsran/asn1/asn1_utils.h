@@ -22,6 +22,7 @@
 #ifndef SRSASN_COMMON_UTILS_H
 #define SRSASN_COMMON_UTILS_H
 
+#include "srsran/adt/pool/linear_allocator.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/support/srsran_assert.h"
 #include <algorithm>
@@ -31,6 +32,7 @@
 #include <cstring>
 #include <limits>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -187,6 +189,68 @@ public:
   SRSASN_CODE align_bytes_zero();
 };
 
+/************************
+      decode arena
+************************/
+
+/**
+ * Monotonic allocator for the dynamic arrays of decoded messages. Memory is taken from large blocks and is only
+ * given back in one step, when the arena is reset. The blocks are kept for the next decodes, so once the arena has
+ * grown to the size of the largest message, decoding does not call the heap allocator.
+ * The messages whose arrays were allocated in the arena must be destroyed before the arena is reset or destroyed.
+ */
+class decode_arena
+{
+public:
+  explicit decode_arena(size_t block_size_ = 4096) : block_size(block_size_) {}
+  decode_arena(const decode_arena&) = delete;
+  decode_arena& operator=(const decode_arena&) = delete;
+
+  void* allocate(size_t sz, size_t alignment);
+  void  reset();
+
+  size_t nof_bytes_allocated() const { return nof_bytes; }
+  size_t nof_blocks() const { return blocks.size(); }
+
+private:
+  struct memblock {
+    std::unique_ptr<uint8_t[]> data;
+    size_t                     size;
+  };
+
+  size_t                   block_size;
+  std::vector<memblock>    blocks;
+  size_t                   next_block = 0;
+  size_t                   nof_bytes  = 0;
+  srsran::linear_allocator cur_block;
+};
+
+/// Arena where the dynamic arrays are currently allocated by the calling thread, or nullptr for the heap
+decode_arena* get_current_decode_arena();
+
+/**
+ * While an object of this class is alive, the dynamic arrays (dyn_array, dyn_seq_of, dyn_octstring, ...) that the
+ * calling thread allocates, e.g. while unpacking a message, are placed in the given arena. Usage:
+ *   asn1::decode_arena arena;
+ *   {
+ *     asn1::decode_arena_scope scope(arena);
+ *     msg.unpack(bref);
+ *   }
+ *   ... use msg ...
+ * Scopes can be nested. Arrays that are resized after the scope ends move back to the heap.
+ */
+class decode_arena_scope
+{
+public:
+  explicit decode_arena_scope(decode_arena& arena);
+  ~decode_arena_scope();
+  decode_arena_scope(const decode_arena_scope&) = delete;
+  decode_arena_scope& operator=(const decode_arena_scope&) = delete;
+
+private:
+  decode_arena* prev_arena;
+};
+
 /*********************
   function helpers
 *********************/
@@ -198,20 +262,20 @@ public:
   using iterator       = T*;
   using const_iterator = const T*;
 
-  dyn_array() = default;
-  explicit dyn_array(uint32_t new_size) : size_(new_size), cap_(new_size) { data_ = new T[size_]; }
+  dyn_array() : cap_(0), in_arena_(0) {}
+  explicit dyn_array(uint32_t new_size) : size_(new_size), cap_(new_size) { data_ = allocate_(size_); }
   dyn_array(const dyn_array<T>& other) : dyn_array(&other[0], other.size_) {}
   dyn_array(const T* ptr, uint32_t nof_items)
   {
     size_ = nof_items;
     cap_  = nof_items;
-    data_ = new T[cap_];
+    data_ = allocate_(cap_);
     std::copy(ptr, ptr + size_, data_);
   }
   ~dyn_array()
   {
     if (data_ != NULL) {
-      delete[] data_;
+      deallocate_(data_, cap_, in_arena_);
     }
   }
   uint32_t      size() const { return size_; }
@@ -237,20 +301,23 @@ public:
       return;
     }
 
-    T* old_data = data_;
-    cap_        = new_size > new_cap ? new_size : new_cap;
+    T*       old_data     = data_;
+    uint32_t old_cap      = cap_;
+    bool     old_in_arena = in_arena_;
+    cap_                  = new_size > new_cap ? new_size : new_cap;
     if (cap_ > 0) {
-      data_ = new T[cap_];
+      data_ = allocate_(cap_);
       if (old_data != NULL) {
         srsran_assert(cap_ > size_, "Old size larger than new capacity in dyn_array\n");
         std::copy(&old_data[0], &old_data[size_], data_);
       }
     } else {
-      data_ = NULL;
+      data_     = NULL;
+      in_arena_ = 0;
     }
     size_ = new_size;
     if (old_data != NULL) {
-      delete[] old_data;
+      deallocate_(old_data, old_cap, old_in_arena);
     }
   }
   iterator erase(iterator it)
@@ -285,9 +352,35 @@ public:
   const_iterator end() const { return &data_[size()]; }
 
 private:
+  T* allocate_(uint32_t n)
+  {
+    decode_arena* arena = get_current_decode_arena();
+    in_arena_           = arena != nullptr;
+    if (arena == nullptr) {
+      return new T[n];
+    }
+    T* ptr = static_cast<T*>(arena->allocate(sizeof(T) * n, alignof(T)));
+    for (uint32_t i = 0; i < n; ++i) {
+      new (&ptr[i]) T();
+    }
+    return ptr;
+  }
+  static void deallocate_(T* ptr, uint32_t n, bool in_arena)
+  {
+    if (not in_arena) {
+      delete[] ptr;
+      return;
+    }
+    // The memory itself is given back when the arena is reset
+    for (uint32_t i = 0; i < n; ++i) {
+      ptr[i].~T();
+    }
+  }
+
   T*       data_ = nullptr;
   uint32_t size_ = 0;
-  uint32_t cap_  = 0;
+  uint32_t cap_ : 31;
+  uint32_t in_arena_ : 1; ///< Whether data_ was allocated in a decode_arena rather than in the heap
 };
 
 template <class T, uint32_t MAX_N>
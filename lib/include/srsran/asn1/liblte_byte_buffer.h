@@ -0,0 +1,68 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_LIBLTE_BYTE_BUFFER_H
+#define SRSRAN_LIBLTE_BYTE_BUFFER_H
+
+#include "srsran/asn1/liblte_common.h"
+#include "srsran/common/byte_buffer.h"
+#include "srsran/support/srsran_assert.h"
+
+namespace srsran {
+
+/**
+ * Passes a byte buffer to the liblte pack/unpack functions, which take a LIBLTE_BYTE_MSG_STRUCT.
+ * The byte buffer layout does not match the liblte message struct, as the buffer array is the last member of
+ * byte_buffer_t, so the message is copied in on construction and copied back on destruction. Used as a temporary
+ * argument, the message is copied back when the liblte call returns:
+ *
+ *   liblte_mme_pack_attach_request_msg(&attach_req, liblte_byte_msg_adapter(pdu.get()));
+ */
+class liblte_byte_msg_adapter
+{
+public:
+  explicit liblte_byte_msg_adapter(byte_buffer_t* buf_) : buf(buf_)
+  {
+    msg.N_bytes = buf->N_bytes;
+    memcpy(msg.msg, buf->msg, buf->N_bytes);
+  }
+  ~liblte_byte_msg_adapter()
+  {
+    srsran_assert(buf->get_headroom() + msg.N_bytes <= buf->get_buffer_size(),
+                  "Byte buffer of size=%d can not hold a NAS message of %d bytes",
+                  buf->get_buffer_size(),
+                  msg.N_bytes);
+    buf->N_bytes = msg.N_bytes;
+    memcpy(buf->msg, msg.msg, msg.N_bytes);
+  }
+  liblte_byte_msg_adapter(const liblte_byte_msg_adapter&) = delete;
+  liblte_byte_msg_adapter& operator=(const liblte_byte_msg_adapter&) = delete;
+
+  operator LIBLTE_BYTE_MSG_STRUCT*() { return &msg; }
+
+private:
+  byte_buffer_t*         buf;
+  LIBLTE_BYTE_MSG_STRUCT msg;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_LIBLTE_BYTE_BUFFER_H
@@ -25,6 +25,7 @@
 #include "byte_buffer.h"
 #include "srsran/adt/bounded_vector.h"
 #include <algorithm>
+#include <array>
 #include <map>
 #include <pthread.h>
 #include <stack>
@@ -166,13 +167,54 @@ private:
   uint32_t               capacity;
 };
 
-using byte_buffer_pool = concurrent_fixed_memory_pool<sizeof(byte_buffer_t)>;
+namespace detail {
+
+/// Header stored in front of each byte buffer in its pool block, holding the size class the block belongs to.
+union byte_buffer_block_header_t {
+  uint32_t        size_class;
+  max_alignment_t align;
+};
+
+/// Size of the pool blocks of a size class, made of the block header, the byte buffer members and the buffer array
+/// truncated to the headroom plus the size class payload.
+constexpr size_t byte_buffer_block_size(byte_buffer_size_class size_class)
+{
+  return sizeof(byte_buffer_block_header_t) + sizeof(byte_buffer_t) - SRSRAN_MAX_BUFFER_SIZE_BYTES +
+         SRSRAN_BUFFER_HEADER_OFFSET + byte_buffer_payload_size(size_class);
+}
+
+} // namespace detail
+
+using byte_buffer_pool =
+    concurrent_fixed_memory_pool<detail::byte_buffer_block_size(byte_buffer_size_class::jumbo)>;
+using small_byte_buffer_pool =
+    concurrent_fixed_memory_pool<detail::byte_buffer_block_size(byte_buffer_size_class::small)>;
+using mtu_byte_buffer_pool = concurrent_fixed_memory_pool<detail::byte_buffer_block_size(byte_buffer_size_class::mtu)>;
+
+/// Occupancy of the byte buffer pools, per size class.
+struct byte_buffer_pool_metrics_t {
+  struct size_class_metrics_t {
+    uint32_t payload_size    = 0;
+    uint32_t nof_buffers     = 0;
+    uint32_t nof_allocated   = 0;
+    uint64_t nof_allocations = 0; ///< Buffers allocated since startup
+  };
+  std::array<size_class_metrics_t, nof_byte_buffer_size_classes> size_classes;
+};
+
+byte_buffer_pool_metrics_t get_byte_buffer_pool_metrics();
 
 inline unique_byte_buffer_t make_byte_buffer() noexcept
 {
   return std::unique_ptr<byte_buffer_t>(new (std::nothrow) byte_buffer_t());
 }
 
+/// Creates a byte buffer with room for at least "capacity" payload bytes, taken from the smallest size class that fits.
+inline unique_byte_buffer_t make_byte_buffer(uint32_t capacity) noexcept
+{
+  return std::unique_ptr<byte_buffer_t>(byte_buffer_t::allocate(capacity));
+}
+
 inline unique_byte_buffer_t make_byte_buffer(uint32_t size, uint8_t value) noexcept
 {
   return std::unique_ptr<byte_buffer_t>(new (std::nothrow) byte_buffer_t(size, value));
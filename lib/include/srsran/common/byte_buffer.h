@@ -24,6 +24,7 @@
 
 #include "common.h"
 #include "srsran/adt/span.h"
+#include "srsran/support/srsran_assert.h"
 #include <chrono>
 #include <cstdint>
 
@@ -79,12 +80,27 @@ private:
 #endif
 };
 
+/// Size classes of the byte buffer pool. Each class is served by a separate fixed size memory pool.
+enum class byte_buffer_size_class : uint32_t { small, mtu, jumbo, nof_classes };
+
+const uint32_t nof_byte_buffer_size_classes = static_cast<uint32_t>(byte_buffer_size_class::nof_classes);
+
+/// Payload capacity, on top of the SRSRAN_BUFFER_HEADER_OFFSET headroom, of the buffers of a size class.
+constexpr uint32_t byte_buffer_payload_size(byte_buffer_size_class size_class)
+{
+  return size_class == byte_buffer_size_class::small ? 256
+         : size_class == byte_buffer_size_class::mtu ? 2048
+                                                      : SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+}
+
 /******************************************************************************
  * Byte buffer
  *
  * Generic byte buffer with headroom to accommodate packet headers and custom
  * copy constructors & assignment operators for quick copying. Byte buffer
  * holds a next pointer to support linked lists.
+ * Buffers allocated from the small and MTU pool size classes only own the
+ * first get_buffer_size() bytes of the buffer array.
  *****************************************************************************/
 class byte_buffer_t
 {
@@ -93,8 +109,7 @@ public:
   using const_iterator = const uint8_t*;
 
   uint32_t N_bytes = 0;
-  uint8_t  buffer[SRSRAN_MAX_BUFFER_SIZE_BYTES];
-  uint8_t* msg = nullptr;
+  uint8_t* msg     = nullptr;
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
   char debug_name[SRSRAN_BUFFER_POOL_LOG_NAME_LEN];
 #endif
@@ -128,6 +143,10 @@ public:
     // avoid self assignment
     if (&buf == this)
       return *this;
+    srsran_assert(SRSRAN_BUFFER_HEADER_OFFSET + buf.N_bytes <= buffer_size,
+                  "Byte buffer of size=%d can not hold %d bytes",
+                  buffer_size,
+                  buf.N_bytes);
     msg     = &buffer[SRSRAN_BUFFER_HEADER_OFFSET];
     N_bytes = buf.N_bytes;
     md      = buf.md;
@@ -143,7 +162,9 @@ public:
   }
   uint32_t get_headroom() { return msg - buffer; }
   // Returns the remaining space from what is reported to be the length of msg
-  uint32_t                  get_tailroom() const { return (sizeof(buffer) - (msg - buffer) - N_bytes); }
+  uint32_t                  get_tailroom() const { return (buffer_size - (msg - buffer) - N_bytes); }
+  // Returns the size of the buffer array owned by this byte buffer, headroom included
+  uint32_t                  get_buffer_size() const { return buffer_size; }
   std::chrono::microseconds get_latency_us() const { return md.tp.get_latency_us(); }
 
   std::chrono::high_resolution_clock::time_point get_timestamp() const { return md.tp.get_timestamp(); }
@@ -174,6 +195,27 @@ public:
   void* operator new[](size_t sz) = delete;
   void  operator delete(void* ptr);
   void  operator delete[](void* ptr) = delete;
+
+  /// Allocates a byte buffer from the smallest pool size class that fits "capacity" payload bytes after the
+  /// headroom. When the pool of that size class is depleted, the next larger size classes are tried.
+  static byte_buffer_t* allocate(uint32_t capacity) noexcept;
+
+private:
+  struct buffer_size_tag {
+    uint32_t value;
+  };
+  explicit byte_buffer_t(buffer_size_tag size_) : buffer_size(size_.value), msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET])
+  {
+#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
+    bzero(debug_name, SRSRAN_BUFFER_POOL_LOG_NAME_LEN);
+#endif
+  }
+
+  uint32_t buffer_size = SRSRAN_MAX_BUFFER_SIZE_BYTES;
+
+public:
+  // Note: must be the last member, as the pool size classes allocate the buffer array only up to buffer_size
+  uint8_t buffer[SRSRAN_MAX_BUFFER_SIZE_BYTES];
 };
 
 struct bit_buffer_t {
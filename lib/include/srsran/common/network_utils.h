@@ -120,6 +120,13 @@ public:
   /// Register (fd, callback). callback is called within socket thread when fd has data.
   virtual bool add_socket_handler(int fd, recv_callback_t handler) = 0;
 
+  /// Register (fd, callback) with edge-triggered notification. callback must read fd until it would block, as it is
+  /// only called again when new data arrives. Managers without edge-triggered support use add_socket_handler().
+  virtual bool add_socket_handler_edge_triggered(int fd, recv_callback_t handler)
+  {
+    return add_socket_handler(fd, std::move(handler));
+  }
+
   /// remove registered socket fd
   virtual bool remove_socket(int fd) = 0;
 
@@ -128,7 +135,7 @@ protected:
 };
 
 /**
- * Description - Instantiates a thread that will block waiting for IO from multiple sockets, via a select
+ * Description - Instantiates a thread that will block waiting for IO from multiple sockets, via epoll
  *               The user can register their own (socket fd, data handler) in this class via the
  *               add_socket_handler(fd, task) API or its other variants
  */
@@ -144,11 +151,18 @@ public:
   bool remove_socket_nonblocking(int fd, bool signal_completion = false);
   bool remove_socket(int fd) final;
   bool add_socket_handler(int fd, recv_callback_t handler) final;
+  bool add_socket_handler_edge_triggered(int fd, recv_callback_t handler) final;
 
   void run_thread() override;
 
 private:
-  const int thread_prio = 65;
+  const int thread_prio    = 65;
+  const int max_epoll_evts = 32;
+
+  struct socket_handler_t {
+    recv_callback_t callback;
+    bool            edge_triggered;
+  };
 
   // used to unlock select
   struct ctrl_cmd_t {
@@ -158,15 +172,17 @@ private:
     bool     signal_rm_complete;
     ctrl_cmd_t() { bzero(this, sizeof(ctrl_cmd_t)); }
   };
-  std::map<int, recv_callback_t>::iterator remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max_fd);
+  bool add_socket_handler_impl(int fd, recv_callback_t handler, bool edge_triggered);
+  void remove_socket_unprotected(int fd);
 
   // state
-  std::mutex                     socket_mutex;
-  std::map<int, recv_callback_t> active_sockets;
-  std::atomic<bool>              running   = {false};
-  int                            pipefd[2] = {-1, -1};
-  std::vector<int>               rem_fd_tmp_list;
-  std::condition_variable        rem_cvar;
+  std::mutex                      socket_mutex;
+  std::map<int, socket_handler_t> active_sockets;
+  std::atomic<bool>               running   = {false};
+  int                             pipefd[2] = {-1, -1};
+  int                             epoll_fd  = -1;
+  std::vector<int>                rem_fd_tmp_list;
+  std::condition_variable         rem_cvar;
 };
 
 /// Function signature for SDU byte buffers received from SCTP socket
@@ -196,6 +212,14 @@ make_sctp_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& q
 socket_manager_itf::recv_callback_t
 make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvfrom_callback_t rx_callback);
 
+/**
+ * Similar to make_sdu_handler, but for datagram sockets with high packet rates. Each call drains the socket with
+ * recvmmsg(...) calls of up to 32 SDUs, and each batch is dispatched into the "queue" as a single task that calls
+ * rx_callback for every SDU of the batch. Meant to be registered with add_socket_handler_edge_triggered().
+ */
+socket_manager_itf::recv_callback_t
+make_sdu_batch_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvfrom_callback_t rx_callback);
+
 } // namespace srsran
 
 #endif // SRSRAN_RX_SOCKET_HANDLER_H
@@ -29,6 +29,7 @@
 #include "srsran/common/common.h"
 #include "srsran/srslog/srslog.h"
 
+#include <memory>
 #include <vector>
 
 #define AKA_RAND_LEN 16
@@ -266,6 +267,54 @@ uint8_t security_128_eea3(uint8_t* key,
                           uint32_t msg_len,
                           uint8_t* msg_out);
 
+/******************************************************************************
+ * EEA2/EIA2 with a pre-expanded key
+ *****************************************************************************/
+/**
+ * AES-128 key schedule, expanded once when the key is set and reused by every EEA2/EIA2 operation under that key.
+ * It also holds the CMAC subkeys used by EIA2. The AES-NI (and VAES, when available) implementation is selected at
+ * build time, otherwise the SSL library is used.
+ */
+class security_aes128_key_t
+{
+public:
+  security_aes128_key_t();
+  ~security_aes128_key_t();
+  security_aes128_key_t(security_aes128_key_t&&) noexcept;
+  security_aes128_key_t& operator=(security_aes128_key_t&&) noexcept;
+
+  void set(const uint8_t* key);
+  bool is_set() const { return impl != nullptr; }
+
+  struct impl_t;
+  const impl_t* get() const { return impl.get(); }
+
+private:
+  std::unique_ptr<impl_t> impl;
+};
+
+/**
+ * EEA2 ciphering of msg_len bytes. msg_out may point to msg for in-place operation.
+ */
+uint8_t security_128_eea2(const security_aes128_key_t& key,
+                          uint32_t                     count,
+                          uint8_t                      bearer,
+                          uint8_t                      direction,
+                          const uint8_t*               msg,
+                          uint32_t                     msg_len,
+                          uint8_t*                     msg_out);
+
+/**
+ * EIA2 MAC of msg_len bytes, computed without copying the message.
+ */
+uint8_t security_128_eia2(const security_aes128_key_t& key,
+                          uint32_t                     count,
+                          uint32_t                     bearer,
+                          uint8_t                      direction,
+                          const uint8_t*               msg,
+                          uint32_t                     msg_len,
+                          uint8_t*                     mac);
+
 /******************************************************************************
  * Authentication
  *****************************************************************************/
@@ -29,6 +29,7 @@
 #include "srsenb/hdr/stack/mac/common/mac_metrics.h"
 #include "srsenb/hdr/stack/rrc/rrc_metrics.h"
 #include "srsenb/hdr/stack/s1ap/s1ap_metrics.h"
+#include "srsran/common/buffer_pool.h"
 #include "srsran/common/metrics_hub.h"
 #include "srsran/radio/radio_metrics.h"
 #include "srsran/rlc/rlc_metrics.h"
@@ -47,16 +48,18 @@ struct pdcp_metrics_t {
 };
 
 struct stack_metrics_t {
-  mac_metrics_t  mac;
-  rrc_metrics_t  rrc;
-  rlc_metrics_t  rlc;
-  pdcp_metrics_t pdcp;
-  s1ap_metrics_t s1ap;
+  mac_metrics_t                      mac;
+  rrc_metrics_t                      rrc;
+  rlc_metrics_t                      rlc;
+  pdcp_metrics_t                     pdcp;
+  s1ap_metrics_t                     s1ap;
+  srsran::byte_buffer_pool_metrics_t pool;
 };
 
 struct enb_metrics_t {
   srsran::rf_metrics_t       rf;
   std::vector<phy_metrics_t> phy;
+  phy_deadline_metrics_t     phy_deadline;
   stack_metrics_t            stack;
   stack_metrics_t            nr_stack;
   srsran::sys_metrics_t      sys;
@@ -23,6 +23,7 @@
 #define SRSRAN_UE_PDCP_INTERFACES_H
 
 #include "pdcp_interface_types.h"
+#include "srsran/adt/bounded_vector.h"
 #include "srsran/common/byte_buffer.h"
 
 namespace srsue {
@@ -72,9 +73,20 @@ public:
 class stack_interface_gw
 {
 public:
+  static const uint32_t max_sdu_batch_size = 32;
+  using sdu_batch_t                        = srsran::bounded_vector<srsran::unique_byte_buffer_t, max_sdu_batch_size>;
+
   virtual bool is_registered()         = 0;
   virtual bool start_service_request() = 0;
   virtual void write_sdu(uint32_t eps_bearer_id, srsran::unique_byte_buffer_t sdu) = 0;
+  ///< Push several SDUs of the same EPS bearer at once. The batch is left empty.
+  virtual void write_sdu_batch(uint32_t eps_bearer_id, sdu_batch_t& sdus)
+  {
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(eps_bearer_id, std::move(sdu));
+    }
+    sdus.clear();
+  }
   ///< Allow GW to query if a radio bearer for a given EPS bearer ID is currently active
   virtual bool has_active_radio_bearer(uint32_t eps_bearer_id) = 0;
 };
@@ -30,7 +30,10 @@
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/srslog/srslog.h"
 #include <memory>
+#include <semaphore.h>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace srsran {
 
@@ -41,6 +44,9 @@ public:
     // General
     bool enable = false;
 
+    // Process each antenna in its own thread
+    bool pipeline_enable = false;
+
     // AWGN options
     bool  awgn_enable            = false;
     float awgn_signal_power_dBfs = 0.0f;
@@ -76,18 +82,34 @@ public:
   void run(cf_t* in[SRSRAN_MAX_CHANNELS], cf_t* out[SRSRAN_MAX_CHANNELS], uint32_t len, const srsran_timestamp_t& t);
 
 private:
+  /// Runs the channel of one of the antennas, other than the first, in parallel with the others
+  struct coworker_t {
+    std::thread        thread;
+    sem_t              start      = {};
+    sem_t              finish     = {};
+    bool               quit       = false;
+    uint32_t           channel_id = 0;
+    cf_t*              in         = nullptr;
+    cf_t*              out        = nullptr;
+    uint32_t           len        = 0;
+    srsran_timestamp_t t          = {};
+  };
+
+  void run_channel(uint32_t i, cf_t* in, cf_t* out, uint32_t len, const srsran_timestamp_t& t);
+  void coworker_loop(coworker_t* w);
+
   srslog::basic_logger&    logger;
   float                    hst_init_phase              = 0.0f;
   srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS] = {};
   srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]  = {};
-  srsran_channel_awgn_t*   awgn                        = nullptr;
-  srsran_channel_hst_t*    hst                         = nullptr;
+  srsran_channel_awgn_t*   awgn[SRSRAN_MAX_CHANNELS]   = {};
+  srsran_channel_hst_t*    hst[SRSRAN_MAX_CHANNELS]    = {};
   srsran_channel_rlf_t*    rlf                         = nullptr;
-  cf_t*                    buffer_in                   = nullptr;
-  cf_t*                    buffer_out                  = nullptr;
   uint32_t                 nof_channels                = 0;
   uint32_t                 current_srate               = 0;
   args_t                   args                        = {};
+
+  std::vector<std::unique_ptr<coworker_t> > coworkers;
 };
 
 typedef std::unique_ptr<channel> channel_ptr;
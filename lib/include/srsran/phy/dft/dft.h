@@ -24,6 +24,7 @@
 
 #include "srsran/config.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 /**********************************************************************************************
  *  File:         dft.h
@@ -67,6 +68,17 @@ typedef struct SRSRAN_API {
   srsran_dft_mode_t mode;    // Complex/Real
 } srsran_dft_plan_t;
 
+/**
+ * Statistics of the process-wide FFTW plan cache. Plans describing the same transform (size, direction, strides and
+ * buffer layout) are created once and shared by all the srsran_dft_plan_t objects using them.
+ */
+typedef struct SRSRAN_API {
+  uint32_t nof_plans;        // Number of FFTW plans created since start
+  uint32_t nof_shared;       // Number of plan requests served from the cache
+  uint32_t nof_cached;       // Number of FFTW plans currently alive
+  uint64_t planning_time_us; // Accumulated time spent in the FFTW planner
+} srsran_dft_plan_stats_t;
+
 SRSRAN_API int srsran_dft_plan(srsran_dft_plan_t* plan, int dft_points, srsran_dft_dir_t dir, srsran_dft_mode_t type);
 
 SRSRAN_API int srsran_dft_plan_c(srsran_dft_plan_t* plan, int dft_points, srsran_dft_dir_t dir);
@@ -102,6 +114,11 @@ SRSRAN_API int srsran_dft_replan_r(srsran_dft_plan_t* plan, int new_dft_points);
 
 SRSRAN_API void srsran_dft_plan_free(srsran_dft_plan_t* plan);
 
+SRSRAN_API void srsran_dft_get_plan_stats(srsran_dft_plan_stats_t* stats);
+
+/* Writes the accumulated FFTW wisdom to the given file */
+SRSRAN_API int srsran_dft_export_wisdom(const char* filename);
+
 /* Set options */
 
 SRSRAN_API void srsran_dft_plan_set_mirror(srsran_dft_plan_t* plan, bool val);
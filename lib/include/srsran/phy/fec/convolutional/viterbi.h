@@ -34,6 +34,9 @@
 #include "srsran/config.h"
 #include <stdbool.h>
 
+/* Maximum number of frames that srsran_viterbi_decode_f_multi() decodes at once */
+#define SRSRAN_VITERBI_MAX_STREAMS 16
+
 typedef enum { SRSRAN_VITERBI_27 = 0, SRSRAN_VITERBI_29, SRSRAN_VITERBI_37, SRSRAN_VITERBI_39 } srsran_viterbi_type_t;
 
 typedef struct SRSRAN_API {
@@ -52,6 +55,8 @@ typedef struct SRSRAN_API {
   uint16_t* tmp_s;
   uint8_t*  symbols_uc;
   uint16_t* symbols_us;
+  void*     ptr_multi;
+  uint16_t* symbols_multi;
 } srsran_viterbi_t;
 
 SRSRAN_API int srsran_viterbi_init(srsran_viterbi_t*     q,
@@ -74,6 +79,21 @@ SRSRAN_API int srsran_viterbi_decode_us(srsran_viterbi_t* q, uint16_t* symbols,
 
 SRSRAN_API int srsran_viterbi_decode_uc(srsran_viterbi_t* q, uint8_t* symbols, uint8_t* data, uint32_t frame_length);
 
+/**
+ * Decodes several frames of the same length. The result is equivalent to calling srsran_viterbi_decode_f() for each
+ * frame, but if the platform has a multi-stream decoder, up to SRSRAN_VITERBI_MAX_STREAMS frames are decoded at once.
+ * @param symbols Real-valued symbols of each frame
+ * @param data Decoded bits of each frame
+ * @param nof_frames Number of frames, any number is accepted
+ * @param frame_length Number of bits of every frame
+ * @return SRSRAN_SUCCESS or SRSRAN_ERROR if the frame length exceeds the one given at initialization
+ */
+SRSRAN_API int srsran_viterbi_decode_f_multi(srsran_viterbi_t* q,
+                                             float*            symbols[],
+                                             uint8_t*          data[],
+                                             uint32_t          nof_frames,
+                                             uint32_t          frame_length);
+
 SRSRAN_API int srsran_viterbi_init_sse(srsran_viterbi_t*     q,
                                        srsran_viterbi_type_t type,
                                        int                   poly[3],
@@ -0,0 +1,91 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+/*!
+ * \file ldpc_decoder_cache.h
+ * \brief Declaration of a process-wide cache of LDPC decoders.
+ *
+ * Decoders are grouped in entries keyed by their configuration arguments (type, base graph, lifting size, scaling
+ * factor and maximum number of iterations). Entries are created on first request and reference counted, so that all
+ * the shared channel objects using the same configuration share them. Since the decoder registers are modified while
+ * decoding, every entry keeps a pool of decoder instances that are lent out for the duration of a decoding operation;
+ * the pool only grows when several threads decode with the same configuration concurrently.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#ifndef SRSRAN_LDPC_DECODER_CACHE_H
+#define SRSRAN_LDPC_DECODER_CACHE_H
+
+#include "srsran/phy/fec/ldpc/ldpc_decoder.h"
+
+/*!
+ * \brief Opaque LDPC decoder cache entry.
+ */
+typedef struct srsran_ldpc_decoder_cache_entry_s srsran_ldpc_decoder_cache_entry_t;
+
+/*!
+ * Looks up the cache entry matching the given decoder arguments, creating it if it does not exist, and takes a
+ * reference on it. No decoder is initialised until the first call to srsran_ldpc_decoder_cache_acquire().
+ * \param[in] args LDPC decoder configuration arguments.
+ * \return A pointer to the cache entry, NULL if an error occurred.
+ */
+SRSRAN_API srsran_ldpc_decoder_cache_entry_t* srsran_ldpc_decoder_cache_get(const srsran_ldpc_decoder_args_t* args);
+
+/*!
+ * Drops a reference taken with srsran_ldpc_decoder_cache_get(). The entry and all its decoders are freed when the
+ * last reference is dropped.
+ * \param[in] entry A pointer to the cache entry.
+ */
+SRSRAN_API void srsran_ldpc_decoder_cache_put(srsran_ldpc_decoder_cache_entry_t* entry);
+
+/*!
+ * Borrows a decoder from the entry for exclusive use by the calling thread, initialising a new one if all the
+ * decoders of the entry are in use.
+ * \param[in] entry A pointer to the cache entry.
+ * \return A pointer to the decoder, NULL if an error occurred.
+ */
+SRSRAN_API srsran_ldpc_decoder_t* srsran_ldpc_decoder_cache_acquire(srsran_ldpc_decoder_cache_entry_t* entry);
+
+/*!
+ * Returns a decoder obtained with srsran_ldpc_decoder_cache_acquire() to its entry.
+ * \param[in] entry A pointer to the cache entry.
+ * \param[in] decoder A pointer to the decoder.
+ */
+SRSRAN_API void srsran_ldpc_decoder_cache_release(srsran_ldpc_decoder_cache_entry_t* entry,
+                                                  srsran_ldpc_decoder_t*             decoder);
+
+/*!
+ * Gets the number of decoders currently initialised in the cache.
+ * \return The number of decoders.
+ */
+SRSRAN_API uint32_t srsran_ldpc_decoder_cache_nof_decoders();
+
+/*!
+ * Gets an estimate of the memory held by the cache, accounting for the decoder objects, their parity check matrices
+ * and their working registers.
+ * \return The number of bytes.
+ */
+SRSRAN_API uint64_t srsran_ldpc_decoder_cache_nbytes();
+
+#endif // SRSRAN_LDPC_DECODER_CACHE_H
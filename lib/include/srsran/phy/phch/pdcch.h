@@ -45,6 +45,9 @@
 #include "srsran/phy/phch/regs.h"
 #include "srsran/phy/scrambling/scrambling.h"
 
+/* Maximum number of candidates that srsran_pdcch_decode_msg_multi() decodes in a call */
+#define SRSRAN_PDCCH_MAX_CANDIDATES_MULTI 128
+
 typedef enum SRSRAN_API { SEARCH_UE, SEARCH_COMMON } srsran_pdcch_search_mode_t;
 
 /* PDCCH object */
@@ -65,6 +68,7 @@ typedef struct SRSRAN_API {
   cf_t*    d;
   uint8_t* e;
   float    rm_f[3 * (SRSRAN_DCI_MAX_BITS + 16)];
+  float*   rm_f_multi;
   float*   llr;
 
   /* tx & rx objects */
@@ -104,6 +108,25 @@ SRSRAN_API int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
 SRSRAN_API int
 srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dci_cfg_t* dci_cfg, srsran_dci_msg_t* msg);
 
+/**
+ * @brief Decodes several DCI candidates after calling srsran_pdcch_extract_llr(), as srsran_pdcch_decode_msg() does
+ * for each of them. Locations without energy are dropped before decoding, a location and size pair is only decoded once
+ * and the remaining candidates of the same size are decoded together by the multi-stream Viterbi decoder.
+ * Only available in UE PDCCH objects.
+ * @param q PDCCH object
+ * @param sf Subframe configuration
+ * @param dci_cfg DCI configuration
+ * @param msgs Candidates to decode, with the location and format set. The payload, nof_bits and CRC remainder (rnti)
+ * are set on return. Candidates that were dropped have nof_bits set to 0
+ * @param nof_msgs Number of candidates, up to SRSRAN_PDCCH_MAX_CANDIDATES_MULTI
+ * @return SRSRAN_SUCCESS if the candidates were processed, an error code otherwise
+ */
+SRSRAN_API int srsran_pdcch_decode_msg_multi(srsran_pdcch_t*     q,
+                                             srsran_dl_sf_cfg_t* sf,
+                                             srsran_dci_cfg_t*   dci_cfg,
+                                             srsran_dci_msg_t*   msgs,
+                                             uint32_t            nof_msgs);
+
 /**
  * @brief Computes decoded DCI correlation. It encodes the given DCI message and compares it with the received LLRs
  * @param q PDCCH object
@@ -48,6 +48,9 @@
 #define SRSRAN_TX_NULL 100
 #endif
 
+/* Maximum number of threads helping a shared channel to decode the code blocks of a transport block */
+#define SRSRAN_SCH_MAX_CB_COWORKERS 8
+
 /* DL-SCH AND UL-SCH common functions */
 typedef struct SRSRAN_API {
 
@@ -71,12 +74,26 @@ typedef struct SRSRAN_API {
 
   srsran_uci_cqi_pusch_t uci_cqi;
 
+  /* Optional code block decoding coworkers */
+  void*    cb_coworkers;
+  uint32_t nof_cb_coworkers;
+
 } srsran_sch_t;
 
 SRSRAN_API int srsran_sch_init(srsran_sch_t* q);
 
 SRSRAN_API void srsran_sch_free(srsran_sch_t* q);
 
+/**
+ * @brief Starts nof_coworkers threads, each with its own turbo decoder, that decode the code blocks of a transport
+ * block in parallel with the calling thread. Code block CRC flags and decoded data are merged before the decode call
+ * returns. Setting nof_coworkers to 0 stops them and returns to sequential decoding.
+ * @return SRSRAN_SUCCESS if the coworkers are running, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_sch_enable_cb_coworkers(srsran_sch_t* q, uint32_t nof_coworkers);
+
+SRSRAN_API void srsran_sch_disable_cb_coworkers(srsran_sch_t* q);
+
 SRSRAN_API void srsran_sch_set_max_noi(srsran_sch_t* q, uint32_t max_iterations);
 
 SRSRAN_API float srsran_sch_last_noi(srsran_sch_t* q);
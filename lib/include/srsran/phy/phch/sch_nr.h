@@ -34,6 +34,7 @@
 #include "srsran/phy/common/phy_common_nr.h"
 #include "srsran/phy/fec/crc.h"
 #include "srsran/phy/fec/ldpc/ldpc_decoder.h"
+#include "srsran/phy/fec/ldpc/ldpc_decoder_cache.h"
 #include "srsran/phy/fec/ldpc/ldpc_encoder.h"
 #include "srsran/phy/fec/ldpc/ldpc_rm.h"
 #include "srsran/phy/phch/phch_cfg_nr.h"
@@ -69,9 +70,10 @@ typedef struct SRSRAN_API {
   srsran_ldpc_encoder_t* encoder_bg1[MAX_LIFTSIZE + 1];
   srsran_ldpc_encoder_t* encoder_bg2[MAX_LIFTSIZE + 1];
 
-  /// LDPC decoders
-  srsran_ldpc_decoder_t* decoder_bg1[MAX_LIFTSIZE + 1];
-  srsran_ldpc_decoder_t* decoder_bg2[MAX_LIFTSIZE + 1];
+  /// LDPC decoders, taken from the shared decoder cache the first time a base graph and lifting size is decoded
+  srsran_ldpc_decoder_args_t         decoder_args;
+  srsran_ldpc_decoder_cache_entry_t* decoder_bg1[MAX_LIFTSIZE + 1];
+  srsran_ldpc_decoder_cache_entry_t* decoder_bg2[MAX_LIFTSIZE + 1];
 
   /// LDPC Rate matcher
   srsran_ldpc_rm_t tx_rm;
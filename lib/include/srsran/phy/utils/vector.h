@@ -188,6 +188,8 @@ SRSRAN_API void srsran_vec_lut_sis(const short* x, const unsigned int* lut, shor
 
 /* vector product (element-wise) */
 SRSRAN_API void srsran_vec_prod_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t len);
+/* element-wise product scaled by a complex scalar, z = x * y * h */
+SRSRAN_API void srsran_vec_prod_sc_ccc(const cf_t* x, const cf_t* y, const cf_t h, cf_t* z, const uint32_t len);
 SRSRAN_API void srsran_vec_prod_ccc_split(const float*   x_re,
                                           const float*   x_im,
                                           const float*   y_re,
@@ -88,6 +88,8 @@ SRSRAN_API void srsran_vec_prod_fff_simd(const float* x, const float* y, float*
 
 SRSRAN_API void srsran_vec_prod_ccc_simd(const cf_t* x, const cf_t* y, cf_t* z, const int len);
 
+SRSRAN_API void srsran_vec_prod_sc_ccc_simd(const cf_t* x, const cf_t* y, const cf_t h, cf_t* z, const int len);
+
 SRSRAN_API void srsran_vec_prod_conj_ccc_simd(const cf_t* x, const cf_t* y, cf_t* z, const int len);
 
 /* SIMD Division */
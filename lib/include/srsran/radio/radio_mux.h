@@ -0,0 +1,122 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file radio_mux.h
+ * @brief Shares a single radio between several PHY instances
+ */
+
+#ifndef SRSRAN_RADIO_MUX_H
+#define SRSRAN_RADIO_MUX_H
+
+#include "srsran/interfaces/radio_interfaces.h"
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/radio/rf_buffer.h"
+#include "srsran/srslog/srslog.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Multiplexes a single radio, running at a fixed sampling rate, between several PHY instances. Each PHY is given a
+ * port, which implements the radio interface on top of the shared radio:
+ * - The received samples are stored in a ring buffer. Every port reads it at its own pace and sampling rate. The
+ *   radio is only read when a port asks for samples that have not been received yet. A port that falls behind the ring
+ *   buffer is moved to the most recent samples and notified with an overflow.
+ * - The transmitted samples of all the ports are added up in a ring buffer, indexed by their transmission time. The
+ *   radio transmits the ring buffer as a single continuous stream once every port had the chance to write its
+ *   samples. Samples that arrive too late are dropped.
+ */
+class radio_mux : public phy_interface_radio
+{
+public:
+  /**
+   * @param radio_ Shared radio. Before the ports are used, it must be initialised with this object as PHY and its
+   * sampling rate set to srate_hz_
+   * @param srate_hz_ Sampling rate of the shared radio
+   * @param nof_channels_ Number of RF channels of every port
+   * @param nof_ports_ Number of ports
+   */
+  radio_mux(radio_interface_phy& radio_, double srate_hz_, uint32_t nof_channels_, uint32_t nof_ports_);
+  ~radio_mux();
+
+  radio_mux(const radio_mux&) = delete;
+  radio_mux& operator=(const radio_mux&) = delete;
+
+  /// Returns the radio interface of a port
+  radio_interface_phy* get_port(uint32_t port_idx);
+
+  /// Sets the PHY that is notified of the overflows and failures of a port
+  void set_phy(uint32_t port_idx, phy_interface_radio* phy);
+
+  // phy_interface_radio, called by the shared radio
+  void radio_overflow() override;
+  void radio_failure() override;
+
+private:
+  class port_t;
+
+  bool    rx(port_t& port, rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time);
+  bool    tx(port_t& port, rf_buffer_interface& buffer, const rf_timestamp_interface& tx_time);
+  bool    receive(uint32_t nof_samples);
+  void    flush_tx(uint64_t end);
+  void    set_rx_freq(uint32_t carrier_idx, double freq);
+  void    set_tx_freq(uint32_t carrier_idx, double freq);
+  int64_t get_index(const srsran_timestamp_t& ts) const;
+  void    get_timestamp(uint64_t index, srsran_timestamp_t* ts) const;
+
+  srslog::basic_logger& logger;
+  radio_interface_phy&  radio;
+  const double          srate_hz;
+  const uint32_t        nof_channels;
+  const uint32_t        rx_ring_len;
+  const uint32_t        tx_ring_len;
+  const uint32_t        tx_advance;
+
+  std::vector<std::unique_ptr<port_t> > ports;
+
+  // Received samples, the sample with index n is stored in the position n % rx_ring_len. The time reference is
+  // written holding both mutexes
+  std::mutex                      rx_mutex;
+  std::vector<std::vector<cf_t> > rx_ring;
+  std::vector<std::vector<cf_t> > rx_tmp;
+  bool                            rx_started = false;
+  uint64_t                        rx_head    = 0;  ///< Index of the next sample to receive
+  srsran_timestamp_t              base_ts    = {}; ///< Time of the sample with index 0
+
+  // Samples to transmit, the sample with index n is stored in the position n % tx_ring_len
+  std::mutex                      tx_mutex;
+  std::vector<std::vector<cf_t> > tx_ring;
+  bool                            tx_started = false;
+  uint64_t                        tx_flushed = 0; ///< Index of the next sample to transmit
+  uint64_t                        nof_late   = 0; ///< Number of samples dropped because they arrived too late
+
+  // Current radio frequencies, to avoid setting them again for every port
+  std::mutex          freq_mutex;
+  std::vector<double> rx_freq;
+  std::vector<double> tx_freq;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_RADIO_MUX_H
@@ -98,8 +98,34 @@ struct rlc_amd_rx_pdu {
   explicit rlc_amd_rx_pdu(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
 };
 
+/// RLC AM PDU segment received, kept in the list of segments of its SN until the full PDU can be reconstructed
+struct rlc_amd_rx_pdu_segment : public intrusive_double_linked_list_element<>, public intrusive_forward_list_element<> {
+  rlc_amd_pdu_header_t header;
+  unique_byte_buffer_t buf;
+};
+
+/// Segments received of a RLC PDU, sorted by segment offset
 struct rlc_amd_rx_pdu_segments_t {
-  std::list<rlc_amd_rx_pdu> segments;
+  intrusive_double_linked_list<rlc_amd_rx_pdu_segment> segments;
+};
+
+/// Pool of the RLC AM Rx PDU segments. It grows on demand, and the segments are returned to it once their PDU is
+/// reconstructed or leaves the Rx window. Thus, no allocations take place once the pool holds as many segments as the
+/// peak number of segments pending reassembly
+class rlc_am_rx_segment_pool
+{
+public:
+  rlc_am_rx_segment_pool()                              = default;
+  rlc_am_rx_segment_pool(const rlc_am_rx_segment_pool&) = delete;
+  rlc_am_rx_segment_pool& operator=(const rlc_am_rx_segment_pool&) = delete;
+
+  rlc_amd_rx_pdu_segment* allocate();
+  void                    deallocate(rlc_amd_rx_pdu_segment* segment);
+  size_t                  size() const { return segments.size(); }
+
+private:
+  std::deque<rlc_amd_rx_pdu_segment>             segments;
+  intrusive_forward_list<rlc_amd_rx_pdu_segment> free_list;
 };
 
 /// Class that contains the parameters and state (e.g. segments) of a RLC PDU
@@ -508,8 +534,12 @@ private:
     void reassemble_rx_sdus();
     bool inside_rx_window(const int16_t sn);
     void debug_state();
+    bool accept_data_pdu(uint32_t nof_bytes, rlc_amd_pdu_header_t& header);
+    void insert_data_pdu(unique_byte_buffer_t pdu, rlc_amd_pdu_header_t& header);
     void print_rx_segments();
-    bool add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_amd_rx_pdu* segment);
+    bool add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_amd_rx_pdu_segment* segment);
+    void erase_rx_segments(uint32_t sn);
+    void clear_rx_segments();
     void reset_status();
 
     rlc_am_lte*           parent = nullptr;
@@ -541,8 +571,10 @@ private:
     std::mutex mutex;
 
     // Rx windows
-    rlc_ringbuffer_t<rlc_amd_rx_pdu>              rx_window;
-    std::map<uint32_t, rlc_amd_rx_pdu_segments_t> rx_segments;
+    rlc_ringbuffer_t<rlc_amd_rx_pdu> rx_window;
+    // The segment pool outlives the segment lists that point to its segments
+    rlc_am_rx_segment_pool                                                               segment_pool;
+    srsran::static_circular_map<uint32_t, rlc_amd_rx_pdu_segments_t, RLC_AM_WINDOW_SIZE> rx_segments;
 
     bool              poll_received = false;
     std::atomic<bool> do_status     = {false}; // light-weight access from Tx entity
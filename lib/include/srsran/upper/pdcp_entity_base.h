@@ -169,6 +169,10 @@ protected:
 
   srsran::as_security_config_t sec_cfg = {};
 
+  // EEA2/EIA2 key schedules, expanded once in config_security()
+  srsran::security_aes128_key_t aes_key_enc;
+  srsran::security_aes128_key_t aes_key_int;
+
   // Security functions
   void integrity_generate(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
   bool integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
@@ -113,6 +113,84 @@ map_enum_number<const float>(const float* array, uint32_t nof_types, uint32_t en
        bit_ref
 *********************/
 
+// The bit_ref methods below assemble each field in a 64-bit word, rather than processing it one byte at a time, and
+// check the buffer bounds once per field. Word loads that would cross the end of the buffer fall back to byte loads.
+
+static inline uint64_t load_be64(const uint8_t* ptr)
+{
+  uint64_t word;
+  memcpy(&word, ptr, sizeof(word));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  word = __builtin_bswap64(word);
+#endif
+  return word;
+}
+
+static inline void store_be64(uint8_t* ptr, uint64_t word)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  word = __builtin_bswap64(word);
+#endif
+  memcpy(ptr, &word, sizeof(word));
+}
+
+/// Number of bytes spanned by a field of "n_bits" that starts at bit "offset" of a byte
+static inline uint32_t nof_bytes_spanned(uint32_t offset, uint32_t n_bits)
+{
+  return (offset + n_bits + 7) / 8;
+}
+
+/// Read a field of 1 to 64 bits that starts at bit "offset" of "ptr". The bounds must be checked by the caller
+static uint64_t read_bits(const uint8_t* ptr, uint32_t offset, uint32_t n_bits, const uint8_t* max_ptr)
+{
+  uint32_t end_bit = offset + n_bits;
+  uint64_t word;
+  if (ptr + sizeof(uint64_t) <= max_ptr) {
+    word = load_be64(ptr);
+  } else {
+    word = 0;
+    for (uint32_t i = 0, nof_bytes = std::min(nof_bytes_spanned(offset, n_bits), 8u); i < nof_bytes; ++i) {
+      word |= static_cast<uint64_t>(ptr[i]) << (56u - 8u * i);
+    }
+  }
+  uint64_t val = (word << offset) >> (64u - n_bits);
+  if (end_bit > 64) {
+    // The field spills into a ninth byte
+    val |= ptr[8] >> (72u - end_bit);
+  }
+  return val;
+}
+
+/// Write a field that starts at bit "offset" of "ptr" and does not go past the eighth byte
+static inline void write_word_bits(uint8_t* ptr, uint32_t offset, uint64_t val, uint32_t n_bits)
+{
+  uint32_t end_bit = offset + n_bits;
+  // Note: The word is stored byte by byte, rather than with a read-modify-write of 64 bits, to avoid stalls when the
+  // next field is packed into the same bytes
+  uint64_t word = (val & (std::numeric_limits<uint64_t>::max() >> (64u - n_bits))) << (64u - end_bit);
+  if (offset > 0) {
+    word |= (static_cast<uint64_t>(*ptr) << 56u) & ~(std::numeric_limits<uint64_t>::max() >> offset);
+  }
+  for (uint32_t i = 0, nof_bytes = nof_bytes_spanned(offset, n_bits); i < nof_bytes; ++i) {
+    ptr[i] = static_cast<uint8_t>(word >> (56u - 8u * i));
+  }
+}
+
+/// Write a field of 1 to 64 bits that starts at bit "offset" of "ptr". The bits of the first byte that precede the
+/// field are preserved, the remaining bits of the last byte are zeroed, and the bytes that follow are not touched.
+/// The bounds must be checked by the caller
+static void write_bits(uint8_t* ptr, uint32_t offset, uint64_t val, uint32_t n_bits)
+{
+  uint32_t end_bit = offset + n_bits;
+  if (end_bit <= 64) {
+    write_word_bits(ptr, offset, val, n_bits);
+  } else {
+    // The field spills into a ninth byte. Write its last byte separately
+    write_word_bits(ptr, offset, val >> 8u, n_bits - 8);
+    write_word_bits(ptr + 7, end_bit - 64, val & 0xffu, 8);
+  }
+}
+
 template <typename Ptr>
 int bit_ref_impl<Ptr>::distance(const bit_ref_impl<Ptr>& other) const
 {
@@ -146,32 +224,27 @@ int bit_ref_impl<Ptr>::distance_bytes_end() const
 
 SRSASN_CODE bit_ref::pack(uint64_t val, uint32_t n_bits)
 {
-  if (n_bits >= 64) {
+  if (n_bits > 64) {
     log_error("This method only supports packing up to 64 bits");
     return SRSASN_ERROR_ENCODE_FAIL;
   }
-  uint64_t mask;
-  while (n_bits > 0) {
-    if (ptr >= max_ptr) {
-      log_error("Buffer size limit was achieved");
-      return SRSASN_ERROR_ENCODE_FAIL;
-    }
-    mask             = ((1ul << n_bits) - 1ul);
-    val              = val & mask;
-    uint8_t keepmask = ((uint8_t)-1) - (uint8_t)((1u << (8u - offset)) - 1u);
-    if ((uint32_t)(8 - offset) > n_bits) {
-      auto bit = static_cast<uint8_t>(val << (8u - offset - n_bits));
-      *ptr     = ((*ptr) & keepmask) + bit;
-      offset += n_bits;
-      n_bits = 0;
-    } else {
-      auto bit = static_cast<uint8_t>(val >> (n_bits - 8u + offset));
-      *ptr     = (*ptr & keepmask) + bit;
-      n_bits -= (8 - offset);
-      offset = 0;
-      ptr++;
-    }
+  if (n_bits == 0) {
+    return SRSASN_SUCCESS;
+  }
+  uint32_t end_bit = offset + n_bits;
+  if (ptr + nof_bytes_spanned(offset, n_bits) > max_ptr) {
+    log_error("Buffer size limit was achieved");
+    return SRSASN_ERROR_ENCODE_FAIL;
   }
+  if (end_bit <= 8) {
+    // Most PER fields (flags, choices, enums) fit in the current byte
+    auto keepmask = static_cast<uint8_t>(0xff00u >> offset);
+    *ptr          = (*ptr & keepmask) | static_cast<uint8_t>((val & ((1u << n_bits) - 1u)) << (8u - end_bit));
+  } else {
+    write_bits(ptr, offset, val, n_bits);
+  }
+  ptr += end_bit / 8;
+  offset = end_bit % 8;
   return SRSASN_SUCCESS;
 }
 
@@ -183,24 +256,22 @@ SRSASN_CODE unpack_bits(T& val, Ptr& ptr, uint8_t& offset, const uint8_t* max_pt
     return SRSASN_ERROR_DECODE_FAIL;
   }
   val = 0;
-  while (n_bits > 0) {
-    if (ptr >= max_ptr) {
-      log_error("Buffer size limit was achieved");
-      return SRSASN_ERROR_DECODE_FAIL;
-    }
-    if ((uint32_t)(8 - offset) > n_bits) {
-      uint8_t mask = (uint8_t)(1u << (8u - offset)) - (uint8_t)(1u << (8u - offset - n_bits));
-      val += ((uint32_t)((*ptr) & mask)) >> (8u - offset - n_bits);
-      offset += n_bits;
-      n_bits = 0;
-    } else {
-      auto mask = static_cast<uint8_t>((1u << (8u - offset)) - 1u);
-      val += ((uint32_t)((*ptr) & mask)) << (n_bits - 8 + offset);
-      n_bits -= 8 - offset;
-      offset = 0;
-      ptr++;
-    }
+  if (n_bits == 0) {
+    return SRSASN_SUCCESS;
   }
+  uint32_t end_bit = offset + n_bits;
+  if (ptr + nof_bytes_spanned(offset, n_bits) > max_ptr) {
+    log_error("Buffer size limit was achieved");
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  if (end_bit <= 8) {
+    // Most PER fields (flags, choices, enums) fit in the current byte
+    val = static_cast<T>((*ptr >> (8u - end_bit)) & ((1u << n_bits) - 1u));
+  } else {
+    val = static_cast<T>(read_bits(ptr, offset, n_bits, max_ptr));
+  }
+  ptr += end_bit / 8;
+  offset = end_bit % 8;
   return SRSASN_SUCCESS;
 }
 
@@ -260,8 +331,16 @@ SRSASN_CODE bit_ref_impl<Ptr>::unpack_bytes(uint8_t* buf, uint32_t n_bytes)
       log_error("Buffer size limit was achieved");
       return SRSASN_ERROR_DECODE_FAIL;
     }
-    for (uint32_t i = 0; i < n_bytes; ++i) {
-      HANDLE_CODE(unpack(buf[i], 8));
+    for (; n_bytes >= sizeof(uint64_t); n_bytes -= sizeof(uint64_t), buf += sizeof(uint64_t)) {
+      store_be64(buf, read_bits(ptr, offset, 64, max_ptr));
+      ptr += sizeof(uint64_t);
+    }
+    if (n_bytes > 0) {
+      uint64_t word = read_bits(ptr, offset, 8 * n_bytes, max_ptr);
+      for (uint32_t i = 0; i < n_bytes; ++i) {
+        buf[i] = static_cast<uint8_t>(word >> (8u * (n_bytes - 1 - i)));
+      }
+      ptr += n_bytes;
     }
   }
   return SRSASN_SUCCESS;
@@ -285,8 +364,8 @@ template <typename Ptr>
 SRSASN_CODE bit_ref_impl<Ptr>::advance_bits(uint32_t n_bits)
 {
   uint32_t extra_bits     = (offset + n_bits) % 8;
-  uint32_t bytes_required = ceilf((offset + n_bits) / 8.0f);
-  uint32_t bytes_offset   = floorf((offset + n_bits) / 8.0f);
+  uint32_t bytes_required = nof_bytes_spanned(offset, n_bits);
+  uint32_t bytes_offset   = (offset + n_bits) / 8;
 
   if (ptr + bytes_required > max_ptr) {
     log_error("Buffer size limit was achieved");
@@ -323,8 +402,17 @@ SRSASN_CODE bit_ref::pack_bytes(const uint8_t* buf, uint32_t n_bytes)
     memcpy(ptr, buf, n_bytes);
     ptr += n_bytes;
   } else {
-    for (uint32_t i = 0; i < n_bytes; ++i) {
-      pack(buf[i], 8);
+    for (; n_bytes >= sizeof(uint64_t); n_bytes -= sizeof(uint64_t), buf += sizeof(uint64_t)) {
+      write_bits(ptr, offset, load_be64(buf), 64);
+      ptr += sizeof(uint64_t);
+    }
+    if (n_bytes > 0) {
+      uint64_t word = 0;
+      for (uint32_t i = 0; i < n_bytes; ++i) {
+        word = (word << 8u) | buf[i];
+      }
+      write_bits(ptr, offset, word, 8 * n_bytes);
+      ptr += n_bytes;
     }
   }
   return SRSASN_SUCCESS;
@@ -345,6 +433,56 @@ SRSASN_CODE bit_ref::align_bytes_zero()
   return SRSASN_SUCCESS;
 }
 
+/************************
+      decode arena
+************************/
+
+static thread_local decode_arena* current_decode_arena = nullptr;
+
+void* decode_arena::allocate(size_t sz, size_t alignment)
+{
+  void* ptr = cur_block.allocate(sz, alignment);
+  // Move to the next block with enough space. Only allocate a new one when all the blocks were used
+  while (ptr == nullptr and next_block < blocks.size()) {
+    memblock& b = blocks[next_block++];
+    cur_block   = srsran::linear_allocator(b.data.get(), b.size);
+    ptr         = cur_block.allocate(sz, alignment);
+  }
+  if (ptr == nullptr) {
+    size_t   new_size = std::max(block_size, sz + alignment);
+    memblock b{std::unique_ptr<uint8_t[]>(new uint8_t[new_size]), new_size};
+    cur_block = srsran::linear_allocator(b.data.get(), b.size);
+    blocks.push_back(std::move(b));
+    next_block = blocks.size();
+    ptr        = cur_block.allocate(sz, alignment);
+  }
+  nof_bytes += sz;
+  return ptr;
+}
+
+void decode_arena::reset()
+{
+  srsran_assert(current_decode_arena != this, "Resetting a decode arena that is still in use");
+  cur_block  = srsran::linear_allocator();
+  next_block = 0;
+  nof_bytes  = 0;
+}
+
+decode_arena* get_current_decode_arena()
+{
+  return current_decode_arena;
+}
+
+decode_arena_scope::decode_arena_scope(decode_arena& arena) : prev_arena(current_decode_arena)
+{
+  current_decode_arena = &arena;
+}
+
+decode_arena_scope::~decode_arena_scope()
+{
+  current_decode_arena = prev_arena;
+}
+
 /*********************
      ext packing
 *********************/
@@ -24,16 +24,85 @@
 
 namespace srsran {
 
+namespace {
+
+using block_header_t = detail::byte_buffer_block_header_t;
+
+uint32_t get_size_class_buffer_size(uint32_t size_class)
+{
+  return SRSRAN_BUFFER_HEADER_OFFSET + byte_buffer_payload_size(static_cast<byte_buffer_size_class>(size_class));
+}
+
+uint32_t get_size_class(uint32_t capacity)
+{
+  for (uint32_t size_class = 0; size_class < nof_byte_buffer_size_classes; ++size_class) {
+    if (capacity <= byte_buffer_payload_size(static_cast<byte_buffer_size_class>(size_class))) {
+      return size_class;
+    }
+  }
+  return nof_byte_buffer_size_classes;
+}
+
+void* allocate_block(uint32_t size_class)
+{
+  void* block = nullptr;
+  switch (static_cast<byte_buffer_size_class>(size_class)) {
+    case byte_buffer_size_class::small:
+      block = small_byte_buffer_pool::get_instance()->allocate_node(small_byte_buffer_pool::BLOCK_SIZE);
+      break;
+    case byte_buffer_size_class::mtu:
+      block = mtu_byte_buffer_pool::get_instance()->allocate_node(mtu_byte_buffer_pool::BLOCK_SIZE);
+      break;
+    default:
+      block = byte_buffer_pool::get_instance()->allocate_node(byte_buffer_pool::BLOCK_SIZE);
+      break;
+  }
+  if (block == nullptr) {
+    return nullptr;
+  }
+  static_cast<block_header_t*>(block)->size_class = size_class;
+  return static_cast<uint8_t*>(block) + sizeof(block_header_t);
+}
+
+void deallocate_block(void* ptr)
+{
+  void*    block      = static_cast<uint8_t*>(ptr) - sizeof(block_header_t);
+  uint32_t size_class = static_cast<block_header_t*>(block)->size_class;
+  switch (static_cast<byte_buffer_size_class>(size_class)) {
+    case byte_buffer_size_class::small:
+      small_byte_buffer_pool::get_instance()->deallocate_node(block);
+      break;
+    case byte_buffer_size_class::mtu:
+      mtu_byte_buffer_pool::get_instance()->deallocate_node(block);
+      break;
+    default:
+      byte_buffer_pool::get_instance()->deallocate_node(block);
+      break;
+  }
+}
+
+template <typename Pool>
+void fill_size_class_metrics(byte_buffer_pool_metrics_t& metrics, byte_buffer_size_class size_class)
+{
+  byte_buffer_pool_metrics_t::size_class_metrics_t& m = metrics.size_classes[static_cast<uint32_t>(size_class)];
+  m.payload_size                                      = byte_buffer_payload_size(size_class);
+  m.nof_buffers                                       = Pool::get_instance()->size();
+  m.nof_allocated                                     = Pool::get_instance()->nof_allocated_blocks();
+  m.nof_allocations                                   = Pool::get_instance()->nof_total_allocations();
+}
+
+} // namespace
+
 void* byte_buffer_t::operator new(size_t sz, const std::nothrow_t& nothrow_value) noexcept
 {
   assert(sz == sizeof(byte_buffer_t));
-  return byte_buffer_pool::get_instance()->allocate_node(sz);
+  return allocate_block(static_cast<uint32_t>(byte_buffer_size_class::jumbo));
 }
 
 void* byte_buffer_t::operator new(size_t sz)
 {
   assert(sz == sizeof(byte_buffer_t));
-  void* ptr = byte_buffer_pool::get_instance()->allocate_node(sz);
+  void* ptr = allocate_block(static_cast<uint32_t>(byte_buffer_size_class::jumbo));
   if (ptr == nullptr) {
     throw std::bad_alloc();
   }
@@ -42,7 +111,28 @@ void* byte_buffer_t::operator new(size_t sz)
 
 void byte_buffer_t::operator delete(void* ptr)
 {
-  byte_buffer_pool::get_instance()->deallocate_node(ptr);
+  deallocate_block(ptr);
+}
+
+byte_buffer_t* byte_buffer_t::allocate(uint32_t capacity) noexcept
+{
+  for (uint32_t size_class = get_size_class(capacity); size_class < nof_byte_buffer_size_classes; ++size_class) {
+    void* ptr = allocate_block(size_class);
+    if (ptr != nullptr) {
+      // placement new of the global scope, as the class-specific operator new hides it
+      return ::new (ptr) byte_buffer_t(buffer_size_tag{get_size_class_buffer_size(size_class)});
+    }
+  }
+  return nullptr;
+}
+
+byte_buffer_pool_metrics_t get_byte_buffer_pool_metrics()
+{
+  byte_buffer_pool_metrics_t metrics;
+  fill_size_class_metrics<small_byte_buffer_pool>(metrics, byte_buffer_size_class::small);
+  fill_size_class_metrics<mtu_byte_buffer_pool>(metrics, byte_buffer_size_class::mtu);
+  fill_size_class_metrics<byte_buffer_pool>(metrics, byte_buffer_size_class::jumbo);
+  return metrics;
 }
 
 } // namespace srsran
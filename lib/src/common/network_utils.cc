@@ -21,7 +21,10 @@
 
 #include "srsran/common/network_utils.h"
 
+#include <array>
+#include <memory>
 #include <netinet/sctp.h>
+#include <sys/epoll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h> // for the pipe
@@ -356,6 +359,13 @@ socket_manager::socket_manager() : thread("RXsockets"), socket_manager_itf(srslo
   // register control pipe fd
   int fd = pipe(pipefd);
   srsran_assert(fd != -1, "Failed to open control pipe");
+  epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  srsran_assert(epoll_fd != -1, "Failed to create epoll instance");
+  struct epoll_event ev = {};
+  ev.events             = EPOLLIN;
+  ev.data.fd            = pipefd[0];
+  fd                    = epoll_ctl(epoll_fd, EPOLL_CTL_ADD, pipefd[0], &ev);
+  srsran_assert(fd != -1, "Failed to register control pipe");
   start(thread_prio);
 }
 
@@ -387,9 +397,23 @@ void socket_manager::stop()
     pipefd[1] = -1;
     rxSockDebug("closed.");
   }
+  if (epoll_fd >= 0) {
+    close(epoll_fd);
+    epoll_fd = -1;
+  }
 }
 
 bool socket_manager::add_socket_handler(int fd, recv_callback_t handler)
+{
+  return add_socket_handler_impl(fd, std::move(handler), false);
+}
+
+bool socket_manager::add_socket_handler_edge_triggered(int fd, recv_callback_t handler)
+{
+  return add_socket_handler_impl(fd, std::move(handler), true);
+}
+
+bool socket_manager::add_socket_handler_impl(int fd, recv_callback_t handler, bool edge_triggered)
 {
   std::lock_guard<std::mutex> lock(socket_mutex);
   if (fd < 0) {
@@ -401,7 +425,10 @@ bool socket_manager::add_socket_handler(int fd, recv_callback_t handler)
     return false;
   }
 
-  active_sockets.insert(std::make_pair(fd, std::move(handler)));
+  socket_handler_t entry;
+  entry.callback       = std::move(handler);
+  entry.edge_triggered = edge_triggered;
+  active_sockets.insert(std::make_pair(fd, std::move(entry)));
 
   // this unlocks the reading thread to add new connections
   ctrl_cmd_t msg;
@@ -412,7 +439,7 @@ bool socket_manager::add_socket_handler(int fd, recv_callback_t handler)
     return false;
   }
 
-  rxSockDebug("socket fd=%d has been registered.", fd);
+  rxSockDebug("socket fd=%d has been registered%s.", fd, edge_triggered ? " (edge-triggered)" : "");
   return true;
 }
 
@@ -451,68 +478,63 @@ bool socket_manager::remove_socket(int fd)
   return result;
 }
 
-std::map<int, socket_manager::recv_callback_t>::iterator
-socket_manager::remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max_fd)
+void socket_manager::remove_socket_unprotected(int fd)
 {
   if (fd < 0) {
     rxSockError("fd to be removed is not valid");
-    return active_sockets.end();
+    return;
   }
-  auto it = active_sockets.find(fd);
-  it      = active_sockets.erase(it);
-  FD_CLR(fd, total_fd_set);
-  // assumes ordering
-  *max_fd = (active_sockets.empty()) ? pipefd[0] : std::max(pipefd[0], active_sockets.rbegin()->first);
+  active_sockets.erase(fd);
+  // The fd may have already been closed by its owner, in which case epoll has dropped it already
+  epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
   rxSockDebug("Socket fd=%d has been successfully removed", fd);
-  return it;
 }
 
 void socket_manager::run_thread()
 {
   running = true;
-  fd_set total_fd_set, read_fd_set;
-  FD_ZERO(&total_fd_set);
-  int max_fd = 0;
-
-  FD_SET(pipefd[0], &total_fd_set);
-  max_fd = std::max(pipefd[0], max_fd);
+  std::vector<struct epoll_event> events(max_epoll_evts);
 
   while (running.load(std::memory_order_relaxed)) {
-    memcpy(&read_fd_set, &total_fd_set, sizeof(total_fd_set));
-    int n = select(max_fd + 1, &read_fd_set, nullptr, nullptr, nullptr);
+    int n = epoll_wait(epoll_fd, events.data(), max_epoll_evts, -1);
 
-    // handle select return
+    // handle epoll_wait return
     if (n == -1) {
-      rxSockError("Error from select(%d,...). Number of rx sockets: %d", max_fd + 1, (int)active_sockets.size() + 1);
+      if (errno != EINTR) {
+        rxSockError("Error from epoll_wait. Number of rx sockets: %d", (int)active_sockets.size() + 1);
+      }
       continue;
     }
     if (n == 0) {
-      rxSockDebug("No data from select.");
+      rxSockDebug("No data from epoll_wait.");
       continue;
     }
 
     // Shared state area
     std::lock_guard<std::mutex> lock(socket_mutex);
 
-    // call read callback for all SCTP/TCP/UDP connections
-    for (auto handler_it = active_sockets.begin(); handler_it != active_sockets.end();) {
-      int              fd       = handler_it->first;
-      recv_callback_t& callback = handler_it->second;
-      if (not FD_ISSET(fd, &read_fd_set)) {
-        ++handler_it;
+    // call read callback for all SCTP/TCP/UDP connections with events
+    bool ctrl_pending = false;
+    for (int i = 0; i < n; ++i) {
+      int fd = events[i].data.fd;
+      if (fd == pipefd[0]) {
+        ctrl_pending = true;
+        continue;
+      }
+      auto handler_it = active_sockets.find(fd);
+      if (handler_it == active_sockets.end()) {
+        // removed while handling a previous event of this batch
         continue;
       }
-      bool socket_valid = callback(fd);
+      bool socket_valid = handler_it->second.callback(fd);
       if (not socket_valid) {
         rxSockInfo("The socket fd=%d has been closed by peer", fd);
-        handler_it = remove_socket_unprotected(fd, &total_fd_set, &max_fd);
-      } else {
-        ++handler_it;
+        remove_socket_unprotected(fd);
       }
     }
 
     // handle ctrl messages
-    if (FD_ISSET(pipefd[0], &read_fd_set)) {
+    if (ctrl_pending) {
       ctrl_cmd_t msg;
       ssize_t    nrd = read(pipefd[0], &msg, sizeof(msg));
       if (nrd <= 0) {
@@ -523,21 +545,25 @@ void socket_manager::run_thread()
         case ctrl_cmd_t::cmd_id_t::EXIT:
           running = false;
           return;
-        case ctrl_cmd_t::cmd_id_t::NEW_FD:
-          if (msg.new_fd >= 0) {
-            FD_SET(msg.new_fd, &total_fd_set);
-            max_fd = std::max(max_fd, msg.new_fd);
-          } else {
+        case ctrl_cmd_t::cmd_id_t::NEW_FD: {
+          auto handler_it = active_sockets.find(msg.new_fd);
+          if (handler_it == active_sockets.end()) {
             rxSockError("added fd is not valid");
+            break;
           }
-          break;
+          struct epoll_event ev = {};
+          ev.events             = EPOLLIN | (handler_it->second.edge_triggered ? EPOLLET : 0);
+          ev.data.fd            = msg.new_fd;
+          if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, msg.new_fd, &ev) == -1) {
+            rxSockError("Failed to register fd=%d in epoll: %s", msg.new_fd, strerror(errno));
+          }
+        } break;
         case ctrl_cmd_t::cmd_id_t::RM_FD:
-          remove_socket_unprotected(msg.new_fd, &total_fd_set, &max_fd);
+          remove_socket_unprotected(msg.new_fd);
           if (msg.signal_rm_complete) {
             rem_fd_tmp_list.push_back(msg.new_fd);
             rem_cvar.notify_one();
           }
-          rxSockDebug("Socket fd=%d has been successfully removed", msg.new_fd);
           break;
         default:
           rxSockError("ctrl message command %d is not valid", (int)msg.cmd);
@@ -657,4 +683,102 @@ make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue,
   return socket_manager_itf::recv_callback_t(recvfrom_pdu_task(logger, queue, std::move(rx_callback)));
 }
 
+/**
+ * Description: Functor that drains a datagram socket with recvmmsg(...) calls, and pushes each received batch of
+ * unique_byte_buffers to the queue as a single task
+ */
+class recvmmsg_pdu_batch_task
+{
+public:
+  using callback_t                = recvfrom_callback_t;
+  static const uint32_t max_batch = 32;
+
+  explicit recvmmsg_pdu_batch_task(srslog::basic_logger& logger, srsran::task_queue_handle& queue_, callback_t func_) :
+    logger(logger), queue(queue_), func(std::move(func_)), state(new batch_state_t)
+  {}
+
+  bool operator()(int fd)
+  {
+    // Edge-triggered, so the socket is read until it would block
+    while (true) {
+      uint32_t nof_bufs = 0;
+      for (; nof_bufs < max_batch; ++nof_bufs) {
+        srsran::unique_byte_buffer_t& pdu = state->pdus[nof_bufs];
+        if (pdu == nullptr) {
+          pdu = srsran::make_byte_buffer();
+          if (pdu == nullptr) {
+            break;
+          }
+        }
+        state->iovs[nof_bufs].iov_base           = pdu->msg;
+        state->iovs[nof_bufs].iov_len            = pdu->get_tailroom();
+        state->msgs[nof_bufs]                    = {};
+        state->msgs[nof_bufs].msg_hdr.msg_name    = &state->from[nof_bufs];
+        state->msgs[nof_bufs].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        state->msgs[nof_bufs].msg_hdr.msg_iov     = &state->iovs[nof_bufs];
+        state->msgs[nof_bufs].msg_hdr.msg_iovlen  = 1;
+      }
+      if (nof_bufs == 0) {
+        logger.error("Unable to allocate byte buffer");
+        return true;
+      }
+
+      int n_recv = recvmmsg(fd, state->msgs.data(), nof_bufs, MSG_DONTWAIT, nullptr);
+      if (n_recv == -1) {
+        if (errno != EAGAIN and errno != EWOULDBLOCK) {
+          logger.error("Error reading from socket: %s", strerror(errno));
+        }
+        return true;
+      }
+
+      // Move the received SDUs to a batch. Unused buffers stay for the next call
+      std::unique_ptr<rx_batch_t> batch(new rx_batch_t);
+      batch->nof_pdus = n_recv;
+      for (int i = 0; i < n_recv; ++i) {
+        state->pdus[i]->N_bytes = state->msgs[i].msg_len;
+        batch->pdus[i]          = std::move(state->pdus[i]);
+        batch->from[i]          = state->from[i];
+      }
+
+      // Defer handling of received batch to provided queue
+      queue.push(std::bind(
+          [this](std::unique_ptr<rx_batch_t>& b) {
+            for (uint32_t i = 0; i < b->nof_pdus; ++i) {
+              func(std::move(b->pdus[i]), b->from[i]);
+            }
+          },
+          std::move(batch)));
+
+      if ((uint32_t)n_recv < nof_bufs) {
+        // socket drained
+        return true;
+      }
+    }
+  }
+
+private:
+  struct rx_batch_t {
+    uint32_t                                            nof_pdus = 0;
+    std::array<srsran::unique_byte_buffer_t, max_batch> pdus;
+    std::array<sockaddr_in, max_batch>                  from;
+  };
+  struct batch_state_t {
+    std::array<srsran::unique_byte_buffer_t, max_batch> pdus;
+    std::array<sockaddr_in, max_batch>                  from;
+    std::array<struct iovec, max_batch>                 iovs;
+    std::array<struct mmsghdr, max_batch>               msgs;
+  };
+
+  srslog::basic_logger&          logger;
+  srsran::task_queue_handle&     queue;
+  callback_t                     func;
+  std::unique_ptr<batch_state_t> state;
+};
+
+socket_manager_itf::recv_callback_t
+make_sdu_batch_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvfrom_callback_t rx_callback)
+{
+  return socket_manager_itf::recv_callback_t(recvmmsg_pdu_batch_task(logger, queue, std::move(rx_callback)));
+}
+
 } // namespace srsran
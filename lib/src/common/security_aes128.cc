@@ -0,0 +1,301 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * EEA2 (AES-128 CTR) and EIA2 (AES-128 CMAC) with a pre-expanded key.
+ *
+ * Document Reference: 33.401 v13.1.0 Annex B.1.3 and B.2.3
+ *                     RFC4493
+ *****************************************************************************/
+
+#include "srsran/common/liblte_security.h"
+#include "srsran/common/security.h"
+#include "srsran/common/ssl.h"
+
+#include <string.h>
+
+#ifdef __AES__
+#include <immintrin.h>
+#endif // __AES__
+
+namespace srsran {
+
+struct security_aes128_key_t::impl_t {
+#ifdef __AES__
+  __m128i rk[11]; ///< Round keys
+#else
+  aes_context ctx; ///< SSL library context, kept on the heap so its internal round key pointer stays valid
+#endif
+  uint8_t k1[16]; ///< CMAC subkey K1
+  uint8_t k2[16]; ///< CMAC subkey K2
+};
+
+#ifdef __AES__
+#define AES128_EXPAND(RK, RCON)                                                                                        \
+  do {                                                                                                                 \
+    __m128i t = _mm_shuffle_epi32(_mm_aeskeygenassist_si128((RK)[0], (RCON)), _MM_SHUFFLE(3, 3, 3, 3));                \
+    __m128i k = (RK)[0];                                                                                               \
+    k         = _mm_xor_si128(k, _mm_slli_si128(k, 4));                                                                \
+    k         = _mm_xor_si128(k, _mm_slli_si128(k, 4));                                                                \
+    k         = _mm_xor_si128(k, _mm_slli_si128(k, 4));                                                                \
+    (RK)[1]   = _mm_xor_si128(k, t);                                                                                   \
+  } while (false)
+
+static inline __m128i aes128_encrypt(const __m128i* rk, __m128i x)
+{
+  x = _mm_xor_si128(x, rk[0]);
+  for (uint32_t r = 1; r < 10; r++) {
+    x = _mm_aesenc_si128(x, rk[r]);
+  }
+  return _mm_aesenclast_si128(x, rk[10]);
+}
+#endif // __AES__
+
+static inline void aes128_encrypt_block(const security_aes128_key_t::impl_t* impl, const uint8_t* in, uint8_t* out)
+{
+#ifdef __AES__
+  _mm_storeu_si128((__m128i*)out, aes128_encrypt(impl->rk, _mm_loadu_si128((const __m128i*)in)));
+#else
+  aes_crypt_ecb(const_cast<aes_context*>(&impl->ctx), AES_ENCRYPT, in, out);
+#endif
+}
+
+// Left shift by one bit of a 128-bit string, as used for the CMAC subkey generation
+static void cmac_subkey(const uint8_t* in, uint8_t* out)
+{
+  for (uint32_t i = 0; i < 15; i++) {
+    out[i] = (in[i] << 1) | ((in[i + 1] >> 7) & 0x01);
+  }
+  out[15] = in[15] << 1;
+  if (in[0] & 0x80) {
+    out[15] ^= 0x87;
+  }
+}
+
+security_aes128_key_t::security_aes128_key_t() = default;
+
+security_aes128_key_t::~security_aes128_key_t() = default;
+
+security_aes128_key_t::security_aes128_key_t(security_aes128_key_t&&) noexcept = default;
+
+security_aes128_key_t& security_aes128_key_t::operator=(security_aes128_key_t&&) noexcept = default;
+
+void security_aes128_key_t::set(const uint8_t* key)
+{
+  if (impl == nullptr) {
+    impl.reset(new impl_t);
+  }
+
+#ifdef __AES__
+  impl->rk[0] = _mm_loadu_si128((const __m128i*)key);
+  AES128_EXPAND(&impl->rk[0], 0x01);
+  AES128_EXPAND(&impl->rk[1], 0x02);
+  AES128_EXPAND(&impl->rk[2], 0x04);
+  AES128_EXPAND(&impl->rk[3], 0x08);
+  AES128_EXPAND(&impl->rk[4], 0x10);
+  AES128_EXPAND(&impl->rk[5], 0x20);
+  AES128_EXPAND(&impl->rk[6], 0x40);
+  AES128_EXPAND(&impl->rk[7], 0x80);
+  AES128_EXPAND(&impl->rk[8], 0x1b);
+  AES128_EXPAND(&impl->rk[9], 0x36);
+#else
+  aes_setkey_enc(&impl->ctx, key, 128);
+#endif
+
+  // CMAC subkeys
+  uint8_t const_zero[16] = {};
+  uint8_t L[16];
+  aes128_encrypt_block(impl.get(), const_zero, L);
+  cmac_subkey(L, impl->k1);
+  cmac_subkey(impl->k1, impl->k2);
+}
+
+uint8_t security_128_eea2(const security_aes128_key_t& key,
+                          uint32_t                     count,
+                          uint8_t                      bearer,
+                          uint8_t                      direction,
+                          const uint8_t*               msg,
+                          uint32_t                     msg_len,
+                          uint8_t*                     msg_out)
+{
+  const security_aes128_key_t::impl_t* impl = key.get();
+  if (impl == nullptr || msg == nullptr || msg_out == nullptr) {
+    return LIBLTE_ERROR_INVALID_INPUTS;
+  }
+
+  // Construct nonce, the lower 64 bits hold the block counter
+  uint8_t nonce_cnt[16] = {};
+  nonce_cnt[0]          = (count >> 24) & 0xFF;
+  nonce_cnt[1]          = (count >> 16) & 0xFF;
+  nonce_cnt[2]          = (count >> 8) & 0xFF;
+  nonce_cnt[3]          = (count)&0xFF;
+  nonce_cnt[4]          = ((bearer & 0x1F) << 3) | ((direction & 0x01) << 2);
+
+#ifdef __AES__
+  const __m128i* rk = impl->rk;
+  int64_t        nh;
+  memcpy(&nh, nonce_cnt, sizeof(nh));
+
+  uint64_t i   = 0;
+  uint32_t off = 0;
+
+#if defined(__VAES__) && defined(__AVX512F__)
+  // Eight counter blocks per iteration in two 512-bit registers
+  __m512i rk512[11];
+  for (uint32_t r = 0; r < 11; r++) {
+    rk512[r] = _mm512_broadcast_i32x4(rk[r]);
+  }
+  for (; off + 128 <= msg_len; off += 128, i += 8) {
+    __m512i c0 = _mm512_set_epi64(__builtin_bswap64(i + 3),
+                                  nh,
+                                  __builtin_bswap64(i + 2),
+                                  nh,
+                                  __builtin_bswap64(i + 1),
+                                  nh,
+                                  __builtin_bswap64(i),
+                                  nh);
+    __m512i c1 = _mm512_set_epi64(__builtin_bswap64(i + 7),
+                                  nh,
+                                  __builtin_bswap64(i + 6),
+                                  nh,
+                                  __builtin_bswap64(i + 5),
+                                  nh,
+                                  __builtin_bswap64(i + 4),
+                                  nh);
+    c0         = _mm512_xor_si512(c0, rk512[0]);
+    c1         = _mm512_xor_si512(c1, rk512[0]);
+    for (uint32_t r = 1; r < 10; r++) {
+      c0 = _mm512_aesenc_epi128(c0, rk512[r]);
+      c1 = _mm512_aesenc_epi128(c1, rk512[r]);
+    }
+    c0 = _mm512_aesenclast_epi128(c0, rk512[10]);
+    c1 = _mm512_aesenclast_epi128(c1, rk512[10]);
+    _mm512_storeu_si512((void*)&msg_out[off], _mm512_xor_si512(c0, _mm512_loadu_si512((const void*)&msg[off])));
+    _mm512_storeu_si512((void*)&msg_out[off + 64],
+                        _mm512_xor_si512(c1, _mm512_loadu_si512((const void*)&msg[off + 64])));
+  }
+#endif // defined(__VAES__) && defined(__AVX512F__)
+
+  // Four independent counter blocks per iteration to fill the AES pipeline
+  for (; off + 64 <= msg_len; off += 64, i += 4) {
+    __m128i c[4];
+    for (uint32_t j = 0; j < 4; j++) {
+      c[j] = _mm_xor_si128(_mm_set_epi64x(__builtin_bswap64(i + j), nh), rk[0]);
+    }
+    for (uint32_t r = 1; r < 10; r++) {
+      for (uint32_t j = 0; j < 4; j++) {
+        c[j] = _mm_aesenc_si128(c[j], rk[r]);
+      }
+    }
+    for (uint32_t j = 0; j < 4; j++) {
+      c[j] = _mm_aesenclast_si128(c[j], rk[10]);
+      _mm_storeu_si128((__m128i*)&msg_out[off + 16 * j],
+                       _mm_xor_si128(c[j], _mm_loadu_si128((const __m128i*)&msg[off + 16 * j])));
+    }
+  }
+
+  for (; off + 16 <= msg_len; off += 16, i++) {
+    __m128i c = aes128_encrypt(rk, _mm_set_epi64x(__builtin_bswap64(i), nh));
+    _mm_storeu_si128((__m128i*)&msg_out[off], _mm_xor_si128(c, _mm_loadu_si128((const __m128i*)&msg[off])));
+  }
+
+  // Last partial block
+  if (off < msg_len) {
+    uint8_t stream_blk[16];
+    _mm_storeu_si128((__m128i*)stream_blk, aes128_encrypt(rk, _mm_set_epi64x(__builtin_bswap64(i), nh)));
+    for (uint32_t j = 0; off + j < msg_len; j++) {
+      msg_out[off + j] = msg[off + j] ^ stream_blk[j];
+    }
+  }
+#else
+  uint8_t stream_blk[16] = {};
+  size_t  nc_off         = 0;
+  if (aes_crypt_ctr(const_cast<aes_context*>(&impl->ctx), msg_len, &nc_off, nonce_cnt, stream_blk, msg, msg_out) !=
+      0) {
+    return LIBLTE_ERROR_INVALID_INPUTS;
+  }
+#endif // __AES__
+
+  return LIBLTE_SUCCESS;
+}
+
+uint8_t security_128_eia2(const security_aes128_key_t& key,
+                          uint32_t                     count,
+                          uint32_t                     bearer,
+                          uint8_t                      direction,
+                          const uint8_t*               msg,
+                          uint32_t                     msg_len,
+                          uint8_t*                     mac)
+{
+  const security_aes128_key_t::impl_t* impl = key.get();
+  if (impl == nullptr || msg == nullptr || mac == nullptr) {
+    return LIBLTE_ERROR_INVALID_INPUTS;
+  }
+
+  // The MAC is computed over M = COUNT | BEARER | DIRECTION | 0 (64 bits) | msg. Every block of M but the first one is
+  // read straight from the message.
+  uint32_t M_len = msg_len + 8;
+  uint32_t n     = (M_len + 15) / 16;
+
+  uint8_t T[16] = {};
+  uint8_t tmp[16];
+
+  for (uint32_t i = 0; i < n; i++) {
+    uint32_t blk_len = (i < n - 1) ? 16 : M_len - 16 * i;
+
+    // Gather block of M
+    if (i == 0) {
+      memset(tmp, 0, sizeof(tmp));
+      tmp[0] = (count >> 24) & 0xFF;
+      tmp[1] = (count >> 16) & 0xFF;
+      tmp[2] = (count >> 8) & 0xFF;
+      tmp[3] = count & 0xFF;
+      tmp[4] = (bearer << 3) | (direction << 2);
+      memcpy(&tmp[8], msg, blk_len - 8);
+    } else {
+      memcpy(tmp, &msg[16 * i - 8], blk_len);
+    }
+
+    // Last block, padded if incomplete and combined with the corresponding subkey
+    if (i == n - 1) {
+      const uint8_t* K = impl->k1;
+      if (blk_len < 16) {
+        memset(&tmp[blk_len], 0, 16 - blk_len);
+        tmp[blk_len] = 0x80;
+        K            = impl->k2;
+      }
+      for (uint32_t j = 0; j < 16; j++) {
+        tmp[j] ^= K[j];
+      }
+    }
+
+    for (uint32_t j = 0; j < 16; j++) {
+      tmp[j] ^= T[j];
+    }
+    aes128_encrypt_block(impl, tmp, T);
+  }
+
+  memcpy(mac, T, 4);
+
+  return LIBLTE_SUCCESS;
+}
+
+} // namespace srsran
@@ -44,6 +44,14 @@ void pdcp_entity_base::config_security(const as_security_config_t& sec_cfg_)
   logger.debug(sec_cfg.k_up_enc.data(), 32, "K_up_enc");
   logger.debug(sec_cfg.k_rrc_int.data(), 32, "K_rrc_int");
   logger.debug(sec_cfg.k_up_int.data(), 32, "K_up_int");
+
+  // Expand the AES keys here rather than for every PDU. If control plane use RRC keys. If data use user plane keys
+  if (sec_cfg.cipher_algo == CIPHERING_ALGORITHM_ID_128_EEA2) {
+    aes_key_enc.set(is_srb() ? &sec_cfg.k_rrc_enc[16] : &sec_cfg.k_up_enc[16]);
+  }
+  if (sec_cfg.integ_algo == INTEGRITY_ALGORITHM_ID_128_EIA2) {
+    aes_key_int.set(is_srb() ? &sec_cfg.k_rrc_int[16] : &sec_cfg.k_up_int[16]);
+  }
 }
 
 /****************************************************************************
@@ -67,7 +75,7 @@ void pdcp_entity_base::integrity_generate(uint8_t* msg, uint32_t msg_len, uint32
       security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
+      security_128_eia2(aes_key_int, count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA3:
       security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
@@ -105,7 +113,7 @@ bool pdcp_entity_base::integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t
       security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
+      security_128_eia2(aes_key_int, count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA3:
       security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
@@ -162,8 +170,8 @@ void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t c
       memcpy(ct, ct_tmp, msg_len);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
-      memcpy(ct, ct_tmp, msg_len);
+      // Works in place, no intermediate copy needed
+      security_128_eea2(aes_key_enc, count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA3:
       security_128_eea3(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
@@ -202,8 +210,8 @@ void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t cou
       memcpy(msg, msg_tmp, ct_len);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
-      memcpy(msg, msg_tmp, ct_len);
+      // Works in place, no intermediate copy needed
+      security_128_eea2(aes_key_enc, count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA3:
       security_128_eea3(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
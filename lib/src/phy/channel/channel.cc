@@ -28,9 +28,8 @@ using namespace srsran;
 channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, srslog::basic_logger& logger) :
   logger(logger)
 {
-  int      ret         = SRSRAN_SUCCESS;
-  uint32_t srate_max   = (uint32_t)srsran_symbol_sz(SRSRAN_MAX_PRB) * 15000;
-  uint32_t buffer_size = (uint32_t)SRSRAN_SF_LEN_PRB(SRSRAN_MAX_PRB) * 5; // be safe, 5 Subframes
+  int      ret       = SRSRAN_SUCCESS;
+  uint32_t srate_max = (uint32_t)srsran_symbol_sz(SRSRAN_MAX_PRB) * 15000;
 
   if (_nof_channels > SRSRAN_MAX_CHANNELS) {
     fprintf(stderr,
@@ -43,13 +42,6 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
   // Copy args
   args = channel_args;
 
-  // Allocate internal buffers
-  buffer_in  = srsran_vec_cf_malloc(buffer_size);
-  buffer_out = srsran_vec_cf_malloc(buffer_size);
-  if (!buffer_out || !buffer_in) {
-    ret = SRSRAN_ERROR;
-  }
-
   nof_channels = _nof_channels;
   for (uint32_t i = 0; i < nof_channels; i++) {
     // Create fading channel
@@ -73,19 +65,19 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
     } else {
       delay[i] = nullptr;
     }
-  }
 
-  // Create AWGN channnel
-  if (channel_args.awgn_enable && ret == SRSRAN_SUCCESS) {
-    awgn = (srsran_channel_awgn_t*)calloc(sizeof(srsran_channel_awgn_t), 1);
-    ret  = srsran_channel_awgn_init(awgn, 1234);
-    srsran_channel_awgn_set_n0(awgn, args.awgn_signal_power_dBfs - args.awgn_snr_dB);
-  }
+    // Create AWGN channnel, each antenna has its own generator so that they can run in parallel
+    if (channel_args.awgn_enable && ret == SRSRAN_SUCCESS) {
+      awgn[i] = (srsran_channel_awgn_t*)calloc(sizeof(srsran_channel_awgn_t), 1);
+      ret     = srsran_channel_awgn_init(awgn[i], 1234 + i);
+      srsran_channel_awgn_set_n0(awgn[i], args.awgn_signal_power_dBfs - args.awgn_snr_dB);
+    }
 
-  // Create high speed train
-  if (channel_args.hst_enable && ret == SRSRAN_SUCCESS) {
-    hst = (srsran_channel_hst_t*)calloc(sizeof(srsran_channel_hst_t), 1);
-    srsran_channel_hst_init(hst, channel_args.hst_fd_hz, channel_args.hst_period_s, channel_args.hst_init_time_s);
+    // Create high speed train
+    if (channel_args.hst_enable && ret == SRSRAN_SUCCESS) {
+      hst[i] = (srsran_channel_hst_t*)calloc(sizeof(srsran_channel_hst_t), 1);
+      srsran_channel_hst_init(hst[i], channel_args.hst_fd_hz, channel_args.hst_period_s, channel_args.hst_init_time_s);
+    }
   }
 
   // Create Radio Link Failure simulator
@@ -94,6 +86,21 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
     srsran_channel_rlf_init(rlf, channel_args.rlf_t_on_ms, channel_args.rlf_t_off_ms);
   }
 
+  // Start a coworker for every antenna but the first one, which runs in the caller thread
+  if (channel_args.pipeline_enable && ret == SRSRAN_SUCCESS) {
+    for (uint32_t i = 1; i < nof_channels; i++) {
+      std::unique_ptr<coworker_t> w(new coworker_t);
+      w->channel_id = i;
+      if (sem_init(&w->start, 0, 0) || sem_init(&w->finish, 0, 0)) {
+        ret = SRSRAN_ERROR;
+        break;
+      }
+      coworker_t* w_ptr = w.get();
+      w->thread         = std::thread([this, w_ptr]() { coworker_loop(w_ptr); });
+      coworkers.push_back(std::move(w));
+    }
+  }
+
   if (ret != SRSRAN_SUCCESS) {
     fprintf(stderr, "Error: Creating channel\n\n");
   }
@@ -101,22 +108,12 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
 
 channel::~channel()
 {
-  if (buffer_in) {
-    free(buffer_in);
-  }
-
-  if (buffer_out) {
-    free(buffer_out);
-  }
-
-  if (awgn) {
-    srsran_channel_awgn_free(awgn);
-    free(awgn);
-  }
-
-  if (hst) {
-    srsran_channel_hst_free(hst);
-    free(hst);
+  for (auto& w : coworkers) {
+    w->quit = true;
+    sem_post(&w->start);
+    w->thread.join();
+    sem_destroy(&w->start);
+    sem_destroy(&w->finish);
   }
 
   if (rlf) {
@@ -134,6 +131,16 @@ channel::~channel()
       srsran_channel_delay_free(delay[i]);
       free(delay[i]);
     }
+
+    if (awgn[i]) {
+      srsran_channel_awgn_free(awgn[i]);
+      free(awgn[i]);
+    }
+
+    if (hst[i]) {
+      srsran_channel_hst_free(hst[i]);
+      free(hst[i]);
+    }
   }
 }
 
@@ -147,6 +154,54 @@ static inline cf_t local_cexpf(float phase)
 }
 }
 
+void channel::coworker_loop(coworker_t* w)
+{
+  sem_wait(&w->start);
+  while (!w->quit) {
+    run_channel(w->channel_id, w->in, w->out, w->len, w->t);
+    sem_post(&w->finish);
+    sem_wait(&w->start);
+  }
+}
+
+void channel::run_channel(uint32_t i, cf_t* in, cf_t* out, uint32_t len, const srsran_timestamp_t& t)
+{
+  // Every stage supports running in place, so the first stage reads the input and the following ones work on the
+  // output buffer
+  cf_t* src = in;
+
+  if (hst[i]) {
+    srsran_channel_hst_execute(hst[i], src, out, len, &t);
+    srsran_vec_sc_prod_ccc(out, local_cexpf(hst_init_phase), out, len);
+    src = out;
+  }
+
+  if (awgn[i]) {
+    srsran_channel_awgn_run_c(awgn[i], src, out, len);
+    src = out;
+  }
+
+  if (fading[i]) {
+    srsran_channel_fading_execute(fading[i], src, out, len, t.full_secs + t.frac_secs);
+    src = out;
+  }
+
+  if (delay[i]) {
+    srsran_channel_delay_execute(delay[i], src, out, len, &t);
+    src = out;
+  }
+
+  if (rlf) {
+    srsran_channel_rlf_execute(rlf, src, out, len, &t);
+    src = out;
+  }
+
+  // No stage is enabled
+  if (src != out) {
+    srsran_vec_cf_copy(out, src, len);
+  }
+}
+
 void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
                   cf_t*                     out[SRSRAN_MAX_CHANNELS],
                   uint32_t                  len,
@@ -157,56 +212,46 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
     return;
   }
 
-  // For each channel
-  for (uint32_t i = 0; i < nof_channels; i++) {
-    // Skip iteration if any buffer is null
-    if (in[i] == nullptr || out[i] == nullptr) {
-      continue;
-    }
-
-    // If sampling rate is not set, copy input and skip rest of channel
-    if (current_srate == 0) {
-      if (in[i] != out[i]) {
+  // If sampling rate is not set, copy input and skip rest of channel
+  if (current_srate == 0) {
+    for (uint32_t i = 0; i < nof_channels; i++) {
+      if (in[i] != nullptr && out[i] != nullptr && in[i] != out[i]) {
         srsran_vec_cf_copy(out[i], in[i], len);
       }
-      continue;
-    }
-
-    // Copy input buffer
-    srsran_vec_cf_copy(buffer_in, in[i], len);
-
-    if (hst) {
-      srsran_channel_hst_execute(hst, buffer_in, buffer_out, len, &t);
-      srsran_vec_sc_prod_ccc(buffer_out, local_cexpf(hst_init_phase), buffer_in, len);
-    }
-
-    if (awgn) {
-      srsran_channel_awgn_run_c(awgn, buffer_in, buffer_out, len);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
     }
+    return;
+  }
 
-    if (fading[i]) {
-      srsran_channel_fading_execute(fading[i], buffer_in, buffer_out, len, t.full_secs + t.frac_secs);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  // Start the coworkers
+  for (auto& w : coworkers) {
+    w->in  = in[w->channel_id];
+    w->out = out[w->channel_id];
+    w->len = len;
+    w->t   = t;
+    if (w->in != nullptr && w->out != nullptr) {
+      sem_post(&w->start);
     }
+  }
 
-    if (delay[i]) {
-      srsran_channel_delay_execute(delay[i], buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  // Run the channels that have no coworker
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    // Skip iteration if it runs in a coworker or any buffer is null
+    if ((i > 0 && i <= coworkers.size()) || in[i] == nullptr || out[i] == nullptr) {
+      continue;
     }
+    run_channel(i, in[i], out[i], len, t);
+  }
 
-    if (rlf) {
-      srsran_channel_rlf_execute(rlf, buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  // Wait for the coworkers
+  for (auto& w : coworkers) {
+    if (w->in != nullptr && w->out != nullptr) {
+      sem_wait(&w->finish);
     }
-
-    // Copy output buffer
-    srsran_vec_cf_copy(out[i], buffer_in, len);
   }
 
-  if (hst) {
+  if (hst[0]) {
     // Increment phase to keep it coherent between frames
-    hst_init_phase += (2 * M_PI * len * hst->fs_hz / hst->srate_hz);
+    hst_init_phase += (2 * M_PI * len * hst[0]->fs_hz / hst[0]->srate_hz);
 
     // Positive Remainder
     while (hst_init_phase > 2 * M_PI) {
@@ -220,15 +265,17 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
   }
 
   // Logging
-  std::stringstream str;
-  str << "Channel: t=" << t.full_secs + t.frac_secs << "s; ";
-  if (delay[0]) {
-    str << "delay=" << delay[0]->delay_us << "us; ";
-  }
-  if (hst) {
-    str << "hst=" << hst->fs_hz << "Hz; ";
+  if (logger.debug.enabled()) {
+    std::stringstream str;
+    str << "Channel: t=" << t.full_secs + t.frac_secs << "s; ";
+    if (delay[0]) {
+      str << "delay=" << delay[0]->delay_us << "us; ";
+    }
+    if (hst[0]) {
+      str << "hst=" << hst[0]->fs_hz << "Hz; ";
+    }
+    logger.debug("%s", str.str().c_str());
   }
-  logger.debug("%s", str.str().c_str());
 }
 
 void channel::set_srate(uint32_t srate)
@@ -244,10 +291,10 @@ void channel::set_srate(uint32_t srate)
       if (delay[i]) {
         srsran_channel_delay_update_srate(delay[i], srate);
       }
-    }
 
-    if (hst) {
-      srsran_channel_hst_update_srate(hst, srate);
+      if (hst[i]) {
+        srsran_channel_hst_update_srate(hst[i], srate);
+      }
     }
 
     // Update sampling rate
@@ -257,7 +304,9 @@ void channel::set_srate(uint32_t srate)
 
 void channel::set_signal_power_dBfs(float power_dBfs)
 {
-  if (awgn != nullptr) {
-    srsran_channel_awgn_set_n0(awgn, power_dBfs - args.awgn_snr_dB);
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    if (awgn[i] != nullptr) {
+      srsran_channel_awgn_set_n0(awgn[i], power_dBfs - args.awgn_snr_dB);
+    }
   }
 }
@@ -90,6 +90,8 @@ static inline __m128 _sine(const float* table, __m128 arg)
   __m128  argmod   = _mm_sub_ps(arg, _mm_mul_ps(turns, _mm_set1_ps(2.0f * (float)M_PI)));
   __m128  indexps  = _mm_mul_ps(argmod, _mm_set1_ps(1024.0f / (2.0f * (float)M_PI)));
   __m128i indexi32 = _mm_abs_epi32(_mm_cvtps_epi32(indexps));
+  // A full turn may round to the index 1024, which wraps to the start of the table
+  indexi32 = _mm_and_si128(indexi32, _mm_set1_epi32(1023));
   _mm_store_si128((__m128i*)idx, indexi32);
 
   for (int i = 0; i < 4; i++) {
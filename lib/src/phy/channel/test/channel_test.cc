@@ -0,0 +1,161 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/channel/channel.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/srslog/srslog.h"
+#include <chrono>
+#include <unistd.h>
+
+static uint32_t    nof_prb          = 100;
+static uint32_t    max_nof_antennas = 4;
+static uint32_t    nof_subframes    = 200;
+static std::string fading_model     = "epa5";
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [pamn]\n", prog);
+  printf("\t-p Number of PRB [Default %d]\n", nof_prb);
+  printf("\t-a Maximum number of antennas [Default %d]\n", max_nof_antennas);
+  printf("\t-m Fading model [Default %s]\n", fading_model.c_str());
+  printf("\t-n Number of subframes [Default %d]\n", nof_subframes);
+}
+
+static int parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "pamn")) != -1) {
+    switch (opt) {
+      case 'p':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'a':
+        max_nof_antennas = SRSRAN_MIN((uint32_t)strtol(argv[optind], NULL, 10), SRSRAN_MAX_CHANNELS);
+        break;
+      case 'm':
+        fading_model = argv[optind];
+        break;
+      case 'n':
+        nof_subframes = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/// Runs all the stages of the emulator in place over random subframes. Returns the real-time factor, that is, the
+/// processing time over the duration of the signal, and leaves the output of the last subframe in buffer
+static double run_channel(const srsran::channel::args_t& args,
+                          uint32_t                       nof_antennas,
+                          cf_t*                          buffer[SRSRAN_MAX_CHANNELS],
+                          uint32_t                       sf_len)
+{
+  srsran::channel channel(args, nof_antennas, srslog::fetch_basic_logger("CHANNEL", false));
+  channel.set_srate((uint32_t)srsran_sampling_freq_hz(nof_prb));
+  channel.set_signal_power_dBfs(0.0f);
+
+  srsran_random_t    random_gen = srsran_random_init(0x1234);
+  srsran_timestamp_t ts         = {};
+  double             elapsed_us = 0;
+  for (uint32_t sf = 0; sf < nof_subframes; sf++) {
+    for (uint32_t i = 0; i < nof_antennas; i++) {
+      srsran_random_uniform_complex_dist_vector(random_gen, buffer[i], sf_len, -1.0f, +1.0f);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    channel.run(buffer, buffer, sf_len, ts);
+    elapsed_us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    srsran_timestamp_add(&ts, 0, 0.001);
+  }
+  srsran_random_free(random_gen);
+
+  return elapsed_us / (nof_subframes * 1000.0);
+}
+
+int main(int argc, char** argv)
+{
+  if (parse_args(argc, argv) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  srslog::fetch_basic_logger("CHANNEL", false).set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  uint32_t sf_len                                = SRSRAN_SF_LEN_PRB(nof_prb);
+  cf_t*    buffer_serial[SRSRAN_MAX_CHANNELS]    = {};
+  cf_t*    buffer_pipelined[SRSRAN_MAX_CHANNELS] = {};
+  for (uint32_t i = 0; i < max_nof_antennas; i++) {
+    buffer_serial[i]    = srsran_vec_cf_malloc(sf_len);
+    buffer_pipelined[i] = srsran_vec_cf_malloc(sf_len);
+    if (buffer_serial[i] == nullptr || buffer_pipelined[i] == nullptr) {
+      ERROR("Error: Allocating memory");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  srsran::channel::args_t args;
+  args.enable        = true;
+  args.awgn_enable   = true;
+  args.awgn_snr_dB   = 20.0f;
+  args.fading_enable = true;
+  args.fading_model  = fading_model;
+  args.delay_enable  = true;
+  args.hst_enable    = true;
+  args.rlf_enable    = true;
+
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t nof_antennas = 1; nof_antennas <= max_nof_antennas; nof_antennas *= 2) {
+    args.pipeline_enable = false;
+    double rtf_serial    = run_channel(args, nof_antennas, buffer_serial, sf_len);
+
+    args.pipeline_enable = true;
+    double rtf_pipelined = run_channel(args, nof_antennas, buffer_pipelined, sf_len);
+
+    // Both modes must produce the same signal
+    bool passed = true;
+    for (uint32_t i = 0; i < nof_antennas; i++) {
+      passed &= memcmp(buffer_serial[i], buffer_pipelined[i], sizeof(cf_t) * sf_len) == 0;
+    }
+    if (!passed) {
+      ret = SRSRAN_ERROR;
+    }
+
+    printf("Test nof_prb=%d; nof_antennas=%d; fading=%s; real-time factor serial=%.3f; pipelined=%.3f; %s\n",
+           nof_prb,
+           nof_antennas,
+           fading_model.c_str(),
+           rtf_serial,
+           rtf_pipelined,
+           passed ? "Passed" : "Failed");
+  }
+
+  for (uint32_t i = 0; i < max_nof_antennas; i++) {
+    free(buffer_serial[i]);
+    free(buffer_pipelined[i]);
+  }
+
+  return ret;
+}
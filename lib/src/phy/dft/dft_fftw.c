@@ -25,6 +25,7 @@
 #include <math.h>
 #include <pwd.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "srsran/phy/dft/dft.h"
@@ -53,6 +54,180 @@ static int get_fftw_wisdom_file(char* full_path, uint32_t n)
 
 static pthread_mutex_t fft_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+/*
+ * Process-wide plan cache. FFTW plans are read-only once created and can be executed concurrently on different arrays
+ * using the new-array execute interface, so all the srsran_dft_plan_t objects describing the same transform share a
+ * single FFTW plan. This avoids measuring the same plan once per worker, channel and antenna. Entries are reference
+ * counted and protected by fft_mutex.
+ */
+typedef struct {
+  srsran_dft_mode_t mode;
+  bool              guru;
+  int               sign;
+  int               size;
+  int               istride;
+  int               ostride;
+  int               how_many;
+  int               idist;
+  int               odist;
+  bool              in_place;
+  int               in_align;  // FFTW alignment of the input buffer, new-array execution requires it to match
+  int               out_align; // FFTW alignment of the output buffer
+} dft_plan_key_t;
+
+typedef struct dft_plan_entry_s {
+  dft_plan_key_t           key;
+  fftwf_plan               p;
+  uint32_t                 refcount;
+  struct dft_plan_entry_s* next;
+} dft_plan_entry_t;
+
+static dft_plan_entry_t*       plan_cache = NULL;
+static srsran_dft_plan_stats_t plan_stats;
+
+static void dft_plan_key_init(dft_plan_key_t*   key,
+                              srsran_dft_mode_t mode,
+                              bool              guru,
+                              int               sign,
+                              int               size,
+                              const void*       in,
+                              const void*       out,
+                              int               istride,
+                              int               ostride,
+                              int               how_many,
+                              int               idist,
+                              int               odist)
+{
+  bzero(key, sizeof(dft_plan_key_t));
+  key->mode      = mode;
+  key->guru      = guru;
+  key->sign      = sign;
+  key->size      = size;
+  key->istride   = istride;
+  key->ostride   = ostride;
+  key->how_many  = how_many;
+  key->idist     = idist;
+  key->odist     = odist;
+  key->in_place  = (in == out);
+  key->in_align  = fftwf_alignment_of((float*)in);
+  key->out_align = fftwf_alignment_of((float*)out);
+}
+
+static bool dft_plan_key_equal(const dft_plan_key_t* a, const dft_plan_key_t* b)
+{
+  return a->mode == b->mode && a->guru == b->guru && a->sign == b->sign && a->size == b->size &&
+         a->istride == b->istride && a->ostride == b->ostride && a->how_many == b->how_many && a->idist == b->idist &&
+         a->odist == b->odist && a->in_place == b->in_place && a->in_align == b->in_align &&
+         a->out_align == b->out_align;
+}
+
+static uint64_t dft_time_us()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000UL + (uint64_t)ts.tv_nsec / 1000UL;
+}
+
+// Returns a plan for the given key, creating it if it is not cached. Must be called with fft_mutex locked.
+static fftwf_plan dft_plan_acquire(const dft_plan_key_t* key, void* in, void* out)
+{
+  for (dft_plan_entry_t* e = plan_cache; e != NULL; e = e->next) {
+    if (dft_plan_key_equal(&e->key, key)) {
+      e->refcount++;
+      plan_stats.nof_shared++;
+      return e->p;
+    }
+  }
+
+  dft_plan_entry_t* e = calloc(1, sizeof(dft_plan_entry_t));
+  if (e == NULL) {
+    return NULL;
+  }
+
+  uint64_t t0 = dft_time_us();
+  if (key->mode == SRSRAN_REAL) {
+    e->p = fftwf_plan_r2r_1d(key->size, in, out, key->sign, FFTW_TYPE);
+  } else if (key->guru) {
+    const fftwf_iodim iodim        = {key->size, key->istride, key->ostride};
+    const fftwf_iodim howmany_dims = {key->how_many, key->idist, key->odist};
+    e->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in, out, key->sign, FFTW_TYPE);
+  } else {
+    e->p = fftwf_plan_dft_1d(key->size, in, out, key->sign, FFTW_TYPE);
+  }
+  plan_stats.planning_time_us += dft_time_us() - t0;
+
+  if (e->p == NULL) {
+    free(e);
+    return NULL;
+  }
+
+  e->key      = *key;
+  e->refcount = 1;
+  e->next     = plan_cache;
+  plan_cache  = e;
+  plan_stats.nof_plans++;
+  plan_stats.nof_cached++;
+
+  return e->p;
+}
+
+// Drops a reference to a plan, destroying it when it is no longer used. Must be called with fft_mutex locked.
+static void dft_plan_release(fftwf_plan p)
+{
+  if (p == NULL) {
+    return;
+  }
+
+  dft_plan_entry_t** prev = &plan_cache;
+  for (dft_plan_entry_t* e = plan_cache; e != NULL; prev = &e->next, e = e->next) {
+    if (e->p == p) {
+      if (--e->refcount == 0) {
+        *prev = e->next;
+        fftwf_destroy_plan(e->p);
+        free(e);
+        plan_stats.nof_cached--;
+      }
+      return;
+    }
+  }
+
+  // Not created through the cache
+  fftwf_destroy_plan(p);
+}
+
+void srsran_dft_get_plan_stats(srsran_dft_plan_stats_t* stats)
+{
+  if (stats == NULL) {
+    return;
+  }
+  pthread_mutex_lock(&fft_mutex);
+  *stats = plan_stats;
+  pthread_mutex_unlock(&fft_mutex);
+}
+
+int srsran_dft_export_wisdom(const char* filename)
+{
+  FILE* fd = fopen(filename, "w");
+  if (fd == NULL) {
+    return SRSRAN_ERROR;
+  }
+  if (lockf(fileno(fd), F_LOCK, 0) == -1) {
+    perror("lockf()");
+    fclose(fd);
+    return SRSRAN_ERROR;
+  }
+  pthread_mutex_lock(&fft_mutex);
+  fftwf_export_wisdom_to_file(fd);
+  pthread_mutex_unlock(&fft_mutex);
+  if (lockf(fileno(fd), F_ULOCK, 0) == -1) {
+    perror("u-lockf()");
+    fclose(fd);
+    return SRSRAN_ERROR;
+  }
+  fclose(fd);
+  return SRSRAN_SUCCESS;
+}
+
 // This function is called in the beggining of any executable where it is linked
 __attribute__((constructor)) static void srsran_dft_load()
 {
@@ -87,22 +262,7 @@ __attribute__((destructor)) void srsran_dft_exit()
 #ifdef FFTW_WISDOM_FILE
   char full_path[256];
   get_fftw_wisdom_file(full_path, sizeof(full_path));
-  FILE* fd = fopen(full_path, "w");
-  if (fd == NULL) {
-    return;
-  }
-  if (lockf(fileno(fd), F_LOCK, 0) == -1) {
-    perror("lockf()");
-    fclose(fd);
-    return;
-  }
-  fftwf_export_wisdom_to_file(fd);
-  if (lockf(fileno(fd), F_ULOCK, 0) == -1) {
-    perror("u-lockf()");
-    fclose(fd);
-    return;
-  }
-  fclose(fd);
+  srsran_dft_export_wisdom(full_path);
 #endif
   fftwf_cleanup();
 }
@@ -153,21 +313,34 @@ int srsran_dft_replan_guru_c(srsran_dft_plan_t* plan,
 {
   int sign = (plan->forward) ? FFTW_FORWARD : FFTW_BACKWARD;
 
-  const fftwf_iodim iodim        = {new_dft_points, istride, ostride};
-  const fftwf_iodim howmany_dims = {how_many, idist, odist};
+  dft_plan_key_t key;
+  dft_plan_key_init(&key,
+                    SRSRAN_DFT_COMPLEX,
+                    true,
+                    sign,
+                    new_dft_points,
+                    in_buffer,
+                    out_buffer,
+                    istride,
+                    ostride,
+                    how_many,
+                    idist,
+                    odist);
 
   pthread_mutex_lock(&fft_mutex);
 
   /* Destroy current plan */
-  fftwf_destroy_plan(plan->p);
+  dft_plan_release(plan->p);
 
-  plan->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  plan->p = dft_plan_acquire(&key, in_buffer, out_buffer);
 
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
     return -1;
   }
+  plan->in        = in_buffer;
+  plan->out       = out_buffer;
   plan->size      = new_dft_points;
   plan->init_size = plan->size;
 
@@ -183,12 +356,15 @@ int srsran_dft_replan_c(srsran_dft_plan_t* plan, const int new_dft_points)
     return 0;
   }
 
+  dft_plan_key_t key;
+  dft_plan_key_init(&key, SRSRAN_DFT_COMPLEX, false, sign, new_dft_points, plan->in, plan->out, 1, 1, 1, 1, 1);
+
   pthread_mutex_lock(&fft_mutex);
   if (plan->p) {
-    fftwf_destroy_plan(plan->p);
+    dft_plan_release(plan->p);
     plan->p = NULL;
   }
-  plan->p = fftwf_plan_dft_1d(new_dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  plan->p = dft_plan_acquire(&key, plan->in, plan->out);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -211,18 +387,21 @@ int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
 {
   int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
 
-  const fftwf_iodim iodim        = {dft_points, istride, ostride};
-  const fftwf_iodim howmany_dims = {how_many, idist, odist};
+  dft_plan_key_t key;
+  dft_plan_key_init(
+      &key, SRSRAN_DFT_COMPLEX, true, sign, dft_points, in_buffer, out_buffer, istride, ostride, how_many, idist, odist);
 
   pthread_mutex_lock(&fft_mutex);
-
-  plan->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  plan->p = dft_plan_acquire(&key, in_buffer, out_buffer);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
     return -1;
   }
 
+  // Guru plans run on the buffers provided by the caller, they are not owned by the plan
+  plan->in        = in_buffer;
+  plan->out       = out_buffer;
   plan->size      = dft_points;
   plan->init_size = plan->size;
   plan->mode      = SRSRAN_DFT_COMPLEX;
@@ -241,11 +420,12 @@ int srsran_dft_plan_c(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_
 {
   allocate(plan, sizeof(fftwf_complex), sizeof(fftwf_complex), dft_points);
 
-  pthread_mutex_lock(&fft_mutex);
-
-  int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
-  plan->p  = fftwf_plan_dft_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  int            sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
+  dft_plan_key_t key;
+  dft_plan_key_init(&key, SRSRAN_DFT_COMPLEX, false, sign, dft_points, plan->in, plan->out, 1, 1, 1, 1, 1);
 
+  pthread_mutex_lock(&fft_mutex);
+  plan->p = dft_plan_acquire(&key, plan->in, plan->out);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -269,12 +449,15 @@ int srsran_dft_replan_r(srsran_dft_plan_t* plan, const int new_dft_points)
 {
   int sign = (plan->dir == SRSRAN_DFT_FORWARD) ? FFTW_R2HC : FFTW_HC2R;
 
+  dft_plan_key_t key;
+  dft_plan_key_init(&key, SRSRAN_REAL, false, sign, new_dft_points, plan->in, plan->out, 1, 1, 1, 1, 1);
+
   pthread_mutex_lock(&fft_mutex);
   if (plan->p) {
-    fftwf_destroy_plan(plan->p);
+    dft_plan_release(plan->p);
     plan->p = NULL;
   }
-  plan->p = fftwf_plan_r2r_1d(new_dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  plan->p = dft_plan_acquire(&key, plan->in, plan->out);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -289,8 +472,11 @@ int srsran_dft_plan_r(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_
   allocate(plan, sizeof(float), sizeof(float), dft_points);
   int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_R2HC : FFTW_HC2R;
 
+  dft_plan_key_t key;
+  dft_plan_key_init(&key, SRSRAN_REAL, false, sign, dft_points, plan->in, plan->out, 1, 1, 1, 1, 1);
+
   pthread_mutex_lock(&fft_mutex);
-  plan->p = fftwf_plan_r2r_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  plan->p = dft_plan_acquire(&key, plan->in, plan->out);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -372,7 +558,7 @@ void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
   fftwf_complex* f_out = plan->out;
 
   copy_pre((uint8_t*)plan->in, (uint8_t*)in, sizeof(cf_t), plan->size, plan->forward, plan->mirror, plan->dc);
-  fftwf_execute(plan->p);
+  fftwf_execute_dft(plan->p, plan->in, plan->out);
   if (plan->norm) {
     norm = 1.0 / sqrtf(plan->size);
     srsran_vec_sc_prod_cfc(f_out, norm, f_out, plan->size);
@@ -388,7 +574,7 @@ void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
 void srsran_dft_run_guru_c(srsran_dft_plan_t* plan)
 {
   if (plan->is_guru == true) {
-    fftwf_execute(plan->p);
+    fftwf_execute_dft(plan->p, plan->in, plan->out);
   } else {
     ERROR("srsran_dft_run_guru_c: the selected plan is not guru!");
   }
@@ -402,7 +588,7 @@ void srsran_dft_run_r(srsran_dft_plan_t* plan, const float* in, float* out)
   float* f_out = plan->out;
 
   memcpy(plan->in, in, sizeof(float) * plan->size);
-  fftwf_execute(plan->p);
+  fftwf_execute_r2r(plan->p, plan->in, plan->out);
   if (plan->norm) {
     norm = 1.0 / plan->size;
     srsran_vec_sc_prod_fff(f_out, norm, f_out, plan->size);
@@ -430,7 +616,7 @@ void srsran_dft_plan_free(srsran_dft_plan_t* plan)
       fftwf_free(plan->out);
   }
   if (plan->p)
-    fftwf_destroy_plan(plan->p);
+    dft_plan_release(plan->p);
   pthread_mutex_unlock(&fft_mutex);
   bzero(plan, sizeof(srsran_dft_plan_t));
 }
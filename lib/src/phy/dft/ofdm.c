@@ -450,6 +450,71 @@ void srsran_ofdm_rx_slot_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
   }
 }
 
+/* Scales a vector by a factor that is usually 1 or real, picking the cheapest kernel.
+ */
+static void ofdm_scale(const cf_t* x, cf_t scale, cf_t* z, uint32_t len)
+{
+  if (scale == 1.0f) {
+    if (x != z) {
+      srsran_vec_cf_copy(z, x, len);
+    }
+  } else if (cimagf(scale) == 0.0f) {
+    srsran_vec_sc_prod_cfc(x, crealf(scale), z, len);
+  } else {
+    srsran_vec_sc_prod_ccc(x, scale, z, len);
+  }
+}
+
+/* Returns the normalisation and phase compensation factor of a symbol. The receiver applies its conjugate.
+ */
+static cf_t ofdm_symbol_scale(const srsran_ofdm_t* q, uint32_t symbol_idx)
+{
+  cf_t scale = 1.0f;
+
+  if (isnormal(q->cfg.phase_compensation_hz)) {
+    scale = q->phase_compensation[symbol_idx];
+  }
+
+  if (q->fft_plan.norm) {
+    scale *= 1.0f / sqrtf(q->cfg.symbol_sz);
+  }
+
+  return scale;
+}
+
+/* Fused post-FFT stage of one symbol. The FFT shift, the DFT window offset compensation, the normalisation and the
+ * phase compensation are applied in a single pass from the FFT output to the resource grid.
+ */
+static void ofdm_rx_symbol(const srsran_ofdm_t* q, const cf_t* tmp, cf_t* output, cf_t scale)
+{
+  uint32_t half = q->nof_re / 2;
+  uint32_t dc   = (q->fft_plan.dc) ? 1 : 0;
+
+  // Negative subcarriers are at the end of the FFT output, positive ones follow the optional DC
+  uint32_t offset[2] = {q->cfg.symbol_sz - half, dc};
+
+  for (uint32_t k = 0; k < 2; k++) {
+    if (q->window_offset_n) {
+      srsran_vec_prod_sc_ccc(&tmp[offset[k]], &q->window_offset_buffer[offset[k]], scale, &output[k * half], half);
+    } else {
+      ofdm_scale(&tmp[offset[k]], scale, &output[k * half], half);
+    }
+  }
+}
+
+/* Fused pre-IFFT stage of one symbol. The inverse FFT shift, the normalisation and the phase compensation are applied
+ * in a single pass from the resource grid to the IFFT input. The IFFT is linear, so scaling before it leaves nothing to
+ * do on the time domain samples but the CP copy.
+ */
+static void ofdm_tx_symbol(const srsran_ofdm_t* q, const cf_t* input, cf_t* tmp, cf_t scale)
+{
+  uint32_t half = q->nof_re / 2;
+  uint32_t dc   = (q->fft_plan.dc) ? 1 : 0;
+
+  ofdm_scale(&input[half], scale, &tmp[dc], half);
+  ofdm_scale(&input[0], scale, &tmp[q->cfg.symbol_sz - half], half);
+}
+
 /* Transforms input samples into output OFDM symbols.
  * Performs FFT on a each symbol and removes CP.
  */
@@ -460,40 +525,15 @@ static void ofdm_rx_slot(srsran_ofdm_t* q, int slot_in_sf)
       q, q->cfg.in_buffer + slot_in_sf * q->slot_sz, q->cfg.out_buffer + slot_in_sf * q->nof_re * q->nof_symbols);
 #else
   uint32_t nof_symbols = q->nof_symbols;
-  uint32_t nof_re = q->nof_re;
-  cf_t* output = q->cfg.out_buffer + slot_in_sf * nof_re * nof_symbols;
-  uint32_t symbol_sz = q->cfg.symbol_sz;
-  float norm = 1.0f / sqrtf(q->fft_plan.size);
-  cf_t* tmp = q->tmp;
-  uint32_t dc = (q->fft_plan.dc) ? 1 : 0;
+  uint32_t nof_re      = q->nof_re;
+  cf_t*    output      = q->cfg.out_buffer + slot_in_sf * nof_re * nof_symbols;
+  uint32_t symbol_sz   = q->cfg.symbol_sz;
+  cf_t*    tmp         = q->tmp;
 
   srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
 
-  for (int i = 0; i < q->nof_symbols; i++) {
-    // Apply frequency domain window offset
-    if (q->window_offset_n) {
-      srsran_vec_prod_ccc(tmp, q->window_offset_buffer, tmp, symbol_sz);
-    }
-
-    // Perform FFT shift
-    memcpy(output, tmp + symbol_sz - nof_re / 2, sizeof(cf_t) * nof_re / 2);
-    memcpy(output + nof_re / 2, &tmp[dc], sizeof(cf_t) * nof_re / 2);
-
-    // Normalize output
-    if (isnormal(q->cfg.phase_compensation_hz)) {
-      // Get phase compensation
-      cf_t phase_compensation = conjf(q->phase_compensation[slot_in_sf * q->nof_symbols + i]);
-
-      // Apply normalization
-      if (q->fft_plan.norm) {
-        phase_compensation *= norm;
-      }
-
-      // Apply correction
-      srsran_vec_sc_prod_ccc(output, phase_compensation, output, nof_re);
-    } else if (q->fft_plan.norm) {
-      srsran_vec_sc_prod_cfc(output, norm, output, nof_re);
-    }
+  for (uint32_t i = 0; i < nof_symbols; i++) {
+    ofdm_rx_symbol(q, tmp, output, conjf(ofdm_symbol_scale(q, slot_in_sf * nof_symbols + i)));
 
     tmp += symbol_sz;
     output += nof_re;
@@ -584,16 +624,13 @@ static void ofdm_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
   }
 #else
   uint32_t nof_symbols = q->nof_symbols;
-  uint32_t nof_re = q->nof_re;
-  float norm = 1.0f / sqrtf(symbol_sz);
-  cf_t* tmp = q->tmp;
+  uint32_t nof_re      = q->nof_re;
+  cf_t*    tmp         = q->tmp;
 
   bzero(tmp, q->slot_sz);
-  uint32_t dc = (q->fft_plan.dc) ? 1 : 0;
 
-  for (int i = 0; i < nof_symbols; i++) {
-    srsran_vec_cf_copy(&tmp[dc], &input[nof_re / 2], nof_re / 2);
-    srsran_vec_cf_copy(&tmp[symbol_sz - nof_re / 2], &input[0], nof_re / 2);
+  for (uint32_t i = 0; i < nof_symbols; i++) {
+    ofdm_tx_symbol(q, input, tmp, ofdm_symbol_scale(q, slot_in_sf * nof_symbols + i));
 
     input += nof_re;
     tmp += symbol_sz;
@@ -601,24 +638,9 @@ static void ofdm_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
 
   srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
 
-  for (int i = 0; i < nof_symbols; i++) {
+  for (uint32_t i = 0; i < nof_symbols; i++) {
     int cp_len = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
 
-    if (isnormal(q->cfg.phase_compensation_hz)) {
-      // Get phase compensation
-      cf_t phase_compensation = q->phase_compensation[slot_in_sf * q->nof_symbols + i];
-
-      // Apply normalization
-      if (q->fft_plan.norm) {
-        phase_compensation *= norm;
-      }
-
-      // Apply correction
-      srsran_vec_sc_prod_ccc(&output[cp_len], phase_compensation, &output[cp_len], symbol_sz);
-    } else if (q->fft_plan.norm) {
-      srsran_vec_sc_prod_cfc(&output[cp_len], norm, &output[cp_len], symbol_sz);
-    }
-
     /* add CP */
     srsran_vec_cf_copy(output, &output[symbol_sz], cp_len);
     output += symbol_sz + cp_len;
@@ -0,0 +1,323 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Per-slot micro-benchmark of the OFDM modulator and demodulator. It compares the fused single-pass symbol processing
+ * of srsran_ofdm_tx_sf()/srsran_ofdm_rx_sf() with the previous multi-pass processing, which is reproduced below, and
+ * checks that both give the same output.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+
+static uint32_t    nof_prb               = 100;
+static srsran_cp_t cp                    = SRSRAN_CP_NORM;
+static int         nof_repetitions       = 1000;
+static float       rx_window_offset      = 0.5f;
+static double      phase_compensation_hz = 0.0;
+static bool        normalize             = true;
+
+static double elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
+{
+  return ((double)ts_end->tv_sec - (double)ts_start->tv_sec) * 1e6 + (double)ts_end->tv_usec -
+         (double)ts_start->tv_usec;
+}
+
+static void usage(char* prog)
+{
+  printf("Usage: %s\n", prog);
+  printf("\t-n Number of Resource blocks [Default %d]\n", nof_prb);
+  printf("\t-e extended cyclic prefix [Default Normal]\n");
+  printf("\t-r nof_repetitions [Default %d]\n", nof_repetitions);
+  printf("\t-o rx window offset (portion of CP length) [Default %.1f]\n", rx_window_offset);
+  printf("\t-p Phase compensation carrier frequency in Hz [Default %.1f]\n", phase_compensation_hz);
+  printf("\t-u Disable normalisation [Default %s]\n", normalize ? "enabled" : "disabled");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nerpou")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'e':
+        cp = SRSRAN_CP_EXT;
+        break;
+      case 'r':
+        nof_repetitions = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'o':
+        rx_window_offset = SRSRAN_MIN(1.0f, SRSRAN_MAX(0.0f, strtof(argv[optind], NULL)));
+        break;
+      case 'p':
+        phase_compensation_hz = strtod(argv[optind], NULL);
+        break;
+      case 'u':
+        normalize = false;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/* Previous demodulator slot processing: window, FFT shift and scaling each take a pass over the symbol.
+ */
+static void legacy_rx_slot(srsran_ofdm_t* q, int slot_in_sf)
+{
+  uint32_t nof_re    = q->nof_re;
+  cf_t*    output    = q->cfg.out_buffer + slot_in_sf * nof_re * q->nof_symbols;
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  float    norm      = 1.0f / sqrtf(q->fft_plan.size);
+  cf_t*    tmp       = q->tmp;
+  uint32_t dc        = (q->fft_plan.dc) ? 1 : 0;
+
+  srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
+
+  for (int i = 0; i < q->nof_symbols; i++) {
+    if (q->window_offset_n) {
+      srsran_vec_prod_ccc(tmp, q->window_offset_buffer, tmp, symbol_sz);
+    }
+
+    memcpy(output, tmp + symbol_sz - nof_re / 2, sizeof(cf_t) * nof_re / 2);
+    memcpy(output + nof_re / 2, &tmp[dc], sizeof(cf_t) * nof_re / 2);
+
+    if (isnormal(q->cfg.phase_compensation_hz)) {
+      cf_t phase_compensation = conjf(q->phase_compensation[slot_in_sf * q->nof_symbols + i]);
+      if (q->fft_plan.norm) {
+        phase_compensation *= norm;
+      }
+      srsran_vec_sc_prod_ccc(output, phase_compensation, output, nof_re);
+    } else if (q->fft_plan.norm) {
+      srsran_vec_sc_prod_cfc(output, norm, output, nof_re);
+    }
+
+    tmp += symbol_sz;
+    output += nof_re;
+  }
+}
+
+/* Previous modulator slot processing: the scaling takes a pass over the time domain samples after the IFFT.
+ */
+static void legacy_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
+{
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  uint32_t nof_re    = q->nof_re;
+  cf_t*    input     = q->cfg.in_buffer + slot_in_sf * nof_re * q->nof_symbols;
+  cf_t*    output    = q->cfg.out_buffer + slot_in_sf * q->slot_sz;
+  float    norm      = 1.0f / sqrtf(symbol_sz);
+  cf_t*    tmp       = q->tmp;
+  uint32_t dc        = (q->fft_plan.dc) ? 1 : 0;
+
+  bzero(tmp, q->slot_sz);
+
+  for (int i = 0; i < q->nof_symbols; i++) {
+    srsran_vec_cf_copy(&tmp[dc], &input[nof_re / 2], nof_re / 2);
+    srsran_vec_cf_copy(&tmp[symbol_sz - nof_re / 2], &input[0], nof_re / 2);
+    input += nof_re;
+    tmp += symbol_sz;
+  }
+
+  srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
+
+  for (int i = 0; i < q->nof_symbols; i++) {
+    int cp_len = SRSRAN_CP_ISNORM(q->cfg.cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+
+    if (isnormal(q->cfg.phase_compensation_hz)) {
+      cf_t phase_compensation = q->phase_compensation[slot_in_sf * q->nof_symbols + i];
+      if (q->fft_plan.norm) {
+        phase_compensation *= norm;
+      }
+      srsran_vec_sc_prod_ccc(&output[cp_len], phase_compensation, &output[cp_len], symbol_sz);
+    } else if (q->fft_plan.norm) {
+      srsran_vec_sc_prod_cfc(&output[cp_len], norm, &output[cp_len], symbol_sz);
+    }
+
+    srsran_vec_cf_copy(output, &output[symbol_sz], cp_len);
+    output += symbol_sz + cp_len;
+  }
+}
+
+static void fft_only_sf(srsran_ofdm_t* q)
+{
+  for (int n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
+    srsran_dft_run_guru_c(&q->fft_plan_sf[n]);
+  }
+}
+
+static double time_per_slot_us(void (*sf_func)(srsran_ofdm_t*), srsran_ofdm_t* q)
+{
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  for (int i = 0; i < nof_repetitions; i++) {
+    sf_func(q);
+  }
+  gettimeofday(&end, NULL);
+  return elapsed_us(&start, &end) / (nof_repetitions * SRSRAN_NOF_SLOTS_PER_SF);
+}
+
+static void legacy_rx_sf(srsran_ofdm_t* q)
+{
+  for (int n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
+    legacy_rx_slot(q, n);
+  }
+}
+
+static void legacy_tx_sf(srsran_ofdm_t* q)
+{
+  for (int n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
+    legacy_tx_slot(q, n);
+  }
+}
+
+static float nmse(const cf_t* ref, cf_t* x, uint32_t len)
+{
+  float ref_power = srsran_vec_avg_power_cf(ref, len);
+  srsran_vec_sub_ccc(ref, x, x, len);
+  return srsran_vec_avg_power_cf(x, len) / ref_power;
+}
+
+static void print_result(const char* name, double legacy_us, double fused_us, double fft_us, float error)
+{
+  printf("%s  %9.2f  %9.2f  %9.2f  %9.2f  %9.2f  %7.2f  %.1e\n",
+         name,
+         legacy_us,
+         fused_us,
+         fft_us,
+         legacy_us - fft_us,
+         fused_us - fft_us,
+         legacy_us / fused_us,
+         error);
+}
+
+int main(int argc, char** argv)
+{
+  srsran_random_t random_gen = srsran_random_init(0);
+  srsran_ofdm_t   fft = {}, ifft = {};
+  int             ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  uint32_t symbol_sz = (uint32_t)srsran_symbol_sz(nof_prb);
+  uint32_t n_re      = SRSRAN_CP_NSYMB(cp) * nof_prb * SRSRAN_NRE * SRSRAN_NOF_SLOTS_PER_SF;
+  uint32_t sf_len    = SRSRAN_SF_LEN(symbol_sz);
+
+  cf_t* grid       = srsran_vec_cf_malloc(n_re);
+  cf_t* grid_rx    = srsran_vec_cf_malloc(n_re);
+  cf_t* grid_ref   = srsran_vec_cf_malloc(n_re);
+  cf_t* signal     = srsran_vec_cf_malloc(sf_len);
+  cf_t* signal_ref = srsran_vec_cf_malloc(sf_len);
+  if (!grid || !grid_rx || !grid_ref || !signal || !signal_ref) {
+    perror("malloc");
+    goto clean_exit;
+  }
+  srsran_vec_cf_zero(signal, sf_len);
+
+  srsran_ofdm_cfg_t ofdm_cfg     = {};
+  ofdm_cfg.cp                    = cp;
+  ofdm_cfg.in_buffer             = grid;
+  ofdm_cfg.out_buffer            = signal;
+  ofdm_cfg.nof_prb               = nof_prb;
+  ofdm_cfg.normalize             = normalize;
+  ofdm_cfg.phase_compensation_hz = phase_compensation_hz;
+  if (srsran_ofdm_tx_init_cfg(&ifft, &ofdm_cfg)) {
+    ERROR("Error initializing iFFT");
+    goto clean_exit;
+  }
+
+  ofdm_cfg.in_buffer        = signal;
+  ofdm_cfg.out_buffer       = grid_rx;
+  ofdm_cfg.rx_window_offset = rx_window_offset;
+  if (srsran_ofdm_rx_init_cfg(&fft, &ofdm_cfg)) {
+    ERROR("Error initializing FFT");
+    goto clean_exit;
+  }
+
+  srsran_random_uniform_complex_dist_vector(random_gen, grid, n_re, -1.0f, +1.0f);
+
+  printf("OFDM benchmark: %d PRB, symbol size %d, %s CP, window offset %.2f, phase compensation %.3g Hz, %d "
+         "repetitions\n",
+         nof_prb,
+         symbol_sz,
+         SRSRAN_CP_ISNORM(cp) ? "normal" : "extended",
+         rx_window_offset,
+         phase_compensation_hz,
+         nof_repetitions);
+  printf("Times are in us per slot and antenna. 'post' is the time spent outside the FFT.\n");
+  printf("       legacy      fused        fft  legacy post fused post  speedup  NMSE\n");
+
+  // Modulator. The guru plans write to the configured output, so the legacy output is saved before the fused run.
+  double tx_legacy_us = time_per_slot_us(legacy_tx_sf, &ifft);
+  srsran_vec_cf_copy(signal_ref, signal, sf_len);
+  double tx_fft_us   = time_per_slot_us(fft_only_sf, &ifft);
+  double tx_fused_us = time_per_slot_us(srsran_ofdm_tx_sf, &ifft);
+  float  tx_error    = nmse(signal_ref, signal, sf_len);
+  print_result("Tx", tx_legacy_us, tx_fused_us, tx_fft_us, tx_error);
+
+  // Demodulator, on the modulated signal
+  srsran_vec_cf_copy(signal, signal_ref, sf_len);
+  double rx_legacy_us = time_per_slot_us(legacy_rx_sf, &fft);
+  srsran_vec_cf_copy(grid_ref, grid_rx, n_re);
+  double rx_fft_us   = time_per_slot_us(fft_only_sf, &fft);
+  double rx_fused_us = time_per_slot_us(srsran_ofdm_rx_sf, &fft);
+  float  rx_error    = nmse(grid_ref, grid_rx, n_re);
+  print_result("Rx", rx_legacy_us, rx_fused_us, rx_fft_us, rx_error);
+
+  if (tx_error > 1e-8f || rx_error > 1e-8f) {
+    ERROR("The fused and legacy outputs differ");
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_ofdm_rx_free(&fft);
+  srsran_ofdm_tx_free(&ifft);
+  if (grid) {
+    free(grid);
+  }
+  if (grid_rx) {
+    free(grid_rx);
+  }
+  if (grid_ref) {
+    free(grid_ref);
+  }
+  if (signal) {
+    free(signal);
+  }
+  if (signal_ref) {
+    free(signal_ref);
+  }
+  srsran_random_free(random_gen);
+
+  return ret;
+}
@@ -37,6 +37,9 @@ static float    ebno_db     = 100.0;
 static uint32_t seed        = 0;
 static bool     tail_biting = false;
 
+// One more than the decoded at once, so that the frames are split
+#define NOF_MULTI_FRAMES (SRSRAN_VITERBI_MAX_STREAMS + 1)
+
 #define SNR_POINTS 10
 #define SNR_MIN 0.0
 #define SNR_MAX 5.0
@@ -109,11 +112,16 @@ int main(int argc, char** argv)
   uint8_t * data_tx, *data_rx, *symbols;
   float     var[SNR_POINTS], varunc[SNR_POINTS];
   int       snr_points;
-  int       errors_s   = 0;
-  int       errors_us  = 0;
-  int       errors_c   = 0;
-  int       errors_f   = 0;
-  int       errors_sse = 0;
+  int       errors_s     = 0;
+  int       errors_us    = 0;
+  int       errors_c     = 0;
+  int       errors_f     = 0;
+  int       errors_sse   = 0;
+  int       errors_multi = 0;
+  int       errors_multi_stream[NOF_MULTI_FRAMES];
+  float*    llr_multi[NOF_MULTI_FRAMES];
+  uint8_t*  data_tx_multi[NOF_MULTI_FRAMES];
+  uint8_t*  data_rx_multi[NOF_MULTI_FRAMES];
 #ifdef TEST_SSE
   srsran_viterbi_t dec_sse;
 #endif
@@ -185,6 +193,25 @@ int main(int argc, char** argv)
     perror("malloc");
     exit(-1);
   }
+  // The first stream decodes the same frame as the other decoders, the others decode frames of their own
+  llr_multi[0]     = llr;
+  data_tx_multi[0] = data_tx;
+  for (uint32_t i = 0; i < NOF_MULTI_FRAMES; i++) {
+    if (i > 0) {
+      llr_multi[i]     = srsran_vec_f_malloc(coded_length);
+      data_tx_multi[i] = srsran_vec_u8_malloc(frame_length);
+      if (!llr_multi[i] || !data_tx_multi[i]) {
+        perror("malloc");
+        exit(-1);
+      }
+    }
+    data_rx_multi[i] = srsran_vec_u8_malloc(frame_length);
+    if (!data_rx_multi[i]) {
+      perror("malloc");
+      exit(-1);
+    }
+  }
+  srsran_random_t random_multi = srsran_random_init(seed);
 
   float ebno_inc, esno_db;
   ebno_inc = (SNR_MAX - SNR_MIN) / SNR_POINTS;
@@ -208,7 +235,9 @@ int main(int argc, char** argv)
     errors_s   = 0;
     errors_c   = 0;
     errors_f   = 0;
-    errors_sse = 0;
+    errors_sse   = 0;
+    errors_multi = 0;
+    bzero(errors_multi_stream, sizeof(errors_multi_stream));
     while (frame_cnt < nof_frames) {
       /* generate data_tx */
       srsran_random_t random_gen = srsran_random_init(0);
@@ -244,6 +273,26 @@ int main(int argc, char** argv)
 #ifdef TEST_SSE
       VITERBI_TEST(srsran_viterbi_decode_uc, dec_sse, llr_c, errors_sse);
 #endif
+
+      // Decode a different frame in each stream. Each stream is a test of its own, the worst one is reported
+      for (uint32_t j = 1; j < NOF_MULTI_FRAMES; j++) {
+        for (int k = 0; k < frame_length; k++) {
+          data_tx_multi[j][k] = srsran_random_uniform_int_dist(random_multi, 0, 1);
+        }
+        srsran_convcoder_encode(&cod, data_tx_multi[j], symbols, frame_length);
+        for (int k = 0; k < coded_length; k++) {
+          llr_multi[j][k] = symbols[k] ? M_SQRT2 : -M_SQRT2;
+        }
+        srsran_ch_awgn_f(llr_multi[j], llr_multi[j], var[i], coded_length);
+      }
+      if (srsran_viterbi_decode_f_multi(&dec, llr_multi, data_rx_multi, NOF_MULTI_FRAMES, frame_length) < 0) {
+        errors_multi = -1;
+      } else if (errors_multi >= 0) {
+        for (uint32_t j = 0; j < NOF_MULTI_FRAMES; j++) {
+          errors_multi_stream[j] += srsran_bit_diff(data_tx_multi[j], data_rx_multi[j], frame_length);
+          errors_multi = SRSRAN_MAX(errors_multi, errors_multi_stream[j]);
+        }
+      }
       frame_cnt++;
       printf("     Eb/No: %3.2f %10d/%d   ", SNR_MIN + i * ebno_inc, frame_cnt, nof_frames);
       if (errors_s >= 0)
@@ -254,6 +303,8 @@ int main(int argc, char** argv)
         printf("uint8  BER: %.2e  ", (float)errors_c / (frame_cnt * frame_length));
       if (errors_f >= 0)
         printf("float  BER: %.2e  ", (float)errors_f / (frame_cnt * frame_length));
+      if (errors_multi >= 0)
+        printf("multi  BER: %.2e  ", (float)errors_multi / (frame_cnt * frame_length));
 #ifdef TEST_SSE
       printf("sse    BER: %.2e  ", (float)errors_sse / (frame_cnt * frame_length));
 #endif
@@ -270,6 +321,8 @@ int main(int argc, char** argv)
         printf("uint8  BER    :    %g\t%u errors\n", (float)errors_c / (frame_cnt * frame_length), errors_c);
       if (errors_f >= 0)
         printf("float  BER    :    %g\t%u errors\n", (float)errors_f / (frame_cnt * frame_length), errors_f);
+      if (errors_multi >= 0)
+        printf("multi  BER    :    %g\t%u errors\n", (float)errors_multi / (frame_cnt * frame_length), errors_multi);
 #ifdef TEST_SSE
       printf("sse    BER    :    %g\t%u errors\n", (float)errors_sse / (frame_cnt * frame_length), errors_sse);
 #endif
@@ -287,6 +340,14 @@ int main(int argc, char** argv)
   free(llr_s);
   free(llr_us);
   free(data_rx);
+  for (uint32_t i = 0; i < NOF_MULTI_FRAMES; i++) {
+    if (i > 0) {
+      free(llr_multi[i]);
+      free(data_tx_multi[i]);
+    }
+    free(data_rx_multi[i]);
+  }
+  srsran_random_free(random_multi);
 
   if (snr_points == 1) {
     int expected_e = get_expected_errors(nof_frames, seed, frame_length, tail_biting, ebno_db);
@@ -294,14 +355,21 @@ int main(int argc, char** argv)
       ERROR("Test parameters not defined in test_results.h");
       exit(-1);
     } else {
-      printf(
-          "errors =(%d,%d,%d,%d,%d), expected =%d\n", errors_s, errors_us, errors_c, errors_f, errors_sse, expected_e);
+      printf("errors =(%d,%d,%d,%d,%d,%d), expected =%d\n",
+             errors_s,
+             errors_us,
+             errors_c,
+             errors_f,
+             errors_sse,
+             errors_multi,
+             expected_e);
       bool passed = true;
       passed &= (bool)(errors_us <= expected_e);
       passed &= (bool)(errors_s <= expected_e);
       passed &= (bool)(errors_c <= expected_e);
       passed &= (bool)(errors_f <= expected_e);
       passed &= (bool)(errors_sse <= expected_e);
+      passed &= (bool)(errors_multi >= 0 && errors_multi <= expected_e);
       exit(!passed);
     }
   } else {
@@ -39,6 +39,9 @@
 #define DEFAULT_GAIN 100
 
 #define DEFAULT_GAIN_16 500
+
+/* The multi-stream decoder costs as much as decoding this many frames one by one */
+#define MULTI_MIN_FRAMES 7
 #define VITERBI_16
 
 #ifndef LV_HAVE_AVX2
@@ -156,6 +159,50 @@ int decode37_avx2_16bit(void* o, uint16_t* symbols, uint8_t* data, uint32_t fram
   return q->framebits;
 }
 
+static float symbols_max_abs(float* symbols, uint32_t len);
+
+int decode37_avx2_multi(srsran_viterbi_t* q,
+                        float*            symbols[],
+                        uint8_t*          data[],
+                        uint32_t          nof_frames,
+                        uint32_t          frame_length)
+{
+  uint32_t best_state[SRSRAN_VITERBI_MAX_STREAMS] = {};
+  uint32_t len = 3 * (q->tail_biting ? frame_length : frame_length + q->K - 1);
+
+  /* Quantize each frame with its own gain and interleave the symbols of all the frames */
+  for (uint32_t s = 0; s < nof_frames; s++) {
+    float gain = q->gain_quant / symbols_max_abs(symbols[s], len);
+    srsran_vec_quant_fus(symbols[s], q->symbols_us, gain, 32767.5, 65535, len);
+    for (uint32_t i = 0; i < len; i++) {
+      q->symbols_multi[i * SRSRAN_VITERBI_MAX_STREAMS + s] = q->symbols_us[i];
+    }
+  }
+
+  /* Initialize Viterbi decoder */
+  init_viterbi37_avx2_multi(q->ptr_multi, q->tail_biting ? -1 : 0);
+
+  /* Decode block. The tail biting iterations run over the same symbols, instead of copying them */
+  if (q->tail_biting) {
+    for (int i = 0; i < TB_ITER; i++) {
+      update_viterbi37_blk_avx2_multi(
+          q->ptr_multi, q->symbols_multi, frame_length, (i == TB_ITER - 1) ? best_state : NULL);
+    }
+    chainback_viterbi37_avx2_multi(q->ptr_multi,
+                                   data,
+                                   nof_frames,
+                                   TB_ITER * frame_length,
+                                   ((int)(TB_ITER / 2)) * frame_length,
+                                   frame_length,
+                                   best_state);
+  } else {
+    update_viterbi37_blk_avx2_multi(q->ptr_multi, q->symbols_multi, frame_length + q->K - 1, NULL);
+    chainback_viterbi37_avx2_multi(q->ptr_multi, data, nof_frames, frame_length, 0, frame_length, best_state);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 void free37_avx2_16bit(void* o)
 {
   srsran_viterbi_t* q = o;
@@ -172,7 +219,11 @@ void free37_avx2_16bit(void* o)
   if (q->tmp_s) {
     free(q->tmp_s);
   }
+  if (q->symbols_multi) {
+    free(q->symbols_multi);
+  }
   delete_viterbi37_avx2_16bit(q->ptr);
+  delete_viterbi37_avx2_multi(q->ptr_multi);
 }
 
 int decode37_avx2(void* o, uint8_t* symbols, uint8_t* data, uint32_t frame_length)
@@ -464,9 +515,22 @@ int init37_avx2_16bit(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool
     ERROR("create_viterbi37 failed");
     free37(q);
     return -1;
-  } else {
-    return 0;
   }
+
+  /* Multi-stream decoder, the unused streams decode zeros */
+  q->symbols_multi = srsran_vec_u16_malloc(SRSRAN_VITERBI_MAX_STREAMS * 3 * (q->framebits + q->K - 1));
+  if (!q->symbols_multi) {
+    perror("malloc");
+    srsran_viterbi_free(q);
+    return -1;
+  }
+  bzero(q->symbols_multi, SRSRAN_VITERBI_MAX_STREAMS * 3 * (q->framebits + q->K - 1) * sizeof(uint16_t));
+  if ((q->ptr_multi = create_viterbi37_avx2_multi(poly, TB_ITER * framebits)) == NULL) {
+    ERROR("create_viterbi37 failed");
+    srsran_viterbi_free(q);
+    return -1;
+  }
+  return 0;
 }
 
 #endif
@@ -544,6 +608,16 @@ void srsran_viterbi_free(srsran_viterbi_t* q)
   bzero(q, sizeof(srsran_viterbi_t));
 }
 
+static float symbols_max_abs(float* symbols, uint32_t len)
+{
+  float    max   = 1e-9;
+  uint32_t max_i = srsran_vec_max_abs_fi(symbols, len);
+  if (max_i < len && isnormal(symbols[max_i])) {
+    max = fabsf(symbols[max_i]);
+  }
+  return max;
+}
+
 /* symbols are real-valued */
 int srsran_viterbi_decode_f(srsran_viterbi_t* q, float* symbols, uint8_t* data, uint32_t frame_length)
 {
@@ -558,11 +632,7 @@ int srsran_viterbi_decode_f(srsran_viterbi_t* q, float* symbols, uint8_t* data,
     len = 3 * (frame_length + q->K - 1);
   }
   if (!q->decode_f) {
-    float    max   = 1e-9;
-    uint32_t max_i = srsran_vec_max_abs_fi(symbols, len);
-    if (max_i < len && isnormal(symbols[max_i])) {
-      max = fabsf(symbols[max_i]);
-    }
+    float max = symbols_max_abs(symbols, len);
 #ifdef VITERBI_16
     srsran_vec_quant_fus(symbols, q->symbols_us, q->gain_quant / max, 32767.5, 65535, len);
     return srsran_viterbi_decode_us(q, q->symbols_us, data, frame_length);
@@ -575,6 +645,38 @@ int srsran_viterbi_decode_f(srsran_viterbi_t* q, float* symbols, uint8_t* data,
   }
 }
 
+int srsran_viterbi_decode_f_multi(srsran_viterbi_t* q,
+                                  float*            symbols[],
+                                  uint8_t*          data[],
+                                  uint32_t          nof_frames,
+                                  uint32_t          frame_length)
+{
+  if (frame_length > q->framebits) {
+    ERROR("Initialized decoder for max frame length %d bits", q->framebits);
+    return SRSRAN_ERROR;
+  }
+
+  while (nof_frames > 0) {
+    uint32_t n = SRSRAN_MIN(nof_frames, SRSRAN_VITERBI_MAX_STREAMS);
+#ifdef LV_HAVE_AVX2
+    if (q->ptr_multi && n >= MULTI_MIN_FRAMES) {
+      decode37_avx2_multi(q, symbols, data, n, frame_length);
+    } else
+#endif
+    {
+      for (uint32_t i = 0; i < n; i++) {
+        if (srsran_viterbi_decode_f(q, symbols[i], data[i], frame_length) < 0) {
+          return SRSRAN_ERROR;
+        }
+      }
+    }
+    symbols += n;
+    data += n;
+    nof_frames -= n;
+  }
+  return SRSRAN_SUCCESS;
+}
+
 /* symbols are int16 */
 int srsran_viterbi_decode_s(srsran_viterbi_t* q, int16_t* symbols, uint8_t* data, uint32_t frame_length)
 {
@@ -0,0 +1,252 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/* r=1/3 k=7 Viterbi decoder for x86 AVX2 that decodes up to 16 frames of the same length at once.
+ *
+ * Unlike the single frame decoders, which spread the 64 trellis states across the SIMD lanes, each 16-bit lane holds
+ * the path metric of a different frame (stream). Every butterfly is therefore computed for all the streams with plain
+ * vertical instructions, without shuffling the states between lanes.
+ *
+ * Symbols are unsigned 16-bit, interleaved per stream: syms[(3 * n + k) * 16 + stream] is the k-th symbol of the n-th
+ * bit of the given stream.
+ */
+
+#include "parity.h"
+#include <memory.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef LV_HAVE_AVX2
+
+#include <immintrin.h>
+
+#define NOF_STREAMS 16
+#define NOF_STATES 64
+
+/* Branch metrics are 12-bit wide. The path metrics spread of a K=7 code is bounded by 6 branch metrics, which fits in
+ * a signed 16-bit difference, so the metrics can wrap around and do not need to be normalized */
+#define METRIC_SHIFT 4
+#define METRIC_MAX 4095
+
+/* The decisions of the states 2i and 2i+1 of every stream are packed in a 32-bit word */
+typedef struct {
+  uint32_t w[NOF_STATES / 2];
+} decision_t;
+
+/* State info for instance of Viterbi decoder */
+struct v37_multi {
+  __m256i     metrics1[NOF_STATES];        /* path metric buffer 1 */
+  __m256i     metrics2[NOF_STATES];        /* path metric buffer 2 */
+  __m256i *   old_metrics, *new_metrics;   /* Pointers to path metrics, swapped on every bit */
+  decision_t* dp;                          /* Pointer to current decision */
+  decision_t* decisions;                   /* Beginning of decisions for block */
+  uint32_t    len;                         /* Number of decisions that fit in the buffer */
+  uint8_t     branch_code[NOF_STATES / 2]; /* Encoder output bits of the transitions out of each butterfly */
+};
+
+/* Initialize Viterbi decoder for start of new frame */
+int init_viterbi37_avx2_multi(void* p, int starting_state)
+{
+  struct v37_multi* vp = p;
+
+  if (p == NULL) {
+    return -1;
+  }
+
+  for (uint32_t i = 0; i < NOF_STATES; i++) {
+    vp->metrics1[i] = _mm256_set1_epi16(METRIC_MAX);
+  }
+  if (starting_state != -1) {
+    vp->metrics1[starting_state & 63] = _mm256_setzero_si256(); /* Bias known start state */
+  }
+
+  vp->old_metrics = vp->metrics1;
+  vp->new_metrics = vp->metrics2;
+  vp->dp          = vp->decisions;
+  return 0;
+}
+
+/* Create a new instance of a multi-stream Viterbi decoder */
+void* create_viterbi37_avx2_multi(int polys[3], uint32_t len)
+{
+  void*             p;
+  struct v37_multi* vp;
+
+  if (posix_memalign(&p, sizeof(__m256i), sizeof(struct v37_multi))) {
+    return NULL;
+  }
+  vp = (struct v37_multi*)p;
+
+  if (posix_memalign(&p, sizeof(__m256i), (len + 6) * sizeof(decision_t))) {
+    free(vp);
+    return NULL;
+  }
+  vp->decisions = (decision_t*)p;
+  vp->len       = len + 6;
+
+  for (uint32_t state = 0; state < NOF_STATES / 2; state++) {
+    vp->branch_code[state] = 0;
+    for (uint32_t k = 0; k < 3; k++) {
+      vp->branch_code[state] |= ((polys[k] < 0) ^ parity((2 * state) & polys[k])) << k;
+    }
+  }
+
+  init_viterbi37_avx2_multi(vp, 0);
+  return vp;
+}
+
+/* Process nbits bits of all the streams. best_state, if given, is filled with the final best state of each stream */
+int update_viterbi37_blk_avx2_multi(void* p, uint16_t* syms, uint32_t nbits, uint32_t* best_state)
+{
+  struct v37_multi* vp = p;
+
+  if (p == NULL || vp->dp + nbits + 6 > vp->decisions + vp->len) {
+    return -1;
+  }
+
+  const __m256i  ones        = _mm256_set1_epi16(-1);
+  const __m256i  metric_max  = _mm256_set1_epi16(METRIC_MAX);
+  const uint8_t* branch_code = vp->branch_code;
+
+  decision_t* d           = vp->dp;
+  __m256i*    old_metrics = vp->old_metrics;
+  __m256i*    new_metrics = vp->new_metrics;
+  while (nbits--) {
+    __m256i sym[3][2];
+    __m256i metric[8];
+
+    /* Symbols and their complements, for the expected encoder output bits 0 and 1 */
+    for (uint32_t k = 0; k < 3; k++) {
+      sym[k][0] = _mm256_loadu_si256((__m256i*)&syms[k * NOF_STREAMS]);
+      sym[k][1] = _mm256_xor_si256(sym[k][0], ones);
+    }
+    syms += 3 * NOF_STREAMS;
+
+    /* There are only 8 different branch metrics, one for each encoder output */
+    for (uint32_t c = 0; c < 8; c++) {
+      __m256i m = _mm256_avg_epu16(_mm256_avg_epu16(sym[0][c & 1], sym[1][(c >> 1) & 1]), sym[2][(c >> 2) & 1]);
+      metric[c] = _mm256_srli_epi16(m, METRIC_SHIFT);
+    }
+
+    for (uint32_t i = 0; i < NOF_STATES / 2; i++) {
+      __m256i decision0, decision1, m_metric, m0, m1, m2, m3;
+
+      /* Add branch metrics to path metrics */
+      m_metric = _mm256_sub_epi16(metric_max, metric[branch_code[i]]);
+      m0       = _mm256_add_epi16(old_metrics[i], metric[branch_code[i]]);
+      m1       = _mm256_add_epi16(old_metrics[32 + i], m_metric);
+      m2       = _mm256_add_epi16(old_metrics[i], m_metric);
+      m3       = _mm256_add_epi16(old_metrics[32 + i], metric[branch_code[i]]);
+
+      /* Compare and select, using modulo arithmetic */
+      decision0 = _mm256_cmpgt_epi16(_mm256_sub_epi16(m0, m1), _mm256_setzero_si256());
+      decision1 = _mm256_cmpgt_epi16(_mm256_sub_epi16(m2, m3), _mm256_setzero_si256());
+
+      new_metrics[2 * i]     = _mm256_blendv_epi8(m0, m1, decision0);
+      new_metrics[2 * i + 1] = _mm256_blendv_epi8(m2, m3, decision1);
+
+      /* Bit (s % 8) + 8 * b + 16 * (s / 8) holds the decision of the state 2i+b of the stream s */
+      d->w[i] = (uint32_t)_mm256_movemask_epi8(_mm256_packs_epi16(decision0, decision1));
+    }
+
+    d++;
+    /* Swap pointers to old and new metrics */
+    __m256i* tmp = old_metrics;
+    old_metrics  = new_metrics;
+    new_metrics  = tmp;
+  }
+
+  /* The chainback looks past the last decision */
+  memset(d, 0, 6 * sizeof(decision_t));
+  vp->dp          = d;
+  vp->old_metrics = old_metrics;
+  vp->new_metrics = new_metrics;
+
+  if (best_state) {
+    int16_t metrics[NOF_STATES][NOF_STREAMS];
+    for (uint32_t i = 0; i < NOF_STATES; i++) {
+      _mm256_storeu_si256((__m256i*)metrics[i], old_metrics[i]);
+    }
+    for (uint32_t s = 0; s < NOF_STREAMS; s++) {
+      /* Metrics are compared relative to the first state, as they may have wrapped around */
+      uint32_t bst       = 0;
+      int16_t  minmetric = 0;
+      for (uint32_t i = 0; i < NOF_STATES; i++) {
+        int16_t m = (int16_t)(metrics[i][s] - metrics[0][s]);
+        if (m <= minmetric) {
+          bst       = i;
+          minmetric = m;
+        }
+      }
+      best_state[s] = bst;
+    }
+  }
+  return 0;
+}
+
+/* Viterbi chainback of the first nof_streams streams. The chains are independent, so they are interleaved. Only the
+ * bits first_bit to first_bit + len - 1 are stored, and the chainback stops after them */
+int chainback_viterbi37_avx2_multi(void*     p,
+                                   uint8_t*  data[],   /* Decoded output data of each stream */
+                                   uint32_t  nof_streams,
+                                   uint32_t  nbits,    /* Number of data bits */
+                                   uint32_t  first_bit,
+                                   uint32_t  len,
+                                   uint32_t* endstate) /* Terminal encoder state of each stream */
+{
+  struct v37_multi* vp = p;
+  uint32_t          state[NOF_STREAMS];
+
+  if (p == NULL || nof_streams > NOF_STREAMS || first_bit + len > nbits) {
+    return -1;
+  }
+
+  for (uint32_t s = 0; s < nof_streams; s++) {
+    state[s] = endstate[s] % 64;
+  }
+
+  decision_t* d = vp->decisions;
+  d += 6; /* Look past tail */
+  while (nbits-- > first_bit) {
+    for (uint32_t s = 0; s < nof_streams; s++) {
+      uint32_t shift = (s % 8) + 8 * (state[s] % 2) + 16 * (s / 8);
+      uint32_t k     = (d[nbits].w[state[s] / 2] >> shift) & 1;
+      state[s]       = (state[s] >> 1) | (k << 5);
+      if (nbits < first_bit + len) {
+        data[s][nbits - first_bit] = k;
+      }
+    }
+  }
+  return 0;
+}
+
+/* Delete instance of a Viterbi decoder */
+void delete_viterbi37_avx2_multi(void* p)
+{
+  struct v37_multi* vp = p;
+
+  if (vp != NULL) {
+    free(vp->decisions);
+    free(vp);
+  }
+}
+
+#endif
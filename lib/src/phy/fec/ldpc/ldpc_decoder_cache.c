@@ -0,0 +1,281 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file ldpc_decoder_cache.c
+ * \brief Definition of a process-wide cache of LDPC decoders.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "../utils_avx2.h"
+#include "../utils_avx512.h"
+#include "srsran/phy/fec/ldpc/base_graph.h"
+#include "srsran/phy/fec/ldpc/ldpc_decoder_cache.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+
+/*!
+ * \brief Decoder instance of a cache entry. The decoder must be the first member so that the node can be recovered
+ * from the decoder pointer handed out to the users.
+ */
+typedef struct decoder_node_s {
+  srsran_ldpc_decoder_t  decoder; /*!< \brief The decoder itself. */
+  struct decoder_node_s* next;    /*!< \brief Next idle decoder of the entry. */
+} decoder_node_t;
+
+struct srsran_ldpc_decoder_cache_entry_s {
+  srsran_ldpc_decoder_args_t                args;         /*!< \brief Key of the entry. */
+  uint32_t                                  refcount;     /*!< \brief Number of users of the entry. */
+  uint32_t                                  nof_decoders; /*!< \brief Number of decoders, idle or in use. */
+  uint64_t                                  nbytes;       /*!< \brief Estimated memory held by the decoders. */
+  decoder_node_t*                           idle;         /*!< \brief List of idle decoders. */
+  struct srsran_ldpc_decoder_cache_entry_s* next;         /*!< \brief Next entry of the cache. */
+};
+
+static pthread_mutex_t                    cache_mutex        = PTHREAD_MUTEX_INITIALIZER;
+static srsran_ldpc_decoder_cache_entry_t* cache_entries      = NULL;
+static uint32_t                           cache_nof_decoders = 0;
+static uint64_t                           cache_nbytes       = 0;
+
+static bool args_equal(const srsran_ldpc_decoder_args_t* a, const srsran_ldpc_decoder_args_t* b)
+{
+  return a->type == b->type && a->bg == b->bg && a->ls == b->ls && a->scaling_fctr == b->scaling_fctr &&
+         a->max_nof_iter == b->max_nof_iter;
+}
+
+/*!
+ * Estimates the memory held by a decoder from the size of its dominant buffers: the parity check matrix and the
+ * soft-bit, variable-to-check and check-to-variable registers allocated by each implementation.
+ */
+static uint64_t decoder_nbytes(const srsran_ldpc_decoder_t* q, srsran_ldpc_decoder_type_t type)
+{
+  uint64_t nbytes = sizeof(decoder_node_t);
+  nbytes += (uint64_t)q->bgM * q->bgN * sizeof(uint16_t);
+  nbytes += (uint64_t)q->bgM * sizeof(int8_t[MAX_CNCT]);
+
+  uint64_t hrr  = q->bgK + 4;
+  uint64_t hrrN = hrr * q->ls;
+
+  uint64_t elem_size  = sizeof(int8_t);
+  uint64_t simd_width = 0;
+  bool     flood      = false;
+  switch (type) {
+    case SRSRAN_LDPC_DECODER_F:
+      elem_size = sizeof(float);
+      break;
+    case SRSRAN_LDPC_DECODER_S:
+      elem_size = sizeof(int16_t);
+      break;
+    case SRSRAN_LDPC_DECODER_C:
+      break;
+    case SRSRAN_LDPC_DECODER_C_FLOOD:
+      flood = true;
+      break;
+    case SRSRAN_LDPC_DECODER_C_AVX2:
+      simd_width = SRSRAN_AVX2_B_SIZE;
+      break;
+    case SRSRAN_LDPC_DECODER_C_AVX2_FLOOD:
+      simd_width = SRSRAN_AVX2_B_SIZE;
+      flood      = true;
+      break;
+    case SRSRAN_LDPC_DECODER_C_AVX512:
+      simd_width = SRSRAN_AVX512_B_SIZE;
+      break;
+    case SRSRAN_LDPC_DECODER_C_AVX512_FLOOD:
+      simd_width = SRSRAN_AVX512_B_SIZE;
+      flood      = true;
+      break;
+  }
+
+  if (simd_width == 0) {
+    // Scalar decoders store one element per lifted node
+    nbytes += (uint64_t)q->liftN * elem_size * (flood ? 2 : 1);
+    nbytes += (hrrN + q->ls) * q->bgM * elem_size;
+    nbytes += (hrrN + q->ls) * (flood ? q->bgM : 1) * elem_size;
+  } else {
+    // SIMD decoders store every base graph node in an integer number of registers
+    uint64_t node_size = SRSRAN_CEIL(q->ls, simd_width) * simd_width;
+    nbytes += q->bgN * node_size * (flood ? 2 : 1);
+    nbytes += (hrr + 1) * q->bgM * node_size;
+    nbytes += (hrr + 1) * (flood ? q->bgM : 1) * node_size;
+  }
+
+  return nbytes;
+}
+
+srsran_ldpc_decoder_cache_entry_t* srsran_ldpc_decoder_cache_get(const srsran_ldpc_decoder_args_t* args)
+{
+  if (args == NULL) {
+    return NULL;
+  }
+
+  pthread_mutex_lock(&cache_mutex);
+
+  srsran_ldpc_decoder_cache_entry_t* entry = cache_entries;
+  while (entry != NULL && !args_equal(&entry->args, args)) {
+    entry = entry->next;
+  }
+
+  if (entry == NULL) {
+    entry = SRSRAN_MEM_ALLOC(srsran_ldpc_decoder_cache_entry_t, 1);
+    if (entry != NULL) {
+      SRSRAN_MEM_ZERO(entry, srsran_ldpc_decoder_cache_entry_t, 1);
+      entry->args   = *args;
+      entry->next   = cache_entries;
+      cache_entries = entry;
+    } else {
+      ERROR("Error: calloc");
+    }
+  }
+
+  if (entry != NULL) {
+    entry->refcount++;
+  }
+
+  pthread_mutex_unlock(&cache_mutex);
+
+  return entry;
+}
+
+void srsran_ldpc_decoder_cache_put(srsran_ldpc_decoder_cache_entry_t* entry)
+{
+  if (entry == NULL) {
+    return;
+  }
+
+  pthread_mutex_lock(&cache_mutex);
+
+  if (entry->refcount > 1) {
+    entry->refcount--;
+    pthread_mutex_unlock(&cache_mutex);
+    return;
+  }
+
+  // Last reference, unlink the entry
+  srsran_ldpc_decoder_cache_entry_t** link = &cache_entries;
+  while (*link != NULL && *link != entry) {
+    link = &(*link)->next;
+  }
+  if (*link != NULL) {
+    *link = entry->next;
+  }
+
+  uint32_t nof_idle = 0;
+  for (decoder_node_t* node = entry->idle; node != NULL; node = node->next) {
+    nof_idle++;
+  }
+  if (nof_idle != entry->nof_decoders) {
+    ERROR("Error: releasing LDPC decoder cache entry with %d decoders in use", entry->nof_decoders - nof_idle);
+  }
+
+  cache_nof_decoders -= entry->nof_decoders;
+  cache_nbytes -= entry->nbytes;
+
+  pthread_mutex_unlock(&cache_mutex);
+
+  decoder_node_t* node = entry->idle;
+  while (node != NULL) {
+    decoder_node_t* next = node->next;
+    srsran_ldpc_decoder_free(&node->decoder);
+    free(node);
+    node = next;
+  }
+  free(entry);
+}
+
+srsran_ldpc_decoder_t* srsran_ldpc_decoder_cache_acquire(srsran_ldpc_decoder_cache_entry_t* entry)
+{
+  if (entry == NULL) {
+    return NULL;
+  }
+
+  pthread_mutex_lock(&cache_mutex);
+  decoder_node_t* node = entry->idle;
+  if (node != NULL) {
+    entry->idle = node->next;
+  }
+  pthread_mutex_unlock(&cache_mutex);
+
+  if (node != NULL) {
+    return &node->decoder;
+  }
+
+  // All decoders are in use, initialise a new one outside the critical section
+  node = SRSRAN_MEM_ALLOC(decoder_node_t, 1);
+  if (node == NULL) {
+    ERROR("Error: calloc");
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(node, decoder_node_t, 1);
+
+  if (srsran_ldpc_decoder_init(&node->decoder, &entry->args) < SRSRAN_SUCCESS) {
+    ERROR("Error: initialising BG%d LDPC decoder for ls=%d", entry->args.bg + 1, entry->args.ls);
+    free(node);
+    return NULL;
+  }
+
+  uint64_t nbytes = decoder_nbytes(&node->decoder, entry->args.type);
+
+  pthread_mutex_lock(&cache_mutex);
+  entry->nof_decoders++;
+  entry->nbytes += nbytes;
+  cache_nof_decoders++;
+  cache_nbytes += nbytes;
+  pthread_mutex_unlock(&cache_mutex);
+
+  return &node->decoder;
+}
+
+void srsran_ldpc_decoder_cache_release(srsran_ldpc_decoder_cache_entry_t* entry, srsran_ldpc_decoder_t* decoder)
+{
+  if (entry == NULL || decoder == NULL) {
+    return;
+  }
+
+  decoder_node_t* node = (decoder_node_t*)decoder;
+
+  pthread_mutex_lock(&cache_mutex);
+  node->next  = entry->idle;
+  entry->idle = node;
+  pthread_mutex_unlock(&cache_mutex);
+}
+
+uint32_t srsran_ldpc_decoder_cache_nof_decoders()
+{
+  pthread_mutex_lock(&cache_mutex);
+  uint32_t nof_decoders = cache_nof_decoders;
+  pthread_mutex_unlock(&cache_mutex);
+  return nof_decoders;
+}
+
+uint64_t srsran_ldpc_decoder_cache_nbytes()
+{
+  pthread_mutex_lock(&cache_mutex);
+  uint64_t nbytes = cache_nbytes;
+  pthread_mutex_unlock(&cache_mutex);
+  return nbytes;
+}
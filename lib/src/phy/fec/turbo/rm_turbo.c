@@ -83,8 +83,13 @@ static bool                     rm_turbo_tables_generated = false;
 // Store deinterleaver version for sub-block turbo decoder
 #if SRSRAN_TDEC_EXPECT_INPUT_SB == 1
 // Prepare bit for sub-block decoder processing. These are the nof subblock sizes
+#ifdef LV_HAVE_AVX512
+#define NOF_DEINTER_TABLE_SB_IDX 4
+const static int deinter_table_sb_idx[NOF_DEINTER_TABLE_SB_IDX] = {8, 16, 32, 64};
+#else
 #define NOF_DEINTER_TABLE_SB_IDX 3
 const static int deinter_table_sb_idx[NOF_DEINTER_TABLE_SB_IDX] = {8, 16, 32};
+#endif
 int              deinter_table_idx_from_sb_len(uint32_t nof_subblocks)
 {
   for (int i = 0; i < NOF_DEINTER_TABLE_SB_IDX; i++) {
@@ -261,6 +266,10 @@ static void interleave_table_sb(uint16_t* in, uint16_t* out, uint32_t cb_idx, ui
 {
   int long_cb = srsran_cbsegm_cbsize(cb_idx);
   int out_len = 3 * long_cb + 12;
+  // Code blocks that do not split evenly in nof_sb sub-blocks are never decoded with nof_sb sub-blocks
+  if (long_cb % nof_sb) {
+    nof_sb = 1;
+  }
   for (int i = 0; i < out_len; i++) {
     // Do not change tail bit order
     if (in[i] < 3 * long_cb) {
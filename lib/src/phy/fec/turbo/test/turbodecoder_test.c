@@ -45,16 +45,28 @@ int nof_iterations  = MAX_ITERATIONS;
 int test_known_data = 0;
 int test_errors     = 0;
 int nof_repetitions = 1;
+int benchmark_all   = 0;
 
 srsran_tdec_impl_type_t tdec_type;
 
+static const char* tdec_type_names[SRSRAN_TDEC_NOF_IMP] = {"Auto",
+                                                            "Generic",
+                                                            "SSE",
+                                                            "SSE-window",
+                                                            "NEON-window",
+                                                            "AVX2-window",
+                                                            "AVX512-window",
+                                                            "SSE-8bit-window",
+                                                            "AVX2-8bit-window",
+                                                            "AVX512-8bit-window"};
+
 #define SNR_POINTS 4
 #define SNR_MIN 1.0
 #define SNR_MAX 8.0
 
 void usage(char* prog)
 {
-  printf("Usage: %s [kcinNledts]\n", prog);
+  printf("Usage: %s [kcinNledtsb]\n", prog);
   printf("\t-k Test with known data (ignores frame_length) [Default disabled]\n");
   printf("\t-c nof_cb in parallel [Default %d]\n", nof_cb);
   printf("\t-i nof_iterations [Default %d]\n", nof_iterations);
@@ -62,15 +74,19 @@ void usage(char* prog)
   printf("\t-N nof_repetitions [Default %d]\n", nof_repetitions);
   printf("\t-l frame_length [Default %d]\n", frame_length);
   printf("\t-e ebno in dB [Default scan]\n");
-  printf("\t-d Decoder implementation type: 0: Generic, 1: SSE, 2: SSE-window\n");
+  printf("\t-d Decoder implementation type:");
+  for (int i = 0; i < SRSRAN_TDEC_NOF_IMP; i++) {
+    printf(" %d: %s%s", i, tdec_type_names[i], i < SRSRAN_TDEC_NOF_IMP - 1 ? "," : "\n");
+  }
   printf("\t-t test: check errors on exit [Default disabled]\n");
   printf("\t-s seed [Default 0=time]\n");
+  printf("\t-b benchmark throughput of every available implementation [Default disabled]\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "kcinNledts")) != -1) {
+  while ((opt = getopt(argc, argv, "kcinNledtsb")) != -1) {
     switch (opt) {
       case 'c':
         nof_cb = (int)strtol(argv[optind], NULL, 10);
@@ -102,6 +118,9 @@ void parse_args(int argc, char** argv)
       case 's':
         seed = (uint32_t)strtoul(argv[optind], NULL, 0);
         break;
+      case 'b':
+        benchmark_all = 1;
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -112,6 +131,112 @@ void parse_args(int argc, char** argv)
   }
 }
 
+static bool tdec_type_is_8bit(srsran_tdec_impl_type_t type)
+{
+  return type == SRSRAN_TDEC_SSE8_WINDOW || type == SRSRAN_TDEC_AVX8_WINDOW || type == SRSRAN_TDEC_AVX512_8_WINDOW;
+}
+
+/* Decodes the same frames with every implementation supported by this build and reports its throughput */
+static int run_benchmark_all(srsran_random_t random_gen, float var, uint32_t coded_length)
+{
+  srsran_tcod_t tcod;
+  if (srsran_tcod_init(&tcod, frame_length)) {
+    ERROR("Error initiating Turbo coder");
+    return SRSRAN_ERROR;
+  }
+
+  uint8_t* data_tx       = srsran_vec_u8_malloc(frame_length);
+  uint8_t* data_rx       = srsran_vec_u8_malloc(frame_length);
+  uint8_t* data_rx_bytes = srsran_vec_u8_malloc(frame_length);
+  uint8_t* symbols       = srsran_vec_u8_malloc(coded_length);
+  float*   llr           = srsran_vec_f_malloc(coded_length);
+  int16_t* llr_s         = srsran_vec_i16_malloc(coded_length);
+  int8_t*  llr_c         = srsran_vec_i8_malloc(coded_length);
+  if (!data_tx || !data_rx || !data_rx_bytes || !symbols || !llr || !llr_s || !llr_c) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  uint32_t t = (nof_iterations == -1) ? MAX_ITERATIONS : nof_iterations;
+
+  printf("%-20s %10s %10s %12s\n", "Implementation", "Mbps", "usec/CB", "BER");
+  for (int type = 0; type < SRSRAN_TDEC_NOF_IMP; type++) {
+    srsran_tdec_t dec;
+    if (srsran_tdec_init_manual(&dec, frame_length, (srsran_tdec_impl_type_t)type)) {
+      // Implementation not available in this build
+      continue;
+    }
+    srsran_tdec_force_not_sb(&dec);
+
+    // Window decoders need code blocks that split evenly into sub-blocks longer than the 40 bit overlap window
+    int nof_blocks = tdec_type_is_8bit(type) ? dec.nof_blocks8[0] : dec.nof_blocks16[0];
+    if (type != SRSRAN_TDEC_AUTO && nof_blocks > 1 &&
+        ((frame_length % nof_blocks) != 0 || frame_length / nof_blocks < 40)) {
+      printf("%-20s %10s\n", tdec_type_names[type], "n/a");
+      srsran_tdec_free(&dec);
+      continue;
+    }
+
+    uint64_t       total_usec = 0;
+    uint32_t       errors     = 0;
+    struct timeval tdata[3];
+    for (uint32_t frame_cnt = 0; frame_cnt < nof_frames; frame_cnt++) {
+      for (uint32_t j = 0; j < frame_length; j++) {
+        data_tx[j] = srsran_random_uniform_int_dist(random_gen, 0, 1);
+      }
+      srsran_tcod_encode(&tcod, data_tx, symbols, frame_length);
+      for (uint32_t j = 0; j < coded_length; j++) {
+        llr[j] = symbols[j] ? 1 : -1;
+      }
+      srsran_ch_awgn_f(llr, llr, var, coded_length);
+
+      if (tdec_type_is_8bit(type)) {
+        for (uint32_t j = 0; j < coded_length; j++) {
+          llr_c[j] = (int8_t)SRSRAN_MAX(-127, SRSRAN_MIN(127, 16 * llr[j]));
+        }
+      } else {
+        for (uint32_t j = 0; j < coded_length; j++) {
+          llr_s[j] = (int16_t)(100 * llr[j]);
+        }
+      }
+
+      gettimeofday(&tdata[1], NULL);
+      for (int k = 0; k < nof_repetitions; k++) {
+        if (tdec_type_is_8bit(type)) {
+          srsran_tdec_run_all_8bit(&dec, llr_c, data_rx_bytes, t, frame_length);
+        } else {
+          srsran_tdec_run_all(&dec, llr_s, data_rx_bytes, t, frame_length);
+        }
+      }
+      gettimeofday(&tdata[2], NULL);
+      get_time_interval(tdata);
+      total_usec += tdata[0].tv_sec * 1000000 + tdata[0].tv_usec;
+
+      srsran_bit_unpack_vector(data_rx_bytes, data_rx, frame_length);
+      errors += srsran_bit_diff(data_tx, data_rx, frame_length);
+    }
+
+    float usec_cb = (float)total_usec / (nof_frames * nof_repetitions);
+    printf("%-20s %10.1f %10.2f %12.2e\n",
+           tdec_type_names[type],
+           (float)frame_length / usec_cb,
+           usec_cb,
+           (float)errors / (nof_frames * frame_length));
+
+    srsran_tdec_free(&dec);
+  }
+
+  free(data_tx);
+  free(data_rx);
+  free(data_rx_bytes);
+  free(symbols);
+  free(llr);
+  free(llr_s);
+  free(llr_c);
+  srsran_tcod_free(&tcod);
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   srsran_random_t random_gen = srsran_random_init(0);
@@ -153,6 +278,13 @@ int main(int argc, char** argv)
     printf("  EbNo: %.2f\n", ebno_db);
   }
 
+  if (benchmark_all) {
+    float esno_db = (ebno_db == 100.0 ? SNR_MAX : ebno_db) + srsran_convert_power_to_dB(1.0f / 3.0f);
+    int   ret     = run_benchmark_all(random_gen, srsran_convert_dB_to_amplitude(-esno_db), coded_length);
+    srsran_random_free(random_gen);
+    exit(ret);
+  }
+
   data_tx = srsran_vec_u8_malloc(frame_length);
   if (!data_tx) {
     perror("malloc");
@@ -87,6 +87,13 @@ static int pdcch_init(srsran_pdcch_t* q, uint32_t max_prb, uint32_t nof_rx_anten
       goto clean;
     }
 
+    if (q->is_ue) {
+      q->rm_f_multi = srsran_vec_f_malloc(SRSRAN_VITERBI_MAX_STREAMS * 3 * (SRSRAN_DCI_MAX_BITS + 16));
+      if (!q->rm_f_multi) {
+        goto clean;
+      }
+    }
+
     srsran_vec_f_zero(q->llr, q->max_bits);
 
     q->d = srsran_vec_cf_malloc(q->max_bits / 2);
@@ -140,6 +147,9 @@ void srsran_pdcch_free(srsran_pdcch_t* q)
   if (q->llr) {
     free(q->llr);
   }
+  if (q->rm_f_multi) {
+    free(q->rm_f_multi);
+  }
   if (q->d) {
     free(q->d);
   }
@@ -369,6 +379,18 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
   }
 }
 
+/** Absolute mean of the LLRs of a candidate location, used to skip the locations that carry no energy */
+static float pdcch_llr_mean(srsran_pdcch_t* q, srsran_dci_location_t* location)
+{
+  uint32_t e_bits = PDCCH_FORMAT_NOF_BITS(location->L);
+
+  double mean = 0;
+  for (int i = 0; i < e_bits; i++) {
+    mean += fabsf(q->llr[location->ncce * 72 + i]);
+  }
+  return mean / e_bits;
+}
+
 /** Tries to decode a DCI message from the LLRs stored in the srsran_pdcch_t structure by the function
  * srsran_pdcch_extract_llr(). This function can be called multiple times.
  * The location to search for is obtained from msg.
@@ -388,11 +410,7 @@ int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dc
       uint32_t e_bits   = PDCCH_FORMAT_NOF_BITS(msg->location.L);
 
       // Compute absolute mean of the LLRs
-      double mean = 0;
-      for (int i = 0; i < e_bits; i++) {
-        mean += fabsf(q->llr[msg->location.ncce * 72 + i]);
-      }
-      mean /= e_bits;
+      float mean = pdcch_llr_mean(q, &msg->location);
 
       if (mean > 0.3f) {
         ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
@@ -422,6 +440,113 @@ int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dc
   return ret;
 }
 
+int srsran_pdcch_decode_msg_multi(srsran_pdcch_t*     q,
+                                  srsran_dl_sf_cfg_t* sf,
+                                  srsran_dci_cfg_t*   dci_cfg,
+                                  srsran_dci_msg_t*   msgs,
+                                  uint32_t            nof_msgs)
+{
+  uint32_t nof_bits[SRSRAN_PDCCH_MAX_CANDIDATES_MULTI];
+  int      source[SRSRAN_PDCCH_MAX_CANDIDATES_MULTI];
+  float*   symbols[SRSRAN_VITERBI_MAX_STREAMS];
+  uint8_t* data[SRSRAN_VITERBI_MAX_STREAMS];
+  uint32_t batch[SRSRAN_VITERBI_MAX_STREAMS];
+
+  if (q == NULL || msgs == NULL || q->rm_f_multi == NULL || nof_msgs > SRSRAN_PDCCH_MAX_CANDIDATES_MULTI) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Compute the size of each candidate and drop the locations without energy. The candidates with the same location
+  // and size as a previous one are not decoded again
+  float mean = 0;
+  for (uint32_t i = 0; i < nof_msgs; i++) {
+    srsran_dci_msg_t* msg = &msgs[i];
+    if (!srsran_dci_location_isvalid(&msg->location) ||
+        msg->location.ncce * 72 + PDCCH_FORMAT_NOF_BITS(msg->location.L) > NOF_CCE(sf->cfi) * 72) {
+      ERROR("Invalid location: nCCE: %d, L: %d, NofCCE: %d", msg->location.ncce, msg->location.L, NOF_CCE(sf->cfi));
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+    msg->rnti     = 0;
+    msg->nof_bits = 0;
+    nof_bits[i]   = srsran_dci_format_sizeof(&q->cell, sf, dci_cfg, msg->format);
+    source[i]     = -1;
+
+    if (i == 0 || !srsran_location_find_location(&msgs[i - 1].location, 1, &msg->location)) {
+      mean = pdcch_llr_mean(q, &msg->location);
+    }
+    if (mean <= 0.3f) {
+      INFO("Skipping DCI:  nCCE=%d, L=%d, msg_len=%d, mean=%f", msg->location.ncce, msg->location.L, nof_bits[i], mean);
+      nof_bits[i] = 0;
+      continue;
+    }
+    for (uint32_t j = 0; j < i && source[i] < 0; j++) {
+      if (source[j] < 0 && nof_bits[j] == nof_bits[i] &&
+          srsran_location_find_location(&msgs[j].location, 1, &msg->location)) {
+        source[i] = j;
+      }
+    }
+  }
+
+  // Decode together the candidates of the same size
+  for (uint32_t i = 0; i < nof_msgs; i++) {
+    if (nof_bits[i] == 0 || source[i] >= 0 || msgs[i].nof_bits > 0) {
+      continue;
+    }
+    uint32_t nof_batch = 0;
+    for (uint32_t j = i; j < nof_msgs && nof_batch < SRSRAN_VITERBI_MAX_STREAMS; j++) {
+      if (nof_bits[j] == nof_bits[i] && source[j] < 0 && msgs[j].nof_bits == 0) {
+        symbols[nof_batch] = &q->rm_f_multi[nof_batch * 3 * (SRSRAN_DCI_MAX_BITS + 16)];
+        data[nof_batch]    = msgs[j].payload;
+        srsran_rm_conv_rx(&q->llr[msgs[j].location.ncce * 72],
+                          PDCCH_FORMAT_NOF_BITS(msgs[j].location.L),
+                          symbols[nof_batch],
+                          3 * (nof_bits[i] + 16));
+        // Marks the candidate as decoded
+        msgs[j].nof_bits   = nof_bits[i];
+        batch[nof_batch++] = j;
+      }
+    }
+
+    if (srsran_viterbi_decode_f_multi(&q->decoder, symbols, data, nof_batch, nof_bits[i] + 16) < SRSRAN_SUCCESS) {
+      ERROR("Error decoding DCI candidates");
+      return SRSRAN_ERROR;
+    }
+
+    // Check CRC. The remainder is the RNTI the candidate was scrambled with
+    for (uint32_t b = 0; b < nof_batch; b++) {
+      srsran_dci_msg_t* msg     = &msgs[batch[b]];
+      uint8_t*          x       = &msg->payload[msg->nof_bits];
+      uint16_t          p_bits  = (uint16_t)srsran_bit_pack(&x, 16);
+      uint16_t          crc_res = ((uint16_t)srsran_crc_checksum(&q->crc, msg->payload, msg->nof_bits) & 0xffff);
+      msg->rnti                 = p_bits ^ crc_res;
+    }
+  }
+
+  for (uint32_t i = 0; i < nof_msgs; i++) {
+    srsran_dci_msg_t* msg = &msgs[i];
+    if (nof_bits[i] == 0) {
+      continue;
+    }
+    if (source[i] >= 0) {
+      memcpy(msg->payload, msgs[source[i]].payload, nof_bits[i] + 16);
+      msg->nof_bits = nof_bits[i];
+      msg->rnti     = msgs[source[i]].rnti;
+    }
+    // Check format differentiation
+    if (msg->format == SRSRAN_DCI_FORMAT0 || msg->format == SRSRAN_DCI_FORMAT1A) {
+      msg->format = (msg->payload[dci_cfg->cif_enabled ? 3 : 0] == 0) ? SRSRAN_DCI_FORMAT0 : SRSRAN_DCI_FORMAT1A;
+    }
+    INFO("Decoded DCI: nCCE=%d, L=%d, format=%s, msg_len=%d, crc_rem=0x%x",
+         msg->location.ncce,
+         msg->location.L,
+         srsran_dci_format_string(msg->format),
+         msg->nof_bits,
+         msg->rnti);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 float srsran_pdcch_msg_corr(srsran_pdcch_t* q, srsran_dci_msg_t* msg)
 {
   if (q == NULL || msg == NULL) {
@@ -446,6 +446,12 @@ int srsran_pusch_decode(srsran_pusch_t*        q,
     srsran_sequence_pusch_gen_unpack(
         c, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
 
+    if (cfg->meas_time_en) {
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      cfg->meas_time_demod_value = t[0].tv_usec;
+    }
+
     // Set max number of iterations
     srsran_sch_set_max_noi(&q->ul_sch, cfg->max_nof_iterations);
 
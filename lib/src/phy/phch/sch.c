@@ -24,7 +24,10 @@
 #include "srsran/phy/utils/vector.h"
 #include "srsran/srsran.h"
 #include <assert.h>
+#include <errno.h>
 #include <math.h>
+#include <pthread.h>
+#include <semaphore.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -39,6 +42,46 @@
 #include <immintrin.h>
 #endif /* LV_HAVE_SSE */
 
+/* Code block decoding job, shared by the calling thread and all its coworkers */
+typedef struct {
+  srsran_sch_t*           q;
+  srsran_softbuffer_rx_t* softbuffer;
+  srsran_cbsegm_t*        cb_segm;
+  uint32_t                Qm;
+  uint32_t                rv;
+  uint32_t                nof_e_bits;
+  void*                   e_bits;
+  uint8_t*                data;
+} sch_cb_job_t;
+
+typedef struct {
+  /* Thread identifier: they must set before thread creation */
+  pthread_t pthread;
+  uint32_t  worker_idx;
+
+  /* Decoder context owned by the coworker */
+  srsran_tdec_t decoder;
+  srsran_crc_t  crc_cb;
+  uint8_t*      cb_out;
+
+  /* Job: it must be set before posting start semaphore */
+  const sch_cb_job_t* job;
+
+  /* Execution status */
+  uint32_t nof_iterations;
+  int      ret_status;
+
+  /* Semaphores */
+  sem_t start;
+  sem_t finish;
+
+  /* Thread flags */
+  bool started;
+  bool quit;
+} sch_cb_coworker_t;
+
+static void* sch_cb_coworker_thread(void* arg);
+
 /* 36.213 Table 8.6.3-1: Mapping of HARQ-ACK offset values and the index signalled by higher layers */
 static inline float get_beta_harq_offset(uint32_t idx)
 {
@@ -200,6 +243,8 @@ clean:
 
 void srsran_sch_free(srsran_sch_t* q)
 {
+  srsran_sch_disable_cb_coworkers(q);
+
   srsran_rm_turbo_free_tables();
 
   if (q->cb_in) {
@@ -220,6 +265,86 @@ void srsran_sch_free(srsran_sch_t* q)
   bzero(q, sizeof(srsran_sch_t));
 }
 
+void srsran_sch_disable_cb_coworkers(srsran_sch_t* q)
+{
+  sch_cb_coworker_t* coworkers = (sch_cb_coworker_t*)q->cb_coworkers;
+  if (coworkers) {
+    for (uint32_t i = 0; i < q->nof_cb_coworkers; i++) {
+      sch_cb_coworker_t* h = &coworkers[i];
+      if (h->started) {
+        /* Stop threads */
+        h->quit = true;
+        sem_post(&h->start);
+        pthread_join(h->pthread, NULL);
+      }
+      sem_destroy(&h->start);
+      sem_destroy(&h->finish);
+      srsran_tdec_free(&h->decoder);
+      if (h->cb_out) {
+        free(h->cb_out);
+      }
+    }
+    free(coworkers);
+  }
+  q->cb_coworkers     = NULL;
+  q->nof_cb_coworkers = 0;
+}
+
+int srsran_sch_enable_cb_coworkers(srsran_sch_t* q, uint32_t nof_coworkers)
+{
+  if (q == NULL || nof_coworkers > SRSRAN_SCH_MAX_CB_COWORKERS) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  srsran_sch_disable_cb_coworkers(q);
+  if (nof_coworkers == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  sch_cb_coworker_t* coworkers = calloc(nof_coworkers, sizeof(sch_cb_coworker_t));
+  if (!coworkers) {
+    ERROR("Allocating SCH CB coworkers");
+    return SRSRAN_ERROR;
+  }
+  q->cb_coworkers = coworkers;
+
+  for (uint32_t i = 0; i < nof_coworkers; i++) {
+    sch_cb_coworker_t* h = &coworkers[i];
+    h->worker_idx        = i;
+
+    // Count the coworker from now on, so that it is released in case of error
+    q->nof_cb_coworkers = i + 1;
+
+    if (sem_init(&h->start, 0, 0) || sem_init(&h->finish, 0, 0)) {
+      ERROR("Creating semaphore");
+      goto clean;
+    }
+    if (srsran_tdec_init(&h->decoder, SRSRAN_TCOD_MAX_LEN_CB)) {
+      ERROR("Error initiating Turbo Decoder");
+      goto clean;
+    }
+    if (srsran_crc_init(&h->crc_cb, SRSRAN_LTE_CRC24B, 24)) {
+      ERROR("Error initiating CRC");
+      goto clean;
+    }
+    h->cb_out = srsran_vec_u8_malloc((SRSRAN_TCOD_MAX_LEN_CB + 8) / 8);
+    if (!h->cb_out) {
+      goto clean;
+    }
+    if (pthread_create(&h->pthread, NULL, sch_cb_coworker_thread, (void*)h)) {
+      ERROR("Creating SCH CB coworker thread");
+      goto clean;
+    }
+    h->started = true;
+  }
+
+  return SRSRAN_SUCCESS;
+
+clean:
+  srsran_sch_disable_cb_coworkers(q);
+  return SRSRAN_ERROR;
+}
+
 void srsran_sch_set_max_noi(srsran_sch_t* q, uint32_t max_iterations)
 {
   if (max_iterations == 0) {
@@ -368,111 +493,220 @@ static int encode_tb(srsran_sch_t*           q,
   return encode_tb_off(q, soft_buffer, cb_segm, Qm, rv, nof_e_bits, data, e_bits, 0);
 }
 
-bool decode_tb_cb(srsran_sch_t*           q,
-                  srsran_softbuffer_rx_t* softbuffer,
-                  srsran_cbsegm_t*        cb_segm,
-                  uint32_t                Qm,
-                  uint32_t                rv,
-                  uint32_t                nof_e_bits,
-                  void*                   e_bits,
-                  uint8_t*                data)
+/* Rate dematches and decodes a single code block. Returns the number of turbo decoder iterations or a negative
+ * value if an error occurred.
+ *
+ * The turbo decoder output includes the code block CRC, which overlaps the first bytes of the next code block in
+ * data. When cb_out is provided, the code block is decoded there and only its payload is copied into data. This way
+ * different code blocks can be decoded in parallel, as long as each caller provides its own decoder, CB CRC and
+ * cb_out buffer.
+ */
+static int
+decode_cb(const sch_cb_job_t* job, srsran_tdec_t* decoder, srsran_crc_t* crc_cb, uint8_t* cb_out, uint32_t cb_idx)
 {
-  int8_t*  e_bits_b = e_bits;
-  int16_t* e_bits_s = e_bits;
+  srsran_sch_t*           q          = job->q;
+  srsran_softbuffer_rx_t* softbuffer = job->softbuffer;
+  srsran_cbsegm_t*        cb_segm    = job->cb_segm;
+  uint32_t                Qm         = job->Qm;
+  uint8_t*                data       = job->data;
+  int8_t*                 e_bits_b   = job->e_bits;
+  int16_t*                e_bits_s   = job->e_bits;
+
+  uint32_t cb_len     = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+  uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
+
+  uint32_t rlen  = cb_segm->C == 1 ? cb_len : (cb_len - 24);
+  uint32_t Gp    = job->nof_e_bits / Qm;
+  uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
+  uint32_t n_e   = Qm * (Gp / cb_segm->C);
+
+  uint32_t rp   = cb_idx * n_e;
+  uint32_t n_e2 = n_e;
+
+  if (cb_idx > cb_segm->C - gamma) {
+    n_e2 = n_e + Qm;
+    rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
+  }
 
-  if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
-    ERROR("Error SRSRAN_MAX_CODEBLOCKS=%d", SRSRAN_MAX_CODEBLOCKS);
-    return false;
+  if (q->llr_is_8bit) {
+    if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, job->rv)) {
+      ERROR("Error in rate matching");
+      return SRSRAN_ERROR;
+    }
+  } else {
+    if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, job->rv)) {
+      ERROR("Error in rate matching");
+      return SRSRAN_ERROR;
+    }
   }
 
-  q->avg_iterations = 0;
+  srsran_tdec_new_cb(decoder, cb_len);
 
-  for (int cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
-    /* Do not process blocks with CRC Ok */
-    if (softbuffer->cb_crc[cb_idx] == false) {
-      uint32_t cb_len     = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
-      uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
+  uint8_t* output = cb_out ? cb_out : &data[cb_idx * rlen / 8];
 
-      uint32_t rlen  = cb_segm->C == 1 ? cb_len : (cb_len - 24);
-      uint32_t Gp    = nof_e_bits / Qm;
-      uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
-      uint32_t n_e   = Qm * (Gp / cb_segm->C);
+  // Run iterations and use CRC for early stopping
+  bool     early_stop = false;
+  uint32_t cb_noi     = 0;
+  do {
+    if (q->llr_is_8bit) {
+      srsran_tdec_iteration_8bit(decoder, (int8_t*)softbuffer->buffer_f[cb_idx], output);
+    } else {
+      srsran_tdec_iteration(decoder, softbuffer->buffer_f[cb_idx], output);
+    }
+    cb_noi++;
 
-      uint32_t rp   = cb_idx * n_e;
-      uint32_t n_e2 = n_e;
+    uint32_t      len_crc;
+    srsran_crc_t* crc_ptr;
 
-      if (cb_idx > cb_segm->C - gamma) {
-        n_e2 = n_e + Qm;
-        rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
-      }
+    if (cb_segm->C > 1) {
+      len_crc = cb_len;
+      crc_ptr = crc_cb;
+    } else {
+      len_crc = cb_segm->tbs + 24;
+      crc_ptr = &q->crc_tb;
+    }
 
-      if (q->llr_is_8bit) {
-        if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
-          return SRSRAN_ERROR;
-        }
-      } else {
-        if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
-          return SRSRAN_ERROR;
-        }
-      }
+    // CRC is OK and ran the minimum number of iterations
+    if (!srsran_crc_checksum_byte(crc_ptr, output, len_crc) &&
+        (cb_noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS)) {
+      softbuffer->cb_crc[cb_idx] = true;
+      early_stop                 = true;
 
-      srsran_tdec_new_cb(&q->decoder, cb_len);
+      // CRC is error and exceeded maximum iterations for this CB.
+      // Early stop the whole transport block.
+    }
 
-      // Run iterations and use CRC for early stopping
-      bool     early_stop = false;
-      uint32_t cb_noi     = 0;
-      do {
-        if (q->llr_is_8bit) {
-          srsran_tdec_iteration_8bit(&q->decoder, (int8_t*)softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        } else {
-          srsran_tdec_iteration(&q->decoder, softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        }
-        q->avg_iterations++;
-        cb_noi++;
+  } while (cb_noi < q->max_iterations && !early_stop);
 
-        uint32_t      len_crc;
-        srsran_crc_t* crc_ptr;
+  if (cb_out) {
+    memcpy(&data[cb_idx * rlen / 8], cb_out, rlen / 8 * sizeof(uint8_t));
+  }
 
-        if (cb_segm->C > 1) {
-          len_crc = cb_len;
-          crc_ptr = &q->crc_cb;
-        } else {
-          len_crc = cb_segm->tbs + 24;
-          crc_ptr = &q->crc_tb;
-        }
+  INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
+       cb_idx,
+       rp,
+       n_e2,
+       cb_len,
+       early_stop ? "OK" : "KO",
+       rlen,
+       cb_noi,
+       q->max_iterations);
+
+  return (int)cb_noi;
+}
 
-        // CRC is OK and ran the minimum number of iterations
-        if (!srsran_crc_checksum_byte(crc_ptr, &data[cb_idx * rlen / 8], len_crc) &&
-            (cb_noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS)) {
-          softbuffer->cb_crc[cb_idx] = true;
-          early_stop                 = true;
+/* Decodes every code block assigned to the worker worker_idx out of nof_workers (round-robin on the CB index).
+ * Returns the accumulated number of iterations or a negative value if an error occurred.
+ */
+static int decode_cb_range(const sch_cb_job_t* job,
+                           srsran_tdec_t*      decoder,
+                           srsran_crc_t*       crc_cb,
+                           uint8_t*            cb_out,
+                           uint32_t            worker_idx,
+                           uint32_t            nof_workers)
+{
+  int nof_iterations = 0;
+  for (uint32_t cb_idx = worker_idx; cb_idx < job->cb_segm->C; cb_idx += nof_workers) {
+    /* Do not process blocks with CRC Ok */
+    if (job->softbuffer->cb_crc[cb_idx]) {
+      continue;
+    }
+    int n = decode_cb(job, decoder, crc_cb, cb_out, cb_idx);
+    if (n < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    nof_iterations += n;
+  }
+  return nof_iterations;
+}
 
-          // CRC is error and exceeded maximum iterations for this CB.
-          // Early stop the whole transport block.
-        }
+static void* sch_cb_coworker_thread(void* arg)
+{
+  sch_cb_coworker_t* h = (sch_cb_coworker_t*)arg;
 
-      } while (cb_noi < q->max_iterations && !early_stop);
+  sem_wait(&h->start);
+  while (!h->quit) {
+    const sch_cb_job_t* job = h->job;
 
-      INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
-           cb_idx,
-           rp,
-           n_e2,
-           cb_len,
-           early_stop ? "OK" : "KO",
-           rlen,
-           cb_noi,
-           q->max_iterations);
+    int ret =
+        decode_cb_range(job, &h->decoder, &h->crc_cb, h->cb_out, h->worker_idx + 1, job->q->nof_cb_coworkers + 1);
 
-    } else {
-      // Copy decoded data from previous transmissions
+    h->ret_status     = ret < SRSRAN_SUCCESS ? SRSRAN_ERROR : SRSRAN_SUCCESS;
+    h->nof_iterations = ret < SRSRAN_SUCCESS ? 0 : (uint32_t)ret;
+
+    /* Post finish semaphore */
+    sem_post(&h->finish);
+
+    /* Wait for next loop */
+    sem_wait(&h->start);
+  }
+  sem_post(&h->finish);
+
+  pthread_exit(NULL);
+  return h;
+}
+
+bool decode_tb_cb(srsran_sch_t*           q,
+                  srsran_softbuffer_rx_t* softbuffer,
+                  srsran_cbsegm_t*        cb_segm,
+                  uint32_t                Qm,
+                  uint32_t                rv,
+                  uint32_t                nof_e_bits,
+                  void*                   e_bits,
+                  uint8_t*                data)
+{
+  if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
+    ERROR("Error SRSRAN_MAX_CODEBLOCKS=%d", SRSRAN_MAX_CODEBLOCKS);
+    return false;
+  }
+
+  q->avg_iterations = 0;
+
+  // Copy decoded data from previous transmissions
+  for (uint32_t cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
+    if (softbuffer->cb_crc[cb_idx]) {
       uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
       uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
       memcpy(&data[cb_idx * rlen / 8], softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
     }
   }
 
+  sch_cb_job_t job = {q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, data};
+
+  // Split the code blocks between this thread and the coworkers, if there is more than one code block
+  uint32_t           nof_coworkers = (cb_segm->C > 1) ? SRSRAN_MIN(q->nof_cb_coworkers, cb_segm->C - 1) : 0;
+  sch_cb_coworker_t* coworkers     = (sch_cb_coworker_t*)q->cb_coworkers;
+  for (uint32_t i = 0; i < nof_coworkers; i++) {
+    coworkers[i].job = &job;
+    sem_post(&coworkers[i].start);
+  }
+
+  // With coworkers, decode in a separate buffer to avoid overwriting the next code block. The encoder input buffer
+  // cb_in is not used while decoding.
+  uint8_t* cb_out         = nof_coworkers ? q->cb_in : NULL;
+  bool     ret            = true;
+  int      nof_iterations = decode_cb_range(&job, &q->decoder, &q->crc_cb, cb_out, 0, q->nof_cb_coworkers + 1);
+  if (nof_iterations < SRSRAN_SUCCESS) {
+    ret = false;
+  } else {
+    q->avg_iterations += nof_iterations;
+  }
+
+  // Wait for the coworkers and merge their results
+  for (uint32_t i = 0; i < nof_coworkers; i++) {
+    if (sem_wait(&coworkers[i].finish)) {
+      ERROR("SCH CB coworker: %s", strerror(errno));
+    }
+    if (coworkers[i].ret_status) {
+      ret = false;
+    }
+    q->avg_iterations += coworkers[i].nof_iterations;
+  }
+
+  if (!ret) {
+    return false;
+  }
+
   softbuffer->tb_crc = true;
   for (int i = 0; i < cb_segm->C && softbuffer->tb_crc; i++) {
     /* If one CB failed return false */
@@ -280,6 +280,40 @@ int srsran_sch_nr_init_tx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
   return SRSRAN_SUCCESS;
 }
 
+static void sch_nr_put_decoders(srsran_sch_nr_t* q)
+{
+  for (uint16_t ls = 0; ls <= MAX_LIFTSIZE; ls++) {
+    if (q->decoder_bg1[ls]) {
+      srsran_ldpc_decoder_cache_put(q->decoder_bg1[ls]);
+      q->decoder_bg1[ls] = NULL;
+    }
+    if (q->decoder_bg2[ls]) {
+      srsran_ldpc_decoder_cache_put(q->decoder_bg2[ls]);
+      q->decoder_bg2[ls] = NULL;
+    }
+  }
+}
+
+static srsran_ldpc_decoder_cache_entry_t* sch_nr_get_decoder(srsran_sch_nr_t* q, srsran_basegraph_t bg, uint32_t Z)
+{
+  // Invalid lifting size
+  if (Z > MAX_LIFTSIZE || get_ls_index(Z) == VOID_LIFTSIZE) {
+    return NULL;
+  }
+
+  srsran_ldpc_decoder_cache_entry_t** entry = (bg == BG1) ? &q->decoder_bg1[Z] : &q->decoder_bg2[Z];
+
+  // Take a reference on the shared decoders the first time the base graph and lifting size are used
+  if (*entry == NULL) {
+    srsran_ldpc_decoder_args_t decoder_args = q->decoder_args;
+    decoder_args.bg                         = bg;
+    decoder_args.ls                         = Z;
+    *entry                                  = srsran_ldpc_decoder_cache_get(&decoder_args);
+  }
+
+  return *entry;
+}
+
 int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
 {
   int ret = sch_nr_init_common(q);
@@ -306,50 +340,13 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
   // and MCS indexes for all possible MCS tables
   float scaling_factor = isnormal(args->decoder_scaling_factor) ? args->decoder_scaling_factor : 0.8f;
 
-  // Iterate over all possible lifting sizes
-  for (uint16_t ls = 0; ls <= MAX_LIFTSIZE; ls++) {
-    uint8_t ls_index = get_ls_index(ls);
+  // Drop the decoders of a previous initialisation, if any
+  sch_nr_put_decoders(q);
 
-    // Invalid lifting size
-    if (ls_index == VOID_LIFTSIZE) {
-      q->decoder_bg1[ls] = NULL;
-      q->decoder_bg2[ls] = NULL;
-      continue;
-    }
-
-    // Initialise LDPC configuration arguments
-    srsran_ldpc_decoder_args_t decoder_args = {};
-    decoder_args.type                       = decoder_type;
-    decoder_args.ls                         = ls;
-    decoder_args.scaling_fctr               = scaling_factor;
-    decoder_args.max_nof_iter               = args->max_nof_iter;
-
-    q->decoder_bg1[ls] = SRSRAN_MEM_ALLOC(srsran_ldpc_decoder_t, 1);
-    if (!q->decoder_bg1[ls]) {
-      ERROR("Error: calloc");
-      return SRSRAN_ERROR;
-    }
-    SRSRAN_MEM_ZERO(q->decoder_bg1[ls], srsran_ldpc_decoder_t, 1);
-
-    decoder_args.bg = BG1;
-    if (srsran_ldpc_decoder_init(q->decoder_bg1[ls], &decoder_args) < SRSRAN_SUCCESS) {
-      ERROR("Error: initialising BG1 LDPC decoder for ls=%d", ls);
-      return SRSRAN_ERROR;
-    }
-
-    q->decoder_bg2[ls] = SRSRAN_MEM_ALLOC(srsran_ldpc_decoder_t, 1);
-    if (!q->decoder_bg2[ls]) {
-      ERROR("Error: calloc");
-      return SRSRAN_ERROR;
-    }
-    SRSRAN_MEM_ZERO(q->decoder_bg2[ls], srsran_ldpc_decoder_t, 1);
-
-    decoder_args.bg = BG2;
-    if (srsran_ldpc_decoder_init(q->decoder_bg2[ls], &decoder_args) < SRSRAN_SUCCESS) {
-      ERROR("Error: initialising BG2 LDPC decoder for ls=%d", ls);
-      return SRSRAN_ERROR;
-    }
-  }
+  // Decoders are taken from the shared cache on demand, only the arguments are kept
+  q->decoder_args.type         = decoder_type;
+  q->decoder_args.scaling_fctr = scaling_factor;
+  q->decoder_args.max_nof_iter = args->max_nof_iter;
 
   if (srsran_ldpc_rm_rx_init_c(&q->rx_rm) < SRSRAN_SUCCESS) {
     ERROR("Error: initialising Rx LDPC Rate matching");
@@ -390,16 +387,10 @@ void srsran_sch_nr_free(srsran_sch_nr_t* q)
       srsran_ldpc_encoder_free(q->encoder_bg2[ls]);
       free(q->encoder_bg2[ls]);
     }
-    if (q->decoder_bg1[ls]) {
-      srsran_ldpc_decoder_free(q->decoder_bg1[ls]);
-      free(q->decoder_bg1[ls]);
-    }
-    if (q->decoder_bg2[ls]) {
-      srsran_ldpc_decoder_free(q->decoder_bg2[ls]);
-      free(q->decoder_bg2[ls]);
-    }
   }
 
+  sch_nr_put_decoders(q);
+
   srsran_ldpc_rm_tx_free(&q->tx_rm);
   srsran_ldpc_rm_rx_free_c(&q->rx_rm);
 }
@@ -551,46 +542,16 @@ static inline int sch_nr_encode(srsran_sch_nr_t*        q,
   return SRSRAN_SUCCESS;
 }
 
-static int sch_nr_decode(srsran_sch_nr_t*        q,
-                         const srsran_sch_cfg_t* sch_cfg,
-                         const srsran_sch_tb_t*  tb,
-                         int8_t*                 e_bits,
-                         srsran_sch_tb_res_nr_t* res)
+static int sch_nr_decode_cbs(srsran_sch_nr_t*               q,
+                             const srsran_sch_tb_t*         tb,
+                             const srsran_sch_nr_tb_info_t* cfg,
+                             srsran_ldpc_decoder_t*         decoder,
+                             int8_t*                        e_bits,
+                             srsran_sch_tb_res_nr_t*        res)
 {
-  // Pointer protection
-  if (!q || !sch_cfg || !tb || !e_bits || !res) {
-    return SRSRAN_ERROR_INVALID_INPUTS;
-  }
-
-  // Protect softbuffer access
-  if (!tb->softbuffer.rx) {
-    ERROR("Missing softbuffer!");
-    return SRSRAN_ERROR;
-  }
-
-  // Protect PDU access
-  if (!res->payload) {
-    ERROR("Missing payload pointer!");
-    return SRSRAN_ERROR;
-  }
-
-  int8_t*  input_ptr    = e_bits;
-  uint32_t nof_iter_sum = 0;
-
-  srsran_sch_nr_tb_info_t cfg = {};
-  if (srsran_sch_nr_fill_tb_info(&q->carrier, sch_cfg, tb, &cfg) < SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
-  }
-
-  // Select encoder and CRC
-  srsran_ldpc_decoder_t* decoder = (cfg.bg == BG1) ? q->decoder_bg1[cfg.Z] : q->decoder_bg2[cfg.Z];
-  srsran_crc_t*          crc_tb  = (cfg.L_tb == 24) ? &q->crc_tb_24 : &q->crc_tb_16;
-
-  // Check decoder
-  if (decoder == NULL) {
-    ERROR("Error: decoder for lifting size Z=%d not found", cfg.Z);
-    return SRSRAN_ERROR;
-  }
+  int8_t*       input_ptr    = e_bits;
+  uint32_t      nof_iter_sum = 0;
+  srsran_crc_t* crc_tb       = (cfg->L_tb == 24) ? &q->crc_tb_24 : &q->crc_tb_16;
 
   // Check CRC for TB
   if (crc_tb == NULL) {
@@ -599,7 +560,7 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
   }
 
   // Soft-buffer number of code-block protection
-  if (tb->softbuffer.rx->max_cb < cfg.Cp || tb->softbuffer.rx->max_cb_size < (decoder->liftN - 2 * cfg.Z)) {
+  if (tb->softbuffer.rx->max_cb < cfg->Cp || tb->softbuffer.rx->max_cb_size < (decoder->liftN - 2 * cfg->Z)) {
     return SRSRAN_ERROR;
   }
 
@@ -608,7 +569,7 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
 
   // For each code block...
   uint32_t j = 0;
-  for (uint32_t r = 0; r < cfg.C; r++) {
+  for (uint32_t r = 0; r < cfg->C; r++) {
     bool    decoded   = tb->softbuffer.rx->cb_crc[r];
     int8_t* rm_buffer = (int8_t*)tb->softbuffer.tx->buffer_b[r];
     if (!rm_buffer) {
@@ -617,7 +578,7 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     }
 
     // Skip CB if mask indicates no transmission of the CB
-    if (!cfg.mask[r]) {
+    if (!cfg->mask[r]) {
       if (decoded) {
         cb_ok++;
       }
@@ -626,7 +587,7 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     }
 
     // Select rate matching output sequence number of bits
-    uint32_t E = sch_nr_get_E(&cfg, j);
+    uint32_t E = sch_nr_get_E(cfg, j);
     j++;
 
     // Skip CB if it has a matched CRC
@@ -640,22 +601,22 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     SCH_INFO_RX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
                 r,
                 E,
-                cfg.F,
-                cfg.bg == BG1 ? 1 : 2,
-                cfg.Z,
+                cfg->F,
+                cfg->bg == BG1 ? 1 : 2,
+                cfg->Z,
                 tb->rv,
-                cfg.Qm,
-                cfg.Nref);
+                cfg->Qm,
+                cfg->Nref);
     int n_llr =
-        srsran_ldpc_rm_rx_c(&q->rx_rm, input_ptr, rm_buffer, E, cfg.F, cfg.bg, cfg.Z, tb->rv, tb->mod, cfg.Nref);
+        srsran_ldpc_rm_rx_c(&q->rx_rm, input_ptr, rm_buffer, E, cfg->F, cfg->bg, cfg->Z, tb->rv, tb->mod, cfg->Nref);
     if (n_llr < SRSRAN_SUCCESS) {
       ERROR("Error in LDPC rate mateching");
       return SRSRAN_ERROR;
     }
 
     // Select CB or TB early stop CRC
-    srsran_crc_t* crc = (cfg.L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
-    if (cfg.L_cb) {
+    srsran_crc_t* crc = (cfg->L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
+    if (cfg->L_cb) {
       crc = &q->crc_cb;
     }
 
@@ -671,14 +632,14 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     nof_iter_sum += n_iter_cb;
 
     // Check if CB is all zeros
-    uint32_t cb_len = cfg.Kp - cfg.L_cb;
+    uint32_t cb_len = cfg->Kp - cfg->L_cb;
 
     tb->softbuffer.rx->cb_crc[r] = (ret != 0);
-    SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg.C, n_iter_cb, tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
+    SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg->C, n_iter_cb, tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
 
     // CB Debug trace
     if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-      DEBUG("CB %d/%d:", r, cfg.C);
+      DEBUG("CB %d/%d:", r, cfg->C);
       srsran_vec_fprint_hex(stdout, q->temp_cb, cb_len);
     }
 
@@ -691,29 +652,29 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     input_ptr += E;
   }
   // Set average number of iterations
-  res->avg_iter = (float)nof_iter_sum / (float)cfg.C;
+  res->avg_iter = (float)nof_iter_sum / (float)cfg->C;
 
   // Set average number of iterations
-  if (cfg.C > 0) {
-    res->avg_iter = (float)nof_iter_sum / (float)cfg.C;
+  if (cfg->C > 0) {
+    res->avg_iter = (float)nof_iter_sum / (float)cfg->C;
   } else {
     res->avg_iter = NAN;
   }
 
   // Not all CB are decoded, skip TB union and CRC check
-  if (cb_ok != cfg.C) {
+  if (cb_ok != cfg->C) {
     return SRSRAN_SUCCESS;
   }
 
   uint32_t checksum2  = 0;
   uint8_t* output_ptr = res->payload;
 
-  for (uint32_t r = 0; r < cfg.C; r++) {
-    uint32_t cb_len = cfg.Kp - cfg.L_cb;
+  for (uint32_t r = 0; r < cfg->C; r++) {
+    uint32_t cb_len = cfg->Kp - cfg->L_cb;
 
     // Subtract TB CRC from the last code block
-    if (r == cfg.C - 1) {
-      cb_len -= cfg.L_tb;
+    if (r == cfg->C - 1) {
+      cb_len -= cfg->L_tb;
     }
 
     // Append CB
@@ -721,16 +682,16 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     output_ptr += cb_len / 8;
 
     // Compute TB CRC for last block
-    if (cfg.C > 1 && r == cfg.C - 1) {
+    if (cfg->C > 1 && r == cfg->C - 1) {
       uint8_t  tb_crc_unpacked[24] = {};
       uint8_t* tb_crc_unpacked_ptr = tb_crc_unpacked;
-      srsran_bit_unpack_vector(&tb->softbuffer.rx->data[r][cb_len / 8], tb_crc_unpacked, cfg.L_tb);
-      checksum2 = srsran_bit_pack(&tb_crc_unpacked_ptr, cfg.L_tb);
+      srsran_bit_unpack_vector(&tb->softbuffer.rx->data[r][cb_len / 8], tb_crc_unpacked, cfg->L_tb);
+      checksum2 = srsran_bit_pack(&tb_crc_unpacked_ptr, cfg->L_tb);
     }
   }
 
   // Calculate TB CRC from packed data
-  if (cfg.C == 1) {
+  if (cfg->C == 1) {
     SCH_INFO_RX("TB: TBS=%d; CRC=%s", tb->tbs, tb->softbuffer.rx->cb_crc[0] ? "OK" : "KO");
     res->crc = true;
   } else {
@@ -748,6 +709,54 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
   return SRSRAN_SUCCESS;
 }
 
+static int sch_nr_decode(srsran_sch_nr_t*        q,
+                         const srsran_sch_cfg_t* sch_cfg,
+                         const srsran_sch_tb_t*  tb,
+                         int8_t*                 e_bits,
+                         srsran_sch_tb_res_nr_t* res)
+{
+  // Pointer protection
+  if (!q || !sch_cfg || !tb || !e_bits || !res) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Protect softbuffer access
+  if (!tb->softbuffer.rx) {
+    ERROR("Missing softbuffer!");
+    return SRSRAN_ERROR;
+  }
+
+  // Protect PDU access
+  if (!res->payload) {
+    ERROR("Missing payload pointer!");
+    return SRSRAN_ERROR;
+  }
+
+  srsran_sch_nr_tb_info_t cfg = {};
+  if (srsran_sch_nr_fill_tb_info(&q->carrier, sch_cfg, tb, &cfg) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // Select decoder
+  srsran_ldpc_decoder_cache_entry_t* decoder_entry = sch_nr_get_decoder(q, cfg.bg, cfg.Z);
+  if (decoder_entry == NULL) {
+    ERROR("Error: decoder for lifting size Z=%d not found", cfg.Z);
+    return SRSRAN_ERROR;
+  }
+
+  // Borrow a decoder instance for the whole transport block
+  srsran_ldpc_decoder_t* decoder = srsran_ldpc_decoder_cache_acquire(decoder_entry);
+  if (decoder == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  int ret = sch_nr_decode_cbs(q, tb, &cfg, decoder, e_bits, res);
+
+  srsran_ldpc_decoder_cache_release(decoder_entry, decoder);
+
+  return ret;
+}
+
 int srsran_dlsch_nr_encode(srsran_sch_nr_t*        q,
                            const srsran_sch_cfg_t* pdsch_cfg,
                            const srsran_sch_tb_t*  tb,
@@ -347,6 +347,131 @@ static int test_case1()
   return SRSRAN_SUCCESS;
 }
 
+static bool dci_is_detected(srsran_pdcch_t* q, const srsran_dci_msg_t* dci_tx, srsran_dci_msg_t* dci_rx)
+{
+  return dci_rx->rnti == dci_tx->rnti && dci_rx->nof_bits == dci_tx->nof_bits &&
+         srsran_location_find_location(&dci_tx->location, 1, &dci_rx->location) &&
+         memcmp(dci_tx->payload, dci_rx->payload, dci_tx->nof_bits) == 0 && srsran_pdcch_msg_corr(q, dci_rx) > 0.5f;
+}
+
+// Blind search of a UE in a control region full of DCIs for other UEs, decoding the candidates one by one and all at
+// once. Both must find the DCI of the UE
+static int test_case2()
+{
+  static const srsran_dci_format_t search_formats[] = {SRSRAN_DCI_FORMAT1A, SRSRAN_DCI_FORMAT1};
+  static const uint32_t            nof_search_formats = 2;
+
+  uint32_t       nof_re           = SRSRAN_NOF_RE(pdcch_tx.cell);
+  struct timeval t[3]             = {};
+  uint64_t       t_single_us      = 0;
+  uint64_t       t_multi_us       = 0;
+  uint64_t       candidates_count = 0;
+  uint64_t       dropped_count    = 0;
+
+  srsran_dci_msg_t candidates[SRSRAN_MAX_CANDIDATES * 2] = {};
+
+  for (uint32_t sf_idx = 0; sf_idx < repetitions * SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    srsran_dl_sf_cfg_t dl_sf_cfg = {};
+    dl_sf_cfg.cfi                = cfi;
+    dl_sf_cfg.tti                = sf_idx % 10240;
+
+    // Generate PDCCH locations
+    srsran_dci_location_t locations[SRSRAN_MAX_CANDIDATES] = {};
+
+    uint32_t nof_common = srsran_pdcch_common_locations(&pdcch_tx, locations, SRSRAN_MAX_CANDIDATES_COM, cfi);
+    uint32_t nof_ue =
+        srsran_pdcch_ue_locations(&pdcch_tx, &dl_sf_cfg, &locations[nof_common], SRSRAN_MAX_CANDIDATES_UE, rnti);
+    if (nof_ue == 0) {
+      continue;
+    }
+
+    for (uint32_t p = 0; p < nof_ports; p++) {
+      srsran_vec_cf_zero(slot_symbols[p], nof_re);
+    }
+
+    // Fill every CCE with a DCI for another UE
+    for (uint32_t ncce = 0; ncce < pdcch_tx.nof_cce[cfi - 1]; ncce++) {
+      srsran_dci_msg_t dci_other = {};
+      dci_other.location.L       = 0;
+      dci_other.location.ncce    = ncce;
+      dci_other.format           = SRSRAN_DCI_FORMAT1A;
+      dci_other.nof_bits         = srsran_dci_format_sizeof(&pdcch_tx.cell, &dl_sf_cfg, &dci_cfg, dci_other.format);
+      dci_other.rnti             = rnti + 1 + ncce;
+      srsran_random_bit_vector(random_gen, dci_other.payload, dci_other.nof_bits);
+      TESTASSERT(srsran_pdcch_encode(&pdcch_tx, &dl_sf_cfg, &dci_other, slot_symbols) == SRSRAN_SUCCESS);
+    }
+
+    // DCI for the UE in one of its UE-specific locations
+    srsran_dci_msg_t dci_tx = {};
+    dci_tx.location         = locations[nof_common + sf_idx % nof_ue];
+    dci_tx.format           = search_formats[sf_idx % nof_search_formats];
+    dci_tx.nof_bits         = srsran_dci_format_sizeof(&pdcch_tx.cell, &dl_sf_cfg, &dci_cfg, dci_tx.format);
+    dci_tx.rnti             = rnti;
+    srsran_random_bit_vector(random_gen, dci_tx.payload, dci_tx.nof_bits);
+    TESTASSERT(srsran_pdcch_encode(&pdcch_tx, &dl_sf_cfg, &dci_tx, slot_symbols) == SRSRAN_SUCCESS);
+
+    float n0_dB = -get_snr_dB(dci_tx.location.L);
+    TESTASSERT(srsran_channel_awgn_set_n0(&awgn, n0_dB) == SRSRAN_SUCCESS);
+    chest_dl_res.noise_estimate = srsran_convert_dB_to_power(n0_dB);
+    for (uint32_t p = 0; p < nof_ports; p++) {
+      srsran_channel_awgn_run_c(&awgn, slot_symbols[p], slot_symbols[p], nof_re);
+    }
+    TESTASSERT(srsran_pdcch_extract_llr(&pdcch_rx, &dl_sf_cfg, &chest_dl_res, slot_symbols) == SRSRAN_SUCCESS);
+
+    uint32_t nof_candidates = 0;
+    for (uint32_t loc = 0; loc < nof_common + nof_ue; loc++) {
+      for (uint32_t f = 0; f < nof_search_formats; f++) {
+        candidates[nof_candidates].location = locations[loc];
+        candidates[nof_candidates].format   = search_formats[f];
+        nof_candidates++;
+      }
+    }
+
+    // Decode the candidates one by one
+    bool found_single = false;
+    gettimeofday(&t[1], NULL);
+    for (uint32_t i = 0; i < nof_candidates; i++) {
+      srsran_dci_msg_t dci_rx = {};
+      dci_rx.location         = candidates[i].location;
+      dci_rx.format           = candidates[i].format;
+      TESTASSERT(srsran_pdcch_decode_msg(&pdcch_rx, &dl_sf_cfg, &dci_cfg, &dci_rx) == SRSRAN_SUCCESS);
+      found_single |= dci_is_detected(&pdcch_rx, &dci_tx, &dci_rx);
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    t_single_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+
+    // Decode all the candidates at once
+    bool found_multi = false;
+    gettimeofday(&t[1], NULL);
+    TESTASSERT(srsran_pdcch_decode_msg_multi(&pdcch_rx, &dl_sf_cfg, &dci_cfg, candidates, nof_candidates) ==
+               SRSRAN_SUCCESS);
+    for (uint32_t i = 0; i < nof_candidates; i++) {
+      found_multi |= dci_is_detected(&pdcch_rx, &dci_tx, &candidates[i]);
+      dropped_count += (candidates[i].nof_bits == 0);
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    t_multi_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+
+    TESTASSERT(found_single);
+    TESTASSERT(found_multi);
+    candidates_count += nof_candidates;
+  }
+
+  if (!t_single_us || !t_multi_us) {
+    ERROR("Error in test case 2: undefined division");
+    return SRSRAN_ERROR;
+  }
+
+  printf("test_case_2 - passed - %.0f candidates/s one by one; %.0f candidates/s at once; %.1f%% dropped;\n",
+         (double)candidates_count * 1e6 / (double)t_single_us,
+         (double)candidates_count * 1e6 / (double)t_multi_us,
+         100.0 * (double)dropped_count / (double)candidates_count);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   srsran_regs_t regs = {};
@@ -416,6 +541,11 @@ int main(int argc, char** argv)
     goto quit;
   }
 
+  if (test_case2() < SRSRAN_SUCCESS) {
+    ERROR("Test case 2 failed");
+    goto quit;
+  }
+
   ret = SRSRAN_SUCCESS;
 
 quit:
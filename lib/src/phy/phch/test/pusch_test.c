@@ -56,6 +56,7 @@ int          freq_hop      = -1;
 int          riv           = -1;
 uint32_t     mcs_idx       = 0;
 bool         enable_64_qam = false;
+uint32_t     nof_coworkers = 0;
 
 void usage(char* prog)
 {
@@ -84,6 +85,7 @@ void usage(char* prog)
   printf("\n\tOther parameters:\n");
   printf("\t\t-p enable_64qam [Default %s]\n", enable_64_qam ? "enabled" : "disabled");
   printf("\t\t-s number of subframes [Default %d]\n", subframe);
+  printf("\t\t-w number of code block decoding coworkers [Default %d]\n", nof_coworkers);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
@@ -139,7 +141,7 @@ void parse_extensive_param(char* param, char* arg)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "msLFrncpvf")) != -1) {
+  while ((opt = getopt(argc, argv, "msLFrncpvfw")) != -1) {
     switch (opt) {
       case 'm':
         mcs_idx = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -169,6 +171,9 @@ void parse_args(int argc, char** argv)
         parse_extensive_param(argv[optind], argv[optind + 1]);
         optind++;
         break;
+      case 'w':
+        nof_coworkers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -243,6 +248,10 @@ int main(int argc, char** argv)
     ERROR("Error creating PUSCH object");
     goto quit;
   }
+  if (nof_coworkers > 0 && srsran_sch_enable_cb_coworkers(&pusch_rx.ul_sch, nof_coworkers) < SRSRAN_SUCCESS) {
+    ERROR("Error enabling code block coworkers");
+    goto quit;
+  }
 
   uint16_t rnti = 62;
   dci.rnti      = rnti;
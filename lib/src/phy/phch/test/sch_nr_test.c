@@ -234,12 +234,22 @@ int main(int argc, char** argv)
     }
   }
 
+  printf("LDPC decoder cache: %d decoders, %.1f kB\n",
+         srsran_ldpc_decoder_cache_nof_decoders(),
+         srsran_ldpc_decoder_cache_nbytes() / 1024.0);
+
   ret = SRSRAN_SUCCESS;
 
 clean_exit:
   srsran_random_free(rand_gen);
   srsran_sch_nr_free(&sch_nr_tx);
   srsran_sch_nr_free(&sch_nr_rx);
+
+  // Releasing the last SCH object must release all the shared decoders
+  if (srsran_ldpc_decoder_cache_nof_decoders() != 0 || srsran_ldpc_decoder_cache_nbytes() != 0) {
+    ERROR("Error: LDPC decoder cache not empty after releasing all SCH objects");
+    ret = SRSRAN_ERROR;
+  }
   if (data_tx) {
     free(data_tx);
   }
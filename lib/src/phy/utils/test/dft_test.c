@@ -154,6 +154,54 @@ clean_exit:
   return res;
 }
 
+// Two identical plans must share the underlying FFTW plan, and remain usable after the other one is released
+int test_dft_shared(cf_t* in)
+{
+  int res = -1;
+
+  cf_t* out1 = srsran_vec_cf_malloc(N);
+  cf_t* out2 = srsran_vec_cf_malloc(N);
+
+  srsran_dft_plan_stats_t stats_before = {};
+  srsran_dft_plan_stats_t stats_after  = {};
+  srsran_dft_get_plan_stats(&stats_before);
+
+  srsran_dft_plan_t plan1 = {};
+  srsran_dft_plan_t plan2 = {};
+  if (srsran_dft_plan(&plan1, N, SRSRAN_DFT_FORWARD, SRSRAN_DFT_COMPLEX) != SRSRAN_SUCCESS ||
+      srsran_dft_plan(&plan2, N, SRSRAN_DFT_FORWARD, SRSRAN_DFT_COMPLEX) != SRSRAN_SUCCESS) {
+    ERROR("Error in DFT plan");
+    goto clean_exit;
+  }
+  srsran_dft_get_plan_stats(&stats_after);
+
+  if (plan1.p != plan2.p || plan1.in == plan2.in || stats_after.nof_shared != stats_before.nof_shared + 1) {
+    ERROR("DFT plans are not shared");
+    goto clean_exit;
+  }
+
+  srsran_dft_run(&plan1, in, out1);
+  srsran_dft_plan_free(&plan1);
+  srsran_dft_run(&plan2, in, out2);
+
+  for (int i = 0; i < N; i++) {
+    if (cabsf(out1[i] - out2[i]) > 1e-3) {
+      ERROR("Shared DFT plan output mismatch");
+      goto clean_exit;
+    }
+  }
+
+  res = 0;
+
+clean_exit:
+  srsran_dft_plan_free(&plan1);
+  srsran_dft_plan_free(&plan2);
+  free(out1);
+  free(out2);
+
+  return res;
+}
+
 int main(int argc, char** argv)
 {
   srsran_random_t random_gen = srsran_random_init(0x1234);
@@ -165,6 +213,9 @@ int main(int argc, char** argv)
   if (test_dft(in) != 0)
     return -1;
 
+  if (test_dft_shared(in) != 0)
+    return -1;
+
   free(in);
   srsran_random_free(random_gen);
   printf("Done\n");
@@ -376,6 +376,27 @@ TEST(
     free(y);
     free(z);)
 
+TEST(
+    srsran_vec_prod_sc_ccc, MALLOC(cf_t, x); MALLOC(cf_t, y); MALLOC(cf_t, z);
+
+    cf_t gold;
+    cf_t h = RANDOM_CF();
+    for (int i = 0; i < block_size; i++) {
+      x[i] = RANDOM_CF();
+      y[i] = RANDOM_CF();
+    }
+
+    TEST_CALL(srsran_vec_prod_sc_ccc(x, y, h, z, block_size))
+
+        for (int i = 0; i < block_size; i++) {
+          gold = x[i] * y[i] * h;
+          mse += cabsf(gold - z[i]);
+        }
+
+    free(x);
+    free(y);
+    free(z);)
+
 TEST(
     srsran_vec_prod_ccc_split, MALLOC(float, x_re); MALLOC(float, x_im); MALLOC(float, y_re); MALLOC(float, y_im);
     MALLOC(float, z_re);
@@ -943,6 +964,10 @@ int main(int argc, char** argv)
         test_srsran_vec_prod_ccc(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srsran_vec_prod_sc_ccc(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     passed[func_count][size_count] =
         test_srsran_vec_prod_ccc_split(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
@@ -506,6 +506,11 @@ void srsran_vec_prod_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t l
   srsran_vec_prod_ccc_simd(x, y, z, len);
 }
 
+void srsran_vec_prod_sc_ccc(const cf_t* x, const cf_t* y, const cf_t h, cf_t* z, const uint32_t len)
+{
+  srsran_vec_prod_sc_ccc_simd(x, y, h, z, len);
+}
+
 void srsran_vec_prod_ccc_split(const float*   x_re,
                                const float*   x_im,
                                const float*   y_re,
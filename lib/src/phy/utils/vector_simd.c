@@ -933,6 +933,39 @@ void srsran_vec_prod_ccc_simd(const cf_t* x, const cf_t* y, cf_t* z, const int l
   }
 }
 
+void srsran_vec_prod_sc_ccc_simd(const cf_t* x, const cf_t* y, const cf_t h, cf_t* z, const int len)
+{
+  int i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  const simd_cf_t hh = srsran_simd_cf_set1(h);
+
+  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(y) && SRSRAN_IS_ALIGNED(z)) {
+    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t a = srsran_simd_cfi_load(&x[i]);
+      simd_cf_t b = srsran_simd_cfi_load(&y[i]);
+
+      simd_cf_t r = srsran_simd_cf_prod(srsran_simd_cf_prod(a, b), hh);
+
+      srsran_simd_cfi_store(&z[i], r);
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t a = srsran_simd_cfi_loadu(&x[i]);
+      simd_cf_t b = srsran_simd_cfi_loadu(&y[i]);
+
+      simd_cf_t r = srsran_simd_cf_prod(srsran_simd_cf_prod(a, b), hh);
+
+      srsran_simd_cfi_storeu(&z[i], r);
+    }
+  }
+#endif
+
+  for (; i < len; i++) {
+    z[i] = x[i] * y[i] * h;
+  }
+}
+
 void srsran_vec_prod_ccc_split_simd(const float* a_re,
                                     const float* a_im,
                                     const float* b_re,
@@ -0,0 +1,455 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/radio/radio_mux.h"
+#include "srsran/common/common.h"
+#include "srsran/radio/rf_timestamp.h"
+#include "srsran/support/srsran_assert.h"
+#include <cinttypes>
+#include <cmath>
+
+namespace srsran {
+
+/// Length of the received samples ring buffer in milliseconds
+static const uint32_t rx_ring_len_ms = 20;
+
+/// Length of the transmitted samples ring buffer in milliseconds
+static const uint32_t tx_ring_len_ms = 20;
+
+/// Time in advance to the last received sample at which the transmitted samples are handed to the radio
+static const uint32_t tx_advance_ms = 1;
+
+/// Radio interface of a single PHY. It resamples from/to the shared radio sampling rate and defers the rest to the mux
+class radio_mux::port_t : public radio_interface_phy
+{
+public:
+  port_t(radio_mux& parent_, uint32_t nof_channels) :
+    parent(parent_),
+    decimators(nof_channels),
+    rx_buffer(nof_channels),
+    interpolators(nof_channels),
+    tx_buffer(nof_channels)
+  {}
+
+  ~port_t()
+  {
+    for (srsran_resampler_fft_t& q : decimators) {
+      srsran_resampler_fft_free(&q);
+    }
+    for (srsran_resampler_fft_t& q : interpolators) {
+      srsran_resampler_fft_free(&q);
+    }
+  }
+
+  void tx_end() override {}
+  bool tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_time) override
+  {
+    return parent.tx(*this, buffer, tx_time);
+  }
+  bool rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time) override
+  {
+    return parent.rx(*this, buffer, rxd_time);
+  }
+  void set_tx_freq(const uint32_t& carrier_idx, const double& freq) override { parent.set_tx_freq(carrier_idx, freq); }
+  void set_rx_freq(const uint32_t& carrier_idx, const double& freq) override { parent.set_rx_freq(carrier_idx, freq); }
+  void release_freq(const uint32_t& carrier_idx) override {}
+  void set_tx_gain(const float& gain) override { parent.radio.set_tx_gain(gain); }
+  void set_rx_gain_th(const float& gain) override { parent.radio.set_rx_gain_th(gain); }
+  void set_rx_gain(const float& gain) override { parent.radio.set_rx_gain(gain); }
+  void set_tx_srate(const double& srate) override
+  {
+    std::lock_guard<std::mutex> lock(tx_mutex);
+    set_ratio(interpolators, SRSRAN_RESAMPLER_MODE_INTERPOLATE, srate);
+  }
+  void set_rx_srate(const double& srate) override
+  {
+    std::lock_guard<std::mutex> lock(rx_mutex);
+    set_ratio(decimators, SRSRAN_RESAMPLER_MODE_DECIMATE, srate);
+  }
+  void set_channel_rx_offset(uint32_t ch, int32_t offset_samples) override {}
+
+  double            get_freq_offset() override { return parent.radio.get_freq_offset(); }
+  float             get_rx_gain() override { return parent.radio.get_rx_gain(); }
+  bool              is_continuous_tx() override { return false; }
+  bool              get_is_start_of_burst() override { return true; }
+  bool              is_init() override { return parent.radio.is_init(); }
+  void              reset() override
+  {
+    std::lock_guard<std::mutex> lock(rx_mutex);
+    rx_started = false;
+  }
+  srsran_rf_info_t* get_info() override { return parent.radio.get_info(); }
+
+  /// Returns the resampling ratio, which is 1 if the sampling rate has not been set
+  static uint32_t get_ratio(const std::vector<srsran_resampler_fft_t>& resamplers)
+  {
+    return resamplers.empty() ? 1 : SRSRAN_MAX(resamplers[0].ratio, 1);
+  }
+
+  radio_mux&           parent;
+  phy_interface_radio* phy = nullptr;
+
+  // Receive state, protected by rx_mutex
+  std::mutex                          rx_mutex;
+  std::vector<srsran_resampler_fft_t> decimators;
+  std::vector<std::vector<cf_t> >     rx_buffer;
+  bool                                rx_started = false;
+  uint64_t                            rx_cursor  = 0; ///< Index of the next sample to read from the ring buffer
+
+  // Transmit state, protected by tx_mutex
+  std::mutex                          tx_mutex;
+  std::vector<srsran_resampler_fft_t> interpolators;
+  std::vector<std::vector<cf_t> >     tx_buffer;
+
+private:
+  void set_ratio(std::vector<srsran_resampler_fft_t>& resamplers, srsran_resampler_mode_t mode, double srate)
+  {
+    srsran_assert(std::isnormal(srate) and ((uint64_t)parent.srate_hz % (uint64_t)srate) == 0,
+                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz)",
+                  parent.srate_hz / 1e6,
+                  srate / 1e6);
+    uint32_t ratio = (uint32_t)round(parent.srate_hz / srate);
+    for (srsran_resampler_fft_t& q : resamplers) {
+      srsran_resampler_fft_init(&q, mode, ratio);
+    }
+  }
+};
+
+radio_mux::radio_mux(radio_interface_phy& radio_, double srate_hz_, uint32_t nof_channels_, uint32_t nof_ports_) :
+  logger(srslog::fetch_basic_logger("RF", false)),
+  radio(radio_),
+  srate_hz(srate_hz_),
+  nof_channels(nof_channels_),
+  rx_ring_len((uint32_t)(srate_hz_ * rx_ring_len_ms / 1000)),
+  tx_ring_len((uint32_t)(srate_hz_ * tx_ring_len_ms / 1000)),
+  tx_advance((uint32_t)(srate_hz_ * tx_advance_ms / 1000)),
+  rx_ring(nof_channels_, std::vector<cf_t>(rx_ring_len)),
+  rx_tmp(nof_channels_),
+  tx_ring(nof_channels_, std::vector<cf_t>(tx_ring_len)),
+  rx_freq(SRSRAN_MAX_CARRIERS, 0.0),
+  tx_freq(SRSRAN_MAX_CARRIERS, 0.0)
+{
+  srsran_assert(nof_channels > 0 and nof_channels <= SRSRAN_MAX_CHANNELS, "Invalid number of channels");
+
+  ports.reserve(nof_ports_);
+  for (uint32_t i = 0; i < nof_ports_; i++) {
+    ports.emplace_back(std::unique_ptr<port_t>(new port_t(*this, nof_channels)));
+  }
+}
+
+radio_mux::~radio_mux() = default;
+
+radio_interface_phy* radio_mux::get_port(uint32_t port_idx)
+{
+  return port_idx < ports.size() ? ports[port_idx].get() : nullptr;
+}
+
+void radio_mux::set_phy(uint32_t port_idx, phy_interface_radio* phy)
+{
+  if (port_idx < ports.size()) {
+    ports[port_idx]->phy = phy;
+  }
+}
+
+void radio_mux::radio_overflow()
+{
+  for (std::unique_ptr<port_t>& port : ports) {
+    if (port->phy != nullptr) {
+      port->phy->radio_overflow();
+    }
+  }
+}
+
+void radio_mux::radio_failure()
+{
+  for (std::unique_ptr<port_t>& port : ports) {
+    if (port->phy != nullptr) {
+      port->phy->radio_failure();
+    }
+  }
+}
+
+int64_t radio_mux::get_index(const srsran_timestamp_t& ts) const
+{
+  double secs = (double)(ts.full_secs - base_ts.full_secs) + (ts.frac_secs - base_ts.frac_secs);
+  return (int64_t)llround(secs * srate_hz);
+}
+
+void radio_mux::get_timestamp(uint64_t index, srsran_timestamp_t* ts) const
+{
+  *ts = base_ts;
+  srsran_timestamp_add(ts, 0, (double)index / srate_hz);
+}
+
+bool radio_mux::receive(uint32_t nof_samples)
+{
+  rf_buffer_t    buffer;
+  rf_timestamp_t rxd_time;
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    if (rx_tmp[ch].size() < nof_samples) {
+      rx_tmp[ch].resize(nof_samples);
+    }
+    buffer.set(ch, rx_tmp[ch].data());
+  }
+  buffer.set_nof_samples(nof_samples);
+
+  bool ret = radio.rx_now(buffer, rxd_time);
+
+  // The first received sample has the index 0. Afterwards, the stream is expected to be continuous, otherwise the time
+  // reference is moved so the indexes keep increasing. The Tx side reads the time reference too
+  const srsran_timestamp_t&   ts = rxd_time.get(0);
+  {
+    std::lock_guard<std::mutex> tx_lock(tx_mutex);
+    if (not rx_started) {
+      base_ts    = ts;
+      rx_started = true;
+    } else if (std::abs(get_index(ts) - (int64_t)rx_head) > 1) {
+      logger.info("RF mux: Rx stream is not continuous, expected sample %" PRIu64 " but received %" PRId64,
+                  rx_head,
+                  get_index(ts));
+      double secs = (double)rx_head / srate_hz;
+      base_ts     = ts;
+      srsran_timestamp_sub(&base_ts, (time_t)floor(secs), secs - floor(secs));
+    }
+  }
+
+  // Store samples in the ring buffer
+  uint32_t offset = (uint32_t)(rx_head % rx_ring_len);
+  uint32_t n1     = SRSRAN_MIN(nof_samples, rx_ring_len - offset);
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    srsran_vec_cf_copy(&rx_ring[ch][offset], rx_tmp[ch].data(), n1);
+    srsran_vec_cf_copy(&rx_ring[ch][0], &rx_tmp[ch][n1], nof_samples - n1);
+  }
+  rx_head += nof_samples;
+
+  // Every port received the samples in advance of the last received sample, hand them to the radio
+  flush_tx(rx_head + tx_advance);
+
+  return ret;
+}
+
+bool radio_mux::rx(port_t& port, rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time)
+{
+  std::lock_guard<std::mutex> port_lock(port.rx_mutex);
+  uint32_t                    ratio       = port_t::get_ratio(port.decimators);
+  uint32_t                    nof_samples = buffer.get_nof_samples() * ratio;
+  bool                        ret         = true;
+  bool                        overflow    = false;
+
+  if (nof_samples > rx_ring_len) {
+    logger.error("RF mux: Rx number of samples (%d) exceeds buffer size (%d)", nof_samples, rx_ring_len);
+    return false;
+  }
+
+  // Samples are read at the shared radio rate and decimated afterwards
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    if (ratio > 1 && port.rx_buffer[ch].size() < nof_samples) {
+      port.rx_buffer[ch].resize(nof_samples);
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(rx_mutex);
+
+    // A port starts receiving the most recent samples
+    if (not port.rx_started) {
+      port.rx_cursor  = rx_head;
+      port.rx_started = true;
+    }
+
+    // Only the first port asking for samples that have not been received yet reads the radio
+    if (port.rx_cursor + nof_samples > rx_head) {
+      ret = receive((uint32_t)(port.rx_cursor + nof_samples - rx_head));
+    }
+
+    // The samples of a port that fell behind have been overwritten, jump to the most recent ones
+    if (port.rx_cursor + rx_ring_len < rx_head) {
+      port.rx_cursor = rx_head - nof_samples;
+      overflow       = true;
+    }
+
+    uint32_t offset = (uint32_t)(port.rx_cursor % rx_ring_len);
+    uint32_t n1     = SRSRAN_MIN(nof_samples, rx_ring_len - offset);
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      cf_t* ptr = ratio > 1 ? port.rx_buffer[ch].data() : buffer.get(ch);
+      if (ptr != nullptr) {
+        srsran_vec_cf_copy(ptr, &rx_ring[ch][offset], n1);
+        srsran_vec_cf_copy(&ptr[n1], &rx_ring[ch][0], nof_samples - n1);
+      }
+    }
+
+    srsran_timestamp_t ts = {};
+    get_timestamp(port.rx_cursor, &ts);
+    for (uint32_t i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
+      rxd_time[i] = ts;
+    }
+
+    port.rx_cursor += nof_samples;
+  }
+
+  // Decimate outside of the shared lock
+  if (ratio > 1) {
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      if (buffer.get(ch) != nullptr) {
+        srsran_resampler_fft_run(&port.decimators[ch], port.rx_buffer[ch].data(), buffer.get(ch), nof_samples);
+      }
+    }
+  }
+
+  if (overflow && port.phy != nullptr) {
+    port.phy->radio_overflow();
+  }
+
+  return ret;
+}
+
+bool radio_mux::tx(port_t& port, rf_buffer_interface& buffer, const rf_timestamp_interface& tx_time)
+{
+  std::lock_guard<std::mutex> port_lock(port.tx_mutex);
+  uint32_t                    ratio       = port_t::get_ratio(port.interpolators);
+  uint32_t                    nof_samples = buffer.get_nof_samples() * ratio;
+
+  if (nof_samples > tx_ring_len) {
+    logger.error("RF mux: Tx number of samples (%d) exceeds buffer size (%d)", nof_samples, tx_ring_len);
+    return false;
+  }
+
+  // Interpolate outside of the shared lock
+  cf_t* ptr[SRSRAN_MAX_CHANNELS] = {};
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    ptr[ch] = buffer.get(ch);
+    if (ratio > 1 && ptr[ch] != nullptr) {
+      if (port.tx_buffer[ch].size() < nof_samples) {
+        port.tx_buffer[ch].resize(nof_samples);
+      }
+      srsran_resampler_fft_run(&port.interpolators[ch], ptr[ch], port.tx_buffer[ch].data(), buffer.get_nof_samples());
+      ptr[ch] = port.tx_buffer[ch].data();
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(tx_mutex);
+
+  // Transmission times are only known after the first reception
+  if (not rx_started) {
+    return false;
+  }
+
+  int64_t index = get_index(tx_time.get(0));
+  if (not tx_started) {
+    tx_flushed = (uint64_t)SRSRAN_MAX(index, 0);
+    tx_started = true;
+  }
+
+  // Drop the samples that have already been handed to the radio
+  uint32_t skip = 0;
+  if (index < (int64_t)tx_flushed) {
+    skip = (uint32_t)SRSRAN_MIN((int64_t)tx_flushed - index, (int64_t)nof_samples);
+    nof_late += skip;
+    logger.debug("RF mux: Dropping %d late Tx samples (%" PRIu64 " in total)", skip, nof_late);
+  }
+  if (skip == nof_samples) {
+    return true;
+  }
+
+  // Samples too far in the future do not fit in the ring buffer
+  uint64_t start = (uint64_t)index + skip;
+  uint64_t end   = (uint64_t)index + nof_samples;
+  if (end > tx_flushed + tx_ring_len) {
+    logger.warning("RF mux: Tx time is %" PRIu64 " samples ahead of the radio, dropping them", end - tx_flushed);
+    return false;
+  }
+
+  // Add the samples to the ones of the other ports
+  uint32_t len    = (uint32_t)(end - start);
+  uint32_t offset = (uint32_t)(start % tx_ring_len);
+  uint32_t n1     = SRSRAN_MIN(len, tx_ring_len - offset);
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    if (ptr[ch] != nullptr) {
+      srsran_vec_sum_ccc(&tx_ring[ch][offset], &ptr[ch][skip], &tx_ring[ch][offset], n1);
+      srsran_vec_sum_ccc(&tx_ring[ch][0], &ptr[ch][skip + n1], &tx_ring[ch][0], len - n1);
+    }
+  }
+
+  return true;
+}
+
+void radio_mux::flush_tx(uint64_t end)
+{
+  std::lock_guard<std::mutex> lock(tx_mutex);
+
+  if (not tx_started or end <= tx_flushed) {
+    return;
+  }
+
+  // Nothing in the ring buffer is that old, the samples written so far are misplaced in time
+  if (end > tx_flushed + tx_ring_len) {
+    for (std::vector<cf_t>& v : tx_ring) {
+      srsran_vec_cf_zero(v.data(), tx_ring_len);
+    }
+    tx_flushed = end;
+    return;
+  }
+
+  // Transmit the contiguous segments of the ring buffer and clear them for the next round
+  while (tx_flushed < end) {
+    uint32_t offset = (uint32_t)(tx_flushed % tx_ring_len);
+    uint32_t len    = (uint32_t)SRSRAN_MIN(end - tx_flushed, (uint64_t)(tx_ring_len - offset));
+
+    rf_buffer_t buffer;
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      buffer.set(ch, &tx_ring[ch][offset]);
+    }
+    buffer.set_nof_samples(len);
+
+    rf_timestamp_t tx_time;
+    get_timestamp(tx_flushed, tx_time.get_ptr(0));
+    for (uint32_t i = 1; i < SRSRAN_MAX_CHANNELS; i++) {
+      tx_time[i] = tx_time[0];
+    }
+
+    radio.tx(buffer, tx_time);
+
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      srsran_vec_cf_zero(&tx_ring[ch][offset], len);
+    }
+    tx_flushed += len;
+  }
+}
+
+void radio_mux::set_rx_freq(uint32_t carrier_idx, double freq)
+{
+  std::lock_guard<std::mutex> lock(freq_mutex);
+  if (carrier_idx < rx_freq.size() and rx_freq[carrier_idx] != freq) {
+    radio.set_rx_freq(carrier_idx, freq);
+    rx_freq[carrier_idx] = freq;
+  }
+}
+
+void radio_mux::set_tx_freq(uint32_t carrier_idx, double freq)
+{
+  std::lock_guard<std::mutex> lock(freq_mutex);
+  if (carrier_idx < tx_freq.size() and tx_freq[carrier_idx] != freq) {
+    radio.set_tx_freq(carrier_idx, freq);
+    tx_freq[carrier_idx] = freq;
+  }
+}
+
+} // namespace srsran
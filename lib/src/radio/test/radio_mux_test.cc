@@ -0,0 +1,237 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/radio/radio_mux.h"
+#include "srsran/radio/rf_timestamp.h"
+
+static const double   srate_hz   = 1.92e6;
+static const uint32_t sf_len     = 1920;
+static const double   start_secs = 10.0;
+
+/// Radio that receives a ramp, sample n is equal to n, and records the transmitted samples by their index
+class dummy_radio : public srsran::radio_interface_phy
+{
+public:
+  void tx_end() override {}
+  bool tx(srsran::rf_buffer_interface& buffer, const srsran::rf_timestamp_interface& tx_time) override
+  {
+    double   secs  = srsran_timestamp_real(&tx_time.get(0)) - start_secs;
+    uint64_t index = (uint64_t)llround(secs * srate_hz);
+
+    // The stream starts with the first transmission and it must be continuous
+    if (tx_samples.empty()) {
+      tx_first = index;
+      tx_next  = index;
+    }
+    TESTASSERT(index == tx_next);
+    for (uint32_t i = 0; i < buffer.get_nof_samples(); i++) {
+      tx_samples.push_back(buffer.get(0)[i]);
+    }
+    tx_next += buffer.get_nof_samples();
+    return true;
+  }
+  bool rx_now(srsran::rf_buffer_interface& buffer, srsran::rf_timestamp_interface& rxd_time) override
+  {
+    srsran_timestamp_init(rxd_time.get_ptr(0), (time_t)start_secs, 0.0);
+    srsran_timestamp_add(rxd_time.get_ptr(0), 0, rx_next / srate_hz);
+    for (uint32_t i = 0; i < buffer.get_nof_samples(); i++) {
+      buffer.get(0)[i] = (float)(rx_next + i);
+    }
+    rx_next += buffer.get_nof_samples();
+    nof_rx_calls++;
+    return true;
+  }
+  void set_tx_freq(const uint32_t& carrier_idx, const double& freq) override { nof_freq_calls++; }
+  void set_rx_freq(const uint32_t& carrier_idx, const double& freq) override { nof_freq_calls++; }
+  void release_freq(const uint32_t& carrier_idx) override {}
+  void set_tx_gain(const float& gain) override {}
+  void set_rx_gain_th(const float& gain) override {}
+  void set_rx_gain(const float& gain) override {}
+  void set_tx_srate(const double& srate) override {}
+  void set_rx_srate(const double& srate) override {}
+  void set_channel_rx_offset(uint32_t ch, int32_t offset_samples) override {}
+
+  double            get_freq_offset() override { return 0; }
+  float             get_rx_gain() override { return 0; }
+  bool              is_continuous_tx() override { return true; }
+  bool              get_is_start_of_burst() override { return false; }
+  bool              is_init() override { return true; }
+  void              reset() override {}
+  srsran_rf_info_t* get_info() override { return &rf_info; }
+
+  uint64_t          rx_next        = 0;
+  uint64_t          tx_first       = 0;
+  uint64_t          tx_next        = 0;
+  uint32_t          nof_rx_calls   = 0;
+  uint32_t          nof_freq_calls = 0;
+  std::vector<cf_t> tx_samples;
+
+private:
+  srsran_rf_info_t rf_info = {};
+};
+
+class dummy_phy : public srsran::phy_interface_radio
+{
+public:
+  void radio_overflow() override { nof_overflows++; }
+  void radio_failure() override {}
+
+  uint32_t nof_overflows = 0;
+};
+
+/// Receives a subframe from a port, checks it is the expected portion of the ramp and returns its timestamp
+static srsran_timestamp_t rx_subframe(srsran::radio_interface_phy* port, uint64_t expected_index)
+{
+  std::vector<cf_t>      samples(sf_len);
+  srsran::rf_buffer_t    buffer(samples.data(), sf_len);
+  srsran::rf_timestamp_t rxd_time;
+
+  TESTASSERT(port->rx_now(buffer, rxd_time));
+  for (uint32_t i = 0; i < sf_len; i++) {
+    TESTASSERT(__real__ samples[i] == (float)(expected_index + i));
+  }
+
+  double secs = srsran_timestamp_real(&rxd_time.get(0)) - start_secs;
+  TESTASSERT(llround(secs * srate_hz) == (long long)expected_index);
+
+  return rxd_time.get(0);
+}
+
+/// Every port receives the same samples and the radio is read only once
+static int test_rx()
+{
+  dummy_radio       radio;
+  srsran::radio_mux mux(radio, srate_hz, 1, 2);
+
+  for (uint32_t sf = 0; sf < 4; sf++) {
+    rx_subframe(mux.get_port(0), sf * sf_len);
+    rx_subframe(mux.get_port(1), sf * sf_len);
+  }
+  TESTASSERT(radio.rx_next == 4 * sf_len);
+  TESTASSERT(radio.nof_rx_calls == 4);
+
+  // Frequencies are only set once for all the ports
+  mux.get_port(0)->set_rx_freq(0, 2.68e9);
+  mux.get_port(1)->set_rx_freq(0, 2.68e9);
+  TESTASSERT(radio.nof_freq_calls == 1);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// A port that falls behind is notified with an overflow and moved to the most recent samples
+static int test_overflow()
+{
+  dummy_radio       radio;
+  dummy_phy         phy[2];
+  srsran::radio_mux mux(radio, srate_hz, 1, 2);
+  mux.set_phy(0, &phy[0]);
+  mux.set_phy(1, &phy[1]);
+
+  rx_subframe(mux.get_port(1), 0);
+  for (uint32_t sf = 0; sf < 30; sf++) {
+    rx_subframe(mux.get_port(0), sf * sf_len);
+  }
+
+  // The next subframe of the slow port is the last received one
+  rx_subframe(mux.get_port(1), 29 * sf_len);
+  TESTASSERT(phy[0].nof_overflows == 0);
+  TESTASSERT(phy[1].nof_overflows == 1);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// A port at a lower sampling rate receives the same time span with fewer samples
+static int test_resampling()
+{
+  dummy_radio       radio;
+  srsran::radio_mux mux(radio, srate_hz, 1, 2);
+  mux.get_port(1)->set_rx_srate(srate_hz / 2);
+
+  for (uint32_t sf = 0; sf < 4; sf++) {
+    rx_subframe(mux.get_port(0), sf * sf_len);
+
+    std::vector<cf_t>      samples(sf_len / 2);
+    srsran::rf_buffer_t    buffer(samples.data(), sf_len / 2);
+    srsran::rf_timestamp_t rxd_time;
+    TESTASSERT(mux.get_port(1)->rx_now(buffer, rxd_time));
+
+    double secs = srsran_timestamp_real(&rxd_time.get(0)) - start_secs;
+    TESTASSERT(llround(secs * srate_hz) == (long long)(sf * sf_len));
+  }
+  TESTASSERT(radio.rx_next == 4 * sf_len);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// The samples of all the ports are added up and transmitted as a continuous stream, late samples are dropped
+static int test_tx()
+{
+  dummy_radio       radio;
+  srsran::radio_mux mux(radio, srate_hz, 1, 2);
+
+  std::vector<cf_t>   samples(sf_len, 1.0f);
+  srsran::rf_buffer_t buffer(samples.data(), sf_len);
+
+  for (uint32_t sf = 0; sf < 10; sf++) {
+    for (uint32_t p = 0; p < 2; p++) {
+      srsran_timestamp_t ts = rx_subframe(mux.get_port(p), sf * sf_len);
+
+      // Both ports transmit subframe sf + 4 every other subframe, the second one also transmits late in between
+      srsran::rf_timestamp_t tx_time;
+      for (uint32_t i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
+        tx_time[i] = ts;
+      }
+      if (sf % 2 == 0) {
+        tx_time.add(4e-3);
+        TESTASSERT(mux.get_port(p)->tx(buffer, tx_time));
+      } else if (p == 1) {
+        TESTASSERT(mux.get_port(p)->tx(buffer, tx_time));
+      }
+    }
+  }
+
+  // The samples are handed to the radio up to 1 ms after the last received one
+  TESTASSERT(radio.tx_first == 4 * sf_len);
+  TESTASSERT(radio.tx_samples.size() == 7 * sf_len);
+  for (uint32_t i = 0; i < radio.tx_samples.size(); i++) {
+    uint32_t sf       = 4 + i / sf_len;
+    float    expected = (sf % 2 == 0) ? 2.0f : 0.0f;
+    TESTASSERT(__real__ radio.tx_samples[i] == expected);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  TESTASSERT(test_rx() == SRSRAN_SUCCESS);
+  TESTASSERT(test_overflow() == SRSRAN_SUCCESS);
+  TESTASSERT(test_resampling() == SRSRAN_SUCCESS);
+  TESTASSERT(test_tx() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
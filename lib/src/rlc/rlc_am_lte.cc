@@ -113,6 +113,21 @@ bool rlc_am_pdu_segment_pool::make_segment(rlc_amd_tx_pdu& rlc_list, pdcp_pdu_in
   return true;
 }
 
+rlc_amd_rx_pdu_segment* rlc_am_rx_segment_pool::allocate()
+{
+  if (free_list.empty()) {
+    segments.emplace_back();
+    return &segments.back();
+  }
+  return free_list.pop_front();
+}
+
+void rlc_am_rx_segment_pool::deallocate(rlc_amd_rx_pdu_segment* segment)
+{
+  segment->buf.reset();
+  free_list.push_front(segment);
+}
+
 void pdcp_pdu_info::ack_segment(rlc_am_pdu_segment& segment)
 {
   // remove from list
@@ -1538,7 +1553,7 @@ void rlc_am_lte::rlc_am_lte_rx::stop()
   do_status     = false;
 
   // Drop all messages in RX segments
-  rx_segments.clear();
+  clear_rx_segments();
 
   // Drop all messages in RX window
   rx_window.clear();
@@ -1552,11 +1567,39 @@ void rlc_am_lte::rlc_am_lte_rx::stop()
  */
 void rlc_am_lte::rlc_am_lte_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header)
 {
-  std::map<uint32_t, rlc_amd_rx_pdu>::iterator it;
-
   logger.info(payload, nof_bytes, "%s Rx data PDU SN=%d (%d B)", RB_NAME, header.sn, nof_bytes);
   log_rlc_amd_pdu_header_to_string(logger.debug, header);
 
+  if (not accept_data_pdu(nof_bytes, header)) {
+    return;
+  }
+
+  unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  if (pdu == NULL) {
+#ifdef RLC_AM_BUFFER_DEBUG
+    srsran::console("Fatal Error: Couldn't allocate PDU in handle_data_pdu().\n");
+    exit(-1);
+#else
+    logger.error("Fatal Error: Couldn't allocate PDU in handle_data_pdu().");
+    return;
+#endif
+  }
+
+  // check available space for payload
+  if (nof_bytes > pdu->get_tailroom()) {
+    logger.error(
+        "%s Discarding SN=%d of size %d B (available space %d B)", RB_NAME, header.sn, nof_bytes, pdu->get_tailroom());
+    return;
+  }
+  memcpy(pdu->msg, payload, nof_bytes);
+  pdu->N_bytes = nof_bytes;
+
+  insert_data_pdu(std::move(pdu), header);
+}
+
+/// Checks whether a data PDU, received whole or reconstructed from its segments, has to be stored in the Rx window
+bool rlc_am_lte::rlc_am_lte_rx::accept_data_pdu(uint32_t nof_bytes, rlc_amd_pdu_header_t& header)
+{
   // sanity check for segments not exceeding PDU length
   if (header.N_li > 0) {
     uint32_t segments_len = 0;
@@ -1564,7 +1607,7 @@ void rlc_am_lte::rlc_am_lte_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_b
       segments_len += header.li[i];
       if (segments_len > nof_bytes) {
         logger.info("Dropping corrupted PDU (segments_len=%d > pdu_len=%d)", segments_len, nof_bytes);
-        return;
+        return false;
       }
     }
   }
@@ -1575,7 +1618,7 @@ void rlc_am_lte::rlc_am_lte_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_b
       do_status = true;
     }
     logger.info("%s SN=%d outside rx window [%d:%d] - discarding", RB_NAME, header.sn, vr_r, vr_mr);
-    return;
+    return false;
   }
 
   if (rx_window.has_sn(header.sn)) {
@@ -1584,36 +1627,19 @@ void rlc_am_lte::rlc_am_lte_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_b
       do_status = true;
     }
     logger.info("%s Discarding duplicate SN=%d", RB_NAME, header.sn);
-    return;
+    return false;
   }
+  return true;
+}
 
+/// Stores an accepted data PDU in the Rx window, taking ownership of its buffer, and delivers the completed SDUs
+void rlc_am_lte::rlc_am_lte_rx::insert_data_pdu(unique_byte_buffer_t pdu, rlc_amd_pdu_header_t& header)
+{
   // Write to rx window
-  rlc_amd_rx_pdu& pdu = rx_window.add_pdu(header.sn);
-  pdu.buf             = srsran::make_byte_buffer();
-  if (pdu.buf == NULL) {
-#ifdef RLC_AM_BUFFER_DEBUG
-    srsran::console("Fatal Error: Couldn't allocate PDU in handle_data_pdu().\n");
-    exit(-1);
-#else
-    logger.error("Fatal Error: Couldn't allocate PDU in handle_data_pdu().");
-    rx_window.remove_pdu(header.sn);
-    return;
-#endif
-  }
-  pdu.buf->set_timestamp();
-
-  // check available space for payload
-  if (nof_bytes > pdu.buf->get_tailroom()) {
-    logger.error("%s Discarding SN=%d of size %d B (available space %d B)",
-                 RB_NAME,
-                 header.sn,
-                 nof_bytes,
-                 pdu.buf->get_tailroom());
-    return;
-  }
-  memcpy(pdu.buf->msg, payload, nof_bytes);
-  pdu.buf->N_bytes = nof_bytes;
-  pdu.header       = header;
+  rlc_amd_rx_pdu& rx_pdu = rx_window.add_pdu(header.sn);
+  rx_pdu.buf             = std::move(pdu);
+  rx_pdu.buf->set_timestamp();
+  rx_pdu.header = header;
 
   // Update vr_h
   if (RX_MOD_BASE(header.sn) >= RX_MOD_BASE(vr_h)) {
@@ -1671,8 +1697,6 @@ void rlc_am_lte::rlc_am_lte_rx::handle_data_pdu_segment(uint8_t*              pa
                                                         uint32_t              nof_bytes,
                                                         rlc_amd_pdu_header_t& header)
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-
   logger.info(payload,
               nof_bytes,
               "%s Rx data PDU segment of SN=%d (%d B), SO=%d, N_li=%d",
@@ -1693,9 +1717,9 @@ void rlc_am_lte::rlc_am_lte_rx::handle_data_pdu_segment(uint8_t*              pa
     return;
   }
 
-  rlc_amd_rx_pdu segment;
-  segment.buf = srsran::make_byte_buffer();
-  if (segment.buf == NULL) {
+  // Segments are usually much smaller than a full PDU, so their buffers are sized to the segment
+  unique_byte_buffer_t buf = srsran::make_byte_buffer(nof_bytes);
+  if (buf == NULL) {
 #ifdef RLC_AM_BUFFER_DEBUG
     srsran::console("Fatal Error: Couldn't allocate PDU in handle_data_pdu_segment().\n");
     exit(-1);
@@ -1705,17 +1729,20 @@ void rlc_am_lte::rlc_am_lte_rx::handle_data_pdu_segment(uint8_t*              pa
 #endif
   }
 
-  if (segment.buf->get_tailroom() < nof_bytes) {
+  if (buf->get_tailroom() < nof_bytes) {
     logger.info("Dropping corrupted segment SN=%d, not enough space to fit %d B", header.sn, nof_bytes);
     return;
   }
 
-  memcpy(segment.buf->msg, payload, nof_bytes);
-  segment.buf->N_bytes = nof_bytes;
-  segment.header       = header;
+  memcpy(buf->msg, payload, nof_bytes);
+  buf->N_bytes = nof_bytes;
+
+  rlc_amd_rx_pdu_segment* segment = segment_pool.allocate();
+  segment->buf                    = std::move(buf);
+  segment->header                 = header;
 
   // Check if we already have a segment from the same PDU
-  it = rx_segments.find(header.sn);
+  auto it = rx_segments.find(header.sn);
   if (rx_segments.end() != it) {
     if (header.p) {
       logger.info("%s Status packet requested through polling bit", RB_NAME);
@@ -1723,16 +1750,19 @@ void rlc_am_lte::rlc_am_lte_rx::handle_data_pdu_segment(uint8_t*              pa
     }
 
     // Add segment to PDU list and check for complete
-    // NOTE: MAY MOVE. Preference would be to capture by value, and then move; but header is stack allocated
-    if (add_segment_and_check(&it->second, &segment)) {
-      rx_segments.erase(it);
+    if (add_segment_and_check(&it->second, segment)) {
+      erase_rx_segments(header.sn);
     }
 
   } else {
     // Create new PDU segment list and write to rx_segments
-    rlc_amd_rx_pdu_segments_t pdu;
-    pdu.segments.push_back(std::move(segment));
-    rx_segments[header.sn] = std::move(pdu);
+    auto ret = rx_segments.insert(header.sn, rlc_amd_rx_pdu_segments_t{});
+    if (ret.is_error()) {
+      logger.error("Dropping segment SN=%d, the segments of another SN are still stored", header.sn);
+      segment_pool.deallocate(segment);
+      return;
+    }
+    ret.value()->second.segments.push_front(segment);
 
     // Update vr_h
     if (RX_MOD_BASE(header.sn) >= RX_MOD_BASE(vr_h)) {
@@ -1760,18 +1790,6 @@ void rlc_am_lte::rlc_am_lte_rx::handle_data_pdu_segment(uint8_t*              pa
 void rlc_am_lte::rlc_am_lte_rx::reassemble_rx_sdus()
 {
   uint32_t len = 0;
-  if (rx_sdu == NULL) {
-    rx_sdu = srsran::make_byte_buffer();
-    if (rx_sdu == NULL) {
-#ifdef RLC_AM_BUFFER_DEBUG
-      srsran::console("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (1)\n");
-      exit(-1);
-#else
-      logger.error("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (1)");
-      return;
-#endif
-    }
-  }
 
   // Iterate through rx_window, assembling and delivering SDUs
   while (rx_window.has_sn(vr_r)) {
@@ -1792,8 +1810,22 @@ void rlc_am_lte::rlc_am_lte_rx::reassemble_rx_sdus()
         break;
       }
 
+      // The SDU shares the PDU buffer with the following SDUs, so it has to be copied
+      if (rx_sdu == nullptr) {
+        rx_sdu = srsran::make_byte_buffer();
+        if (rx_sdu == nullptr) {
+#ifdef RLC_AM_BUFFER_DEBUG
+          srsran::console("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (1)\n");
+          exit(-1);
+#else
+          logger.error("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (1)");
+          return;
+#endif
+        }
+      }
+
       if (rx_sdu->get_tailroom() >= len) {
-        if ((rx_window[vr_r].buf->msg - rx_window[vr_r].buf->buffer) + len < SRSRAN_MAX_BUFFER_SIZE_BYTES) {
+        if ((rx_window[vr_r].buf->msg - rx_window[vr_r].buf->buffer) + len < rx_window[vr_r].buf->get_buffer_size()) {
           if (rx_window[vr_r].buf->N_bytes < len) {
             logger.error("Dropping corrupted SN=%d", vr_r);
             rx_sdu.reset();
@@ -1818,17 +1850,6 @@ void rlc_am_lte::rlc_am_lte_rx::reassemble_rx_sdus()
             std::lock_guard<std::mutex> lock(parent->metrics_mutex);
             parent->metrics.num_rx_sdus++;
           }
-
-          rx_sdu = srsran::make_byte_buffer();
-          if (rx_sdu == nullptr) {
-#ifdef RLC_AM_BUFFER_DEBUG
-            srsran::console("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (2)\n");
-            exit(-1);
-#else
-            logger.error("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (2)");
-            return;
-#endif
-          }
         } else {
           int buf_len = rx_window[vr_r].buf->msg - rx_window[vr_r].buf->buffer;
           logger.error("Cannot read %d bytes from rx_window. vr_r=%d, msg-buffer=%d B", len, vr_r, buf_len);
@@ -1845,20 +1866,40 @@ void rlc_am_lte::rlc_am_lte_rx::reassemble_rx_sdus()
     // Handle last segment
     len = rx_window[vr_r].buf->N_bytes;
     logger.debug(rx_window[vr_r].buf->msg, len, "Handling last segment of length %d B of SN=%d", len, vr_r);
-    if (rx_sdu->get_tailroom() >= len) {
-      // store timestamp of the first segment when starting to assemble SDUs
-      if (rx_sdu->N_bytes == 0) {
-        rx_sdu->set_timestamp(rx_window[vr_r].buf->get_timestamp());
-      }
-      memcpy(&rx_sdu->msg[rx_sdu->N_bytes], rx_window[vr_r].buf->msg, len);
-      rx_sdu->N_bytes += rx_window[vr_r].buf->N_bytes;
+    if (rx_sdu == nullptr and rlc_am_end_aligned(rx_window[vr_r].header.fi)) {
+      // The last segment is a whole SDU. Rather than copying it, the PDU buffer becomes the SDU buffer, with the
+      // RLC header and the preceding SDUs left in its headroom
+      rx_sdu = std::move(rx_window[vr_r].buf);
     } else {
-      printf("Cannot fit RLC PDU in SDU buffer (tailroom=%d, len=%d), dropping both. Erasing SN=%d.\n",
-             rx_sdu->get_tailroom(),
-             len,
-             vr_r);
-      rx_sdu.reset();
-      goto exit;
+      // Otherwise the segment is copied. An SDU that starts here and continues in the next PDU needs a fresh buffer,
+      // with the tailroom for its next segments
+      if (rx_sdu == nullptr) {
+        rx_sdu = srsran::make_byte_buffer();
+        if (rx_sdu == nullptr) {
+#ifdef RLC_AM_BUFFER_DEBUG
+          srsran::console("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (2)\n");
+          exit(-1);
+#else
+          logger.error("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (2)");
+          return;
+#endif
+        }
+      }
+      if (rx_sdu->get_tailroom() >= len) {
+        // store timestamp of the first segment when starting to assemble SDUs
+        if (rx_sdu->N_bytes == 0) {
+          rx_sdu->set_timestamp(rx_window[vr_r].buf->get_timestamp());
+        }
+        memcpy(&rx_sdu->msg[rx_sdu->N_bytes], rx_window[vr_r].buf->msg, len);
+        rx_sdu->N_bytes += rx_window[vr_r].buf->N_bytes;
+      } else {
+        printf("Cannot fit RLC PDU in SDU buffer (tailroom=%d, len=%d), dropping both. Erasing SN=%d.\n",
+               rx_sdu->get_tailroom(),
+               len,
+               vr_r);
+        rx_sdu.reset();
+        goto exit;
+      }
     }
 
     if (rlc_am_end_aligned(rx_window[vr_r].header.fi)) {
@@ -1871,37 +1912,13 @@ void rlc_am_lte::rlc_am_lte_rx::reassemble_rx_sdus()
         std::lock_guard<std::mutex> lock(parent->metrics_mutex);
         parent->metrics.num_rx_sdus++;
       }
-
-      rx_sdu = srsran::make_byte_buffer();
-      if (rx_sdu == NULL) {
-#ifdef RLC_AM_BUFFER_DEBUG
-        srsran::console("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (3)\n");
-        exit(-1);
-#else
-        logger.error("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (3)");
-        return;
-#endif
-      }
     }
 
   exit:
     // Move the rx_window
     logger.debug("Erasing SN=%d.", vr_r);
     // also erase any segments of this SN
-    std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-    it = rx_segments.find(vr_r);
-    if (rx_segments.end() != it) {
-      logger.debug("Erasing segments of SN=%d", vr_r);
-      std::list<rlc_amd_rx_pdu>::iterator segit;
-      for (segit = it->second.segments.begin(); segit != it->second.segments.end(); ++segit) {
-        logger.debug(" Erasing segment of SN=%d SO=%d Len=%d N_li=%d",
-                     segit->header.sn,
-                     segit->header.so,
-                     segit->buf->N_bytes,
-                     segit->header.N_li);
-      }
-      it->second.segments.clear();
-    }
+    erase_rx_segments(vr_r);
     rx_window.remove_pdu(vr_r);
     vr_r  = (vr_r + 1) % MOD;
     vr_mr = (vr_mr + 1) % MOD;
@@ -2061,53 +2078,88 @@ int rlc_am_lte::rlc_am_lte_rx::get_status_pdu_length()
 
 void rlc_am_lte::rlc_am_lte_rx::print_rx_segments()
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-  std::stringstream                                       ss;
+  std::stringstream ss;
   ss << "rx_segments:" << std::endl;
-  for (it = rx_segments.begin(); it != rx_segments.end(); it++) {
-    std::list<rlc_amd_rx_pdu>::iterator segit;
-    for (segit = it->second.segments.begin(); segit != it->second.segments.end(); segit++) {
-      ss << "    SN=" << segit->header.sn << " SO:" << segit->header.so << " N:" << segit->buf->N_bytes
-         << " N_li: " << segit->header.N_li << std::endl;
+  for (auto& pdu : rx_segments) {
+    for (const rlc_amd_rx_pdu_segment& segment : pdu.second.segments) {
+      ss << "    SN=" << segment.header.sn << " SO:" << segment.header.so << " N:" << segment.buf->N_bytes
+         << " N_li: " << segment.header.N_li << std::endl;
     }
   }
   logger.debug("%s", ss.str().c_str());
 }
 
-// NOTE: Preference would be to capture by value, and then move; but header is stack allocated
-bool rlc_am_lte::rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_amd_rx_pdu* segment)
+/// Returns the segments of a SN to the segment pool, once its PDU is reconstructed or leaves the Rx window
+void rlc_am_lte::rlc_am_lte_rx::erase_rx_segments(uint32_t sn)
+{
+  auto it = rx_segments.find(sn);
+  if (rx_segments.end() == it) {
+    return;
+  }
+  logger.debug("Erasing segments of SN=%d", sn);
+  while (not it->second.segments.empty()) {
+    rlc_amd_rx_pdu_segment* segment = &it->second.segments.front();
+    logger.debug(" Erasing segment of SN=%d SO=%d Len=%d N_li=%d",
+                 segment->header.sn,
+                 segment->header.so,
+                 segment->buf->N_bytes,
+                 segment->header.N_li);
+    it->second.segments.pop_front();
+    segment_pool.deallocate(segment);
+  }
+  rx_segments.erase(it);
+}
+
+void rlc_am_lte::rlc_am_lte_rx::clear_rx_segments()
+{
+  for (auto& pdu : rx_segments) {
+    while (not pdu.second.segments.empty()) {
+      rlc_amd_rx_pdu_segment* segment = &pdu.second.segments.front();
+      pdu.second.segments.pop_front();
+      segment_pool.deallocate(segment);
+    }
+  }
+  rx_segments.clear();
+}
+
+// The segment is either stored in the list, sorted by segment offset, or returned to the segment pool
+bool rlc_am_lte::rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_amd_rx_pdu_segment* segment)
 {
   // Find segment insertion point in the list of segments
-  auto it1 = pdu->segments.begin();
+  rlc_amd_rx_pdu_segment* prev = nullptr;
+  auto                    it1  = pdu->segments.begin();
   while (it1 != pdu->segments.end() && (*it1).header.so < segment->header.so) {
     // Increment iterator
-    it1++;
+    prev = &(*it1);
+    ++it1;
   }
 
   // Check if the insertion point was found
-  if (it1 != pdu->segments.end()) {
-    // Found insertion point
-    rlc_amd_rx_pdu& s = *it1;
-    if (s.header.so == segment->header.so) {
-      // Same Segment offset
-      if (segment->buf->N_bytes > s.buf->N_bytes) {
-        // replace if the new one is bigger
-        s = std::move(*segment);
-      } else {
-        // Ignore otherwise
-      }
-    } else if (s.header.so > segment->header.so) {
-      pdu->segments.insert(it1, std::move(*segment));
+  if (it1 != pdu->segments.end() && (*it1).header.so == segment->header.so) {
+    // Same Segment offset
+    rlc_amd_rx_pdu_segment& s = *it1;
+    if (segment->buf->N_bytes > s.buf->N_bytes) {
+      // replace if the new one is bigger
+      s.header = segment->header;
+      s.buf    = std::move(segment->buf);
+    } else {
+      // Ignore otherwise
     }
+    segment_pool.deallocate(segment);
+  } else if (prev != nullptr) {
+    // Insert before the segment with a higher offset, or at the end of the list
+    pdu->segments.insert_after(prev, segment);
   } else {
-    // Either the new segment is the latest or the only one, push back
-    pdu->segments.push_back(std::move(*segment));
+    // The new segment has the lowest offset
+    pdu->segments.push_front(segment);
   }
 
   // Check for complete
-  uint32_t                            so = 0;
-  std::list<rlc_amd_rx_pdu>::iterator it, tmpit;
-  for (it = pdu->segments.begin(); it != pdu->segments.end(); /* Do not increment */) {
+  uint32_t so           = 0;
+  uint32_t nof_segments = 0;
+  auto     it           = pdu->segments.begin();
+  auto     last         = pdu->segments.end();
+  while (it != pdu->segments.end()) {
     // Check that there is no gap between last segment and current; overlap allowed
     if (so < it->header.so) {
       // return
@@ -2117,16 +2169,21 @@ bool rlc_am_lte::rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t*
     // Check if segment is overlapped
     if (it->header.so + it->buf->N_bytes <= so) {
       // completely overlapped with previous segments, erase
-      it = pdu->segments.erase(it); // Returns next iterator
+      rlc_amd_rx_pdu_segment* overlapped = &(*it);
+      ++it;
+      pdu->segments.pop(overlapped);
+      segment_pool.deallocate(overlapped);
     } else {
       // Update segment offset it shall not go backwards
-      so = SRSRAN_MAX(so, it->header.so + it->buf->N_bytes);
-      it++; // Increments iterator
+      so   = SRSRAN_MAX(so, it->header.so + it->buf->N_bytes);
+      last = it;
+      ++it;
+      nof_segments++;
     }
   }
 
   // Check for last segment flag available
-  if (!pdu->segments.back().header.lsf) {
+  if (last == pdu->segments.end() || !last->header.lsf) {
     return false;
   }
 
@@ -2143,9 +2200,9 @@ bool rlc_am_lte::rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t*
 
   // Reconstruct fi field
   header.fi |= (pdu->segments.front().header.fi & RLC_FI_FIELD_NOT_START_ALIGNED);
-  header.fi |= (pdu->segments.back().header.fi & RLC_FI_FIELD_NOT_END_ALIGNED);
+  header.fi |= (last->header.fi & RLC_FI_FIELD_NOT_END_ALIGNED);
 
-  logger.debug("Starting header reconstruction of %zd segments", pdu->segments.size());
+  logger.debug("Starting header reconstruction of %d segments", nof_segments);
 
   // Reconstruct li fields
   uint16_t count          = 0;
@@ -2207,7 +2264,7 @@ bool rlc_am_lte::rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t*
                    header.li[header.N_li]);
     }
 
-    tmpit = it;
+    auto tmpit = it;
     if (rlc_am_end_aligned(it->header.fi) && ++tmpit != pdu->segments.end()) {
       logger.debug("Header is end-aligned, overwrite header.li[%d]=%d", header.N_li, carryover);
       header.li[header.N_li] = carryover;
@@ -2221,7 +2278,7 @@ bool rlc_am_lte::rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t*
     header.p |= it->header.p;
   }
 
-  logger.debug("Finished header reconstruction of %zd segments", pdu->segments.size());
+  logger.debug("Finished header reconstruction of %d segments", nof_segments);
 
   // Copy data
   unique_byte_buffer_t full_pdu = srsran::make_byte_buffer();
@@ -2234,7 +2291,7 @@ bool rlc_am_lte::rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t*
     return false;
 #endif
   }
-  for (it = pdu->segments.begin(); it != pdu->segments.end(); it++) {
+  for (it = pdu->segments.begin(); it != pdu->segments.end(); ++it) {
     // By default, the segment is not copied. It could be it is fully overlapped with previous segments
     uint32_t overlap = 0;
     uint32_t n       = 0;
@@ -2251,7 +2308,12 @@ bool rlc_am_lte::rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t*
     full_pdu->N_bytes += n;
   }
 
-  handle_data_pdu(full_pdu->msg, full_pdu->N_bytes, header);
+  // The reconstructed PDU is moved to the Rx window, rather than copied once more
+  logger.info(full_pdu->msg, full_pdu->N_bytes, "%s Rx data PDU SN=%d (%d B)", RB_NAME, header.sn, full_pdu->N_bytes);
+  log_rlc_amd_pdu_header_to_string(logger.debug, header);
+  if (accept_data_pdu(full_pdu->N_bytes, header)) {
+    insert_data_pdu(std::move(full_pdu), header);
+  }
   return true;
 }
 
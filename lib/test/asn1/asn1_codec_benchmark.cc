@@ -0,0 +1,199 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/asn1/ngap.h"
+#include "srsran/asn1/rrc.h"
+#include "srsran/asn1/s1ap.h"
+#include "srsran/common/test_common.h"
+
+#include <chrono>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+/*
+ * Measures the time taken to unpack and pack a set of representative RRC, S1AP and NGAP messages. The unpack times
+ * include the release of the decoded message, which is done either in the heap or in a decode_arena.
+ */
+
+using namespace asn1;
+
+static uint32_t nof_repetitions = 10000;
+
+static void usage(const char* prog)
+{
+  printf("Usage: %s [n]\n", prog);
+  printf("\t-n Number of decode/encode repetitions per message [Default %d]\n", nof_repetitions);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_repetitions = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// RRCConnectionReconfiguration with measConfig, radioResourceConfigDedicated and a NAS PDU
+static const uint8_t rrc_conn_reconf[] = {
+    0x20, 0x16, 0x15, 0xC8, 0x40, 0x00, 0x03, 0xC2, 0x84, 0x18, 0x10, 0xA8, 0x04, 0xD7, 0x95, 0x14, 0xA2, 0x01, 0x02,
+    0x18, 0x9A, 0x01, 0x80, 0x14, 0x81, 0x0A, 0xCB, 0x84, 0x08, 0x00, 0xAD, 0x6D, 0xC4, 0x06, 0x08, 0xAF, 0x6D, 0xC7,
+    0xA0, 0xC0, 0x82, 0x00, 0x00, 0x0C, 0x38, 0x60, 0x20, 0x30, 0xC3, 0x00, 0x00, 0x10, 0x04, 0x40, 0x10, 0xC2, 0x3C,
+    0x2A, 0x06, 0x20, 0x30, 0x11, 0x10, 0x28, 0x13, 0xDA, 0x4E, 0x96, 0xDA, 0x80, 0x83, 0xA1, 0x00, 0xA4, 0x83, 0x00,
+    0x32, 0x7B, 0x08, 0x95, 0xAE, 0x00, 0x16, 0xA9, 0x00, 0xE0, 0x80, 0x84, 0x8C, 0x82, 0xBB, 0xB1, 0xB4, 0xBA, 0x18,
+    0x83, 0x36, 0xB7, 0x31, 0x98, 0x18, 0x98, 0x83, 0x36, 0xB1, 0xB1, 0x9A, 0x1B, 0x1B, 0x02, 0x33, 0xB8, 0x39, 0x39,
+    0x82, 0x80, 0x85, 0x7F, 0x80, 0x80, 0xAF, 0x03, 0x7F, 0x7F, 0x7D, 0x7D, 0x7F, 0x7F, 0x28, 0x05, 0xFB, 0x32, 0x7B,
+    0x08, 0xC0, 0x00, 0x01, 0xF8, 0x3E, 0x3C, 0xB1, 0xB2, 0x00, 0xC0, 0x30, 0x38, 0x1F, 0xFA, 0x9C, 0x08, 0x3E, 0xA2,
+    0x5F, 0x1C, 0xE1, 0xD0, 0x84};
+
+// SIB2
+static const uint8_t rrc_sib2[] = {0x00, 0x01, 0x49, 0x00, 0x12, 0x50, 0x40, 0x08, 0x00, 0x09, 0x40, 0x00, 0xA0,
+                                   0x3F, 0x01, 0x00, 0x0A, 0x7F, 0xC9, 0x80, 0x01, 0x04, 0x28, 0x6C, 0x00, 0x0C};
+
+// S1AP InitialContextSetupRequest with one E-RAB and a NAS PDU
+static const uint8_t s1ap_init_ctxt_setup_req[] = {
+    0x00, 0x09, 0x00, 0x80, 0xc6, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x02, 0x00, 0x64, 0x00, 0x08, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x42, 0x00, 0x0a, 0x18, 0x3b, 0x9a, 0xca, 0x00, 0x60, 0x3b, 0x9a, 0xca, 0x00, 0x00, 0x18, 0x00, 0x78,
+    0x00, 0x00, 0x34, 0x00, 0x73, 0x45, 0x00, 0x09, 0x3c, 0x0f, 0x80, 0x0a, 0x00, 0x21, 0xf0, 0xb7, 0x36, 0x1c, 0x56,
+    0x64, 0x27, 0x3e, 0x5b, 0x04, 0xb7, 0x02, 0x07, 0x42, 0x02, 0x3e, 0x06, 0x00, 0x09, 0xf1, 0x07, 0x00, 0x07, 0x00,
+    0x37, 0x52, 0x66, 0xc1, 0x01, 0x09, 0x1b, 0x07, 0x74, 0x65, 0x73, 0x74, 0x31, 0x32, 0x33, 0x06, 0x6d, 0x6e, 0x63,
+    0x30, 0x37, 0x30, 0x06, 0x6d, 0x63, 0x63, 0x39, 0x30, 0x31, 0x04, 0x67, 0x70, 0x72, 0x73, 0x05, 0x01, 0xc0, 0xa8,
+    0x03, 0x02, 0x27, 0x0e, 0x80, 0x80, 0x21, 0x0a, 0x03, 0x00, 0x00, 0x0a, 0x81, 0x06, 0x08, 0x08, 0x08, 0x08, 0x50,
+    0x0b, 0xf6, 0x09, 0xf1, 0x07, 0x80, 0x01, 0x01, 0xf6, 0x7e, 0x72, 0x69, 0x13, 0x09, 0xf1, 0x07, 0x00, 0x01, 0x23,
+    0x05, 0xf4, 0xf6, 0x7e, 0x72, 0x69, 0x00, 0x6b, 0x00, 0x05, 0x18, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x49, 0x00, 0x20,
+    0x45, 0x25, 0xe4, 0x9a, 0x77, 0xc8, 0xd5, 0xcf, 0x26, 0x33, 0x63, 0xeb, 0x5b, 0xb9, 0xc3, 0x43, 0x9b, 0x9e, 0xb3,
+    0x86, 0x1f, 0xa8, 0xa7, 0xcf, 0x43, 0x54, 0x07, 0xae, 0x42, 0x2b, 0x63, 0xb9};
+
+// S1AP S1SetupRequest
+static const uint8_t s1ap_s1setup_req[] = {0x00, 0x11, 0x00, 0x2d, 0x00, 0x00, 0x04, 0x00, 0x3b, 0x00, 0x08, 0x00,
+                                           0x09, 0xf1, 0x07, 0x00, 0x00, 0x19, 0xb0, 0x00, 0x3c, 0x40, 0x0a, 0x03,
+                                           0x80, 0x65, 0x6e, 0x62, 0x30, 0x30, 0x31, 0x39, 0x62, 0x00, 0x40, 0x00,
+                                           0x07, 0x00, 0x00, 0x01, 0xc0, 0x09, 0xf1, 0x07, 0x00, 0x89, 0x40, 0x01,
+                                           0x40};
+
+// NGAP PDUSessionResourceSetupRequest with a NAS PDU and the setup request transfer
+static const uint8_t ngap_pdu_session_setup_req[] = {
+    0x00, 0x1d, 0x00, 0x6c, 0x00, 0x00, 0x04, 0x00, 0x0a, 0x00, 0x02, 0x00, 0x01, 0x00, 0x55, 0x00, 0x02, 0x00, 0x01,
+    0x00, 0x26, 0x00, 0x2e, 0x2d, 0x7e, 0x00, 0x68, 0x01, 0x00, 0x25, 0x2e, 0x01, 0x00, 0xc2, 0x11, 0x00, 0x06, 0x01,
+    0x00, 0x03, 0x30, 0x01, 0x01, 0x06, 0x06, 0x03, 0xe8, 0x06, 0x03, 0xe8, 0x29, 0x05, 0x01, 0xc0, 0xa8, 0x0c, 0x7b,
+    0x25, 0x08, 0x07, 0x64, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x12, 0x01, 0x00, 0x4a, 0x00, 0x27, 0x00, 0x00, 0x01,
+    0x00, 0x00, 0x21, 0x00, 0x00, 0x03, 0x00, 0x8b, 0x00, 0x0a, 0x01, 0xf0, 0xc0, 0xa8, 0x11, 0xd2, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x86, 0x00, 0x01, 0x10, 0x00, 0x88, 0x00, 0x07, 0x00, 0x01, 0x00, 0x00, 0x09, 0x00, 0x00};
+
+// NGAP NGSetupResponse
+static const uint8_t ngap_ngsetup_resp[] = {
+    0x20, 0x15, 0x00, 0x5e, 0x00, 0x00, 0x04, 0x00, 0x01, 0x00, 0x3a, 0x1b, 0x80, 0x61, 0x6d, 0x66, 0x31, 0x2e, 0x63,
+    0x6c, 0x75, 0x73, 0x74, 0x65, 0x72, 0x31, 0x2e, 0x6e, 0x65, 0x74, 0x32, 0x2e, 0x61, 0x6d, 0x66, 0x2e, 0x35, 0x67,
+    0x63, 0x2e, 0x6d, 0x6e, 0x63, 0x30, 0x30, 0x31, 0x2e, 0x6d, 0x63, 0x63, 0x30, 0x30, 0x31, 0x2e, 0x33, 0x67, 0x70,
+    0x70, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x2e, 0x6f, 0x72, 0x67, 0x00, 0x60, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0xf1, 0x10, 0x38, 0x08, 0x97, 0x00, 0x56, 0x40, 0x01, 0x05, 0x00, 0x50, 0x00, 0x08, 0x00, 0x00, 0xf1, 0x10, 0x00,
+    0x00, 0x00, 0x08};
+
+/// Decodes and re-encodes "msg" nof_repetitions times, checking that the result matches the original message
+template <typename Msg, size_t N>
+static int run_codec_benchmark(const char* name, const uint8_t (&msg)[N])
+{
+  uint8_t                   buffer[1024];
+  std::chrono::nanoseconds  unpack_time{0}, arena_unpack_time{0}, pack_time{0};
+  std::chrono::steady_clock clock;
+  decode_arena              arena;
+
+  for (uint32_t i = 0; i < nof_repetitions; ++i) {
+    auto t0 = clock.now();
+    {
+      Msg      pdu;
+      cbit_ref cbref(msg, N);
+      TESTASSERT(pdu.unpack(cbref) == SRSASN_SUCCESS);
+    }
+    auto t1 = clock.now();
+    auto t2 = t1, t3 = t1;
+    {
+      Msg pdu;
+      {
+        decode_arena_scope scope(arena);
+        cbit_ref           cbref(msg, N);
+        TESTASSERT(pdu.unpack(cbref) == SRSASN_SUCCESS);
+      }
+      t2 = clock.now();
+
+      bit_ref bref(buffer, sizeof(buffer));
+      TESTASSERT(pdu.pack(bref) == SRSASN_SUCCESS);
+      t3 = clock.now();
+      TESTASSERT(bref.distance_bytes() == (int)N);
+      TESTASSERT(memcmp(buffer, msg, N) == 0);
+    }
+    arena.reset();
+    auto t4 = clock.now();
+
+    unpack_time += t1 - t0;
+    arena_unpack_time += (t2 - t1) + (t4 - t3);
+    pack_time += t3 - t2;
+  }
+
+  double unpack_ns       = (double)unpack_time.count() / nof_repetitions;
+  double arena_unpack_ns = (double)arena_unpack_time.count() / nof_repetitions;
+  double pack_ns         = (double)pack_time.count() / nof_repetitions;
+  printf("| %-36s | %5zu | %12.1f | %12.1f | %12.1f | %13.1f |\n",
+         name,
+         N,
+         unpack_ns,
+         arena_unpack_ns,
+         pack_ns,
+         (double)N * 8 * 1000 / (unpack_ns + pack_ns));
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::init();
+
+  printf("| %-36s | %5s | %12s | %12s | %12s | %13s |\n",
+         "Message",
+         "Bytes",
+         "Unpack [ns]",
+         "Arena [ns]",
+         "Pack [ns]",
+         "Codec [Mbps]");
+  printf("|--------------------------------------|-------|--------------|--------------|--------------|---------------|\n");
+  TESTASSERT(run_codec_benchmark<rrc::dl_dcch_msg_s>("RRC RRCConnectionReconfiguration", rrc_conn_reconf) ==
+             SRSRAN_SUCCESS);
+  TESTASSERT(run_codec_benchmark<rrc::bcch_dl_sch_msg_s>("RRC SIB2", rrc_sib2) == SRSRAN_SUCCESS);
+  TESTASSERT(run_codec_benchmark<s1ap::s1ap_pdu_c>("S1AP InitialContextSetupRequest", s1ap_init_ctxt_setup_req) ==
+             SRSRAN_SUCCESS);
+  TESTASSERT(run_codec_benchmark<s1ap::s1ap_pdu_c>("S1AP S1SetupRequest", s1ap_s1setup_req) == SRSRAN_SUCCESS);
+  TESTASSERT(run_codec_benchmark<ngap_nr::ngap_pdu_c>("NGAP PDUSessionResourceSetupRequest",
+                                                   ngap_pdu_session_setup_req) == SRSRAN_SUCCESS);
+  TESTASSERT(run_codec_benchmark<ngap_nr::ngap_pdu_c>("NGAP NGSetupResponse", ngap_ngsetup_resp) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  return SRSRAN_SUCCESS;
+}
@@ -195,6 +195,86 @@ int test_bit_ref()
   return 0;
 }
 
+/// Compares word-based bit packing/unpacking against a bit-by-bit reference, for random field sizes and offsets
+int test_bit_ref_random()
+{
+  std::uniform_int_distribution<uint32_t> nbits_dist(1, 64), nbytes_dist(0, 20), type_dist(0, 3);
+  std::uniform_int_distribution<uint64_t> val_dist;
+
+  for (uint32_t run = 0; run < 100; ++run) {
+    std::vector<bool>     ref_bits;
+    std::vector<uint64_t> vals;
+    std::vector<uint32_t> sizes;
+    std::vector<bool>     is_bytes;
+    uint8_t               bytes[20];
+    for (uint32_t i = 0; i < 50; ++i) {
+      // pack fields or unaligned octet strings
+      bool     oct  = type_dist(g) == 0;
+      uint32_t n    = oct ? nbytes_dist(g) : nbits_dist(g);
+      uint64_t val  = val_dist(g);
+      uint32_t nbit = oct ? 8 * n : n;
+      for (uint32_t j = 0; j < nbit; ++j) {
+        ref_bits.push_back(oct ? ((i + j / 8) >> (7 - j % 8)) & 1u : (val >> (nbit - 1 - j)) & 1u);
+      }
+      vals.push_back(val);
+      sizes.push_back(n);
+      is_bytes.push_back(oct);
+    }
+    std::vector<uint8_t> ref_buf((ref_bits.size() + 7) / 8, 0);
+    for (uint32_t j = 0; j < ref_bits.size(); ++j) {
+      ref_buf[j / 8] |= ref_bits[j] << (7 - j % 8);
+    }
+
+    // pack_bytes/unpack_bytes require one extra byte. The bytes past the buffer end must not be touched
+    std::vector<uint8_t> buf(ref_buf.size() + 9, 0xa5);
+    uint32_t             buf_len = ref_buf.size() + 1;
+    bit_ref              bref(buf.data(), buf_len);
+    for (uint32_t i = 0; i < vals.size(); ++i) {
+      if (is_bytes[i]) {
+        for (uint32_t j = 0; j < sizes[i]; ++j) {
+          bytes[j] = i + j;
+        }
+        TESTASSERT(bref.pack_bytes(bytes, sizes[i]) == SRSASN_SUCCESS);
+      } else {
+        TESTASSERT(bref.pack(vals[i], sizes[i]) == SRSASN_SUCCESS);
+      }
+    }
+    TESTASSERT(bref.distance() == (int)ref_bits.size());
+    TESTASSERT(std::equal(ref_buf.begin(), ref_buf.end(), buf.begin()));
+    TESTASSERT(std::all_of(buf.begin() + ref_buf.size(), buf.end(), [](uint8_t b) { return b == 0xa5; }));
+    uint32_t remaining_bits = 8 * buf_len - ref_bits.size();
+    TESTASSERT(bref.pack(0, remaining_bits + 1) == SRSASN_ERROR_ENCODE_FAIL);
+
+    cbit_ref cbref(buf.data(), buf_len);
+    for (uint32_t i = 0; i < vals.size(); ++i) {
+      if (is_bytes[i]) {
+        uint8_t bytes2[20];
+        TESTASSERT(cbref.unpack_bytes(bytes2, sizes[i]) == SRSASN_SUCCESS);
+        for (uint32_t j = 0; j < sizes[i]; ++j) {
+          TESTASSERT(bytes2[j] == (uint8_t)(i + j));
+        }
+      } else {
+        uint64_t val;
+        TESTASSERT(cbref.unpack(val, sizes[i]) == SRSASN_SUCCESS);
+        TESTASSERT(val == (vals[i] & (std::numeric_limits<uint64_t>::max() >> (64 - sizes[i]))));
+      }
+    }
+    TESTASSERT(cbref.distance() == (int)ref_bits.size());
+    uint64_t val;
+    cbit_ref cbref2 = cbref;
+    TESTASSERT(cbref.unpack(val, remaining_bits + 1) == SRSASN_ERROR_DECODE_FAIL);
+    TESTASSERT(cbref2.unpack(val, remaining_bits) == SRSASN_SUCCESS);
+    TESTASSERT(val == 0xa5);
+  }
+
+  // Discard the errors logged by the out-of-bounds checks
+  srslog::flush();
+  TESTASSERT(test_spy->get_error_counter() == 200);
+  test_spy->reset_counters();
+
+  return 0;
+}
+
 int test_oct_string()
 {
   uint8_t  buf[1024];
@@ -480,6 +560,68 @@ int test_seq_of()
   return 0;
 }
 
+int test_decode_arena()
+{
+  using octstring_list = dyn_seq_of<dyn_octstring, 0, 16>;
+
+  uint8_t        buffer[1024];
+  octstring_list orig_list;
+  orig_list.resize(10);
+  for (uint32_t i = 0; i < orig_list.size(); ++i) {
+    orig_list[i].resize(i * 3 + 1);
+    std::fill(orig_list[i].data(), orig_list[i].data() + orig_list[i].size(), (uint8_t)i);
+  }
+  bit_ref bref(buffer, sizeof(buffer));
+  TESTASSERT(orig_list.pack(bref) == SRSASN_SUCCESS);
+  int nof_bytes = bref.distance_bytes();
+
+  decode_arena arena(256);
+  size_t       nof_blocks = 0;
+  TESTASSERT(get_current_decode_arena() == nullptr);
+  for (uint32_t run = 0; run < 3; ++run) {
+    {
+      octstring_list list;
+      {
+        decode_arena_scope scope(arena);
+        TESTASSERT(get_current_decode_arena() == &arena);
+        cbit_ref cbref(buffer, nof_bytes);
+        TESTASSERT(list.unpack(cbref) == SRSASN_SUCCESS);
+      }
+      TESTASSERT(get_current_decode_arena() == nullptr);
+      TESTASSERT(list == orig_list);
+      TESTASSERT(arena.nof_bytes_allocated() >= sizeof(dyn_octstring) * list.size());
+
+      // Arrays that grow outside of the scope move to the heap
+      list[0].resize(100);
+      list.push_back(orig_list[1]);
+      TESTASSERT(list.size() == orig_list.size() + 1);
+      TESTASSERT(list.back() == orig_list[1]);
+    }
+    // The blocks of the first run are reused in the next ones
+    if (run == 0) {
+      nof_blocks = arena.nof_blocks();
+      TESTASSERT(nof_blocks > 1);
+    }
+    TESTASSERT(arena.nof_blocks() == nof_blocks);
+    arena.reset();
+    TESTASSERT(arena.nof_bytes_allocated() == 0);
+  }
+
+  // Nested scopes
+  decode_arena arena2;
+  {
+    decode_arena_scope scope(arena);
+    {
+      decode_arena_scope scope2(arena2);
+      TESTASSERT(get_current_decode_arena() == &arena2);
+    }
+    TESTASSERT(get_current_decode_arena() == &arena);
+  }
+  TESTASSERT(get_current_decode_arena() == nullptr);
+
+  return 0;
+}
+
 int test_copy_ptr()
 {
   typedef fixed_octstring<10> TestType;
@@ -675,9 +817,11 @@ int main()
 
   TESTASSERT(test_arrays() == 0);
   TESTASSERT(test_bit_ref() == 0);
+  TESTASSERT(test_bit_ref_random() == 0);
   TESTASSERT(test_oct_string() == 0);
   TESTASSERT(test_bitstring() == 0);
   TESTASSERT(test_seq_of() == 0);
+  TESTASSERT(test_decode_arena() == 0);
   TESTASSERT(test_copy_ptr() == 0);
   TESTASSERT(test_enum() == 0);
   TESTASSERT(test_big_integers() == 0);
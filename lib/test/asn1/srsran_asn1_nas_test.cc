@@ -19,6 +19,7 @@
  *
  */
 
+#include "srsran/asn1/liblte_byte_buffer.h"
 #include "srsran/asn1/liblte_mme.h"
 #include "srsran/srslog/srslog.h"
 #include <iostream>
@@ -59,12 +60,12 @@ int nas_dedicated_eps_bearer_context_setup_request_test()
 
   // Test message type and protocol discriminator
   uint8_t pd, msg_type;
-  liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)tst_msg.get(), &pd, &msg_type);
+  liblte_mme_parse_msg_header(srsran::liblte_byte_msg_adapter(tst_msg.get()), &pd, &msg_type);
   TESTASSERT(msg_type == LIBLTE_MME_MSG_TYPE_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST);
 
   // Unpack message
-  err = liblte_mme_unpack_activate_dedicated_eps_bearer_context_request_msg((LIBLTE_BYTE_MSG_STRUCT*)tst_msg.get(),
-                                                                            &ded_bearer_req);
+  err = liblte_mme_unpack_activate_dedicated_eps_bearer_context_request_msg(
+      srsran::liblte_byte_msg_adapter(tst_msg.get()), &ded_bearer_req);
   TESTASSERT(err == LIBLTE_SUCCESS);
 
   // Check EPS bearer identity
@@ -115,6 +116,37 @@ int nas_dedicated_eps_bearer_context_setup_request_test()
   return 0;
 }
 
+int nas_byte_buffer_pack_unpack_test()
+{
+  srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+  TESTASSERT(buf != nullptr);
+  uint8_t* msg = buf->msg;
+
+  LIBLTE_MME_ID_RESPONSE_MSG_STRUCT id_resp = {};
+  id_resp.mobile_id.type_of_id              = LIBLTE_MME_MOBILE_ID_TYPE_IMSI;
+  for (uint32_t i = 0; i < 15; ++i) {
+    id_resp.mobile_id.imsi[i] = i % 10;
+  }
+  TESTASSERT(liblte_mme_pack_identity_response_msg(&id_resp,
+                                                   LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS,
+                                                   0,
+                                                   srsran::liblte_byte_msg_adapter(buf.get())) == LIBLTE_SUCCESS);
+
+  // The byte buffer keeps its own members, and gets the packed message
+  TESTASSERT(buf->msg == msg);
+  TESTASSERT(buf->N_bytes > 0);
+  TESTASSERT(buf->get_tailroom() > 0);
+
+  LIBLTE_MME_ID_RESPONSE_MSG_STRUCT id_resp_out = {};
+  TESTASSERT(liblte_mme_unpack_identity_response_msg(srsran::liblte_byte_msg_adapter(buf.get()), &id_resp_out) ==
+             LIBLTE_SUCCESS);
+  TESTASSERT(id_resp_out.mobile_id.type_of_id == LIBLTE_MME_MOBILE_ID_TYPE_IMSI);
+  TESTASSERT(memcmp(id_resp_out.mobile_id.imsi, id_resp.mobile_id.imsi, 15) == 0);
+
+  printf("Test NAS pack/unpack with byte buffers successfull\n");
+  return 0;
+}
+
 int main(int argc, char** argv)
 {
   auto& asn1_logger = srslog::fetch_basic_logger("ASN1", false);
@@ -124,6 +156,9 @@ int main(int argc, char** argv)
   srslog::init();
 
   int result = nas_dedicated_eps_bearer_context_setup_request_test();
+  if (result == 0) {
+    result = nas_byte_buffer_pack_unpack_test();
+  }
 
   return result;
 }
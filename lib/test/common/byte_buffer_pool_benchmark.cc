@@ -0,0 +1,201 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+
+#include <atomic>
+#include <chrono>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+/*
+ * Measures the byte buffer pool allocation rate under contention. In the "local" test each thread allocates and
+ * releases bursts of buffers on its own. In the "producer/consumer" test, buffers are allocated by producer threads
+ * and released by consumer threads, as it happens between the PHY/stack/GTP-U threads, which forces the blocks to
+ * travel through the central cache of the pool.
+ */
+
+static uint32_t nof_buffers_per_thread = 1000000;
+static uint32_t max_nof_threads        = 16;
+
+static const uint32_t burst_size = 32;
+
+static void usage(const char* prog)
+{
+  printf("Usage: %s [nt]\n", prog);
+  printf("\t-n Number of buffers allocated per thread [Default %d]\n", nof_buffers_per_thread);
+  printf("\t-t Maximum number of threads [Default %d]\n", max_nof_threads);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:t:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_buffers_per_thread = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 't':
+        max_nof_threads = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/// Single producer, single consumer ring of buffers
+class buffer_ring
+{
+public:
+  bool try_push(srsran::unique_byte_buffer_t& buf)
+  {
+    uint32_t w = wpos.load(std::memory_order_relaxed);
+    if (w - rpos.load(std::memory_order_acquire) == ring_size) {
+      return false;
+    }
+    ring[w % ring_size] = buf.release();
+    wpos.store(w + 1, std::memory_order_release);
+    return true;
+  }
+  srsran::unique_byte_buffer_t try_pop()
+  {
+    uint32_t r = rpos.load(std::memory_order_relaxed);
+    if (r == wpos.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    srsran::unique_byte_buffer_t buf(ring[r % ring_size]);
+    rpos.store(r + 1, std::memory_order_release);
+    return buf;
+  }
+
+private:
+  static const uint32_t  ring_size = 64;
+  srsran::byte_buffer_t* ring[ring_size];
+  alignas(64) std::atomic<uint32_t> wpos{0};
+  alignas(64) std::atomic<uint32_t> rpos{0};
+};
+
+static srsran::unique_byte_buffer_t alloc_buffer(uint32_t capacity)
+{
+  srsran::unique_byte_buffer_t buf;
+  while ((buf = srsran::make_byte_buffer(capacity)) == nullptr) {
+    // wait until the pool is not depleted
+    std::this_thread::yield();
+  }
+  buf->N_bytes = capacity;
+  return buf;
+}
+
+static void run_local(uint32_t capacity)
+{
+  std::vector<srsran::unique_byte_buffer_t> burst(burst_size);
+  for (uint32_t i = 0; i < nof_buffers_per_thread; i += burst_size) {
+    for (srsran::unique_byte_buffer_t& b : burst) {
+      b = alloc_buffer(capacity);
+    }
+    for (srsran::unique_byte_buffer_t& b : burst) {
+      b.reset();
+    }
+  }
+}
+
+static void run_producer(buffer_ring& ring, uint32_t capacity)
+{
+  for (uint32_t i = 0; i < nof_buffers_per_thread; ++i) {
+    srsran::unique_byte_buffer_t buf = alloc_buffer(capacity);
+    while (not ring.try_push(buf)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+static void run_consumer(buffer_ring& ring)
+{
+  for (uint32_t i = 0; i < nof_buffers_per_thread;) {
+    srsran::unique_byte_buffer_t buf = ring.try_pop();
+    if (buf == nullptr) {
+      std::this_thread::yield();
+      continue;
+    }
+    i++;
+  }
+}
+
+/// Returns the number of allocations per second, in millions
+static double run_test(uint32_t nof_threads, bool producer_consumer, uint32_t capacity)
+{
+  std::vector<std::thread> threads;
+  std::vector<buffer_ring> rings(nof_threads);
+  auto                     t_start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_threads; ++i) {
+    if (producer_consumer) {
+      threads.emplace_back(run_producer, std::ref(rings[i]), capacity);
+      threads.emplace_back(run_consumer, std::ref(rings[i]));
+    } else {
+      threads.emplace_back(run_local, capacity);
+    }
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  auto t_end = std::chrono::steady_clock::now();
+
+  double elapsed_us = std::chrono::duration<double, std::micro>(t_end - t_start).count();
+  return (double)nof_buffers_per_thread * nof_threads / elapsed_us;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  const uint32_t mtu_payload = srsran::byte_buffer_payload_size(srsran::byte_buffer_size_class::mtu);
+  const uint32_t max_payload = srsran::byte_buffer_payload_size(srsran::byte_buffer_size_class::jumbo);
+
+  // Instantiate the pools before the measurements
+  srsran::get_byte_buffer_pool_metrics();
+
+  printf("%-8s %-18s %12s %12s\n", "threads", "test", "MTU Malloc/s", "max Malloc/s");
+  for (uint32_t nof_threads = 1; nof_threads <= max_nof_threads; nof_threads *= 2) {
+    printf("%-8d %-18s %12.2f %12.2f\n",
+           nof_threads,
+           "local",
+           run_test(nof_threads, false, mtu_payload),
+           run_test(nof_threads, false, max_payload));
+    printf("%-8d %-18s %12.2f %12.2f\n",
+           nof_threads,
+           "producer/consumer",
+           run_test(nof_threads, true, mtu_payload),
+           run_test(nof_threads, true, max_payload));
+  }
+
+  // All the buffers must have been returned to the pool
+  srsran::byte_buffer_pool_metrics_t metrics = srsran::get_byte_buffer_pool_metrics();
+  for (const auto& size_class : metrics.size_classes) {
+    TESTASSERT(size_class.nof_allocated == 0);
+  }
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,122 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+#include <vector>
+
+using namespace srsran;
+
+uint32_t nof_allocated(byte_buffer_size_class size_class)
+{
+  return get_byte_buffer_pool_metrics().size_classes[(uint32_t)size_class].nof_allocated;
+}
+
+int test_size_class_selection()
+{
+  const uint32_t small_payload = byte_buffer_payload_size(byte_buffer_size_class::small);
+  const uint32_t mtu_payload   = byte_buffer_payload_size(byte_buffer_size_class::mtu);
+  const uint32_t max_payload   = byte_buffer_payload_size(byte_buffer_size_class::jumbo);
+
+  unique_byte_buffer_t small = make_byte_buffer(100);
+  TESTASSERT(small != nullptr);
+  TESTASSERT(small->get_headroom() == SRSRAN_BUFFER_HEADER_OFFSET);
+  TESTASSERT(small->get_tailroom() == small_payload);
+  TESTASSERT(nof_allocated(byte_buffer_size_class::small) == 1);
+
+  unique_byte_buffer_t mtu = make_byte_buffer(1500);
+  TESTASSERT(mtu != nullptr);
+  TESTASSERT(mtu->get_tailroom() == mtu_payload);
+  TESTASSERT(nof_allocated(byte_buffer_size_class::mtu) == 1);
+
+  unique_byte_buffer_t jumbo = make_byte_buffer(mtu_payload + 1);
+  TESTASSERT(jumbo != nullptr);
+  TESTASSERT(jumbo->get_tailroom() == max_payload);
+  TESTASSERT(nof_allocated(byte_buffer_size_class::jumbo) == 1);
+
+  // Buffers without a requested capacity keep the maximum size
+  unique_byte_buffer_t dflt = make_byte_buffer();
+  TESTASSERT(dflt != nullptr);
+  TESTASSERT(dflt->get_buffer_size() == SRSRAN_MAX_BUFFER_SIZE_BYTES);
+  TESTASSERT(nof_allocated(byte_buffer_size_class::jumbo) == 2);
+
+  TESTASSERT(make_byte_buffer(max_payload + 1) == nullptr);
+
+  // Contents can be moved between size classes
+  small->N_bytes = small_payload;
+  std::fill(small->begin(), small->end(), 0xab);
+  *jumbo = *small;
+  TESTASSERT(jumbo->N_bytes == small_payload);
+  TESTASSERT(std::all_of(jumbo->begin(), jumbo->end(), [](uint8_t b) { return b == 0xab; }));
+  TESTASSERT(jumbo->get_tailroom() == max_payload - small_payload);
+  small->clear();
+  TESTASSERT(small->get_tailroom() == small_payload);
+
+  // Buffers are returned to the pool of their own size class
+  small.reset();
+  mtu.reset();
+  jumbo.reset();
+  dflt.reset();
+  for (uint32_t i = 0; i < nof_byte_buffer_size_classes; ++i) {
+    TESTASSERT(nof_allocated((byte_buffer_size_class)i) == 0);
+  }
+
+  // The allocations since startup are still counted
+  byte_buffer_pool_metrics_t metrics = get_byte_buffer_pool_metrics();
+  TESTASSERT(metrics.size_classes[(uint32_t)byte_buffer_size_class::small].nof_allocations == 1);
+  TESTASSERT(metrics.size_classes[(uint32_t)byte_buffer_size_class::mtu].nof_allocations == 1);
+  TESTASSERT(metrics.size_classes[(uint32_t)byte_buffer_size_class::jumbo].nof_allocations == 2);
+  return SRSRAN_SUCCESS;
+}
+
+int test_size_class_fallback()
+{
+  uint32_t nof_small_buffers =
+      get_byte_buffer_pool_metrics().size_classes[(uint32_t)byte_buffer_size_class::small].nof_buffers;
+
+  // Deplete the small size class
+  std::vector<unique_byte_buffer_t> small_bufs;
+  for (uint32_t i = 0; i < nof_small_buffers; ++i) {
+    small_bufs.push_back(make_byte_buffer(1));
+    TESTASSERT(small_bufs.back() != nullptr);
+  }
+  TESTASSERT(nof_allocated(byte_buffer_size_class::small) == nof_small_buffers);
+
+  // The next small allocation is served by the MTU size class
+  unique_byte_buffer_t buf = make_byte_buffer(1);
+  TESTASSERT(buf != nullptr);
+  TESTASSERT(buf->get_tailroom() == byte_buffer_payload_size(byte_buffer_size_class::mtu));
+  TESTASSERT(nof_allocated(byte_buffer_size_class::mtu) == 1);
+
+  buf.reset();
+  small_bufs.clear();
+  TESTASSERT(nof_allocated(byte_buffer_size_class::small) == 0);
+  TESTASSERT(nof_allocated(byte_buffer_size_class::mtu) == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_size_class_selection() == SRSRAN_SUCCESS);
+  TESTASSERT(test_size_class_fallback() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -124,6 +124,73 @@ int test_socket_handler()
   return 0;
 }
 
+int test_udp_batch_handler()
+{
+  auto& logger = srslog::fetch_basic_logger("S1AP", false);
+
+  srsran::socket_manager sockhandler;
+  srsran::unique_socket  server_socket, server_socket2, client_socket;
+  using namespace srsran::net_utils;
+
+  TESTASSERT(server_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(server_socket.bind_addr("127.0.0.1", 0));
+  TESTASSERT(server_socket2.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(server_socket2.bind_addr("127.0.0.1", 0));
+  TESTASSERT(client_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+
+  sockaddr_in server_addrin = {}, server_addrin2 = {};
+  socklen_t   socklen       = sizeof(sockaddr_in);
+  TESTASSERT(getsockname(server_socket.fd(), (struct sockaddr*)&server_addrin, &socklen) == 0);
+  socklen = sizeof(sockaddr_in);
+  TESTASSERT(getsockname(server_socket2.fd(), (struct sockaddr*)&server_addrin2, &socklen) == 0);
+
+  // The first socket is drained in batches with edge-triggered notification, the second one pdu by pdu
+  std::atomic<int> counter = {0}, counter2 = {0};
+  std::atomic<int> seq_errors   = {0};
+  int              expected_seq = 0;
+  auto pdu_handler = [&counter, &seq_errors, &expected_seq](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
+    if (pdu->N_bytes != sizeof(int) or memcmp(pdu->msg, &expected_seq, sizeof(int)) != 0) {
+      seq_errors++;
+    }
+    expected_seq++;
+    counter++;
+  };
+  auto pdu_handler2 = [&counter2](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) { counter2++; };
+
+  rx_thread_tester rx_tester;
+  TESTASSERT(sockhandler.add_socket_handler_edge_triggered(
+      server_socket.fd(), srsran::make_sdu_batch_handler(logger, rx_tester.task_queue, pdu_handler)));
+  TESTASSERT(sockhandler.add_socket_handler(server_socket2.fd(),
+                                            srsran::make_sdu_handler(logger, rx_tester.task_queue, pdu_handler2)));
+
+  // Send bursts larger than a recvmmsg batch
+  const int nof_pdus = 200;
+  for (int i = 0; i < nof_pdus; ++i) {
+    ssize_t n_sent = sendto(client_socket.fd(), &i, sizeof(i), 0, (struct sockaddr*)&server_addrin, socklen);
+    TESTASSERT(n_sent == sizeof(i));
+    n_sent = sendto(client_socket.fd(), &i, sizeof(i), 0, (struct sockaddr*)&server_addrin2, socklen);
+    TESTASSERT(n_sent == sizeof(i));
+    if (i % 50 == 49) {
+      usleep(1000);
+    }
+  }
+
+  uint32_t time_elapsed = 0;
+  while (counter != nof_pdus or counter2 != nof_pdus) {
+    usleep(100);
+    time_elapsed += 100;
+    if (time_elapsed > 3000000) {
+      logger.error("Received %d and %d out of %d PDUs", counter.load(), counter2.load(), nof_pdus);
+      return -1;
+    }
+  }
+  TESTASSERT(seq_errors == 0);
+
+  TESTASSERT(sockhandler.remove_socket(server_socket.fd()));
+  TESTASSERT(sockhandler.remove_socket(server_socket2.fd()));
+  return 0;
+}
+
 int test_sctp_bind_error()
 {
   srsran::unique_socket sock;
@@ -146,6 +213,7 @@ int main()
 
   TESTASSERT(test_socket_handler() == 0);
   TESTASSERT(test_sctp_bind_error() == 0);
+  TESTASSERT(test_udp_batch_handler() == 0);
 
   return 0;
 }
@@ -0,0 +1,114 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+
+#include <chrono>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+/*
+ * Compares the throughput of EEA2/EIA2 when the AES key is expanded for every message (as the byte key API does)
+ * against the pre-expanded key API used by PDCP, for small and full-size SDUs.
+ */
+
+static uint32_t nof_repetitions = 100000;
+
+static void usage(const char* prog)
+{
+  printf("Usage: %s [n]\n", prog);
+  printf("\t-n Number of messages per test [Default %d]\n", nof_repetitions);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+template <typename F>
+static double measure_mbps(uint32_t sdu_len, F&& f)
+{
+  auto t_start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_repetitions; i++) {
+    f(i);
+  }
+  auto t_end = std::chrono::steady_clock::now();
+
+  double elapsed_us = std::chrono::duration<double, std::micro>(t_end - t_start).count();
+  return (double)sdu_len * 8 * nof_repetitions / elapsed_us;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  uint8_t key[16];
+  for (uint32_t i = 0; i < sizeof(key); i++) {
+    key[i] = rand() & 0xff;
+  }
+  srsran::security_aes128_key_t aes_key;
+  aes_key.set(key);
+
+  uint8_t  bearer    = 3;
+  uint8_t  direction = srsran::SECURITY_DIRECTION_UPLINK;
+  uint8_t  mac[4];
+  uint32_t sdu_sizes[] = {40, 100, 1500};
+
+  printf("%8s  %16s  %16s  %16s  %16s\n", "SDU (B)", "EEA2 (Mbps)", "EEA2 key (Mbps)", "EIA2 (Mbps)", "EIA2 key (Mbps)");
+
+  for (uint32_t sdu_len : sdu_sizes) {
+    std::vector<uint8_t> sdu(sdu_len);
+    std::vector<uint8_t> out(sdu_len);
+    for (uint8_t& b : sdu) {
+      b = rand() & 0xff;
+    }
+
+    double eea2 = measure_mbps(sdu_len, [&](uint32_t count) {
+      srsran::security_128_eea2(key, count, bearer, direction, sdu.data(), sdu_len, out.data());
+    });
+    double eea2_key = measure_mbps(sdu_len, [&](uint32_t count) {
+      srsran::security_128_eea2(aes_key, count, bearer, direction, sdu.data(), sdu_len, sdu.data());
+    });
+    double eia2 = measure_mbps(sdu_len, [&](uint32_t count) {
+      srsran::security_128_eia2(key, count, bearer, direction, sdu.data(), sdu_len, mac);
+    });
+    double eia2_key = measure_mbps(sdu_len, [&](uint32_t count) {
+      srsran::security_128_eia2(aes_key, count, bearer, direction, sdu.data(), sdu_len, mac);
+    });
+
+    printf("%8d  %16.1f  %16.1f  %16.1f  %16.1f\n", sdu_len, eea2, eea2_key, eia2, eia2_key);
+  }
+
+  return SRSRAN_SUCCESS;
+}
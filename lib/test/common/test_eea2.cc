@@ -24,6 +24,7 @@
 #include <stdlib.h>
 
 #include "srsran/common/liblte_security.h"
+#include "srsran/common/security.h"
 #include "srsran/common/test_common.h"
 #include "srsran/srsran.h"
 
@@ -455,6 +456,44 @@ int test_set_1_invalid()
   return SRSRAN_SUCCESS;
 }
 
+// Compares the in-place pre-expanded key implementation against the reference one for every byte length up to a full
+// SDU
+int test_pre_expanded_key()
+{
+  uint8_t key[16];
+  uint8_t msg[1600];
+  uint8_t ct[1600];
+  uint8_t ct_ref[1600];
+  for (uint32_t i = 0; i < sizeof(key); i++) {
+    key[i] = rand() & 0xff;
+  }
+  for (uint32_t i = 0; i < sizeof(msg); i++) {
+    msg[i] = rand() & 0xff;
+  }
+
+  srsran::security_aes128_key_t aes_key;
+  aes_key.set(key);
+
+  for (uint32_t len = 0; len <= sizeof(msg); len++) {
+    uint32_t count     = rand();
+    uint8_t  bearer    = rand() & 0x1f;
+    uint8_t  direction = rand() & 0x01;
+
+    srsran::security_128_eea2(key, count, bearer, direction, msg, len, ct_ref);
+
+    // In place
+    memcpy(ct, msg, len);
+    TESTASSERT(srsran::security_128_eea2(aes_key, count, bearer, direction, ct, len, ct) == LIBLTE_SUCCESS);
+    TESTASSERT(arrcmp(ct, ct_ref, len) == 0);
+
+    // Decryption
+    TESTASSERT(srsran::security_128_eea2(aes_key, count, bearer, direction, ct, len, ct) == LIBLTE_SUCCESS);
+    TESTASSERT(arrcmp(ct, msg, len) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 /*
  * Functions
  */
@@ -469,4 +508,5 @@ int main(int argc, char* argv[])
   TESTASSERT(test_set_6() == SRSRAN_SUCCESS);
   TESTASSERT(test_set_1_block_size() == SRSRAN_SUCCESS);
   TESTASSERT(test_set_1_invalid() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pre_expanded_key() == SRSRAN_SUCCESS);
 }
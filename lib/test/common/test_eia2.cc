@@ -0,0 +1,105 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "srsran/common/liblte_security.h"
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include "srsran/srsran.h"
+
+/*
+ * Tests
+ *
+ * Document Reference: 33.401 V13.1.0 Annex C.2
+ */
+
+int test_set_1()
+{
+  uint8_t  key[]     = {0xd3, 0xc5, 0xd5, 0x92, 0x32, 0x7f, 0xb1, 0x1c, 0x40, 0x35, 0xc6, 0x68, 0x0a, 0xf8, 0xc6, 0xd1};
+  uint32_t count     = 0x398a59b4;
+  uint8_t  bearer    = 0x1a;
+  uint8_t  direction = 1;
+  uint32_t len_bits = 64, len_bytes = (len_bits + 7) / 8;
+  uint8_t  msg[] = {0x48, 0x45, 0x83, 0xd5, 0xaf, 0xe0, 0x82, 0xae};
+  uint8_t  mt[]  = {0xb9, 0x37, 0x87, 0xe6};
+
+  uint8_t mac[4];
+
+  // gen mac
+  srsran::security_128_eia2(key, count, bearer, direction, msg, len_bytes, mac);
+  for (int i = 0; i < 4; i++) {
+    TESTASSERT(mac[i] == mt[i]);
+  }
+
+  // gen mac with the pre-expanded key
+  srsran::security_aes128_key_t aes_key;
+  aes_key.set(key);
+  TESTASSERT(srsran::security_128_eia2(aes_key, count, bearer, direction, msg, len_bytes, mac) == LIBLTE_SUCCESS);
+  for (int i = 0; i < 4; i++) {
+    TESTASSERT(mac[i] == mt[i]);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// Compares the pre-expanded key implementation against the reference one for every byte length up to a full SDU
+int test_pre_expanded_key()
+{
+  uint8_t key[16];
+  uint8_t msg[1600];
+  for (uint32_t i = 0; i < sizeof(key); i++) {
+    key[i] = rand() & 0xff;
+  }
+  for (uint32_t i = 0; i < sizeof(msg); i++) {
+    msg[i] = rand() & 0xff;
+  }
+
+  srsran::security_aes128_key_t aes_key;
+  aes_key.set(key);
+
+  for (uint32_t len = 0; len <= sizeof(msg); len++) {
+    uint32_t count     = rand();
+    uint8_t  bearer    = rand() & 0x1f;
+    uint8_t  direction = rand() & 0x01;
+    uint8_t  mac_ref[4];
+    uint8_t  mac[4];
+
+    srsran::security_128_eia2(key, count, bearer, direction, msg, len, mac_ref);
+    TESTASSERT(srsran::security_128_eia2(aes_key, count, bearer, direction, msg, len, mac) == LIBLTE_SUCCESS);
+    for (int i = 0; i < 4; i++) {
+      TESTASSERT(mac[i] == mac_ref[i]);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * Functions
+ */
+
+int main(int argc, char* argv[])
+{
+  TESTASSERT(test_set_1() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pre_expanded_key() == SRSRAN_SUCCESS);
+}
@@ -387,6 +387,65 @@ int segment_test(bool in_seq_rx)
   return SRSRAN_SUCCESS;
 }
 
+// An SDU starting at the end of a near-maximum PDU and continuing in the next one must not be limited by the tailroom
+// left in the buffer of the first PDU
+int large_sdu_test()
+{
+  rlc_am_tester         tester;
+  srsran::timer_handler timers(8);
+
+  rlc_am_lte rlc1(srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am_lte rlc2(srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+
+  if (not rlc1.configure(rlc_config_t::default_rlc_am_config())) {
+    return -1;
+  }
+
+  if (not rlc2.configure(rlc_config_t::default_rlc_am_config())) {
+    return -1;
+  }
+
+  // Push a small SDU followed by a large one into RLC1
+  const uint32_t       sdu_len[] = {1000, 12000};
+  unique_byte_buffer_t sdu_bufs[2];
+  for (uint32_t i = 0; i < 2; i++) {
+    sdu_bufs[i] = srsran::make_byte_buffer();
+    TESTASSERT(sdu_bufs[i] != nullptr);
+    for (uint32_t j = 0; j < sdu_len[i]; j++) {
+      sdu_bufs[i]->msg[j] = j + i;
+    }
+    sdu_bufs[i]->N_bytes    = sdu_len[i];
+    sdu_bufs[i]->md.pdcp_sn = i;
+    rlc1.write_sdu(std::move(sdu_bufs[i]));
+  }
+
+  // The first PDU carries the small SDU and most of the large one, the second PDU the rest of the large SDU
+  unique_byte_buffer_t pdu_bufs[2];
+  const uint32_t       pdu_len[] = {12000, 2000};
+  for (uint32_t i = 0; i < 2; i++) {
+    pdu_bufs[i] = srsran::make_byte_buffer();
+    TESTASSERT(pdu_bufs[i] != nullptr);
+    pdu_bufs[i]->N_bytes = rlc1.read_pdu(pdu_bufs[i]->msg, pdu_len[i]);
+  }
+  TESTASSERT(pdu_bufs[0]->N_bytes == pdu_len[0]);
+  TESTASSERT(0 == rlc1.get_buffer_state());
+
+  // Write PDUs into RLC2
+  for (uint32_t i = 0; i < 2; i++) {
+    rlc2.write_pdu(pdu_bufs[i]->msg, pdu_bufs[i]->N_bytes);
+  }
+
+  TESTASSERT(tester.sdus.size() == 2);
+  for (uint32_t i = 0; i < tester.sdus.size(); i++) {
+    TESTASSERT(tester.sdus[i]->N_bytes == sdu_len[i]);
+    for (uint32_t j = 0; j < sdu_len[i]; j++) {
+      TESTASSERT(tester.sdus[i]->msg[j] == (uint8_t)(j + i));
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int retx_test()
 {
   rlc_am_tester tester;
@@ -3723,6 +3782,11 @@ int main(int argc, char** argv)
     exit(-1);
   };
 
+  if (large_sdu_test()) {
+    printf("large_sdu_test failed\n");
+    exit(-1);
+  };
+
   if (retx_test()) {
     printf("retx_test failed\n");
     exit(-1);
@@ -31,6 +31,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
+#include <new>
 #include <pthread.h>
 #include <random>
 
@@ -62,6 +63,31 @@ int write_pdu_to_pcap(const bool is_dl, const uint32_t lcid, const uint8_t* payl
   return SRSRAN_ERROR;
 }
 
+/// Heap allocations of the whole test, reported per received SDU in benchmark mode
+static std::atomic<uint64_t> nof_heap_allocations = {0};
+
+void* operator new(std::size_t sz)
+{
+  nof_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(sz);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+// Not inlined, so that the compiler does not flag the free() of memory returned by operator new
+[[gnu::noinline]] void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+// Sized deallocation, called by the libraries built for newer C++ standards
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t sz) noexcept
+{
+  std::free(ptr);
+}
+
 using namespace std;
 using namespace srsue;
 using namespace srsran;
@@ -88,6 +114,7 @@ typedef struct {
   bool        zero_seed;
   uint32_t    nof_pdu_tti;
   uint32_t    max_retx;
+  bool        benchmark;
 } stress_test_args_t;
 
 void parse_args(stress_test_args_t* args, int argc, char* argv[])
@@ -118,7 +145,8 @@ void parse_args(stress_test_args_t* args, int argc, char* argv[])
       ("pcap",          bpo::value<bool>(&args->write_pcap)->default_value(false), "Whether to write all RLC PDU to PCAP file")
       ("zeroseed",      bpo::value<bool>(&args->zero_seed)->default_value(false), "Whether to initialize random seed to zero")
       ("max_retx",      bpo::value<uint32_t>(&args->max_retx)->default_value(32), "Maximum number of RLC retransmission attempts")
-      ("nof_pdu_tti",   bpo::value<uint32_t>(&args->nof_pdu_tti)->default_value(1), "Number of PDUs processed in a TTI");
+      ("nof_pdu_tti",   bpo::value<uint32_t>(&args->nof_pdu_tti)->default_value(1), "Number of PDUs processed in a TTI")
+      ("benchmark",     bpo::value<bool>(&args->benchmark)->default_value(false), "Whether to report the received SDU rate and the allocations per received SDU");
   // clang-format on
 
   // these options are allowed on the command line
@@ -189,13 +217,6 @@ private:
   {
     // Generate A number of MAC PDUs
     for (uint32_t i = 0; i < args.nof_pdu_tti; i++) {
-      // Create PDU unique buffer
-      unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-      if (!pdu) {
-        printf("Fatal Error: Could not allocate PDU in mac_reader::run_thread\n");
-        exit(-1);
-      }
-
       // Get MAC PDU size
       float factor = 1.0f;
       if (args.random_opp) {
@@ -206,6 +227,12 @@ private:
       // Request data to transmit
       uint32_t buf_state = tx_rlc->get_buffer_state(lcid);
       if (buf_state > 0) {
+        // Create PDU unique buffer
+        unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+        if (!pdu) {
+          printf("Fatal Error: Could not allocate PDU in mac_reader::run_thread\n");
+          exit(-1);
+        }
         pdu->N_bytes = tx_rlc->read_pdu(lcid, pdu->msg, opp_size);
 
         // Push PDU in the list
@@ -538,6 +565,10 @@ void stress_test(stress_test_args_t args)
 
   printf("Starting test ..\n");
 
+  uint64_t                           heap_allocs_start = nof_heap_allocations.load(std::memory_order_relaxed);
+  srsran::byte_buffer_pool_metrics_t pool_start        = srsran::get_byte_buffer_pool_metrics();
+  auto                               t_start           = std::chrono::steady_clock::now();
+
   tester1.start(7);
   if (!args.single_tx) {
     tester2.start(7);
@@ -568,6 +599,22 @@ void stress_test(stress_test_args_t args)
     pcap.close();
   }
 
+  if (args.benchmark) {
+    // Allocations of both the Tx and Rx sides, including the SDUs generated by the testers
+    std::chrono::duration<double>      elapsed    = std::chrono::steady_clock::now() - t_start;
+    uint64_t                           heap_end   = nof_heap_allocations.load(std::memory_order_relaxed);
+    srsran::byte_buffer_pool_metrics_t pool_end   = srsran::get_byte_buffer_pool_metrics();
+    uint64_t                           buf_allocs = 0;
+    for (uint32_t i = 0; i < srsran::nof_byte_buffer_size_classes; ++i) {
+      buf_allocs += pool_end.size_classes[i].nof_allocations - pool_start.size_classes[i].nof_allocations;
+    }
+    uint64_t nof_sdus = tester1.get_nof_rx_pdus() + tester2.get_nof_rx_pdus();
+    printf("Benchmark: %.0f SDUs/s, %.2f byte buffer and %.2f heap allocations per SDU\n",
+           nof_sdus / elapsed.count(),
+           nof_sdus > 0 ? static_cast<double>(buf_allocs) / nof_sdus : 0,
+           nof_sdus > 0 ? static_cast<double>(heap_end - heap_allocs_start) / nof_sdus : 0);
+  }
+
   rlc_metrics_t metrics = {};
   rlc1.get_metrics(metrics, 1);
 
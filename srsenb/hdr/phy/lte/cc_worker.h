@@ -22,6 +22,9 @@
 #ifndef SRSENB_CC_WORKER_H
 #define SRSENB_CC_WORKER_H
 
+#include <array>
+#include <chrono>
+#include <condition_variable>
 #include <string.h>
 
 #include "../phy_common.h"
@@ -32,6 +35,72 @@
 namespace srsenb {
 namespace lte {
 
+/**
+ * Synchronises the UL stage of a subframe with its DL stage, which may run in a different thread. The scheduler call
+ * of the DL stage needs the feedback decoded by the UL stage (CRC, UCI, SNR and TA). The DL stage waits for it until a
+ * deadline, then it closes the gate. The UL stage reports to the MAC through the gate, so the feedback decoded after
+ * the deadline is discarded, and the MAC sees it as missing.
+ */
+class ul_report_gate
+{
+public:
+  /// Holds the gate while the UL stage reports to the MAC, so that a report is never interrupted by the deadline
+  class guard
+  {
+  public:
+    explicit guard(ul_report_gate& gate_) : gate(gate_), lock(gate_.mutex) {}
+    bool is_open() const { return gate.open; }
+
+  private:
+    ul_report_gate&             gate;
+    std::lock_guard<std::mutex> lock;
+  };
+
+  /// Opens the gate for a new UL stage
+  void start()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    open    = true;
+    running = true;
+  }
+
+  /// Signals the end of the UL stage
+  void finish()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    running = false;
+    cvar.notify_all();
+  }
+
+  bool is_open()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return open;
+  }
+
+  /// Waits for the end of the UL stage, closes the gate if it has not finished by the deadline
+  void wait(const std::chrono::steady_clock::time_point& deadline)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (not cvar.wait_until(lock, deadline, [this]() { return not running; })) {
+      open = false;
+    }
+  }
+
+  /// Waits for the end of the UL stage, without deadline
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cvar.wait(lock, [this]() { return not running; });
+  }
+
+private:
+  std::mutex              mutex;
+  std::condition_variable cvar;
+  bool                    open    = true;
+  bool                    running = false;
+};
+
 class cc_worker
 {
 public:
@@ -55,7 +124,10 @@ public:
   int  read_pucch_d(cf_t* pusch_d);
   void start_plot();
 
-  void work_ul(const srsran_ul_sf_cfg_t& ul_sf, stack_interface_phy_lte::ul_sched_t& ul_grants);
+  /* The UL grants are prepared before the DL is encoded, as the PHICH is transmitted in the resources of their PUSCH.
+   * The UL is then decoded, possibly in a different thread than the DL, and the grants must remain valid until then */
+  void prepare_ul(const srsran_ul_sf_cfg_t& ul_sf, stack_interface_phy_lte::ul_sched_t& ul_grants);
+  void work_ul(ul_report_gate& gate);
   void work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                stack_interface_phy_lte::dl_sched_t& dl_grants,
                stack_interface_phy_lte::ul_sched_t& ul_grants,
@@ -63,20 +135,34 @@ public:
 
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
 
+  /* Per stage processing time, used for profiling the PHY */
+  void set_stage_timing(bool enable);
+  void get_stage_times(phy_stage_times_t& times);
+
 private:
   constexpr static float PUSCH_RL_SNR_DB_TH = 1.0f;
   constexpr static float PUCCH_RL_CORR_TH   = 0.15f;
 
   int  encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
   int  encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srsran_mbsfn_cfg_t* mbsfn_cfg);
-  bool decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
-                         srsran_ul_cfg_t&                           ul_cfg,
-                         srsran_pusch_res_t&                        pusch_res);
-  void decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch);
+  // PUSCH grant prepared for decoding
+  struct pusch_ctx_t {
+    stack_interface_phy_lte::ul_sched_grant_t* grant        = nullptr;
+    srsran_ul_cfg_t                            ul_cfg       = {};
+    bool                                       uci_required = false;
+  };
+
+  bool prepare_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant, pusch_ctx_t& ctx);
+  bool decode_pusch_rnti(pusch_ctx_t& ctx, srsran_pusch_res_t& pusch_res);
+  void decode_pusch(ul_report_gate& gate);
   int  encode_phich(stack_interface_phy_lte::ul_sched_ack_t* acks, uint32_t nof_acks);
   int  encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
   int  encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_grants);
-  int  decode_pucch();
+  int  decode_pucch(ul_report_gate& gate);
+
+  using stage_clock = std::chrono::steady_clock;
+  stage_clock::time_point stage_start() const;
+  void                    stage_end(const stage_clock::time_point& start, double& acc_us);
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -93,8 +179,14 @@ private:
   srsran_dl_sf_cfg_t dl_sf = {};
   srsran_ul_sf_cfg_t ul_sf = {};
 
+  std::array<pusch_ctx_t, stack_interface_phy_lte::MAX_GRANTS> pusch_ctx;
+  uint32_t                                                     nof_pusch = 0;
+
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
 
+  bool              stage_time_en = false;
+  phy_stage_times_t stage_times   = {};
+
   // Class to store user information
   class ue
   {
@@ -120,9 +212,11 @@ private:
   // Component carrier index
   uint32_t cc_idx = 0;
 
-  // Each worker keeps a local copy of the user database. Uses more memory but more efficient to manage concurrency
+  // Each worker keeps a local copy of the user database. Uses more memory but more efficient to manage concurrency.
+  // The UL and the DL may be processed concurrently, the database is only modified holding both mutexes
   std::map<uint16_t, ue*> ue_db;
-  std::mutex              mutex;
+  std::mutex              ul_mutex;
+  std::mutex              dl_mutex;
 };
 
 } // namespace lte
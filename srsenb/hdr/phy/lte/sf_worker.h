@@ -22,11 +22,13 @@
 #ifndef SRSENB_PHCH_WORKER_H
 #define SRSENB_PHCH_WORKER_H
 
+#include <atomic>
 #include <mutex>
 #include <string.h>
 
 #include "../phy_common.h"
 #include "cc_worker.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
 
@@ -38,7 +40,7 @@ class sf_worker : public srsran::thread_pool::worker
 public:
   sf_worker(srslog::basic_logger& logger) : logger(logger) {}
   ~sf_worker();
-  void init(phy_common* phy);
+  void init(phy_common* phy, srsran::task_thread_pool* ul_pool = nullptr);
 
   cf_t* get_buffer_rx(uint32_t cc_idx, uint32_t antenna_idx);
   void  set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
@@ -58,8 +60,18 @@ public:
 
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
 
+  /* Per stage processing time, used for profiling the PHY */
+  void set_stage_timing(bool enable);
+  void get_stage_times(phy_stage_times_t& times);
+
+  /* Deadline misses since the last call, they are added to the given metrics */
+  void get_deadline_metrics(phy_deadline_metrics_t& metrics);
+
 private:
   void work_imp() final;
+  void start_ul();
+  void work_ul();
+  void work_dl();
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -73,6 +85,20 @@ private:
   srsran::phy_common_interface::worker_context_t context = {};
 
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
+
+  // UL stage, it runs in the UL pool if there is one. Otherwise it runs in the worker before the DL stage
+  srsran::task_thread_pool*                ul_pool   = nullptr;
+  stack_interface_phy_lte::ul_sched_list_t ul_grants = {};
+  ul_report_gate                           ul_gate;
+
+  // Deadlines of the current subframe, set when it is received
+  std::chrono::steady_clock::time_point ul_deadline      = {};
+  std::chrono::steady_clock::time_point dl_deadline      = {};
+  std::atomic<uint32_t>                 ul_deadline_miss = {0};
+  std::atomic<uint32_t>                 dl_deadline_miss = {0};
+
+  bool              stage_time_en = false; ///< Protected by work_mutex
+  phy_stage_times_t stage_times   = {};
 };
 
 } // namespace lte
@@ -67,8 +67,11 @@ struct phy_args_t {
   uint32_t                pusch_max_its       = 10;
   uint32_t                nr_pusch_max_its    = 10;
   bool                    pusch_8bit_decoder  = false;
+  uint32_t                pusch_cb_coworkers  = 0;
   float                   tx_amplitude        = 1.0f;
   uint32_t                nof_phy_threads     = 1;
+  uint32_t                nof_ul_threads      = 0;
+  uint32_t                ul_deadline_us      = 2000;
   std::string             equalizer_mode      = "mmse";
   float                   estimator_fil_w     = 1.0f;
   bool                    pusch_meas_epre     = true;
@@ -22,6 +22,8 @@
 #ifndef SRSENB_PHY_METRICS_H
 #define SRSENB_PHY_METRICS_H
 
+#include <cstdint>
+
 namespace srsenb {
 
 // PHY metrics per user
@@ -47,6 +49,48 @@ struct phy_metrics_t {
   ul_metrics_t ul;
 };
 
+// Accumulated PHY worker processing time per stage, in microseconds. Only measured when stage timing is enabled.
+
+struct phy_stage_times_t {
+  uint64_t nof_sf          = 0; ///< Number of processed subframes
+  uint64_t nof_cc_sf       = 0; ///< Number of processed subframes, accounting each carrier
+  uint64_t nof_pusch       = 0;
+  double   sf_us           = 0; ///< Whole subframe worker, including the scheduler calls
+  double   ul_fft_us       = 0; ///< UL OFDM demodulation
+  double   pusch_chest_us  = 0; ///< PUSCH channel estimation
+  double   pusch_demod_us  = 0; ///< PUSCH equalization, DFT de-precoding, soft-demodulation and descrambling
+  double   pusch_decode_us = 0; ///< UL-SCH rate de-matching, turbo decoding and CRC check
+  double   pucch_us        = 0;
+  double   dl_base_us      = 0; ///< Reference signals, PSS/SSS, PBCH, PCFICH and PHICH
+  double   pdcch_us        = 0; ///< DL and UL DCI encoding
+  double   pdsch_us        = 0; ///< DL-SCH encoding, modulation and mapping
+  double   dl_ifft_us      = 0; ///< DL OFDM modulation
+
+  phy_stage_times_t& operator+=(const phy_stage_times_t& other)
+  {
+    nof_sf += other.nof_sf;
+    nof_cc_sf += other.nof_cc_sf;
+    nof_pusch += other.nof_pusch;
+    sf_us += other.sf_us;
+    ul_fft_us += other.ul_fft_us;
+    pusch_chest_us += other.pusch_chest_us;
+    pusch_demod_us += other.pusch_demod_us;
+    pusch_decode_us += other.pusch_decode_us;
+    pucch_us += other.pucch_us;
+    dl_base_us += other.dl_base_us;
+    pdcch_us += other.pdcch_us;
+    pdsch_us += other.pdsch_us;
+    dl_ifft_us += other.dl_ifft_us;
+    return *this;
+  }
+};
+
+// Number of subframes whose processing missed its deadline, per direction, since the last report
+struct phy_deadline_metrics_t {
+  uint32_t ul_miss = 0; ///< UL decoded too late for its feedback to be used by the scheduler
+  uint32_t dl_miss = 0; ///< DL encoded too late to leave the radio time to transmit it
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_PHY_METRICS_H
@@ -25,14 +25,50 @@
 #include "phy_interfaces.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <srsran/adt/circular_array.h>
+#include <vector>
 
 namespace srsenb {
 
 class phy_ue_db
 {
+public:
+  /**
+   * Immutable configuration of a UE for one of its active eNb cells/carriers, as seen by the PHY workers. The stashed
+   * parameters of an ongoing reconfiguration are already applied to the DL fields.
+   */
+  struct cell_cfg_snapshot_t {
+    bool             active     = false; ///< The cell is the PCell or an active SCell
+    bool             is_pcell   = false; ///< The cell is the PCell
+    uint32_t         enb_cc_idx = 0;     ///< eNb cell/carrier index
+    uint32_t         ue_cc_idx  = 0;     ///< UE serving cell index
+    srsran_dl_cfg_t  dl_cfg     = {};    ///< DL configuration for PDSCH transmissions
+    srsran_dci_cfg_t dci_dl_cfg = {};    ///< DCI configuration for DL grants
+    srsran_ul_cfg_t  ul_cfg     = {};    ///< UL configuration for PUSCH and PUCCH receptions
+    srsran_dci_cfg_t dci_ul_cfg = {};    ///< DCI configuration for UL grants
+  };
+
+  /**
+   * Read-side critical section for the configuration snapshots. The pointers returned by get_cfg_snapshot() remain
+   * valid while the guard is alive. Guards are cheap, they shall be kept for the duration of a single UE grant.
+   */
+  class read_guard
+  {
+  public:
+    explicit read_guard(const phy_ue_db& db_);
+    ~read_guard();
+    read_guard(const read_guard&) = delete;
+    read_guard& operator=(const read_guard&) = delete;
+
+  private:
+    const phy_ue_db& db;
+    uint32_t         idx;
+  };
+
 private:
   /**
    * Primary serving cell configuration flow
@@ -113,6 +149,31 @@ private:
    */
   mutable std::mutex mutex;
 
+  /**
+   * Configuration snapshot read path
+   * --------------------------------
+   * The PHY workers read the UE configurations for every grant. They do it without locking from an immutable table of
+   * per-RNTI snapshots, sorted by RNTI. Every change in the configuration builds a new snapshot for the RNTI and
+   * publishes a new table (copy on write, UE snapshots are shared between table versions). The replaced table is
+   * released once all the readers that could still hold it have left their read-side critical section (two-phase grace
+   * period on the reader counters, the writer side is serialised by the database mutex).
+   */
+  struct ue_cfg_snapshot_t {
+    uint16_t                                              rnti = SRSRAN_INVALID_RNTI;
+    std::array<cell_cfg_snapshot_t, SRSRAN_MAX_CARRIERS> cells;
+  };
+  using cfg_table_t = std::vector<std::pair<uint16_t, std::shared_ptr<const ue_cfg_snapshot_t> > >;
+
+  std::atomic<const cfg_table_t*>               cfg_table = {nullptr};
+  std::atomic<uint32_t>                         cfg_epoch = {0};
+  mutable std::array<std::atomic<uint32_t>, 2> cfg_readers;
+  std::mutex                                    cfg_release_mutex;
+
+  /**
+   * Default configuration, used for non-user RNTIs
+   */
+  const srsran::phy_cfg_t default_cfg;
+
   /**
    * Stack interface
    */
@@ -227,14 +288,21 @@ private:
   inline int _assert_cell_list_cfg() const;
 
   /**
-   * Internal eNb general configuration getter, returns default configuration if the UE does not exist in the given cell
+   * Builds a new configuration snapshot for the given RNTI from the database and publishes it to the PHY workers. If the
+   * RNTI does not exist in the database, its snapshot is removed. It is not thread safe protected
    *
-   * @param rnti provides UE identifier
-   * @param enb_cc_idx eNb cell index
-   * @param[out] phy_cfg The PHY configuration of the indicated UE for the indicated eNb carrier/call index.
-   * @return SRSRAN_SUCCESS if provided context is correct, SRSRAN_ERROR code otherwise
+   * @param rnti identifier of the UE
+   * @return the replaced table, it must be released with _release_cfg_table() after unlocking the database mutex
+   */
+  const cfg_table_t* _publish_config_rnti(uint16_t rnti);
+
+  /**
+   * Waits until all the readers that could access a replaced table have finished and deletes it. It must not be called
+   * with the database mutex locked, readers may be waiting for it inside their read-side critical section
+   *
+   * @param table the replaced table
    */
-  inline int _get_rnti_config(uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg) const;
+  void _release_cfg_table(const cfg_table_t* table);
 
   /**
    * Count number of configured secondary serving cells
@@ -245,6 +313,11 @@ private:
   inline uint32_t _count_nof_configured_scell(uint16_t rnti);
 
 public:
+  phy_ue_db();
+  ~phy_ue_db();
+  phy_ue_db(const phy_ue_db&) = delete;
+  phy_ue_db& operator=(const phy_ue_db&) = delete;
+
   /**
    * Initialises the UE database with the stack and cell list
    * @param stack_ptr points to the stack (read/write)
@@ -305,6 +378,16 @@ public:
    */
   bool ue_has_cell(uint16_t rnti, uint32_t enb_cc_idx) const;
 
+  /**
+   * Get the configuration snapshot of a user RNTI for an eNb cell/carrier without locking or copying. It must be called
+   * while holding a read_guard, the returned snapshot is valid until the guard is released.
+   *
+   * @param rnti identifier of the UE
+   * @param enb_cc_idx the eNb cell/carrier identifier
+   * @return the snapshot if the RNTI exists and the cell/carrier is active for it, nullptr otherwise
+   */
+  const cell_cfg_snapshot_t* get_cfg_snapshot(uint16_t rnti, uint32_t enb_cc_idx) const;
+
   /**
    * Get the current down-link physical layer configuration for an RNTI and an eNb cell/carrier
    *
@@ -58,6 +58,7 @@ public:
   void ul_sr_info(uint16_t rnti) override;
   void ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr) override;
   void dl_buffer_state(uint16_t rnti, uint32_t lcid, uint32_t newtx, uint32_t retx);
+  void dl_cqi_info(uint16_t rnti, uint32_t cc, uint32_t cqi_value);
 
   int run_slot(slot_point pdsch_tti, uint32_t cc, dl_res_t& result) override;
   int get_ul_sched(slot_point pusch_tti, uint32_t cc, ul_res_t& result) override;
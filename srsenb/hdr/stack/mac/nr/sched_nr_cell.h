@@ -24,6 +24,7 @@
 
 #include "sched_nr_cfg.h"
 #include "sched_nr_grant_allocator.h"
+#include "sched_nr_time_pf.h"
 #include "sched_nr_time_rr.h"
 #include "srsran/adt/pool/cached_alloc.h"
 
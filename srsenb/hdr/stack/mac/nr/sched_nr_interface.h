@@ -95,6 +95,8 @@ public:
     bool        auto_refill_buffer = false;
     int         fixed_dl_mcs       = 28;
     int         fixed_ul_mcs       = 28;
+    std::string sched_policy       = "time_rr";
+    std::string sched_policy_args  = "2";
     std::string logger_name        = "MAC-NR";
   };
 
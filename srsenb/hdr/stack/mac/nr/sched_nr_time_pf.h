@@ -0,0 +1,69 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_NR_TIME_PF_H
+#define SRSRAN_SCHED_NR_TIME_PF_H
+
+#include "sched_nr_time_rr.h"
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/**
+ * Time-domain Proportional Fair scheduler. In every slot, the UE with the highest ratio between its expected
+ * instantaneous rate (derived from the last CQI, when the MCS is not fixed) and its averaged served rate, raised to the fairness coefficient,
+ * is allocated first. HARQ retransmissions take precedence over new transmissions.
+ */
+class sched_nr_time_pf : public sched_nr_base
+{
+public:
+  explicit sched_nr_time_pf(const bwp_params_t& bwp_cfg_);
+
+  void sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+  void sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+
+private:
+  /// Scratch buffers, in SoA layout, with the PF metric inputs of all candidates of a given slot
+  struct candidate_list {
+    uint32_t                                 size = 0;
+    std::array<slot_ue*, SCHED_NR_MAX_USERS> ues;
+    std::array<float, SCHED_NR_MAX_USERS>    inst_rate;
+    std::array<float, SCHED_NR_MAX_USERS>    avg_rate;
+    std::array<float, SCHED_NR_MAX_USERS>    prio;
+
+    void push_back(slot_ue& ue, float r, float R);
+  };
+
+  float    expected_rate(uint32_t cqi, int fixed_mcs) const;
+  void     compute_priorities(candidate_list& cands) const;
+  slot_ue* alloc_best_candidate(candidate_list& cands, bool is_dl, bwp_slot_allocator& slot_alloc);
+  void     update_avg_rates(bool is_dl, const slot_ue* winner);
+
+  const bwp_params_t& bwp_cfg;
+  float               fairness_coeff = 1;
+
+  candidate_list retx_cands, newtx_cands;
+};
+
+} // namespace sched_nr_impl
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_NR_TIME_PF_H
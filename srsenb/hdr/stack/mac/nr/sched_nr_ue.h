@@ -37,6 +37,17 @@ namespace sched_nr_impl {
 
 class ue_carrier;
 
+/// Averaged rate served to a UE in a carrier, kept across slots for the scheduling policies that need it
+struct ue_served_rate {
+  float    dl_avg_rate    = 0;
+  float    ul_avg_rate    = 0;
+  uint32_t dl_nof_samples = 0;
+  uint32_t ul_nof_samples = 0;
+
+  void save_dl_alloc(uint32_t alloc_bytes, float exp_avg_alpha);
+  void save_ul_alloc(uint32_t alloc_bytes, float exp_avg_alpha);
+};
+
 class slot_ue
 {
 public:
@@ -62,10 +73,11 @@ public:
   slot_point          pusch_slot;
   slot_point          uci_slot;
   uint32_t            dl_cqi  = 0;
-  uint32_t            ul_cqi  = 0;
-  dl_harq_proc*       h_dl    = nullptr;
-  ul_harq_proc*       h_ul    = nullptr;
-  srsran_uci_cfg_nr_t uci_cfg = {};
+  uint32_t            ul_cqi      = 0;
+  dl_harq_proc*       h_dl        = nullptr;
+  ul_harq_proc*       h_ul        = nullptr;
+  srsran_uci_cfg_nr_t uci_cfg     = {};
+  ue_served_rate*     served_rate = nullptr;
 };
 
 class ue_carrier
@@ -88,6 +100,9 @@ public:
 
   harq_entity harq_ent;
 
+  // Served rate history, released with the UE
+  ue_served_rate served_rate;
+
   // metrics
   mac_ue_metrics_t metrics = {};
   std::mutex       metrics_mutex;
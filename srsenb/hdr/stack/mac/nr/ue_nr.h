@@ -55,6 +55,7 @@ public:
 
   void     set_tti(uint32_t tti);
   uint16_t get_rnti() const { return rnti; }
+  uint32_t get_pcell_cc_idx() const { return pcell_cc_idx; }
   void     set_active(bool active) { active_state.store(active, std::memory_order_relaxed); }
   bool     is_active() const { return active_state.load(std::memory_order_relaxed); }
 
@@ -90,6 +91,7 @@ private:
 
   uint64_t conres_id    = 0;
   uint16_t rnti         = 0;
+  uint32_t pcell_cc_idx = 0;
   uint32_t last_tti     = 0;
   uint32_t nof_failures = 0;
 
@@ -26,7 +26,9 @@
 #include "sched_interface.h"
 #include "sched_ue.h"
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsran/common/thread_pool.h"
 #include <atomic>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 
@@ -91,6 +93,7 @@ public:
 
 protected:
   void new_tti(srsran::tti_point tti_rx);
+  void new_tti_parallel(srsran::tti_point tti_rx, srsran::span<const uint32_t> cc_list);
   bool is_generated(srsran::tti_point, uint32_t enb_cc_idx) const;
   // Helper methods
   template <typename Func>
@@ -112,6 +115,12 @@ protected:
   srsran::tti_point last_tti;
   std::mutex        sched_mutex;
   bool              configured;
+
+  // Workers that allocate the user data of different carriers of the same TTI in parallel
+  std::unique_ptr<srsran::task_thread_pool> cc_workers;
+  std::mutex                                cc_workers_mutex;
+  std::condition_variable                   cc_workers_cvar;
+  uint32_t                                  nof_pending_cc_workers = 0;
 };
 
 } // namespace srsenb
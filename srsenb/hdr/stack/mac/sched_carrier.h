@@ -46,6 +46,15 @@ public:
   const cc_sched_result& generate_tti_result(srsran::tti_point tti_rx);
   int                    dl_rach_info(dl_sched_rar_info_t rar_info);
 
+  /* Steps of generate_tti_result(), for when the carriers of the same TTI are scheduled in parallel */
+  //! Allocate PHICH, broadcast, RAR and Msg3 grants. Accesses UE state shared across carriers
+  void alloc_ctrl_tti(srsran::tti_point tti_rx);
+  //! Allocate DL and UL user data. Only modifies carrier-specific state, and can run concurrently with other carriers
+  void alloc_users_tti(srsran::tti_point tti_rx);
+  //! Generate the DCIs and update the UE HARQs and buffers with the allocations of the TTI. In parallel mode, the DL
+  //! grants left without data by the other carriers are dropped
+  const cc_sched_result& finish_tti(srsran::tti_point tti_rx, bool parallel = false);
+
   // getters
   const ra_sched* get_ra_sched() const { return ra_sched_ptr.get(); }
   //! Get a subframe result for a given tti
@@ -195,8 +195,9 @@ public:
   }
   alloc_result alloc_phich(sched_ue* user);
 
-  // compute DCIs and generate dl_sched_result/ul_sched_result for a given TTI
-  void generate_sched_results(sched_ue_list& ue_db);
+  // compute DCIs and generate dl_sched_result/ul_sched_result for a given TTI. drop_failed_dl removes the DL grants
+  // whose DCI could not be generated from the result
+  void generate_sched_results(sched_ue_list& ue_db, bool drop_failed_dl = false);
 
   alloc_result                    alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask, uint32_t pid);
   tti_point                       get_tti_tx_dl() const { return to_tx_dl(tti_rx); }
@@ -217,7 +218,8 @@ public:
 private:
   void set_dl_data_sched_result(const sf_cch_allocator::alloc_result_t& dci_result,
                                 sched_interface::dl_sched_res_t*        dl_result,
-                                sched_ue_list&                          ue_list);
+                                sched_ue_list&                          ue_list,
+                                bool                                    drop_failed);
   void set_ul_sched_result(const sf_cch_allocator::alloc_result_t& dci_result,
                            sched_interface::ul_sched_res_t*        ul_result,
                            sched_ue_list&                          ue_list);
@@ -49,6 +49,16 @@ inline uint32_t get_nof_retx(uint32_t rv_idx)
 
 cce_frame_position_table generate_cce_location_table(uint16_t rnti, const sched_cell_params_t& cell_cfg);
 
+/// Converts a table of CCE start positions into the equivalent table of PDCCH candidate bitmasks
+cce_frame_candidate_table generate_cce_candidate_table(const cce_frame_position_table& locations);
+
+/**
+ * Generate the PDCCH candidate bitmasks for a list of CCE locations
+ * @param locations CCE start positions for each aggregation level
+ * @param candidates Result of the conversion, with the same ordering as the CCE locations
+ */
+void generate_cce_candidates(const cce_cfi_position_table& locations, cce_cfi_candidate_table& candidates);
+
 /**
  * Generate possible CCE locations a user can use to allocate DCIs
  * @param regs Regs data for the given cell configuration
@@ -79,6 +79,7 @@ public:
     int         init_dl_cqi               = 5;
     float       max_sib_coderate          = 0.8;
     int         pdcch_cqi_offset          = 0;
+    uint32_t    nof_cc_workers            = 1; ///< Number of threads taking carrier scheduling decisions in parallel
   };
 
   struct cell_cfg_t {
@@ -51,6 +51,26 @@ using cce_sf_position_table = std::array<std::array<cce_position_list, NOF_AGGR_
 /// Map {sf, cfi, L} -> list of CCE positions
 using cce_frame_position_table = std::array<cce_sf_position_table, SRSRAN_NOF_SF_X_FRAME>;
 
+/// PDCCH candidate, with the CCEs it occupies in the form of a 64-bit word of the PDCCH CCE bitmap.
+/// Note: Candidates start at a multiple of their aggregation level, so they never straddle two words
+struct cce_candidate {
+  uint32_t ncce     = 0; ///< First CCE of the candidate
+  uint32_t word_idx = 0; ///< Index of the 64-bit word of the CCE bitmap where the candidate lies
+  uint64_t mask     = 0; ///< CCEs occupied by the candidate within the word
+};
+
+/// List of PDCCH candidates, in the same order as the respective CCE start positions
+using cce_candidate_list = srsran::bounded_vector<cce_candidate, 6>;
+
+/// Map {L} -> list of PDCCH candidates
+using cce_cfi_candidate_table = std::array<cce_candidate_list, NOF_AGGR_LEVEL>;
+
+/// Map {cfi, L} -> list of PDCCH candidates
+using cce_sf_candidate_table = std::array<cce_cfi_candidate_table, SRSRAN_NOF_CFI>;
+
+/// Map {sf, cfi, L} -> list of PDCCH candidates
+using cce_frame_candidate_table = std::array<cce_sf_candidate_table, SRSRAN_NOF_SF_X_FRAME>;
+
 /// structs to bundle together all the sched arguments, and share them with all the sched sub-components
 class sched_cell_params_t
 {
@@ -73,11 +93,13 @@ public:
   srsran_pucch_cfg_t                           pucch_cfg_common = {};
   const sched_interface::sched_args_t*         sched_cfg        = nullptr;
   std::unique_ptr<srsran_regs_t, regs_deleter> regs;
-  cce_sf_position_table                        common_locations = {};
-  cce_frame_position_table                     rar_locations    = {};
-  std::array<uint32_t, SRSRAN_NOF_CFI>         nof_cce_table    = {}; ///< map cfix -> nof cces in PDCCH
-  uint32_t                                     P                = 0;
-  uint32_t                                     nof_rbgs         = 0;
+  cce_sf_position_table                        common_locations  = {};
+  cce_frame_position_table                     rar_locations     = {};
+  cce_sf_candidate_table                       common_candidates = {}; ///< bitmask form of common_locations
+  cce_frame_candidate_table                    rar_candidates    = {}; ///< bitmask form of rar_locations
+  std::array<uint32_t, SRSRAN_NOF_CFI>         nof_cce_table     = {}; ///< map cfix -> nof cces in PDCCH
+  uint32_t                                     P                 = 0;
+  uint32_t                                     nof_rbgs          = 0;
 
   using dl_nof_re_table = srsran::bounded_vector<
       std::array<std::array<std::array<uint32_t, SRSRAN_NOF_CFI>, SRSRAN_NOF_SLOTS_PER_SF>, SRSRAN_NOF_SF_X_FRAME>,
@@ -29,11 +29,21 @@ namespace srsenb {
 
 class sched_ue;
 
-/// Class responsible for managing a PDCCH CCE grid, namely CCE allocs, and avoid collisions.
+/**
+ * Class responsible for managing a PDCCH CCE grid, namely CCE allocs, and avoid collisions.
+ * The CCE and PUCCH occupancy of the current solution is tracked with plain 64-bit word bitmaps, and the candidate
+ * CCE positions of each DCI are read from the tables of bitmasks precomputed at cell/UE configuration time. When a new
+ * DCI does not fit, the positions of the previously allocated DCIs are permuted via a depth-first search, with a bounded
+ * number of backtracking steps per CFI. No memory allocations take place during the search.
+ */
 class sf_cch_allocator
 {
 public:
   const static uint32_t MAX_CFI = 3;
+  /// Maximum number of DCIs allocated per subframe
+  const static uint32_t MAX_DCIS = 16;
+  /// Maximum number of DFS backtracking steps per CFI in a single DCI allocation attempt
+  const static uint32_t MAX_DFS_BACKTRACKS = 64;
   struct tree_node {
     int8_t                pucch_n_prb = -1; ///< this PUCCH resource identifier
     uint16_t              rnti        = SRSRAN_INVALID_RNTI;
@@ -44,7 +54,7 @@ public:
     pdcch_mask_t total_mask, current_mask;
     prbmask_t    total_pucch_mask;
   };
-  using alloc_result_t = srsran::bounded_vector<const tree_node*, 16>;
+  using alloc_result_t = srsran::bounded_vector<const tree_node*, MAX_DCIS>;
 
   sf_cch_allocator() : logger(srslog::fetch_basic_logger("MAC")) {}
 
@@ -77,23 +87,43 @@ private:
     alloc_type_t alloc_type;
     sched_ue*    user;
   };
-  const cce_cfi_position_table* get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uint32_t cfix) const;
+  using cce_bitmap_t   = std::array<uint64_t, (MAX_NOF_CCES + 63) / 64>;
+  using pucch_bitmap_t = std::array<uint64_t, (MAX_NOF_PRBS + 63) / 64>;
+  /// CCE position chosen for a DCI record, and cumulative CCE/PUCCH occupancy of the DFS path up to it
+  struct dfs_node {
+    int8_t         pucch_n_prb      = -1;
+    uint32_t       dci_pos_idx      = 0;
+    uint32_t       ncce             = 0;
+    cce_bitmap_t   total_mask       = {};
+    pucch_bitmap_t total_pucch_mask = {};
+  };
+  using dfs_path_t = srsran::bounded_vector<dfs_node, MAX_DCIS>;
+
+  const cce_cfi_candidate_table* get_cce_candidates(alloc_type_t alloc_type, sched_ue* user, uint32_t cfix) const;
 
   // PDCCH allocation algorithm
   bool alloc_dfs_node(const alloc_record& record, uint32_t start_child_idx);
   bool get_next_dfs();
+  void update_result() const;
 
   // consts
   const sched_cell_params_t* cc_cfg = nullptr;
   srslog::basic_logger&      logger;
-  srsran_pucch_cfg_t         pucch_cfg_common = {};
+  /// Map ncce -> PUCCH PRB of the HARQ-ACK of a DL grant, -1 for the CCEs beyond the cell max_nof_cces. The PUCCH HARQ
+  /// region is checked when the DCI is allocated
+  std::array<int8_t, MAX_NOF_CCES> ncce_to_pucch_n_prb;
 
   // tti vars
-  tti_point                 tti_rx;
-  uint32_t                  current_cfix     = 0;
-  uint32_t                  current_max_cfix = 0;
-  std::vector<tree_node>    last_dci_dfs, temp_dci_dfs;
-  std::vector<alloc_record> dci_record_list; ///< Keeps a record of all the PDCCH allocations done so far
+  tti_point                                      tti_rx;
+  uint32_t                                       current_cfix     = 0;
+  uint32_t                                       current_max_cfix = 0;
+  uint32_t                                       nof_backtracks   = 0;
+  dfs_path_t                                     last_dci_dfs, temp_dci_dfs;
+  srsran::bounded_vector<alloc_record, MAX_DCIS> dci_record_list; ///< Keeps a record of all the PDCCH allocations
+
+  // Allocation result in the form of tree nodes. Only derived from the DFS path when requested
+  mutable srsran::bounded_vector<tree_node, MAX_DCIS> result_nodes;
+  mutable bool                                        result_outdated = false;
 };
 
 // Helper methods
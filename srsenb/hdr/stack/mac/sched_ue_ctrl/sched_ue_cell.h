@@ -71,6 +71,9 @@ struct sched_ue_cell {
   /// Allowed DCI locations per per CFI and per subframe
   const cce_frame_position_table dci_locations;
 
+  /// Bitmask form of the allowed DCI locations, used by the PDCCH allocator
+  const cce_frame_candidate_table dci_candidates;
+
   /// Cell HARQ Entity
   harq_entity harq_ent;
 
@@ -26,6 +26,7 @@
 #include "srsenb/src/enb_cfg_parser.h"
 #include "srsran/build_info.h"
 #include "srsran/common/enb_events.h"
+#include "srsran/phy/dft/dft.h"
 #include "srsran/radio/radio_null.h"
 #include <iostream>
 
@@ -146,6 +147,13 @@ int enb::init(const all_args_t& args_)
     event_logger::get().log_sector_start(i, rrc_cfg.cell_list[i].pci, rrc_cfg.cell_list[i].cell_id, sib9_hnb_name);
   }
 
+  srsran_dft_plan_stats_t dft_stats = {};
+  srsran_dft_get_plan_stats(&dft_stats);
+  enb_log.info("FFT planning: %d plans created, %d shared, %.1f ms",
+               dft_stats.nof_plans,
+               dft_stats.nof_shared,
+               dft_stats.planning_time_us / 1000.0);
+
   if (ret == SRSRAN_SUCCESS) {
     srsran::console("\n==== eNodeB started ===\n");
     srsran::console("Type <t> to view trace\n");
@@ -212,6 +220,7 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   radio->get_metrics(&m->rf);
   phy->get_metrics(m->phy);
+  phy->get_deadline_metrics(m->phy_deadline);
   if (eutra_stack) {
     eutra_stack->get_metrics(&m->stack);
   }
@@ -177,11 +177,13 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("scheduler.init_dl_cqi", bpo::value<int>(&args->stack.mac.sched.init_dl_cqi)->default_value(5), "DL CQI value used before any CQI report is available to the eNB")
     ("scheduler.max_sib_coderate", bpo::value<float>(&args->stack.mac.sched.max_sib_coderate)->default_value(0.8), "Upper bound on SIB and RAR grants coderate")
     ("scheduler.pdcch_cqi_offset", bpo::value<int>(&args->stack.mac.sched.pdcch_cqi_offset)->default_value(0), "CQI offset in derivation of PDCCH aggregation level")
+    ("scheduler.nof_cc_workers", bpo::value<uint32_t>(&args->stack.mac.sched.nof_cc_workers)->default_value(1), "Number of threads scheduling the carriers of a TTI in parallel (1 for sequential scheduling)")
 
 
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),               "Enable/Disable internal Downlink channel emulator")
+    ("channel.dl.pipeline",          bpo::value<bool>(&args->phy.dl_channel_args.pipeline_enable)->default_value(false),      "Process each antenna in its own thread")
     ("channel.dl.awgn.enable",       bpo::value<bool>(&args->phy.dl_channel_args.awgn_enable)->default_value(false),          "Enable/Disable AWGN simulator")
     ("channel.dl.awgn.snr",          bpo::value<float>(&args->phy.dl_channel_args.awgn_snr_dB)->default_value(30.0f),         "Target SNR in dB")
     ("channel.dl.fading.enable",     bpo::value<bool>(&args->phy.dl_channel_args.fading_enable)->default_value(false),        "Enable/Disable Fading model")
@@ -201,6 +203,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Uplink Channel emulator section */
     ("channel.ul.enable",            bpo::value<bool>(&args->phy.ul_channel_args.enable)->default_value(false),                  "Enable/Disable internal Downlink channel emulator")
+    ("channel.ul.pipeline",          bpo::value<bool>(&args->phy.ul_channel_args.pipeline_enable)->default_value(false),         "Process each antenna in its own thread")
     ("channel.ul.awgn.enable",       bpo::value<bool>(&args->phy.ul_channel_args.awgn_enable)->default_value(false),             "Enable/Disable AWGN simulator")
     ("channel.ul.awgn.signal_power", bpo::value<float>(&args->phy.ul_channel_args.awgn_signal_power_dBfs)->default_value(30.0f), "Received signal power in decibels full scale (dBfs)")
     ("channel.ul.awgn.snr",          bpo::value<float>(&args->phy.ul_channel_args.awgn_snr_dB)->default_value(30.0f),            "Noise level in decibels full scale (dBfs)")
@@ -225,9 +228,12 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.metrics_csv_filename", bpo::value<string>(&args->general.metrics_csv_filename)->default_value("/tmp/enb_metrics.csv"), "Metrics CSV filename.")
     ("expert.pusch_max_its", bpo::value<uint32_t>(&args->phy.pusch_max_its)->default_value(8), "Maximum number of turbo decoder iterations for LTE.")
     ("expert.pusch_8bit_decoder", bpo::value<bool>(&args->phy.pusch_8bit_decoder)->default_value(false), "Use 8-bit for LLR representation and turbo decoder trellis computation (Experimental).")
+    ("expert.pusch_cb_coworkers", bpo::value<uint32_t>(&args->phy.pusch_cb_coworkers)->default_value(0), "Number of additional threads per PHY worker decoding PUSCH code blocks in parallel (0 disables).")
     ("expert.pusch_meas_evm", bpo::value<bool>(&args->phy.pusch_meas_evm)->default_value(false), "Enable/Disable PUSCH EVM measure.")
     ("expert.tx_amplitude", bpo::value<float>(&args->phy.tx_amplitude)->default_value(0.6), "Transmit amplitude factor.")
     ("expert.nof_phy_threads", bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3), "Number of PHY threads.")
+    ("expert.nof_ul_threads", bpo::value<uint32_t>(&args->phy.nof_ul_threads)->default_value(0), "Number of threads decoding the UL separately from the PHY threads (0 decodes it in the PHY threads).")
+    ("expert.ul_deadline_us", bpo::value<uint32_t>(&args->phy.ul_deadline_us)->default_value(2000), "Time after the reception of a subframe by which its UL feedback must be decoded (in us).")
     ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. Only 1 or 0 is supported.")
     ("expert.max_prach_offset_us", bpo::value<float>(&args->phy.max_prach_offset_us)->default_value(30), "Maximum allowed RACH offset (in us).")
     ("expert.equalizer_mode", bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"), "Equalizer mode.")
@@ -266,6 +272,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     // NR section
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
     ("scheduler.nr_pusch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_ul_mcs)->default_value(28), "Fixed NR UL MCS (-1 for dynamic).")
+    ("scheduler.nr_policy", bpo::value<string>(&args->nr_stack.mac.sched_cfg.sched_policy)->default_value("time_rr"), "NR DL and UL data scheduling policy (E.g. time_rr, time_pf)")
+    ("scheduler.nr_policy_args", bpo::value<string>(&args->nr_stack.mac.sched_cfg.sched_policy_args)->default_value("2"), "NR scheduler policy-specific arguments")
     ("expert.nr_pusch_max_its", bpo::value<uint32_t>(&args->phy.nr_pusch_max_its)->default_value(10),     "Maximum number of LDPC iterations for NR.")
 
     // VNF params
@@ -81,13 +81,24 @@ DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
 DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
 
+/// Byte buffer pool size class container metrics.
+DECLARE_METRIC("payload_size", metric_pool_payload_size, uint32_t, "");
+DECLARE_METRIC("nof_buffers", metric_pool_nof_buffers, uint32_t, "");
+DECLARE_METRIC("nof_allocated", metric_pool_nof_allocated, uint32_t, "");
+DECLARE_METRIC_SET("pool_container",
+                   mset_pool_container,
+                   metric_pool_payload_size,
+                   metric_pool_nof_buffers,
+                   metric_pool_nof_allocated);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 DECLARE_METRIC_LIST("cell_list", mlist_cell, std::vector<mset_cell_container>);
+DECLARE_METRIC_LIST("byte_buffer_pool", mlist_pool, std::vector<mset_pool_container>);
 
 /// Metrics context.
-using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell>;
+using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell, mlist_pool>;
 
 } // namespace
 
@@ -208,6 +219,15 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     }
   }
 
+  // For each byte buffer pool size class...
+  auto& pool_list = ctx.get<mlist_pool>();
+  for (const auto& size_class : m.stack.pool.size_classes) {
+    pool_list.emplace_back();
+    pool_list.back().write<metric_pool_payload_size>(size_class.payload_size);
+    pool_list.back().write<metric_pool_nof_buffers>(size_class.nof_buffers);
+    pool_list.back().write<metric_pool_nof_allocated>(size_class.nof_allocated);
+  }
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
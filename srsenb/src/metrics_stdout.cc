@@ -187,6 +187,10 @@ void metrics_stdout::set_metrics(const enb_metrics_t& metrics, const uint32_t pe
     fmt::print("RF status: O={}, U={}, L={}\n", metrics.rf.rf_o, metrics.rf.rf_u, metrics.rf.rf_l);
   }
 
+  if (metrics.phy_deadline.ul_miss > 0 or metrics.phy_deadline.dl_miss > 0) {
+    fmt::print("PHY deadline misses: UL={}, DL={}\n", metrics.phy_deadline.ul_miss, metrics.phy_deadline.dl_miss);
+  }
+
   if (metrics.stack.rrc.ues.size() == 0) {
     return;
   }
@@ -149,6 +149,11 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     enb_ul.pusch.llr_is_8bit        = true;
     enb_ul.pusch.ul_sch.llr_is_8bit = true;
   }
+  if (phy->params.pusch_cb_coworkers > 0) {
+    if (srsran_sch_enable_cb_coworkers(&enb_ul.pusch.ul_sch, phy->params.pusch_cb_coworkers) < SRSRAN_SUCCESS) {
+      ERROR("Error enabling PUSCH code block coworkers");
+    }
+  }
   initiated = true;
 
 #ifdef DEBUG_WRITE_FILE
@@ -181,7 +186,9 @@ void cc_worker::set_tti(uint32_t tti_)
 
 int cc_worker::add_rnti(uint16_t rnti)
 {
-  std::unique_lock<std::mutex> lock(mutex);
+  std::lock(ul_mutex, dl_mutex);
+  std::lock_guard<std::mutex> ul_lock(ul_mutex, std::adopt_lock);
+  std::lock_guard<std::mutex> dl_lock(dl_mutex, std::adopt_lock);
 
   // Create user unless already exists
   if (ue_db.count(rnti) == 0) {
@@ -192,7 +199,9 @@ int cc_worker::add_rnti(uint16_t rnti)
 
 void cc_worker::rem_rnti(uint16_t rnti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock(ul_mutex, dl_mutex);
+  std::lock_guard<std::mutex> ul_lock(ul_mutex, std::adopt_lock);
+  std::lock_guard<std::mutex> dl_lock(dl_mutex, std::adopt_lock);
   if (ue_db.count(rnti)) {
     delete ue_db[rnti];
     ue_db.erase(rnti);
@@ -201,24 +210,38 @@ void cc_worker::rem_rnti(uint16_t rnti)
 
 uint32_t cc_worker::get_nof_rnti()
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(dl_mutex);
   return ue_db.size();
 }
 
-void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy_lte::ul_sched_t& ul_grants)
+void cc_worker::prepare_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy_lte::ul_sched_t& ul_grants)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(ul_mutex);
   ul_sf = ul_sf_cfg;
-  logger.set_context(ul_sf.tti);
+
+  // Compute the grants and the PHICH resources, stop at the first grant that fails
+  nof_pusch = 0;
+  while (nof_pusch < ul_grants.nof_grants and prepare_pusch_rnti(ul_grants.pusch[nof_pusch], pusch_ctx[nof_pusch])) {
+    nof_pusch++;
+  }
+}
+
+void cc_worker::work_ul(ul_report_gate& gate)
+{
+  std::lock_guard<std::mutex> lock(ul_mutex);
 
   // Process UL signal
+  stage_clock::time_point t = stage_start();
   srsran_enb_ul_fft(&enb_ul);
+  stage_end(t, stage_times.ul_fft_us);
 
   // Decode pending UL grants for the tti they were scheduled
-  decode_pusch(ul_grants.pusch, ul_grants.nof_grants);
+  decode_pusch(gate);
 
   // Decode remaining PUCCH ACKs not associated with PUSCH transmission and SR signals
-  decode_pucch();
+  t = stage_start();
+  decode_pucch(gate);
+  stage_end(t, stage_times.pucch_us);
 }
 
 void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
@@ -226,30 +249,48 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                         stack_interface_phy_lte::ul_sched_t& ul_grants,
                         srsran_mbsfn_cfg_t*                  mbsfn_cfg)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(dl_mutex);
   dl_sf = dl_sf_cfg;
 
   // Put base signals (references, PBCH, PCFICH and PSS/SSS) into the resource grid
+  stage_clock::time_point t = stage_start();
   srsran_enb_dl_put_base(&enb_dl, &dl_sf);
+  stage_end(t, stage_times.dl_base_us);
 
   // Put DL grants to resource grid. PDSCH data will be encoded as well.
   if (dl_sf_cfg.sf_type == SRSRAN_SF_NORM) {
+    t = stage_start();
     encode_pdcch_dl(dl_grants.pdsch, dl_grants.nof_grants);
+    stage_end(t, stage_times.pdcch_us);
+    t = stage_start();
     encode_pdsch(dl_grants.pdsch, dl_grants.nof_grants);
+    stage_end(t, stage_times.pdsch_us);
   } else {
     if (mbsfn_cfg->enable) {
+      t = stage_start();
       encode_pmch(dl_grants.pdsch, mbsfn_cfg);
+      stage_end(t, stage_times.pdsch_us);
     }
   }
 
   // Put UL grants to resource grid.
+  t = stage_start();
   encode_pdcch_ul(ul_grants.pusch, ul_grants.nof_grants);
+  stage_end(t, stage_times.pdcch_us);
 
   // Put pending PHICH HARQ ACK/NACK indications into subframe
+  t = stage_start();
   encode_phich(ul_grants.phich, ul_grants.nof_phich);
+  stage_end(t, stage_times.dl_base_us);
 
   // Generate signal and transmit
+  t = stage_start();
   srsran_enb_dl_gen_signal(&enb_dl);
+  stage_end(t, stage_times.dl_ifft_us);
+
+  if (stage_time_en) {
+    stage_times.nof_cc_sf++;
+  }
 
   // Scale if cell gain is set
   float cell_gain_db = phy->get_cell_gain(cc_idx);
@@ -262,11 +303,10 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
   }
 }
 
-bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
-                                  srsran_ul_cfg_t&                           ul_cfg,
-                                  srsran_pusch_res_t&                        pusch_res)
+bool cc_worker::prepare_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant, pusch_ctx_t& ctx)
 {
-  uint16_t rnti = ul_grant.dci.rnti;
+  uint16_t         rnti   = ul_grant.dci.rnti;
+  srsran_ul_cfg_t& ul_cfg = ctx.ul_cfg;
 
   // Invalid RNTI
   if (rnti == SRSRAN_INVALID_RNTI) {
@@ -279,6 +319,7 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
   }
 
   // Get UE configuration
+  ul_cfg = {};
   if (phy->ue_db.get_ul_config(rnti, cc_idx, ul_cfg) < SRSRAN_SUCCESS) {
     // It could happen that the UL configuration is missing due to intra-enb HO which is not an error
     Info("Failed retrieving UL configuration for cc=%d rnti=0x%x", cc_idx, rnti);
@@ -286,7 +327,7 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
   }
 
   // Fill UCI configuration
-  bool uci_required =
+  ctx.uci_required =
       phy->ue_db.fill_uci_cfg(tti_rx, cc_idx, rnti, ul_grant.dci.cqi_request, true, ul_cfg.pusch.uci_cfg);
 
   // Compute UL grant
@@ -317,61 +358,104 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
     Error("Error setting last UL TB for RNTI %x, CC %d, PID %d", rnti, cc_idx, ul_grant.pid);
   }
 
+  // Save PHICH scheduling for this user. Each user can have just 1 PUSCH dci per TTI
+  ue_db[rnti]->phich_grant.n_prb_lowest = grant.n_prb_tilde[0];
+  ue_db[rnti]->phich_grant.n_dmrs       = ul_grant.dci.n_dmrs;
+
+  ctx.grant = &ul_grant;
+  return true;
+}
+
+bool cc_worker::decode_pusch_rnti(pusch_ctx_t& ctx, srsran_pusch_res_t& pusch_res)
+{
+  stack_interface_phy_lte::ul_sched_grant_t& ul_grant = *ctx.grant;
+  srsran_ul_cfg_t&                           ul_cfg   = ctx.ul_cfg;
+  uint16_t                                   rnti     = ul_grant.dci.rnti;
+
   // Run PUSCH decoder
   ul_cfg.pusch.softbuffers.rx = ul_grant.softbuffer_rx;
   pusch_res.data              = ul_grant.data;
   if (pusch_res.data) {
+    stage_clock::time_point t = stage_start();
     if (srsran_enb_ul_get_pusch(&enb_ul, &ul_sf, &ul_cfg.pusch, &pusch_res)) {
       Error("Decoding PUSCH for RNTI %x", rnti);
       return false;
     }
-  }
-  // Save PHICH scheduling for this user. Each user can have just 1 PUSCH dci per TTI
-  ue_db[rnti]->phich_grant.n_prb_lowest = grant.n_prb_tilde[0];
-  ue_db[rnti]->phich_grant.n_dmrs       = ul_grant.dci.n_dmrs;
-
-  float snr_db = enb_ul.chest_res.snr_db;
-
-  // Notify MAC of RL status
-  if (snr_db >= PUSCH_RL_SNR_DB_TH) {
-    // Notify MAC UL channel quality
-    phy->stack->snr_info(ul_sf.tti, rnti, cc_idx, snr_db, mac_interface_phy_lte::PUSCH);
 
-    // Notify MAC of Time Alignment only if it enabled and valid measurement, ignore value otherwise
-    if (ul_cfg.pusch.meas_ta_en and not std::isnan(enb_ul.chest_res.ta_us) and not std::isinf(enb_ul.chest_res.ta_us)) {
-      phy->stack->ta_info(ul_sf.tti, rnti, enb_ul.chest_res.ta_us);
+    // The PUSCH decoder measures its own time, the remainder is spent in the channel estimator
+    if (stage_time_en) {
+      double pusch_us = 0.0;
+      stage_end(t, pusch_us);
+      double decode_us = std::min(pusch_us, (double)ul_cfg.pusch.meas_time_value);
+      double demod_us  = std::min(decode_us, (double)ul_cfg.pusch.meas_time_demod_value);
+      stage_times.pusch_chest_us += pusch_us - decode_us;
+      stage_times.pusch_demod_us += demod_us;
+      stage_times.pusch_decode_us += decode_us - demod_us;
+      stage_times.nof_pusch++;
     }
   }
 
-  // Send UCI data to MAC
-  if (uci_required) {
-    phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pusch.uci_cfg, pusch_res.uci);
-  }
-
   // Save statistics only if data was provided
-  if (ul_grant.data != nullptr) {
+  auto ue_it = ue_db.find(rnti);
+  if (ul_grant.data != nullptr and ue_it != ue_db.end()) {
     // Save metrics stats
-    ue_db[rnti]->metrics_ul(ul_grant.dci.tb.mcs_idx, 0, enb_ul.chest_res.snr_db, pusch_res.avg_iterations_block);
+    ue_it->second->metrics_ul(ul_grant.dci.tb.mcs_idx, 0, enb_ul.chest_res.snr_db, pusch_res.avg_iterations_block);
   }
   return true;
 }
 
-void cc_worker::decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch)
+void cc_worker::decode_pusch(ul_report_gate& gate)
 {
   // Iterate over all the grants, all the grants need to report MAC the CRC status
   for (uint32_t i = 0; i < nof_pusch; i++) {
+    // Once the gate is closed the results are discarded, skip the remaining grants
+    if (not gate.is_open()) {
+      return;
+    }
+
     // Get grant itself and RNTI
-    stack_interface_phy_lte::ul_sched_grant_t& ul_grant = grants[i];
+    pusch_ctx_t&                               ctx      = pusch_ctx[i];
+    stack_interface_phy_lte::ul_sched_grant_t& ul_grant = *ctx.grant;
+    srsran_ul_cfg_t&                           ul_cfg   = ctx.ul_cfg;
     uint16_t                                   rnti     = ul_grant.dci.rnti;
 
+    // The RNTI may have been removed since the grant was prepared
+    if (ue_db.count(rnti) == 0) {
+      continue;
+    }
+
     srsran_pusch_res_t pusch_res = {};
-    srsran_ul_cfg_t    ul_cfg    = {};
 
     // Decodes PUSCH for the given grant
-    if (!decode_pusch_rnti(ul_grant, ul_cfg, pusch_res)) {
+    if (!decode_pusch_rnti(ctx, pusch_res)) {
       return;
     }
 
+    // All the reports of the grant are delivered to the MAC, or none of them
+    ul_report_gate::guard report(gate);
+    if (not report.is_open()) {
+      return;
+    }
+
+    float snr_db = enb_ul.chest_res.snr_db;
+
+    // Notify MAC of RL status
+    if (snr_db >= PUSCH_RL_SNR_DB_TH) {
+      // Notify MAC UL channel quality
+      phy->stack->snr_info(ul_sf.tti, rnti, cc_idx, snr_db, mac_interface_phy_lte::PUSCH);
+
+      // Notify MAC of Time Alignment only if it enabled and valid measurement, ignore value otherwise
+      if (ul_cfg.pusch.meas_ta_en and not std::isnan(enb_ul.chest_res.ta_us) and
+          not std::isinf(enb_ul.chest_res.ta_us)) {
+        phy->stack->ta_info(ul_sf.tti, rnti, enb_ul.chest_res.ta_us);
+      }
+    }
+
+    // Send UCI data to MAC
+    if (ctx.uci_required) {
+      phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pusch.uci_cfg, pusch_res.uci);
+    }
+
     // Notify MAC new received data and HARQ Indication value
     if (ul_grant.data != nullptr) {
       // Inform MAC about the CRC result
@@ -389,7 +473,7 @@ void cc_worker::decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants,
   }
 }
 
-int cc_worker::decode_pucch()
+int cc_worker::decode_pucch(ul_report_gate& gate)
 {
   srsran_pucch_res_t pucch_res = {};
 
@@ -397,16 +481,21 @@ int cc_worker::decode_pucch()
     uint16_t rnti = iter.first;
 
     // If it's a User RNTI and doesn't have PUSCH grant in this TTI
-    if (SRSRAN_RNTI_ISUSER(rnti) and phy->ue_db.is_pcell(rnti, cc_idx)) {
-      srsran_ul_cfg_t ul_cfg = {};
-
-      if (phy->ue_db.get_ul_config(rnti, cc_idx, ul_cfg) < SRSRAN_SUCCESS) {
-        Error("Error retrieving last UL configuration for RNTI %x, CC %d", rnti, cc_idx);
-        continue;
+    if (SRSRAN_RNTI_ISUSER(rnti)) {
+      srsran_pucch_cfg_t pucch_cfg = {};
+
+      // Only the PUCCH configuration is copied from the snapshot, PUCCH is received in the PCell only
+      {
+        phy_ue_db::read_guard                 guard(phy->ue_db);
+        const phy_ue_db::cell_cfg_snapshot_t* cell_cfg = phy->ue_db.get_cfg_snapshot(rnti, cc_idx);
+        if (cell_cfg == nullptr or not cell_cfg->is_pcell) {
+          continue;
+        }
+        pucch_cfg = cell_cfg->ul_cfg.pucch;
       }
 
       // Check if user needs to receive PUCCH
-      int ret = phy->ue_db.fill_uci_cfg(tti_rx, cc_idx, rnti, false, false, ul_cfg.pucch.uci_cfg);
+      int ret = phy->ue_db.fill_uci_cfg(tti_rx, cc_idx, rnti, false, false, pucch_cfg.uci_cfg);
       if (ret < SRSRAN_SUCCESS) {
         Error("Error retrieving UCI configuration for RNTI %x, CC %d", rnti, cc_idx);
         continue;
@@ -415,31 +504,39 @@ int cc_worker::decode_pucch()
       // If ret is more than success, UCI is present
       if (ret > SRSRAN_SUCCESS) {
         // Decode PUCCH
-        if (srsran_enb_ul_get_pucch(&enb_ul, &ul_sf, &ul_cfg.pucch, &pucch_res)) {
+        if (srsran_enb_ul_get_pucch(&enb_ul, &ul_sf, &pucch_cfg, &pucch_res)) {
           Error("Error getting PUCCH");
           continue;
         }
 
-        // Send UCI data to MAC
-        if (phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pucch.uci_cfg, pucch_res.uci_data) < SRSRAN_SUCCESS) {
-          Error("Error sending UCI data for RNTI %x, CC %d", rnti, cc_idx);
-          continue;
-        }
-
-        if (pucch_res.detected and pucch_res.ta_valid) {
-          phy->stack->ta_info(tti_rx, rnti, pucch_res.ta_us);
-          phy->stack->snr_info(tti_rx, rnti, cc_idx, pucch_res.snr_db, mac_interface_phy_lte::PUCCH);
+        {
+          // Once the gate is closed the results are discarded, skip the remaining users
+          ul_report_gate::guard report(gate);
+          if (not report.is_open()) {
+            return SRSRAN_SUCCESS;
+          }
+
+          // Send UCI data to MAC
+          if (phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, pucch_cfg.uci_cfg, pucch_res.uci_data) < SRSRAN_SUCCESS) {
+            Error("Error sending UCI data for RNTI %x, CC %d", rnti, cc_idx);
+            continue;
+          }
+
+          if (pucch_res.detected and pucch_res.ta_valid) {
+            phy->stack->ta_info(tti_rx, rnti, pucch_res.ta_us);
+            phy->stack->snr_info(tti_rx, rnti, cc_idx, pucch_res.snr_db, mac_interface_phy_lte::PUCCH);
+          }
         }
 
         // Logging
         if (logger.info.enabled()) {
           char str[512];
-          srsran_pucch_rx_info(&ul_cfg.pucch, &pucch_res, str, sizeof(str));
+          srsran_pucch_rx_info(&pucch_cfg, &pucch_res, str, sizeof(str));
           logger.info("PUCCH: cc=%d; %s", cc_idx, str);
         }
 
         // Save metrics
-        ue_db[rnti]->metrics_ul_pucch(pucch_res.snr_db);
+        iter.second->metrics_ul_pucch(pucch_res.snr_db);
       }
     }
   }
@@ -626,7 +723,9 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
 /************ METRICS interface ********************/
 uint32_t cc_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock(ul_mutex, dl_mutex);
+  std::lock_guard<std::mutex> ul_lock(ul_mutex, std::adopt_lock);
+  std::lock_guard<std::mutex> dl_lock(dl_mutex, std::adopt_lock);
   uint32_t                    cnt = 0;
   metrics.resize(ue_db.size());
   for (auto& ue : ue_db) {
@@ -638,6 +737,36 @@ uint32_t cc_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
   return cnt;
 }
 
+void cc_worker::set_stage_timing(bool enable)
+{
+  std::lock(ul_mutex, dl_mutex);
+  std::lock_guard<std::mutex> ul_lock(ul_mutex, std::adopt_lock);
+  std::lock_guard<std::mutex> dl_lock(dl_mutex, std::adopt_lock);
+  stage_time_en = enable;
+  stage_times   = {};
+}
+
+void cc_worker::get_stage_times(phy_stage_times_t& times)
+{
+  std::lock(ul_mutex, dl_mutex);
+  std::lock_guard<std::mutex> ul_lock(ul_mutex, std::adopt_lock);
+  std::lock_guard<std::mutex> dl_lock(dl_mutex, std::adopt_lock);
+  times += stage_times;
+  stage_times = {};
+}
+
+cc_worker::stage_clock::time_point cc_worker::stage_start() const
+{
+  return stage_time_en ? stage_clock::now() : stage_clock::time_point();
+}
+
+void cc_worker::stage_end(const stage_clock::time_point& start, double& acc_us)
+{
+  if (stage_time_en) {
+    acc_us += std::chrono::duration<double, std::micro>(stage_clock::now() - start).count();
+  }
+}
+
 void cc_worker::ue::metrics_read(phy_metrics_t* metrics_)
 {
   if (metrics_) {
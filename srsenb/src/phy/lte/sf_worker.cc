@@ -72,9 +72,10 @@ namespace lte {
 FILE* f;
 #endif
 
-void sf_worker::init(phy_common* phy_)
+void sf_worker::init(phy_common* phy_, srsran::task_thread_pool* ul_pool_)
 {
-  phy = phy_;
+  phy     = phy_;
+  ul_pool = ul_pool_;
 
   // Initialise each component carrier workers
   for (uint32_t i = 0; i < phy->get_nof_carriers_lte(); i++) {
@@ -121,6 +122,11 @@ void sf_worker::set_context(const srsran::phy_common_interface::worker_context_t
   for (auto& w : cc_workers) {
     w->set_tti(w_ctx.sf_idx);
   }
+
+  // The subframe has just been received. The DL must be ready to transmit one subframe before its transmission time
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  ul_deadline = now + std::chrono::microseconds(phy->params.ul_deadline_us);
+  dl_deadline = now + std::chrono::milliseconds(FDD_HARQ_DELAY_UL_MS - 1);
 }
 
 int sf_worker::add_rnti(uint16_t rnti, uint32_t cc_idx)
@@ -151,7 +157,85 @@ void sf_worker::work_imp()
 {
   std::lock_guard<std::mutex> lock(work_mutex);
 
+  logger.set_context(tti_rx);
+
+  if (running) {
+    start_ul();
+  }
+
+  work_dl();
+
+  // The UL buffers and grants are reused by the next subframe, wait for the UL stage to finish with them
+  ul_gate.wait();
+
+#ifdef DEBUG_WRITE_FILE
+  fwrite(signal_buffer_tx, SRSRAN_SF_LEN_PRB(phy->cell.nof_prb) * sizeof(cf_t), 1, f);
+#endif
+
+#ifdef DEBUG_WRITE_FILE
+  if (tti_tx_dl == 10) {
+    fclose(f);
+    exit(-1);
+  }
+#endif
+
+  /* Tell the plotting thread to draw the plots */
+#ifdef ENABLE_GUI
+  if ((int)get_id() == plot_worker_id) {
+    sem_post(&plot_sem);
+  }
+#endif
+}
+
+void sf_worker::start_ul()
+{
   srsran_ul_sf_cfg_t ul_sf = {};
+
+  // Uplink grants to receive this TTI
+  ul_grants = phy->get_ul_grants(tti_rx);
+
+  // Configure UL subframe
+  ul_sf.tti = tti_rx;
+
+  // Set UL grant availability prior to any UL processing
+  if (phy->ue_db.set_ul_grant_available(tti_rx, ul_grants) < SRSRAN_SUCCESS) {
+    Info("Failed setting UL grants. Some grant's RNTI does not exist.");
+  }
+
+  // Prepare the UL grants, the DL needs their PHICH resources
+  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+    cc_workers[cc]->prepare_ul(ul_sf, ul_grants[cc]);
+  }
+
+  // Process UL, in parallel with the DL if there is a UL pool
+  ul_gate.start();
+  if (ul_pool != nullptr) {
+    ul_pool->push_task([this]() { work_ul(); });
+  } else {
+    work_ul();
+  }
+}
+
+void sf_worker::work_ul()
+{
+  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+    cc_workers[cc]->work_ul(ul_gate);
+  }
+
+  if (std::chrono::steady_clock::now() > ul_deadline) {
+    ul_deadline_miss++;
+  }
+
+  ul_gate.finish();
+}
+
+void sf_worker::work_dl()
+{
+  std::chrono::steady_clock::time_point t_start = {};
+  if (stage_time_en) {
+    t_start = std::chrono::steady_clock::now();
+  }
+
   srsran_dl_sf_cfg_t dl_sf = {};
 
   // Get Transmission buffers
@@ -166,8 +250,6 @@ void sf_worker::work_imp()
   srsran_mbsfn_cfg_t mbsfn_cfg;
   srsran_sf_t        sf_type = phy->is_mbsfn_sf(&mbsfn_cfg, tti_tx_dl) ? SRSRAN_SF_MBSFN : SRSRAN_SF_NORM;
 
-  // Uplink grants to receive this TTI
-  stack_interface_phy_lte::ul_sched_list_t ul_grants = phy->get_ul_grants(tti_rx);
   // Uplink grants to transmit this tti and receive in the future
   stack_interface_phy_lte::ul_sched_list_t ul_grants_tx = phy->get_ul_grants(tti_tx_ul);
 
@@ -176,22 +258,10 @@ void sf_worker::work_imp()
 
   stack_interface_phy_lte* stack = phy->stack;
 
-  logger.set_context(tti_rx);
-
   Debug("Worker %d running", get_id());
 
-  // Configure UL subframe
-  ul_sf.tti = tti_rx;
-
-  // Set UL grant availability prior to any UL processing
-  if (phy->ue_db.set_ul_grant_available(tti_rx, ul_grants) < SRSRAN_SUCCESS) {
-    Info("Failed setting UL grants. Some grant's RNTI does not exist.");
-  }
-
-  // Process UL
-  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
-  }
+  // The scheduler needs the UL feedback of this TTI, wait for it until the UL deadline at most
+  ul_gate.wait(ul_deadline);
 
   // Get DL scheduling for the TX TTI from MAC
   if (sf_type == SRSRAN_SF_NORM) {
@@ -244,26 +314,17 @@ void sf_worker::work_imp()
     }
   }
 
-  Debug("Sending to radio");
-  phy->worker_end(context, true, tx_buffer);
-
-#ifdef DEBUG_WRITE_FILE
-  fwrite(signal_buffer_tx, SRSRAN_SF_LEN_PRB(phy->cell.nof_prb) * sizeof(cf_t), 1, f);
-#endif
-
-#ifdef DEBUG_WRITE_FILE
-  if (tti_tx_dl == 10) {
-    fclose(f);
-    exit(-1);
+  if (std::chrono::steady_clock::now() > dl_deadline) {
+    dl_deadline_miss++;
   }
-#endif
 
-  /* Tell the plotting thread to draw the plots */
-#ifdef ENABLE_GUI
-  if ((int)get_id() == plot_worker_id) {
-    sem_post(&plot_sem);
+  if (stage_time_en) {
+    stage_times.sf_us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t_start).count();
+    stage_times.nof_sf++;
   }
-#endif
+
+  Debug("Sending to radio");
+  phy->worker_end(context, true, tx_buffer);
 }
 
 /************ METRICS interface ********************/
@@ -293,6 +354,32 @@ uint32_t sf_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
   return cnt;
 }
 
+void sf_worker::set_stage_timing(bool enable)
+{
+  std::lock_guard<std::mutex> lock(work_mutex);
+  stage_time_en = enable;
+  stage_times   = {};
+  for (auto& w : cc_workers) {
+    w->set_stage_timing(enable);
+  }
+}
+
+void sf_worker::get_stage_times(phy_stage_times_t& times)
+{
+  std::lock_guard<std::mutex> lock(work_mutex);
+  times += stage_times;
+  stage_times = {};
+  for (auto& w : cc_workers) {
+    w->get_stage_times(times);
+  }
+}
+
+void sf_worker::get_deadline_metrics(phy_deadline_metrics_t& metrics)
+{
+  metrics.ul_miss += ul_deadline_miss.exchange(0);
+  metrics.dl_miss += dl_deadline_miss.exchange(0);
+}
+
 void sf_worker::start_plot()
 {
 #ifdef ENABLE_GUI
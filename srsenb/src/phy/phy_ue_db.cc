@@ -20,9 +20,36 @@
  */
 
 #include "srsenb/hdr/phy/phy_ue_db.h"
+#include <algorithm>
+#include <thread>
 
 using namespace srsenb;
 
+phy_ue_db::read_guard::read_guard(const phy_ue_db& db_) : db(db_)
+{
+  // Register in the reader counter of the current epoch, the table must be loaded after registering
+  idx = db.cfg_epoch.load() & 1U;
+  db.cfg_readers[idx].fetch_add(1);
+}
+
+phy_ue_db::read_guard::~read_guard()
+{
+  db.cfg_readers[idx].fetch_sub(1);
+}
+
+phy_ue_db::phy_ue_db()
+{
+  for (std::atomic<uint32_t>& readers : cfg_readers) {
+    readers.store(0);
+  }
+  cfg_table.store(new cfg_table_t);
+}
+
+phy_ue_db::~phy_ue_db()
+{
+  delete cfg_table.exchange(nullptr);
+}
+
 void phy_ue_db::init(stack_interface_phy_lte*   stack_ptr,
                      const phy_args_t&          phy_args_,
                      const phy_cell_cfg_list_t& cell_cfg_list_)
@@ -163,7 +190,8 @@ inline int phy_ue_db::_assert_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const
 
 bool phy_ue_db::ue_has_cell(uint16_t rnti, uint32_t enb_cc_idx) const
 {
-  return _assert_enb_cc(rnti, enb_cc_idx) == SRSRAN_SUCCESS;
+  read_guard guard(*this);
+  return get_cfg_snapshot(rnti, enb_cc_idx) != nullptr;
 }
 
 inline int phy_ue_db::_assert_enb_pcell(uint16_t rnti, uint32_t enb_cc_idx) const
@@ -233,29 +261,98 @@ inline int phy_ue_db::_assert_cell_list_cfg() const
   return SRSRAN_SUCCESS;
 }
 
-inline int phy_ue_db::_get_rnti_config(uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg) const
+void phy_ue_db::_release_cfg_table(const cfg_table_t* table)
 {
-  srsran::phy_cfg_t default_cfg = {};
-  default_cfg.set_defaults();
-  default_cfg.dl_cfg.pdsch.rnti = rnti;
-  default_cfg.ul_cfg.pucch.rnti = rnti;
-  default_cfg.ul_cfg.pusch.rnti = rnti;
+  if (table == nullptr) {
+    return;
+  }
 
-  // Use default configuration for non-user C-RNTI
-  if (not SRSRAN_RNTI_ISUSER(rnti)) {
-    phy_cfg = default_cfg;
-    return SRSRAN_SUCCESS;
+  // Grace periods are serialised, the epoch must not be flipped concurrently
+  std::lock_guard<std::mutex> lock(cfg_release_mutex);
+
+  // Two flips are required, a reader may have read the epoch right before the first flip and registered after it
+  for (uint32_t i = 0; i < 2; i++) {
+    uint32_t old_idx = cfg_epoch.fetch_add(1) & 1U;
+    while (cfg_readers[old_idx].load() != 0) {
+      std::this_thread::yield();
+    }
   }
 
-  // Make sure the C-RNTI exists and the cell/carrier is configured
-  if (_assert_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
+  delete table;
+}
+
+const phy_ue_db::cfg_table_t* phy_ue_db::_publish_config_rnti(uint16_t rnti)
+{
+  // Build new snapshot from the current database state
+  std::shared_ptr<ue_cfg_snapshot_t> snapshot;
+  if (ue_db.count(rnti)) {
+    const common_ue& ue = ue_db.at(rnti);
+    snapshot            = std::make_shared<ue_cfg_snapshot_t>();
+    snapshot->rnti      = rnti;
+
+    for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
+      const cell_info_t&   cell_info = ue.cell_info[ue_cc_idx];
+      cell_cfg_snapshot_t& cell_cfg  = snapshot->cells[ue_cc_idx];
+
+      cell_cfg.active =
+          (cell_info.state == cell_state_primary or cell_info.state == cell_state_secondary_active);
+      cell_cfg.is_pcell   = (cell_info.state == cell_state_primary);
+      cell_cfg.enb_cc_idx = cell_info.enb_cc_idx;
+      cell_cfg.ue_cc_idx  = ue_cc_idx;
+      cell_cfg.dl_cfg     = cell_info.phy_cfg.dl_cfg;
+      cell_cfg.dci_dl_cfg = cell_info.phy_cfg.dl_cfg.dci;
+      cell_cfg.ul_cfg     = cell_info.phy_cfg.ul_cfg;
+      cell_cfg.dci_ul_cfg = cell_info.phy_cfg.dl_cfg.dci;
+
+      // The DL configuration must overwrite the use_tbs_index_alt value (for 256QAM) and the DCI configuration used for
+      // DL grants the multiple_csi_request_enabled value with the temporary values in case we are in the middle of a
+      // reconfiguration
+      if (ue_cc_idx == 0) {
+        cell_cfg.dl_cfg.pdsch.use_tbs_index_alt       = cell_info.stash_use_tbs_index_alt;
+        cell_cfg.dci_dl_cfg.multiple_csi_request_enabled = ue.stashed_multiple_csi_request_enabled;
+      }
+    }
   }
 
-  // Write the current configuration
-  uint32_t ue_cc_idx = _get_ue_cc_idx(rnti, enb_cc_idx);
-  phy_cfg            = ue_db.at(rnti).cell_info.at(ue_cc_idx).phy_cfg;
-  return SRSRAN_SUCCESS;
+  // Copy the current table replacing the RNTI entry
+  const cfg_table_t* old_table = cfg_table.load();
+  cfg_table_t*       new_table = new cfg_table_t;
+  new_table->reserve(old_table->size() + 1);
+  for (const auto& e : *old_table) {
+    if (e.first != rnti) {
+      new_table->push_back(e);
+    }
+  }
+  if (snapshot != nullptr) {
+    new_table->emplace_back(rnti, std::move(snapshot));
+  }
+  std::sort(new_table->begin(), new_table->end(), [](const cfg_table_t::value_type& a, const cfg_table_t::value_type& b) {
+    return a.first < b.first;
+  });
+
+  // Publish, the old table is released by the caller once the database mutex is unlocked
+  cfg_table.store(new_table);
+  return old_table;
+}
+
+const phy_ue_db::cell_cfg_snapshot_t* phy_ue_db::get_cfg_snapshot(uint16_t rnti, uint32_t enb_cc_idx) const
+{
+  const cfg_table_t* table = cfg_table.load();
+
+  auto it = std::lower_bound(
+      table->begin(), table->end(), rnti, [](const cfg_table_t::value_type& e, uint16_t r) { return e.first < r; });
+  if (it == table->end() or it->first != rnti) {
+    return nullptr;
+  }
+
+  // Find the lowest active serving cell index for the eNb cell/carrier
+  for (const cell_cfg_snapshot_t& cell_cfg : it->second->cells) {
+    if (cell_cfg.active and cell_cfg.enb_cc_idx == enb_cc_idx) {
+      return &cell_cfg;
+    }
+  }
+
+  return nullptr;
 }
 
 void phy_ue_db::clear_tti_pending_ack(uint32_t tti)
@@ -270,7 +367,7 @@ void phy_ue_db::clear_tti_pending_ack(uint32_t tti)
 
 void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_cfg_list_t& phy_cfg_list)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::unique_lock<std::mutex> lock(mutex);
 
   // Create new user if did not exist
   if (ue_db.count(rnti) == 0) {
@@ -342,11 +439,16 @@ void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_
   for (uint32_t ue_cc_idx = 0; ue_cc_idx < nof_cc; ue_cc_idx++) {
     ue.cell_info[ue_cc_idx].phy_cfg.dl_cfg.dci.multiple_csi_request_enabled = (_count_nof_configured_scell(rnti) > 0);
   }
+
+  // Publish the new configuration to the PHY workers
+  const cfg_table_t* old_table = _publish_config_rnti(rnti);
+  lock.unlock();
+  _release_cfg_table(old_table);
 }
 
 int phy_ue_db::rem_rnti(uint16_t rnti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::unique_lock<std::mutex> lock(mutex);
 
   if (ue_db.count(rnti) == 0) {
     return SRSRAN_ERROR;
@@ -354,6 +456,10 @@ int phy_ue_db::rem_rnti(uint16_t rnti)
 
   ue_db.erase(rnti);
 
+  const cfg_table_t* old_table = _publish_config_rnti(rnti);
+  lock.unlock();
+  _release_cfg_table(old_table);
+
   return SRSRAN_SUCCESS;
 }
 
@@ -371,7 +477,7 @@ uint32_t phy_ue_db::_count_nof_configured_scell(uint16_t rnti)
 
 int phy_ue_db::complete_config(uint16_t rnti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::unique_lock<std::mutex> lock(mutex);
 
   // Makes sure the RNTI exists
   if (_assert_rnti(rnti) != SRSRAN_SUCCESS) {
@@ -388,12 +494,16 @@ int phy_ue_db::complete_config(uint16_t rnti)
         ue_db[rnti].cell_info[ue_cc_idx].phy_cfg.dl_cfg.pdsch.use_tbs_index_alt;
   }
 
+  const cfg_table_t* old_table = _publish_config_rnti(rnti);
+  lock.unlock();
+  _release_cfg_table(old_table);
+
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::activate_deactivate_scell(uint16_t rnti, uint32_t ue_cc_idx, bool activate)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::unique_lock<std::mutex> lock(mutex);
 
   // Assert RNTI and SCell are valid
   if (_assert_ue_cc(rnti, ue_cc_idx) != SRSRAN_SUCCESS) {
@@ -410,79 +520,91 @@ int phy_ue_db::activate_deactivate_scell(uint16_t rnti, uint32_t ue_cc_idx, bool
   // Set scell state
   cell_info.state = (activate) ? cell_state_secondary_active : cell_state_secondary_inactive;
 
+  const cfg_table_t* old_table = _publish_config_rnti(rnti);
+  lock.unlock();
+  _release_cfg_table(old_table);
+
   return SRSRAN_SUCCESS;
 }
 
 bool phy_ue_db::is_pcell(uint16_t rnti, uint32_t enb_cc_idx) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  return _assert_enb_pcell(rnti, enb_cc_idx) == SRSRAN_SUCCESS;
+  read_guard                 guard(*this);
+  const cell_cfg_snapshot_t* cell_cfg = get_cfg_snapshot(rnti, enb_cc_idx);
+  return cell_cfg != nullptr and cell_cfg->is_pcell;
 }
 
 int phy_ue_db::get_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dl_cfg_t& dl_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  // Use default configuration for non-user C-RNTI
+  if (not SRSRAN_RNTI_ISUSER(rnti)) {
+    dl_cfg            = default_cfg.dl_cfg;
+    dl_cfg.pdsch.rnti = rnti;
+    return SRSRAN_SUCCESS;
+  }
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  read_guard                 guard(*this);
+  const cell_cfg_snapshot_t* cell_cfg = get_cfg_snapshot(rnti, enb_cc_idx);
+  if (cell_cfg == nullptr) {
     return SRSRAN_ERROR;
   }
-  dl_cfg = phy_cfg.dl_cfg;
+  dl_cfg = cell_cfg->dl_cfg;
 
-  // The DL configuration must overwrite the use_tbs_index_alt value (for 256QAM) with the temporary value
-  // in case we are in the middle of a reconfiguration
-  if (ue_db.count(rnti) && SRSRAN_RNTI_ISUSER(rnti)) {
-    uint32_t ue_cc_idx = _get_ue_cc_idx(rnti, enb_cc_idx);
-    if (ue_cc_idx == 0) {
-      dl_cfg.pdsch.use_tbs_index_alt = ue_db.at(rnti).cell_info[ue_cc_idx].stash_use_tbs_index_alt;
-    }
-  }
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::get_dci_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_cfg_t& dci_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  // Use default configuration for non-user C-RNTI
+  if (not SRSRAN_RNTI_ISUSER(rnti)) {
+    dci_cfg = default_cfg.dl_cfg.dci;
+    return SRSRAN_SUCCESS;
+  }
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  read_guard                 guard(*this);
+  const cell_cfg_snapshot_t* cell_cfg = get_cfg_snapshot(rnti, enb_cc_idx);
+  if (cell_cfg == nullptr) {
     return SRSRAN_ERROR;
   }
-  dci_cfg = phy_cfg.dl_cfg.dci;
+  dci_cfg = cell_cfg->dci_dl_cfg;
 
-  // The DCI configuration used for DL grants must overwrite the multiple_csi_request_enabled value with the
-  // temporary value in case we are in the middle of a reconfiguration
-  if (ue_db.count(rnti) && SRSRAN_RNTI_ISUSER(rnti)) {
-    uint32_t ue_cc_idx = _get_ue_cc_idx(rnti, enb_cc_idx);
-    if (ue_cc_idx == 0) {
-      dci_cfg.multiple_csi_request_enabled = ue_db.at(rnti).stashed_multiple_csi_request_enabled;
-    }
-  }
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::get_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_ul_cfg_t& ul_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  // Use default configuration for non-user C-RNTI
+  if (not SRSRAN_RNTI_ISUSER(rnti)) {
+    ul_cfg            = default_cfg.ul_cfg;
+    ul_cfg.pucch.rnti = rnti;
+    ul_cfg.pusch.rnti = rnti;
+    return SRSRAN_SUCCESS;
+  }
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  read_guard                 guard(*this);
+  const cell_cfg_snapshot_t* cell_cfg = get_cfg_snapshot(rnti, enb_cc_idx);
+  if (cell_cfg == nullptr) {
     return SRSRAN_ERROR;
   }
-  ul_cfg = phy_cfg.ul_cfg;
+  ul_cfg = cell_cfg->ul_cfg;
 
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::get_dci_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_cfg_t& dci_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  // Use default configuration for non-user C-RNTI
+  if (not SRSRAN_RNTI_ISUSER(rnti)) {
+    dci_cfg = default_cfg.dl_cfg.dci;
+    return SRSRAN_SUCCESS;
+  }
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  read_guard                 guard(*this);
+  const cell_cfg_snapshot_t* cell_cfg = get_cfg_snapshot(rnti, enb_cc_idx);
+  if (cell_cfg == nullptr) {
     return SRSRAN_ERROR;
   }
-  dci_cfg = phy_cfg.dl_cfg.dci;
+  dci_cfg = cell_cfg->dci_ul_cfg;
 
   return SRSRAN_SUCCESS;
 }
@@ -277,6 +277,7 @@ bool enb_stack_lte::get_metrics(stack_metrics_t* metrics)
     }
     rrc.get_metrics(metrics.rrc);
     s1ap.get_metrics(metrics.s1ap);
+    metrics.pool = srsran::get_byte_buffer_pool_metrics();
     if (not pending_stack_metrics.try_push(metrics)) {
       stack_logger.error("Unable to push metrics to queue");
     }
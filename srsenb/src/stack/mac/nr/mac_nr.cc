@@ -409,6 +409,17 @@ bool mac_nr::handle_uci_data(const uint16_t rnti, const srsran_uci_cfg_nr_t& cfg
     srsran::rwlock_read_guard rw_lock(rwmutex);
     if (ue_db.contains(rnti) && value.valid) {
       ue_db[rnti]->metrics_dl_cqi(cfg_, value.csi->wideband_cri_ri_pmi_cqi.cqi);
+
+      // The CSI is reported for the PCell of the UE
+      uint32_t cc = ue_db[rnti]->get_pcell_cc_idx();
+      for (uint32_t i = 0; i < cfg_.nof_csi; i++) {
+        // Skip if not supported CSI report
+        if (cfg_.csi[i].cfg.quantity != SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI or
+            cfg_.csi[i].cfg.freq_cfg != SRSRAN_CSI_REPORT_FREQ_WIDEBAND) {
+          continue;
+        }
+        sched.dl_cqi_info(rnti, cc, value.csi[i].wideband_cri_ri_pmi_cqi.cqi);
+      }
     }
   }
 
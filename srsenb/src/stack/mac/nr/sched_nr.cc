@@ -236,6 +236,11 @@ void sched_nr::dl_buffer_state(uint16_t rnti, uint32_t lcid, uint32_t newtx, uin
   });
 }
 
+void sched_nr::dl_cqi_info(uint16_t rnti, uint32_t cc, uint32_t cqi_value)
+{
+  sched_workers->enqueue_cc_feedback(rnti, cc, [cqi_value](ue_carrier& ue_cc) { ue_cc.dl_cqi = cqi_value; });
+}
+
 #define VERIFY_INPUT(cond, msg, ...)                                                                                   \
   do {                                                                                                                 \
     if (not(cond)) {                                                                                                   \
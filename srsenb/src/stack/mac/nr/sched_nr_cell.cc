@@ -229,9 +229,20 @@ int ra_sched::dl_rach_info(const dl_sched_rar_info_t& rar_info)
   return SRSRAN_SUCCESS;
 }
 
-bwp_ctxt::bwp_ctxt(const bwp_params_t& bwp_cfg) :
-  cfg(&bwp_cfg), ra(bwp_cfg), grid(bwp_cfg), data_sched(new sched_nr_time_rr())
-{}
+bwp_ctxt::bwp_ctxt(const bwp_params_t& bwp_cfg) : cfg(&bwp_cfg), ra(bwp_cfg), grid(bwp_cfg)
+{
+  if (bwp_cfg.sched_cfg.sched_policy == "time_pf") {
+    data_sched.reset(new sched_nr_time_pf(bwp_cfg));
+    bwp_cfg.logger.info("Using time-domain PF scheduling policy for cc=%d", bwp_cfg.cc);
+  } else {
+    if (bwp_cfg.sched_cfg.sched_policy != "time_rr") {
+      bwp_cfg.logger.error("Unknown NR scheduling policy \"%s\". Falling back to time_rr",
+                           bwp_cfg.sched_cfg.sched_policy.c_str());
+    }
+    data_sched.reset(new sched_nr_time_rr());
+    bwp_cfg.logger.info("Using time-domain RR scheduling policy for cc=%d", bwp_cfg.cc);
+  }
+}
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,170 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/nr/sched_nr_time_pf.h"
+#include "srsran/phy/utils/vector.h"
+#include <cmath>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/// Forgetting factor of the averaged served rate
+const static float pf_exp_avg_alpha = 0.01;
+
+/// Spectral efficiency (bit/RE) of each CQI index. See TS 38.214, Table 5.2.2.1-2
+const static std::array<float, 16> cqi_to_spectral_eff = {
+    0.0, 0.1523, 0.2344, 0.3770, 0.6016, 0.8770, 1.1758, 1.4766, 1.9141, 2.4063, 2.7305, 3.3223, 3.9023, 4.5234, 5.1152,
+    5.5547};
+
+sched_nr_time_pf::sched_nr_time_pf(const bwp_params_t& bwp_cfg_) : bwp_cfg(bwp_cfg_)
+{
+  if (not bwp_cfg.sched_cfg.sched_policy_args.empty()) {
+    fairness_coeff = std::stof(bwp_cfg.sched_cfg.sched_policy_args);
+  }
+}
+
+void sched_nr_time_pf::sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  retx_cands.size  = 0;
+  newtx_cands.size = 0;
+  for (auto& u : ue_db) {
+    slot_ue& ue = u.second;
+    if (ue.h_dl == nullptr) {
+      continue;
+    }
+    if (ue.h_dl->has_pending_retx(slot_alloc.get_tti_rx())) {
+      retx_cands.push_back(ue, expected_rate(ue.dl_cqi, ue.cfg->fixed_pdsch_mcs()), ue.served_rate->dl_avg_rate);
+    } else if (ue.h_dl->empty()) {
+      newtx_cands.push_back(ue, expected_rate(ue.dl_cqi, ue.cfg->fixed_pdsch_mcs()), ue.served_rate->dl_avg_rate);
+    }
+  }
+
+  // Start with retxs, and move on to new txs if none could be allocated
+  slot_ue* winner = alloc_best_candidate(retx_cands, true, slot_alloc);
+  if (winner == nullptr) {
+    winner = alloc_best_candidate(newtx_cands, true, slot_alloc);
+  }
+  update_avg_rates(true, winner);
+}
+
+void sched_nr_time_pf::sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  retx_cands.size  = 0;
+  newtx_cands.size = 0;
+  for (auto& u : ue_db) {
+    slot_ue& ue = u.second;
+    if (ue.h_ul == nullptr) {
+      continue;
+    }
+    if (ue.h_ul->has_pending_retx(slot_alloc.get_tti_rx())) {
+      retx_cands.push_back(ue, expected_rate(ue.ul_cqi, ue.cfg->fixed_pusch_mcs()), ue.served_rate->ul_avg_rate);
+    } else if (ue.h_ul->empty()) {
+      newtx_cands.push_back(ue, expected_rate(ue.ul_cqi, ue.cfg->fixed_pusch_mcs()), ue.served_rate->ul_avg_rate);
+    }
+  }
+
+  // Start with retxs, and move on to new txs if none could be allocated
+  slot_ue* winner = alloc_best_candidate(retx_cands, false, slot_alloc);
+  if (winner == nullptr) {
+    winner = alloc_best_candidate(newtx_cands, false, slot_alloc);
+  }
+  update_avg_rates(false, winner);
+}
+
+float sched_nr_time_pf::expected_rate(uint32_t cqi, int fixed_mcs) const
+{
+  if (fixed_mcs >= 0) {
+    // Link adaptation ignores the reported CQI. All UEs achieve the same rate per PRB
+    return bwp_cfg.cfg.rb_width;
+  }
+  // Note: CQI=0 means that no CSI report was received yet. Assume the most robust CQI in that case
+  cqi = std::min(std::max(cqi, 1u), (uint32_t)cqi_to_spectral_eff.size() - 1);
+  return cqi_to_spectral_eff[cqi] * bwp_cfg.cfg.rb_width;
+}
+
+void sched_nr_time_pf::compute_priorities(candidate_list& cands) const
+{
+  if (fairness_coeff != 1) {
+    for (uint32_t i = 0; i < cands.size; ++i) {
+      cands.avg_rate[i] = std::pow(cands.avg_rate[i], fairness_coeff);
+    }
+  }
+  // prio = r / R^fairness_coeff. UEs that were never served (R=0) get infinite priority
+  srsran_vec_div_fff(cands.inst_rate.data(), cands.avg_rate.data(), cands.prio.data(), cands.size);
+}
+
+slot_ue* sched_nr_time_pf::alloc_best_candidate(candidate_list& cands, bool is_dl, bwp_slot_allocator& slot_alloc)
+{
+  if (cands.size == 0) {
+    return nullptr;
+  }
+  compute_priorities(cands);
+
+  const prb_interval full_bwp{0, slot_alloc.cfg.cfg.rb_width};
+  for (uint32_t count = 0; count < cands.size; ++count) {
+    uint32_t idx = srsran_vec_max_fi(cands.prio.data(), cands.size);
+    if (cands.prio[idx] < 0) {
+      break;
+    }
+    cands.prio[idx] = -1; // Do not consider this candidate again
+    slot_ue&     ue = *cands.ues[idx];
+    alloc_result res;
+    if (is_dl) {
+      res = ue.h_dl->empty() ? slot_alloc.alloc_pdsch(ue, full_bwp) : slot_alloc.alloc_pdsch(ue, ue.h_dl->prbs());
+    } else {
+      res = ue.h_ul->empty() ? slot_alloc.alloc_pusch(ue, full_bwp) : slot_alloc.alloc_pusch(ue, ue.h_ul->prbs());
+    }
+    if (res == alloc_result::success) {
+      return &ue;
+    }
+  }
+  return nullptr;
+}
+
+void sched_nr_time_pf::update_avg_rates(bool is_dl, const slot_ue* winner)
+{
+  if (winner == nullptr) {
+    // No allocation took place in this slot (e.g. no DL/UL resources). Keep the history unchanged
+    return;
+  }
+  uint32_t alloc_bytes = (is_dl ? winner->h_dl->tbs() : winner->h_ul->tbs()) / 8;
+  for (candidate_list* cands : {&retx_cands, &newtx_cands}) {
+    for (uint32_t i = 0; i < cands->size; ++i) {
+      uint32_t bytes = cands->ues[i] == winner ? alloc_bytes : 0;
+      if (is_dl) {
+        cands->ues[i]->served_rate->save_dl_alloc(bytes, pf_exp_avg_alpha);
+      } else {
+        cands->ues[i]->served_rate->save_ul_alloc(bytes, pf_exp_avg_alpha);
+      }
+    }
+  }
+}
+
+void sched_nr_time_pf::candidate_list::push_back(slot_ue& ue, float r, float R)
+{
+  ues[size]       = &ue;
+  inst_rate[size] = r;
+  avg_rate[size]  = R;
+  size++;
+}
+
+} // namespace sched_nr_impl
+} // namespace srsenb
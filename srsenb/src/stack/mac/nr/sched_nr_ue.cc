@@ -26,6 +26,30 @@
 namespace srsenb {
 namespace sched_nr_impl {
 
+void ue_served_rate::save_dl_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
+{
+  if (dl_nof_samples < 1 / exp_avg_alpha) {
+    // fast start
+    dl_avg_rate = dl_avg_rate + (alloc_bytes - dl_avg_rate) / (dl_nof_samples + 1);
+  } else {
+    dl_avg_rate = (1 - exp_avg_alpha) * dl_avg_rate + (exp_avg_alpha)*alloc_bytes;
+  }
+  dl_nof_samples++;
+}
+
+void ue_served_rate::save_ul_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
+{
+  if (ul_nof_samples < 1 / exp_avg_alpha) {
+    // fast start
+    ul_avg_rate = ul_avg_rate + (alloc_bytes - ul_avg_rate) / (ul_nof_samples + 1);
+  } else {
+    ul_avg_rate = (1 - exp_avg_alpha) * ul_avg_rate + (exp_avg_alpha)*alloc_bytes;
+  }
+  ul_nof_samples++;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 slot_ue::slot_ue(uint16_t rnti_, slot_point slot_rx_, uint32_t cc_) : rnti(rnti_), slot_rx(slot_rx_), cc(cc_) {}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -57,6 +81,7 @@ slot_ue ue_carrier::try_reserve(slot_point pdcch_slot, uint32_t dl_pending_bytes
   sfu.cfg           = &bwp_cfg;
   sfu.pdcch_slot    = pdcch_slot;
   sfu.harq_ent      = &harq_ent;
+  sfu.served_rate   = &served_rate;
   const uint32_t k0 = 0;
   sfu.pdsch_slot    = sfu.pdcch_slot + k0;
   uint32_t k1       = sfu.cfg->get_k1(sfu.pdsch_slot);
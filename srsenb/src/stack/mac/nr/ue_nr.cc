@@ -39,6 +39,7 @@ ue_nr::ue_nr(uint16_t                rnti_,
              phy_interface_stack_nr* phy_,
              srslog::basic_logger&   logger_) :
   rnti(rnti_),
+  pcell_cc_idx(enb_cc_idx),
   sched(sched_),
   rrc(rrc_),
   rlc(rlc_),
@@ -91,6 +91,21 @@ int sched::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg)
     carrier_schedulers[i]->carrier_cfg(sched_cell_params[i]);
   }
 
+  // The calling thread schedules one of the carriers. The remaining ones are handed to the carrier workers
+  uint32_t nof_cc_workers = std::min(sched_cfg.nof_cc_workers, (uint32_t)sched_cell_params.size());
+  if (cc_workers != nullptr and (nof_cc_workers <= 1 or cc_workers->nof_workers() > nof_cc_workers - 1)) {
+    // The pool cannot shrink. Its workers are stopped, and a smaller pool is created below if one is still needed.
+    // No carrier task is pending, as new_tti_parallel() waits for all of them under the sched mutex
+    cc_workers.reset();
+  }
+  if (nof_cc_workers > 1) {
+    if (cc_workers == nullptr) {
+      cc_workers.reset(new srsran::task_thread_pool(nof_cc_workers - 1));
+    } else {
+      cc_workers->set_nof_workers(nof_cc_workers - 1);
+    }
+  }
+
   configured = true;
   return 0;
 }
@@ -355,13 +370,63 @@ void sched::new_tti(tti_point tti_rx)
 {
   last_tti = std::max(last_tti, tti_rx);
 
-  // Generate sched results for all CCs, if not yet generated
-  for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+  srsran::bounded_vector<uint32_t, SRSRAN_MAX_CARRIERS> cc_list;
+  for (uint32_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
     if (not is_generated(tti_rx, cc_idx)) {
-      // Generate carrier scheduling result
-      carrier_schedulers[cc_idx]->generate_tti_result(tti_rx);
+      cc_list.push_back(cc_idx);
     }
   }
+  if (cc_workers != nullptr and cc_list.size() > 1) {
+    new_tti_parallel(tti_rx, cc_list);
+    return;
+  }
+
+  // Generate sched results for all CCs, if not yet generated
+  for (uint32_t cc_idx : cc_list) {
+    // Generate carrier scheduling result
+    carrier_schedulers[cc_idx]->generate_tti_result(tti_rx);
+  }
+}
+
+/// Generate the scheduling decisions of several CCs for tti_rx, with the user data allocation of each CC running in
+/// a separate thread. The steps that access UE state shared across CCs (buffers, HARQs of other carriers, SCell
+/// activation) run sequentially, before and after the parallel region.
+/// NOTE: Given that all CCs see the same UE buffer state while allocating user data, the DL grants of a UE on
+///       different carriers may exceed its pending data. Grants that end up without data are discarded in finish_tti()
+void sched::new_tti_parallel(tti_point tti_rx, srsran::span<const uint32_t> cc_list)
+{
+  // Control allocations. This step also resets the TTI grids and results, before they are accessed concurrently
+  for (uint32_t cc_idx : cc_list) {
+    carrier_schedulers[cc_idx]->alloc_ctrl_tti(tti_rx);
+  }
+
+  // Parallel region. The calling thread handles the first carrier
+  {
+    std::lock_guard<std::mutex> lock(cc_workers_mutex);
+    nof_pending_cc_workers = cc_list.size() - 1;
+  }
+  for (uint32_t i = 1; i < cc_list.size(); ++i) {
+    carrier_sched* carrier = carrier_schedulers[cc_list[i]].get();
+    cc_workers->push_task([this, carrier, tti_rx]() {
+      carrier->alloc_users_tti(tti_rx);
+      std::lock_guard<std::mutex> lock(cc_workers_mutex);
+      if (--nof_pending_cc_workers == 0) {
+        cc_workers_cvar.notify_one();
+      }
+    });
+  }
+  carrier_schedulers[cc_list[0]]->alloc_users_tti(tti_rx);
+  {
+    std::unique_lock<std::mutex> lock(cc_workers_mutex);
+    while (nof_pending_cc_workers > 0) {
+      cc_workers_cvar.wait(lock);
+    }
+  }
+
+  // Generate the DCIs and update the UE state in carrier order
+  for (uint32_t cc_idx : cc_list) {
+    carrier_schedulers[cc_idx]->finish_tti(tti_rx, true);
+  }
 }
 
 /// Check if TTI result is generated
@@ -382,9 +382,14 @@ void sched::carrier_sched::set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs)
 
 const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_rx)
 {
-  sf_sched*        tti_sched = get_sf_sched(tti_rx);
-  sf_sched_result* sf_result = prev_sched_results->get_sf(tti_rx);
-  cc_sched_result* cc_result = sf_result->get_cc(enb_cc_idx);
+  alloc_ctrl_tti(tti_rx);
+  alloc_users_tti(tti_rx);
+  return finish_tti(tti_rx);
+}
+
+void sched::carrier_sched::alloc_ctrl_tti(tti_point tti_rx)
+{
+  sf_sched* tti_sched = get_sf_sched(tti_rx);
 
   bool dl_active = sf_dl_mask[tti_sched->get_tti_tx_dl().to_uint() % sf_dl_mask.size()] == 0;
 
@@ -412,6 +417,11 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
     sf_sched* sf_msg3_sched = get_sf_sched(tti_rx + MSG3_DELAY_MS);
     ra_sched_ptr->ul_sched(tti_sched, sf_msg3_sched);
   }
+}
+
+void sched::carrier_sched::alloc_users_tti(tti_point tti_rx)
+{
+  sf_sched* tti_sched = get_sf_sched(tti_rx);
 
   /* Prioritize PDCCH scheduling for DL and UL data in a RoundRobin fashion */
   if ((tti_rx.to_uint() % 2) == 0) {
@@ -424,9 +434,16 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
   if ((tti_rx.to_uint() % 2) == 1) {
     alloc_ul_users(tti_sched);
   }
+}
+
+const cc_sched_result& sched::carrier_sched::finish_tti(tti_point tti_rx, bool parallel)
+{
+  sf_sched*        tti_sched = get_sf_sched(tti_rx);
+  sf_sched_result* sf_result = prev_sched_results->get_sf(tti_rx);
+  cc_sched_result* cc_result = sf_result->get_cc(enb_cc_idx);
 
   /* Select the winner DCI allocation combination, store all the scheduling results */
-  tti_sched->generate_sched_results(*ue_db);
+  tti_sched->generate_sched_results(*ue_db, parallel);
 
   /* Reset ue harq pending ack state, clean-up blocked pids */
   for (auto& user : *ue_db) {
@@ -662,7 +662,8 @@ alloc_result sf_sched::alloc_phich(sched_ue* user)
 
 void sf_sched::set_dl_data_sched_result(const sf_cch_allocator::alloc_result_t& dci_result,
                                         sched_interface::dl_sched_res_t*        dl_result,
-                                        sched_ue_list&                          ue_list)
+                                        sched_ue_list&                          ue_list,
+                                        bool                                    drop_failed)
 {
   for (const auto& data_alloc : data_allocs) {
     dl_result->data.emplace_back();
@@ -694,7 +695,15 @@ void sf_sched::set_dl_data_sched_result(const sf_cch_allocator::alloc_result_t&
                      data_alloc.user_mask,
                      tbs,
                      user->get_pending_dl_bytes(cc_cfg->enb_cc_idx));
-      logger.warning("%s", srsran::to_c_str(str_buffer));
+      if (drop_failed and is_newtx and user->get_pending_dl_bytes(cc_cfg->enb_cc_idx) == 0) {
+        // Note: When carriers are scheduled in parallel, the UE buffer may have been emptied by another carrier
+        logger.info("%s", srsran::to_c_str(str_buffer));
+      } else {
+        logger.warning("%s", srsran::to_c_str(str_buffer));
+      }
+      if (drop_failed) {
+        dl_result->data.pop_back();
+      }
       continue;
     }
 
@@ -901,7 +910,7 @@ alloc_result sf_sched::alloc_msg3(sched_ue* user, const sched_interface::dl_sche
   return ret;
 }
 
-void sf_sched::generate_sched_results(sched_ue_list& ue_db)
+void sf_sched::generate_sched_results(sched_ue_list& ue_db, bool drop_failed_dl)
 {
   cc_sched_result* cc_result = cc_results->get_cc(cc_cfg->enb_cc_idx);
 
@@ -950,7 +959,7 @@ void sf_sched::generate_sched_results(sched_ue_list& ue_db)
     log_rar_allocation(cc_result->dl_sched_result.rar.back(), rar_alloc.alloc_data.rbg_range);
   }
 
-  set_dl_data_sched_result(dci_result, &cc_result->dl_sched_result, ue_db);
+  set_dl_data_sched_result(dci_result, &cc_result->dl_sched_result, ue_db, drop_failed_dl);
 
   set_ul_sched_result(dci_result, &cc_result->ul_sched_result, ue_db);
 
@@ -273,6 +273,7 @@ bool sched_cell_params_t::set_cfg(uint32_t                             enb_cc_id
   // Compute Common locations for DCI for each CFI
   for (uint32_t cfix = 0; cfix < SRSRAN_NOF_CFI; cfix++) {
     generate_cce_location(regs.get(), common_locations[cfix], cfix + 1);
+    generate_cce_candidates(common_locations[cfix], common_candidates[cfix]);
   }
   if (common_locations[sched_cfg->max_nof_ctrl_symbols - 1][2].empty()) {
     Error("SCHED: Current cfi=%d is not valid for broadcast (check scheduler.max_nof_ctrl_symbols in conf file).",
@@ -287,6 +288,7 @@ bool sched_cell_params_t::set_cfg(uint32_t                             enb_cc_id
   for (uint32_t cfi = 0; cfi < SRSRAN_NOF_CFI; cfi++) {
     for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
       generate_cce_location(regs.get(), rar_locations[sf_idx][cfi], cfi + 1, sf_idx);
+      generate_cce_candidates(rar_locations[sf_idx][cfi], rar_candidates[sf_idx][cfi]);
     }
   }
 
@@ -364,6 +366,17 @@ cce_frame_position_table generate_cce_location_table(uint16_t rnti, const sched_
   return dci_locations;
 }
 
+cce_frame_candidate_table generate_cce_candidate_table(const cce_frame_position_table& locations)
+{
+  cce_frame_candidate_table candidates = {};
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    for (uint32_t cfix = 0; cfix < SRSRAN_NOF_CFI; cfix++) {
+      generate_cce_candidates(locations[sf_idx][cfix], candidates[sf_idx][cfix]);
+    }
+  }
+  return candidates;
+}
+
 void generate_cce_location(srsran_regs_t*          regs_,
                            cce_cfi_position_table& locations,
                            uint32_t                cfi,
@@ -387,6 +400,22 @@ void generate_cce_location(srsran_regs_t*          regs_,
   }
 }
 
+void generate_cce_candidates(const cce_cfi_position_table& locations, cce_cfi_candidate_table& candidates)
+{
+  for (uint32_t l = 0; l < NOF_AGGR_LEVEL; ++l) {
+    uint32_t nof_cces = 1U << l;
+    candidates[l].clear();
+    for (uint32_t ncce : locations[l]) {
+      srsran_assert(ncce % nof_cces == 0, "PDCCH candidate ncce=%d not aligned to L=%d", ncce, nof_cces);
+      cce_candidate cand;
+      cand.ncce     = ncce;
+      cand.word_idx = ncce / 64;
+      cand.mask     = ((uint64_t(1) << nof_cces) - 1U) << (ncce % 64U);
+      candidates[l].push_back(cand);
+    }
+  }
+}
+
 /*******************************************************
  *            DCI-specific helper functions
  *******************************************************/
@@ -22,6 +22,7 @@
 #include "srsenb/hdr/stack/mac/sched_phy_ch/sf_cch_allocator.h"
 #include "srsenb/hdr/stack/mac/sched_grid.h"
 #include "srsran/srslog/bundled/fmt/format.h"
+#include <algorithm>
 
 namespace srsenb {
 
@@ -35,11 +36,16 @@ bool is_pucch_sr_collision(const srsran_pucch_cfg_t& ue_pucch_cfg, tti_point tti
 
 void sf_cch_allocator::init(const sched_cell_params_t& cell_params_)
 {
-  cc_cfg           = &cell_params_;
-  pucch_cfg_common = cc_cfg->pucch_cfg_common;
-  dci_record_list.reserve(16);
-  last_dci_dfs.reserve(16);
-  temp_dci_dfs.reserve(16);
+  cc_cfg = &cell_params_;
+
+  // Precompute the PUCCH PRB of the HARQ-ACK for each possible first CCE of a DL grant DCI
+  srsran_pucch_cfg_t pucch_cfg = cc_cfg->pucch_cfg_common;
+  uint32_t max_nof_cces = *std::max_element(cc_cfg->nof_cce_table.begin(), cc_cfg->nof_cce_table.end());
+  ncce_to_pucch_n_prb.fill(-1);
+  for (uint32_t ncce = 0; ncce < std::min(max_nof_cces, MAX_NOF_CCES); ++ncce) {
+    pucch_cfg.n_pucch         = ncce + pucch_cfg.N_pucch_1;
+    ncce_to_pucch_n_prb[ncce] = srsran_pucch_n_prb(&cc_cfg->cfg.cell, &pucch_cfg, 0);
+  }
 }
 
 void sf_cch_allocator::new_tti(tti_point tti_rx_)
@@ -50,20 +56,21 @@ void sf_cch_allocator::new_tti(tti_point tti_rx_)
   last_dci_dfs.clear();
   current_cfix     = cc_cfg->sched_cfg->min_nof_ctrl_symbols - 1;
   current_max_cfix = cc_cfg->sched_cfg->max_nof_ctrl_symbols - 1;
+  result_outdated  = true;
 }
 
-const cce_cfi_position_table*
-sf_cch_allocator::get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uint32_t cfix) const
+const cce_cfi_candidate_table*
+sf_cch_allocator::get_cce_candidates(alloc_type_t alloc_type, sched_ue* user, uint32_t cfix) const
 {
   switch (alloc_type) {
     case alloc_type_t::DL_BC:
     case alloc_type_t::DL_PCCH:
-      return &cc_cfg->common_locations[cfix];
+      return &cc_cfg->common_candidates[cfix];
     case alloc_type_t::DL_RAR:
-      return &cc_cfg->rar_locations[to_tx_dl(tti_rx).sf_idx()][cfix];
+      return &cc_cfg->rar_candidates[to_tx_dl(tti_rx).sf_idx()][cfix];
     case alloc_type_t::DL_DATA:
     case alloc_type_t::UL_DATA:
-      return user->get_locations(cc_cfg->enb_cc_idx, cfix + 1, to_tx_dl(tti_rx).sf_idx());
+      return user->get_cce_candidates(cc_cfg->enb_cc_idx, cfix + 1, to_tx_dl(tti_rx).sf_idx());
     default:
       break;
   }
@@ -72,7 +79,12 @@ sf_cch_allocator::get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uin
 
 bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sched_ue* user, bool has_pusch_grant)
 {
+  if (dci_record_list.full()) {
+    logger.info("SCHED: Maximum number of PDCCH allocations reached");
+    return false;
+  }
   temp_dci_dfs.clear();
+  nof_backtracks      = 0;
   uint32_t start_cfix = current_cfix;
 
   alloc_record record;
@@ -87,9 +99,9 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
     // start with an CFI that maximizes nof potential CCE locs
     uint32_t nof_locs = 0, lowest_cfix = current_cfix;
     for (uint32_t cfix_tmp = current_max_cfix; cfix_tmp > lowest_cfix; --cfix_tmp) {
-      const cce_cfi_position_table* dci_locs = get_cce_loc_table(record.alloc_type, record.user, cfix_tmp);
-      if ((*dci_locs)[record.aggr_idx].size() > nof_locs) {
-        nof_locs     = (*dci_locs)[record.aggr_idx].size();
+      const cce_cfi_candidate_table* dci_cands = get_cce_candidates(record.alloc_type, record.user, cfix_tmp);
+      if ((*dci_cands)[record.aggr_idx].size() > nof_locs) {
+        nof_locs     = (*dci_cands)[record.aggr_idx].size();
         current_cfix = cfix_tmp;
       } else {
         break;
@@ -104,6 +116,7 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
     if (success) {
       // DCI record allocation successful
       dci_record_list.push_back(record);
+      result_outdated = true;
 
       if (is_dl_ctrl_alloc(alloc_type)) {
         // Dynamic CFI not yet supported for DL control allocations, as coderate can be exceeded
@@ -117,7 +130,7 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
   } while (get_next_dfs());
 
   // Revert steps to initial state, before dci record allocation was attempted
-  last_dci_dfs.swap(temp_dci_dfs);
+  last_dci_dfs = temp_dci_dfs;
   current_cfix = start_cfix;
   return false;
 }
@@ -126,16 +139,19 @@ bool sf_cch_allocator::get_next_dfs()
 {
   do {
     uint32_t start_child_idx = 0;
-    if (last_dci_dfs.empty()) {
-      // If we reach root, increase CFI
+    if (last_dci_dfs.empty() or nof_backtracks >= MAX_DFS_BACKTRACKS) {
+      // If we reach root or the search budget for this CFI is exhausted, increase CFI
       current_cfix++;
       if (current_cfix > current_max_cfix) {
         return false;
       }
+      last_dci_dfs.clear();
+      nof_backtracks = 0;
     } else {
       // Attempt to re-add last tree node, but with a higher node child index
       start_child_idx = last_dci_dfs.back().dci_pos_idx + 1;
       last_dci_dfs.pop_back();
+      nof_backtracks++;
     }
     while (last_dci_dfs.size() < dci_record_list.size() and
            alloc_dfs_node(dci_record_list[last_dci_dfs.size()], start_child_idx)) {
@@ -149,70 +165,55 @@ bool sf_cch_allocator::get_next_dfs()
 
 bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start_dci_idx)
 {
-  // Get DCI Location Table
-  const cce_cfi_position_table* dci_locs = get_cce_loc_table(record.alloc_type, record.user, current_cfix);
-  if (dci_locs == nullptr or (*dci_locs)[record.aggr_idx].empty()) {
-    return false;
-  }
-  const cce_position_list& dci_pos_list = (*dci_locs)[record.aggr_idx];
-  if (start_dci_idx >= dci_pos_list.size()) {
+  // Get DCI candidate table
+  const cce_cfi_candidate_table* dci_cands = get_cce_candidates(record.alloc_type, record.user, current_cfix);
+  if (dci_cands == nullptr) {
     return false;
   }
+  const cce_candidate_list& cand_list = (*dci_cands)[record.aggr_idx];
 
-  tree_node node;
-  node.dci_pos_idx = start_dci_idx;
-  node.dci_pos.L   = record.aggr_idx;
-  node.rnti        = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
-  node.current_mask.resize(nof_cces());
   // get cumulative pdcch & pucch masks
+  dfs_node node;
   if (not last_dci_dfs.empty()) {
-    node.total_mask       = last_dci_dfs.back().total_mask;
-    node.total_pucch_mask = last_dci_dfs.back().total_pucch_mask;
-  } else {
-    node.total_mask.resize(nof_cces());
-    node.total_pucch_mask.resize(cc_cfg->nof_prb());
+    node = last_dci_dfs.back();
   }
+  node.pucch_n_prb = -1;
 
-  for (; node.dci_pos_idx < dci_pos_list.size(); ++node.dci_pos_idx) {
-    node.dci_pos.ncce = dci_pos_list[node.dci_pos_idx];
+  for (uint32_t idx = start_dci_idx; idx < cand_list.size(); ++idx) {
+    const cce_candidate& cand = cand_list[idx];
+    if ((node.total_mask[cand.word_idx] & cand.mask) != 0) {
+      // there is a PDCCH collision. Try another CCE position
+      continue;
+    }
 
     if (record.alloc_type == alloc_type_t::DL_DATA and not record.pusch_uci) {
       // The UE needs to allocate space in PUCCH for HARQ-ACK
-      pucch_cfg_common.n_pucch = node.dci_pos.ncce + pucch_cfg_common.N_pucch_1;
-
-      if (is_pucch_sr_collision(record.user->get_ue_cfg().pucch_cfg, to_tx_dl_ack(tti_rx), pucch_cfg_common.n_pucch)) {
+      uint32_t n1_pucch = cand.ncce + cc_cfg->pucch_cfg_common.N_pucch_1;
+      if (is_pucch_sr_collision(record.user->get_ue_cfg().pucch_cfg, to_tx_dl_ack(tti_rx), n1_pucch)) {
         // avoid collision of HARQ-ACK with own SR n(1)_pucch
         continue;
       }
 
-      node.pucch_n_prb = srsran_pucch_n_prb(&cc_cfg->cfg.cell, &pucch_cfg_common, 0);
-      if (not cc_cfg->sched_cfg->pucch_mux_enabled and node.total_pucch_mask.test(node.pucch_n_prb)) {
+      int      n_prb    = ncce_to_pucch_n_prb[cand.ncce];
+      uint64_t prb_mask = uint64_t(1) << (n_prb % 64U);
+      if (not cc_cfg->sched_cfg->pucch_mux_enabled and (node.total_pucch_mask[n_prb / 64] & prb_mask) != 0) {
         // PUCCH allocation would collide with other PUCCH/PUSCH grants. Try another CCE position
         continue;
       }
-      int low_rb = node.pucch_n_prb < (int)cc_cfg->cfg.cell.nof_prb / 2
-                       ? node.pucch_n_prb
-                       : cc_cfg->cfg.cell.nof_prb - node.pucch_n_prb - 1;
+      int low_rb = n_prb < (int)cc_cfg->cfg.cell.nof_prb / 2 ? n_prb : cc_cfg->cfg.cell.nof_prb - n_prb - 1;
       if (cc_cfg->sched_cfg->pucch_harq_max_rb > 0 && low_rb >= cc_cfg->sched_cfg->pucch_harq_max_rb) {
         // PUCCH allocation would fall outside the maximum allowed PUCCH HARQ region. Try another CCE position
-        logger.info("Skipping PDCCH allocation for CCE=%d due to PUCCH HARQ falling outside region\n",
-                    node.dci_pos.ncce);
+        logger.info("Skipping PDCCH allocation for CCE=%d due to PUCCH HARQ falling outside region\n", cand.ncce);
         continue;
       }
-    }
-
-    node.current_mask.reset();
-    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
-    if ((node.total_mask & node.current_mask).any()) {
-      // there is a PDCCH collision. Try another CCE position
-      continue;
+      node.pucch_n_prb = n_prb;
+      node.total_pucch_mask[n_prb / 64] |= prb_mask;
     }
 
     // Allocation successful
-    node.total_mask |= node.current_mask;
-    if (node.pucch_n_prb >= 0) {
-      node.total_pucch_mask.set(node.pucch_n_prb);
-    }
+    node.dci_pos_idx = idx;
+    node.ncce        = cand.ncce;
+    node.total_mask[cand.word_idx] |= cand.mask;
     last_dci_dfs.push_back(node);
     return true;
   }
@@ -227,25 +228,59 @@ void sf_cch_allocator::rem_last_dci()
   // Remove DCI record
   last_dci_dfs.pop_back();
   dci_record_list.pop_back();
+  result_outdated = true;
+}
+
+void sf_cch_allocator::update_result() const
+{
+  result_nodes.clear();
+  pdcch_mask_t total_mask(nof_cces());
+  prbmask_t    total_pucch_mask(cc_cfg->nof_prb());
+  for (uint32_t i = 0; i < last_dci_dfs.size(); ++i) {
+    const dfs_node&     path_node = last_dci_dfs[i];
+    const alloc_record& record    = dci_record_list[i];
+
+    result_nodes.emplace_back();
+    tree_node& node   = result_nodes.back();
+    node.pucch_n_prb  = path_node.pucch_n_prb;
+    node.rnti         = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
+    node.record_idx   = i;
+    node.dci_pos_idx  = path_node.dci_pos_idx;
+    node.dci_pos.L    = record.aggr_idx;
+    node.dci_pos.ncce = path_node.ncce;
+    node.current_mask.resize(nof_cces());
+    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
+    total_mask |= node.current_mask;
+    node.total_mask = total_mask;
+    if (node.pucch_n_prb >= 0) {
+      total_pucch_mask.set(node.pucch_n_prb);
+    }
+    node.total_pucch_mask = total_pucch_mask;
+  }
+  result_outdated = false;
 }
 
 void sf_cch_allocator::get_allocs(alloc_result_t* vec, pdcch_mask_t* tot_mask, size_t idx) const
 {
+  if (result_outdated) {
+    update_result();
+  }
+
   if (vec != nullptr) {
     vec->clear();
 
-    vec->resize(last_dci_dfs.size());
-    for (uint32_t i = 0; i < last_dci_dfs.size(); ++i) {
-      (*vec)[i] = &last_dci_dfs[i];
+    vec->resize(result_nodes.size());
+    for (uint32_t i = 0; i < result_nodes.size(); ++i) {
+      (*vec)[i] = &result_nodes[i];
     }
   }
 
   if (tot_mask != nullptr) {
-    if (last_dci_dfs.empty()) {
+    if (result_nodes.empty()) {
       tot_mask->resize(nof_cces());
       tot_mask->reset();
     } else {
-      *tot_mask = last_dci_dfs.back().total_mask;
+      *tot_mask = result_nodes.back().total_mask;
     }
   }
 }
@@ -256,14 +291,15 @@ std::string sf_cch_allocator::result_to_string(bool verbose) const
   if (dci_record_list.empty()) {
     fmt::format_to(strbuf, "SCHED: PDCCH allocations cfi={}, nof_cce={}, No allocations.\n", get_cfi(), nof_cces());
   } else {
+    alloc_result_t vec;
+    pdcch_mask_t   tot_mask;
+    get_allocs(&vec, &tot_mask);
     fmt::format_to(strbuf,
                    "SCHED: PDCCH allocations cfi={}, nof_cce={}, nof_allocs={}, total PDCCH mask=0x{:x}",
                    get_cfi(),
                    nof_cces(),
                    nof_allocs(),
-                   last_dci_dfs.back().total_mask);
-    alloc_result_t vec;
-    get_allocs(&vec);
+                   tot_mask);
     if (verbose) {
       fmt::format_to(strbuf, ", allocations:\n");
       for (const auto& dci_alloc : vec) {
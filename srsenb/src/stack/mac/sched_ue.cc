@@ -1044,6 +1044,16 @@ const cce_cfi_position_table* sched_ue::get_locations(uint32_t enb_cc_idx, uint3
   }
 }
 
+const cce_cfi_candidate_table* sched_ue::get_cce_candidates(uint32_t enb_cc_idx, uint32_t cfi, uint32_t sf_idx) const
+{
+  if (cfi > 0 && cfi <= 3) {
+    return &cells[enb_cc_idx].dci_candidates[sf_idx][cfi - 1];
+  } else {
+    logger.error("SCHED: Invalid CFI=%d", cfi);
+    return &cells[enb_cc_idx].dci_candidates[sf_idx][0];
+  }
+}
+
 sched_ue_cell* sched_ue::find_ue_carrier(uint32_t enb_cc_idx)
 {
   return cells[enb_cc_idx].configured() ? &cells[enb_cc_idx] : nullptr;
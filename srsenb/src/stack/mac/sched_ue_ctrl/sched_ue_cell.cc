@@ -43,6 +43,7 @@ sched_ue_cell::sched_ue_cell(uint16_t rnti_, const sched_cell_params_t& cell_cfg
   rnti(rnti_),
   cell_cfg(&cell_cfg_),
   dci_locations(generate_cce_location_table(rnti_, cell_cfg_)),
+  dci_candidates(generate_cce_candidate_table(dci_locations)),
   harq_ent(SCHED_MAX_HARQ_PROC, SCHED_MAX_HARQ_PROC),
   tpc_fsm(rnti_,
           cell_cfg->nof_prb(),
@@ -415,7 +415,8 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
   auto rx_callback = [this](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
     handle_gtpu_s1u_rx_packet(std::move(pdu), from);
   };
-  rx_socket_handler->add_socket_handler(fd, srsran::make_sdu_handler(logger, gtpu_queue, rx_callback));
+  rx_socket_handler->add_socket_handler_edge_triggered(fd,
+                                                      srsran::make_sdu_batch_handler(logger, gtpu_queue, rx_callback));
 
   // Start MCH socket if enabled
   if (args.embms_enable) {
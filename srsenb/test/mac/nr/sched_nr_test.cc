@@ -21,6 +21,7 @@
 
 #include "sched_nr_cfg_generators.h"
 #include "sched_nr_sim_ue.h"
+#include "srsenb/hdr/stack/mac/nr/sched_nr_time_pf.h"
 #include "srsran/common/phy_cfg_nr_default.h"
 #include "srsran/common/test_common.h"
 #include <chrono>
@@ -109,6 +110,138 @@ void run_sched_nr_test(uint32_t nof_workers)
   printf("Total time taken per slot: %f usec\n", final_avg_usec);
 }
 
+/// Tester that accounts the DL bytes allocated to each UE, to assess the throughput and fairness of a policy
+class sched_nr_policy_tester : public sched_nr_base_tester
+{
+public:
+  using sched_nr_base_tester::sched_nr_base_tester;
+
+  void process_slot_result(const sim_nr_enb_ctxt_t& slot_ctxt, srsran::const_span<cc_result_t> cc_list) override
+  {
+    for (auto& cc_out : cc_list) {
+      for (auto& pdsch : cc_out.dl_res.pdsch) {
+        auto it = ue_dl_bytes.find(pdsch.sch.grant.rnti);
+        if (it != ue_dl_bytes.end()) {
+          it->second += pdsch.sch.grant.tb[0].tbs / 8;
+        }
+      }
+    }
+  }
+
+  /// Jain's fairness index, (sum x)^2 / (N * sum x^2)
+  double jain_fairness() const
+  {
+    double sum = 0, sum_sq = 0;
+    for (auto& u : ue_dl_bytes) {
+      sum += u.second;
+      sum_sq += (double)u.second * u.second;
+    }
+    return sum_sq > 0 ? sum * sum / (ue_dl_bytes.size() * sum_sq) : 0;
+  }
+
+  uint64_t cell_dl_bytes() const
+  {
+    uint64_t sum = 0;
+    for (auto& u : ue_dl_bytes) {
+      sum += u.second;
+    }
+    return sum;
+  }
+
+  std::map<uint16_t, uint64_t> ue_dl_bytes;
+};
+
+void run_sched_nr_policy_test(const std::string& policy)
+{
+  uint32_t max_nof_ttis = 2000, nof_sectors = 1, nof_ues = 4;
+  uint16_t first_rnti   = 0x4601;
+
+  sched_nr_interface::sched_args_t cfg;
+  cfg.auto_refill_buffer = true;
+  cfg.sched_policy       = policy;
+
+  std::vector<sched_nr_interface::cell_cfg_t> cells_cfg = get_default_cells_cfg(nof_sectors);
+
+  sched_nr_policy_tester tester(cfg, cells_cfg, fmt::format("Policy {} Test", policy));
+
+  for (uint32_t nof_slots = 0; nof_slots < max_nof_ttis; ++nof_slots) {
+    slot_point slot_rx(0, nof_slots % 10240);
+    slot_point slot_tx = slot_rx + TX_ENB_DELAY;
+    if (slot_rx.to_uint() == 9) {
+      for (uint32_t i = 0; i < nof_ues; ++i) {
+        sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(nof_sectors);
+        tester.add_user(first_rnti + i, uecfg, slot_rx, i);
+        tester.ue_dl_bytes[first_rnti + i] = 0;
+      }
+    }
+    tester.run_slot(slot_tx);
+  }
+  tester.stop();
+
+  double fairness = tester.jain_fairness();
+  double mbps     = tester.cell_dl_bytes() * 8 / (double)max_nof_ttis / 1000.0;
+  printf("Policy %s: cell DL throughput: %.1f Mbps, Jain fairness: %.3f\n", policy.c_str(), mbps, fairness);
+  TESTASSERT(tester.cell_dl_bytes() > 0);
+  TESTASSERT(fairness > 0.9);
+}
+
+/// Two active UEs whose RNTIs are equal modulo the maximum number of UEs, as the MAC hands them out after UE churn,
+/// must keep separate PF histories
+void run_sched_nr_pf_rnti_collision_test()
+{
+  using namespace sched_nr_impl;
+  const std::array<uint16_t, 2> rntis = {0x4601, 0x4601 + SCHED_NR_MAX_USERS};
+
+  sched_nr_interface::sched_args_t sched_cfg{};
+  sched_cfg.auto_refill_buffer = true;
+  sched_cfg.sched_policy       = "time_pf";
+
+  std::vector<sched_nr_interface::cell_cfg_t> cells_cfg = get_default_cells_cfg(1);
+  sched_params                                schedparams{sched_cfg};
+  schedparams.cells.emplace_back(0, cells_cfg[0], sched_cfg);
+  const bwp_params_t& bwpparams = schedparams.cells[0].bwps[0];
+
+  std::unique_ptr<bwp_res_grid> res_grid(new bwp_res_grid{bwpparams});
+  bwp_slot_allocator            alloc(*res_grid);
+  sched_nr_time_pf              pf(bwpparams);
+
+  sched_nr_interface::ue_cfg_t      uecfg = get_default_ue_cfg(1);
+  std::vector<std::unique_ptr<ue> > ues;
+  for (uint16_t rnti : rntis) {
+    ues.emplace_back(new ue(rnti, uecfg, schedparams));
+  }
+
+  // The slot UE map cannot hold both UEs, so they take turns in the DL slots
+  slot_ue_map_t           slot_ues;
+  uint32_t                nof_dl_slots = 0;
+  std::array<uint32_t, 2> nof_allocs   = {};
+  for (slot_point pdcch_slot{0, TX_ENB_DELAY}; nof_dl_slots < 2 * 8; ++pdcch_slot) {
+    if (not bwpparams.slots[pdcch_slot.slot_idx()].is_dl) {
+      continue;
+    }
+    uint32_t ue_idx = nof_dl_slots++ % ues.size();
+    ue&      u      = *ues[ue_idx];
+    u.new_slot(pdcch_slot);
+    u.carriers[0]->new_slot(pdcch_slot);
+    slot_ues.clear();
+    slot_ue sfu = u.try_reserve(pdcch_slot, 0);
+    TESTASSERT(not sfu.empty());
+    slot_ues.insert(rntis[ue_idx], std::move(sfu));
+    alloc.new_slot(pdcch_slot, slot_ues);
+    pf.sched_dl_users(slot_ues, alloc);
+    nof_allocs[ue_idx] += (*res_grid)[pdcch_slot].pdschs.size();
+    (*res_grid)[pdcch_slot].reset();
+  }
+
+  // Every allocation of a UE adds to its own history, without being reset by the other UE
+  for (uint32_t i = 0; i < ues.size(); ++i) {
+    const ue_served_rate& rate = ues[i]->carriers[0]->served_rate;
+    TESTASSERT(nof_allocs[i] > 1);
+    TESTASSERT_EQ(nof_allocs[i], rate.dl_nof_samples);
+    TESTASSERT(rate.dl_avg_rate > 0);
+  }
+}
+
 } // namespace srsenb
 
 int main()
@@ -126,4 +259,8 @@ int main()
   srsenb::run_sched_nr_test(1);
   srsenb::run_sched_nr_test(2);
   srsenb::run_sched_nr_test(4);
+
+  srsenb::run_sched_nr_policy_test("time_rr");
+  srsenb::run_sched_nr_policy_test("time_pf");
+  srsenb::run_sched_nr_pf_rnti_collision_test();
 }
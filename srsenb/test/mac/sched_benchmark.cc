@@ -21,6 +21,7 @@
 
 #include "sched_test_common.h"
 #include "srsenb/hdr/stack/mac/sched.h"
+#include "srsenb/hdr/stack/mac/sched_grid.h"
 #include "srsran/adt/accumulators.h"
 #include "srsran/common/common_lte.h"
 #include <chrono>
@@ -296,6 +297,100 @@ void print_benchmark_results(const std::vector<run_data>& run_results)
   }
 }
 
+struct pdcch_run_data {
+  uint32_t                 nof_prbs;
+  uint32_t                 nof_ues;
+  float                    avg_nof_allocs;
+  std::chrono::nanoseconds avg_latency;
+  std::chrono::nanoseconds q0_9_latency;
+};
+
+/// Measures the time taken by the PDCCH allocator to place the DL and UL DCIs of all UEs in a TTI
+int run_pdcch_benchmark_scenario(uint32_t                     nof_prbs,
+                                 uint32_t                     nof_ues,
+                                 uint32_t                     nof_ttis,
+                                 std::vector<pdcch_run_data>& run_results)
+{
+  std::vector<sched_cell_params_t> cell_params(1);
+  sched_interface::ue_cfg_t        ue_cfg = generate_default_ue_cfg();
+  sched_interface::sched_args_t    sched_args{};
+  TESTASSERT(cell_params[0].set_cfg(0, generate_default_cell_cfg(nof_prbs), sched_args));
+
+  std::vector<std::unique_ptr<sched_ue>> ues;
+  for (uint32_t ue_idx = 0; ue_idx < nof_ues; ++ue_idx) {
+    ues.emplace_back(new sched_ue(0x46 + ue_idx, cell_params, ue_cfg));
+  }
+  sf_cch_allocator pdcch;
+  pdcch.init(cell_params[0]);
+
+  srsran::rolling_average<double>  avg_latency, avg_nof_allocs;
+  std::vector<uint32_t>            latency_samples;
+  std::vector<uint32_t>            aggr_idxs(nof_ues);
+  sf_cch_allocator::alloc_result_t dci_result;
+  pdcch_mask_t                     pdcch_mask;
+  latency_samples.reserve(nof_ttis);
+  for (uint32_t count = 0; count < nof_ttis; ++count) {
+    tti_point tti_rx{count % 10240};
+    for (uint32_t& aggr_idx : aggr_idxs) {
+      aggr_idx = std::uniform_int_distribution<uint32_t>{0, 2}(get_rand_gen());
+    }
+
+    std::chrono::time_point<std::chrono::steady_clock> tp = std::chrono::steady_clock::now();
+    pdcch.new_tti(tti_rx);
+    for (uint32_t ue_idx = 0; ue_idx < nof_ues; ++ue_idx) {
+      pdcch.alloc_dci(alloc_type_t::DL_DATA, aggr_idxs[ue_idx], ues[ue_idx].get());
+    }
+    for (uint32_t ue_idx = 0; ue_idx < nof_ues; ++ue_idx) {
+      pdcch.alloc_dci(alloc_type_t::UL_DATA, aggr_idxs[ue_idx], ues[ue_idx].get());
+    }
+    pdcch.get_allocs(&dci_result, &pdcch_mask);
+    std::chrono::time_point<std::chrono::steady_clock> tp2 = std::chrono::steady_clock::now();
+    std::chrono::nanoseconds tdur = std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp);
+
+    avg_latency.push(tdur.count());
+    latency_samples.push_back(tdur.count());
+    avg_nof_allocs.push(dci_result.size());
+  }
+  std::sort(latency_samples.begin(), latency_samples.end());
+
+  pdcch_run_data run_result = {};
+  run_result.nof_prbs       = nof_prbs;
+  run_result.nof_ues        = nof_ues;
+  run_result.avg_nof_allocs = avg_nof_allocs.value();
+  run_result.avg_latency    = std::chrono::nanoseconds(static_cast<int>(avg_latency.value()));
+  run_result.q0_9_latency   = std::chrono::nanoseconds(latency_samples[static_cast<size_t>(nof_ttis * 0.9)]);
+  run_results.push_back(run_result);
+
+  return SRSRAN_SUCCESS;
+}
+
+int run_pdcch_benchmark(uint32_t nof_ttis)
+{
+  fmt::print("\n====== PDCCH Allocation Benchmark ======\n\n");
+  std::vector<pdcch_run_data> run_results;
+  for (uint32_t nof_prbs : {6, 25, 100}) {
+    for (uint32_t nof_ues : {1, 4, 8}) {
+      TESTASSERT(run_pdcch_benchmark_scenario(nof_prbs, nof_ues, nof_ttis, run_results) == SRSRAN_SUCCESS);
+    }
+  }
+
+  srslog::flush();
+  fmt::print("run | Nprb | Nue | DCIs/TTI | PDCCH alloc [nsec] | PDCCH alloc q0.9 [nsec]\n");
+  fmt::print("--------------------------------------------------------------------------\n");
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    const pdcch_run_data& r = run_results[i];
+    fmt::print("{:>3d}{:>7d}{:>6d}{:>11.1f}{:>21d}{:>26d}\n",
+               i,
+               r.nof_prbs,
+               r.nof_ues,
+               r.avg_nof_allocs,
+               r.avg_latency.count(),
+               r.q0_9_latency.count());
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int run_rate_test()
 {
   fmt::print("\n====== Scheduler Rate Test ======\n\n");
@@ -422,10 +517,13 @@ int main(int argc, char* argv[])
 
   if (argc == 1 or strcmp(argv[1], "test") == 0) {
     TESTASSERT(srsenb::run_rate_test() == SRSRAN_SUCCESS);
+    TESTASSERT(srsenb::run_pdcch_benchmark(1000) == SRSRAN_SUCCESS);
   } else if (strcmp(argv[1], "benchmark") == 0) {
     TESTASSERT(srsenb::run_benchmark() == SRSRAN_SUCCESS);
+    TESTASSERT(srsenb::run_pdcch_benchmark(100000) == SRSRAN_SUCCESS);
   } else {
     TESTASSERT(srsenb::run_all() == SRSRAN_SUCCESS);
+    TESTASSERT(srsenb::run_pdcch_benchmark(100000) == SRSRAN_SUCCESS);
   }
 
   return 0;
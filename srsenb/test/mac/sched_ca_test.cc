@@ -19,11 +19,14 @@
  *
  */
 
+#include "sched_sim_ue.h"
 #include "sched_test_common.h"
 #include "sched_test_utils.h"
 #include "srsenb/hdr/stack/mac/sched.h"
+#include "srsran/adt/accumulators.h"
 #include "srsran/common/common_lte.h"
 #include "srsran/mac/pdu.h"
+#include <chrono>
 
 using namespace srsenb;
 
@@ -62,16 +65,21 @@ sim_sched_args generate_default_sim_args(uint32_t nof_prb, uint32_t nof_ccs)
 
   sim_args.default_ue_sim_cfg.ue_cfg = generate_default_ue_cfg2();
 
-  // setup two cells
+  // setup cells. Each cell can be used as SCell of any other cell
   std::vector<srsenb::sched_interface::cell_cfg_t> cell_cfg(nof_ccs, generate_default_cell_cfg(nof_prb));
-  cell_cfg[0].scell_list.resize(1);
-  cell_cfg[0].scell_list[0].enb_cc_idx               = 1;
-  cell_cfg[0].scell_list[0].cross_carrier_scheduling = false;
-  cell_cfg[0].scell_list[0].ul_allowed               = true;
-  cell_cfg[1].cell.id                                = 2; // id=2
-  cell_cfg[1].scell_list                             = cell_cfg[0].scell_list;
-  cell_cfg[1].scell_list[0].enb_cc_idx               = 0;
-  sim_args.cell_cfg                                  = std::move(cell_cfg);
+  for (uint32_t i = 0; i < nof_ccs; ++i) {
+    cell_cfg[i].cell.id = i + 1;
+    for (uint32_t j = 0; j < nof_ccs; ++j) {
+      if (i != j) {
+        srsenb::sched_interface::cell_cfg_t::scell_cfg_t scell = {};
+        scell.enb_cc_idx                                       = j;
+        scell.cross_carrier_scheduling                         = false;
+        scell.ul_allowed                                       = true;
+        cell_cfg[i].scell_list.push_back(scell);
+      }
+    }
+  }
+  sim_args.cell_cfg = std::move(cell_cfg);
 
   /* Setup Derived Params */
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list.resize(nof_ccs);
@@ -84,7 +92,8 @@ sim_sched_args generate_default_sim_args(uint32_t nof_prb, uint32_t nof_ccs)
 }
 
 struct test_scell_activation_params {
-  uint32_t pcell_idx = 0;
+  uint32_t pcell_idx      = 0;
+  uint32_t nof_cc_workers = 1;
 };
 
 int test_scell_activation(uint32_t sim_number, test_scell_activation_params params)
@@ -112,7 +121,8 @@ int test_scell_activation(uint32_t sim_number, test_scell_activation_params para
 
   /* Setup simulation arguments struct */
   sim_sched_args sim_args = generate_default_sim_args(nof_prb, nof_ccs);
-  sim_args.start_tti      = start_tti;
+  sim_args.start_tti                 = start_tti;
+  sim_args.sched_args.nof_cc_workers = params.nof_cc_workers;
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list.resize(1);
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list[0].active                                = true;
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list[0].enb_cc_idx                            = cc_idxs[0];
@@ -241,7 +251,191 @@ int test_scell_activation(uint32_t sim_number, test_scell_activation_params para
   return SRSRAN_SUCCESS;
 }
 
-int main()
+/******************************
+ *   Carrier Latency Benchmark
+ *****************************/
+
+/// Simulator of UEs with full buffer in all their carriers, used to measure the scheduling latency
+class sched_ca_latency_tester : public sched_sim_base
+{
+public:
+  sched_ca_latency_tester(sched*                                          sched_obj_,
+                          const sched_interface::sched_args_t&            sched_args,
+                          const std::vector<sched_interface::cell_cfg_t>& cell_cfg_list) :
+    sched_sim_base(sched_obj_, sched_args, cell_cfg_list),
+    sched_ptr(sched_obj_),
+    dl_result(cell_cfg_list.size()),
+    ul_result(cell_cfg_list.size())
+  {}
+
+  void advance_tti()
+  {
+    tti_point tti_rx = get_tti_rx().is_valid() ? get_tti_rx() + 1 : tti_point(0);
+    srslog::fetch_basic_logger("MAC").set_context(tti_rx.to_uint());
+    new_tti(tti_rx);
+
+    // The scheduling decisions of all carriers are taken in the first dl_sched call of the TTI
+    auto tp = std::chrono::steady_clock::now();
+    for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
+      sched_ptr->dl_sched(to_tx_dl(tti_rx).to_uint(), cc, dl_result[cc]);
+      sched_ptr->ul_sched(to_tx_ul(tti_rx).to_uint(), cc, ul_result[cc]);
+    }
+    auto tdur = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+    avg_latency.push(tdur.count());
+    latency_samples.push_back(tdur.count());
+
+    sf_output_res_t sf_out{get_cell_params(), tti_rx, ul_result, dl_result};
+    update(sf_out);
+    for (const auto& dl_res : dl_result) {
+      for (const auto& data : dl_res.data) {
+        dl_bytes += data.tbs[0] + data.tbs[1];
+      }
+    }
+  }
+
+  void set_external_tti_events(const sim_ue_ctxt_t& ue_ctxt, ue_tti_events& pending_events) override
+  {
+    if (ue_ctxt.conres_rx) {
+      sched_ptr->ul_bsr(ue_ctxt.rnti, 1, 100000);
+      sched_ptr->dl_rlc_buffer_state(ue_ctxt.rnti, 3, 100000, 0);
+      if (get_tti_rx().to_uint() % 5 == 0) {
+        for (auto& cc : pending_events.cc_list) {
+          cc.dl_cqi = 15;
+          cc.ul_snr = 40;
+        }
+      }
+    }
+  }
+
+  void reset_stats()
+  {
+    avg_latency = {};
+    latency_samples.clear();
+    dl_bytes = 0;
+  }
+
+  sched*                                       sched_ptr;
+  std::vector<sched_interface::dl_sched_res_t> dl_result;
+  std::vector<sched_interface::ul_sched_res_t> ul_result;
+  srsran::rolling_average<double>              avg_latency;
+  std::vector<uint64_t>                        latency_samples;
+  uint64_t                                     dl_bytes = 0;
+};
+
+/// Reconfigures the cells, so that the number of carrier scheduling workers grows, shrinks and goes back to one
+int test_cc_workers_reconfiguration()
+{
+  sim_sched_args sim_args            = generate_default_sim_args(6, 4);
+  sim_args.sched_args.nof_cc_workers = 4;
+
+  sched     sched_obj;
+  rrc_dummy rrc{};
+  sched_obj.init(&rrc, sim_args.sched_args);
+
+  sched_interface::dl_sched_res_t dl_res;
+  sched_interface::ul_sched_res_t ul_res;
+  uint32_t                        tti = 0;
+  for (uint32_t nof_ccs : {4, 2, 1, 3, 1}) {
+    std::vector<sched_interface::cell_cfg_t> cell_cfg(sim_args.cell_cfg.begin(), sim_args.cell_cfg.begin() + nof_ccs);
+    TESTASSERT(sched_obj.cell_cfg(cell_cfg) == SRSRAN_SUCCESS);
+    for (uint32_t i = 0; i < 20; ++i, tti = TTI_ADD(tti, 1)) {
+      for (uint32_t cc = 0; cc < nof_ccs; ++cc) {
+        TESTASSERT(sched_obj.dl_sched(tti, cc, dl_res) == SRSRAN_SUCCESS);
+        TESTASSERT(sched_obj.ul_sched(tti, cc, ul_res) == SRSRAN_SUCCESS);
+      }
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/// Measures the time taken to generate the scheduling decisions of all carriers of a TTI, as a function of the number
+/// of carriers and of carrier scheduling workers. All UEs have all carriers configured and active
+int run_ca_latency_scenario(uint32_t nof_ccs, uint32_t nof_cc_workers, uint32_t nof_ues, uint32_t nof_ttis)
+{
+  const uint32_t nof_prb             = 100;
+  sim_sched_args sim_args            = generate_default_sim_args(nof_prb, nof_ccs);
+  sim_args.sched_args.nof_cc_workers = nof_cc_workers;
+
+  sched     sched_obj;
+  rrc_dummy rrc{};
+  sched_obj.init(&rrc, sim_args.sched_args);
+  sched_ca_latency_tester tester(&sched_obj, sim_args.sched_args, sim_args.cell_cfg);
+
+  // Add users with only the PCell. SCells are added once the UEs are connected
+  std::vector<uint16_t>     rntis;
+  sched_interface::ue_cfg_t ue_cfg = generate_default_ue_cfg2();
+  for (uint32_t ue_idx = 0; ue_idx < nof_ues; ++ue_idx) {
+    uint16_t rnti = 0x46 + ue_idx;
+    ue_cfg.supported_cc_list.resize(1);
+    ue_cfg.supported_cc_list[0].active                                = true;
+    ue_cfg.supported_cc_list[0].enb_cc_idx                            = ue_idx % nof_ccs;
+    ue_cfg.supported_cc_list[0].dl_cfg.cqi_report.periodic_configured = true;
+    ue_cfg.supported_cc_list[0].dl_cfg.cqi_report.pmi_idx             = 37;
+    while (not srsran_prach_tti_opportunity_config_fdd(
+        tester.get_cell_params()[ue_idx % nof_ccs].cfg.prach_config, tester.get_tti_rx().to_uint(), -1)) {
+      tester.advance_tti();
+    }
+    TESTASSERT(tester.add_user(rnti, ue_cfg, 16) == SRSRAN_SUCCESS);
+    rntis.push_back(rnti);
+    tester.advance_tti();
+  }
+  auto all_connected = [&tester, &rntis]() {
+    return std::all_of(rntis.begin(), rntis.end(), [&tester](uint16_t rnti) {
+      return tester.at(rnti).get_ctxt().conres_rx;
+    });
+  };
+  while (not all_connected()) {
+    tester.advance_tti();
+  }
+  for (uint16_t rnti : rntis) {
+    sched_interface::ue_cfg_t ue_recfg = tester.at(rnti).get_ctxt().ue_cfg;
+    uint32_t                  pcell    = ue_recfg.supported_cc_list[0].enb_cc_idx;
+    for (uint32_t i = 1; i < nof_ccs; ++i) {
+      ue_recfg.supported_cc_list.push_back(ue_recfg.supported_cc_list[0]);
+      ue_recfg.supported_cc_list.back().enb_cc_idx                = (pcell + i) % nof_ccs;
+      ue_recfg.supported_cc_list.back().dl_cfg.cqi_report.pmi_idx = 37 + 2 * i; // avoid CQI collisions
+    }
+    TESTASSERT(tester.ue_recfg(rnti, ue_recfg) == SRSRAN_SUCCESS);
+  }
+  // Give time for the SCell activation CEs to be acked
+  for (uint32_t i = 0; i < 100; ++i) {
+    tester.advance_tti();
+  }
+
+  tester.reset_stats();
+  tester.latency_samples.reserve(nof_ttis);
+  for (uint32_t i = 0; i < nof_ttis; ++i) {
+    tester.advance_tti();
+  }
+  std::sort(tester.latency_samples.begin(), tester.latency_samples.end());
+
+  printf("| %6u | %7u | %5u | %12.1f | %12.1f | %14.1f |\n",
+         nof_ccs,
+         nof_cc_workers,
+         nof_ues,
+         tester.avg_latency.value() / 1000,
+         tester.latency_samples[tester.latency_samples.size() * 9 / 10] / 1000.0,
+         tester.dl_bytes * 8 / (nof_ttis * 1e-3) / 1e6);
+  return SRSRAN_SUCCESS;
+}
+
+int run_ca_latency_benchmark(uint32_t nof_ttis)
+{
+  printf("\nScheduling latency per TTI vs number of carriers:\n");
+  printf("| nof_cc | workers | #UEs  | avg lat [us] | p90 lat [us] | DL tput [Mbps] |\n");
+  printf("|--------|---------|-------|--------------|--------------|----------------|\n");
+  for (uint32_t nof_ues : {4, 16}) {
+    for (uint32_t nof_ccs = 1; nof_ccs <= 4; ++nof_ccs) {
+      TESTASSERT(run_ca_latency_scenario(nof_ccs, 1, nof_ues, nof_ttis) == SRSRAN_SUCCESS);
+      if (nof_ccs > 1) {
+        TESTASSERT(run_ca_latency_scenario(nof_ccs, nof_ccs, nof_ues, nof_ttis) == SRSRAN_SUCCESS);
+      }
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
 {
   // Setup rand seed
   set_randseed(seed);
@@ -258,8 +452,11 @@ int main()
     return SRSRAN_ERROR;
   }
 
+  // Run benchmark with "sched_ca_test benchmark [nof_ttis]"
+  bool benchmark = argc > 1 and std::string(argv[1]) == "benchmark";
+
   auto& mac_log = srslog::fetch_basic_logger("MAC");
-  mac_log.set_level(srslog::basic_levels::debug);
+  mac_log.set_level(benchmark ? srslog::basic_levels::warning : srslog::basic_levels::debug);
   auto& test_log = srslog::fetch_basic_logger("TEST", *spy, false);
   test_log.set_level(srslog::basic_levels::debug);
 
@@ -268,6 +465,13 @@ int main()
 
   sched_diagnostic_printer printer(*spy);
 
+  if (benchmark) {
+    uint32_t nof_ttis = argc > 2 ? std::stoul(argv[2]) : 10000;
+    TESTASSERT(run_ca_latency_benchmark(nof_ttis) == SRSRAN_SUCCESS);
+    srslog::flush();
+    return 0;
+  }
+
   printf("[TESTER] This is the chosen seed: %u\n", seed);
   uint32_t N_runs = 20;
   for (uint32_t n = 0; n < N_runs; ++n) {
@@ -277,10 +481,16 @@ int main()
     p.pcell_idx                    = 0;
     TESTASSERT(test_scell_activation(n * 2, p) == SRSRAN_SUCCESS);
 
-    p           = {};
-    p.pcell_idx = 1;
+    p                = {};
+    p.pcell_idx      = 1;
+    p.nof_cc_workers = 2; // Schedule both carriers in parallel
     TESTASSERT(test_scell_activation(n * 2 + 1, p) == SRSRAN_SUCCESS);
   }
+  TESTASSERT(test_cc_workers_reconfiguration() == SRSRAN_SUCCESS);
+
+  // Short run of the latency benchmark, to exercise parallel scheduling with more than two carriers
+  TESTASSERT(run_ca_latency_scenario(4, 1, 8, 1000) == SRSRAN_SUCCESS);
+  TESTASSERT(run_ca_latency_scenario(4, 4, 8, 1000) == SRSRAN_SUCCESS);
 
   srslog::flush();
 
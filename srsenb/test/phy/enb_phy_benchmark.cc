@@ -0,0 +1,795 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * eNb PHY subframe throughput benchmark. The LTE subframe workers are driven without radio: a synthetic scheduler
+ * fills every subframe with DL and UL grants, and the UL baseband is a pre-generated loopback of the UL UEs PUSCH
+ * transmissions. Subframes are processed back to back as fast as the workers allow, and the per stage processing
+ * time is reported together with the load a single core can sustain in real time.
+ */
+
+#include "srsenb/hdr/phy/lte/worker_pool.h"
+#include "srsenb/hdr/phy/phy_common.h"
+#include "srsran/common/test_common.h"
+#include "srsran/srslog/srslog.h"
+#include "srsran/srsran.h"
+#include <atomic>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace bpo = boost::program_options;
+
+struct bench_args_t {
+  uint32_t    nof_prb       = 100;
+  uint32_t    nof_carriers  = 1;
+  uint32_t    nof_ue        = 4; ///< Number of DL UEs and UL UEs per carrier
+  uint32_t    dl_mcs        = 27;
+  uint32_t    ul_mcs        = 24;
+  uint32_t    nof_tti       = 1000;
+  uint32_t    max_workers   = 4;
+  uint32_t    ul_threads    = 0; ///< Threads decoding the UL apart from the subframe workers
+  uint32_t    ul_deadline   = 1000000; ///< Subframes are not processed in real time, do not discard any UL report
+  uint32_t    pusch_max_its = 4;
+  bool        pusch_8bit    = false;
+  float       snr_db        = 30.0f;
+  bool        sweep         = false;
+  std::string log_level     = "none";
+};
+
+/// Traffic of a single carrier. Every subframe carries the same grants, DL and UL UEs have disjoint RNTIs so that the
+/// PUSCH transmissions do not carry UCI.
+struct bench_traffic_t {
+  static const uint32_t cfi = 3;
+
+  struct dl_ue_t {
+    uint16_t rnti        = 0;
+    uint32_t rbg_bitmask = 0;
+    uint32_t nof_prb     = 0;
+    uint32_t ncce        = 0;
+  };
+  struct ul_ue_t {
+    uint16_t rnti    = 0;
+    uint32_t riv     = 0;
+    uint32_t nof_prb = 0;
+    uint32_t ncce    = 0;
+  };
+
+  std::vector<dl_ue_t> dl_ues;
+  std::vector<ul_ue_t> ul_ues;
+
+  int init(const srsran_cell_t& cell, uint32_t cc_idx, uint32_t nof_ue)
+  {
+    // Every DCI takes a single CCE
+    srsran_regs_t regs = {};
+    if (srsran_regs_init(&regs, cell) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    int nof_cce = srsran_regs_pdcch_ncce(&regs, cfi);
+    srsran_regs_free(&regs);
+    if (nof_cce < (int)(2 * nof_ue)) {
+      ERROR("%d UEs do not fit in %d CCEs", 2 * nof_ue, nof_cce);
+      return SRSRAN_ERROR;
+    }
+
+    // Split the RBGs between the DL UEs
+    uint32_t P       = srsran_ra_type0_P(cell.nof_prb);
+    uint32_t nof_rbg = SRSRAN_CEIL(cell.nof_prb, P);
+    if (nof_ue > nof_rbg) {
+      ERROR("%d DL UEs do not fit in %d RBGs", nof_ue, nof_rbg);
+      return SRSRAN_ERROR;
+    }
+    dl_ues.resize(nof_ue);
+    for (uint32_t i = 0; i < nof_ue; i++) {
+      dl_ue_t& ue = dl_ues[i];
+      ue.rnti     = 0x100 + 0x100 * cc_idx + i;
+      ue.ncce     = i;
+      for (uint32_t rbg = i * nof_rbg / nof_ue; rbg < (i + 1) * nof_rbg / nof_ue; rbg++) {
+        ue.rbg_bitmask |= 1U << (nof_rbg - rbg - 1);
+        ue.nof_prb += SRSRAN_MIN(P, cell.nof_prb - rbg * P);
+      }
+    }
+
+    // Split the PRBs outside the PUCCH region between the UL UEs
+    uint32_t pucch_prb = cell.nof_prb >= 15 ? 4 : 1;
+    uint32_t nof_prb   = cell.nof_prb - 2 * pucch_prb;
+    if (nof_ue > nof_prb) {
+      ERROR("%d UL UEs do not fit in %d PRBs", nof_ue, nof_prb);
+      return SRSRAN_ERROR;
+    }
+    ul_ues.resize(nof_ue);
+    for (uint32_t i = 0; i < nof_ue; i++) {
+      ul_ue_t& ue    = ul_ues[i];
+      uint32_t start = pucch_prb + i * nof_prb / nof_ue;
+      ue.rnti        = 0x180 + 0x100 * cc_idx + i;
+      ue.ncce        = nof_ue + i;
+      ue.nof_prb     = (i + 1) * nof_prb / nof_ue - i * nof_prb / nof_ue;
+      while (not srsran_dft_precoding_valid_prb(ue.nof_prb)) {
+        ue.nof_prb--;
+      }
+      ue.riv = srsran_ra_type2_to_riv(ue.nof_prb, start, cell.nof_prb);
+    }
+
+    return SRSRAN_SUCCESS;
+  }
+
+  static void fill_ul_dci(const ul_ue_t& ue, uint32_t mcs, srsran_dci_ul_t& dci)
+  {
+    dci                     = {};
+    dci.rnti                = ue.rnti;
+    dci.format              = SRSRAN_DCI_FORMAT0;
+    dci.location.L          = 0;
+    dci.location.ncce       = ue.ncce;
+    dci.type2_alloc.riv     = ue.riv;
+    dci.type2_alloc.n_prb1a = srsran_ra_type2_t::SRSRAN_RA_TYPE2_NPRB1A_2;
+    dci.type2_alloc.n_gap   = srsran_ra_type2_t::SRSRAN_RA_TYPE2_NG1;
+    dci.type2_alloc.mode    = srsran_ra_type2_t::SRSRAN_RA_TYPE2_LOC;
+    dci.freq_hop_fl         = srsran_dci_ul_t::SRSRAN_RA_PUSCH_HOP_DISABLED;
+    dci.tb.mcs_idx          = mcs;
+    dci.tb.rv               = 0;
+    dci.tb.ndi              = false;
+    dci.tb.cw_idx           = 0;
+    dci.n_dmrs              = 0;
+    dci.cqi_request         = false;
+  }
+};
+
+class bench_radio final : public srsran::radio_interface_phy
+{
+public:
+  std::atomic<uint64_t> nof_tx = {0};
+
+  bool tx(srsran::rf_buffer_interface& buffer, const srsran::rf_timestamp_interface& tx_time) override
+  {
+    nof_tx++;
+    return true;
+  }
+  void              tx_end() override {}
+  bool              rx_now(srsran::rf_buffer_interface& buffer, srsran::rf_timestamp_interface& rxd_time) override
+  {
+    return true;
+  }
+  void              release_freq(const uint32_t& carrier_idx) override {}
+  void              set_tx_freq(const uint32_t& channel_idx, const double& freq) override {}
+  void              set_rx_freq(const uint32_t& channel_idx, const double& freq) override {}
+  void              set_rx_gain_th(const float& gain) override {}
+  void              set_rx_gain(const float& gain) override {}
+  void              set_tx_srate(const double& srate) override {}
+  void              set_rx_srate(const double& srate) override {}
+  void              set_channel_rx_offset(uint32_t ch, int32_t offset_samples) override {}
+  void              set_tx_gain(const float& gain) override {}
+  float             get_rx_gain() override { return 0; }
+  double            get_freq_offset() override { return 0; }
+  bool              is_continuous_tx() override { return false; }
+  bool              get_is_start_of_burst() override { return false; }
+  bool              is_init() override { return true; }
+  void              reset() override {}
+  srsran_rf_info_t* get_info() override { return nullptr; }
+};
+
+/// Scheduler stand-in, called concurrently by the subframe workers for different TTIs
+class bench_stack final : public srsenb::stack_interface_phy_lte
+{
+public:
+  std::atomic<uint64_t> nof_crc_ok = {0};
+  std::atomic<uint64_t> nof_crc_ko = {0};
+  std::atomic<uint64_t> ul_bytes   = {0};
+
+  bench_stack(const std::vector<bench_traffic_t>& traffic_, uint32_t nof_prb, uint32_t dl_mcs_, uint32_t ul_mcs_) :
+    traffic(traffic_), dl_mcs(dl_mcs_), ul_mcs(ul_mcs_), dl_data(150000)
+  {
+    for (uint32_t i = 0; i < dl_data.size(); i++) {
+      dl_data[i] = static_cast<uint8_t>(((i + 257) * (i + 373)) % 255);
+    }
+
+    // One HARQ process per TTI of the FDD pipeline, so concurrent workers never share softbuffers
+    for (const bench_traffic_t& t : traffic) {
+      for (uint32_t i = 0; i < t.dl_ues.size() * SRSRAN_FDD_NOF_HARQ; i++) {
+        std::unique_ptr<srsran_softbuffer_tx_t> sb(new srsran_softbuffer_tx_t);
+        srsran_softbuffer_tx_init(sb.get(), nof_prb);
+        softbuffer_tx.push_back(std::move(sb));
+      }
+      for (uint32_t i = 0; i < t.ul_ues.size() * SRSRAN_FDD_NOF_HARQ; i++) {
+        std::unique_ptr<srsran_softbuffer_rx_t> sb(new srsran_softbuffer_rx_t);
+        srsran_softbuffer_rx_init(sb.get(), nof_prb);
+        softbuffer_rx.push_back(std::move(sb));
+        ul_data.emplace_back(SRSRAN_MAX_BUFFER_SIZE_BYTES);
+      }
+    }
+  }
+
+  ~bench_stack()
+  {
+    for (auto& sb : softbuffer_tx) {
+      srsran_softbuffer_tx_free(sb.get());
+    }
+    for (auto& sb : softbuffer_rx) {
+      srsran_softbuffer_rx_free(sb.get());
+    }
+  }
+
+  int get_dl_sched(uint32_t tti, dl_sched_list_t& dl_sched_res) override
+  {
+    uint32_t pid = tti % SRSRAN_FDD_NOF_HARQ;
+    uint32_t idx = 0;
+    for (uint32_t cc = 0; cc < dl_sched_res.size() and cc < traffic.size(); cc++) {
+      dl_sched_t& dl_sched = dl_sched_res[cc];
+      dl_sched.cfi         = bench_traffic_t::cfi;
+      dl_sched.nof_grants  = traffic[cc].dl_ues.size();
+      for (uint32_t i = 0; i < dl_sched.nof_grants; i++, idx++) {
+        const bench_traffic_t::dl_ue_t& ue    = traffic[cc].dl_ues[i];
+        dl_sched_grant_t&               grant = dl_sched.pdsch[i];
+
+        grant                             = {};
+        grant.dci.rnti                    = ue.rnti;
+        grant.dci.format                  = SRSRAN_DCI_FORMAT1;
+        grant.dci.alloc_type              = SRSRAN_RA_ALLOC_TYPE0;
+        grant.dci.type0_alloc.rbg_bitmask = ue.rbg_bitmask;
+        grant.dci.location.L              = 0;
+        grant.dci.location.ncce           = ue.ncce;
+        grant.dci.tb[0].mcs_idx           = dl_mcs;
+        grant.dci.tb[0].rv                = 0;
+        grant.dci.tb[0].ndi               = (tti / SRSRAN_FDD_NOF_HARQ) % 2;
+        grant.dci.tb[1].mcs_idx           = 0;
+        grant.dci.tb[1].rv                = 1;
+        grant.data[0]                     = dl_data.data();
+        grant.softbuffer_tx[0]            = softbuffer_tx[idx * SRSRAN_FDD_NOF_HARQ + pid].get();
+        srsran_softbuffer_tx_reset(grant.softbuffer_tx[0]);
+      }
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  int get_ul_sched(uint32_t tti, ul_sched_list_t& ul_sched_res) override
+  {
+    uint32_t pid = tti % SRSRAN_FDD_NOF_HARQ;
+    uint32_t idx = 0;
+    for (uint32_t cc = 0; cc < ul_sched_res.size() and cc < traffic.size(); cc++) {
+      ul_sched_t& ul_sched = ul_sched_res[cc];
+      ul_sched.nof_grants  = traffic[cc].ul_ues.size();
+      ul_sched.nof_phich   = traffic[cc].ul_ues.size();
+      for (uint32_t i = 0; i < ul_sched.nof_grants; i++, idx++) {
+        const bench_traffic_t::ul_ue_t& ue    = traffic[cc].ul_ues[i];
+        ul_sched_grant_t&               grant = ul_sched.pusch[i];
+
+        grant = {};
+        bench_traffic_t::fill_ul_dci(ue, ul_mcs, grant.dci);
+        grant.pid           = pid;
+        grant.needs_pdcch   = true;
+        grant.data          = ul_data[idx * SRSRAN_FDD_NOF_HARQ + pid].data();
+        grant.softbuffer_rx = softbuffer_rx[idx * SRSRAN_FDD_NOF_HARQ + pid].get();
+        srsran_softbuffer_rx_reset(grant.softbuffer_rx);
+
+        ul_sched.phich[i].rnti = ue.rnti;
+        ul_sched.phich[i].ack  = true;
+      }
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  int crc_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t nof_bytes, bool crc_res) override
+  {
+    if (crc_res) {
+      nof_crc_ok++;
+      ul_bytes += nof_bytes;
+    } else {
+      nof_crc_ko++;
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  int  sr_detected(uint32_t tti, uint16_t rnti) override { return SRSRAN_SUCCESS; }
+  void rach_detected(uint32_t tti, uint32_t primary_cc_idx, uint32_t preamble_idx, uint32_t time_adv) override {}
+  int  ri_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t ri_value) override { return SRSRAN_SUCCESS; }
+  int  pmi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t pmi_value) override { return SRSRAN_SUCCESS; }
+  int  cqi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t cqi_value) override { return SRSRAN_SUCCESS; }
+  int  sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t sb_idx, uint32_t cqi_value) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int snr_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, float snr_db, ul_channel_t ch) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int ta_info(uint32_t tti, uint16_t rnti, float ta_us) override { return SRSRAN_SUCCESS; }
+  int ack_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t tb_idx, bool ack) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int push_pdu(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t nof_bytes, bool crc_res, uint32_t nof_prb)
+      override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res) override { return SRSRAN_SUCCESS; }
+  void set_sched_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs) override {}
+
+private:
+  const std::vector<bench_traffic_t>&                   traffic;
+  uint32_t                                              dl_mcs = 0;
+  uint32_t                                              ul_mcs = 0;
+  std::vector<uint8_t>                                  dl_data;
+  std::vector<std::vector<uint8_t> >                    ul_data;
+  std::vector<std::unique_ptr<srsran_softbuffer_tx_t> > softbuffer_tx;
+  std::vector<std::unique_ptr<srsran_softbuffer_rx_t> > softbuffer_rx;
+};
+
+/// Generates the UL baseband received by a carrier for each subframe index of a radio frame
+static int generate_ul_signal(const srsran_cell_t&     cell,
+                              const bench_traffic_t&   traffic,
+                              const srsran::phy_cfg_t& dedicated,
+                              uint32_t                 ul_mcs,
+                              float                    snr_db,
+                              std::vector<cf_t*>&      signal)
+{
+  uint32_t               sf_len     = SRSRAN_SF_LEN_PRB(cell.nof_prb);
+  int                    ret        = SRSRAN_ERROR;
+  srsran_ue_ul_t         ue_ul      = {};
+  srsran_softbuffer_tx_t softbuffer = {};
+  cf_t*                  ue_signal  = srsran_vec_cf_malloc(sf_len);
+  std::vector<uint8_t>   data(SRSRAN_MAX_BUFFER_SIZE_BYTES);
+
+  if (ue_signal == nullptr or srsran_ue_ul_init(&ue_ul, ue_signal, cell.nof_prb) < SRSRAN_SUCCESS or
+      srsran_ue_ul_set_cell(&ue_ul, cell) < SRSRAN_SUCCESS or
+      srsran_softbuffer_tx_init(&softbuffer, cell.nof_prb) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising UE UL");
+    goto clean_exit;
+  }
+
+  for (uint32_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<uint8_t>(((i + 257) * (i + 373)) % 255);
+  }
+
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    srsran_vec_cf_zero(signal[sf_idx], sf_len);
+
+    for (const bench_traffic_t::ul_ue_t& ue : traffic.ul_ues) {
+      srsran_ul_sf_cfg_t  sf_cfg     = {};
+      srsran_ue_ul_cfg_t  ue_ul_cfg  = {};
+      srsran_dci_ul_t     dci        = {};
+      srsran_pusch_data_t pusch_data = {};
+
+      sf_cfg.tti                            = sf_idx;
+      ue_ul_cfg.ul_cfg                      = dedicated.ul_cfg;
+      ue_ul_cfg.ul_cfg.pusch.rnti           = ue.rnti;
+      ue_ul_cfg.ul_cfg.pucch.rnti           = ue.rnti;
+      ue_ul_cfg.ul_cfg.pusch.softbuffers.tx = &softbuffer;
+      ue_ul_cfg.grant_available             = true;
+      pusch_data.ptr                        = data.data();
+
+      bench_traffic_t::fill_ul_dci(ue, ul_mcs, dci);
+      if (srsran_ue_ul_dci_to_pusch_grant(&ue_ul, &sf_cfg, &ue_ul_cfg, &dci, &ue_ul_cfg.ul_cfg.pusch.grant) <
+          SRSRAN_SUCCESS) {
+        ERROR("Error computing PUSCH grant");
+        goto clean_exit;
+      }
+
+      srsran_softbuffer_tx_reset(&softbuffer);
+      if (srsran_ue_ul_encode(&ue_ul, &sf_cfg, &ue_ul_cfg, &pusch_data) < SRSRAN_SUCCESS) {
+        ERROR("Error encoding PUSCH");
+        goto clean_exit;
+      }
+      srsran_vec_sum_ccc(signal[sf_idx], ue_signal, signal[sf_idx], sf_len);
+    }
+
+    // Add noise relative to the average power of the whole subframe
+    float power = srsran_vec_avg_power_cf(signal[sf_idx], sf_len);
+    if (std::isnormal(power)) {
+      srsran_ch_awgn_c(signal[sf_idx], signal[sf_idx], power * srsran_convert_dB_to_power(-snr_db), sf_len);
+    }
+  }
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_ue_ul_free(&ue_ul);
+  srsran_softbuffer_tx_free(&softbuffer);
+  if (ue_signal) {
+    free(ue_signal);
+  }
+  return ret;
+}
+
+struct bench_result_t {
+  double                    tti_per_sec = 0.0;
+  srsenb::phy_stage_times_t stages      = {};
+  uint64_t                  nof_crc_ok  = 0;
+  uint64_t                  nof_crc_ko  = 0;
+  uint32_t                  ul_miss     = 0; ///< Subframes whose UL finished after the deadline
+  double                    ul_mbps     = 0.0; ///< Decoded UL throughput, at the processed TTI rate
+  double                    dl_mbps     = 0.0; ///< Scheduled DL throughput, at the processed TTI rate
+};
+
+/// Processes nof_tti subframes with nof_workers subframe workers, following the same pipeline as the eNb txrx thread
+static int run_bench(const bench_args_t& args, uint32_t nof_workers, bench_result_t& result)
+{
+  srsenb::phy_cell_cfg_list_t    cell_list;
+  srsenb::phy_cell_cfg_list_nr_t cell_list_nr;
+  for (uint32_t cc = 0; cc < args.nof_carriers; cc++) {
+    srsenb::phy_cell_cfg_t cell_cfg = {};
+    cell_cfg.cell.nof_prb           = args.nof_prb;
+    cell_cfg.cell.nof_ports         = 1;
+    cell_cfg.cell.id                = cc;
+    cell_cfg.cell.cp                = SRSRAN_CP_NORM;
+    cell_cfg.cell.phich_length      = SRSRAN_PHICH_NORM;
+    cell_cfg.cell.phich_resources   = SRSRAN_PHICH_R_1;
+    cell_cfg.cell_id                = cc;
+    cell_cfg.rf_port                = cc;
+    cell_list.push_back(cell_cfg);
+  }
+
+  // Traffic and UE dedicated configuration, without periodic reports nor scheduling requests
+  std::vector<bench_traffic_t> traffic(args.nof_carriers);
+  for (uint32_t cc = 0; cc < args.nof_carriers; cc++) {
+    if (traffic[cc].init(cell_list[cc].cell, cc, args.nof_ue) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+  srsran::phy_cfg_t dedicated                    = {};
+  dedicated.dl_cfg.tm                            = SRSRAN_TM1;
+  dedicated.ul_cfg.pucch.delta_pucch_shift       = 1;
+  dedicated.ul_cfg.pucch.n_rb_2                  = 2;
+  dedicated.ul_cfg.pucch.N_pucch_1               = 12;
+  dedicated.ul_cfg.pucch.simul_cqi_ack           = true;
+  dedicated.ul_cfg.pusch.enable_64qam            = true;
+  dedicated.ul_cfg.pusch.uci_offset.I_offset_ack = 7;
+  dedicated.ul_cfg.pusch.uci_offset.I_offset_ri  = 7;
+  dedicated.ul_cfg.pusch.uci_offset.I_offset_cqi = 7;
+
+  // Pre-generate the loopback UL signal
+  uint32_t                         sf_len = SRSRAN_SF_LEN_PRB(args.nof_prb);
+  std::vector<std::vector<cf_t*> > ul_signal(args.nof_carriers, std::vector<cf_t*>(SRSRAN_NOF_SF_X_FRAME));
+  for (uint32_t cc = 0; cc < args.nof_carriers; cc++) {
+    for (cf_t*& s : ul_signal[cc]) {
+      s = srsran_vec_cf_malloc(sf_len);
+    }
+    if (generate_ul_signal(cell_list[cc].cell, traffic[cc], dedicated, args.ul_mcs, args.snr_db, ul_signal[cc]) <
+        SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  bench_radio radio;
+  bench_stack stack(traffic, args.nof_prb, args.dl_mcs, args.ul_mcs);
+
+  srsenb::phy_args_t phy_args;
+  phy_args.log.phy_level      = args.log_level;
+  phy_args.nof_phy_threads    = nof_workers;
+  phy_args.pusch_max_its      = args.pusch_max_its;
+  phy_args.pusch_8bit_decoder = args.pusch_8bit;
+  phy_args.nof_ul_threads     = args.ul_threads;
+  phy_args.ul_deadline_us     = args.ul_deadline;
+
+  srsenb::phy_common common;
+  common.params = phy_args;
+  common.init(cell_list, cell_list_nr, &radio, &stack);
+
+  srsenb::lte::worker_pool workers(nof_workers);
+  workers.init(phy_args, &common, srslog::get_default_sink(), -1);
+
+  // Configure the UEs in their carrier
+  for (uint32_t cc = 0; cc < args.nof_carriers; cc++) {
+    srsenb::phy_interface_rrc_lte::phy_rrc_cfg_list_t phy_rrc_cfg(1);
+    phy_rrc_cfg[0].configured = true;
+    phy_rrc_cfg[0].enb_cc_idx = cc;
+    phy_rrc_cfg[0].phy_cfg    = dedicated;
+
+    std::vector<uint16_t> rntis;
+    for (const bench_traffic_t::dl_ue_t& ue : traffic[cc].dl_ues) {
+      rntis.push_back(ue.rnti);
+    }
+    for (const bench_traffic_t::ul_ue_t& ue : traffic[cc].ul_ues) {
+      rntis.push_back(ue.rnti);
+    }
+    for (uint16_t rnti : rntis) {
+      common.ue_db.addmod_rnti(rnti, phy_rrc_cfg);
+      common.ue_db.complete_config(rnti);
+      for (uint32_t w = 0; w < nof_workers; w++) {
+        workers[w]->add_rnti(rnti, cc);
+      }
+    }
+  }
+
+  for (uint32_t w = 0; w < nof_workers; w++) {
+    workers[w]->set_stage_timing(true);
+  }
+
+  // Fill the HARQ pipeline before measuring
+  const uint32_t nof_warmup = 2 * SRSRAN_FDD_NOF_HARQ;
+  uint32_t       tti        = TTI_SUB(0, FDD_HARQ_DELAY_UL_MS + 1);
+
+  std::chrono::steady_clock::time_point t_start = {};
+  for (uint32_t n = 0; n < nof_warmup + args.nof_tti; n++) {
+    if (n == nof_warmup) {
+      common.semaphore.wait_all();
+      srsenb::phy_stage_times_t      discard          = {};
+      srsenb::phy_deadline_metrics_t discard_deadline = {};
+      for (uint32_t w = 0; w < nof_workers; w++) {
+        workers[w]->get_stage_times(discard);
+        workers[w]->get_deadline_metrics(discard_deadline);
+      }
+      stack.nof_crc_ok = 0;
+      stack.nof_crc_ko = 0;
+      stack.ul_bytes   = 0;
+      t_start          = std::chrono::steady_clock::now();
+    }
+
+    tti                       = TTI_ADD(tti, 1);
+    srsenb::lte::sf_worker* w = workers.wait_worker(tti);
+    if (w == nullptr) {
+      break;
+    }
+
+    for (uint32_t cc = 0; cc < args.nof_carriers; cc++) {
+      srsran_vec_cf_copy(w->get_buffer_rx(cc, 0), ul_signal[cc][tti % SRSRAN_NOF_SF_X_FRAME], sf_len);
+    }
+
+    srsran::phy_common_interface::worker_context_t context;
+    context.sf_idx     = tti;
+    context.worker_ptr = w;
+    context.last       = true;
+    w->set_context(context);
+
+    common.semaphore.push(w);
+    workers.start_worker(w);
+  }
+  common.semaphore.wait_all();
+  double elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+
+  result                                  = {};
+  srsenb::phy_deadline_metrics_t deadline = {};
+  for (uint32_t w = 0; w < nof_workers; w++) {
+    workers[w]->get_stage_times(result.stages);
+    workers[w]->get_deadline_metrics(deadline);
+  }
+  workers.stop();
+
+  result.tti_per_sec = args.nof_tti / elapsed_s;
+  result.nof_crc_ok  = stack.nof_crc_ok;
+  result.nof_crc_ko  = stack.nof_crc_ko;
+  result.ul_miss     = deadline.ul_miss;
+  result.ul_mbps     = 8.0 * stack.ul_bytes / elapsed_s / 1e6;
+
+  int tbs_idx = srsran_ra_tbs_idx_from_mcs(args.dl_mcs, false, false);
+  for (const bench_traffic_t& t : traffic) {
+    for (const bench_traffic_t::dl_ue_t& ue : t.dl_ues) {
+      result.dl_mbps += srsran_ra_tbs_from_idx(tbs_idx, ue.nof_prb) * result.tti_per_sec / 1e6;
+    }
+  }
+
+  for (std::vector<cf_t*>& v : ul_signal) {
+    for (cf_t* s : v) {
+      free(s);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Average worker time per subframe, in microseconds
+static double sf_time_us(const bench_result_t& r)
+{
+  return r.stages.nof_sf ? r.stages.sf_us / r.stages.nof_sf : 0.0;
+}
+
+static void print_result(uint32_t nof_workers, const bench_result_t& r)
+{
+  const srsenb::phy_stage_times_t& s  = r.stages;
+  double                           n  = SRSRAN_MAX(1.0, (double)s.nof_sf);
+  uint64_t                         nb = r.nof_crc_ok + r.nof_crc_ko;
+
+  printf("%7d %8.0f %6.2f %8.1f %7.1f %7.1f %7.1f %8.1f %7.1f %7.1f %7.1f %7.1f %7.1f %6.1f%% %8.1f %8.1f\n",
+         nof_workers,
+         r.tti_per_sec,
+         r.tti_per_sec / 1000.0,
+         sf_time_us(r),
+         s.ul_fft_us / n,
+         s.pusch_chest_us / n,
+         s.pusch_demod_us / n,
+         s.pusch_decode_us / n,
+         s.pucch_us / n,
+         s.dl_base_us / n,
+         s.pdcch_us / n,
+         s.pdsch_us / n,
+         s.dl_ifft_us / n,
+         nb ? 100.0 * r.nof_crc_ok / nb : 0.0,
+         r.dl_mbps,
+         r.ul_mbps);
+}
+
+static int run_workers(const bench_args_t& args)
+{
+  printf("eNb PHY benchmark: %d carrier(s) of %d PRB, %d DL and %d UL UEs per carrier, DL MCS=%d, UL MCS=%d, "
+         "%d TTI\n",
+         args.nof_carriers,
+         args.nof_prb,
+         args.nof_ue,
+         args.nof_ue,
+         args.dl_mcs,
+         args.ul_mcs,
+         args.nof_tti);
+  printf("Stage times are in us per TTI and worker. The PUSCH decode stage includes turbo decoding and CRC.\n");
+  printf("%7s %8s %6s %8s %7s %7s %7s %8s %7s %7s %7s %7s %7s %7s %8s %8s\n",
+         "workers",
+         "TTI/s",
+         "RT",
+         "sf",
+         "ul_fft",
+         "chest",
+         "demod",
+         "decode",
+         "pucch",
+         "dl_base",
+         "pdcch",
+         "pdsch",
+         "dl_ifft",
+         "crc_ok",
+         "DL Mbps",
+         "UL Mbps");
+
+  double single_sf_us = 0.0;
+  for (uint32_t nof_workers = 1; nof_workers <= args.max_workers; nof_workers *= 2) {
+    bench_result_t result = {};
+    if (run_bench(args, nof_workers, result) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    print_result(nof_workers, result);
+
+    uint64_t nof_pusch = (uint64_t)args.nof_tti * args.nof_carriers * args.nof_ue;
+    if (args.ul_deadline == 0) {
+      // The UL always finishes after a null deadline, and the reports the DL stage did not wait for are discarded
+      TESTASSERT(result.ul_miss == args.nof_tti);
+      TESTASSERT(result.nof_crc_ok + result.nof_crc_ko < nof_pusch);
+    } else {
+      // All UL transmissions are expected to be decoded with the default SNR
+      TESTASSERT(result.nof_crc_ok > 0);
+      TESTASSERT(result.ul_miss > 0 or result.nof_crc_ok + result.nof_crc_ko == nof_pusch);
+    }
+
+    if (nof_workers == 1) {
+      single_sf_us = sf_time_us(result);
+    }
+  }
+
+  // A core sustains the load as long as it processes one TTI per millisecond
+  if (single_sf_us > 0.0) {
+    double load = 1000.0 / single_sf_us;
+    printf("Sustainable load per core: %.2f x this configuration, that is %.0f PRB and %.1f DL + %.1f UL UEs\n",
+           load,
+           load * args.nof_carriers * args.nof_prb,
+           load * args.nof_carriers * args.nof_ue,
+           load * args.nof_carriers * args.nof_ue);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/// Single worker sweep over the bandwidth and MCS, reporting the highest MCS that a core sustains for each bandwidth
+static int run_sweep(const bench_args_t& args)
+{
+  const uint32_t prb_list[] = {6, 15, 25, 50, 75, 100};
+  const uint32_t mcs_list[] = {0, 4, 8, 12, 16, 20, 24, 28};
+
+  printf("Single worker us per TTI, %d carrier(s), %d DL and %d UL UEs per carrier, same DL and UL MCS\n",
+         args.nof_carriers,
+         args.nof_ue,
+         args.nof_ue);
+  printf("%5s", "PRB");
+  for (uint32_t mcs : mcs_list) {
+    printf("  MCS %2d", mcs);
+  }
+  printf("  max MCS\n");
+
+  for (uint32_t nof_prb : prb_list) {
+    bench_args_t a = args;
+    a.nof_prb      = nof_prb;
+    a.nof_ue       = SRSRAN_MIN(args.nof_ue, SRSRAN_CEIL(nof_prb, srsran_ra_type0_P(nof_prb)));
+
+    int  max_mcs = -1;
+    bool fits    = true;
+    printf("%5d", nof_prb);
+    for (uint32_t mcs : mcs_list) {
+      a.dl_mcs = mcs;
+      a.ul_mcs = mcs;
+
+      bench_result_t result = {};
+      if (run_bench(a, 1, result) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+      printf(" %7.1f", sf_time_us(result));
+      fflush(stdout);
+      fits &= sf_time_us(result) < 1000.0;
+      if (fits) {
+        max_mcs = mcs;
+      }
+    }
+    if (max_mcs < 0) {
+      printf("  %7s\n", "none");
+    } else {
+      printf("  %7d\n", max_mcs);
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+static int parse_args(int argc, char** argv, bench_args_t& args)
+{
+  bpo::options_description options("eNb PHY benchmark options");
+
+  // clang-format off
+  options.add_options()
+      ("nof_prb",       bpo::value<uint32_t>(&args.nof_prb)->default_value(args.nof_prb),             "Cell bandwidth in PRB")
+      ("nof_carriers",  bpo::value<uint32_t>(&args.nof_carriers)->default_value(args.nof_carriers),   "Number of eNb carriers")
+      ("nof_ue",        bpo::value<uint32_t>(&args.nof_ue)->default_value(args.nof_ue),               "Number of DL UEs and of UL UEs per carrier")
+      ("dl_mcs",        bpo::value<uint32_t>(&args.dl_mcs)->default_value(args.dl_mcs),               "PDSCH MCS")
+      ("ul_mcs",        bpo::value<uint32_t>(&args.ul_mcs)->default_value(args.ul_mcs),               "PUSCH MCS")
+      ("nof_tti",       bpo::value<uint32_t>(&args.nof_tti)->default_value(args.nof_tti),             "Number of measured TTIs")
+      ("max_workers",   bpo::value<uint32_t>(&args.max_workers)->default_value(args.max_workers),     "Maximum number of subframe workers, doubled from 1")
+      ("ul_threads",    bpo::value<uint32_t>(&args.ul_threads)->default_value(args.ul_threads),       "Number of threads decoding the UL, 0 decodes it in the subframe workers")
+      ("ul_deadline",   bpo::value<uint32_t>(&args.ul_deadline)->default_value(args.ul_deadline),     "UL deadline in us, 0 discards the UL reports not ready when the DL starts")
+      ("pusch_max_its", bpo::value<uint32_t>(&args.pusch_max_its)->default_value(args.pusch_max_its), "Maximum number of turbo decoder iterations")
+      ("pusch_8bit",    bpo::bool_switch(&args.pusch_8bit),                                           "Use the 8 bit PUSCH decoder")
+      ("snr",           bpo::value<float>(&args.snr_db)->default_value(args.snr_db),                  "UL signal to noise ratio in dB")
+      ("sweep",         bpo::bool_switch(&args.sweep),                                                "Sweep bandwidth and MCS with a single worker")
+      ("log_level",     bpo::value<std::string>(&args.log_level)->default_value(args.log_level),      "PHY logging level")
+      ("help",          "Show this message")
+      ;
+  // clang-format on
+
+  bpo::variables_map vm;
+  try {
+    bpo::store(bpo::command_line_parser(argc, argv).options(options).run(), vm);
+    bpo::notify(vm);
+  } catch (bpo::error& e) {
+    std::cerr << e.what() << std::endl;
+    return SRSRAN_ERROR;
+  }
+
+  if (vm.count("help")) {
+    std::cout << "Usage: " << argv[0] << " [OPTIONS]" << std::endl << std::endl << options << std::endl;
+    return SRSRAN_ERROR;
+  }
+
+  // Concurrent workers must not share a HARQ process
+  if (args.max_workers == 0 or args.max_workers > SRSRAN_FDD_NOF_HARQ or args.nof_carriers == 0 or
+      args.nof_carriers > SRSRAN_MAX_CARRIERS or args.nof_ue == 0) {
+    std::cerr << "Invalid arguments" << std::endl;
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srsran_debug_handle_crash(argc, argv);
+
+  bench_args_t args;
+  if (parse_args(argc, argv, args) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  srslog::init();
+
+  int ret = args.sweep ? run_sweep(args) : run_workers(args);
+
+  srslog::flush();
+  return ret;
+}
@@ -0,0 +1,307 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * PHY UE database contention benchmark. Several reader threads emulate the PHY workers, fetching the DL/UL
+ * configuration of random UEs as it happens for every PDSCH/PUSCH grant, while a writer thread emulates the RRC
+ * reconfiguring UEs. The snapshot based phy_ue_db is compared with a replica of the former mutex protected lookup,
+ * which copied the whole PHY configuration under the database lock.
+ */
+
+#include "srsenb/hdr/phy/phy_ue_db.h"
+#include "srsran/common/test_common.h"
+#include "srsran/srslog/srslog.h"
+#include <atomic>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace bpo = boost::program_options;
+
+struct bench_args_t {
+  uint32_t nof_ue             = 64;
+  uint32_t nof_carriers       = 2;
+  uint32_t nof_readers        = 4;
+  uint32_t nof_lookups        = 200000; ///< Number of lookups per reader
+  uint32_t reconfig_period_us = 100;
+};
+
+/// Replica of the former database read path: a single mutex and full configuration copies
+class locked_ue_db
+{
+public:
+  void addmod_rnti(uint16_t rnti, const srsenb::phy_interface_rrc_lte::phy_rrc_cfg_list_t& phy_cfg_list)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ue_db[rnti] = phy_cfg_list;
+  }
+
+  int get_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dl_cfg_t& dl_cfg) const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    srsran::phy_cfg_t           phy_cfg = {};
+    if (get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    dl_cfg = phy_cfg.dl_cfg;
+    return SRSRAN_SUCCESS;
+  }
+
+  int get_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_ul_cfg_t& ul_cfg) const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    srsran::phy_cfg_t           phy_cfg = {};
+    if (get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    ul_cfg = phy_cfg.ul_cfg;
+    return SRSRAN_SUCCESS;
+  }
+
+private:
+  int get_rnti_config(uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg) const
+  {
+    srsran::phy_cfg_t default_cfg = {};
+    default_cfg.set_defaults();
+
+    auto it = ue_db.find(rnti);
+    if (it == ue_db.end()) {
+      return SRSRAN_ERROR;
+    }
+    for (const srsenb::phy_interface_rrc_lte::phy_rrc_cfg_t& cell : it->second) {
+      if (cell.configured and cell.enb_cc_idx == enb_cc_idx) {
+        phy_cfg = cell.phy_cfg;
+        return SRSRAN_SUCCESS;
+      }
+    }
+    phy_cfg = default_cfg;
+    return SRSRAN_ERROR;
+  }
+
+  mutable std::mutex                                                             mutex;
+  std::map<uint16_t, std::vector<srsenb::phy_interface_rrc_lte::phy_rrc_cfg_t> > ue_db;
+};
+
+static uint16_t bench_rnti(uint32_t ue_idx)
+{
+  return (uint16_t)(0x46 + ue_idx);
+}
+
+/// Builds the configuration of a UE using all the carriers, the transmission mode toggles on every reconfiguration
+static srsenb::phy_interface_rrc_lte::phy_rrc_cfg_list_t
+bench_cfg(uint16_t rnti, uint32_t nof_carriers, uint32_t version)
+{
+  srsenb::phy_interface_rrc_lte::phy_rrc_cfg_list_t phy_cfg_list(nof_carriers);
+  for (uint32_t i = 0; i < nof_carriers; i++) {
+    phy_cfg_list[i].configured                = true;
+    phy_cfg_list[i].enb_cc_idx                = i;
+    phy_cfg_list[i].phy_cfg.dl_cfg.tm         = (version % 2 == 0) ? SRSRAN_TM1 : SRSRAN_TM2;
+    phy_cfg_list[i].phy_cfg.dl_cfg.pdsch.rnti = rnti;
+    phy_cfg_list[i].phy_cfg.ul_cfg.pusch.rnti = rnti;
+    phy_cfg_list[i].phy_cfg.ul_cfg.pucch.rnti = rnti;
+  }
+  return phy_cfg_list;
+}
+
+struct bench_result_t {
+  double   lookups_per_sec = 0.0;
+  double   ns_per_lookup   = 0.0;
+  double   max_reconfig_us = 0.0;
+  uint32_t nof_reconfig    = 0;
+  uint32_t nof_errors      = 0;
+};
+
+template <typename DB>
+static bench_result_t run_contention(DB& db, const bench_args_t& args)
+{
+  bench_result_t        result      = {};
+  std::atomic<bool>     start       = {false};
+  std::atomic<uint32_t> nof_running = {args.nof_readers};
+  std::atomic<uint32_t> nof_errors  = {0};
+
+  // Readers, emulate the PHY workers fetching the configuration of a UE for each grant
+  std::vector<std::thread> readers;
+  for (uint32_t r = 0; r < args.nof_readers; r++) {
+    readers.emplace_back([&db, &args, &start, &nof_running, &nof_errors, r]() {
+      while (not start.load()) {
+        std::this_thread::yield();
+      }
+      srsran_dl_cfg_t dl_cfg = {};
+      srsran_ul_cfg_t ul_cfg = {};
+      for (uint32_t i = 0; i < args.nof_lookups; i++) {
+        uint16_t rnti   = bench_rnti((i * 7 + r * 13) % args.nof_ue);
+        uint32_t cc_idx = (i / 2) % args.nof_carriers;
+        if (i % 2 == 0) {
+          if (db.get_dl_config(rnti, cc_idx, dl_cfg) < SRSRAN_SUCCESS or dl_cfg.pdsch.rnti != rnti or
+              (dl_cfg.tm != SRSRAN_TM1 and dl_cfg.tm != SRSRAN_TM2)) {
+            nof_errors++;
+          }
+        } else {
+          if (db.get_ul_config(rnti, cc_idx, ul_cfg) < SRSRAN_SUCCESS or ul_cfg.pusch.rnti != rnti) {
+            nof_errors++;
+          }
+        }
+      }
+      nof_running--;
+    });
+  }
+
+  // Writer, emulates the RRC reconfiguring UEs while the readers run
+  std::thread writer([&db, &args, &start, &nof_running, &result]() {
+    while (not start.load()) {
+      std::this_thread::yield();
+    }
+    for (uint32_t version = 1; nof_running.load() > 0; version++) {
+      uint32_t                                          ue_idx = version % args.nof_ue;
+      srsenb::phy_interface_rrc_lte::phy_rrc_cfg_list_t cfg    = bench_cfg(bench_rnti(ue_idx), args.nof_carriers, version);
+
+      std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now();
+      db.addmod_rnti(bench_rnti(ue_idx), cfg);
+      double reconfig_us =
+          std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t).count();
+      result.max_reconfig_us = std::max(result.max_reconfig_us, reconfig_us);
+      result.nof_reconfig++;
+      std::this_thread::sleep_for(std::chrono::microseconds(args.reconfig_period_us));
+    }
+  });
+
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  start.store(true);
+  for (std::thread& t : readers) {
+    t.join();
+  }
+  std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+  writer.join();
+
+  double elapsed_s       = std::chrono::duration<double>(t1 - t0).count();
+  double total_lookups   = (double)args.nof_lookups * args.nof_readers;
+  result.lookups_per_sec = total_lookups / elapsed_s;
+  result.ns_per_lookup   = elapsed_s * 1e9 * args.nof_readers / total_lookups;
+  result.nof_errors      = nof_errors.load();
+  return result;
+}
+
+static void print_result(const char* name, const bench_result_t& r)
+{
+  printf("%-10s %12.2f %14.1f %10d %17.1f %8d\n",
+         name,
+         r.lookups_per_sec / 1e6,
+         r.ns_per_lookup,
+         r.nof_reconfig,
+         r.max_reconfig_us,
+         r.nof_errors);
+}
+
+static int parse_args(int argc, char** argv, bench_args_t& args)
+{
+  bpo::options_description options("PHY UE database benchmark options");
+
+  // clang-format off
+  options.add_options()
+      ("nof_ue",             bpo::value<uint32_t>(&args.nof_ue)->default_value(args.nof_ue),                         "Number of UEs")
+      ("nof_carriers",       bpo::value<uint32_t>(&args.nof_carriers)->default_value(args.nof_carriers),             "Number of carriers per UE")
+      ("nof_readers",        bpo::value<uint32_t>(&args.nof_readers)->default_value(args.nof_readers),               "Number of reader threads")
+      ("nof_lookups",        bpo::value<uint32_t>(&args.nof_lookups)->default_value(args.nof_lookups),               "Number of lookups per reader")
+      ("reconfig_period_us", bpo::value<uint32_t>(&args.reconfig_period_us)->default_value(args.reconfig_period_us), "Time between UE reconfigurations in microseconds")
+      ("help",               "Show this message")
+      ;
+  // clang-format on
+
+  bpo::variables_map vm;
+  try {
+    bpo::store(bpo::command_line_parser(argc, argv).options(options).run(), vm);
+    bpo::notify(vm);
+  } catch (bpo::error& e) {
+    std::cerr << e.what() << std::endl;
+    return SRSRAN_ERROR;
+  }
+
+  if (vm.count("help")) {
+    std::cout << "Usage: " << argv[0] << " [OPTIONS]" << std::endl << std::endl << options << std::endl;
+    return SRSRAN_ERROR;
+  }
+
+  if (args.nof_ue == 0 or args.nof_carriers == 0 or args.nof_carriers > SRSRAN_MAX_CARRIERS or args.nof_readers == 0) {
+    std::cerr << "Invalid arguments" << std::endl;
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  bench_args_t args;
+  if (parse_args(argc, argv, args) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  srslog::init();
+
+  // Databases under test, initially with all the UEs configured
+  srsenb::phy_args_t          phy_args = {};
+  srsenb::phy_cell_cfg_list_t cell_list(args.nof_carriers);
+  for (uint32_t i = 0; i < args.nof_carriers; i++) {
+    cell_list[i].cell           = {};
+    cell_list[i].cell.nof_prb   = 6;
+    cell_list[i].cell.nof_ports = 1;
+  }
+
+  std::unique_ptr<srsenb::phy_ue_db> snapshot_db(new srsenb::phy_ue_db);
+  locked_ue_db                       locked_db;
+  snapshot_db->init(nullptr, phy_args, cell_list);
+  for (uint32_t i = 0; i < args.nof_ue; i++) {
+    snapshot_db->addmod_rnti(bench_rnti(i), bench_cfg(bench_rnti(i), args.nof_carriers, 0));
+    snapshot_db->complete_config(bench_rnti(i));
+    for (uint32_t scell_idx = 1; scell_idx < args.nof_carriers; scell_idx++) {
+      snapshot_db->activate_deactivate_scell(bench_rnti(i), scell_idx, true);
+    }
+    locked_db.addmod_rnti(bench_rnti(i), bench_cfg(bench_rnti(i), args.nof_carriers, 0));
+  }
+
+  bench_result_t locked   = run_contention(locked_db, args);
+  bench_result_t snapshot = run_contention(*snapshot_db, args);
+
+  printf("%d readers, %d UEs, %d carriers, reconfiguration every %d us\n",
+         args.nof_readers,
+         args.nof_ue,
+         args.nof_carriers,
+         args.reconfig_period_us);
+  printf("%-10s %12s %14s %10s %17s %8s\n",
+         "Database",
+         "Mlookup/s",
+         "ns/lookup/thr",
+         "Reconfigs",
+         "Max reconfig (us)",
+         "Errors");
+  print_result("locked", locked);
+  print_result("snapshot", snapshot);
+  printf("Speedup: %.2f\n", snapshot.lookups_per_sec / locked.lookups_per_sec);
+
+  srslog::flush();
+
+  TESTASSERT(locked.nof_errors == 0);
+  TESTASSERT(snapshot.nof_errors == 0);
+  return SRSRAN_SUCCESS;
+}
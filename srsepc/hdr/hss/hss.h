@@ -28,13 +28,17 @@
 #ifndef SRSEPC_HSS_H
 #define SRSEPC_HSS_H
 
+#include "srsepc/hdr/hss/hss_sqn_log.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/rwlock_guard.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
+#include <atomic>
 #include <cstddef>
 
 #include <map>
+#include <unordered_map>
 
 #define LTE_FDD_ENB_IND_HE_N_BITS 5
 #define LTE_FDD_ENB_IND_HE_MASK 0x1FUL
@@ -45,8 +49,10 @@ namespace srsepc {
 
 struct hss_args_t {
   std::string db_file;
+  bool        db_sync;
   uint16_t    mcc;
   uint16_t    mnc;
+  uint32_t    sqn_log_max_records = 65536; ///< The SQN log is merged into the DB file when it reaches this size
 };
 
 enum hss_auth_algo { HSS_ALGO_XOR, HSS_ALGO_MILENAGE };
@@ -92,7 +98,7 @@ private:
   virtual ~hss();
   static hss* m_instance;
 
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> > m_imsi_to_ue_ctx;
+  std::unordered_map<uint64_t, hss_ue_ctx_t> m_imsi_to_ue_ctx;
 
   void gen_rand(uint8_t rand_[16]);
 
@@ -112,6 +118,9 @@ private:
   bool          set_auth_algo(std::string auth_algo);
   bool          read_db_file(std::string db_file);
   bool          write_db_file(std::string db_file);
+  bool          replay_sqn_log(const std::string& db_file, bool sync);
+  void          save_ue_sqn(hss_ue_ctx_t* ue_ctx);
+  void          compact_sqn_log();
   hss_ue_ctx_t* get_ue_ctx(uint64_t imsi);
 
   std::string hex_string(uint8_t* hex, int size);
@@ -121,6 +130,15 @@ private:
   /*Logs*/
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("HSS");
 
+  /// SQN updates since the DB file was last written
+  hss_sqn_log m_sqn_log{m_logger};
+
+  // The SQN updates hold the DB lock for reading, as they run concurrently for different users. The SQN log is merged
+  // into the DB file holding it for writing
+  pthread_rwlock_t      m_db_rwlock;
+  uint32_t              m_sqn_log_max_records = 0;
+  std::atomic<uint32_t> m_sqn_log_compact_size{0}; ///< Size of the SQN log that triggers the next merge
+
   uint16_t mcc;
   uint16_t mnc;
 
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        hss_sqn_log.h
+ * Description: Append-only log of the SQN updates of the HSS subscribers.
+ *****************************************************************************/
+
+#ifndef SRSEPC_HSS_SQN_LOG_H
+#define SRSEPC_HSS_SQN_LOG_H
+
+#include "srsran/srslog/srslog.h"
+#include <atomic>
+#include <functional>
+#include <string>
+
+namespace srsepc {
+
+/**
+ * Append-only log with the SQN updates of the HSS subscribers. Every update is written to the file with a single
+ * write() call, so that it is not lost if the EPC crashes, and optionally synced to the disk.
+ * At startup, the log is replayed on top of the user DB file. Once the DB file is rewritten with the latest SQNs, the
+ * log is cleared. Each record carries a checksum, so that a record that was partially written is detected and
+ * discarded.
+ */
+class hss_sqn_log
+{
+public:
+  using replay_callback_t = std::function<void(uint64_t imsi, const uint8_t* sqn)>;
+
+  explicit hss_sqn_log(srslog::basic_logger& logger_) : logger(logger_) {}
+  ~hss_sqn_log();
+  hss_sqn_log(const hss_sqn_log&) = delete;
+  hss_sqn_log& operator=(const hss_sqn_log&) = delete;
+
+  /// Opens or creates the log, and calls "replay" for each valid record found in it, from oldest to newest
+  bool open(const std::string& filename_, bool sync_, const replay_callback_t& replay);
+  void close();
+
+  bool append(uint64_t imsi, const uint8_t* sqn);
+  bool clear();
+
+  bool        is_open() const { return fd >= 0; }
+  uint32_t    nof_records() const { return nof_records_.load(std::memory_order_relaxed); }
+  std::string get_filename() const { return filename; }
+
+private:
+  struct record_t {
+    uint64_t imsi;
+    uint8_t  sqn[6];
+    uint16_t checksum;
+  };
+  static_assert(sizeof(record_t) == 16, "SQN log records must not have padding");
+
+  static uint16_t compute_checksum(const record_t& rec);
+
+  srslog::basic_logger& logger;
+  std::string           filename;
+  int                   fd   = -1;
+  bool                  sync = false;
+  // Updated by the concurrent appends of the S1AP workers
+  std::atomic<uint32_t> nof_records_{0};
+};
+
+/// Syncs the directory entry of a file to the disk, so that a newly created or renamed file survives a power loss
+bool sync_parent_dir(const std::string& filename);
+
+} // namespace srsepc
+
+#endif // SRSEPC_HSS_SQN_LOG_H
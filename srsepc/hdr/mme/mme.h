@@ -31,8 +31,11 @@
 #include "s1ap.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/common/threads.h"
 #include <cstddef>
+#include <memory>
+#include <mutex>
 
 namespace srsepc {
 
@@ -71,15 +74,30 @@ private:
   s1ap*       m_s1ap;
   mme_gtpc*   m_mme_gtpc;
 
-  bool   m_running;
-  fd_set m_set;
+  bool m_running;
+  int  m_epoll_fd = -1;
 
-  // Timer map
+  // Timer map. The timers are started and stopped by the S1AP workers
+  std::mutex               m_timers_mutex;
   std::vector<mme_timer_t> timers;
 
   // Timer Methods
   void handle_timer_expire(int timer_fd);
 
+  // S1AP workers. Each worker runs the procedures of the UEs in one shard, including the paging triggered by a Downlink
+  // Data Notification, while the MME thread reads the sockets and handles the non UE-associated signalling
+  using s1ap_task_t = srsran::move_callback<void(), srsran::default_move_callback_buffer_size, true>;
+  struct s1ap_rx_msg_t {
+    s1ap_pdu_t             pdu;
+    struct sctp_sndrcvinfo sri;
+  };
+  std::vector<std::unique_ptr<srsran::task_worker> > m_s1ap_workers;
+
+  void handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* sri);
+  void handle_s11_rx_pdu(srsran::unique_byte_buffer_t& pdu);
+  void delete_enb_ctx(int32_t assoc_id);
+  void push_s1ap_task(uint32_t shard_idx, s1ap_task_t&& task);
+
   // Logs
   srslog::basic_logger& m_s1ap_logger = srslog::fetch_basic_logger("S1AP");
 };
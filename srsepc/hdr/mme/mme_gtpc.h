@@ -24,6 +24,7 @@
 #include "nas.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
+#include <mutex>
 #include <sys/socket.h>
 #include <sys/un.h>
 
@@ -58,7 +59,8 @@ public:
   void         send_downlink_data_notification_acknowledge(uint64_t imsi, enum srsran::gtpc_cause_value cause);
   virtual bool send_downlink_data_notification_failure_indication(uint64_t imsi, enum srsran::gtpc_cause_value cause);
 
-  int get_s11();
+  int  get_s11();
+  bool get_imsi_from_ctrl_teid(uint32_t mme_ctrl_teid, uint64_t* imsi);
 
 private:
   mme_gtpc() = default;
@@ -66,6 +68,9 @@ private:
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("MME GTPC");
   s1ap*                 m_s1ap;
 
+  // Protects the GTP-C contexts, which are accessed by the S1AP workers. Released before sending to the SP-GW, as the
+  // send may block until the SP-GW drains its socket, which in turn may be waiting on the MME
+  std::mutex                          m_mutex;
   uint32_t                            m_next_ctrl_teid;
   std::map<uint32_t, uint64_t>        m_mme_ctr_teid_to_imsi;
   std::map<uint64_t, struct gtpc_ctx> m_imsi_to_gtpc_ctx;
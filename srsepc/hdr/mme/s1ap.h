@@ -39,6 +39,8 @@
 #include "srsran/srslog/srslog.h"
 #include <arpa/inet.h>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <netinet/sctp.h>
 #include <set>
 #include <strings.h>
@@ -68,11 +70,20 @@ public:
 
   bool s1ap_tx_pdu(const s1ap_pdu_t& pdu, struct sctp_sndrcvinfo* enb_sri);
   void handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri);
+  bool unpack_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, s1ap_pdu_t* rx_pdu);
+  void handle_s1ap_pdu(const s1ap_pdu_t& rx_pdu, struct sctp_sndrcvinfo* enb_sri);
   void handle_initiating_message(const asn1::s1ap::init_msg_s& msg, struct sctp_sndrcvinfo* enb_sri);
   void handle_successful_outcome(const asn1::s1ap::successful_outcome_s& msg);
 
   void activate_eps_bearer(uint64_t imsi, uint8_t ebi);
 
+  // UE shards. With S1AP workers, the procedures of a UE run in the worker of its shard
+  uint32_t        get_nof_ue_shards() const { return m_ue_shards.size(); }
+  int             get_s1ap_pdu_ue_shard(const s1ap_pdu_t& rx_pdu, const struct sctp_sndrcvinfo& enb_sri);
+  uint32_t        get_ue_shard(uint64_t imsi);
+  static void     set_current_ue_shard(uint32_t shard_idx);
+  static uint32_t get_current_ue_shard();
+
   void print_enb_ctx_info(const std::string& prefix, const enb_ctx_t& enb_ctx);
 
   uint32_t   get_plmn();
@@ -108,6 +119,9 @@ public:
   std::map<uint32_t, uint64_t>   m_tmsi_to_imsi;
   std::map<uint16_t, enb_ctx_t*> m_active_enbs;
 
+  // Protects the UE context maps indexed by IMSI and M-TMSI, and the eNB context maps
+  std::mutex m_ctx_mutex;
+
   // Interfaces
   virtual bool send_initial_context_setup_request(uint64_t imsi, uint16_t erab_to_setup);
   virtual bool send_ue_context_release_command(uint32_t mme_ue_s1ap_id);
@@ -141,10 +155,25 @@ private:
   std::map<int32_t, uint16_t>            m_sctp_to_enb_id;
   std::map<int32_t, std::set<uint32_t> > m_enb_assoc_to_ue_ids;
 
-  std::map<uint64_t, nas*> m_imsi_to_nas_ctx;
-  std::map<uint32_t, nas*> m_mme_ue_s1ap_id_to_nas_ctx;
+  std::map<uint64_t, nas*>     m_imsi_to_nas_ctx;
+  std::map<uint64_t, uint32_t> m_imsi_to_ue_shard;
+
+  // Each shard allocates the MME-UE-S1AP-IDs congruent to its index, modulo the number of shards, and keeps the UE
+  // contexts indexed by them
+  struct ue_shard_t {
+    std::mutex               mutex;
+    uint32_t                 next_mme_ue_s1ap_id = 0;
+    std::map<uint32_t, nas*> mme_ue_s1ap_id_to_nas_ctx;
+  };
+  std::vector<std::unique_ptr<ue_shard_t> > m_ue_shards;
+
+  ue_shard_t& get_ue_shard_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
+  {
+    return *m_ue_shards[mme_ue_s1ap_id % m_ue_shards.size()];
+  }
+  nas* find_nas_ctx_from_imsi_unsafe(uint64_t imsi);
+  int  get_initial_ue_message_shard(const asn1::s1ap::init_ue_msg_s& init_ue, const struct sctp_sndrcvinfo& enb_sri);
 
-  uint32_t m_next_mme_ue_s1ap_id;
   uint32_t m_next_m_tmsi;
 
   // GTP-C Interface
@@ -153,6 +182,7 @@ private:
   // PCAP
   bool              m_pcap_enable;
   srsran::s1ap_pcap m_pcap;
+  std::mutex        m_pcap_mutex;
 };
 
 inline uint32_t s1ap::get_plmn()
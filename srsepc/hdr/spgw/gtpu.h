@@ -22,6 +22,7 @@
 #ifndef SRSEPC_GTPU_H
 #define SRSEPC_GTPU_H
 
+#include "srsepc/hdr/spgw/gtpu_up_worker.h"
 #include "srsepc/hdr/spgw/spgw.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
@@ -29,11 +30,13 @@
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include <cstddef>
+#include <memory>
 #include <queue>
+#include <vector>
 
 namespace srsepc {
 
-class spgw::gtpu : public gtpu_interface_gtpc
+class spgw::gtpu : public gtpu_interface_gtpc, public gtpu_up_paging_handler
 {
 public:
   gtpu();
@@ -43,13 +46,18 @@ public:
 
   int init_sgi(spgw_args_t* args);
   int init_s1u(spgw_args_t* args);
-  int get_sgi();
-  int get_s1u();
+  void close_sgi_queues();
+  int  get_sgi();
+  int  get_s1u();
+  bool has_up_workers() const { return not m_up_workers.empty(); }
 
   void handle_sgi_pdu(srsran::unique_byte_buffer_t msg);
   void handle_s1u_pdu(srsran::byte_buffer_t* msg);
   void send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg);
 
+  // gtpu_up_paging_handler
+  void handle_paging_pdu(uint32_t spgw_ctrl_teid, srsran::unique_byte_buffer_t msg) override;
+
   virtual in_addr_t get_s1u_addr();
 
   virtual bool modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtp_fteid_t dw_user_fteid, uint32_t up_ctr_fteid);
@@ -61,17 +69,20 @@ public:
   spgw*                m_spgw;
   gtpc_interface_gtpu* m_gtpc;
 
-  bool m_sgi_up;
-  int  m_sgi;
+  bool             m_sgi_up;
+  int              m_sgi;
+  std::vector<int> m_sgi_queues; // One TUN queue per user-plane worker, m_sgi is the first one
+
+  bool             m_s1u_up;
+  int              m_s1u;
+  std::vector<int> m_s1u_socks; // One S1-U socket per user-plane worker, m_s1u is the first one
+  sockaddr_in      m_s1u_addr;
 
-  bool        m_s1u_up;
-  int         m_s1u;
-  sockaddr_in m_s1u_addr;
+  // UE IP to user-plane and control TEIDs. The control TEID is needed to check if the
+  // UE is attached without an active user-plane for downlink notifications.
+  gtpu_tunnel_table m_tunnels;
 
-  std::map<in_addr_t, srsran::gtp_fteid_t> m_ip_to_usr_teid; // Map IP to User-plane TEID for downlink traffic
-  std::map<in_addr_t, uint32_t>            m_ip_to_ctr_teid; // IP to control TEID map. Important to check if
-                                                             // UE is attached without an active user-plane
-                                                             // for downlink notifications.
+  std::vector<std::unique_ptr<gtpu_up_worker>> m_up_workers;
 
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("GTPU");
 };
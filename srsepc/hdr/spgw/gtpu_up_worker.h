@@ -0,0 +1,146 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        gtpu_up_worker.h
+ * Description: SP-GW user-plane workers. Each worker owns one S1-U socket and
+ *              one SGi TUN queue, and forwards GTP-U traffic in batches using
+ *              recvmmsg()/sendmmsg(). Uplink PDUs are steered to the workers
+ *              by TEID, downlink packets by the TUN queue flow hash.
+ *****************************************************************************/
+
+#ifndef SRSEPC_GTPU_UP_WORKER_H
+#define SRSEPC_GTPU_UP_WORKER_H
+
+#include "srsepc/hdr/spgw/spgw.h"
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/threads.h"
+#include "srsran/srslog/srslog.h"
+#include <array>
+#include <atomic>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <unordered_map>
+#include <vector>
+
+namespace srsepc {
+
+/// Result of a downlink tunnel lookup for a UE IP address.
+struct gtpu_dl_tunnel_t {
+  bool                usr_found      = false;
+  bool                ctr_found      = false;
+  srsran::gtp_fteid_t enb_fteid      = {};
+  uint32_t            spgw_ctrl_teid = 0;
+};
+
+/// UE IP to tunnel table. Written by GTP-C and read concurrently by the user-plane workers.
+class gtpu_tunnel_table
+{
+public:
+  gtpu_tunnel_table();
+  ~gtpu_tunnel_table();
+  gtpu_tunnel_table(const gtpu_tunnel_table&) = delete;
+  gtpu_tunnel_table& operator=(const gtpu_tunnel_table&) = delete;
+
+  void modify(in_addr_t ue_ipv4, const srsran::gtp_fteid_t& dw_user_fteid, uint32_t up_ctrl_teid);
+  bool delete_usr(in_addr_t ue_ipv4);
+  bool delete_ctr(in_addr_t ue_ipv4);
+
+  gtpu_dl_tunnel_t find(in_addr_t ue_ipv4) const;
+  /// Looks up a batch of UE addresses while taking the table lock only once.
+  void find(const in_addr_t* ue_ipv4, uint32_t nof_addrs, gtpu_dl_tunnel_t* tunnels) const;
+
+private:
+  gtpu_dl_tunnel_t find_unlocked(in_addr_t ue_ipv4) const;
+
+  mutable pthread_rwlock_t                        rwlock;
+  std::unordered_map<in_addr_t, gtpu_dl_tunnel_t> tunnels;
+};
+
+/// Interface for the downlink PDUs that the user-plane workers can not forward on their own.
+class gtpu_up_paging_handler
+{
+public:
+  /// Called for downlink PDUs of UEs that are attached but not ECM connected.
+  virtual void handle_paging_pdu(uint32_t spgw_ctrl_teid, srsran::unique_byte_buffer_t msg) = 0;
+};
+
+class gtpu_up_worker : public srsran::thread
+{
+public:
+  static const uint32_t max_batch_size = 32;
+
+  explicit gtpu_up_worker(uint32_t id_);
+  ~gtpu_up_worker();
+
+  /// The worker does not take ownership of the S1-U socket and SGi file descriptors.
+  void init(int                      s1u_fd_,
+            int                      sgi_fd_,
+            const gtpu_tunnel_table* tunnels_,
+            gtpu_up_paging_handler*  paging_,
+            uint16_t                 enb_gtpu_port_ = GTPU_RX_PORT);
+  void stop();
+
+  uint64_t get_nof_ul_pdus() const { return nof_ul_pdus.load(std::memory_order_relaxed); }
+  uint64_t get_nof_dl_pdus() const { return nof_dl_pdus.load(std::memory_order_relaxed); }
+  uint64_t get_nof_dropped() const { return nof_dropped.load(std::memory_order_relaxed); }
+
+private:
+  void run_thread() override;
+  void handle_s1u_batch();
+  void handle_sgi_batch();
+
+  uint32_t                 id            = 0;
+  int                      s1u_fd        = -1;
+  int                      sgi_fd        = -1;
+  uint16_t                 enb_gtpu_port = GTPU_RX_PORT;
+  const gtpu_tunnel_table* tunnels       = nullptr;
+  gtpu_up_paging_handler*  paging        = nullptr;
+  std::atomic<bool>        running       = {false};
+
+  // Batch state, reused between wakeups
+  std::array<srsran::unique_byte_buffer_t, max_batch_size> pdus;
+  std::array<struct mmsghdr, max_batch_size>               msgs;
+  std::array<struct iovec, max_batch_size>                 iovs;
+  std::array<struct sockaddr_in, max_batch_size>           addrs;
+  std::array<in_addr_t, max_batch_size>                    ue_addrs;
+  std::array<gtpu_dl_tunnel_t, max_batch_size>             dl_tunnels;
+
+  std::atomic<uint64_t> nof_ul_pdus = {0};
+  std::atomic<uint64_t> nof_dl_pdus = {0};
+  std::atomic<uint64_t> nof_dropped = {0};
+
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("GTPU");
+};
+
+/**
+ * Opens nof_sockets UDP sockets bound to the same address with SO_REUSEPORT, and attaches a BPF program that
+ * steers incoming GTP-U PDUs between them by TEID, so that all the PDUs of a bearer are handled by the same worker.
+ * If the port in addr is 0, it is updated with the port picked by the kernel.
+ */
+int gtpu_open_s1u_sockets(struct sockaddr_in*   addr,
+                          uint32_t              nof_sockets,
+                          std::vector<int>&     fds,
+                          srslog::basic_logger& logger);
+
+} // namespace srsepc
+#endif // SRSEPC_GTPU_UP_WORKER_H
@@ -33,6 +33,7 @@
 #include "srsran/common/threads.h"
 #include "srsran/srslog/srslog.h"
 #include <cstddef>
+#include <mutex>
 #include <queue>
 
 namespace srsepc {
@@ -46,6 +47,7 @@ typedef struct {
   std::string sgi_if_addr;
   std::string sgi_if_name;
   uint32_t    max_paging_queue;
+  uint32_t    nof_up_workers; // 0: the user plane is handled by the SP-GW thread
 } spgw_args_t;
 
 typedef struct spgw_tunnel_ctx {
@@ -87,6 +89,9 @@ private:
   gtpc* m_gtpc;
   gtpu* m_gtpu;
 
+  // Serializes GTP-C between the S11 thread and the user-plane workers that trigger paging
+  std::mutex m_gtpc_mutex;
+
   // Logs
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("SPGW");
 };
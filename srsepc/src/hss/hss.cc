@@ -22,12 +22,15 @@
 #include "srsran/common/security.h"
 #include "srsran/common/string_helpers.h"
 #include <arpa/inet.h>
+#include <fcntl.h>
 #include <inttypes.h> // for printing uint64_t
 #include <iomanip>
 #include <sstream>
+#include <stdio.h>
 #include <stdlib.h> /* srand, rand */
 #include <string>
 #include <time.h>
+#include <unistd.h>
 
 namespace srsepc {
 
@@ -36,12 +39,12 @@ pthread_mutex_t hss_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 hss::hss()
 {
-  return;
+  pthread_rwlock_init(&m_db_rwlock, nullptr);
 }
 
 hss::~hss()
 {
-  return;
+  pthread_rwlock_destroy(&m_db_rwlock);
 }
 
 hss* hss::get_instance()
@@ -79,6 +82,15 @@ int hss::init(hss_args_t* hss_args)
 
   db_file = hss_args->db_file;
 
+  m_sqn_log_max_records  = std::max(hss_args->sqn_log_max_records, 1u);
+  m_sqn_log_compact_size = m_sqn_log_max_records;
+
+  /*Apply the SQN updates that were not yet written to the DB file*/
+  if (not replay_sqn_log(db_file + ".sqn", hss_args->db_sync)) {
+    srsran::console("Error opening HSS SQN log %s.sqn\n", db_file.c_str());
+    return -1;
+  }
+
   m_logger.info("HSS Initialized. DB file %s, MCC: %d, MNC: %d", hss_args->db_file.c_str(), mcc, mnc);
   srsran::console("HSS Initialized.\n");
   return 0;
@@ -86,10 +98,82 @@ int hss::init(hss_args_t* hss_args)
 
 void hss::stop()
 {
-  write_db_file(db_file);
+  if (write_db_file(db_file)) {
+    // All the SQN updates are now in the DB file
+    m_sqn_log.clear();
+  } else {
+    m_logger.error("Failed to write DB file %s. The SQN updates are kept in %s",
+                   db_file.c_str(),
+                   m_sqn_log.get_filename().c_str());
+  }
+  m_sqn_log.close();
   return;
 }
 
+/// Column of a line of the user DB file
+struct db_field_t {
+  const char* ptr = nullptr;
+  size_t      len = 0;
+
+  bool        operator==(const char* s) const { return len == strlen(s) and strncmp(ptr, s, len) == 0; }
+  std::string to_string() const { return std::string(ptr, len); }
+};
+
+/// Splits a line of the user DB file at the commas, without copying the columns. Returns the number of columns
+template <size_t N>
+static size_t split_db_line(const std::string& line, std::array<db_field_t, N>& fields)
+{
+  const char* pos        = line.data();
+  const char* end        = line.data() + line.size();
+  size_t      nof_fields = 0;
+  while (true) {
+    const char* sep = static_cast<const char*>(memchr(pos, ',', end - pos));
+    if (nof_fields < N) {
+      fields[nof_fields].ptr = pos;
+      fields[nof_fields].len = (sep != nullptr ? sep : end) - pos;
+    }
+    nof_fields++;
+    if (sep == nullptr) {
+      return nof_fields;
+    }
+    pos = sep + 1;
+  }
+}
+
+/// Converts a column with an hex string into "len" bytes
+static bool get_uint_vec_from_hex_field(const db_field_t& field, uint8_t* vec, uint32_t len)
+{
+  if (field.len < 2 * len) {
+    return false;
+  }
+  for (uint32_t i = 0; i < 2 * len; ++i) {
+    char    c = field.ptr[i];
+    uint8_t nibble;
+    if (c >= '0' and c <= '9') {
+      nibble = c - '0';
+    } else if (c >= 'a' and c <= 'f') {
+      nibble = c - 'a' + 10;
+    } else if (c >= 'A' and c <= 'F') {
+      nibble = c - 'A' + 10;
+    } else {
+      return false;
+    }
+    vec[i / 2] = (i % 2 == 0) ? (nibble << 4u) : (vec[i / 2] | nibble);
+  }
+  return true;
+}
+
+/// Writes "len" bytes as an hex string
+static char* hex_to_str(const uint8_t* vec, uint32_t len, char* out)
+{
+  static const char digits[] = "0123456789abcdef";
+  for (uint32_t i = 0; i < len; ++i) {
+    *out++ = digits[vec[i] >> 4u];
+    *out++ = digits[vec[i] & 0xfu];
+  }
+  return out;
+}
+
 bool hss::read_db_file(std::string db_filename)
 {
   std::ifstream m_db_file;
@@ -100,45 +184,64 @@ bool hss::read_db_file(std::string db_filename)
   }
   m_logger.info("Opened DB file: %s", db_filename.c_str());
 
-  std::string line;
+  // Each line takes roughly 120 bytes. Size the table upfront to avoid rehashing with large DBs
+  m_db_file.seekg(0, std::ios::end);
+  m_imsi_to_ue_ctx.reserve(m_db_file.tellg() / 120);
+  m_db_file.seekg(0, std::ios::beg);
+
+  std::string                line;
+  const size_t               column_size = 10;
+  std::array<db_field_t, 10> split;
   while (std::getline(m_db_file, line)) {
     if (line[0] != '#' && line.length() > 0) {
-      uint                     column_size = 10;
-      std::vector<std::string> split       = srsran::split_string(line, ',');
-      if (split.size() != column_size) {
+      size_t nof_columns = split_db_line(line, split);
+      if (nof_columns != column_size) {
         m_logger.error("Error parsing UE database. Wrong number of columns in .csv");
-        m_logger.error("Columns: %zd, Expected %d.", split.size(), column_size);
+        m_logger.error("Columns: %zd, Expected %zd.", nof_columns, column_size);
 
         srsran::console("\nError parsing UE database. Wrong number of columns in user database CSV.\n");
         srsran::console("Perhaps you are using an old user_db.csv?\n");
         srsran::console("See 'srsepc/user_db.csv.example' for an example.\n\n");
         return false;
       }
-      std::unique_ptr<hss_ue_ctx_t> ue_ctx = std::unique_ptr<hss_ue_ctx_t>(new hss_ue_ctx_t);
-      ue_ctx->name                         = split[0];
-      if (split[1] == std::string("xor")) {
+      hss_ue_ctx_t  ue_ctx_tmp = {};
+      hss_ue_ctx_t* ue_ctx     = &ue_ctx_tmp;
+      ue_ctx->name             = split[0].to_string();
+      if (split[1] == "xor") {
         ue_ctx->algo = HSS_ALGO_XOR;
-      } else if (split[1] == std::string("mil")) {
+      } else if (split[1] == "mil") {
         ue_ctx->algo = HSS_ALGO_MILENAGE;
       } else {
         m_logger.error("Neither XOR nor MILENAGE configured.");
         return false;
       }
-      ue_ctx->imsi = strtoull(split[2].c_str(), nullptr, 10);
-      srsran::get_uint_vec_from_hex_str(split[3], ue_ctx->key, 16);
-      if (split[4] == std::string("op")) {
+      ue_ctx->imsi = strtoull(split[2].ptr, nullptr, 10);
+      if (not get_uint_vec_from_hex_field(split[3], ue_ctx->key, 16)) {
+        m_logger.error("Invalid Key of user %015" PRIu64 "", ue_ctx->imsi);
+        return false;
+      }
+      if (split[4] == "op") {
         ue_ctx->op_configured = true;
-        srsran::get_uint_vec_from_hex_str(split[5], ue_ctx->op, 16);
+        if (not get_uint_vec_from_hex_field(split[5], ue_ctx->op, 16)) {
+          m_logger.error("Invalid OP of user %015" PRIu64 "", ue_ctx->imsi);
+          return false;
+        }
         srsran::compute_opc(ue_ctx->key, ue_ctx->op, ue_ctx->opc);
-      } else if (split[4] == std::string("opc")) {
+      } else if (split[4] == "opc") {
         ue_ctx->op_configured = false;
-        srsran::get_uint_vec_from_hex_str(split[5], ue_ctx->opc, 16);
+        if (not get_uint_vec_from_hex_field(split[5], ue_ctx->opc, 16)) {
+          m_logger.error("Invalid OPc of user %015" PRIu64 "", ue_ctx->imsi);
+          return false;
+        }
       } else {
         m_logger.error("Neither OP nor OPc configured.");
         return false;
       }
-      srsran::get_uint_vec_from_hex_str(split[6], ue_ctx->amf, 2);
-      srsran::get_uint_vec_from_hex_str(split[7], ue_ctx->sqn, 6);
+      if (not get_uint_vec_from_hex_field(split[6], ue_ctx->amf, 2) or
+          not get_uint_vec_from_hex_field(split[7], ue_ctx->sqn, 6)) {
+        m_logger.error("Invalid AMF or SQN of user %015" PRIu64 "", ue_ctx->imsi);
+        return false;
+      }
 
       m_logger.debug("Added user from DB, IMSI: %015" PRIu64 "", ue_ctx->imsi);
       m_logger.debug(ue_ctx->key, 16, "User Key : ");
@@ -148,27 +251,29 @@ bool hss::read_db_file(std::string db_filename)
       m_logger.debug(ue_ctx->opc, 16, "User OPc : ");
       m_logger.debug(ue_ctx->amf, 2, "AMF : ");
       m_logger.debug(ue_ctx->sqn, 6, "SQN : ");
-      ue_ctx->qci = (uint16_t)strtol(split[8].c_str(), nullptr, 10);
+      ue_ctx->qci = (uint16_t)strtol(split[8].ptr, nullptr, 10);
       m_logger.debug("Default Bearer QCI: %d", ue_ctx->qci);
 
-      if (split[9] == std::string("dynamic")) {
+      if (split[9] == "dynamic") {
         ue_ctx->static_ip_addr = "0.0.0.0";
       } else {
-        char buf[128] = {0};
-        if (inet_pton(AF_INET, split[9].c_str(), buf)) {
-          if (m_ip_to_imsi.insert(std::make_pair(split[9], ue_ctx->imsi)).second) {
-            ue_ctx->static_ip_addr = split[9];
+        std::string ip_addr  = split[9].to_string();
+        char        buf[128] = {0};
+        if (inet_pton(AF_INET, ip_addr.c_str(), buf)) {
+          if (m_ip_to_imsi.insert(std::make_pair(ip_addr, ue_ctx->imsi)).second) {
+            ue_ctx->static_ip_addr = ip_addr;
             m_logger.info("static ip addr %s", ue_ctx->static_ip_addr.c_str());
           } else {
-            m_logger.info("duplicate static ip addr %s", split[9].c_str());
+            m_logger.info("duplicate static ip addr %s", ip_addr.c_str());
             return false;
           }
         } else {
-          m_logger.info("invalid static ip addr %s, %s", split[9].c_str(), strerror(errno));
+          m_logger.info("invalid static ip addr %s, %s", ip_addr.c_str(), strerror(errno));
           return false;
         }
       }
-      m_imsi_to_ue_ctx.insert(std::make_pair(ue_ctx->imsi, std::move(ue_ctx)));
+      uint64_t imsi = ue_ctx->imsi;
+      m_imsi_to_ue_ctx.insert(std::make_pair(imsi, std::move(ue_ctx_tmp)));
     }
   }
 
@@ -181,19 +286,16 @@ bool hss::read_db_file(std::string db_filename)
 
 bool hss::write_db_file(std::string db_filename)
 {
-  std::string line;
-  uint8_t     k[16];
-  uint8_t     amf[2];
-  uint8_t     op[16];
-  uint8_t     sqn[6];
-
+  // The DB is written to a temporary file, which then replaces the old one. This way, the DB file is not left
+  // half-written if the EPC is killed in the middle
+  std::string   tmp_filename = db_filename + ".tmp";
   std::ofstream m_db_file;
 
-  m_db_file.open(db_filename.c_str(), std::ofstream::out);
+  m_db_file.open(tmp_filename.c_str(), std::ofstream::out);
   if (!m_db_file.is_open()) {
     return false;
   }
-  m_logger.info("Opened DB file: %s", db_filename.c_str());
+  m_logger.info("Opened DB file: %s", tmp_filename.c_str());
 
   // Write comment info
   m_db_file << "#                                                                                           \n"
@@ -216,44 +318,118 @@ bool hss::write_db_file(std::string db_filename)
             << "#                                                                                           \n"
             << "# Note: Lines starting by '#' are ignored and will be overwritten                           \n";
 
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator it = m_imsi_to_ue_ctx.begin();
-  while (it != m_imsi_to_ue_ctx.end()) {
-    m_db_file << it->second->name;
-    m_db_file << ",";
-    m_db_file << (it->second->algo == HSS_ALGO_XOR ? "xor" : "mil");
-    m_db_file << ",";
-    m_db_file << std::setfill('0') << std::setw(15) << it->second->imsi;
-    m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->key, 16);
-    m_db_file << ",";
-    if (it->second->op_configured) {
-      m_db_file << "op,";
-      m_db_file << srsran::hex_string(it->second->op, 16);
+  // Keep the users sorted by IMSI in the file
+  std::vector<const hss_ue_ctx_t*> ue_list;
+  ue_list.reserve(m_imsi_to_ue_ctx.size());
+  for (const auto& it : m_imsi_to_ue_ctx) {
+    ue_list.push_back(&it.second);
+  }
+  std::sort(ue_list.begin(), ue_list.end(), [](const hss_ue_ctx_t* a, const hss_ue_ctx_t* b) {
+    return a->imsi < b->imsi;
+  });
+
+  for (const hss_ue_ctx_t* ue_ctx : ue_list) {
+    char  line[128];
+    char* pos = line;
+    pos += snprintf(pos, 32, ",%s,%015" PRIu64 ",", ue_ctx->algo == HSS_ALGO_XOR ? "xor" : "mil", ue_ctx->imsi);
+    pos = hex_to_str(ue_ctx->key, 16, pos);
+    if (ue_ctx->op_configured) {
+      pos = hex_to_str(ue_ctx->op, 16, (char*)memcpy(pos, ",op,", 4) + 4);
     } else {
-      m_db_file << "opc,";
-      m_db_file << srsran::hex_string(it->second->opc, 16);
+      pos = hex_to_str(ue_ctx->opc, 16, (char*)memcpy(pos, ",opc,", 5) + 5);
     }
-    m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->amf, 2);
-    m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->sqn, 6);
-    m_db_file << ",";
-    m_db_file << it->second->qci;
-    if (it->second->static_ip_addr != "0.0.0.0") {
-      m_db_file << ",";
-      m_db_file << it->second->static_ip_addr;
+    *pos++ = ',';
+    pos    = hex_to_str(ue_ctx->amf, 2, pos);
+    *pos++ = ',';
+    pos    = hex_to_str(ue_ctx->sqn, 6, pos);
+    pos += snprintf(pos, 8, ",%d,", ue_ctx->qci);
+    m_db_file << ue_ctx->name;
+    m_db_file.write(line, pos - line);
+    if (ue_ctx->static_ip_addr != "0.0.0.0") {
+      m_db_file << ue_ctx->static_ip_addr;
     } else {
-      m_db_file << ",dynamic";
+      m_db_file << "dynamic";
     }
-    m_db_file << std::endl;
-    it++;
+    m_db_file << '\n';
   }
-  if (m_db_file.is_open()) {
-    m_db_file.close();
+  m_db_file.flush();
+  if (not m_db_file.good()) {
+    m_logger.error("Error writing DB file %s", tmp_filename.c_str());
+    return false;
+  }
+  m_db_file.close();
+
+  // The SQN log is cleared once the DB file is written, so the new file must reach the disk before it replaces the
+  // old one, and the rename must reach the disk before the log is cleared
+  int fd = open(tmp_filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0 or fsync(fd) < 0) {
+    m_logger.error("Error syncing DB file %s: %s", tmp_filename.c_str(), strerror(errno));
+    if (fd >= 0) {
+      close(fd);
+    }
+    return false;
+  }
+  close(fd);
+
+  if (rename(tmp_filename.c_str(), db_filename.c_str()) < 0) {
+    m_logger.error("Error replacing DB file %s: %s", db_filename.c_str(), strerror(errno));
+    return false;
+  }
+  if (not sync_parent_dir(db_filename)) {
+    m_logger.error("Error syncing the directory of DB file %s: %s", db_filename.c_str(), strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+bool hss::replay_sqn_log(const std::string& log_filename, bool sync)
+{
+  uint32_t nof_unknown = 0;
+  auto     replay      = [this, &nof_unknown](uint64_t imsi, const uint8_t* sqn) {
+    auto it = m_imsi_to_ue_ctx.find(imsi);
+    if (it == m_imsi_to_ue_ctx.end()) {
+      // The user was removed from the DB file
+      nof_unknown++;
+      return;
+    }
+    it->second.set_sqn(sqn);
+  };
+  if (not m_sqn_log.open(log_filename, sync, replay)) {
+    return false;
+  }
+  if (nof_unknown > 0) {
+    m_logger.warning("Ignored %d SQN updates of users not present in the DB file", nof_unknown);
+  }
+  if (m_sqn_log.nof_records() > 0) {
+    m_logger.info("Restored %d SQN updates from %s", m_sqn_log.nof_records(), log_filename.c_str());
   }
   return true;
 }
 
+void hss::save_ue_sqn(hss_ue_ctx_t* ue_ctx)
+{
+  if (not m_sqn_log.append(ue_ctx->imsi, ue_ctx->sqn)) {
+    m_logger.error("SQN of user %015" PRIu64 " will not be restored after a restart", ue_ctx->imsi);
+  }
+}
+
+void hss::compact_sqn_log()
+{
+  srsran::rwlock_write_guard lock(m_db_rwlock);
+  if (m_sqn_log.nof_records() < m_sqn_log_compact_size) {
+    // Already merged by another thread
+    return;
+  }
+  if (write_db_file(db_file) and m_sqn_log.clear()) {
+    m_logger.info("Merged the SQN log into DB file %s", db_file.c_str());
+    m_sqn_log_compact_size = m_sqn_log_max_records;
+  } else {
+    // Try again once the log has grown by the same amount
+    m_logger.error("Failed to merge the SQN log into DB file %s", db_file.c_str());
+    m_sqn_log_compact_size = m_sqn_log.nof_records() + m_sqn_log_max_records;
+  }
+}
+
 bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres)
 {
 
@@ -265,15 +441,23 @@ bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, ui
     return false;
   }
 
-  switch (ue_ctx->algo) {
-    case HSS_ALGO_XOR:
-      gen_auth_info_answer_xor(ue_ctx, k_asme, autn, rand, xres);
-      break;
-    case HSS_ALGO_MILENAGE:
-      gen_auth_info_answer_milenage(ue_ctx, k_asme, autn, rand, xres);
-      break;
+  {
+    // The DB file is not written while the SQN is updated
+    srsran::rwlock_read_guard lock(m_db_rwlock);
+    switch (ue_ctx->algo) {
+      case HSS_ALGO_XOR:
+        gen_auth_info_answer_xor(ue_ctx, k_asme, autn, rand, xres);
+        break;
+      case HSS_ALGO_MILENAGE:
+        gen_auth_info_answer_milenage(ue_ctx, k_asme, autn, rand, xres);
+        break;
+    }
+    increment_ue_sqn(ue_ctx);
+    save_ue_sqn(ue_ctx);
+  }
+  if (m_sqn_log.nof_records() >= m_sqn_log_compact_size) {
+    compact_sqn_log();
   }
-  increment_ue_sqn(ue_ctx);
   return true;
 }
 
@@ -440,13 +624,13 @@ void hss::gen_auth_info_answer_xor(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_
 
 bool hss::gen_update_loc_answer(uint64_t imsi, uint8_t* qci)
 {
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
+  auto ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
   if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
     m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
     srsran::console("User not found at HSS. IMSI: %015" PRIu64 "\n", imsi);
     return false;
   }
-  const std::unique_ptr<hss_ue_ctx_t>& ue_ctx = ue_ctx_it->second;
+  const hss_ue_ctx_t* ue_ctx = &ue_ctx_it->second;
   m_logger.info("Found User %015" PRIu64 "", imsi);
   *qci = ue_ctx->qci;
   return true;
@@ -462,16 +646,24 @@ bool hss::resync_sqn(uint64_t imsi, uint8_t* auts)
     return false;
   }
 
-  switch (ue_ctx->algo) {
-    case HSS_ALGO_XOR:
-      resync_sqn_xor(ue_ctx, auts);
-      break;
-    case HSS_ALGO_MILENAGE:
-      resync_sqn_milenage(ue_ctx, auts);
-      break;
-  }
+  {
+    // The DB file is not written while the SQN is updated
+    srsran::rwlock_read_guard lock(m_db_rwlock);
+    switch (ue_ctx->algo) {
+      case HSS_ALGO_XOR:
+        resync_sqn_xor(ue_ctx, auts);
+        break;
+      case HSS_ALGO_MILENAGE:
+        resync_sqn_milenage(ue_ctx, auts);
+        break;
+    }
 
-  increment_seq_after_resync(ue_ctx);
+    increment_seq_after_resync(ue_ctx);
+    save_ue_sqn(ue_ctx);
+  }
+  if (m_sqn_log.nof_records() >= m_sqn_log_compact_size) {
+    compact_sqn_log();
+  }
   return true;
 }
 
@@ -612,13 +804,13 @@ void hss::gen_rand(uint8_t rand_[16])
 
 hss_ue_ctx_t* hss::get_ue_ctx(uint64_t imsi)
 {
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
+  auto ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
   if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
     m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
     return nullptr;
   }
 
-  return ue_ctx_it->second.get();
+  return &ue_ctx_it->second;
 }
 
 std::map<std::string, uint64_t> hss::get_ip_to_imsi(void) const
@@ -0,0 +1,168 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/hss/hss_sqn_log.h"
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+namespace srsepc {
+
+hss_sqn_log::~hss_sqn_log()
+{
+  close();
+}
+
+bool hss_sqn_log::open(const std::string& filename_, bool sync_, const replay_callback_t& replay)
+{
+  close();
+  filename = filename_;
+  sync     = sync_;
+
+  fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+  if (fd < 0) {
+    logger.error("Failed to open SQN log %s: %s", filename.c_str(), strerror(errno));
+    return false;
+  }
+  if (sync and not sync_parent_dir(filename)) {
+    logger.error("Failed to sync the directory of SQN log %s: %s", filename.c_str(), strerror(errno));
+    close();
+    return false;
+  }
+
+  // Replay the log in chunks of records
+  std::vector<record_t> chunk(4096);
+  off_t                 valid_size = 0;
+  bool                  corrupted  = false;
+  nof_records_                     = 0;
+  while (not corrupted) {
+    ssize_t n = pread(fd, chunk.data(), chunk.size() * sizeof(record_t), valid_size);
+    if (n < 0) {
+      logger.error("Failed to read SQN log %s: %s", filename.c_str(), strerror(errno));
+      close();
+      return false;
+    }
+    size_t nof_read = n / sizeof(record_t);
+    for (size_t i = 0; i < nof_read; ++i) {
+      if (chunk[i].checksum != compute_checksum(chunk[i])) {
+        corrupted = true;
+        break;
+      }
+      replay(chunk[i].imsi, chunk[i].sqn);
+      valid_size += sizeof(record_t);
+      nof_records_++;
+    }
+    if (nof_read < chunk.size()) {
+      // End of file. A trailing partial record is the result of an interrupted write
+      corrupted |= (n % sizeof(record_t)) != 0;
+      break;
+    }
+  }
+
+  if (corrupted) {
+    logger.warning("Discarding the end of SQN log %s, which was not completely written", filename.c_str());
+    if (ftruncate(fd, valid_size) < 0) {
+      logger.error("Failed to truncate SQN log %s: %s", filename.c_str(), strerror(errno));
+      close();
+      return false;
+    }
+  }
+  logger.info("Opened SQN log %s with %d records", filename.c_str(), nof_records());
+  return true;
+}
+
+void hss_sqn_log::close()
+{
+  if (fd >= 0) {
+    ::close(fd);
+    fd = -1;
+  }
+}
+
+bool hss_sqn_log::append(uint64_t imsi, const uint8_t* sqn)
+{
+  if (fd < 0) {
+    return false;
+  }
+  record_t rec = {};
+  rec.imsi     = imsi;
+  memcpy(rec.sqn, sqn, sizeof(rec.sqn));
+  rec.checksum = compute_checksum(rec);
+
+  if (write(fd, &rec, sizeof(rec)) != sizeof(rec)) {
+    logger.error("Failed to write SQN log %s: %s", filename.c_str(), strerror(errno));
+    return false;
+  }
+  if (sync and fdatasync(fd) < 0) {
+    logger.error("Failed to sync SQN log %s: %s", filename.c_str(), strerror(errno));
+    return false;
+  }
+  nof_records_++;
+  return true;
+}
+
+bool hss_sqn_log::clear()
+{
+  if (fd < 0) {
+    return false;
+  }
+  if (ftruncate(fd, 0) < 0) {
+    logger.error("Failed to clear SQN log %s: %s", filename.c_str(), strerror(errno));
+    return false;
+  }
+  if (sync and fdatasync(fd) < 0) {
+    logger.error("Failed to sync SQN log %s: %s", filename.c_str(), strerror(errno));
+    return false;
+  }
+  nof_records_ = 0;
+  return true;
+}
+
+uint16_t hss_sqn_log::compute_checksum(const record_t& rec)
+{
+  // Fletcher-16 over the record contents. The constant makes an all-zeros record invalid
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&rec);
+  uint32_t       sum1 = 0, sum2 = 0;
+  for (size_t i = 0; i < offsetof(record_t, checksum); ++i) {
+    sum1 = (sum1 + bytes[i]) % 255;
+    sum2 = (sum2 + sum1) % 255;
+  }
+  return static_cast<uint16_t>((sum2 << 8u) | sum1) ^ 0xa55au;
+}
+
+bool sync_parent_dir(const std::string& filename)
+{
+  size_t      pos = filename.rfind('/');
+  std::string dir = pos == std::string::npos ? "." : filename.substr(0, std::max<size_t>(pos, 1));
+  int         fd  = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  int ret = fsync(fd);
+  ::close(fd);
+  return ret == 0;
+}
+
+} // namespace srsepc
@@ -87,6 +87,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   string   integrity_algo;
   uint16_t paging_timer     = 0;
   uint32_t max_paging_queue = 0;
+  uint32_t nof_up_workers   = 0;
+  uint32_t nof_s1ap_workers = 0;
   string   spgw_bind_addr;
   string   sgi_if_addr;
   string   sgi_if_name;
@@ -95,6 +97,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   string   short_net_name;
   bool     request_imeisv;
   string   hss_db_file;
+  bool     hss_db_sync;
   string   hss_auth_algo;
   string   log_filename;
 
@@ -124,11 +127,14 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("mme.integrity_algo",  bpo::value<string>(&integrity_algo)->default_value("EIA1"),      "Set preferred integrity protection algorithm for NAS")
     ("mme.paging_timer",    bpo::value<uint16_t>(&paging_timer)->default_value(2),           "Set paging timer value in seconds (T3413)")
     ("mme.request_imeisv",  bpo::value<bool>(&request_imeisv)->default_value(false),         "Enable IMEISV request in Security mode command")
+    ("mme.s1ap_workers",    bpo::value<uint32_t>(&nof_s1ap_workers)->default_value(0),       "Number of S1AP worker threads, each handling a shard of the UEs (0: S1AP handled by the MME thread)")
     ("hss.db_file",         bpo::value<string>(&hss_db_file)->default_value("ue_db.csv"),    ".csv file that stores UE's keys")
+    ("hss.db_sync",         bpo::value<bool>(&hss_db_sync)->default_value(false),            "Sync each SQN update to disk before answering")
     ("spgw.gtpu_bind_addr", bpo::value<string>(&spgw_bind_addr)->default_value("127.0.0.1"), "IP address of SP-GW for the S1-U connection")
     ("spgw.sgi_if_addr",    bpo::value<string>(&sgi_if_addr)->default_value("176.16.0.1"),   "IP address of TUN interface for the SGi connection")
     ("spgw.sgi_if_name",    bpo::value<string>(&sgi_if_name)->default_value("srs_spgw_sgi"), "Name of TUN interface for the SGi connection")
     ("spgw.max_paging_queue", bpo::value<uint32_t>(&max_paging_queue)->default_value(100), "Max number of packets in paging queue")
+    ("spgw.up_workers",     bpo::value<uint32_t>(&nof_up_workers)->default_value(0),         "Number of user-plane worker threads (0: user plane handled by the SP-GW thread)")
 
     ("pcap.enable",   bpo::value<bool>(&args->mme_args.s1ap_args.pcap_enable)->default_value(false),         "Enable S1AP PCAP")
     ("pcap.filename", bpo::value<string>(&args->mme_args.s1ap_args.pcap_filename)->default_value("/tmp/epc.pcap"), "PCAP filename")
@@ -284,11 +290,14 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   args->mme_args.s1ap_args.mme_apn        = mme_apn;
   args->mme_args.s1ap_args.paging_timer   = paging_timer;
   args->mme_args.s1ap_args.request_imeisv = request_imeisv;
+  args->mme_args.s1ap_args.nof_workers    = nof_s1ap_workers;
   args->spgw_args.gtpu_bind_addr          = spgw_bind_addr;
   args->spgw_args.sgi_if_addr             = sgi_if_addr;
   args->spgw_args.sgi_if_name             = sgi_if_name;
   args->spgw_args.max_paging_queue        = max_paging_queue;
+  args->spgw_args.nof_up_workers          = nof_up_workers;
   args->hss_args.db_file                  = hss_db_file;
+  args->hss_args.db_sync                  = hss_db_sync;
 
   // Apply all_level to any unset layers
   if (vm.count("log.all_level")) {
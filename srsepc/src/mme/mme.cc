@@ -21,8 +21,11 @@
 
 #include "srsepc/hdr/mme/mme.h"
 #include <arpa/inet.h>
+#include <condition_variable>
+#include <fcntl.h>
 #include <inttypes.h> // for printing uint64_t
 #include <netinet/sctp.h>
+#include <sys/epoll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 
@@ -31,6 +34,9 @@ namespace srsepc {
 mme*            mme::m_instance    = NULL;
 pthread_mutex_t mme_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+// Maximum number of procedures waiting in each S1AP worker
+static const uint32_t s1ap_worker_queue_size = 4096;
+
 mme::mme() : m_running(false), thread("MME")
 {
   return;
@@ -77,8 +83,36 @@ int mme::init(mme_args_t* args)
     exit(-1);
   }
 
+  /*Init the event loop with the S1-MME and S11 sockets*/
+  m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (m_epoll_fd < 0) {
+    m_s1ap_logger.error("Error creating epoll instance: %s", strerror(errno));
+    return -1;
+  }
+  int fds[] = {m_s1ap->get_s1_mme(), m_mme_gtpc->get_s11()};
+  for (int fd : fds) {
+    struct epoll_event ev = {};
+    ev.events             = EPOLLIN;
+    ev.data.fd            = fd;
+    if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+      m_s1ap_logger.error("Error adding socket to epoll: %s", strerror(errno));
+      return -1;
+    }
+  }
+
+  /*Init S1AP workers*/
+  for (uint32_t i = 0; i < args->s1ap_args.nof_workers; ++i) {
+    std::unique_ptr<srsran::task_worker> worker(
+        new srsran::task_worker("S1AP_W_" + std::to_string(i), s1ap_worker_queue_size));
+    worker->push_task([i]() { s1ap::set_current_ue_shard(i); });
+    m_s1ap_workers.push_back(std::move(worker));
+  }
+
   /*Log successful initialization*/
-  m_s1ap_logger.info("MME Initialized. MCC: 0x%x, MNC: 0x%x", args->s1ap_args.mcc, args->s1ap_args.mnc);
+  m_s1ap_logger.info("MME Initialized. MCC: 0x%x, MNC: 0x%x, S1AP workers: %d",
+                     args->s1ap_args.mcc,
+                     args->s1ap_args.mnc,
+                     args->s1ap_args.nof_workers);
   srsran::console("MME Initialized. MCC: 0x%x, MNC: 0x%x\n", args->s1ap_args.mcc, args->s1ap_args.mnc);
   return 0;
 }
@@ -86,11 +120,17 @@ int mme::init(mme_args_t* args)
 void mme::stop()
 {
   if (m_running) {
-    m_s1ap->stop();
-    m_s1ap->cleanup();
     m_running = false;
     thread_cancel();
     wait_thread_finish();
+    for (std::unique_ptr<srsran::task_worker>& worker : m_s1ap_workers) {
+      worker->stop();
+    }
+    m_s1ap_workers.clear();
+    m_s1ap->stop();
+    m_s1ap->cleanup();
+    close(m_epoll_fd);
+    m_epoll_fd = -1;
   }
   return;
 }
@@ -111,6 +151,9 @@ void mme::run_thread()
   int rd_sz;
   int msg_flags = 0;
 
+  const int          max_events = 32;
+  struct epoll_event events[max_events];
+
   // Mark the thread as running
   m_running = true;
 
@@ -119,27 +162,19 @@ void mme::run_thread()
   int s11   = m_mme_gtpc->get_s11();
 
   while (m_running) {
-    pdu->clear();
-    int max_fd = std::max(s1mme, s11);
-
-    FD_ZERO(&m_set);
-    FD_SET(s1mme, &m_set);
-    FD_SET(s11, &m_set);
-
-    // Add timers to select
-    for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end(); ++it) {
-      FD_SET(it->fd, &m_set);
-      max_fd = std::max(max_fd, it->fd);
-      m_s1ap_logger.debug("Adding Timer fd %d to fd_set", it->fd);
-    }
-
     m_s1ap_logger.debug("Waiting for S1-MME or S11 Message");
-    int n = select(max_fd + 1, &m_set, NULL, NULL, NULL);
+    int n = epoll_wait(m_epoll_fd, events, max_events, -1);
     if (n == -1) {
-      m_s1ap_logger.error("Error from select");
-    } else if (n) {
-      // Handle S1-MME
-      if (FD_ISSET(s1mme, &m_set)) {
+      if (errno != EINTR) {
+        m_s1ap_logger.error("Error from epoll_wait: %s", strerror(errno));
+      }
+      continue;
+    }
+    for (int i = 0; i < n; ++i) {
+      int fd = events[i].data.fd;
+      pdu->clear();
+      if (fd == s1mme) {
+        // Handle S1-MME
         rd_sz = sctp_recvmsg(s1mme, pdu->msg, sz, (struct sockaddr*)&enb_addr, &fromlen, &sri, &msg_flags);
         if (rd_sz == -1 && errno != EAGAIN) {
           m_s1ap_logger.error("Error reading from SCTP socket: %s", strerror(errno));
@@ -153,41 +188,129 @@ void mme::run_thread()
             if (notification->sn_header.sn_type == SCTP_SHUTDOWN_EVENT) {
               m_s1ap_logger.info("SCTP Association Shutdown. Association: %d", sri.sinfo_assoc_id);
               srsran::console("SCTP Association Shutdown. Association: %d\n", sri.sinfo_assoc_id);
-              m_s1ap->delete_enb_ctx(sri.sinfo_assoc_id);
+              delete_enb_ctx(sri.sinfo_assoc_id);
             }
           } else {
             // Received data
             pdu->N_bytes = rd_sz;
             m_s1ap_logger.info("Received S1AP msg. Size: %d", pdu->N_bytes);
-            m_s1ap->handle_s1ap_rx_pdu(pdu.get(), &sri);
+            handle_s1ap_rx_pdu(pdu.get(), &sri);
           }
         }
-      }
-      // Handle S11
-      if (FD_ISSET(s11, &m_set)) {
+      } else if (fd == s11) {
+        // Handle S11
         pdu->N_bytes = recvfrom(s11, pdu->msg, sz, 0, NULL, NULL);
-        m_mme_gtpc->handle_s11_pdu(pdu.get());
-      }
-      // Handle NAS Timers
-      for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end();) {
-        if (FD_ISSET(it->fd, &m_set)) {
-          m_s1ap_logger.info("Timer expired");
-          uint64_t exp;
-          rd_sz = read(it->fd, &exp, sizeof(uint64_t));
-          m_s1ap->expire_nas_timer(it->type, it->imsi);
-          close(it->fd);
-          timers.erase(it);
-        } else {
-          ++it;
+        handle_s11_rx_pdu(pdu);
+        if (pdu == nullptr) {
+          pdu = srsran::make_byte_buffer("mme::run_thread");
+          if (pdu == nullptr) {
+            m_s1ap_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+            return;
+          }
         }
+      } else {
+        // Handle NAS Timers
+        handle_timer_expire(fd);
       }
-    } else {
-      m_s1ap_logger.debug("No data from select.");
     }
   }
   return;
 }
 
+/*
+ * S1AP workers
+ */
+void mme::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* sri)
+{
+  if (m_s1ap_workers.empty()) {
+    m_s1ap->handle_s1ap_rx_pdu(pdu, sri);
+    return;
+  }
+
+  std::shared_ptr<s1ap_rx_msg_t> msg = std::make_shared<s1ap_rx_msg_t>();
+  msg->sri                           = *sri;
+  if (!m_s1ap->unpack_s1ap_rx_pdu(pdu, &msg->pdu)) {
+    return;
+  }
+  int shard_idx = m_s1ap->get_s1ap_pdu_ue_shard(msg->pdu, msg->sri);
+  if (shard_idx < 0) {
+    // Non UE-associated signalling
+    m_s1ap->handle_s1ap_pdu(msg->pdu, &msg->sri);
+    return;
+  }
+  push_s1ap_task(shard_idx, [this, msg]() { m_s1ap->handle_s1ap_pdu(msg->pdu, &msg->sri); });
+}
+
+void mme::handle_s11_rx_pdu(srsran::unique_byte_buffer_t& pdu)
+{
+  uint64_t imsi;
+  if (m_s1ap_workers.empty() ||
+      !m_mme_gtpc->get_imsi_from_ctrl_teid(((srsran::gtpc_pdu*)pdu->msg)->header.teid, &imsi)) {
+    m_mme_gtpc->handle_s11_pdu(pdu.get());
+    return;
+  }
+
+  // The worker takes the ownership of the PDU. A Downlink Data Notification pages the UE from its shard, as the paging
+  // starts T3413 in the UE NAS context
+  std::shared_ptr<srsran::byte_buffer_t> s11_pdu(std::move(pdu));
+  push_s1ap_task(m_s1ap->get_ue_shard(imsi), [this, s11_pdu]() { m_mme_gtpc->handle_s11_pdu(s11_pdu.get()); });
+}
+
+void mme::delete_enb_ctx(int32_t assoc_id)
+{
+  if (m_s1ap_workers.empty()) {
+    m_s1ap->delete_enb_ctx(assoc_id);
+    return;
+  }
+
+  // The UEs of the eNB are spread across all the shards. Park the workers while their contexts are released
+  struct barrier_t {
+    std::mutex              mutex;
+    std::condition_variable cvar;
+    uint32_t                nof_parked = 0;
+    bool                    resume     = false;
+  };
+  std::shared_ptr<barrier_t> barrier = std::make_shared<barrier_t>();
+  for (uint32_t i = 0; i < m_s1ap_workers.size(); ++i) {
+    push_s1ap_task(i, [barrier]() {
+      std::unique_lock<std::mutex> lock(barrier->mutex);
+      barrier->nof_parked++;
+      barrier->cvar.notify_all();
+      while (not barrier->resume) {
+        barrier->cvar.wait(lock);
+      }
+    });
+  }
+
+  // The parked workers depend on this thread to resume, so it must not be cancelled in between
+  int cancel_state;
+  pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &cancel_state);
+  {
+    std::unique_lock<std::mutex> lock(barrier->mutex);
+    while (barrier->nof_parked < m_s1ap_workers.size()) {
+      barrier->cvar.wait(lock);
+    }
+  }
+  m_s1ap->delete_enb_ctx(assoc_id);
+  {
+    std::lock_guard<std::mutex> lock(barrier->mutex);
+    barrier->resume = true;
+  }
+  barrier->cvar.notify_all();
+  pthread_setcancelstate(cancel_state, NULL);
+}
+
+void mme::push_s1ap_task(uint32_t shard_idx, s1ap_task_t&& task)
+{
+  // Rather than dropping procedures, hold the MME thread back until the worker catches up. The eNBs then see the
+  // backpressure of the SCTP socket
+  srsran::task_worker& worker = *m_s1ap_workers[shard_idx];
+  while (worker.nof_pending_tasks() >= s1ap_worker_queue_size) {
+    usleep(100);
+  }
+  worker.push_task(std::move(task));
+}
+
 /*
  * Timer Handling
  */
@@ -195,17 +318,29 @@ bool mme::add_nas_timer(int timer_fd, nas_timer_type type, uint64_t imsi)
 {
   m_s1ap_logger.debug("Adding NAS timer to MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, timer_fd);
 
+  // A stale event of a removed timer may be reported for a new timer with the same fd. Its read must not block
+  fcntl(timer_fd, F_SETFL, fcntl(timer_fd, F_GETFL) | O_NONBLOCK);
+
   mme_timer_t timer;
   timer.fd   = timer_fd;
   timer.type = type;
   timer.imsi = imsi;
 
+  std::lock_guard<std::mutex> lock(m_timers_mutex);
+  struct epoll_event          ev = {};
+  ev.events                      = EPOLLIN;
+  ev.data.fd                     = timer_fd;
+  if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, timer_fd, &ev) < 0) {
+    m_s1ap_logger.error("Error adding timer to epoll: %s", strerror(errno));
+    return false;
+  }
   timers.push_back(timer);
   return true;
 }
 
 bool mme::is_nas_timer_running(nas_timer_type type, uint64_t imsi)
 {
+  std::lock_guard<std::mutex>        lock(m_timers_mutex);
   std::vector<mme_timer_t>::iterator it;
   for (it = timers.begin(); it != timers.end(); ++it) {
     if (it->type == type && it->imsi == imsi) {
@@ -217,6 +352,7 @@ bool mme::is_nas_timer_running(nas_timer_type type, uint64_t imsi)
 
 bool mme::remove_nas_timer(nas_timer_type type, uint64_t imsi)
 {
+  std::lock_guard<std::mutex>        lock(m_timers_mutex);
   std::vector<mme_timer_t>::iterator it;
   for (it = timers.begin(); it != timers.end(); ++it) {
     if (it->type == type && it->imsi == imsi) {
@@ -230,10 +366,40 @@ bool mme::remove_nas_timer(nas_timer_type type, uint64_t imsi)
 
   // removing timer
   m_s1ap_logger.debug("Removing NAS timer from MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, it->fd);
-  FD_CLR(it->fd, &m_set);
+  epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, it->fd, NULL);
   close(it->fd);
   timers.erase(it);
   return true;
 }
 
+void mme::handle_timer_expire(int timer_fd)
+{
+  mme_timer_t timer;
+  {
+    std::lock_guard<std::mutex>        lock(m_timers_mutex);
+    std::vector<mme_timer_t>::iterator it = timers.begin();
+    while (it != timers.end() && it->fd != timer_fd) {
+      ++it;
+    }
+    uint64_t exp;
+    if (it == timers.end() || read(it->fd, &exp, sizeof(uint64_t)) != sizeof(uint64_t)) {
+      // The timer was removed after its expiry was reported
+      return;
+    }
+    timer = *it;
+    epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, it->fd, NULL);
+    close(it->fd);
+    timers.erase(it);
+  }
+
+  m_s1ap_logger.info("Timer expired");
+  if (m_s1ap_workers.empty()) {
+    m_s1ap->expire_nas_timer(timer.type, timer.imsi);
+    return;
+  }
+  nas_timer_type type = timer.type;
+  uint64_t       imsi = timer.imsi;
+  push_s1ap_task(m_s1ap->get_ue_shard(imsi), [this, type, imsi]() { m_s1ap->expire_nas_timer(type, imsi); });
+}
+
 } // namespace srsepc
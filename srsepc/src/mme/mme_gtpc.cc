@@ -130,6 +130,17 @@ void mme_gtpc::handle_s11_pdu(srsran::byte_buffer_t* msg)
   return;
 }
 
+bool mme_gtpc::get_imsi_from_ctrl_teid(uint32_t mme_ctrl_teid, uint64_t* imsi)
+{
+  std::lock_guard<std::mutex>            lock(m_mutex);
+  std::map<uint32_t, uint64_t>::iterator it = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
+  if (it == m_mme_ctr_teid_to_imsi.end()) {
+    return false;
+  }
+  *imsi = it->second;
+  return true;
+}
+
 bool mme_gtpc::send_create_session_request(uint64_t imsi)
 {
   m_logger.info("Sending Create Session Request.");
@@ -149,6 +160,7 @@ bool mme_gtpc::send_create_session_request(uint64_t imsi)
   // Setup GTP-C Create Session Request IEs
   cs_req->imsi = imsi;
   // Control TEID allocated
+  std::unique_lock<std::mutex> lock(m_mutex);
   cs_req->sender_f_teid.teid = get_new_ctrl_teid();
 
   m_logger.info("Next MME control TEID: %d", m_next_ctrl_teid);
@@ -191,6 +203,8 @@ bool mme_gtpc::send_create_session_request(uint64_t imsi)
   gtpc_ctx.mme_ctr_fteid = cs_req->sender_f_teid;
   m_imsi_to_gtpc_ctx.insert(std::pair<uint64_t, gtpc_ctx_t>(imsi, gtpc_ctx));
 
+  lock.unlock();
+
   // Send msg to SPGW
   send_s11_pdu(cs_req_pdu);
   return true;
@@ -213,12 +227,11 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
   }
 
   // Get IMSI from the control TEID
-  std::map<uint32_t, uint64_t>::iterator id_it = m_mme_ctr_teid_to_imsi.find(cs_resp_pdu->header.teid);
-  if (id_it == m_mme_ctr_teid_to_imsi.end()) {
+  uint64_t imsi;
+  if (!get_imsi_from_ctrl_teid(cs_resp_pdu->header.teid, &imsi)) {
     m_logger.warning("Could not find IMSI from Ctrl TEID.");
     return false;
   }
-  uint64_t imsi = id_it->second;
 
   m_logger.info("MME GTPC Ctrl TEID %" PRIu64 ", IMSI %" PRIu64 "", cs_resp_pdu->header.teid, imsi);
 
@@ -263,14 +276,17 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
   srsran::console("SPGW Allocated IP %s to IMSI %015" PRIu64 "\n", inet_ntoa(emm_ctx->ue_ip), emm_ctx->imsi);
 
   // Save SGW ctrl F-TEID in GTP-C context
-  std::map<uint64_t, struct gtpc_ctx>::iterator it_g = m_imsi_to_gtpc_ctx.find(imsi);
-  if (it_g == m_imsi_to_gtpc_ctx.end()) {
-    // Could not find GTP-C Context
-    m_logger.error("Could not find GTP-C context");
-    return false;
+  {
+    std::lock_guard<std::mutex>                   lock(m_mutex);
+    std::map<uint64_t, struct gtpc_ctx>::iterator it_g = m_imsi_to_gtpc_ctx.find(imsi);
+    if (it_g == m_imsi_to_gtpc_ctx.end()) {
+      // Could not find GTP-C Context
+      m_logger.error("Could not find GTP-C context");
+      return false;
+    }
+    gtpc_ctx_t* gtpc_ctx    = &it_g->second;
+    gtpc_ctx->sgw_ctr_fteid = sgw_ctr_fteid;
   }
-  gtpc_ctx_t* gtpc_ctx    = &it_g->second;
-  gtpc_ctx->sgw_ctr_fteid = sgw_ctr_fteid;
 
   // Set EPS bearer context
   // TODO default EPS bearer is hard-coded
@@ -288,6 +304,7 @@ bool mme_gtpc::send_modify_bearer_request(uint64_t imsi, uint16_t erab_to_modify
   srsran::gtpc_pdu mb_req_pdu;
   std::memset(&mb_req_pdu, 0, sizeof(mb_req_pdu));
 
+  std::unique_lock<std::mutex>             lock(m_mutex);
   std::map<uint64_t, gtpc_ctx_t>::iterator it = m_imsi_to_gtpc_ctx.find(imsi);
   if (it == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("Modify bearer request for UE without GTP-C connection");
@@ -310,6 +327,8 @@ bool mme_gtpc::send_modify_bearer_request(uint64_t imsi, uint16_t erab_to_modify
   addr.s_addr = enb_fteid->ipv4;
   m_logger.info("GTP-C Modify bearer request -- S1-U TEID 0x%x, IP %s", enb_fteid->teid, inet_ntoa(addr));
 
+  lock.unlock();
+
   // Send msg to SPGW
   send_s11_pdu(mb_req_pdu);
   return true;
@@ -317,16 +336,16 @@ bool mme_gtpc::send_modify_bearer_request(uint64_t imsi, uint16_t erab_to_modify
 
 void mme_gtpc::handle_modify_bearer_response(srsran::gtpc_pdu* mb_resp_pdu)
 {
-  uint32_t                               mme_ctrl_teid = mb_resp_pdu->header.teid;
-  std::map<uint32_t, uint64_t>::iterator imsi_it       = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
-  if (imsi_it == m_mme_ctr_teid_to_imsi.end()) {
+  uint32_t mme_ctrl_teid = mb_resp_pdu->header.teid;
+  uint64_t imsi;
+  if (!get_imsi_from_ctrl_teid(mme_ctrl_teid, &imsi)) {
     m_logger.error("Could not find IMSI from control TEID");
     return;
   }
 
   uint8_t ebi = mb_resp_pdu->choice.modify_bearer_response.eps_bearer_context_modified.ebi;
   m_logger.debug("Activating EPS bearer with id %d", ebi);
-  m_s1ap->activate_eps_bearer(imsi_it->second, ebi);
+  m_s1ap->activate_eps_bearer(imsi, ebi);
 
   return;
 }
@@ -340,6 +359,7 @@ bool mme_gtpc::send_delete_session_request(uint64_t imsi)
   srsran::gtp_fteid_t mme_ctr_fteid;
 
   // Get S-GW Ctr TEID
+  std::unique_lock<std::mutex>             lock(m_mutex);
   std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("Could not find GTP-C context to remove");
@@ -357,9 +377,6 @@ bool mme_gtpc::send_delete_session_request(uint64_t imsi)
   del_req->cause.cause_value                   = srsran::GTPC_CAUSE_VALUE_ISR_DEACTIVATION;
   m_logger.info("GTP-C Delete Session Request -- S-GW Control TEID %d", sgw_ctr_fteid.teid);
 
-  // Send msg to SPGW
-  send_s11_pdu(del_req_pdu);
-
   // Delete GTP-C context
   std::map<uint32_t, uint64_t>::iterator it_imsi = m_mme_ctr_teid_to_imsi.find(mme_ctr_fteid.teid);
   if (it_imsi == m_mme_ctr_teid_to_imsi.end()) {
@@ -368,6 +385,10 @@ bool mme_gtpc::send_delete_session_request(uint64_t imsi)
     m_mme_ctr_teid_to_imsi.erase(it_imsi);
   }
   m_imsi_to_gtpc_ctx.erase(it_ctx);
+  lock.unlock();
+
+  // Send msg to SPGW
+  send_s11_pdu(del_req_pdu);
   return true;
 }
 
@@ -380,6 +401,7 @@ void mme_gtpc::send_release_access_bearers_request(uint64_t imsi)
   srsran::gtp_fteid_t sgw_ctr_fteid;
 
   // Get S-GW Ctr TEID
+  std::unique_lock<std::mutex>             lock(m_mutex);
   std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("Could not find GTP-C context to remove");
@@ -396,6 +418,8 @@ void mme_gtpc::send_release_access_bearers_request(uint64_t imsi)
   srsran::gtpc_release_access_bearers_request* rel_req = &rel_req_pdu.choice.release_access_bearers_request;
   m_logger.info("GTP-C Release Access Berarers Request -- S-GW Control TEID %d", sgw_ctr_fteid.teid);
 
+  lock.unlock();
+
   // Send msg to SPGW
   send_s11_pdu(rel_req_pdu);
 
@@ -406,8 +430,8 @@ bool mme_gtpc::handle_downlink_data_notification(srsran::gtpc_pdu* dl_not_pdu)
 {
   uint32_t                                 mme_ctrl_teid = dl_not_pdu->header.teid;
   srsran::gtpc_downlink_data_notification* dl_not        = &dl_not_pdu->choice.downlink_data_notification;
-  std::map<uint32_t, uint64_t>::iterator   imsi_it       = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
-  if (imsi_it == m_mme_ctr_teid_to_imsi.end()) {
+  uint64_t                                 imsi;
+  if (!get_imsi_from_ctrl_teid(mme_ctrl_teid, &imsi)) {
     m_logger.error("Could not find IMSI from control TEID");
     return false;
   }
@@ -417,9 +441,9 @@ bool mme_gtpc::handle_downlink_data_notification(srsran::gtpc_pdu* dl_not_pdu)
     return false;
   }
   uint8_t ebi = dl_not->eps_bearer_id;
-  m_logger.debug("Downlink Data Notification -- IMSI: %015" PRIu64 ", EBI %d", imsi_it->second, ebi);
+  m_logger.debug("Downlink Data Notification -- IMSI: %015" PRIu64 ", EBI %d", imsi, ebi);
 
-  m_s1ap->send_paging(imsi_it->second, ebi);
+  m_s1ap->send_paging(imsi, ebi);
   return true;
 }
 
@@ -431,6 +455,7 @@ void mme_gtpc::send_downlink_data_notification_acknowledge(uint64_t imsi, enum s
   std::memset(&not_ack_pdu, 0, sizeof(not_ack_pdu));
 
   // get s-gw ctr teid
+  std::unique_lock<std::mutex>             lock(m_mutex);
   std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("could not find gtp-c context to remove");
@@ -448,6 +473,8 @@ void mme_gtpc::send_downlink_data_notification_acknowledge(uint64_t imsi, enum s
       &not_ack_pdu.choice.downlink_data_notification_acknowledge;
   m_logger.info("gtp-c downlink data notification acknowledge -- s-gw control teid %d", sgw_ctr_fteid.teid);
 
+  lock.unlock();
+
   // send msg to spgw
   send_s11_pdu(not_ack_pdu);
   return;
@@ -461,6 +488,7 @@ bool mme_gtpc::send_downlink_data_notification_failure_indication(uint64_t imsi,
   std::memset(&not_fail_pdu, 0, sizeof(not_fail_pdu));
 
   // get s-gw ctr teid
+  std::unique_lock<std::mutex>             lock(m_mutex);
   std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("could not find gtp-c context to send paging failure");
@@ -479,6 +507,8 @@ bool mme_gtpc::send_downlink_data_notification_failure_indication(uint64_t imsi,
   not_fail->cause.cause_value = cause;
   m_logger.info("Downlink Data Notification Failure Indication -- SP-GW control teid %d", sgw_ctr_fteid.teid);
 
+  lock.unlock();
+
   // send msg to spgw
   send_s11_pdu(not_fail_pdu);
   return true;
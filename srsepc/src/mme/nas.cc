@@ -21,6 +21,7 @@
 
 #include "srsepc/hdr/mme/s1ap.h"
 #include "srsepc/hdr/mme/s1ap_nas_transport.h"
+#include "srsran/asn1/liblte_byte_buffer.h"
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/security.h"
 #include <cmath>
@@ -91,7 +92,7 @@ bool nas::handle_attach_request(uint32_t                enb_ue_s1ap_id,
   gtpc_interface_nas* gtpc = itf.gtpc;
 
   // Get NAS Attach Request and PDN connectivity request messages
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_attach_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &attach_req);
+  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_attach_request_msg(srsran::liblte_byte_msg_adapter(nas_rx), &attach_req);
   if (err != LIBLTE_SUCCESS) {
     nas_logger.error("Error unpacking NAS attach request. Error: %s", liblte_error_text[err]);
     return false;
@@ -594,7 +595,7 @@ bool nas::handle_service_request(uint32_t                m_tmsi,
   gtpc_interface_nas* gtpc = itf.gtpc;
   mme_interface_nas*  mme  = itf.mme;
 
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_service_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &service_req);
+  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_service_request_msg(srsran::liblte_byte_msg_adapter(nas_rx), &service_req);
   if (err != LIBLTE_SUCCESS) {
     nas_logger.error("Could not unpack service request");
     return false;
@@ -751,7 +752,7 @@ bool nas::handle_detach_request(uint32_t                m_tmsi,
   hss_interface_nas*  hss  = itf.hss;
   gtpc_interface_nas* gtpc = itf.gtpc;
 
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_detach_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &detach_req);
+  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_detach_request_msg(srsran::liblte_byte_msg_adapter(nas_rx), &detach_req);
   if (err != LIBLTE_SUCCESS) {
     nas_logger.error("Could not unpack detach request");
     return false;
@@ -788,7 +789,7 @@ bool nas::handle_detach_request(uint32_t                m_tmsi,
     err                                               = liblte_mme_pack_detach_accept_msg(&detach_accept,
                                             LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS,
                                             sec_ctx->dl_nas_count,
-                                            (LIBLTE_BYTE_MSG_STRUCT*)nas_tx.get());
+                                            srsran::liblte_byte_msg_adapter(nas_tx.get()));
     if (err != LIBLTE_SUCCESS) {
       nas_logger.error("Error packing Detach Accept\n");
     }
@@ -870,7 +871,7 @@ bool nas::handle_attach_request(srsran::byte_buffer_t* nas_rx)
   LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT pdn_con_req = {};
 
   // Get NAS Attach Request and PDN connectivity request messages
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_attach_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &attach_req);
+  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_attach_request_msg(srsran::liblte_byte_msg_adapter(nas_rx), &attach_req);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS attach request. Error: %s", liblte_error_text[err]);
     return false;
@@ -980,7 +981,8 @@ bool nas::handle_authentication_response(srsran::byte_buffer_t* nas_rx)
   bool                                          ue_valid  = true;
 
   // Get NAS authentication response
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_authentication_response_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &auth_resp);
+  LIBLTE_ERROR_ENUM err =
+      liblte_mme_unpack_authentication_response_msg(srsran::liblte_byte_msg_adapter(nas_rx), &auth_resp);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS authentication response. Error: %s", liblte_error_text[err]);
     return false;
@@ -1034,7 +1036,8 @@ bool nas::handle_security_mode_complete(srsran::byte_buffer_t* nas_rx)
   LIBLTE_MME_SECURITY_MODE_COMPLETE_MSG_STRUCT sm_comp = {};
 
   // Get NAS security mode complete
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_security_mode_complete_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &sm_comp);
+  LIBLTE_ERROR_ENUM err =
+      liblte_mme_unpack_security_mode_complete_msg(srsran::liblte_byte_msg_adapter(nas_rx), &sm_comp);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS authentication response. Error: %s", liblte_error_text[err]);
     return false;
@@ -1079,7 +1082,7 @@ bool nas::handle_attach_complete(srsran::byte_buffer_t* nas_rx)
 
   // Get NAS authentication response
   std::memset(&attach_comp, 0, sizeof(attach_comp));
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_attach_complete_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &attach_comp);
+  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_attach_complete_msg(srsran::liblte_byte_msg_adapter(nas_rx), &attach_comp);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS authentication response. Error: %s", liblte_error_text[err]);
     return false;
@@ -1128,7 +1131,7 @@ bool nas::handle_esm_information_response(srsran::byte_buffer_t* nas_rx)
 
   // Get NAS authentication response
   LIBLTE_ERROR_ENUM err =
-      srsran_mme_unpack_esm_information_response_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &esm_info_resp);
+      srsran_mme_unpack_esm_information_response_msg(srsran::liblte_byte_msg_adapter(nas_rx), &esm_info_resp);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS authentication response. Error: %s", liblte_error_text[err]);
     return false;
@@ -1161,7 +1164,7 @@ bool nas::handle_identity_response(srsran::byte_buffer_t* nas_rx)
   srsran::unique_byte_buffer_t      nas_tx;
   LIBLTE_MME_ID_RESPONSE_MSG_STRUCT id_resp;
 
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_identity_response_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &id_resp);
+  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_identity_response_msg(srsran::liblte_byte_msg_adapter(nas_rx), &id_resp);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS identity response. Error: %s", liblte_error_text[err]);
     return false;
@@ -1245,7 +1248,7 @@ bool nas::handle_authentication_failure(srsran::byte_buffer_t* nas_rx)
   LIBLTE_MME_AUTHENTICATION_FAILURE_MSG_STRUCT auth_fail;
   LIBLTE_ERROR_ENUM                            err;
 
-  err = liblte_mme_unpack_authentication_failure_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &auth_fail);
+  err = liblte_mme_unpack_authentication_failure_msg(srsran::liblte_byte_msg_adapter(nas_rx), &auth_fail);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error unpacking NAS authentication failure. Error: %s", liblte_error_text[err]);
     return false;
@@ -1309,7 +1312,7 @@ bool nas::handle_detach_request(srsran::byte_buffer_t* nas_msg)
   m_logger.info("Detach request -- IMSI %015" PRIu64 "", m_emm_ctx.imsi);
   LIBLTE_MME_DETACH_REQUEST_MSG_STRUCT detach_req;
 
-  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_detach_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_msg, &detach_req);
+  LIBLTE_ERROR_ENUM err = liblte_mme_unpack_detach_request_msg(srsran::liblte_byte_msg_adapter(nas_msg), &detach_req);
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Could not unpack detach request");
     return false;
@@ -1341,7 +1344,8 @@ bool nas::pack_authentication_request(srsran::byte_buffer_t* nas_buffer)
   auth_req.nas_ksi.tsc_flag = LIBLTE_MME_TYPE_OF_SECURITY_CONTEXT_FLAG_NATIVE;
   auth_req.nas_ksi.nas_ksi  = m_sec_ctx.eksi;
 
-  LIBLTE_ERROR_ENUM err = liblte_mme_pack_authentication_request_msg(&auth_req, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+  LIBLTE_ERROR_ENUM err =
+      liblte_mme_pack_authentication_request_msg(&auth_req, srsran::liblte_byte_msg_adapter(nas_buffer));
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error packing Authentication Request");
     srsran::console("Error packing Authentication Request\n");
@@ -1355,7 +1359,8 @@ bool nas::pack_authentication_reject(srsran::byte_buffer_t* nas_buffer)
   m_logger.info("Packing Authentication Reject");
 
   LIBLTE_MME_AUTHENTICATION_REJECT_MSG_STRUCT auth_rej;
-  LIBLTE_ERROR_ENUM err = liblte_mme_pack_authentication_reject_msg(&auth_rej, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+  LIBLTE_ERROR_ENUM err =
+      liblte_mme_pack_authentication_reject_msg(&auth_rej, srsran::liblte_byte_msg_adapter(nas_buffer));
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error packing Authentication Reject");
     srsran::console("Error packing Authentication Reject\n");
@@ -1400,7 +1405,7 @@ bool nas::pack_security_mode_command(srsran::byte_buffer_t* nas_buffer)
 
   uint8_t           sec_hdr_type = 3;
   LIBLTE_ERROR_ENUM err          = liblte_mme_pack_security_mode_command_msg(
-      &sm_cmd, sec_hdr_type, m_sec_ctx.dl_nas_count, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+      &sm_cmd, sec_hdr_type, m_sec_ctx.dl_nas_count, srsran::liblte_byte_msg_adapter(nas_buffer));
   if (err != LIBLTE_SUCCESS) {
     srsran::console("Error packing Authentication Request\n");
     return false;
@@ -1438,7 +1443,7 @@ bool nas::pack_esm_information_request(srsran::byte_buffer_t* nas_buffer)
 
   m_sec_ctx.dl_nas_count++;
   LIBLTE_ERROR_ENUM err = srsran_mme_pack_esm_information_request_msg(
-      &esm_info_req, sec_hdr_type, m_sec_ctx.dl_nas_count, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+      &esm_info_req, sec_hdr_type, m_sec_ctx.dl_nas_count, srsran::liblte_byte_msg_adapter(nas_buffer));
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error packing ESM information request");
     srsran::console("Error packing ESM information request\n");
@@ -1574,7 +1579,7 @@ bool nas::pack_attach_accept(srsran::byte_buffer_t* nas_buffer)
   liblte_mme_pack_activate_default_eps_bearer_context_request_msg(&act_def_eps_bearer_context_req,
                                                                   &attach_accept.esm_msg);
   liblte_mme_pack_attach_accept_msg(
-      &attach_accept, sec_hdr_type, m_sec_ctx.dl_nas_count, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+      &attach_accept, sec_hdr_type, m_sec_ctx.dl_nas_count, srsran::liblte_byte_msg_adapter(nas_buffer));
 
   // Encrypt NAS message
   cipher_encrypt(nas_buffer);
@@ -1595,7 +1600,7 @@ bool nas::pack_identity_request(srsran::byte_buffer_t* nas_buffer)
 
   LIBLTE_MME_ID_REQUEST_MSG_STRUCT id_req;
   id_req.id_type        = LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI;
-  LIBLTE_ERROR_ENUM err = liblte_mme_pack_identity_request_msg(&id_req, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+  LIBLTE_ERROR_ENUM err = liblte_mme_pack_identity_request_msg(&id_req, srsran::liblte_byte_msg_adapter(nas_buffer));
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error packing Identity Request");
     srsran::console("Error packing Identity Request\n");
@@ -1638,7 +1643,7 @@ bool nas::pack_emm_information(srsran::byte_buffer_t* nas_buffer)
   uint8_t sec_hdr_type = LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED;
   m_sec_ctx.dl_nas_count++;
   LIBLTE_ERROR_ENUM err = liblte_mme_pack_emm_information_msg(
-      &emm_info, sec_hdr_type, m_sec_ctx.dl_nas_count, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+      &emm_info, sec_hdr_type, m_sec_ctx.dl_nas_count, srsran::liblte_byte_msg_adapter(nas_buffer));
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error packing EMM Information");
     srsran::console("Error packing EMM Information\n");
@@ -1668,7 +1673,7 @@ bool nas::pack_service_reject(srsran::byte_buffer_t* nas_buffer, uint8_t emm_cau
   service_rej.emm_cause     = emm_cause;
 
   LIBLTE_ERROR_ENUM err = liblte_mme_pack_service_reject_msg(
-      &service_rej, LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS, 0, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+      &service_rej, LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS, 0, srsran::liblte_byte_msg_adapter(nas_buffer));
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error packing Service Reject");
     srsran::console("Error packing Service Reject\n");
@@ -1690,7 +1695,7 @@ bool nas::pack_tracking_area_update_reject(srsran::byte_buffer_t* nas_buffer, ui
   }
 
   LIBLTE_ERROR_ENUM err = liblte_mme_pack_tracking_area_update_reject_msg(
-      &tau_rej, LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS, 0, (LIBLTE_BYTE_MSG_STRUCT*)nas_buffer);
+      &tau_rej, LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS, 0, srsran::liblte_byte_msg_adapter(nas_buffer));
   if (err != LIBLTE_SUCCESS) {
     m_logger.error("Error packing Tracking Area Update Reject");
     srsran::console("Error packing Tracking Area Update Reject\n");
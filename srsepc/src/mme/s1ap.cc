@@ -21,7 +21,9 @@
 
 #include "srsepc/hdr/mme/s1ap.h"
 #include "srsran/asn1/gtpc.h"
+#include "srsran/asn1/liblte_byte_buffer.h"
 #include "srsran/common/bcd_helpers.h"
+#include "srsran/common/int_helpers.h"
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/network_utils.h"
 #include <cmath>
@@ -33,7 +35,10 @@ namespace srsepc {
 s1ap*           s1ap::m_instance    = NULL;
 pthread_mutex_t s1ap_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-s1ap::s1ap() : m_s1mme(-1), m_next_mme_ue_s1ap_id(1), m_mme_gtpc(NULL) {}
+// UE shard served by the calling thread
+static thread_local uint32_t current_ue_shard = 0;
+
+s1ap::s1ap() : m_s1mme(-1), m_mme_gtpc(NULL) {}
 
 s1ap::~s1ap()
 {
@@ -70,6 +75,15 @@ int s1ap::init(const s1ap_args_t& s1ap_args)
   std::uniform_int_distribution<uint32_t> distr(0, std::numeric_limits<uint32_t>::max());
   m_next_m_tmsi = distr(generator);
 
+  // Create the UE shards. MME-UE-S1AP-ID 0 is not valid, so shard 0 starts with the next ID congruent to 0
+  uint32_t nof_ue_shards = std::max(s1ap_args.nof_workers, 1U);
+  m_ue_shards.clear();
+  for (uint32_t i = 0; i < nof_ue_shards; ++i) {
+    std::unique_ptr<ue_shard_t> shard(new ue_shard_t);
+    shard->next_mme_ue_s1ap_id = (i == 0) ? nof_ue_shards : i;
+    m_ue_shards.push_back(std::move(shard));
+  }
+
   // Get pointer to the HSS
   m_hss = hss::get_instance();
 
@@ -143,7 +157,23 @@ int s1ap::get_s1_mme()
 
 uint32_t s1ap::get_next_mme_ue_s1ap_id()
 {
-  return m_next_mme_ue_s1ap_id++;
+  // The ID is allocated from the shard of the calling worker, so that the following procedures of the UE are handled by
+  // the same worker
+  ue_shard_t&                 shard = *m_ue_shards[current_ue_shard];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  uint32_t                    id = shard.next_mme_ue_s1ap_id;
+  shard.next_mme_ue_s1ap_id += m_ue_shards.size();
+  return id;
+}
+
+void s1ap::set_current_ue_shard(uint32_t shard_idx)
+{
+  current_ue_shard = shard_idx;
+}
+
+uint32_t s1ap::get_current_ue_shard()
+{
+  return current_ue_shard;
 }
 
 int s1ap::enb_listen()
@@ -223,6 +253,7 @@ bool s1ap::s1ap_tx_pdu(const asn1::s1ap::s1ap_pdu_c& pdu, struct sctp_sndrcvinfo
   }
 
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(buf->msg, buf->N_bytes);
   }
 
@@ -230,20 +261,32 @@ bool s1ap::s1ap_tx_pdu(const asn1::s1ap::s1ap_pdu_c& pdu, struct sctp_sndrcvinfo
 }
 
 void s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri)
+{
+  s1ap_pdu_t rx_pdu;
+  if (unpack_s1ap_rx_pdu(pdu, &rx_pdu)) {
+    handle_s1ap_pdu(rx_pdu, enb_sri);
+  }
+}
+
+bool s1ap::unpack_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, s1ap_pdu_t* rx_pdu)
 {
   // Save PCAP
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(pdu->msg, pdu->N_bytes);
   }
 
-  // Get PDU type
-  s1ap_pdu_t     rx_pdu;
   asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  if (rx_pdu->unpack(bref) != asn1::SRSASN_SUCCESS) {
     m_logger.error("Failed to unpack received PDU");
-    return;
+    return false;
   }
+  return true;
+}
 
+void s1ap::handle_s1ap_pdu(const s1ap_pdu_t& rx_pdu, struct sctp_sndrcvinfo* enb_sri)
+{
+  // Get PDU type
   switch (rx_pdu.type().value) {
     case s1ap_pdu_t::types_opts::init_msg:
       m_logger.info("Received Initiating PDU");
@@ -310,13 +353,108 @@ void s1ap::handle_successful_outcome(const asn1::s1ap::successful_outcome_s& msg
   }
 }
 
+// UE shards
+int s1ap::get_s1ap_pdu_ue_shard(const s1ap_pdu_t& rx_pdu, const struct sctp_sndrcvinfo& enb_sri)
+{
+  using init_msg_type_opts_t           = asn1::s1ap::s1ap_elem_procs_o::init_msg_c::types_opts;
+  using successful_outcome_type_opts_t = asn1::s1ap::s1ap_elem_procs_o::successful_outcome_c::types_opts;
+
+  uint32_t mme_ue_s1ap_id = 0;
+  if (rx_pdu.type().value == s1ap_pdu_t::types_opts::init_msg) {
+    const asn1::s1ap::init_msg_s& msg = rx_pdu.init_msg();
+    switch (msg.value.type().value) {
+      case init_msg_type_opts_t::init_ue_msg:
+        return get_initial_ue_message_shard(msg.value.init_ue_msg(), enb_sri);
+      case init_msg_type_opts_t::ul_nas_transport:
+        mme_ue_s1ap_id = msg.value.ul_nas_transport().protocol_ies.mme_ue_s1ap_id.value.value;
+        break;
+      case init_msg_type_opts_t::ue_context_release_request:
+        mme_ue_s1ap_id = msg.value.ue_context_release_request().protocol_ies.mme_ue_s1ap_id.value.value;
+        break;
+      case init_msg_type_opts_t::ue_cap_info_ind:
+        mme_ue_s1ap_id = msg.value.ue_cap_info_ind().protocol_ies.mme_ue_s1ap_id.value.value;
+        break;
+      default:
+        return -1;
+    }
+  } else if (rx_pdu.type().value == s1ap_pdu_t::types_opts::successful_outcome) {
+    const asn1::s1ap::successful_outcome_s& msg = rx_pdu.successful_outcome();
+    switch (msg.value.type().value) {
+      case successful_outcome_type_opts_t::init_context_setup_resp:
+        mme_ue_s1ap_id = msg.value.init_context_setup_resp().protocol_ies.mme_ue_s1ap_id.value.value;
+        break;
+      case successful_outcome_type_opts_t::ue_context_release_complete:
+        mme_ue_s1ap_id = msg.value.ue_context_release_complete().protocol_ies.mme_ue_s1ap_id.value.value;
+        break;
+      default:
+        return -1;
+    }
+  } else {
+    return -1;
+  }
+  return mme_ue_s1ap_id % m_ue_shards.size();
+}
+
+int s1ap::get_initial_ue_message_shard(const asn1::s1ap::init_ue_msg_s& init_ue, const struct sctp_sndrcvinfo& enb_sri)
+{
+  // A known UE stays in the shard of its context. It is identified by the S-TMSI or by the EPS mobile identity of the
+  // attach request
+  uint64_t imsi = 0;
+  if (init_ue.protocol_ies.s_tmsi_present) {
+    uint32_t m_tmsi = 0;
+    srsran::uint8_to_uint32(init_ue.protocol_ies.s_tmsi.value.m_tmsi.data(), &m_tmsi);
+    imsi = find_imsi_from_m_tmsi(m_tmsi);
+  }
+  if (imsi == 0) {
+    srsran::unique_byte_buffer_t nas_msg = srsran::make_byte_buffer();
+    if (nas_msg == nullptr) {
+      m_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+      return 0;
+    }
+    memcpy(nas_msg->msg, init_ue.protocol_ies.nas_pdu.value.data(), init_ue.protocol_ies.nas_pdu.value.size());
+    nas_msg->N_bytes = init_ue.protocol_ies.nas_pdu.value.size();
+
+    uint8_t pd, msg_type;
+    liblte_mme_parse_msg_header(srsran::liblte_byte_msg_adapter(nas_msg.get()), &pd, &msg_type);
+    LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT attach_req = {};
+    if (msg_type == LIBLTE_MME_MSG_TYPE_ATTACH_REQUEST &&
+        liblte_mme_unpack_attach_request_msg(srsran::liblte_byte_msg_adapter(nas_msg.get()), &attach_req) ==
+            LIBLTE_SUCCESS) {
+      if (attach_req.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI) {
+        for (int i = 0; i <= 14; i++) {
+          imsi = imsi * 10 + attach_req.eps_mobile_id.imsi[i];
+        }
+      } else if (attach_req.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI) {
+        imsi = find_imsi_from_m_tmsi(attach_req.eps_mobile_id.guti.m_tmsi);
+      }
+    }
+  }
+  if (imsi != 0) {
+    return get_ue_shard(imsi);
+  }
+
+  // Unknown UE, its context is created in any shard
+  return (enb_sri.sinfo_assoc_id + init_ue.protocol_ies.enb_ue_s1ap_id.value.value) % m_ue_shards.size();
+}
+
+uint32_t s1ap::get_ue_shard(uint64_t imsi)
+{
+  std::lock_guard<std::mutex>                  lock(m_ctx_mutex);
+  std::map<uint64_t, uint32_t>::const_iterator it = m_imsi_to_ue_shard.find(imsi);
+  if (it != m_imsi_to_ue_shard.end()) {
+    return it->second;
+  }
+  return imsi % m_ue_shards.size();
+}
+
 // eNB Context Managment
 void s1ap::add_new_enb_ctx(const enb_ctx_t& enb_ctx, const struct sctp_sndrcvinfo* enb_sri)
 {
   m_logger.info("Adding new eNB context. eNB ID %d", enb_ctx.enb_id);
-  std::set<uint32_t> ue_set;
-  enb_ctx_t*         enb_ptr = new enb_ctx_t;
-  *enb_ptr                   = enb_ctx;
+  std::set<uint32_t>          ue_set;
+  enb_ctx_t*                  enb_ptr = new enb_ctx_t;
+  *enb_ptr                            = enb_ctx;
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
   m_active_enbs.insert(std::pair<uint16_t, enb_ctx_t*>(enb_ptr->enb_id, enb_ptr));
   m_sctp_to_enb_id.insert(std::pair<int32_t, uint16_t>(enb_sri->sinfo_assoc_id, enb_ptr->enb_id));
   m_enb_assoc_to_ue_ids.insert(std::pair<int32_t, std::set<uint32_t> >(enb_sri->sinfo_assoc_id, ue_set));
@@ -324,6 +462,7 @@ void s1ap::add_new_enb_ctx(const enb_ctx_t& enb_ctx, const struct sctp_sndrcvinf
 
 enb_ctx_t* s1ap::find_enb_ctx(uint16_t enb_id)
 {
+  std::lock_guard<std::mutex>              lock(m_ctx_mutex);
   std::map<uint16_t, enb_ctx_t*>::iterator it = m_active_enbs.find(enb_id);
   if (it == m_active_enbs.end()) {
     return nullptr;
@@ -334,13 +473,15 @@ enb_ctx_t* s1ap::find_enb_ctx(uint16_t enb_id)
 
 void s1ap::delete_enb_ctx(int32_t assoc_id)
 {
-  std::map<int32_t, uint16_t>::iterator it_assoc = m_sctp_to_enb_id.find(assoc_id);
-  uint16_t                              enb_id   = it_assoc->second;
-
-  std::map<uint16_t, enb_ctx_t*>::iterator it_ctx = m_active_enbs.find(enb_id);
-  if (it_ctx == m_active_enbs.end() || it_assoc == m_sctp_to_enb_id.end()) {
-    m_logger.error("Could not find eNB to delete. Association: %d", assoc_id);
-    return;
+  uint16_t enb_id;
+  {
+    std::lock_guard<std::mutex>           lock(m_ctx_mutex);
+    std::map<int32_t, uint16_t>::iterator it_assoc = m_sctp_to_enb_id.find(assoc_id);
+    if (it_assoc == m_sctp_to_enb_id.end() || m_active_enbs.count(it_assoc->second) == 0) {
+      m_logger.error("Could not find eNB to delete. Association: %d", assoc_id);
+      return;
+    }
+    enb_id = it_assoc->second;
   }
 
   m_logger.info("Deleting eNB context. eNB Id: 0x%x", enb_id);
@@ -350,28 +491,36 @@ void s1ap::delete_enb_ctx(int32_t assoc_id)
   release_ues_ecm_ctx_in_enb(assoc_id);
 
   // Delete eNB
+  std::lock_guard<std::mutex>              lock(m_ctx_mutex);
+  std::map<uint16_t, enb_ctx_t*>::iterator it_ctx = m_active_enbs.find(enb_id);
   delete it_ctx->second;
   m_active_enbs.erase(it_ctx);
-  m_sctp_to_enb_id.erase(it_assoc);
+  m_sctp_to_enb_id.erase(assoc_id);
   return;
 }
 
 // UE Context Management
 bool s1ap::add_nas_ctx_to_imsi_map(nas* nas_ctx)
 {
+  std::lock_guard<std::mutex>        lock(m_ctx_mutex);
   std::map<uint64_t, nas*>::iterator ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
   if (ctx_it != m_imsi_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
-    if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
+    ue_shard_t&                        shard = get_ue_shard_from_mme_ue_s1ap_id(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    std::lock_guard<std::mutex>        shard_lock(shard.mutex);
+    std::map<uint32_t, nas*>::iterator ctx_it2 =
+        shard.mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    if (ctx_it2 != shard.mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with IMSI does not match context identified by MME UE S1AP Id.");
       return false;
     }
   }
   m_imsi_to_nas_ctx.insert(std::pair<uint64_t, nas*>(nas_ctx->m_emm_ctx.imsi, nas_ctx));
+  // The UE stays in the shard of the worker that created its context
+  m_imsi_to_ue_shard[nas_ctx->m_emm_ctx.imsi] = current_ue_shard;
   m_logger.debug("Saved UE context corresponding to IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
   return true;
 }
@@ -382,25 +531,29 @@ bool s1ap::add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)
     m_logger.error("Could not add UE context to MME UE S1AP map. MME UE S1AP ID 0 is not valid.");
     return false;
   }
-  std::map<uint32_t, nas*>::iterator ctx_it = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
-  if (ctx_it != m_mme_ue_s1ap_id_to_nas_ctx.end()) {
+  ue_shard_t&                        shard = get_ue_shard_from_mme_ue_s1ap_id(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+  std::lock_guard<std::mutex>        lock(shard.mutex);
+  std::map<uint32_t, nas*>::iterator ctx_it = shard.mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+  if (ctx_it != shard.mme_ue_s1ap_id_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. MME UE S1AP Id %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_emm_ctx.imsi != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
-    if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
+    std::map<uint32_t, nas*>::iterator ctx_it2 =
+        shard.mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    if (ctx_it2 != shard.mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with MME UE S1AP Id does not match context identified by IMSI.");
       return false;
     }
   }
-  m_mme_ue_s1ap_id_to_nas_ctx.insert(std::pair<uint32_t, nas*>(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id, nas_ctx));
+  shard.mme_ue_s1ap_id_to_nas_ctx.insert(std::pair<uint32_t, nas*>(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id, nas_ctx));
   m_logger.debug("Saved UE context corresponding to MME UE S1AP Id %d", nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
   return true;
 }
 
 bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 {
+  std::lock_guard<std::mutex>                      lock(m_ctx_mutex);
   std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
   if (ues_in_enb == m_enb_assoc_to_ue_ids.end()) {
     m_logger.error("Could not find eNB from eNB SCTP association %d", enb_assoc);
@@ -418,8 +571,10 @@ bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 
 nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 {
-  std::map<uint32_t, nas*>::iterator it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
-  if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
+  ue_shard_t&                        shard = get_ue_shard_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
+  std::lock_guard<std::mutex>        lock(shard.mutex);
+  std::map<uint32_t, nas*>::iterator it = shard.mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
+  if (it == shard.mme_ue_s1ap_id_to_nas_ctx.end()) {
     return NULL;
   } else {
     return it->second;
@@ -427,6 +582,12 @@ nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 }
 
 nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
+{
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  return find_nas_ctx_from_imsi_unsafe(imsi);
+}
+
+nas* s1ap::find_nas_ctx_from_imsi_unsafe(uint64_t imsi)
 {
   std::map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
   if (it == m_imsi_to_nas_ctx.end()) {
@@ -439,15 +600,21 @@ nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
 void s1ap::release_ues_ecm_ctx_in_enb(int32_t enb_assoc)
 {
   srsran::console("Releasing UEs context\n");
+  std::lock_guard<std::mutex>                      lock(m_ctx_mutex);
   std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
   std::set<uint32_t>::iterator                     ue_id      = ues_in_enb->second.begin();
   if (ue_id == ues_in_enb->second.end()) {
     srsran::console("No UEs to be released\n");
   } else {
     while (ue_id != ues_in_enb->second.end()) {
-      std::map<uint32_t, nas*>::iterator nas_ctx = m_mme_ue_s1ap_id_to_nas_ctx.find(*ue_id);
-      emm_ctx_t*                         emm_ctx = &nas_ctx->second->m_emm_ctx;
-      ecm_ctx_t*                         ecm_ctx = &nas_ctx->second->m_ecm_ctx;
+      ue_shard_t& shard = get_ue_shard_from_mme_ue_s1ap_id(*ue_id);
+      nas*        nas_ctx;
+      {
+        std::lock_guard<std::mutex> shard_lock(shard.mutex);
+        nas_ctx = shard.mme_ue_s1ap_id_to_nas_ctx.find(*ue_id)->second;
+      }
+      emm_ctx_t* emm_ctx = &nas_ctx->m_emm_ctx;
+      ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
 
       m_logger.info(
           "Releasing UE context. IMSI: %015" PRIu64 ", UE-MME S1AP Id: %d", emm_ctx->imsi, ecm_ctx->mme_ue_s1ap_id);
@@ -474,21 +641,28 @@ bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
   ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
 
   // Delete UE within eNB UE set
-  std::map<int32_t, uint16_t>::iterator it = m_sctp_to_enb_id.find(ecm_ctx->enb_sri.sinfo_assoc_id);
-  if (it == m_sctp_to_enb_id.end()) {
-    m_logger.error("Could not find eNB for UE release request.");
-    return false;
-  }
-  uint16_t                                         enb_id = it->second;
-  std::map<int32_t, std::set<uint32_t> >::iterator ue_set = m_enb_assoc_to_ue_ids.find(ecm_ctx->enb_sri.sinfo_assoc_id);
-  if (ue_set == m_enb_assoc_to_ue_ids.end()) {
-    m_logger.error("Could not find the eNB's UEs.");
-    return false;
+  {
+    std::lock_guard<std::mutex>           lock(m_ctx_mutex);
+    std::map<int32_t, uint16_t>::iterator it = m_sctp_to_enb_id.find(ecm_ctx->enb_sri.sinfo_assoc_id);
+    if (it == m_sctp_to_enb_id.end()) {
+      m_logger.error("Could not find eNB for UE release request.");
+      return false;
+    }
+    std::map<int32_t, std::set<uint32_t> >::iterator ue_set =
+        m_enb_assoc_to_ue_ids.find(ecm_ctx->enb_sri.sinfo_assoc_id);
+    if (ue_set == m_enb_assoc_to_ue_ids.end()) {
+      m_logger.error("Could not find the eNB's UEs.");
+      return false;
+    }
+    ue_set->second.erase(mme_ue_s1ap_id);
   }
-  ue_set->second.erase(mme_ue_s1ap_id);
 
   // Release UE ECM context
-  m_mme_ue_s1ap_id_to_nas_ctx.erase(mme_ue_s1ap_id);
+  {
+    ue_shard_t&                 shard = get_ue_shard_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.mme_ue_s1ap_id_to_nas_ctx.erase(mme_ue_s1ap_id);
+  }
   ecm_ctx->state          = ECM_STATE_IDLE;
   ecm_ctx->mme_ue_s1ap_id = 0;
   ecm_ctx->enb_ue_s1ap_id = 0;
@@ -511,7 +685,11 @@ bool s1ap::delete_ue_ctx(uint64_t imsi)
   }
 
   // Delete UE context
-  m_imsi_to_nas_ctx.erase(imsi);
+  {
+    std::lock_guard<std::mutex> lock(m_ctx_mutex);
+    m_imsi_to_nas_ctx.erase(imsi);
+    m_imsi_to_ue_shard.erase(imsi);
+  }
   delete nas_ctx;
   m_logger.info("Deleted UE Context.");
   return true;
@@ -520,21 +698,20 @@ bool s1ap::delete_ue_ctx(uint64_t imsi)
 // UE Bearer Managment
 void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 {
-  std::map<uint64_t, nas*>::iterator ue_ctx_it = m_imsi_to_nas_ctx.find(imsi);
-  if (ue_ctx_it == m_imsi_to_nas_ctx.end()) {
+  nas* nas_ctx = find_nas_ctx_from_imsi(imsi);
+  if (nas_ctx == NULL) {
     m_logger.error("Could not activate EPS bearer: Could not find UE context");
     return;
   }
   // Make sure NAS is active
-  uint32_t                           mme_ue_s1ap_id = ue_ctx_it->second->m_ecm_ctx.mme_ue_s1ap_id;
-  std::map<uint32_t, nas*>::iterator it             = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
-  if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
+  uint32_t mme_ue_s1ap_id = nas_ctx->m_ecm_ctx.mme_ue_s1ap_id;
+  if (find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id) == NULL) {
     m_logger.error("Could not activate EPS bearer: ECM context seems to be missing");
     return;
   }
 
-  ecm_ctx_t* ecm_ctx = &ue_ctx_it->second->m_ecm_ctx;
-  esm_ctx_t* esm_ctx = &ue_ctx_it->second->m_esm_ctx[ebi];
+  ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
+  esm_ctx_t* esm_ctx = &nas_ctx->m_esm_ctx[ebi];
   if (esm_ctx->state != ERAB_CTX_SETUP) {
     m_logger.error(
         "Could not be activate EPS Bearer, bearer in wrong state: MME S1AP Id %d, EPS Bearer id %d, state %d",
@@ -557,7 +734,8 @@ void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 
 uint32_t s1ap::allocate_m_tmsi(uint64_t imsi)
 {
-  uint32_t m_tmsi = m_next_m_tmsi;
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  uint32_t                    m_tmsi = m_next_m_tmsi;
   m_next_m_tmsi   = (m_next_m_tmsi + 1) % UINT32_MAX;
 
   m_tmsi_to_imsi.insert(std::pair<uint32_t, uint64_t>(m_tmsi, imsi));
@@ -567,6 +745,7 @@ uint32_t s1ap::allocate_m_tmsi(uint64_t imsi)
 
 uint64_t s1ap::find_imsi_from_m_tmsi(uint32_t m_tmsi)
 {
+  std::lock_guard<std::mutex>            lock(m_ctx_mutex);
   std::map<uint32_t, uint64_t>::iterator it = m_tmsi_to_imsi.find(m_tmsi);
   if (it != m_tmsi_to_imsi.end()) {
     m_logger.debug("Found IMSI %015" PRIu64 " from M-TMSI 0x%x", it->second, m_tmsi);
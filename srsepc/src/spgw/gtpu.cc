@@ -76,6 +76,20 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
     return err;
   }
 
+  // Start the user-plane workers, each one with its own TUN queue and S1-U socket
+  for (uint32_t i = 0; i < args->nof_up_workers; ++i) {
+    std::unique_ptr<gtpu_up_worker> worker(new gtpu_up_worker(i));
+    worker->init(m_s1u_socks[i], m_sgi_queues[i], &m_tunnels, this);
+    if (not worker->start()) {
+      m_logger.error("Could not start GTP-U user-plane worker %d", i);
+      return SRSRAN_ERROR_CANT_START;
+    }
+    m_up_workers.push_back(std::move(worker));
+  }
+  if (not m_up_workers.empty()) {
+    m_logger.info("Started %zd GTP-U user-plane workers", m_up_workers.size());
+  }
+
   m_logger.info("SPGW GTP-U Initialized.");
   srsran::console("SPGW GTP-U Initialized.\n");
   return SRSRAN_SUCCESS;
@@ -83,14 +97,33 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
 
 void spgw::gtpu::stop()
 {
+  // Stop the user-plane workers before closing their file descriptors
+  for (auto& worker : m_up_workers) {
+    worker->stop();
+  }
+  m_up_workers.clear();
+
   // Clean up SGi interface
   if (m_sgi_up) {
-    close(m_sgi);
+    close_sgi_queues();
+    m_sgi_up = false;
   }
-  // Clean up S1-U socket
+  // Clean up S1-U sockets
   if (m_s1u_up) {
-    close(m_s1u);
+    for (int fd : m_s1u_socks) {
+      close(fd);
+    }
+    m_s1u_socks.clear();
+    m_s1u_up = false;
+  }
+}
+
+void spgw::gtpu::close_sgi_queues()
+{
+  for (int fd : m_sgi_queues) {
+    close(fd);
   }
+  m_sgi_queues.clear();
 }
 
 int spgw::gtpu::init_sgi(spgw_args_t* args)
@@ -102,32 +135,42 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
     return SRSRAN_ERROR_ALREADY_STARTED;
   }
 
-  // Construct the TUN device
-  m_sgi = open("/dev/net/tun", O_RDWR);
-  m_logger.info("TUN file descriptor = %d", m_sgi);
-  if (m_sgi < 0) {
-    m_logger.error("Failed to open TUN device: %s", strerror(errno));
-    return SRSRAN_ERROR_CANT_START;
-  }
-
-  memset(&ifr, 0, sizeof(ifr));
-  ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
-  strncpy(
-      ifr.ifr_ifrn.ifrn_name, args->sgi_if_name.c_str(), std::min(args->sgi_if_name.length(), (size_t)(IFNAMSIZ - 1)));
-  ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = '\0';
-
-  if (ioctl(m_sgi, TUNSETIFF, &ifr) < 0) {
-    m_logger.error("Failed to set TUN device name: %s", strerror(errno));
-    close(m_sgi);
-    return SRSRAN_ERROR_CANT_START;
+  // Construct the TUN device. With several user-plane workers, each of them gets its own queue.
+  uint32_t nof_queues = std::max(args->nof_up_workers, 1U);
+  for (uint32_t i = 0; i < nof_queues; ++i) {
+    int fd = open("/dev/net/tun", O_RDWR);
+    m_logger.info("TUN file descriptor = %d", fd);
+    if (fd < 0) {
+      m_logger.error("Failed to open TUN device: %s", strerror(errno));
+      close_sgi_queues();
+      return SRSRAN_ERROR_CANT_START;
+    }
+    m_sgi_queues.push_back(fd);
+
+    memset(&ifr, 0, sizeof(ifr));
+    ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+    if (nof_queues > 1) {
+      ifr.ifr_flags |= IFF_MULTI_QUEUE;
+    }
+    strncpy(ifr.ifr_ifrn.ifrn_name,
+            args->sgi_if_name.c_str(),
+            std::min(args->sgi_if_name.length(), (size_t)(IFNAMSIZ - 1)));
+    ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = '\0';
+
+    if (ioctl(fd, TUNSETIFF, &ifr) < 0) {
+      m_logger.error("Failed to set TUN device name: %s", strerror(errno));
+      close_sgi_queues();
+      return SRSRAN_ERROR_CANT_START;
+    }
   }
+  m_sgi = m_sgi_queues[0];
 
   // Bring up the interface
   sgi_sock = socket(AF_INET, SOCK_DGRAM, 0);
   if (ioctl(sgi_sock, SIOCGIFFLAGS, &ifr) < 0) {
     m_logger.error("Failed to bring up socket: %s", strerror(errno));
     close(sgi_sock);
-    close(m_sgi);
+    close_sgi_queues();
     return SRSRAN_ERROR_CANT_START;
   }
 
@@ -135,7 +178,7 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   if (ioctl(sgi_sock, SIOCSIFFLAGS, &ifr) < 0) {
     m_logger.error("Failed to set socket flags: %s", strerror(errno));
     close(sgi_sock);
-    close(m_sgi);
+    close_sgi_queues();
     return SRSRAN_ERROR_CANT_START;
   }
 
@@ -150,7 +193,7 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   if (ioctl(sgi_sock, SIOCSIFADDR, &ifr) < 0) {
     m_logger.error(
         "Failed to set TUN interface IP. Address: %s, Error: %s", args->sgi_if_addr.c_str(), strerror(errno));
-    close(m_sgi);
+    close_sgi_queues();
     close(sgi_sock);
     return SRSRAN_ERROR_CANT_START;
   }
@@ -162,7 +205,7 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   }
   if (ioctl(sgi_sock, SIOCSIFNETMASK, &ifr) < 0) {
     m_logger.error("Failed to set TUN interface Netmask. Error: %s", strerror(errno));
-    close(m_sgi);
+    close_sgi_queues();
     close(sgi_sock);
     return SRSRAN_ERROR_CANT_START;
   }
@@ -175,16 +218,8 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
 
 int spgw::gtpu::init_s1u(spgw_args_t* args)
 {
-  // Open S1-U socket
-  m_s1u = socket(AF_INET, SOCK_DGRAM, 0);
-  if (m_s1u == -1) {
-    m_logger.error("Failed to open socket: %s", strerror(errno));
-    return SRSRAN_ERROR_CANT_START;
-  }
-  m_s1u_up = true;
-
-  // Bind the socket
-  m_s1u_addr.sin_family      = AF_INET;
+  // Bind the S1-U socket. With several user-plane workers, each of them gets its own socket.
+  m_s1u_addr.sin_family = AF_INET;
   if (inet_pton(m_s1u_addr.sin_family, args->gtpu_bind_addr.c_str(), &m_s1u_addr.sin_addr.s_addr) != 1) {
     m_logger.error("Invalid gtpu_bind_addr: %s", args->gtpu_bind_addr.c_str());
     srsran::console("Invalid gtpu_bind_addr: %s\n", args->gtpu_bind_addr.c_str());
@@ -192,10 +227,12 @@ int spgw::gtpu::init_s1u(spgw_args_t* args)
   }
   m_s1u_addr.sin_port        = htons(GTPU_RX_PORT);
 
-  if (bind(m_s1u, (struct sockaddr*)&m_s1u_addr, sizeof(struct sockaddr_in))) {
-    m_logger.error("Failed to bind socket: %s", strerror(errno));
+  if (gtpu_open_s1u_sockets(&m_s1u_addr, std::max(args->nof_up_workers, 1U), m_s1u_socks, m_logger) !=
+      SRSRAN_SUCCESS) {
     return SRSRAN_ERROR_CANT_START;
   }
+  m_s1u    = m_s1u_socks[0];
+  m_s1u_up = true;
   m_logger.info("S1-U socket = %d", m_s1u);
   m_logger.info("S1-U IP = %s, Port = %d ", inet_ntoa(m_s1u_addr.sin_addr), ntohs(m_s1u_addr.sin_port));
 
@@ -205,14 +242,7 @@ int spgw::gtpu::init_s1u(spgw_args_t* args)
 
 void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
 {
-  bool usr_found = false;
-  bool ctr_found = false;
-
-  std::map<uint32_t, srsran::gtpc_f_teid_ie>::iterator gtpu_fteid_it;
-  std::map<in_addr_t, uint32_t>::iterator              gtpc_teid_it;
-  srsran::gtpc_f_teid_ie                               enb_fteid;
-  uint32_t                                             spgw_teid;
-  struct iphdr*                                        iph = (struct iphdr*)msg->msg;
+  struct iphdr* iph = (struct iphdr*)msg->msg;
   m_logger.debug("Received SGi PDU. Bytes %d", msg->N_bytes);
 
   if (iph->version != 4) {
@@ -234,33 +264,38 @@ void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
   m_logger.debug("SGi PDU -- IP dst addr %s", srsran::to_c_str(buffer));
 
   // Find user and control tunnel
-  gtpu_fteid_it = m_ip_to_usr_teid.find(iph->daddr);
-  if (gtpu_fteid_it != m_ip_to_usr_teid.end()) {
-    usr_found = true;
-    enb_fteid = gtpu_fteid_it->second;
-  }
-  gtpc_teid_it = m_ip_to_ctr_teid.find(iph->daddr);
-  if (gtpc_teid_it != m_ip_to_ctr_teid.end()) {
-    ctr_found = true;
-    spgw_teid = gtpc_teid_it->second;
-  }
+  gtpu_dl_tunnel_t tunnel = m_tunnels.find(iph->daddr);
 
   // Handle SGi packet
-  if (usr_found == false && ctr_found == false) {
+  if (tunnel.usr_found == false && tunnel.ctr_found == false) {
     m_logger.debug("Packet for unknown UE.");
-  } else if (usr_found == false && ctr_found == true) {
-    m_logger.debug("Packet for attached UE that is not ECM connected.");
-    m_logger.debug("Triggering Donwlink Notification Requset.");
-    m_gtpc->send_downlink_data_notification(spgw_teid);
-    m_gtpc->queue_downlink_packet(spgw_teid, std::move(msg));
-    return;
-  } else if (usr_found == true && ctr_found == false) {
+  } else if (tunnel.usr_found == false && tunnel.ctr_found == true) {
+    handle_paging_pdu(tunnel.spgw_ctrl_teid, std::move(msg));
+  } else if (tunnel.usr_found == true && tunnel.ctr_found == false) {
     m_logger.error("User plane tunnel found without a control plane tunnel present.");
   } else {
-    send_s1u_pdu(enb_fteid, msg.get());
+    send_s1u_pdu(tunnel.enb_fteid, msg.get());
   }
 }
 
+void spgw::gtpu::handle_paging_pdu(uint32_t spgw_ctrl_teid, srsran::unique_byte_buffer_t msg)
+{
+  std::lock_guard<std::mutex> lock(m_spgw->m_gtpc_mutex);
+
+  // A user-plane worker may have looked up the tunnel before GTP-C activated it and flushed the paging queue
+  struct iphdr*    iph    = (struct iphdr*)msg->msg;
+  gtpu_dl_tunnel_t tunnel = m_tunnels.find(iph->daddr);
+  if (tunnel.usr_found) {
+    send_s1u_pdu(tunnel.enb_fteid, msg.get());
+    return;
+  }
+
+  m_logger.debug("Packet for attached UE that is not ECM connected.");
+  m_logger.debug("Triggering Donwlink Notification Requset.");
+  m_gtpc->send_downlink_data_notification(spgw_ctrl_teid);
+  m_gtpc->queue_downlink_packet(spgw_ctrl_teid, std::move(msg));
+}
+
 void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg)
 {
   srsran::gtpu_header_t header;
@@ -340,17 +375,14 @@ bool spgw::gtpu::modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw
   srsran::gtpu_ntoa(buffer, dw_user_fteid.ipv4);
   m_logger.info("Downlink eNB addr %s, U-TEID 0x%x", srsran::to_c_str(buffer), dw_user_fteid.teid);
   m_logger.info("Uplink C-TEID: 0x%x", up_ctrl_teid);
-  m_ip_to_usr_teid[ue_ipv4] = dw_user_fteid;
-  m_ip_to_ctr_teid[ue_ipv4] = up_ctrl_teid;
+  m_tunnels.modify(ue_ipv4, dw_user_fteid, up_ctrl_teid);
   return true;
 }
 
 bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 {
   // Remove GTP-U connections, if any.
-  if (m_ip_to_usr_teid.count(ue_ipv4)) {
-    m_ip_to_usr_teid.erase(ue_ipv4);
-  } else {
+  if (not m_tunnels.delete_usr(ue_ipv4)) {
     m_logger.error("Could not find GTP-U Tunnel to delete.");
     return false;
   }
@@ -360,9 +392,7 @@ bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 bool spgw::gtpu::delete_gtpc_tunnel(in_addr_t ue_ipv4)
 {
   // Remove Ctrl TEID from IP mapping.
-  if (m_ip_to_ctr_teid.count(ue_ipv4)) {
-    m_ip_to_ctr_teid.erase(ue_ipv4);
-  } else {
+  if (not m_tunnels.delete_ctr(ue_ipv4)) {
     m_logger.error("Could not find GTP-C Tunnel info to delete.");
     return false;
   }
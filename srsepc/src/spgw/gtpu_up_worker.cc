@@ -0,0 +1,413 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/spgw/gtpu_up_worker.h"
+#include "srsran/common/rwlock_guard.h"
+#include "srsran/upper/gtpu.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/filter.h>
+#include <linux/ip.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+
+namespace srsepc {
+
+/**************************************
+ *
+ * Tunnel table shared between GTP-C
+ * and the user-plane workers
+ *
+ **************************************/
+
+gtpu_tunnel_table::gtpu_tunnel_table()
+{
+  pthread_rwlock_init(&rwlock, nullptr);
+}
+
+gtpu_tunnel_table::~gtpu_tunnel_table()
+{
+  pthread_rwlock_destroy(&rwlock);
+}
+
+void gtpu_tunnel_table::modify(in_addr_t ue_ipv4, const srsran::gtp_fteid_t& dw_user_fteid, uint32_t up_ctrl_teid)
+{
+  srsran::rwlock_write_guard lock(rwlock);
+  gtpu_dl_tunnel_t&          tunnel = tunnels[ue_ipv4];
+  tunnel.usr_found                  = true;
+  tunnel.enb_fteid                  = dw_user_fteid;
+  tunnel.ctr_found                  = true;
+  tunnel.spgw_ctrl_teid             = up_ctrl_teid;
+}
+
+bool gtpu_tunnel_table::delete_usr(in_addr_t ue_ipv4)
+{
+  srsran::rwlock_write_guard lock(rwlock);
+  auto                       it = tunnels.find(ue_ipv4);
+  if (it == tunnels.end() or not it->second.usr_found) {
+    return false;
+  }
+  it->second.usr_found = false;
+  if (not it->second.ctr_found) {
+    tunnels.erase(it);
+  }
+  return true;
+}
+
+bool gtpu_tunnel_table::delete_ctr(in_addr_t ue_ipv4)
+{
+  srsran::rwlock_write_guard lock(rwlock);
+  auto                       it = tunnels.find(ue_ipv4);
+  if (it == tunnels.end() or not it->second.ctr_found) {
+    return false;
+  }
+  it->second.ctr_found = false;
+  if (not it->second.usr_found) {
+    tunnels.erase(it);
+  }
+  return true;
+}
+
+gtpu_dl_tunnel_t gtpu_tunnel_table::find_unlocked(in_addr_t ue_ipv4) const
+{
+  auto it = tunnels.find(ue_ipv4);
+  if (it == tunnels.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+gtpu_dl_tunnel_t gtpu_tunnel_table::find(in_addr_t ue_ipv4) const
+{
+  srsran::rwlock_read_guard lock(rwlock);
+  return find_unlocked(ue_ipv4);
+}
+
+void gtpu_tunnel_table::find(const in_addr_t* ue_ipv4, uint32_t nof_addrs, gtpu_dl_tunnel_t* tunnels_) const
+{
+  srsran::rwlock_read_guard lock(rwlock);
+  for (uint32_t i = 0; i < nof_addrs; ++i) {
+    tunnels_[i] = find_unlocked(ue_ipv4[i]);
+  }
+}
+
+/**************************************
+ *
+ * User-plane worker
+ *
+ **************************************/
+
+namespace {
+
+// Timeout of the worker poll, so that stop() does not need to wake the worker up
+const int poll_timeout_ms = 100;
+
+// The user-plane PDUs are bounded by the SGi MTU, so they are taken from the MTU size class of the buffer pool
+const uint32_t pdu_buf_len = srsran::byte_buffer_payload_size(srsran::byte_buffer_size_class::mtu);
+
+} // namespace
+
+gtpu_up_worker::gtpu_up_worker(uint32_t id_) : thread("GTPU_UP_" + std::to_string(id_)), id(id_) {}
+
+gtpu_up_worker::~gtpu_up_worker()
+{
+  stop();
+}
+
+void gtpu_up_worker::init(int                      s1u_fd_,
+                          int                      sgi_fd_,
+                          const gtpu_tunnel_table* tunnels_,
+                          gtpu_up_paging_handler*  paging_,
+                          uint16_t                 enb_gtpu_port_)
+{
+  s1u_fd        = s1u_fd_;
+  sgi_fd        = sgi_fd_;
+  tunnels       = tunnels_;
+  paging        = paging_;
+  enb_gtpu_port = enb_gtpu_port_;
+
+  // SGi reads are drained until EAGAIN, up to a batch per wakeup
+  int flags = fcntl(sgi_fd, F_GETFL, 0);
+  if (flags < 0 or fcntl(sgi_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+    logger.error("Worker %d: could not set SGi file descriptor as non-blocking: %s", id, strerror(errno));
+  }
+
+  running = true;
+}
+
+void gtpu_up_worker::stop()
+{
+  if (running.exchange(false)) {
+    wait_thread_finish();
+  }
+}
+
+void gtpu_up_worker::run_thread()
+{
+  struct pollfd fds[2] = {};
+  fds[0].fd            = s1u_fd;
+  fds[0].events        = POLLIN;
+  fds[1].fd            = sgi_fd;
+  fds[1].events        = POLLIN;
+
+  while (running) {
+    int n = poll(fds, 2, poll_timeout_ms);
+    if (n < 0) {
+      if (errno != EINTR) {
+        logger.error("Worker %d: error from poll: %s", id, strerror(errno));
+      }
+      continue;
+    }
+    if (fds[0].revents & POLLIN) {
+      handle_s1u_batch();
+    }
+    if (fds[1].revents & POLLIN) {
+      handle_sgi_batch();
+    }
+  }
+}
+
+void gtpu_up_worker::handle_s1u_batch()
+{
+  uint32_t nof_bufs = 0;
+  for (; nof_bufs < max_batch_size; ++nof_bufs) {
+    if (pdus[nof_bufs] == nullptr) {
+      pdus[nof_bufs] = srsran::make_byte_buffer(pdu_buf_len);
+      if (pdus[nof_bufs] == nullptr) {
+        break;
+      }
+    }
+    pdus[nof_bufs]->clear();
+    iovs[nof_bufs].iov_base           = pdus[nof_bufs]->msg;
+    iovs[nof_bufs].iov_len            = pdu_buf_len;
+    msgs[nof_bufs]                    = {};
+    msgs[nof_bufs].msg_hdr.msg_iov    = &iovs[nof_bufs];
+    msgs[nof_bufs].msg_hdr.msg_iovlen = 1;
+  }
+  if (nof_bufs == 0) {
+    logger.error("Worker %d: could not allocate S1-U buffers", id);
+    return;
+  }
+
+  int n = recvmmsg(s1u_fd, msgs.data(), nof_bufs, MSG_DONTWAIT, nullptr);
+  if (n < 0) {
+    if (errno != EAGAIN and errno != EWOULDBLOCK and errno != EINTR) {
+      logger.error("Worker %d: error receiving from S1-U: %s", id, strerror(errno));
+    }
+    return;
+  }
+
+  uint64_t nof_fwd = 0;
+  for (int i = 0; i < n; ++i) {
+    srsran::byte_buffer_t* pdu = pdus[i].get();
+    pdu->N_bytes               = msgs[i].msg_len;
+    if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+      logger.warning("Dropping S1-U PDU larger than %d bytes", pdu_buf_len);
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    srsran::gtpu_header_t header;
+    if (pdu->N_bytes < GTPU_BASE_HEADER_LEN or not srsran::gtpu_read_header(pdu, &header, logger)) {
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+    logger.debug("Received PDU from S1-U. TEID 0x%x, Bytes=%d", header.teid, pdu->N_bytes);
+
+    if (write(sgi_fd, pdu->msg, pdu->N_bytes) < 0) {
+      if (errno == EAGAIN or errno == EWOULDBLOCK) {
+        logger.debug("TUN queue full, dropping packet.");
+      } else {
+        logger.error("Could not write to TUN interface.");
+      }
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+    nof_fwd++;
+  }
+  nof_ul_pdus.fetch_add(nof_fwd, std::memory_order_relaxed);
+}
+
+void gtpu_up_worker::handle_sgi_batch()
+{
+  // TUN devices do not support recvmmsg(), so the batch is drained with non-blocking reads
+  uint32_t nof_pdus = 0;
+  while (nof_pdus < max_batch_size) {
+    if (pdus[nof_pdus] == nullptr) {
+      pdus[nof_pdus] = srsran::make_byte_buffer(pdu_buf_len);
+      if (pdus[nof_pdus] == nullptr) {
+        logger.error("Worker %d: could not allocate SGi buffer", id);
+        break;
+      }
+    }
+    srsran::byte_buffer_t* pdu = pdus[nof_pdus].get();
+    pdu->clear();
+    ssize_t n = read(sgi_fd, pdu->msg, pdu_buf_len);
+    if (n <= 0) {
+      if (n < 0 and errno != EAGAIN and errno != EWOULDBLOCK and errno != EINTR) {
+        logger.error("Worker %d: error reading from SGi: %s", id, strerror(errno));
+      }
+      break;
+    }
+    pdu->N_bytes = n;
+
+    struct iphdr* iph = (struct iphdr*)pdu->msg;
+    if (pdu->N_bytes < sizeof(struct iphdr) or iph->version != 4) {
+      logger.debug("Dropping non IPv4 SGi PDU. Bytes %d", pdu->N_bytes);
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+    ue_addrs[nof_pdus] = iph->daddr;
+    nof_pdus++;
+  }
+  if (nof_pdus == 0) {
+    return;
+  }
+
+  // Resolve all the tunnels of the batch under a single lock
+  tunnels->find(ue_addrs.data(), nof_pdus, dl_tunnels.data());
+
+  uint32_t nof_msgs = 0;
+  for (uint32_t i = 0; i < nof_pdus; ++i) {
+    const gtpu_dl_tunnel_t& tunnel = dl_tunnels[i];
+    if (not tunnel.usr_found or not tunnel.ctr_found) {
+      continue;
+    }
+    srsran::gtpu_header_t header;
+    header.flags        = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+    header.message_type = GTPU_MSG_DATA_PDU;
+    header.length       = pdus[i]->N_bytes;
+    header.teid         = tunnel.enb_fteid.teid;
+    if (not srsran::gtpu_write_header(&header, pdus[i].get(), logger)) {
+      logger.error("Error writing GTP-U header on PDU");
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    addrs[nof_msgs].sin_family         = AF_INET;
+    addrs[nof_msgs].sin_port           = htons(enb_gtpu_port);
+    addrs[nof_msgs].sin_addr.s_addr    = tunnel.enb_fteid.ipv4;
+    iovs[nof_msgs].iov_base            = pdus[i]->msg;
+    iovs[nof_msgs].iov_len             = pdus[i]->N_bytes;
+    msgs[nof_msgs]                     = {};
+    msgs[nof_msgs].msg_hdr.msg_name    = &addrs[nof_msgs];
+    msgs[nof_msgs].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    msgs[nof_msgs].msg_hdr.msg_iov     = &iovs[nof_msgs];
+    msgs[nof_msgs].msg_hdr.msg_iovlen  = 1;
+    nof_msgs++;
+  }
+
+  uint32_t nof_sent = 0;
+  while (nof_sent < nof_msgs) {
+    int n = sendmmsg(s1u_fd, &msgs[nof_sent], nof_msgs - nof_sent, 0);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      logger.error("Error sending packets to eNB: %s", strerror(errno));
+      nof_dropped.fetch_add(nof_msgs - nof_sent, std::memory_order_relaxed);
+      break;
+    }
+    nof_sent += n;
+  }
+  nof_dl_pdus.fetch_add(nof_sent, std::memory_order_relaxed);
+
+  // Hand the PDUs of UEs in ECM-IDLE over to GTP-C once the rest of the batch is on its way
+  for (uint32_t i = 0; i < nof_pdus; ++i) {
+    const gtpu_dl_tunnel_t& tunnel = dl_tunnels[i];
+    if (not tunnel.usr_found and tunnel.ctr_found) {
+      paging->handle_paging_pdu(tunnel.spgw_ctrl_teid, std::move(pdus[i]));
+    } else if (not tunnel.usr_found) {
+      logger.debug("Packet for unknown UE.");
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+    } else if (not tunnel.ctr_found) {
+      logger.error("User plane tunnel found without a control plane tunnel present.");
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+/**************************************
+ *
+ * S1-U socket group
+ *
+ **************************************/
+
+int gtpu_open_s1u_sockets(struct sockaddr_in*   addr,
+                          uint32_t              nof_sockets,
+                          std::vector<int>&     fds,
+                          srslog::basic_logger& logger)
+{
+  fds.clear();
+  for (uint32_t i = 0; i < nof_sockets; ++i) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+      logger.error("Failed to open socket: %s", strerror(errno));
+      goto clean_exit;
+    }
+    fds.push_back(fd);
+
+    int enable = 1;
+    if (nof_sockets > 1 and setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0) {
+      logger.error("setsockopt(SO_REUSEPORT) failed: %s", strerror(errno));
+      goto clean_exit;
+    }
+    if (bind(fd, (struct sockaddr*)addr, sizeof(struct sockaddr_in)) < 0) {
+      logger.error("Failed to bind socket: %s", strerror(errno));
+      goto clean_exit;
+    }
+    if (addr->sin_port == 0) {
+      socklen_t addrlen = sizeof(struct sockaddr_in);
+      getsockname(fd, (struct sockaddr*)addr, &addrlen);
+    }
+  }
+
+  if (nof_sockets > 1) {
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+    // The program runs on the UDP payload and returns the index of the socket, in bind order, that gets the PDU
+    struct sock_filter code[] = {
+        {BPF_LD | BPF_W | BPF_ABS, 0, 0, 4},            // A = TEID
+        {BPF_ALU | BPF_MOD | BPF_K, 0, 0, nof_sockets}, // A = A % nof_sockets
+        {BPF_RET | BPF_A, 0, 0, 0},
+    };
+    struct sock_fprog prog = {};
+    prog.len               = sizeof(code) / sizeof(code[0]);
+    prog.filter            = code;
+    if (setsockopt(fds[0], SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) < 0) {
+      logger.warning("Could not attach S1-U TEID steering program, falling back to address hashing: %s",
+                     strerror(errno));
+    }
+#else
+    logger.warning("S1-U TEID steering not supported, falling back to address hashing");
+#endif
+  }
+  return SRSRAN_SUCCESS;
+
+clean_exit:
+  for (int fd : fds) {
+    close(fd);
+  }
+  fds.clear();
+  return SRSRAN_ERROR_CANT_START;
+}
+
+} // namespace srsepc
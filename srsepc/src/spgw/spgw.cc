@@ -117,6 +117,9 @@ void spgw::run_thread()
 
   size_t buf_len = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
 
+  // With user-plane workers, this thread only handles S11
+  bool handle_user_plane = not m_gtpu->has_up_workers();
+
   fd_set set;
   int    max_fd = std::max(s1u, sgi);
   max_fd        = std::max(max_fd, s11);
@@ -125,15 +128,17 @@ void spgw::run_thread()
     s11_msg->clear();
 
     FD_ZERO(&set);
-    FD_SET(s1u, &set);
-    FD_SET(sgi, &set);
+    if (handle_user_plane) {
+      FD_SET(s1u, &set);
+      FD_SET(sgi, &set);
+    }
     FD_SET(s11, &set);
 
     int n = select(max_fd + 1, &set, NULL, NULL, NULL);
     if (n == -1) {
       m_logger.error("Error from select");
     } else if (n) {
-      if (FD_ISSET(sgi, &set)) {
+      if (handle_user_plane && FD_ISSET(sgi, &set)) {
         /*
          * SGi messages may need to be queued when waiting for UE Paging procedure.
          * For this reason, buffers for SGi pdus are allocated here and deallocated
@@ -147,7 +152,7 @@ void spgw::run_thread()
         sgi_msg->N_bytes = read(sgi, sgi_msg->msg, buf_len);
         m_gtpu->handle_sgi_pdu(std::move(sgi_msg));
       }
-      if (FD_ISSET(s1u, &set)) {
+      if (handle_user_plane && FD_ISSET(s1u, &set)) {
         m_logger.debug("Message received at SPGW: S1-U Message");
         socklen_t addrlen = sizeof(src_addr_in);
         s1u_msg->N_bytes  = recvfrom(s1u, s1u_msg->msg, buf_len, 0, (struct sockaddr*)&src_addr_in, &addrlen);
@@ -157,6 +162,7 @@ void spgw::run_thread()
         m_logger.debug("Message received at SPGW: S11 Message");
         socklen_t addrlen = sizeof(src_addr_un);
         s11_msg->N_bytes  = recvfrom(s11, s11_msg->msg, buf_len, 0, (struct sockaddr*)&src_addr_un, &addrlen);
+        std::lock_guard<std::mutex> lock(m_gtpc_mutex);
         m_gtpc->handle_s11_pdu(s11_msg.get());
       }
     } else {
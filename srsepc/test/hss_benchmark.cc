@@ -0,0 +1,220 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsran/common/test_common.h"
+
+#include <chrono>
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Measures the startup time of the HSS and the latency of the authentication info requests, for a user DB with many
+ * subscribers. It then emulates a crash of the EPC and checks that the SQNs are restored after the restart, and that
+ * a long SQN log is merged into the DB file while the HSS runs.
+ */
+
+using namespace srsepc;
+
+static uint32_t    nof_users   = 10000;
+static uint32_t    nof_auths   = 100000;
+static uint32_t    nof_synced  = 1000;
+static std::string db_filename = "hss_benchmark_user_db.csv";
+
+static const uint64_t first_imsi = 1010000000000;
+
+static void usage(const char* prog)
+{
+  printf("Usage: %s [nasf]\n", prog);
+  printf("\t-n Number of subscribers in the user DB [Default %d]\n", nof_users);
+  printf("\t-a Number of authentication requests [Default %d]\n", nof_auths);
+  printf("\t-s Number of authentication requests with synced SQN updates [Default %d]\n", nof_synced);
+  printf("\t-f User DB file, which is overwritten [Default %s]\n", db_filename.c_str());
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:a:s:f:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_users = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'a':
+        nof_auths = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        nof_synced = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'f':
+        db_filename = optarg;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (nof_users == 0) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+static uint8_t user_key_byte(uint32_t user_idx)
+{
+  return (uint8_t)(user_idx * 7 + 1);
+}
+
+static int write_user_db()
+{
+  FILE* f = fopen(db_filename.c_str(), "w");
+  if (f == nullptr) {
+    perror("fopen");
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t i = 0; i < nof_users; ++i) {
+    // Half of the users with each algorithm, and some with OP rather than OPc
+    fprintf(f, "ue%d,%s,%015" PRIu64 ",", i, i % 2 == 0 ? "xor" : "mil", first_imsi + i);
+    for (uint32_t j = 0; j < 16; ++j) {
+      fprintf(f, "%02x", user_key_byte(i));
+    }
+    fprintf(f, ",%s,63bfa50ee6523365ff14c1f45f88737d,8000,%012x,7,dynamic\n", i % 3 == 0 ? "op" : "opc", i * 32);
+  }
+  fclose(f);
+  return SRSRAN_SUCCESS;
+}
+
+static void remove_db_files()
+{
+  unlink(db_filename.c_str());
+  unlink((db_filename + ".sqn").c_str());
+}
+
+static hss* start_hss(bool sync, double& startup_s, uint32_t sqn_log_max_records = 65536)
+{
+  hss_args_t args          = {};
+  args.db_file             = db_filename;
+  args.db_sync             = sync;
+  args.mcc                 = 1;
+  args.mnc                 = 1;
+  args.sqn_log_max_records = sqn_log_max_records;
+
+  auto t0 = std::chrono::steady_clock::now();
+  hss* h  = hss::get_instance();
+  if (h->init(&args) != 0) {
+    return nullptr;
+  }
+  startup_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  return h;
+}
+
+/// Returns the average latency in microseconds
+static double run_auths(hss* h, uint32_t nof_requests)
+{
+  uint8_t k_asme[32], autn[16], rand[16], xres[16];
+  auto    t0 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_requests; ++i) {
+    // Visit the users in a scattered order
+    uint32_t user_idx = (uint32_t)(((uint64_t)i * 7919) % nof_users);
+    TESTASSERT(h->gen_auth_info_answer(first_imsi + user_idx, k_asme, autn, rand, xres));
+  }
+  double elapsed_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+  return nof_requests > 0 ? elapsed_us / nof_requests : 0;
+}
+
+/// SQN used in an authentication of user 0, which uses the XOR algorithm: AUTN[0:5] = SQN ^ K[3:8] ^ RAND[3:8]
+static uint64_t auth_user0_sqn(hss* h)
+{
+  uint8_t k_asme[32], autn[16], rand[16], xres[16];
+  TESTASSERT(h->gen_auth_info_answer(first_imsi, k_asme, autn, rand, xres));
+  uint64_t sqn = 0;
+  for (uint32_t i = 0; i < 6; ++i) {
+    sqn = (sqn << 8u) | (uint8_t)(autn[i] ^ user_key_byte(0) ^ rand[i + 3]);
+  }
+  return sqn;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("HSS", false).set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  remove_db_files();
+  TESTASSERT(write_user_db() == SRSRAN_SUCCESS);
+
+  // Import from the CSV file, with an empty SQN log
+  double startup_s = 0;
+  hss*   h         = start_hss(false, startup_s);
+  TESTASSERT(h != nullptr);
+  double auth_us = run_auths(h, nof_auths);
+  h->stop();
+  hss::cleanup();
+
+  // Synced SQN updates
+  double unused_s = 0;
+  h               = start_hss(true, unused_s);
+  TESTASSERT(h != nullptr);
+  double synced_auth_us = run_auths(h, nof_synced);
+
+  // Emulate a crash, i.e. stop without writing the DB file. The SQN log must bring the SQNs back on restart
+  uint64_t sqn_before_crash = auth_user0_sqn(h);
+  hss::cleanup();
+  double restart_s = 0;
+  h                = start_hss(false, restart_s);
+  TESTASSERT(h != nullptr);
+  uint64_t sqn_after_restart = auth_user0_sqn(h);
+  TESTASSERT(sqn_after_restart > sqn_before_crash);
+  h->stop();
+  hss::cleanup();
+
+  // Short SQN log, which is merged into the DB file several times. The SQNs must survive a crash even without the log
+  const uint32_t log_max_records = 100;
+  h                              = start_hss(false, unused_s, log_max_records);
+  TESTASSERT(h != nullptr);
+  uint64_t sqn_before_compaction = auth_user0_sqn(h);
+  run_auths(h, 10 * log_max_records);
+  struct stat log_stat = {};
+  TESTASSERT(stat((db_filename + ".sqn").c_str(), &log_stat) == 0);
+  TESTASSERT(log_stat.st_size < 16 * log_max_records); // 16 bytes per record
+  hss::cleanup();
+  unlink((db_filename + ".sqn").c_str());
+  h = start_hss(false, unused_s);
+  TESTASSERT(h != nullptr);
+  TESTASSERT(auth_user0_sqn(h) > sqn_before_compaction);
+  h->stop();
+  hss::cleanup();
+
+  printf("Subscribers:                   %d\n", nof_users);
+  printf("Startup time:                  %.1f ms\n", startup_s * 1000);
+  printf("Restart time after a crash:    %.1f ms, %d SQN updates replayed\n", restart_s * 1000, nof_synced + 1);
+  printf("Auth info answer latency:      %.2f us\n", auth_us);
+  printf("Auth latency, SQN synced:      %.2f us\n", synced_auth_us);
+
+  remove_db_files();
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
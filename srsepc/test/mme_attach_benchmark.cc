@@ -0,0 +1,700 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsepc/hdr/mme/mme.h"
+#include "srsran/asn1/gtpc.h"
+#include "srsran/asn1/liblte_byte_buffer.h"
+#include "srsran/asn1/liblte_mme.h"
+#include "srsran/asn1/s1ap.h"
+#include "srsran/common/bcd_helpers.h"
+#include "srsran/common/int_helpers.h"
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <getopt.h>
+#include <inttypes.h>
+#include <netinet/sctp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+/*
+ * Synthetic attach storm against the MME. The HSS and the MME run in this process, together with a minimal S-GW that
+ * answers the S11 requests. A number of eNBs connect over SCTP and attach UEs concurrently, keeping a window of
+ * attaches in progress each. Reports the attach rate and latency, which are bound by the S1AP/NAS procedures of the
+ * MME, including the authentication vector generation.
+ */
+
+using namespace srsepc;
+using namespace asn1::s1ap;
+
+static uint32_t    nof_enbs       = 4;
+static uint32_t    nof_ues        = 2000;
+static uint32_t    nof_workers    = 0;
+static uint32_t    window         = 16;
+static std::string db_filename    = "mme_attach_benchmark_user_db.csv";
+static const char* mme_bind_addr  = "127.0.0.1";
+static const int   rx_timeout_sec = 10;
+
+static const uint64_t first_imsi = 1010000000000;
+static const uint16_t mcc        = 0xf001;
+static const uint16_t mnc        = 0xff01;
+static const uint16_t tac        = 0x0007;
+static const uint32_t s1ap_ppid  = 18;
+static const uint8_t  opc[16]    = {0x63, 0xbf, 0xa5, 0x0e, 0xe6, 0x52, 0x33, 0x65,
+                                0xff, 0x14, 0xc1, 0xf4, 0x5f, 0x88, 0x73, 0x7d};
+
+static const srsran::INTEGRITY_ALGORITHM_ID_ENUM integ_algo = srsran::INTEGRITY_ALGORITHM_ID_128_EIA2;
+
+static void usage(const char* prog)
+{
+  printf("Usage: %s [euwof]\n", prog);
+  printf("\t-e Number of eNBs [Default %d]\n", nof_enbs);
+  printf("\t-u Number of UEs [Default %d]\n", nof_ues);
+  printf("\t-w Number of MME S1AP workers, 0 for the MME thread [Default %d]\n", nof_workers);
+  printf("\t-o Number of attaches in progress per eNB [Default %d]\n", window);
+  printf("\t-f User DB file, which is overwritten [Default %s]\n", db_filename.c_str());
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "e:u:w:o:f:")) != -1) {
+    switch (opt) {
+      case 'e':
+        nof_enbs = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'u':
+        nof_ues = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'w':
+        nof_workers = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'o':
+        window = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'f':
+        db_filename = optarg;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (nof_enbs == 0 || nof_ues < nof_enbs || window == 0) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+static void user_key(uint32_t user_idx, uint8_t* k)
+{
+  for (uint32_t i = 0; i < 16; ++i) {
+    k[i] = (uint8_t)(user_idx * 7 + i);
+  }
+}
+
+static int write_user_db()
+{
+  FILE* f = fopen(db_filename.c_str(), "w");
+  if (f == nullptr) {
+    perror("fopen");
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    uint8_t k[16];
+    user_key(i, k);
+    fprintf(f, "ue%d,mil,%015" PRIu64 ",", i, first_imsi + i);
+    for (uint32_t j = 0; j < 16; ++j) {
+      fprintf(f, "%02x", k[j]);
+    }
+    fprintf(f, ",opc,");
+    for (uint32_t j = 0; j < 16; ++j) {
+      fprintf(f, "%02x", opc[j]);
+    }
+    fprintf(f, ",8000,%012x,7,dynamic\n", i * 32);
+  }
+  fclose(f);
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * S-GW emulator. Accepts all the sessions and bearer modifications of the MME
+ */
+static std::atomic<bool> sgw_running(true);
+
+static int open_sgw_socket()
+{
+  int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+  if (fd < 0) {
+    perror("socket");
+    return -1;
+  }
+  struct sockaddr_un addr = {};
+  addr.sun_family         = AF_UNIX;
+  snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", "@spgw_s11");
+  addr.sun_path[0] = '\0';
+  if (bind(fd, (const struct sockaddr*)&addr, sizeof(addr)) < 0) {
+    perror("bind");
+    close(fd);
+    return -1;
+  }
+  struct timeval tv = {0, 100000};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  return fd;
+}
+
+static void run_sgw(int fd)
+{
+  srsran::gtpc_pdu req, resp;
+  while (sgw_running) {
+    struct sockaddr_un src     = {};
+    socklen_t          src_len = sizeof(src);
+    if (recvfrom(fd, &req, sizeof(req), 0, (struct sockaddr*)&src, &src_len) != sizeof(req)) {
+      continue;
+    }
+    memset(&resp, 0, sizeof(resp));
+    resp.header.teid_present = true;
+    if (req.header.type == srsran::GTPC_MSG_TYPE_CREATE_SESSION_REQUEST) {
+      // The S-GW uses the control TEID of the MME as its own
+      const srsran::gtpc_create_session_request& cs_req = req.choice.create_session_request;
+      srsran::gtpc_create_session_response&      cs_resp = resp.choice.create_session_response;
+      uint32_t                                   teid    = cs_req.sender_f_teid.teid;
+      resp.header.teid                                   = teid;
+      resp.header.type                                   = srsran::GTPC_MSG_TYPE_CREATE_SESSION_RESPONSE;
+      cs_resp.cause.cause_value                          = srsran::GTPC_CAUSE_VALUE_REQUEST_ACCEPTED;
+      cs_resp.eps_bearer_context_created.ebi             = cs_req.eps_bearer_context_created.ebi;
+      cs_resp.eps_bearer_context_created.s1_u_sgw_f_teid_present = true;
+      cs_resp.eps_bearer_context_created.s1_u_sgw_f_teid.teid    = teid;
+      cs_resp.eps_bearer_context_created.s1_u_sgw_f_teid.ipv4    = htonl(INADDR_LOOPBACK);
+      cs_resp.paa_present                                        = true;
+      cs_resp.paa.pdn_type                                       = srsran::GTPC_PDN_TYPE_IPV4;
+      cs_resp.paa.ipv4                                           = htonl(0xac100000 + teid);
+    } else if (req.header.type == srsran::GTPC_MSG_TYPE_MODIFY_BEARER_REQUEST) {
+      resp.header.teid = req.header.teid;
+      resp.header.type = srsran::GTPC_MSG_TYPE_MODIFY_BEARER_RESPONSE;
+      srsran::gtpc_modify_bearer_response& mb_resp = resp.choice.modify_bearer_response;
+      mb_resp.cause.cause_value                    = srsran::GTPC_CAUSE_VALUE_REQUEST_ACCEPTED;
+      mb_resp.eps_bearer_context_modified.ebi      = req.choice.modify_bearer_request.eps_bearer_context_to_modify.ebi;
+      mb_resp.eps_bearer_context_modified.cause.cause_value = srsran::GTPC_CAUSE_VALUE_REQUEST_ACCEPTED;
+    } else {
+      continue;
+    }
+    sendto(fd, &resp, sizeof(resp), 0, (struct sockaddr*)&src, src_len);
+  }
+}
+
+/*
+ * eNB emulator, with the NAS of its UEs
+ */
+struct bench_ue_t {
+  uint64_t                              imsi           = 0;
+  uint32_t                              user_idx       = 0;
+  uint32_t                              mme_ue_s1ap_id = 0;
+  uint8_t                               k_asme[32]     = {};
+  uint8_t                               k_nas_enc[32]  = {};
+  uint8_t                               k_nas_int[32]  = {};
+  std::chrono::steady_clock::time_point t_start;
+};
+
+class bench_enb
+{
+public:
+  explicit bench_enb(uint32_t id_) : id(id_) {}
+  ~bench_enb()
+  {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+
+  bool connect_s1();
+  bool run_attaches();
+
+  uint32_t            nof_attached = 0;
+  uint32_t            nof_failed   = 0;
+  std::vector<double> latencies_us;
+
+private:
+  bool send_s1ap(const s1ap_pdu_c& pdu, uint16_t stream);
+  bool recv_s1ap(s1ap_pdu_c& pdu);
+  bool send_ul_nas(uint32_t ue_idx, srsran::byte_buffer_t* nas_pdu);
+  void integrity_protect(const bench_ue_t& ue, uint32_t count, srsran::byte_buffer_t* nas_pdu);
+
+  bool start_attach(uint32_t ue_idx);
+  bool handle_dl_nas(uint32_t ue_idx, const asn1::unbounded_octstring<true>& nas);
+  bool handle_init_context_setup_request(uint32_t ue_idx);
+  void finish_attach(uint32_t ue_idx, bool success);
+
+  uint32_t                id;
+  int                     fd = -1;
+  std::vector<bench_ue_t> ues;
+  uint32_t                nof_done = 0;
+  uint32_t                next_ue  = 0;
+};
+
+bool bench_enb::send_s1ap(const s1ap_pdu_c& pdu, uint16_t stream)
+{
+  srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+  if (buf == nullptr) {
+    return false;
+  }
+  asn1::bit_ref bref(buf->msg, buf->get_tailroom());
+  if (pdu.pack(bref) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  buf->N_bytes = bref.distance_bytes();
+  ssize_t n    = sctp_sendmsg(fd, buf->msg, buf->N_bytes, NULL, 0, htonl(s1ap_ppid), 0, stream, 0, 0);
+  return n == (ssize_t)buf->N_bytes;
+}
+
+bool bench_enb::recv_s1ap(s1ap_pdu_c& pdu)
+{
+  srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+  if (buf == nullptr) {
+    return false;
+  }
+  while (true) {
+    struct sctp_sndrcvinfo sri       = {};
+    int                    msg_flags = 0;
+    int n = sctp_recvmsg(fd, buf->msg, buf->get_tailroom(), NULL, NULL, &sri, &msg_flags);
+    if (n <= 0) {
+      fprintf(stderr, "eNB %d: no S1AP message from the MME\n", id);
+      return false;
+    }
+    if (msg_flags & MSG_NOTIFICATION) {
+      continue;
+    }
+    asn1::cbit_ref bref(buf->msg, n);
+    return pdu.unpack(bref) == asn1::SRSASN_SUCCESS;
+  }
+}
+
+bool bench_enb::connect_s1()
+{
+  fd = socket(AF_INET, SOCK_SEQPACKET, IPPROTO_SCTP);
+  if (fd < 0) {
+    perror("socket");
+    return false;
+  }
+  struct timeval tv = {rx_timeout_sec, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+  struct sockaddr_in mme_addr = {};
+  mme_addr.sin_family         = AF_INET;
+  mme_addr.sin_port           = htons(S1MME_PORT);
+  inet_pton(AF_INET, mme_bind_addr, &mme_addr.sin_addr);
+  if (connect(fd, (struct sockaddr*)&mme_addr, sizeof(mme_addr)) < 0) {
+    perror("connect");
+    return false;
+  }
+
+  uint32_t plmn;
+  srsran::s1ap_mccmnc_to_plmn(mcc, mnc, &plmn);
+  plmn = htonl(plmn);
+
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_S1_SETUP);
+  s1_setup_request_ies_container& container = pdu.init_msg().value.s1_setup_request().protocol_ies;
+  container.global_enb_id.value.plm_nid[0]  = ((uint8_t*)&plmn)[1];
+  container.global_enb_id.value.plm_nid[1]  = ((uint8_t*)&plmn)[2];
+  container.global_enb_id.value.plm_nid[2]  = ((uint8_t*)&plmn)[3];
+  container.global_enb_id.value.enb_id.set_macro_enb_id().from_number(0x19b + id);
+  container.supported_tas.value.resize(1);
+  uint16_t tmp16 = htons(tac);
+  memcpy(container.supported_tas.value[0].tac.data(), (uint8_t*)&tmp16, 2);
+  container.supported_tas.value[0].broadcast_plmns.resize(1);
+  container.supported_tas.value[0].broadcast_plmns[0][0] = ((uint8_t*)&plmn)[1];
+  container.supported_tas.value[0].broadcast_plmns[0][1] = ((uint8_t*)&plmn)[2];
+  container.supported_tas.value[0].broadcast_plmns[0][2] = ((uint8_t*)&plmn)[3];
+  container.default_paging_drx.value.value = asn1::s1ap::paging_drx_opts::v128;
+  if (not send_s1ap(pdu, 0)) {
+    return false;
+  }
+
+  s1ap_pdu_c resp;
+  using successful_outcome_type_opts_t = s1ap_elem_procs_o::successful_outcome_c::types_opts;
+  return recv_s1ap(resp) and resp.type().value == s1ap_pdu_c::types_opts::successful_outcome and
+         resp.successful_outcome().value.type().value == successful_outcome_type_opts_t::s1_setup_resp;
+}
+
+bool bench_enb::send_ul_nas(uint32_t ue_idx, srsran::byte_buffer_t* nas_pdu)
+{
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_UL_NAS_TRANSPORT);
+  ul_nas_transport_ies_container& container = pdu.init_msg().value.ul_nas_transport().protocol_ies;
+  container.mme_ue_s1ap_id.value            = ues[ue_idx].mme_ue_s1ap_id;
+  container.enb_ue_s1ap_id.value            = ue_idx;
+  container.nas_pdu.value.resize(nas_pdu->N_bytes);
+  memcpy(container.nas_pdu.value.data(), nas_pdu->msg, nas_pdu->N_bytes);
+  return send_s1ap(pdu, 1);
+}
+
+void bench_enb::integrity_protect(const bench_ue_t& ue, uint32_t count, srsran::byte_buffer_t* nas_pdu)
+{
+  srsran::security_128_eia2(&ue.k_nas_int[16],
+                            count,
+                            0,
+                            srsran::SECURITY_DIRECTION_UPLINK,
+                            &nas_pdu->msg[5],
+                            nas_pdu->N_bytes - 5,
+                            &nas_pdu->msg[1]);
+}
+
+bool bench_enb::start_attach(uint32_t ue_idx)
+{
+  bench_ue_t& ue = ues[ue_idx];
+  ue.t_start     = std::chrono::steady_clock::now();
+
+  LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT attach_req = {};
+  attach_req.eps_attach_type                      = LIBLTE_MME_EPS_ATTACH_TYPE_EPS_ATTACH;
+  for (uint32_t i = 0; i < 3; i++) {
+    attach_req.ue_network_cap.eea[i] = true;
+    attach_req.ue_network_cap.eia[i] = true;
+  }
+  attach_req.eps_mobile_id.type_of_id = LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI;
+  uint64_t imsi                       = ue.imsi;
+  for (int i = 14; i >= 0; i--) {
+    attach_req.eps_mobile_id.imsi[i] = imsi % 10;
+    imsi /= 10;
+  }
+  LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT pdn_con_req = {};
+  pdn_con_req.proc_transaction_id                            = 1;
+  pdn_con_req.request_type                                   = LIBLTE_MME_REQUEST_TYPE_INITIAL_REQUEST;
+  pdn_con_req.pdn_type                                       = LIBLTE_MME_PDN_TYPE_IPV4;
+  liblte_mme_pack_pdn_connectivity_request_msg(&pdn_con_req, &attach_req.esm_msg);
+
+  srsran::unique_byte_buffer_t nas_pdu = srsran::make_byte_buffer();
+  if (nas_pdu == nullptr) {
+    return false;
+  }
+  liblte_mme_pack_attach_request_msg(&attach_req, srsran::liblte_byte_msg_adapter(nas_pdu.get()));
+
+  uint32_t plmn;
+  srsran::s1ap_mccmnc_to_plmn(mcc, mnc, &plmn);
+
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_INIT_UE_MSG);
+  init_ue_msg_ies_container& container = pdu.init_msg().value.init_ue_msg().protocol_ies;
+  container.enb_ue_s1ap_id.value       = ue_idx;
+  container.nas_pdu.value.resize(nas_pdu->N_bytes);
+  memcpy(container.nas_pdu.value.data(), nas_pdu->msg, nas_pdu->N_bytes);
+  container.tai.value.plm_nid.from_number(plmn);
+  container.tai.value.tac.from_number(tac);
+  container.eutran_cgi.value.plm_nid.from_number(plmn);
+  container.eutran_cgi.value.cell_id.from_number(((0x19b + id) << 8u) + 1);
+  container.rrc_establishment_cause.value = asn1::s1ap::rrc_establishment_cause_opts::mo_sig;
+  return send_s1ap(pdu, 1);
+}
+
+bool bench_enb::handle_dl_nas(uint32_t ue_idx, const asn1::unbounded_octstring<true>& nas)
+{
+  bench_ue_t&                  ue     = ues[ue_idx];
+  srsran::unique_byte_buffer_t nas_rx = srsran::make_byte_buffer();
+  srsran::unique_byte_buffer_t nas_tx = srsran::make_byte_buffer();
+  if (nas_rx == nullptr || nas_tx == nullptr) {
+    return false;
+  }
+  memcpy(nas_rx->msg, nas.data(), nas.size());
+  nas_rx->N_bytes = nas.size();
+
+  uint8_t pd, msg_type;
+  liblte_mme_parse_msg_header(srsran::liblte_byte_msg_adapter(nas_rx.get()), &pd, &msg_type);
+  switch (msg_type) {
+    case LIBLTE_MME_MSG_TYPE_AUTHENTICATION_REQUEST: {
+      LIBLTE_MME_AUTHENTICATION_REQUEST_MSG_STRUCT auth_req = {};
+      liblte_mme_unpack_authentication_request_msg(srsran::liblte_byte_msg_adapter(nas_rx.get()), &auth_req);
+
+      uint8_t k[16], op[16], res[16], ck[16], ik[16], ak[6];
+      user_key(ue.user_idx, k);
+      memcpy(op, opc, sizeof(op));
+      srsran::security_milenage_f2345(k, op, auth_req.rand, res, ck, ik, ak);
+      // AUTN starts with SQN xor AK
+      srsran::security_generate_k_asme(ck, ik, auth_req.autn, mcc, mnc, ue.k_asme);
+
+      LIBLTE_MME_AUTHENTICATION_RESPONSE_MSG_STRUCT auth_res = {};
+      memcpy(auth_res.res, res, 8);
+      auth_res.res_len = 8;
+      liblte_mme_pack_authentication_response_msg(&auth_res,
+                                                  LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS,
+                                                  0,
+                                                  srsran::liblte_byte_msg_adapter(nas_tx.get()));
+      return send_ul_nas(ue_idx, nas_tx.get());
+    }
+    case LIBLTE_MME_MSG_TYPE_SECURITY_MODE_COMMAND: {
+      srsran::security_generate_k_nas(
+          ue.k_asme, srsran::CIPHERING_ALGORITHM_ID_EEA0, integ_algo, ue.k_nas_enc, ue.k_nas_int);
+      LIBLTE_MME_SECURITY_MODE_COMPLETE_MSG_STRUCT sm_comp = {};
+      liblte_mme_pack_security_mode_complete_msg(
+          &sm_comp,
+          LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED_WITH_NEW_EPS_SECURITY_CONTEXT,
+          0,
+          srsran::liblte_byte_msg_adapter(nas_tx.get()));
+      integrity_protect(ue, 0, nas_tx.get());
+      return send_ul_nas(ue_idx, nas_tx.get());
+    }
+    case LIBLTE_MME_MSG_TYPE_EMM_INFORMATION:
+      // Last message of the attach
+      finish_attach(ue_idx, true);
+      return true;
+    default:
+      fprintf(stderr, "eNB %d: unexpected NAS message 0x%x for IMSI %015" PRIu64 "\n", id, msg_type, ue.imsi);
+      finish_attach(ue_idx, false);
+      return true;
+  }
+}
+
+bool bench_enb::handle_init_context_setup_request(uint32_t ue_idx)
+{
+  bench_ue_t& ue = ues[ue_idx];
+
+  // Initial Context Setup Response for the default bearer
+  s1ap_pdu_c pdu;
+  pdu.set_successful_outcome().load_info_obj(ASN1_S1AP_ID_INIT_CONTEXT_SETUP);
+  init_context_setup_resp_ies_container& container =
+      pdu.successful_outcome().value.init_context_setup_resp().protocol_ies;
+  container.mme_ue_s1ap_id.value = ue.mme_ue_s1ap_id;
+  container.enb_ue_s1ap_id.value = ue_idx;
+  container.erab_setup_list_ctxt_su_res.value.resize(1);
+  container.erab_setup_list_ctxt_su_res.value[0].load_info_obj(ASN1_S1AP_ID_ERAB_SETUP_ITEM_CTXT_SU_RES);
+  erab_setup_item_ctxt_su_res_s& item =
+      container.erab_setup_list_ctxt_su_res.value[0].value.erab_setup_item_ctxt_su_res();
+  item.erab_id = 5;
+  item.transport_layer_address.resize(32);
+  item.transport_layer_address.from_number(INADDR_LOOPBACK);
+  item.gtp_teid.from_number((id << 24u) + ue_idx);
+  if (not send_s1ap(pdu, 1)) {
+    return false;
+  }
+
+  // Attach Complete, with the accept of the default bearer
+  LIBLTE_MME_ATTACH_COMPLETE_MSG_STRUCT                            attach_comp = {};
+  LIBLTE_MME_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_ACCEPT_MSG_STRUCT act_accept  = {};
+  act_accept.eps_bearer_id                                                     = 5;
+  act_accept.proc_transaction_id                                               = 1;
+  liblte_mme_pack_activate_default_eps_bearer_context_accept_msg(&act_accept, &attach_comp.esm_msg);
+
+  srsran::unique_byte_buffer_t nas_tx = srsran::make_byte_buffer();
+  if (nas_tx == nullptr) {
+    return false;
+  }
+  liblte_mme_pack_attach_complete_msg(&attach_comp,
+                                      LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED,
+                                      1,
+                                      srsran::liblte_byte_msg_adapter(nas_tx.get()));
+  integrity_protect(ue, 1, nas_tx.get());
+  return send_ul_nas(ue_idx, nas_tx.get());
+}
+
+void bench_enb::finish_attach(uint32_t ue_idx, bool success)
+{
+  if (success) {
+    nof_attached++;
+    latencies_us.push_back(
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - ues[ue_idx].t_start).count());
+  } else {
+    nof_failed++;
+  }
+  nof_done++;
+  if (next_ue < ues.size()) {
+    start_attach(next_ue++);
+  }
+}
+
+bool bench_enb::run_attaches()
+{
+  // The UEs of all the eNBs are interleaved in the user DB
+  for (uint32_t user_idx = id; user_idx < nof_ues; user_idx += nof_enbs) {
+    bench_ue_t ue;
+    ue.imsi     = first_imsi + user_idx;
+    ue.user_idx = user_idx;
+    ues.push_back(ue);
+  }
+  latencies_us.reserve(ues.size());
+
+  while (next_ue < std::min<uint32_t>(window, ues.size())) {
+    if (not start_attach(next_ue++)) {
+      return false;
+    }
+  }
+
+  using init_msg_type_opts_t = s1ap_elem_procs_o::init_msg_c::types_opts;
+  while (nof_done < ues.size()) {
+    s1ap_pdu_c pdu;
+    if (not recv_s1ap(pdu)) {
+      return false;
+    }
+    if (pdu.type().value != s1ap_pdu_c::types_opts::init_msg) {
+      continue;
+    }
+    const init_msg_s& msg = pdu.init_msg();
+    if (msg.value.type().value == init_msg_type_opts_t::dl_nas_transport) {
+      const dl_nas_transport_ies_container& dl_nas = msg.value.dl_nas_transport().protocol_ies;
+      uint32_t                              ue_idx = dl_nas.enb_ue_s1ap_id.value.value;
+      if (ue_idx >= ues.size()) {
+        continue;
+      }
+      ues[ue_idx].mme_ue_s1ap_id = dl_nas.mme_ue_s1ap_id.value.value;
+      if (not handle_dl_nas(ue_idx, dl_nas.nas_pdu.value)) {
+        return false;
+      }
+    } else if (msg.value.type().value == init_msg_type_opts_t::init_context_setup_request) {
+      uint32_t ue_idx = msg.value.init_context_setup_request().protocol_ies.enb_ue_s1ap_id.value.value;
+      if (ue_idx >= ues.size() or not handle_init_context_setup_request(ue_idx)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static void run_enb(bench_enb* enb, std::atomic<uint32_t>* nof_connected, bool* ok)
+{
+  if (not enb->connect_s1()) {
+    *ok = false;
+    nof_connected->fetch_add(1);
+    return;
+  }
+  // Start the attach storm when all the eNBs are connected
+  nof_connected->fetch_add(1);
+  while (nof_connected->load() < nof_enbs) {
+    usleep(1000);
+  }
+  *ok = enb->run_attaches();
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("S1AP", false).set_level(srslog::basic_levels::error);
+  srslog::fetch_basic_logger("NAS", false).set_level(srslog::basic_levels::error);
+  srslog::fetch_basic_logger("MME GTPC", false).set_level(srslog::basic_levels::error);
+  srslog::fetch_basic_logger("HSS", false).set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  unlink(db_filename.c_str());
+  unlink((db_filename + ".sqn").c_str());
+  TESTASSERT(write_user_db() == SRSRAN_SUCCESS);
+
+  // The MME reports every procedure on the console. Mute it while the attaches run
+  fflush(stdout);
+  int stdout_fd = dup(STDOUT_FILENO);
+  TESTASSERT(freopen("/dev/null", "w", stdout) != nullptr);
+
+  int sgw_fd = open_sgw_socket();
+  TESTASSERT(sgw_fd >= 0);
+  std::thread sgw_thread(run_sgw, sgw_fd);
+
+  hss_args_t hss_args = {};
+  hss_args.db_file    = db_filename;
+  hss_args.mcc        = mcc;
+  hss_args.mnc        = mnc;
+  hss*       h        = hss::get_instance();
+  TESTASSERT(h->init(&hss_args) == SRSRAN_SUCCESS);
+
+  mme_args_t mme_args                = {};
+  mme_args.s1ap_args.mme_code        = 0x1a;
+  mme_args.s1ap_args.mme_group       = 1;
+  mme_args.s1ap_args.tac             = tac;
+  mme_args.s1ap_args.mcc             = mcc;
+  mme_args.s1ap_args.mnc             = mnc;
+  mme_args.s1ap_args.paging_timer    = 2;
+  mme_args.s1ap_args.mme_bind_addr   = mme_bind_addr;
+  mme_args.s1ap_args.mme_name        = "srsmme01";
+  mme_args.s1ap_args.dns_addr        = "8.8.8.8";
+  mme_args.s1ap_args.full_net_name   = "Software Radio Systems RAN";
+  mme_args.s1ap_args.short_net_name  = "srsRAN";
+  mme_args.s1ap_args.mme_apn         = "srsapn";
+  mme_args.s1ap_args.encryption_algo = srsran::CIPHERING_ALGORITHM_ID_EEA0;
+  mme_args.s1ap_args.integrity_algo  = integ_algo;
+  mme_args.s1ap_args.nof_workers     = nof_workers;
+  mme* m                             = mme::get_instance();
+  TESTASSERT(m->init(&mme_args) == SRSRAN_SUCCESS);
+  m->start();
+
+  std::vector<std::unique_ptr<bench_enb> > enbs;
+  std::vector<std::thread>                 enb_threads;
+  std::unique_ptr<bool[]>                  enb_ok(new bool[nof_enbs]);
+  std::atomic<uint32_t>                    nof_connected(0);
+  for (uint32_t i = 0; i < nof_enbs; ++i) {
+    enbs.emplace_back(new bench_enb(i));
+  }
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_enbs; ++i) {
+    enb_threads.emplace_back(run_enb, enbs[i].get(), &nof_connected, &enb_ok[i]);
+  }
+  for (std::thread& t : enb_threads) {
+    t.join();
+  }
+  double elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  m->stop();
+  mme::cleanup();
+  h->stop();
+  hss::cleanup();
+  sgw_running = false;
+  sgw_thread.join();
+  close(sgw_fd);
+
+  fflush(stdout);
+  dup2(stdout_fd, STDOUT_FILENO);
+  close(stdout_fd);
+
+  uint32_t            nof_attached = 0, nof_failed = 0;
+  std::vector<double> latencies_us;
+  for (uint32_t i = 0; i < nof_enbs; ++i) {
+    TESTASSERT(enb_ok[i]);
+    nof_attached += enbs[i]->nof_attached;
+    nof_failed += enbs[i]->nof_failed;
+    latencies_us.insert(latencies_us.end(), enbs[i]->latencies_us.begin(), enbs[i]->latencies_us.end());
+  }
+  TESTASSERT(nof_failed == 0);
+  TESTASSERT(nof_attached == nof_ues);
+  std::sort(latencies_us.begin(), latencies_us.end());
+  double mean_us = 0;
+  for (double l : latencies_us) {
+    mean_us += l;
+  }
+  mean_us /= latencies_us.size();
+
+  printf("eNBs: %d, UEs: %d, attaches in progress per eNB: %d, S1AP workers: %d\n",
+         nof_enbs,
+         nof_ues,
+         window,
+         nof_workers);
+  printf("Attach rate:           %.0f attaches/s\n", nof_attached / elapsed_s);
+  printf("Attach latency, mean:  %.2f ms\n", mean_us / 1000);
+  printf("Attach latency, p99:   %.2f ms\n", latencies_us[latencies_us.size() * 99 / 100] / 1000);
+
+  unlink(db_filename.c_str());
+  unlink((db_filename + ".sqn").c_str());
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
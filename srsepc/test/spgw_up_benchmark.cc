@@ -0,0 +1,385 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/spgw/gtpu_up_worker.h"
+#include "srsran/common/int_helpers.h"
+#include "srsran/common/test_common.h"
+#include "srsran/upper/gtpu.h"
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <getopt.h>
+#include <linux/ip.h>
+#include <memory>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <unistd.h>
+
+/*
+ * Loopback benchmark of the SP-GW user-plane workers. The S1-U side uses real UDP sockets on the loopback interface,
+ * and each SGi TUN queue is replaced by a datagram socket pair, so that no privileges are needed. For each number of
+ * workers, uplink (S1-U -> SGi) and downlink (SGi -> S1-U) traffic is generated separately and the packets forwarded
+ * by the workers are counted.
+ */
+
+using namespace srsepc;
+
+static uint32_t max_workers = 4;
+static uint32_t nof_ues     = 64;
+static uint32_t duration_ms = 1000;
+static uint32_t pdu_len     = 1000;
+
+static void usage(const char* prog)
+{
+  printf("Usage: %s [tuds]\n", prog);
+  printf("\t-t Maximum number of user-plane workers [Default %d]\n", max_workers);
+  printf("\t-u Number of UEs [Default %d]\n", nof_ues);
+  printf("\t-d Duration of each measurement in ms [Default %d]\n", duration_ms);
+  printf("\t-s IP packet size in bytes [Default %d]\n", pdu_len);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "tuds")) != -1) {
+    switch (opt) {
+      case 't':
+        max_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'u':
+        nof_ues = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'd':
+        duration_ms = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        pdu_len = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (max_workers == 0 or nof_ues == 0 or pdu_len < sizeof(struct iphdr) or
+      pdu_len > SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET - GTPU_EXTENDED_HEADER_LEN) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+static in_addr_t ue_ipv4(uint32_t ue_idx)
+{
+  return htonl(0x0a2d0002 + ue_idx); // 10.45.0.2 onwards
+}
+
+static uint32_t ue_teid(uint32_t ue_idx)
+{
+  return 0x100 + ue_idx;
+}
+
+class dummy_paging_handler : public gtpu_up_paging_handler
+{
+public:
+  void handle_paging_pdu(uint32_t spgw_ctrl_teid, srsran::unique_byte_buffer_t msg) override { nof_paged++; }
+
+  std::atomic<uint32_t> nof_paged = {0};
+};
+
+struct up_test_bench {
+  uint32_t                                     nof_workers = 0;
+  gtpu_tunnel_table                            tunnels;
+  dummy_paging_handler                         paging;
+  std::vector<int>                             s1u_fds;
+  std::vector<std::array<int, 2>>              sgi_pairs;
+  int                                          enb_fd   = -1;
+  struct sockaddr_in                           s1u_addr = {};
+  struct sockaddr_in                           enb_addr = {};
+  std::vector<std::unique_ptr<gtpu_up_worker>> workers;
+  std::atomic<bool>                            draining = {true};
+  std::thread                                  drain_thread;
+
+  ~up_test_bench()
+  {
+    for (auto& w : workers) {
+      w->stop();
+    }
+    draining = false;
+    if (drain_thread.joinable()) {
+      drain_thread.join();
+    }
+    for (int fd : s1u_fds) {
+      close(fd);
+    }
+    for (auto& p : sgi_pairs) {
+      close(p[0]);
+      close(p[1]);
+    }
+    if (enb_fd >= 0) {
+      close(enb_fd);
+    }
+  }
+
+  int init(uint32_t nof_workers_)
+  {
+    nof_workers = nof_workers_;
+
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      srsran::gtp_fteid_t enb_fteid = {};
+      enb_fteid.ipv4                = htonl(INADDR_LOOPBACK);
+      enb_fteid.teid                = ue_teid(i);
+      tunnels.modify(ue_ipv4(i), enb_fteid, 0x1000 + i);
+    }
+
+    // S1-U sockets, one per worker
+    s1u_addr.sin_family      = AF_INET;
+    s1u_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    s1u_addr.sin_port        = 0;
+    if (gtpu_open_s1u_sockets(&s1u_addr, nof_workers, s1u_fds, srslog::fetch_basic_logger("GTPU")) != SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    // eNB side of the downlink
+    enb_fd                   = socket(AF_INET, SOCK_DGRAM, 0);
+    enb_addr.sin_family      = AF_INET;
+    enb_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addrlen        = sizeof(enb_addr);
+    if (enb_fd < 0 or bind(enb_fd, (struct sockaddr*)&enb_addr, sizeof(enb_addr)) < 0 or
+        getsockname(enb_fd, (struct sockaddr*)&enb_addr, &addrlen) < 0) {
+      perror("eNB socket");
+      return SRSRAN_ERROR;
+    }
+
+    // SGi queues
+    for (uint32_t i = 0; i < nof_workers; ++i) {
+      std::array<int, 2> pair;
+      if (socketpair(AF_UNIX, SOCK_DGRAM, 0, pair.data()) < 0) {
+        perror("socketpair");
+        return SRSRAN_ERROR;
+      }
+      sgi_pairs.push_back(pair);
+    }
+
+    for (uint32_t i = 0; i < nof_workers; ++i) {
+      std::unique_ptr<gtpu_up_worker> w(new gtpu_up_worker(i));
+      w->init(s1u_fds[i], sgi_pairs[i][0], &tunnels, &paging, ntohs(enb_addr.sin_port));
+      workers.push_back(std::move(w));
+      if (not workers.back()->start()) {
+        return SRSRAN_ERROR;
+      }
+    }
+
+    drain_thread = std::thread([this]() { drain(); });
+    return SRSRAN_SUCCESS;
+  }
+
+  // Reads everything that comes out of the workers, both at the SGi queues and at the eNB
+  void drain()
+  {
+    std::vector<struct pollfd> fds(nof_workers + 1);
+    for (uint32_t i = 0; i < nof_workers; ++i) {
+      fds[i].fd     = sgi_pairs[i][1];
+      fds[i].events = POLLIN;
+    }
+    fds[nof_workers].fd     = enb_fd;
+    fds[nof_workers].events = POLLIN;
+
+    const uint32_t                                             batch = gtpu_up_worker::max_batch_size;
+    std::vector<uint8_t>                                       buffer(batch * SRSRAN_MAX_BUFFER_SIZE_BYTES);
+    std::array<struct mmsghdr, gtpu_up_worker::max_batch_size> msgs;
+    std::array<struct iovec, gtpu_up_worker::max_batch_size>   iovs;
+    while (draining) {
+      if (poll(fds.data(), fds.size(), 100) <= 0) {
+        continue;
+      }
+      for (auto& pfd : fds) {
+        if (not(pfd.revents & POLLIN)) {
+          continue;
+        }
+        for (uint32_t i = 0; i < batch; ++i) {
+          iovs[i].iov_base           = &buffer[i * SRSRAN_MAX_BUFFER_SIZE_BYTES];
+          iovs[i].iov_len            = SRSRAN_MAX_BUFFER_SIZE_BYTES;
+          msgs[i]                    = {};
+          msgs[i].msg_hdr.msg_iov    = &iovs[i];
+          msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        recvmmsg(pfd.fd, msgs.data(), batch, MSG_DONTWAIT, nullptr);
+      }
+    }
+  }
+
+  uint64_t nof_ul_pdus() const
+  {
+    uint64_t n = 0;
+    for (auto& w : workers) {
+      n += w->get_nof_ul_pdus();
+    }
+    return n;
+  }
+
+  uint64_t nof_dl_pdus() const
+  {
+    uint64_t n = 0;
+    for (auto& w : workers) {
+      n += w->get_nof_dl_pdus();
+    }
+    return n;
+  }
+};
+
+// Sends batches of PDUs to fd until stopped. The PDU builder fills PDU i of the batch and returns its length.
+template <typename F>
+static void generate(int fd, const struct sockaddr_in* dst, std::atomic<bool>& running, F&& build_pdu)
+{
+  const uint32_t                                             batch = gtpu_up_worker::max_batch_size;
+  std::vector<uint8_t>                                       buffer(batch * SRSRAN_MAX_BUFFER_SIZE_BYTES);
+  std::array<struct mmsghdr, gtpu_up_worker::max_batch_size> msgs;
+  std::array<struct iovec, gtpu_up_worker::max_batch_size>   iovs;
+  uint32_t                                                   count = 0;
+  while (running) {
+    for (uint32_t i = 0; i < batch; ++i, ++count) {
+      uint8_t* pdu                = &buffer[i * SRSRAN_MAX_BUFFER_SIZE_BYTES];
+      iovs[i].iov_base            = pdu;
+      iovs[i].iov_len             = build_pdu(pdu, count);
+      msgs[i]                     = {};
+      msgs[i].msg_hdr.msg_name    = (void*)dst;
+      msgs[i].msg_hdr.msg_namelen = dst != nullptr ? sizeof(struct sockaddr_in) : 0;
+      msgs[i].msg_hdr.msg_iov     = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen  = 1;
+    }
+    if (sendmmsg(fd, msgs.data(), batch, MSG_DONTWAIT) < 0) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+static uint32_t build_ip_pdu(uint8_t* pdu, uint32_t ue_idx)
+{
+  memset(pdu, 0, pdu_len);
+  struct iphdr* iph = (struct iphdr*)pdu;
+  iph->version      = 4;
+  iph->ihl          = 5;
+  iph->tot_len      = htons(pdu_len);
+  iph->saddr        = htonl(0x08080808);
+  iph->daddr        = ue_ipv4(ue_idx);
+  return pdu_len;
+}
+
+static uint32_t build_gtpu_pdu(uint8_t* pdu, uint32_t ue_idx)
+{
+  build_ip_pdu(pdu + GTPU_BASE_HEADER_LEN, ue_idx);
+  pdu[0] = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+  pdu[1] = GTPU_MSG_DATA_PDU;
+  srsran::uint16_to_uint8(pdu_len, &pdu[2]);
+  srsran::uint32_to_uint8(ue_teid(ue_idx), &pdu[4]);
+  return pdu_len + GTPU_BASE_HEADER_LEN;
+}
+
+// Runs the generators for duration_ms and returns the number of PDUs per second forwarded by the workers
+template <typename Gen, typename Counter>
+static double measure_pps(uint32_t nof_generators, Gen&& gen, Counter&& counter)
+{
+  std::atomic<bool>        running = {true};
+  std::vector<std::thread> generators;
+  for (uint32_t i = 0; i < nof_generators; ++i) {
+    generators.emplace_back([&gen, &running, i]() { gen(i, running); });
+  }
+
+  // Let the pipeline fill up before measuring
+  std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms / 10));
+  uint64_t start_count = counter();
+  auto     t_start     = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+  uint64_t end_count = counter();
+  auto     t_end     = std::chrono::steady_clock::now();
+
+  running = false;
+  for (auto& t : generators) {
+    t.join();
+  }
+
+  double elapsed_s = std::chrono::duration<double>(t_end - t_start).count();
+  return (end_count - start_count) / elapsed_s;
+}
+
+static int run_bench(uint32_t nof_workers, double& ul_pps, double& dl_pps)
+{
+  up_test_bench bench;
+  if (bench.init(nof_workers) != SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // Uplink: eNBs send GTP-U PDUs to the S1-U address, which the kernel steers to the workers by TEID
+  int ul_fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (ul_fd < 0) {
+    perror("socket");
+    return SRSRAN_ERROR;
+  }
+  ul_pps = measure_pps(
+      nof_workers,
+      [&](uint32_t gen_idx, std::atomic<bool>& running) {
+        generate(ul_fd, &bench.s1u_addr, running, [gen_idx, nof_workers](uint8_t* pdu, uint32_t count) {
+          return build_gtpu_pdu(pdu, (count * nof_workers + gen_idx) % nof_ues);
+        });
+      },
+      [&bench]() { return bench.nof_ul_pdus(); });
+  close(ul_fd);
+
+  // Downlink: each generator feeds the SGi queue of one worker
+  dl_pps = measure_pps(
+      nof_workers,
+      [&](uint32_t gen_idx, std::atomic<bool>& running) {
+        generate(bench.sgi_pairs[gen_idx][1], nullptr, running, [](uint8_t* pdu, uint32_t count) {
+          return build_ip_pdu(pdu, count % nof_ues);
+        });
+      },
+      [&bench]() { return bench.nof_dl_pdus(); });
+
+  TESTASSERT(bench.paging.nof_paged == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("GTPU", false).set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  printf("%8s  %14s  %10s  %14s  %10s\n", "Workers", "UL (pkt/s)", "UL (Mbps)", "DL (pkt/s)", "DL (Mbps)");
+  for (uint32_t nof_workers = 1; nof_workers <= max_workers; ++nof_workers) {
+    double ul_pps = 0, dl_pps = 0;
+    if (run_bench(nof_workers, ul_pps, dl_pps) != SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    printf("%8d  %14.0f  %10.1f  %14.0f  %10.1f\n",
+           nof_workers,
+           ul_pps,
+           ul_pps * pdu_len * 8 / 1e6,
+           dl_pps,
+           dl_pps * pdu_len * 8 / 1e6);
+    TESTASSERT(ul_pps > 0 and dl_pps > 0);
+  }
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
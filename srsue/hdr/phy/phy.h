@@ -76,8 +76,8 @@ private:
 class phy final : public ue_lte_phy_base, public ue_nr_phy_base, public srsran::thread
 {
 public:
-  explicit phy() :
-    logger_phy(srslog::fetch_basic_logger("PHY")),
+  explicit phy(const std::string& log_id_preamble = "") :
+    logger_phy(srslog::fetch_basic_logger(log_id_preamble + "PHY")),
     logger_phy_lib(srslog::fetch_basic_logger("PHY_LIB")),
     lte_workers(MAX_WORKERS),
     nr_workers(MAX_WORKERS),
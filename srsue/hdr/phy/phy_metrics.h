@@ -170,6 +170,12 @@ private:
 
 #undef PHY_METRICS_SET
 
+/// LDPC decoders cached by the NR PHY, which are shared by the whole process
+struct ldpc_cache_metrics_t {
+  uint32_t nof_decoders = 0;
+  uint64_t nbytes       = 0; ///< Resident memory of the cached decoders
+};
+
 struct phy_metrics_t {
   info_metrics_t::array_t info          = {};
   sync_metrics_t::array_t sync          = {};
@@ -177,6 +183,7 @@ struct phy_metrics_t {
   dl_metrics_t::array_t   dl            = {};
   ul_metrics_t::array_t   ul            = {};
   uint32_t                nof_active_cc = 0;
+  ldpc_cache_metrics_t    ldpc_cache    = {}; ///< Only filled by the NR PHY
 };
 
 } // namespace srsue
@@ -27,6 +27,7 @@
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/timers.h"
 #include "srsue/hdr/stack/mac_common/mac_common.h"
+#include <deque>
 
 /* Downlink HARQ entity as defined in 5.3.2 of 36.321 */
 
@@ -35,7 +36,7 @@ namespace srsue {
 class dl_harq_entity
 {
 public:
-  dl_harq_entity(uint8_t cc_idx_);
+  dl_harq_entity(uint8_t cc_idx_, srslog::basic_logger& logger_);
 
   bool init(ue_rnti* rntis, demux* demux_unit);
   void reset();
@@ -54,7 +55,7 @@ private:
   class dl_harq_process
   {
   public:
-    dl_harq_process();
+    explicit dl_harq_process(srslog::basic_logger& logger_);
     bool init(int pid, dl_harq_entity* parent);
     void reset(void);
     void reset_ndi();
@@ -70,7 +71,7 @@ private:
     class dl_tb_process
     {
     public:
-      dl_tb_process(void);
+      explicit dl_tb_process(srslog::basic_logger& logger_);
       ~dl_tb_process();
 
       bool init(int pid, dl_harq_entity* parent, uint32_t tb_idx);
@@ -109,7 +110,7 @@ private:
     };
 
     /* Transport blocks */
-    std::vector<dl_tb_process> subproc;
+    std::deque<dl_tb_process> subproc;
   };
 
   // Private members of dl_harq_entity
@@ -118,7 +119,7 @@ private:
 
   dl_sps dl_sps_assig;
 
-  std::vector<dl_harq_process> proc;
+  std::deque<dl_harq_process> proc;
   dl_harq_process              bcch_proc;
   demux*                       demux_unit = nullptr;
   srslog::basic_logger&        logger;
@@ -28,6 +28,7 @@
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/timers.h"
 #include "ul_sps.h"
+#include <deque>
 
 using namespace srsran;
 
@@ -36,7 +37,7 @@ namespace srsue {
 class ul_harq_entity
 {
 public:
-  ul_harq_entity(const uint8_t cc_idx_);
+  ul_harq_entity(const uint8_t cc_idx_, srslog::basic_logger& logger_);
 
   bool init(ue_rnti* rntis_, ra_proc* ra_proc_h_, mux* mux_unit_);
 
@@ -56,7 +57,7 @@ private:
   class ul_harq_process
   {
   public:
-    ul_harq_process();
+    explicit ul_harq_process(srslog::basic_logger& logger_);
     ~ul_harq_process();
 
     bool init(uint32_t pid_, ul_harq_entity* parent);
@@ -148,7 +149,7 @@ private:
 
   ul_sps ul_sps_assig;
 
-  std::vector<ul_harq_process> proc;
+  std::deque<ul_harq_process> proc;
 
   mux*                  mux_unit = nullptr;
   srsran::mac_pcap*     pcap     = nullptr;
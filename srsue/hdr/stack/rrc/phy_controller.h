@@ -57,7 +57,8 @@ public:
 
   explicit phy_controller(phy_interface_rrc_lte*                        phy_,
                           srsran::task_sched_handle                     task_sched_,
-                          std::function<void(uint32_t, uint32_t, bool)> on_cell_selection = {});
+                          std::function<void(uint32_t, uint32_t, bool)> on_cell_selection = {},
+                          srslog::basic_logger&                         logger_ = srslog::fetch_basic_logger("RRC"));
 
   // PHY procedures interfaces
   bool start_cell_select(const phy_cell_t& phy_cell, srsran::event_observer<bool> observer = {});
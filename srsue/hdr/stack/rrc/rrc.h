@@ -63,7 +63,9 @@ class rrc : public rrc_interface_nas,
             public srsran::timer_callback
 {
 public:
-  rrc(stack_interface_rrc* stack_, srsran::task_sched_handle task_sched_);
+  rrc(stack_interface_rrc*      stack_,
+      srsran::task_sched_handle task_sched_,
+      srslog::basic_logger&     logger_ = srslog::fetch_basic_logger("RRC"));
   ~rrc();
 
   void init(phy_interface_rrc_lte* phy_,
@@ -43,7 +43,9 @@ meas_obj_to_add_mod_s* find_meas_obj_map(std::map<uint32_t, meas_obj_to_add_mod_
 class rrc::rrc_meas
 {
 public:
-  rrc_meas() : meas_cfg(&meas_report_list), meas_report_list(&meas_cfg), logger(srslog::fetch_basic_logger("RRC")) {}
+  explicit rrc_meas(srslog::basic_logger& logger_) :
+    meas_cfg(&meas_report_list, logger_), meas_report_list(&meas_cfg, logger_), logger(logger_)
+  {}
   void init(rrc* rrc_ptr);
   void reset();
   bool parse_meas_config(const rrc_conn_recfg_r8_ies_s* meas_config, bool is_ho_reest = false, uint32_t src_earfcn = 0);
@@ -66,7 +68,9 @@ private:
   class var_meas_report_list
   {
   public:
-    var_meas_report_list(var_meas_cfg* meas_cfg_) : meas_cfg(meas_cfg_), logger(srslog::fetch_basic_logger("RRC")) {}
+    var_meas_report_list(var_meas_cfg* meas_cfg_, srslog::basic_logger& logger_) :
+      meas_cfg(meas_cfg_), logger(logger_)
+    {}
     void init(rrc* rrc);
     void generate_report(const uint32_t measId);
     void remove_all_varmeas_reports();
@@ -110,8 +114,8 @@ private:
   class var_meas_cfg
   {
   public:
-    var_meas_cfg(var_meas_report_list* meas_report_) :
-      meas_report(meas_report_), logger(srslog::fetch_basic_logger("RRC"))
+    var_meas_cfg(var_meas_report_list* meas_report_, srslog::basic_logger& logger_) :
+      meas_report(meas_report_), logger(logger_)
     {}
     void                             init(rrc* rrc);
     void                             reset();
@@ -62,7 +62,7 @@ class ue_stack_lte final : public ue_stack_base,
                            public srsran::thread
 {
 public:
-  explicit ue_stack_lte();
+  explicit ue_stack_lte(const std::string& log_id_preamble = "");
   ~ue_stack_lte();
 
   std::string get_type() final;
@@ -170,6 +170,7 @@ public:
 
   // Interface for GW
   void write_sdu(uint32_t eps_bearer_id, srsran::unique_byte_buffer_t sdu) final;
+  void write_sdu_batch(uint32_t eps_bearer_id, sdu_batch_t& sdus) final;
   bool has_active_radio_bearer(uint32_t eps_bearer_id) final;
 
   // Interface for RRC
@@ -23,22 +23,24 @@
 #define SRSUE_GW_H
 
 #include "gw_metrics.h"
+#include "srsran/adt/circular_buffer.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/interfaces_common.h"
 #include "srsran/common/threads.h"
 #include "srsran/interfaces/ue_gw_interfaces.h"
+#include "srsran/interfaces/ue_pdcp_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include "tft_packet_filter.h"
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <net/if.h>
 #include <netinet/in.h>
+#include <vector>
 
 namespace srsue {
 
-class stack_interface_gw;
-
 struct gw_args_t {
   struct log_args_t {
     std::string gw_level;
@@ -47,6 +49,7 @@ struct gw_args_t {
   std::string netns;
   std::string tun_dev_name;
   std::string tun_dev_netmask;
+  uint32_t    nof_tun_queues = 1; ///< Number of TUN device queues, each one served by its own reader thread
 };
 
 class gw : public gw_interface_stack, public srsran::thread
@@ -74,7 +77,37 @@ public:
   bool is_running();
 
 private:
-  static const int GW_THREAD_PRIO = -1;
+  static const int      GW_THREAD_PRIO      = -1;
+  static const int      TUN_POLL_TIMEOUT_MS = 100;
+  static const uint32_t DL_QUEUE_SIZE       = 1024;
+
+  using sdu_batch_t = stack_interface_gw::sdu_batch_t;
+
+  /// Reader thread of one of the additional queues of a multi-queue TUN device
+  class tun_queue_reader : public srsran::thread
+  {
+  public:
+    tun_queue_reader(gw* parent_, uint32_t queue_idx, int32_t fd_);
+    ~tun_queue_reader();
+
+  private:
+    void run_thread() override;
+
+    gw*     parent = nullptr;
+    int32_t fd     = -1;
+  };
+
+  /// Writes the DL packets to the TUN device in batches, off the stack thread
+  class tun_writer : public srsran::thread
+  {
+  public:
+    explicit tun_writer(gw* parent_) : thread("GW_TX"), parent(parent_) {}
+
+  private:
+    void run_thread() override { parent->write_tun_batches(); }
+
+    gw* parent = nullptr;
+  };
 
   stack_interface_gw* stack = nullptr;
 
@@ -88,6 +121,12 @@ private:
   int32_t           sock       = 0;
   std::atomic<bool> if_up      = {false};
 
+  bool                                                                       readers_started = false;
+  std::vector<std::unique_ptr<tun_queue_reader> >                            tun_readers;
+  std::unique_ptr<tun_writer>                                                dl_writer;
+  srsran::static_blocking_queue<srsran::unique_byte_buffer_t, DL_QUEUE_SIZE> dl_queue;
+  std::atomic<uint32_t>                                                      dl_dropped_pdus = {0};
+
   static const int NOT_ASSIGNED          = -1;
   int32_t          default_eps_bearer_id = NOT_ASSIGNED;
   std::mutex       gw_mutex;
@@ -102,6 +141,13 @@ private:
   std::chrono::high_resolution_clock::time_point metrics_tp; // stores time when last metrics have been taken
 
   void run_thread();
+  void start_readers();
+  void stop_readers();
+  void read_tun_queue(int32_t fd);
+  bool write_ul_batch(sdu_batch_t& batch);
+  bool wait_service(uint32_t eps_bearer_id);
+  void write_tun(srsran::unique_byte_buffer_t pdu);
+  void write_tun_batches();
   int  init_if(char* err_str);
   int  setup_if_addr4(uint32_t ip_addr, char* err_str);
   int  setup_if_addr6(uint8_t* ipv6_if_id, char* err_str);
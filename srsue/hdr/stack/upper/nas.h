@@ -96,7 +96,7 @@ private:
   bool running = false;
 
   nas_args_t  cfg   = {};
-  emm_state_t state = {};
+  emm_state_t state;
 
   srsran::barring_t current_barring = srsran::barring_t::none;
 
@@ -67,6 +67,8 @@ public:
     imsi_dettach_initiated,
   };
 
+  explicit emm_state_t(srslog::basic_logger& logger_ = srslog::fetch_basic_logger("NAS")) : logger(logger_) {}
+
   // FSM setters
   void set_null();
   void set_deregistered(deregistered_substate_t substate);
@@ -88,7 +90,7 @@ private:
   state_t                 state                 = state_t::null;
   deregistered_substate_t deregistered_substate = deregistered_substate_t::null;
   registered_substate_t   registered_substate   = registered_substate_t::null;
-  srslog::basic_logger&   logger                = srslog::fetch_basic_logger("NAS");
+  srslog::basic_logger&   logger;
 };
 
 const char* emm_state_text(emm_state_t::state_t type);
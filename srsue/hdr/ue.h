@@ -35,6 +35,7 @@
 #include "phy/ue_phy_base.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/radio/radio.h"
+#include "srsran/radio/radio_mux.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/system/sys_metrics_processor.h"
 #include "stack/ue_stack_base.h"
@@ -75,6 +76,7 @@ typedef struct {
   bool        tracing_enable;
   std::string tracing_filename;
   std::size_t tracing_buffcapacity;
+  std::string usim_table_filename;
 } general_args_t;
 
 typedef struct {
@@ -112,11 +114,13 @@ public:
   void radio_overflow();
 
 private:
-  // UE consists of a radio, a PHY and a stack element
-  std::unique_ptr<ue_phy_base>        phy;
-  std::unique_ptr<srsran::radio_base> radio;
-  std::unique_ptr<ue_stack_base>      stack;
-  std::unique_ptr<gw>                 gw_inst;
+  // UE consists of a radio, a PHY and a stack element. When several UEs are emulated, each one has its own PHY and
+  // stack, and they share the radio through a multiplexer
+  std::unique_ptr<srsran::radio_base>          radio;
+  std::unique_ptr<srsran::radio_mux>           radio_mux;
+  std::vector<std::unique_ptr<ue_phy_base> >   phy;
+  std::vector<std::unique_ptr<ue_stack_base> > stack;
+  std::vector<std::unique_ptr<gw> >            gw_inst;
 
   // Generic logger members
   srslog::basic_logger& logger;
@@ -126,8 +130,14 @@ private:
 
   all_args_t args;
 
+  // USIM credentials of each emulated UE, empty if a single UE is run
+  std::vector<usim_args_t> usim_table;
+
   // Helper functions
-  int parse_args(const all_args_t& args); // parse and validate arguments
+  int        parse_args(const all_args_t& args); // parse and validate arguments
+  int        parse_usim_table(const std::string& filename);
+  all_args_t  get_ue_args(uint32_t ue_idx) const;
+  std::string get_log_id_preamble(uint32_t ue_idx) const;
 
   std::string get_build_mode();
   std::string get_build_info();
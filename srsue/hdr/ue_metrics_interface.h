@@ -25,6 +25,7 @@
 #include <stdint.h>
 
 #include "phy/phy_metrics.h"
+#include "srsran/common/buffer_pool.h"
 #include "srsran/common/metrics_hub.h"
 #include "srsran/radio/radio_metrics.h"
 #include "srsran/rlc/rlc_metrics.h"
@@ -37,13 +38,14 @@
 namespace srsue {
 
 typedef struct {
-  uint32_t              ul_dropped_sdus;
-  mac_metrics_t         mac[SRSRAN_MAX_CARRIERS];
-  mac_metrics_t         mac_nr[SRSRAN_MAX_CARRIERS];
-  srsran::rlc_metrics_t rlc;
-  nas_metrics_t         nas;
-  rrc_metrics_t         rrc;
-  rrc_metrics_t         rrc_nr;
+  uint32_t                           ul_dropped_sdus;
+  mac_metrics_t                      mac[SRSRAN_MAX_CARRIERS];
+  mac_metrics_t                      mac_nr[SRSRAN_MAX_CARRIERS];
+  srsran::rlc_metrics_t              rlc;
+  nas_metrics_t                      nas;
+  rrc_metrics_t                      rrc;
+  rrc_metrics_t                      rrc_nr;
+  srsran::byte_buffer_pool_metrics_t pool;
 } stack_metrics_t;
 
 typedef struct {
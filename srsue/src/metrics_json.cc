@@ -76,6 +76,11 @@ DECLARE_METRIC_SET("carrier_container",
                    mset_mac_container);
 DECLARE_METRIC_LIST("carrier_list", mlist_carriers, std::vector<mset_carrier_container>);
 
+/// NR PHY container.
+DECLARE_METRIC("ldpc_cache_decoders", metric_ldpc_cache_decoders, uint32_t, "");
+DECLARE_METRIC("ldpc_cache_kB", metric_ldpc_cache_kB, uint32_t, "");
+DECLARE_METRIC_SET("nr_phy_container", mset_nr_phy_container, metric_ldpc_cache_decoders, metric_ldpc_cache_kB);
+
 /// GW container.
 DECLARE_METRIC_SET("gw_container", mset_gw_container, metric_dl_brate, metric_ul_brate);
 
@@ -129,6 +134,7 @@ DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 using metric_context_t = srslog::build_context_type<metric_type_tag,
                                                     metric_timestamp_tag,
                                                     mlist_carriers,
+                                                    mset_nr_phy_container,
                                                     mset_gw_container,
                                                     mset_rrc_container,
                                                     mlist_neighbours,
@@ -198,6 +204,10 @@ void metrics_json::set_metrics(const ue_metrics_t& metrics, const uint32_t perio
     carrier.get<mset_mac_container>().write<metric_ul_buff>(metrics.stack.mac[i].ul_buffer);
   }
 
+  // Fill NR PHY container.
+  ctx.get<mset_nr_phy_container>().write<metric_ldpc_cache_decoders>(metrics.phy_nr.ldpc_cache.nof_decoders);
+  ctx.get<mset_nr_phy_container>().write<metric_ldpc_cache_kB>(metrics.phy_nr.ldpc_cache.nbytes / 1024);
+
   // Fill GW container.
   ctx.get<mset_gw_container>().write<metric_dl_brate>(metrics.gw.dl_tput_mbps);
   ctx.get<mset_gw_container>().write<metric_ul_brate>(metrics.gw.ul_tput_mbps);
@@ -56,7 +56,7 @@ bool worker_pool::init(phy_common* common, int prio)
 {
   // Add workers to workers pool and start threads
   for (uint32_t i = 0; i < common->args->nof_phy_threads; i++) {
-    srslog::basic_logger& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i));
+    srslog::basic_logger& log = srslog::fetch_basic_logger(fmt::format("{}PHY{}", common->args->log.id_preamble, i));
     log.set_level(srslog::str_to_basic_level(common->args->log.phy_level));
     log.set_hex_dump_max_size(common->args->log.phy_hex_limit);
 
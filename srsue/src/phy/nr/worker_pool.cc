@@ -20,6 +20,7 @@
  */
 #include "srsue/hdr/phy/nr/worker_pool.h"
 #include "srsran/common/band_helper.h"
+#include "srsran/phy/fec/ldpc/ldpc_decoder_cache.h"
 
 namespace srsue {
 namespace nr {
@@ -301,6 +302,9 @@ void worker_pool::clear_pending_grants()
 void worker_pool::get_metrics(phy_metrics_t& m)
 {
   phy_state.get_metrics(m);
+
+  m.ldpc_cache.nof_decoders = srsran_ldpc_decoder_cache_nof_decoders();
+  m.ldpc_cache.nbytes       = srsran_ldpc_decoder_cache_nbytes();
 }
 
 int worker_pool::tx_request(const phy_interface_mac_nr::tx_request_t& request)
@@ -30,9 +30,13 @@
 
 namespace srsue {
 
-dl_harq_entity::dl_harq_entity(uint8_t cc_idx_) :
-  proc(SRSRAN_MAX_HARQ_PROC), logger(srslog::fetch_basic_logger("MAC")), cc_idx(cc_idx_)
-{}
+dl_harq_entity::dl_harq_entity(uint8_t cc_idx_, srslog::basic_logger& logger_) :
+  bcch_proc(logger_), logger(logger_), cc_idx(cc_idx_)
+{
+  for (uint32_t i = 0; i < SRSRAN_MAX_HARQ_PROC; i++) {
+    proc.emplace_back(logger);
+  }
+}
 
 bool dl_harq_entity::init(ue_rnti* rntis_, demux* demux_unit_)
 {
@@ -121,7 +125,12 @@ void dl_harq_entity::set_average_retx(uint32_t n_retx)
   average_retx = SRSRAN_VEC_CMA((float)n_retx, average_retx, nof_pkts++);
 }
 
-dl_harq_entity::dl_harq_process::dl_harq_process() : subproc(SRSRAN_MAX_TB) {}
+dl_harq_entity::dl_harq_process::dl_harq_process(srslog::basic_logger& logger_)
+{
+  for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
+    subproc.emplace_back(logger_);
+  }
+}
 
 bool dl_harq_entity::dl_harq_process::init(int pid, dl_harq_entity* parent)
 {
@@ -175,7 +184,7 @@ bool dl_harq_entity::dl_harq_process::is_sps()
   return false;
 }
 
-dl_harq_entity::dl_harq_process::dl_tb_process::dl_tb_process() : logger(srslog::fetch_basic_logger("MAC"))
+dl_harq_entity::dl_harq_process::dl_tb_process::dl_tb_process(srslog::basic_logger& logger_) : logger(logger_)
 {
   is_initiated = false;
   ack          = false;
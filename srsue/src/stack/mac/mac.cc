@@ -46,8 +46,8 @@ mac::mac(const char* logname, ext_task_sched_handle task_sched_) :
   task_sched(task_sched_)
 {
   // Create PCell HARQ entities
-  ul_harq.at(PCELL_CC_IDX) = ul_harq_entity_ptr(new ul_harq_entity(PCELL_CC_IDX));
-  dl_harq.at(PCELL_CC_IDX) = dl_harq_entity_ptr(new dl_harq_entity(PCELL_CC_IDX));
+  ul_harq.at(PCELL_CC_IDX) = ul_harq_entity_ptr(new ul_harq_entity(PCELL_CC_IDX, logger));
+  dl_harq.at(PCELL_CC_IDX) = dl_harq_entity_ptr(new dl_harq_entity(PCELL_CC_IDX, logger));
 
   srsran_softbuffer_rx_init(&pch_softbuffer, 100);
   srsran_softbuffer_rx_init(&mch_softbuffer, 100);
@@ -128,7 +128,7 @@ void mac::reconfiguration(const uint32_t& cc_idx, const bool& enable)
 {
   if (cc_idx < SRSRAN_MAX_CARRIERS) {
     if (enable and ul_harq.at(cc_idx) == nullptr) {
-      ul_harq_entity_ptr ul = ul_harq_entity_ptr(new ul_harq_entity(cc_idx));
+      ul_harq_entity_ptr ul = ul_harq_entity_ptr(new ul_harq_entity(cc_idx, logger));
       ul->init(&uernti, &ra_procedure, &mux_unit);
       ul->set_config(ul_harq_cfg);
 
@@ -140,7 +140,7 @@ void mac::reconfiguration(const uint32_t& cc_idx, const bool& enable)
     }
 
     if (enable and dl_harq.at(cc_idx) == nullptr) {
-      dl_harq_entity_ptr dl = dl_harq_entity_ptr(new dl_harq_entity(cc_idx));
+      dl_harq_entity_ptr dl = dl_harq_entity_ptr(new dl_harq_entity(cc_idx, logger));
       dl->init(&uernti, &demux_unit);
 
       if (pcap != nullptr) {
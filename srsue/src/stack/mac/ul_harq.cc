@@ -31,9 +31,12 @@
 
 namespace srsue {
 
-ul_harq_entity::ul_harq_entity(const uint8_t cc_idx_) :
-  proc(SRSRAN_MAX_HARQ_PROC), logger(srslog::fetch_basic_logger("MAC")), cc_idx(cc_idx_)
-{}
+ul_harq_entity::ul_harq_entity(const uint8_t cc_idx_, srslog::basic_logger& logger_) : logger(logger_), cc_idx(cc_idx_)
+{
+  for (uint32_t i = 0; i < SRSRAN_MAX_HARQ_PROC; i++) {
+    proc.emplace_back(logger);
+  }
+}
 
 bool ul_harq_entity::init(ue_rnti* rntis_, ra_proc* ra_procedure_, mux* mux_unit_)
 {
@@ -116,7 +119,7 @@ float ul_harq_entity::get_average_retx()
   return average_retx.load(std::memory_order_relaxed);
 }
 
-ul_harq_entity::ul_harq_process::ul_harq_process() : logger(srslog::fetch_basic_logger("MAC"))
+ul_harq_entity::ul_harq_process::ul_harq_process(srslog::basic_logger& logger_) : logger(logger_)
 {
   pdu_ptr        = NULL;
   payload_buffer = NULL;
@@ -57,13 +57,13 @@ const static uint32_t required_sibs[NOF_REQUIRED_SIBS] = {0, 1, 2, 12}; // SIB1,
   Base functions
 *******************************************************************************/
 
-rrc::rrc(stack_interface_rrc* stack_, srsran::task_sched_handle task_sched_) :
+rrc::rrc(stack_interface_rrc* stack_, srsran::task_sched_handle task_sched_, srslog::basic_logger& logger_) :
   stack(stack_),
   task_sched(task_sched_),
   state(RRC_STATE_IDLE),
   last_state(RRC_STATE_CONNECTED),
-  logger(srslog::fetch_basic_logger("RRC")),
-  measurements(new rrc_meas()),
+  logger(logger_),
+  measurements(new rrc_meas(logger_)),
   cell_searcher(this),
   si_acquirer(this),
   serv_cell_cfg(this),
@@ -77,8 +77,8 @@ rrc::rrc(stack_interface_rrc* stack_, srsran::task_sched_handle task_sched_) :
   conn_setup_proc(this),
   ho_handler(this),
   conn_recfg_proc(this),
-  meas_cells_nr(task_sched_),
-  meas_cells(task_sched_)
+  meas_cells_nr(task_sched_, logger_),
+  meas_cells(task_sched_, logger_)
 {}
 
 rrc::~rrc() = default;
@@ -134,7 +134,7 @@ void rrc::init(phy_interface_rrc_lte* phy_,
       }
     }
   };
-  phy_ctrl.reset(new phy_controller{phy, task_sched, on_every_cell_selection});
+  phy_ctrl.reset(new phy_controller{phy, task_sched, on_every_cell_selection, logger});
 
   state            = RRC_STATE_IDLE;
   plmn_is_selected = false;
@@ -184,8 +184,8 @@ uint16_t meas_cell_eutra::get_mnc() const
  *           Neighbour Cell List
  ********************************************/
 template <class T>
-meas_cell_list<T>::meas_cell_list(srsran::task_sched_handle task_sched_) :
-  serv_cell(new T(task_sched_.get_unique_timer())), task_sched(task_sched_)
+meas_cell_list<T>::meas_cell_list(srsran::task_sched_handle task_sched_, srslog::basic_logger& logger_) :
+  logger(logger_), task_sched(task_sched_), serv_cell(new T(task_sched_.get_unique_timer()))
 {}
 
 template <class T>
@@ -248,7 +248,7 @@ compute_si_window(uint32_t tti, uint32_t sib_index, uint32_t n, uint32_t T, cons
 
 rrc::si_acquire_proc::si_acquire_proc(rrc* parent_) :
   rrc_ptr(parent_),
-  logger(srslog::fetch_basic_logger("RRC")),
+  logger(parent_->logger),
   si_acq_timeout(rrc_ptr->task_sched.get_unique_timer()),
   si_acq_retry_timer(rrc_ptr->task_sched.get_unique_timer())
 {
@@ -372,7 +372,7 @@ proc_outcome_t rrc::si_acquire_proc::react(si_acq_timer_expired ev)
  *************************************/
 
 rrc::serving_cell_config_proc::serving_cell_config_proc(rrc* parent_) :
-  rrc_ptr(parent_), logger(srslog::fetch_basic_logger("RRC"))
+  rrc_ptr(parent_), logger(parent_->logger)
 {}
 
 /*
@@ -703,7 +703,7 @@ void rrc::cell_selection_proc::then(const srsran::proc_result_t<cs_result_t>& pr
  *       PLMN search Procedure
  *************************************/
 
-rrc::plmn_search_proc::plmn_search_proc(rrc* parent_) : rrc_ptr(parent_), logger(srslog::fetch_basic_logger("RRC")) {}
+rrc::plmn_search_proc::plmn_search_proc(rrc* parent_) : rrc_ptr(parent_), logger(parent_->logger) {}
 
 proc_outcome_t rrc::plmn_search_proc::init()
 {
@@ -783,7 +783,7 @@ void rrc::plmn_search_proc::then(const srsran::proc_state_t& result) const
  *************************************/
 
 rrc::connection_request_proc::connection_request_proc(rrc* parent_) :
-  rrc_ptr(parent_), logger(srslog::fetch_basic_logger("RRC"))
+  rrc_ptr(parent_), logger(parent_->logger)
 {}
 
 proc_outcome_t rrc::connection_request_proc::init(srsran::establishment_cause_t cause_,
@@ -949,7 +949,7 @@ srsran::proc_outcome_t rrc::connection_request_proc::react(const cell_selection_
 
 // Simple procedure mainly do defer the transmission of the SetupComplete until all PHY reconfiguration are done
 rrc::connection_setup_proc::connection_setup_proc(srsue::rrc* parent_) :
-  rrc_ptr(parent_), logger(srslog::fetch_basic_logger("RRC"))
+  rrc_ptr(parent_), logger(parent_->logger)
 {}
 
 srsran::proc_outcome_t rrc::connection_setup_proc::init(const asn1::rrc::rr_cfg_ded_s* cnfg_,
@@ -1129,7 +1129,7 @@ void rrc::connection_reconf_no_ho_proc::then(const srsran::proc_state_t& result)
  *************************************/
 
 rrc::process_pcch_proc::process_pcch_proc(srsue::rrc* parent_) :
-  rrc_ptr(parent_), logger(srslog::fetch_basic_logger("RRC"))
+  rrc_ptr(parent_), logger(parent_->logger)
 {}
 
 proc_outcome_t rrc::process_pcch_proc::init(const asn1::rrc::paging_s& paging_)
@@ -33,33 +33,33 @@ using namespace srsran;
 
 namespace srsue {
 
-ue_stack_lte::ue_stack_lte() :
+ue_stack_lte::ue_stack_lte(const std::string& log_id_preamble) :
   args(),
-  stack_logger(srslog::fetch_basic_logger("STCK", false)),
-  mac_logger(srslog::fetch_basic_logger("MAC")),
-  rlc_logger(srslog::fetch_basic_logger("RLC", false)),
-  pdcp_logger(srslog::fetch_basic_logger("PDCP", false)),
-  rrc_logger(srslog::fetch_basic_logger("RRC", false)),
-  usim_logger(srslog::fetch_basic_logger("USIM", false)),
-  nas_logger(srslog::fetch_basic_logger("NAS", false)),
+  stack_logger(srslog::fetch_basic_logger(log_id_preamble + "STCK", false)),
+  mac_logger(srslog::fetch_basic_logger(log_id_preamble + "MAC")),
+  rlc_logger(srslog::fetch_basic_logger(log_id_preamble + "RLC", false)),
+  pdcp_logger(srslog::fetch_basic_logger(log_id_preamble + "PDCP", false)),
+  rrc_logger(srslog::fetch_basic_logger(log_id_preamble + "RRC", false)),
+  usim_logger(srslog::fetch_basic_logger(log_id_preamble + "USIM", false)),
+  nas_logger(srslog::fetch_basic_logger(log_id_preamble + "NAS", false)),
   mac_nr_logger(srslog::fetch_basic_logger("MAC-NR")),
   rrc_nr_logger(srslog::fetch_basic_logger("RRC-NR", false)),
   rlc_nr_logger(srslog::fetch_basic_logger("RLC-NR", false)),
   pdcp_nr_logger(srslog::fetch_basic_logger("PDCP-NR", false)),
   mac_pcap(),
   mac_nr_pcap(),
-  rlc("RLC"),
-  mac("MAC", &task_sched),
-  rrc(this, &task_sched),
+  rlc((log_id_preamble + "RLC").c_str()),
+  mac((log_id_preamble + "MAC").c_str(), &task_sched),
+  rrc(this, &task_sched, rrc_logger),
   rlc_nr("RLC-NR"),
   mac_nr(&task_sched),
   rrc_nr(&task_sched),
-  pdcp(&task_sched, "PDCP"),
+  pdcp(&task_sched, (log_id_preamble + "PDCP").c_str()),
   pdcp_nr(&task_sched, "PDCP-NR"),
-  nas(srslog::fetch_basic_logger("NAS", false), &task_sched),
+  nas(nas_logger, &task_sched),
   thread("STACK"),
   task_sched(512, 64),
-  tti_tprof("tti_tprof", "STCK", TTI_STAT_PERIOD)
+  tti_tprof("tti_tprof", (log_id_preamble + "STCK").c_str(), TTI_STAT_PERIOD)
 {
   get_background_workers().set_nof_workers(2);
   ue_task_queue  = task_sched.make_task_queue();
@@ -334,6 +334,7 @@ bool ue_stack_lte::get_metrics(stack_metrics_t* metrics)
     rlc.get_metrics(metrics.rlc, metrics.mac[0].nof_tti);
     nas.get_metrics(&metrics.nas);
     rrc.get_metrics(metrics.rrc);
+    metrics.pool = srsran::get_byte_buffer_pool_metrics();
     pending_stack_metrics.push(metrics);
   });
   // wait for result
@@ -399,6 +400,37 @@ void ue_stack_lte::write_sdu(uint32_t eps_bearer_id, srsran::unique_byte_buffer_
   }
 }
 
+/**
+ * GW calls write_sdu_batch() to push several SDUs of the same EPS bearer with a single stack task.
+ *
+ * @param eps_bearer_id
+ * @param sdus batch of SDUs, left empty on return
+ */
+void ue_stack_lte::write_sdu_batch(uint32_t eps_bearer_id, sdu_batch_t& sdus)
+{
+  auto     bearer   = bearers.get_radio_bearer(eps_bearer_id);
+  uint32_t nof_sdus = sdus.size();
+  auto     task     = [this, eps_bearer_id, bearer](sdu_batch_t& batch) {
+    for (srsran::unique_byte_buffer_t& sdu : batch) {
+      // route SDU to PDCP entity
+      if (bearer.rat == srsran_rat_t::lte) {
+        pdcp.write_sdu(bearer.lcid, std::move(sdu));
+      } else if (bearer.rat == srsran_rat_t::nr) {
+        pdcp_nr.write_sdu(bearer.lcid, std::move(sdu));
+      } else {
+        stack_logger.warning("Can't deliver SDU for EPS bearer %d. Dropping it.", eps_bearer_id);
+      }
+    }
+  };
+
+  bool ret = gw_queue_id.try_push(std::bind(task, std::move(sdus))).has_value();
+  sdus.clear();
+  if (not ret) {
+    pdcp_logger.info("GW batch of %d SDUs with lcid=%d was discarded.", nof_sdus, bearer.lcid);
+    ul_dropped_sdus += nof_sdus;
+  }
+}
+
 bool ue_stack_lte::has_active_radio_bearer(uint32_t eps_bearer_id)
 {
   return bearers.has_active_radio_bearer(eps_bearer_id);
@@ -32,6 +32,7 @@
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <unistd.h>
@@ -46,6 +47,8 @@ int gw::init(const gw_args_t& args_, stack_interface_gw* stack_)
   args       = args_;
   run_enable = true;
 
+  args.nof_tun_queues = std::max(args.nof_tun_queues, 1u);
+
   logger.set_level(srslog::str_to_basic_level(args.log.gw_level));
   logger.set_hex_dump_max_size(args.log.gw_hex_limit);
 
@@ -73,6 +76,12 @@ int gw::init(const gw_args_t& args_, stack_interface_gw* stack_)
 
 gw::~gw()
 {
+  stop_readers();
+  if (dl_writer != nullptr) {
+    dl_queue.stop();
+    dl_writer->wait_thread_finish();
+  }
+  tun_readers.clear();
   if (tun_fd > 0) {
     close(tun_fd);
   }
@@ -84,17 +93,14 @@ void gw::stop()
     run_enable = false;
     if (if_up) {
       if_up = false;
-      if (running) {
-        thread_cancel();
-      }
 
-      // Wait thread to exit gracefully otherwise might leave a mutex locked
-      int cnt = 0;
-      while (running && cnt < 100) {
-        usleep(10000);
-        cnt++;
+      // The readers poll the TUN device with a timeout, so they exit on their own once run_enable is cleared
+      stop_readers();
+      if (dl_writer != nullptr) {
+        dl_queue.stop();
+        dl_writer->wait_thread_finish();
+        dl_writer.reset();
       }
-      wait_thread_finish();
 
       current_ip_addr = 0;
     }
@@ -151,10 +157,7 @@ void gw::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
     // Only handle IPv4 and IPv6 packets
     struct iphdr* ip_pkt = (struct iphdr*)pdu->msg;
     if (ip_pkt->version == 4 || ip_pkt->version == 6) {
-      int n = write(tun_fd, pdu->msg, pdu->N_bytes);
-      if (n > 0 && (pdu->N_bytes != (uint32_t)n)) {
-        logger.warning("DL TUN/TAP write failure. Wanted to write %d B but only wrote %d B.", pdu->N_bytes, n);
-      }
+      write_tun(std::move(pdu));
     } else {
       logger.error("Unsupported IP version. Dropping packet with %d B", pdu->N_bytes);
     }
@@ -185,10 +188,16 @@ void gw::write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
         logger.warning("TUN/TAP not up - dropping gw RX message");
       }
     } else {
-      int n = write(tun_fd, pdu->msg, pdu->N_bytes);
-      if (n > 0 && (pdu->N_bytes != (uint32_t)n)) {
-        logger.warning("DL TUN/TAP write failure");
-      }
+      write_tun(std::move(pdu));
+    }
+  }
+}
+
+void gw::write_tun(srsran::unique_byte_buffer_t pdu)
+{
+  if (dl_queue.try_push(std::move(pdu)).is_error()) {
+    if (dl_dropped_pdus++ == 0) {
+      logger.warning("DL TUN/TAP queue full - dropping gw RX messages");
     }
   }
 }
@@ -200,12 +209,8 @@ int gw::setup_if_addr(uint32_t eps_bearer_id, uint8_t pdn_type, uint32_t ip_addr
 {
   int err;
 
-  // Make sure the worker thread is terminated before spawning a new one.
-  if (running) {
-    run_enable = false;
-    thread_cancel();
-    wait_thread_finish();
-  }
+  // Make sure the reader threads are terminated before spawning new ones.
+  stop_readers();
   if (pdn_type == LIBLTE_MME_PDN_TYPE_IPV4 || pdn_type == LIBLTE_MME_PDN_TYPE_IPV4V6) {
     err = setup_if_addr4(ip_addr, err_str);
     if (err != SRSRAN_SUCCESS) {
@@ -221,9 +226,8 @@ int gw::setup_if_addr(uint32_t eps_bearer_id, uint8_t pdn_type, uint32_t ip_addr
 
   default_eps_bearer_id = static_cast<int>(eps_bearer_id);
 
-  // Setup a thread to receive packets from the TUN device
-  run_enable = true;
-  start(GW_THREAD_PRIO);
+  // Setup the threads to receive packets from the TUN device queues
+  start_readers();
 
   return SRSRAN_SUCCESS;
 }
@@ -272,47 +276,101 @@ void gw::add_mch_port(uint32_t lcid, uint32_t port)
 /********************/
 /*    GW Receive    */
 /********************/
-void gw::run_thread()
+void gw::start_readers()
 {
-  uint32 idx     = 0;
-  int32  N_bytes = 0;
+  run_enable = true;
+  start(GW_THREAD_PRIO);
+  for (std::unique_ptr<tun_queue_reader>& reader : tun_readers) {
+    reader->start(GW_THREAD_PRIO);
+  }
+  readers_started = true;
+}
 
-  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-  if (!pdu) {
-    logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+void gw::stop_readers()
+{
+  if (!readers_started) {
     return;
   }
+  run_enable = false;
+  wait_thread_finish();
+  for (std::unique_ptr<tun_queue_reader>& reader : tun_readers) {
+    reader->wait_thread_finish();
+  }
+  readers_started = false;
+}
 
-  const static uint32_t REGISTER_WAIT_TOUT = 40, SERVICE_WAIT_TOUT = 40; // 4 sec
-  uint32_t              register_wait = 0, service_wait = 0;
+void gw::run_thread()
+{
+  running = true;
+  read_tun_queue(tun_fd);
+  running = false;
+}
 
-  logger.info("GW IP packet receiver thread run_enable");
+gw::tun_queue_reader::tun_queue_reader(gw* parent_, uint32_t queue_idx, int32_t fd_) :
+  thread("GW_RX" + std::to_string(queue_idx)), parent(parent_), fd(fd_)
+{}
 
-  running = true;
-  while (run_enable) {
-    // Read packet from TUN
-    if (SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET > idx) {
-      N_bytes = read(tun_fd, &pdu->msg[idx], SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET - idx);
-    } else {
-      logger.error("GW pdu buffer full - gw receive thread exiting.");
-      srsran::console("GW pdu buffer full - gw receive thread exiting.\n");
-      break;
-    }
-    logger.debug("Read %d bytes from TUN fd=%d, idx=%d", N_bytes, tun_fd, idx);
+gw::tun_queue_reader::~tun_queue_reader()
+{
+  if (fd > 0) {
+    close(fd);
+  }
+}
+
+void gw::tun_queue_reader::run_thread()
+{
+  parent->read_tun_queue(fd);
+}
 
-    if (N_bytes <= 0) {
-      logger.error("Failed to read from TUN interface - gw receive thread exiting.");
-      srsran::console("Failed to read from TUN interface - gw receive thread exiting.\n");
+void gw::read_tun_queue(int32_t fd)
+{
+  sdu_batch_t                  batch;
+  srsran::unique_byte_buffer_t pdu;
+  bool                         read_error = false;
+
+  logger.info("GW IP packet receiver thread run_enable (fd=%d)", fd);
+
+  while (run_enable && !read_error) {
+    // Wait for at least one packet, waking up periodically to check whether the GW is being stopped
+    struct pollfd pfd = {fd, POLLIN, 0};
+    int           ret = poll(&pfd, 1, TUN_POLL_TIMEOUT_MS);
+    if (ret < 0 && errno != EINTR) {
+      logger.error("Failed to poll TUN interface - gw receive thread exiting.");
+      srsran::console("Failed to poll TUN interface - gw receive thread exiting.\n");
       break;
     }
+    if (ret <= 0) {
+      continue;
+    }
 
-    {
-      std::unique_lock<std::mutex> lock(gw_mutex);
-      // Check if IP version makes sense and get packtet length
+    // Read all the packets already queued in the TUN device, up to the batch size
+    while (batch.size() < batch.capacity()) {
+      if (pdu == nullptr) {
+        pdu = srsran::make_byte_buffer();
+        if (pdu == nullptr) {
+          logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+          break;
+        }
+      }
+
+      pdu->clear();
+      int32_t N_bytes = read(fd, pdu->msg, pdu->get_tailroom());
+      if (N_bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        break;
+      }
+      logger.debug("Read %d bytes from TUN fd=%d", N_bytes, fd);
+      if (N_bytes <= 0) {
+        logger.error("Failed to read from TUN interface - gw receive thread exiting.");
+        srsran::console("Failed to read from TUN interface - gw receive thread exiting.\n");
+        read_error = true;
+        break;
+      }
+
+      // Check if IP version makes sense and get packet length
       struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
       struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
       uint16_t        pkt_len = 0;
-      pdu->N_bytes            = idx + N_bytes;
+      pdu->N_bytes            = N_bytes;
       if (ip_pkt->version == 4) {
         pkt_len = ntohs(ip_pkt->tot_len);
       } else if (ip_pkt->version == 6) {
@@ -323,74 +381,134 @@ void gw::run_thread()
       }
       logger.debug("IPv%d packet total length: %d Bytes", int(ip_pkt->version), pkt_len);
 
-      // Check if entire packet was received
-      if (pkt_len == pdu->N_bytes) {
-        logger.info(pdu->msg, pdu->N_bytes, "TX PDU");
+      // The TUN device returns one packet per read, truncated if it does not fit in the buffer
+      if (pkt_len != pdu->N_bytes) {
+        logger.warning("Entire packet not read from TUN. Total Length %d, N_Bytes %d. Dropping packet.",
+                       pkt_len,
+                       pdu->N_bytes);
+        continue;
+      }
+      logger.info(pdu->msg, pdu->N_bytes, "TX PDU");
+      batch.push_back(std::move(pdu));
+    }
 
-        // Make sure UE is attached and has default EPS bearer activated
-        while (run_enable && default_eps_bearer_id == NOT_ASSIGNED && register_wait < REGISTER_WAIT_TOUT) {
-          if (!register_wait) {
-            logger.info("UE is not attached, waiting for NAS attach (%d/%d)", register_wait, REGISTER_WAIT_TOUT);
-          }
-          lock.unlock();
-          std::this_thread::sleep_for(std::chrono::microseconds(100));
-          lock.lock();
-          register_wait++;
-        }
-        register_wait = 0;
+    if (!batch.empty() && !write_ul_batch(batch)) {
+      break;
+    }
+  }
+  logger.info("GW IP receiver thread exiting (fd=%d).", fd);
+}
 
-        // If we are still not attached by this stage, drop packet
-        if (run_enable && default_eps_bearer_id == NOT_ASSIGNED) {
-          continue;
-        }
+bool gw::write_ul_batch(sdu_batch_t& batch)
+{
+  const static uint32_t REGISTER_WAIT_TOUT = 40; // 4 sec
+  uint32_t              register_wait      = 0;
 
-        if (!run_enable) {
-          break;
-        }
+  std::unique_lock<std::mutex> lock(gw_mutex);
 
-        // Beyond this point we should have a activated default EPS bearer
-        srsran_assert(default_eps_bearer_id != NOT_ASSIGNED, "Default EPS bearer not activated");
+  // Make sure UE is attached and has default EPS bearer activated
+  while (run_enable && default_eps_bearer_id == NOT_ASSIGNED && register_wait < REGISTER_WAIT_TOUT) {
+    if (!register_wait) {
+      logger.info("UE is not attached, waiting for NAS attach (%d/%d)", register_wait, REGISTER_WAIT_TOUT);
+    }
+    lock.unlock();
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    lock.lock();
+    register_wait++;
+  }
 
-        uint8_t eps_bearer_id = default_eps_bearer_id;
-        tft_matcher.check_tft_filter_match(pdu, eps_bearer_id);
+  // If we are still not attached by this stage, drop the packets
+  if (run_enable && default_eps_bearer_id == NOT_ASSIGNED) {
+    batch.clear();
+    return true;
+  }
 
-        // Wait for service request if necessary
-        while (run_enable && !stack->has_active_radio_bearer(eps_bearer_id) && service_wait < SERVICE_WAIT_TOUT) {
-          if (!service_wait) {
-            logger.info(
-                "UE does not have service, waiting for NAS service request (%d/%d)", service_wait, SERVICE_WAIT_TOUT);
-            stack->start_service_request();
-          }
-          usleep(100000);
-          service_wait++;
-        }
-        service_wait = 0;
+  if (!run_enable) {
+    return false;
+  }
 
-        // Quit before writing packet if necessary
-        if (!run_enable) {
-          break;
-        }
+  // Beyond this point we should have a activated default EPS bearer
+  srsran_assert(default_eps_bearer_id != NOT_ASSIGNED, "Default EPS bearer not activated");
 
-        // Send PDU directly to PDCP
-        pdu->set_timestamp();
-        ul_tput_bytes += pdu->N_bytes;
-        stack->write_sdu(eps_bearer_id, std::move(pdu));
-        do {
-          pdu = srsran::make_byte_buffer();
-          if (!pdu) {
-            logger.error("Fatal Error: Couldn't allocate PDU in run_thread().");
-            usleep(100000);
-          }
-        } while (!pdu);
-        idx = 0;
-      } else {
-        idx += N_bytes;
-        logger.debug("Entire packet not read from socket. Total Length %d, N_Bytes %d.", ip_pkt->tot_len, pdu->N_bytes);
+  // Send the PDUs directly to PDCP, grouping consecutive PDUs of the same EPS bearer in one stack task
+  sdu_batch_t bearer_batch;
+  uint8_t     bearer_batch_id = 0;
+  for (srsran::unique_byte_buffer_t& pdu : batch) {
+    uint8_t eps_bearer_id = default_eps_bearer_id;
+    tft_matcher.check_tft_filter_match(pdu, eps_bearer_id);
+
+    if (!bearer_batch.empty() && eps_bearer_id != bearer_batch_id) {
+      stack->write_sdu_batch(bearer_batch_id, bearer_batch);
+    }
+    if (bearer_batch.empty()) {
+      // Quit before writing the packets if necessary
+      if (!wait_service(eps_bearer_id)) {
+        return false;
       }
-    } // end of holdering gw_mutex
+      bearer_batch_id = eps_bearer_id;
+    }
+
+    pdu->set_timestamp();
+    ul_tput_bytes += pdu->N_bytes;
+    bearer_batch.push_back(std::move(pdu));
+  }
+  if (!bearer_batch.empty()) {
+    stack->write_sdu_batch(bearer_batch_id, bearer_batch);
+  }
+  batch.clear();
+  return true;
+}
+
+// Called with gw_mutex locked. Returns false if the GW is being stopped.
+bool gw::wait_service(uint32_t eps_bearer_id)
+{
+  const static uint32_t SERVICE_WAIT_TOUT = 40; // 4 sec
+  uint32_t              service_wait      = 0;
+
+  // Wait for service request if necessary
+  while (run_enable && !stack->has_active_radio_bearer(eps_bearer_id) && service_wait < SERVICE_WAIT_TOUT) {
+    if (!service_wait) {
+      logger.info(
+          "UE does not have service, waiting for NAS service request (%d/%d)", service_wait, SERVICE_WAIT_TOUT);
+      stack->start_service_request();
+    }
+    usleep(100000);
+    service_wait++;
+  }
+  return run_enable;
+}
+
+/********************/
+/*   GW Transmit    */
+/********************/
+void gw::write_tun_batches()
+{
+  sdu_batch_t batch;
+
+  while (true) {
+    bool                         success = false;
+    srsran::unique_byte_buffer_t pdu     = dl_queue.pop_blocking(&success);
+    if (!success) {
+      break;
+    }
+
+    // Drain the PDUs already queued, so that a burst of PDUs only takes one wakeup of this thread
+    batch.push_back(std::move(pdu));
+    while (batch.size() < batch.capacity() && dl_queue.try_pop(pdu)) {
+      batch.push_back(std::move(pdu));
+    }
+
+    // The TUN device takes a single packet per write
+    for (srsran::unique_byte_buffer_t& dl_pdu : batch) {
+      int n = write(tun_fd, dl_pdu->msg, dl_pdu->N_bytes);
+      if (n < 0) {
+        logger.warning("DL TUN/TAP write failure: %s", strerror(errno));
+      } else if (dl_pdu->N_bytes != (uint32_t)n) {
+        logger.warning("DL TUN/TAP write failure. Wanted to write %d B but only wrote %d B.", dl_pdu->N_bytes, n);
+      }
+    }
+    batch.clear();
   }
-  running = false;
-  logger.info("GW IP receiver thread exiting.");
 }
 
 /**************************/
@@ -419,8 +537,8 @@ int gw::init_if(char* err_str)
     }
   }
 
-  // Construct the TUN device
-  tun_fd = open("/dev/net/tun", O_RDWR);
+  // Construct the TUN device. Its queues are read with poll(), so that the readers can be stopped without cancelling
+  tun_fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
   logger.info("TUN file descriptor = %d", tun_fd);
   if (0 > tun_fd) {
     err_str = strerror(errno);
@@ -430,6 +548,9 @@ int gw::init_if(char* err_str)
 
   memset(&ifr, 0, sizeof(ifr));
   ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+  if (args.nof_tun_queues > 1) {
+    ifr.ifr_flags |= IFF_MULTI_QUEUE;
+  }
   strncpy(
       ifr.ifr_ifrn.ifrn_name, args.tun_dev_name.c_str(), std::min(args.tun_dev_name.length(), (size_t)(IFNAMSIZ - 1)));
   ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = 0;
@@ -440,6 +561,25 @@ int gw::init_if(char* err_str)
     return SRSRAN_ERROR_CANT_START;
   }
 
+  // Attach the additional queues to the same device. The kernel spreads the UL flows across them.
+  tun_readers.clear();
+  for (uint32_t queue_idx = 1; queue_idx < args.nof_tun_queues; queue_idx++) {
+    struct ifreq queue_ifr = ifr;
+    int32_t      queue_fd  = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
+    if (0 > queue_fd || 0 > ioctl(queue_fd, TUNSETIFF, &queue_ifr)) {
+      err_str = strerror(errno);
+      logger.error("Failed to attach TUN queue %d: %s", queue_idx, err_str);
+      if (queue_fd >= 0) {
+        close(queue_fd);
+      }
+      tun_readers.clear();
+      close(tun_fd);
+      return SRSRAN_ERROR_CANT_START;
+    }
+    tun_readers.emplace_back(new tun_queue_reader(this, queue_idx, queue_fd));
+  }
+  logger.info("TUN device %s has %d queue(s)", ifr.ifr_name, args.nof_tun_queues);
+
   // Bring up the interface
   sock = socket(AF_INET, SOCK_DGRAM, 0);
   if (0 > ioctl(sock, SIOCGIFFLAGS, &ifr)) {
@@ -465,6 +605,9 @@ int gw::init_if(char* err_str)
   } else {
     logger.warning("Could not find link-local IPv6 address.");
   }
+
+  dl_writer.reset(new tun_writer(this));
+  dl_writer->start(GW_THREAD_PRIO);
   if_up = true;
 
   return SRSRAN_SUCCESS;
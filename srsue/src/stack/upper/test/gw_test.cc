@@ -25,6 +25,11 @@
 #include "srsue/hdr/stack/upper/gw.h"
 
 #include <arpa/inet.h>
+#include <atomic>
+#include <netinet/ip.h>
+#include <netinet/udp.h>
+#include <thread>
+#include <unistd.h>
 
 class test_stack_dummy : public srsue::stack_interface_gw
 {
@@ -35,6 +40,119 @@ public:
   bool has_active_radio_bearer(uint32_t eps_bearer_id) { return true; }
 };
 
+class test_stack_batch_dummy : public srsue::stack_interface_gw
+{
+public:
+  bool is_registered() { return true; }
+  bool start_service_request() { return true; };
+  void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu) { nof_sdus++; }
+  void write_sdu_batch(uint32_t eps_bearer_id, sdu_batch_t& sdus)
+  {
+    nof_sdus += sdus.size();
+    nof_batches++;
+    sdus.clear();
+  }
+  bool has_active_radio_bearer(uint32_t eps_bearer_id) { return true; }
+
+  std::atomic<uint32_t> nof_sdus    = {0};
+  std::atomic<uint32_t> nof_batches = {0};
+};
+
+// Builds an IPv4/UDP packet without UDP checksum
+srsran::unique_byte_buffer_t make_udp_pdu(in_addr_t src, in_addr_t dst, uint16_t dst_port, uint32_t payload_len)
+{
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  if (pdu == nullptr) {
+    return pdu;
+  }
+  pdu->N_bytes = sizeof(struct iphdr) + sizeof(struct udphdr) + payload_len;
+  memset(pdu->msg, 0, pdu->N_bytes);
+
+  struct iphdr* ip = (struct iphdr*)pdu->msg;
+  ip->version      = 4;
+  ip->ihl          = 5;
+  ip->ttl          = 64;
+  ip->protocol     = IPPROTO_UDP;
+  ip->tot_len      = htons(pdu->N_bytes);
+  ip->saddr        = src;
+  ip->daddr        = dst;
+
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < sizeof(struct iphdr) / 2; i++) {
+    sum += ((uint16_t*)ip)[i];
+  }
+  while (sum >> 16) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+  ip->check = ~sum;
+
+  struct udphdr* udp = (struct udphdr*)&pdu->msg[sizeof(struct iphdr)];
+  udp->source        = htons(dst_port);
+  udp->dest          = htons(dst_port);
+  udp->len           = htons(sizeof(struct udphdr) + payload_len);
+  return pdu;
+}
+
+// Sends UL traffic through a multi-queue TUN device and loops DL packets back to a local socket
+int gw_batch_test(uint32_t nof_tun_queues)
+{
+  const uint32_t   nof_pkts = 256;
+  const uint16_t   port     = 5001;
+  srsue::gw_args_t gw_args;
+  gw_args.tun_dev_name     = "tun_batch";
+  gw_args.tun_dev_netmask  = "255.255.255.0";
+  gw_args.nof_tun_queues   = nof_tun_queues;
+  gw_args.log.gw_level     = "warning";
+  gw_args.log.gw_hex_limit = 0;
+  test_stack_batch_dummy stack;
+  srsue::gw              gw(srslog::fetch_basic_logger("GW"));
+  gw.init(gw_args, &stack);
+
+  in_addr_t ue_addr   = inet_addr("192.168.57.2");
+  in_addr_t peer_addr = inet_addr("192.168.57.3");
+  if (gw.setup_if_addr(5, LIBLTE_MME_PDN_TYPE_IPV4, ntohl(ue_addr), nullptr, nullptr) != SRSRAN_SUCCESS) {
+    srslog::fetch_basic_logger("TEST", false)
+        .error("Failed to setup GW interface. Not possible to test function. Try to execute with sudo rights.");
+    gw.stop();
+    return SRSRAN_SUCCESS;
+  }
+
+  // UL: packets routed to the TUN device must reach the stack, possibly in batches
+  int                sock = socket(AF_INET, SOCK_DGRAM, 0);
+  struct sockaddr_in addr = {};
+  addr.sin_family         = AF_INET;
+  addr.sin_port           = htons(port);
+  addr.sin_addr.s_addr    = ue_addr;
+  TESTASSERT(sock >= 0);
+  TESTASSERT(bind(sock, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+  addr.sin_addr.s_addr = peer_addr;
+  uint8_t payload[100] = {};
+  for (uint32_t i = 0; i < nof_pkts; i++) {
+    TESTASSERT(sendto(sock, payload, sizeof(payload), 0, (struct sockaddr*)&addr, sizeof(addr)) == sizeof(payload));
+  }
+  for (uint32_t i = 0; i < 100 && stack.nof_sdus < nof_pkts; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  TESTASSERT(stack.nof_sdus >= nof_pkts); // The kernel may route its own packets to the device too
+  TESTASSERT(stack.nof_batches >= 1 && stack.nof_batches <= stack.nof_sdus);
+
+  // DL: packets written by PDCP must come out of the TUN device
+  for (uint32_t i = 0; i < nof_pkts; i++) {
+    gw.write_pdu(3, make_udp_pdu(peer_addr, ue_addr, port, sizeof(payload)));
+  }
+  struct timeval tv = {1, 0};
+  setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  uint32_t nof_rx = 0;
+  while (nof_rx < nof_pkts && recv(sock, payload, sizeof(payload), 0) == sizeof(payload)) {
+    nof_rx++;
+  }
+  TESTASSERT(nof_rx == nof_pkts);
+
+  close(sock);
+  gw.stop();
+  return SRSRAN_SUCCESS;
+}
+
 int gw_test()
 {
   srsue::gw_args_t gw_args;
@@ -76,6 +194,8 @@ int main(int argc, char** argv)
 {
   srslog::init();
 
+  TESTASSERT(gw_batch_test(1) == SRSRAN_SUCCESS);
+  TESTASSERT(gw_batch_test(4) == SRSRAN_SUCCESS);
   TESTASSERT(gw_test() == SRSRAN_SUCCESS);
 
   return SRSRAN_SUCCESS;
@@ -34,14 +34,12 @@
 using namespace srsue;
 using namespace srsran;
 
-static_assert(alignof(LIBLTE_BYTE_MSG_STRUCT) == alignof(byte_buffer_t),
-              "liblte buffer and byte buffer members misaligned");
-static_assert(offsetof(LIBLTE_BYTE_MSG_STRUCT, N_bytes) == offsetof(byte_buffer_t, N_bytes),
-              "liblte buffer and byte buffer members misaligned");
-static_assert(offsetof(LIBLTE_BYTE_MSG_STRUCT, header) == offsetof(byte_buffer_t, buffer),
-              "liblte buffer and byte buffer members misaligned");
-static_assert(sizeof(LIBLTE_BYTE_MSG_STRUCT) <= offsetof(byte_buffer_t, msg),
-              "liblte buffer and byte buffer members misaligned");
+// liblte_byte_msg_adapter copies the whole message between the byte buffer and the liblte buffer
+static_assert(LIBLTE_MSG_HEADER_OFFSET == SRSRAN_BUFFER_HEADER_OFFSET, "liblte buffer and byte buffer headroom differ");
+static_assert(LIBLTE_MAX_MSG_SIZE_BYTES >= SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET,
+              "byte buffer payload does not fit in a liblte buffer");
+static_assert(LIBLTE_MAX_MSG_SIZE_BYTES <= SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET,
+              "liblte buffer payload does not fit in a byte buffer");
 
 int mme_attach_request_test()
 {
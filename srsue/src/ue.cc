@@ -30,6 +30,8 @@
 #include "srsue/hdr/stack/ue_stack_lte.h"
 #include "srsue/hdr/stack/ue_stack_nr.h"
 #include <algorithm>
+#include <cinttypes>
+#include <fstream>
 #include <iostream>
 #include <string>
 
@@ -45,7 +47,7 @@ ue::ue() : logger(srslog::fetch_basic_logger("UE", false)), sys_proc(logger)
 
 ue::~ue()
 {
-  stack.reset();
+  stack.clear();
 }
 
 int ue::init(const all_args_t& args_)
@@ -62,23 +64,34 @@ int ue::init(const all_args_t& args_)
     return SRSRAN_ERROR;
   }
 
-  // Instantiate layers and stack together our UE
-  std::unique_ptr<ue_stack_lte> lte_stack(new ue_stack_lte);
-  if (!lte_stack) {
-    srsran::console("Error creating LTE stack instance.\n");
-    return SRSRAN_ERROR;
-  }
+  // Instantiate layers and stack together each UE
+  uint32_t                                   nof_ues = usim_table.empty() ? 1 : (uint32_t)usim_table.size();
+  std::vector<std::unique_ptr<ue_stack_lte> > lte_stacks;
+  std::vector<std::unique_ptr<gw> >           gw_ptrs;
+  std::vector<std::unique_ptr<srsue::phy> >   lte_phys;
+  for (uint32_t ue_idx = 0; ue_idx < nof_ues; ue_idx++) {
+    std::string                   log_id_preamble = get_log_id_preamble(ue_idx);
+    std::unique_ptr<ue_stack_lte> lte_stack(new ue_stack_lte(log_id_preamble));
+    if (!lte_stack) {
+      srsran::console("Error creating LTE stack instance.\n");
+      return SRSRAN_ERROR;
+    }
 
-  std::unique_ptr<gw> gw_ptr(new gw(srslog::fetch_basic_logger("GW")));
-  if (!gw_ptr) {
-    srsran::console("Error creating a GW instance.\n");
-    return SRSRAN_ERROR;
-  }
+    std::unique_ptr<gw> gw_ptr(new gw(srslog::fetch_basic_logger(log_id_preamble + "GW")));
+    if (!gw_ptr) {
+      srsran::console("Error creating a GW instance.\n");
+      return SRSRAN_ERROR;
+    }
 
-  std::unique_ptr<srsue::phy> lte_phy = std::unique_ptr<srsue::phy>(new srsue::phy);
-  if (!lte_phy) {
-    srsran::console("Error creating LTE PHY instance.\n");
-    return SRSRAN_ERROR;
+    std::unique_ptr<srsue::phy> lte_phy = std::unique_ptr<srsue::phy>(new srsue::phy(log_id_preamble));
+    if (!lte_phy) {
+      srsran::console("Error creating LTE PHY instance.\n");
+      return SRSRAN_ERROR;
+    }
+
+    lte_stacks.push_back(std::move(lte_stack));
+    gw_ptrs.push_back(std::move(gw_ptr));
+    lte_phys.push_back(std::move(lte_phy));
   }
 
   std::unique_ptr<srsran::radio> lte_radio = std::unique_ptr<srsran::radio>(new srsran::radio);
@@ -87,51 +100,91 @@ int ue::init(const all_args_t& args_)
     return SRSRAN_ERROR;
   }
 
-  // init layers
-  if (lte_radio->init(args.rf, lte_phy.get())) {
-    srsran::console("Error initializing radio.\n");
-    return SRSRAN_ERROR;
+  // init layers. Several UEs share the radio through a multiplexer, which resamples from and to the fixed sampling
+  // rate, so the radio itself runs at that rate without resampling
+  std::unique_ptr<srsran::radio_mux> lte_radio_mux;
+  if (usim_table.empty()) {
+    if (lte_radio->init(args.rf, lte_phys[0].get())) {
+      srsran::console("Error initializing radio.\n");
+      return SRSRAN_ERROR;
+    }
+  } else {
+    uint32_t nof_channels = args.rf.nof_antennas * args.rf.nof_carriers;
+    lte_radio_mux.reset(new srsran::radio_mux(*lte_radio, args.rf.srate_hz, nof_channels, nof_ues));
+
+    srsran::rf_args_t rf_args = args.rf;
+    rf_args.srate_hz          = 0.0;
+    if (lte_radio->init(rf_args, lte_radio_mux.get())) {
+      srsran::console("Error initializing radio.\n");
+      return SRSRAN_ERROR;
+    }
+    lte_radio->set_rx_srate(args.rf.srate_hz);
+    lte_radio->set_tx_srate(args.rf.srate_hz);
+
+    for (uint32_t ue_idx = 0; ue_idx < nof_ues; ue_idx++) {
+      lte_radio_mux->set_phy(ue_idx, lte_phys[ue_idx].get());
+    }
+    srsran::console("Emulating %d UEs on a single radio\n", nof_ues);
   }
 
   // from here onwards do not exit immediately if something goes wrong as sub-layers may already use interfaces
-  if (lte_phy->init(args.phy, lte_stack.get(), lte_radio.get())) {
-    srsran::console("Error initializing PHY.\n");
-    ret = SRSRAN_ERROR;
-  }
+  for (uint32_t ue_idx = 0; ue_idx < nof_ues; ue_idx++) {
+    all_args_t                   ue_args   = get_ue_args(ue_idx);
+    srsue::phy*                  lte_phy   = lte_phys[ue_idx].get();
+    ue_stack_lte*                lte_stack = lte_stacks[ue_idx].get();
+    srsran::radio_interface_phy* radio_if  = lte_radio_mux ? lte_radio_mux->get_port(ue_idx) : lte_radio.get();
+
+    if (lte_phy->init(ue_args.phy, lte_stack, radio_if)) {
+      srsran::console("Error initializing PHY.\n");
+      ret = SRSRAN_ERROR;
+    }
 
-  srsue::phy_args_nr_t phy_args_nr = {};
-  phy_args_nr.max_nof_prb          = args.phy.nr_max_nof_prb;
-  phy_args_nr.rf_channel_offset    = args.phy.nof_lte_carriers;
-  phy_args_nr.nof_carriers         = args.phy.nof_nr_carriers;
-  phy_args_nr.nof_phy_threads      = args.phy.nof_phy_threads;
-  phy_args_nr.worker_cpu_mask      = args.phy.worker_cpu_mask;
-  phy_args_nr.log                  = args.phy.log;
-  phy_args_nr.store_pdsch_ko       = args.phy.nr_store_pdsch_ko;
-  if (lte_phy->init(phy_args_nr, lte_stack.get(), lte_radio.get())) {
-    srsran::console("Error initializing NR PHY.\n");
-    ret = SRSRAN_ERROR;
-  }
+    srsue::phy_args_nr_t phy_args_nr = {};
+    phy_args_nr.max_nof_prb          = ue_args.phy.nr_max_nof_prb;
+    phy_args_nr.rf_channel_offset    = ue_args.phy.nof_lte_carriers;
+    phy_args_nr.nof_carriers         = ue_args.phy.nof_nr_carriers;
+    phy_args_nr.nof_phy_threads      = ue_args.phy.nof_phy_threads;
+    phy_args_nr.worker_cpu_mask      = ue_args.phy.worker_cpu_mask;
+    phy_args_nr.log                  = ue_args.phy.log;
+    phy_args_nr.store_pdsch_ko       = ue_args.phy.nr_store_pdsch_ko;
+    if (lte_phy->init(phy_args_nr, lte_stack, radio_if)) {
+      srsran::console("Error initializing NR PHY.\n");
+      ret = SRSRAN_ERROR;
+    }
 
-  if (lte_stack->init(args.stack, lte_phy.get(), lte_phy.get(), gw_ptr.get())) {
-    srsran::console("Error initializing stack.\n");
-    ret = SRSRAN_ERROR;
-  }
+    if (lte_stack->init(ue_args.stack, lte_phy, lte_phy, gw_ptrs[ue_idx].get())) {
+      srsran::console("Error initializing stack.\n");
+      ret = SRSRAN_ERROR;
+    }
 
-  if (gw_ptr->init(args.gw, lte_stack.get())) {
-    srsran::console("Error initializing GW.\n");
-    ret = SRSRAN_ERROR;
+    if (gw_ptrs[ue_idx]->init(ue_args.gw, lte_stack)) {
+      srsran::console("Error initializing GW.\n");
+      ret = SRSRAN_ERROR;
+    }
   }
 
   // move ownership
-  stack   = std::move(lte_stack);
-  gw_inst = std::move(gw_ptr);
-  phy     = std::move(lte_phy);
-  radio   = std::move(lte_radio);
+  for (uint32_t ue_idx = 0; ue_idx < nof_ues; ue_idx++) {
+    stack.push_back(std::move(lte_stacks[ue_idx]));
+    gw_inst.push_back(std::move(gw_ptrs[ue_idx]));
+    phy.push_back(std::move(lte_phys[ue_idx]));
+  }
+  radio_mux = std::move(lte_radio_mux);
+  radio     = std::move(lte_radio);
 
-  if (phy) {
+  if (not phy.empty()) {
     srsran::console("Waiting PHY to initialize ... ");
-    phy->wait_initialize();
+    for (std::unique_ptr<ue_phy_base>& p : phy) {
+      p->wait_initialize();
+    }
     srsran::console("done!\n");
+
+    srsran_dft_plan_stats_t dft_stats = {};
+    srsran_dft_get_plan_stats(&dft_stats);
+    logger.info("FFT planning: %d plans created, %d shared, %.1f ms",
+                dft_stats.nof_plans,
+                dft_stats.nof_shared,
+                dft_stats.planning_time_us / 1000.0);
   }
 
   return ret;
@@ -242,22 +295,120 @@ int ue::parse_args(const all_args_t& args_)
   // Consider Carrier Aggregation support if more than one
   args.stack.rrc.support_ca = (args.phy.nof_lte_carriers > 1);
 
+  // Several UEs share the radio at a fixed sampling rate
+  if (not args.general.usim_table_filename.empty()) {
+    if (parse_usim_table(args.general.usim_table_filename)) {
+      return SRSRAN_ERROR;
+    }
+    if (not std::isnormal(args.rf.srate_hz)) {
+      logger.error("Error: rf.srate must be set when usim.table is used");
+      srsran::console("Error: rf.srate must be set when usim.table is used\n");
+      return SRSRAN_ERROR;
+    }
+    if (args.phy.nof_nr_carriers > 0) {
+      logger.error("Error: NR carriers are not supported when usim.table is used");
+      srsran::console("Error: NR carriers are not supported when usim.table is used\n");
+      return SRSRAN_ERROR;
+    }
+  }
+
   return SRSRAN_SUCCESS;
 }
 
+int ue::parse_usim_table(const std::string& filename)
+{
+  // Same format as the HSS user database: name,auth,imsi,key,op_type,op/opc,... Only the first six fields are used
+  std::ifstream file(filename);
+  if (not file.is_open()) {
+    logger.error("Error opening USIM table %s", filename.c_str());
+    srsran::console("Error opening USIM table %s\n", filename.c_str());
+    return SRSRAN_ERROR;
+  }
+
+  usim_table.clear();
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() or line[0] == '#') {
+      continue;
+    }
+
+    std::vector<std::string> fields;
+    srsran::string_parse_list(line, ',', fields);
+    if (fields.size() < 6) {
+      logger.error("Error parsing USIM table line %d: %s", (uint32_t)usim_table.size(), line.c_str());
+      srsran::console("Error parsing USIM table line: %s\n", line.c_str());
+      return SRSRAN_ERROR;
+    }
+
+    usim_args_t usim = args.stack.usim;
+    usim.algo        = (fields[1] == "mil") ? "milenage" : fields[1];
+    usim.imsi        = fields[2];
+    usim.k           = fields[3];
+    usim.using_op    = (fields[4] == "op");
+    usim.op          = usim.using_op ? fields[5] : "";
+    usim.opc         = usim.using_op ? "" : fields[5];
+    usim_table.push_back(usim);
+  }
+
+  if (usim_table.empty()) {
+    logger.error("Error: USIM table %s is empty", filename.c_str());
+    srsran::console("Error: USIM table %s is empty\n", filename.c_str());
+    return SRSRAN_ERROR;
+  }
+
+  logger.info("Loaded %d UEs from USIM table %s", (uint32_t)usim_table.size(), filename.c_str());
+  return SRSRAN_SUCCESS;
+}
+
+all_args_t ue::get_ue_args(uint32_t ue_idx) const
+{
+  all_args_t ue_args = args;
+  if (ue_idx >= usim_table.size()) {
+    return ue_args;
+  }
+
+  // Each UE has its own credentials, IMEI, TUN device and loggers
+  ue_args.stack.usim = usim_table[ue_idx];
+  if (ue_args.stack.usim.imei.length() == 15) {
+    char     imei[16] = {};
+    uint64_t base     = (uint64_t)strtoull(ue_args.stack.usim.imei.c_str(), nullptr, 10);
+    snprintf(imei, sizeof(imei), "%015" PRIu64, base + ue_idx);
+    ue_args.stack.usim.imei = imei;
+  }
+  ue_args.gw.tun_dev_name += std::to_string(ue_idx);
+  if (not ue_args.gw.netns.empty()) {
+    ue_args.gw.netns += std::to_string(ue_idx);
+  }
+  ue_args.phy.log.id_preamble = get_log_id_preamble(ue_idx);
+
+  // Only the first UE writes packet captures
+  if (ue_idx > 0) {
+    ue_args.stack.pkt_trace.enable          = "none";
+    ue_args.stack.pkt_trace.nas_pcap.enable = false;
+  }
+
+  return ue_args;
+}
+
+std::string ue::get_log_id_preamble(uint32_t ue_idx) const
+{
+  // The logger names of each emulated UE start with its index, e.g. "UE3-RRC"
+  return usim_table.empty() ? "" : "UE" + std::to_string(ue_idx) + "-";
+}
+
 void ue::stop()
 {
   // tear down UE in reverse order
-  if (stack) {
-    stack->stop();
+  for (std::unique_ptr<ue_stack_base>& s : stack) {
+    s->stop();
   }
 
-  if (gw_inst) {
-    gw_inst->stop();
+  for (std::unique_ptr<gw>& g : gw_inst) {
+    g->stop();
   }
 
-  if (phy) {
-    phy->stop();
+  for (std::unique_ptr<ue_phy_base>& p : phy) {
+    p->stop();
   }
 
   if (radio) {
@@ -267,30 +418,43 @@ void ue::stop()
 
 bool ue::switch_on()
 {
-  return stack->switch_on();
+  bool ret = true;
+  for (std::unique_ptr<ue_stack_base>& s : stack) {
+    ret &= s->switch_on();
+  }
+  return ret;
 }
 
 bool ue::switch_off()
 {
-  if (gw_inst) {
-    gw_inst->stop();
+  for (std::unique_ptr<gw>& g : gw_inst) {
+    g->stop();
   }
 
   // send switch off
-  stack->switch_off();
+  for (std::unique_ptr<ue_stack_base>& s : stack) {
+    s->switch_off();
+  }
 
   // wait for max. 5s for it to be sent (according to TS 24.301 Sec 25.5.2.2)
-  int             cnt = 0, timeout_s = 5;
-  stack_metrics_t metrics = {};
-  stack->get_metrics(&metrics);
-
-  while (metrics.rrc.state != RRC_STATE_IDLE && ++cnt <= timeout_s) {
+  int      cnt = 0, timeout_s = 5;
+  uint32_t nof_idle = 0;
+  while (true) {
+    nof_idle = 0;
+    for (std::unique_ptr<ue_stack_base>& s : stack) {
+      stack_metrics_t metrics = {};
+      s->get_metrics(&metrics);
+      nof_idle += (metrics.rrc.state == RRC_STATE_IDLE) ? 1 : 0;
+    }
+    if (nof_idle == stack.size() || ++cnt > timeout_s) {
+      break;
+    }
     std::this_thread::sleep_for(std::chrono::seconds(1));
-    stack->get_metrics(&metrics);
   }
 
-  if (metrics.rrc.state != RRC_STATE_IDLE) {
-    srslog::fetch_basic_logger("NAS").warning("Detach couldn't be sent after %ds.", timeout_s);
+  if (nof_idle != stack.size()) {
+    srslog::fetch_basic_logger("NAS").warning(
+        "Detach couldn't be sent after %ds by %d UEs.", timeout_s, (uint32_t)stack.size() - nof_idle);
     return false;
   }
 
@@ -299,17 +463,18 @@ bool ue::switch_off()
 
 void ue::start_plot()
 {
-  phy->start_plot();
+  phy.front()->start_plot();
 }
 
 bool ue::get_metrics(ue_metrics_t* m)
 {
+  // When several UEs are emulated, only the first one is reported
   bzero(m, sizeof(ue_metrics_t));
-  phy->get_metrics(srsran::srsran_rat_t::lte, &m->phy);
-  phy->get_metrics(srsran::srsran_rat_t::nr, &m->phy_nr);
+  phy.front()->get_metrics(srsran::srsran_rat_t::lte, &m->phy);
+  phy.front()->get_metrics(srsran::srsran_rat_t::nr, &m->phy_nr);
   radio->get_metrics(&m->rf);
-  stack->get_metrics(&m->stack);
-  gw_inst->get_metrics(m->gw, m->stack.mac[0].nof_tti);
+  stack.front()->get_metrics(&m->stack);
+  gw_inst.front()->get_metrics(m->gw, m->stack.mac[0].nof_tti);
   m->sys = sys_proc.get_metrics();
   return true;
 }